@@ -17,6 +17,12 @@
 #define LOG_NDEBUG 0
 #define LOG_TAG "BootAnimation"
 
+#include <algorithm>
+#include <condition_variable>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <thread>
 #include <vector>
 
 #include <stdint.h>
@@ -26,6 +32,7 @@
 #include <sys/stat.h>
 #include <sys/types.h>
 #include <math.h>
+#include <string.h>
 #include <fcntl.h>
 #include <utils/misc.h>
 #include <signal.h>
@@ -108,8 +115,13 @@ static const int TEXT_CENTER_VALUE = INT_MAX;
 static const int TEXT_MISSING_VALUE = INT_MIN;
 static const char EXIT_PROP_NAME[] = "service.bootanim.exit";
 static const char DISPLAYS_PROP_NAME[] = "persist.service.bootanim.displays";
+static const char FRAME_STATS_PROP_NAME[] = "service.bootanim.frame_stats";
 static const int ANIM_ENTRY_NAME_MAX = ANIM_PATH_MAX + 1;
 static constexpr size_t TEXT_POS_LEN_MAX = 16;
+// Frames of a part are decoded this far ahead of the one being drawn, on this
+// many threads, so decoding doesn't stall the render thread.
+static constexpr size_t DECODE_AHEAD_FRAMES = 4;
+static constexpr size_t DECODE_THREADS = 2;
 
 // ---------------------------------------------------------------------------
 
@@ -219,21 +231,40 @@ status_t BootAnimation::initTexture(Texture* texture, AssetManager& assets,
     return NO_ERROR;
 }
 
-status_t BootAnimation::initTexture(FileMap* map, int* width, int* height) {
-    SkBitmap bitmap;
+// Decodes a PNG frame into |bitmap|. Safe to call from any thread.
+static void decodeFrame(const FileMap* map, SkBitmap* bitmap) {
     sk_sp<SkData> data = SkData::MakeWithoutCopy(map->getDataPtr(),
             map->getDataLength());
     sk_sp<SkImage> image = SkImage::MakeFromEncoded(data);
-    image->asLegacyBitmap(&bitmap, SkImage::kRO_LegacyBitmapMode);
+    if (image != nullptr) {
+        image->asLegacyBitmap(bitmap, SkImage::kRO_LegacyBitmapMode);
+    }
+}
+
+// Frames named *.pkm hold ETC1 data and are uploaded as is, without decoding.
+static bool isCompressedFrame(const String8& name) {
+    return name.getPathExtension() == ".pkm";
+}
+
+status_t BootAnimation::initTexture(FileMap* map, int* width, int* height) {
+    SkBitmap bitmap;
+    decodeFrame(map, &bitmap);
 
     // FileMap memory is never released until application exit.
     // Release it now as the texture is already loaded and the memory used for
     // the packed resource can be released.
     delete map;
 
+    return initTexture(bitmap, width, height);
+}
+
+status_t BootAnimation::initTexture(const SkBitmap& bitmap, int* width, int* height) {
     const int w = bitmap.width();
     const int h = bitmap.height();
     const void* p = bitmap.getPixels();
+    if (w <= 0 || h <= 0) {
+        return BAD_VALUE;
+    }
 
     GLint crop[4] = { 0, h, w, -h };
     int tw = 1 << (31 - __builtin_clz(w));
@@ -277,6 +308,115 @@ status_t BootAnimation::initTexture(FileMap* map, int* width, int* height) {
     return NO_ERROR;
 }
 
+status_t BootAnimation::initCompressedTexture(FileMap* map, int* width, int* height) {
+    // PKM header: "PKM 10", format, then big-endian padded and original sizes.
+    constexpr size_t kPkmHeaderSize = 16;
+    const uint8_t* data = static_cast<const uint8_t*>(map->getDataPtr());
+    const size_t length = map->getDataLength();
+    auto readBe16 = [data](size_t offset) { return (data[offset] << 8) | data[offset + 1]; };
+
+    status_t status = BAD_VALUE;
+    if (!mUseEtc1Textures) {
+        SLOGE("ETC1 frames are not supported by this GPU");
+    } else if (length < kPkmHeaderSize || memcmp(data, "PKM 10", 6) != 0) {
+        SLOGE("Invalid PKM frame header");
+    } else {
+        const int tw = readBe16(8);
+        const int th = readBe16(10);
+        const int w = readBe16(12);
+        const int h = readBe16(14);
+        const size_t size = (tw / 4) * (th / 4) * 8;
+        const bool pot = (tw & (tw - 1)) == 0 && (th & (th - 1)) == 0;
+        if (w > tw || h > th || length < kPkmHeaderSize + size) {
+            SLOGE("Invalid PKM frame of %dx%d", w, h);
+        } else if (!mUseNpotTextures && !pot) {
+            SLOGE("PKM frame of %dx%d must be padded to a power of two", tw, th);
+        } else {
+            glCompressedTexImage2D(GL_TEXTURE_2D, 0, GL_ETC1_RGB8_OES, tw, th, 0, size,
+                    data + kPkmHeaderSize);
+            GLint crop[4] = { 0, h, w, -h };
+            glTexParameteriv(GL_TEXTURE_2D, GL_TEXTURE_CROP_RECT_OES, crop);
+            *width = w;
+            *height = h;
+            status = NO_ERROR;
+        }
+    }
+
+    delete map;
+    return status;
+}
+
+// Decodes the frames of a part ahead of playback on worker threads so that the
+// render thread only has to upload them. At most |capacity| decoded frames are
+// held in memory at a time.
+class BootAnimation::FrameDecoder {
+public:
+    FrameDecoder(const Animation::Part& part, size_t capacity, size_t threadCount)
+          : mPart(part), mCapacity(capacity) {
+        for (size_t i = 0; i < threadCount; i++) {
+            mThreads.emplace_back([this]() { decodeLoop(); });
+        }
+    }
+
+    ~FrameDecoder() {
+        {
+            std::lock_guard<std::mutex> lock(mLock);
+            mStopping = true;
+        }
+        mCondition.notify_all();
+        for (auto& thread : mThreads) {
+            thread.join();
+        }
+    }
+
+    // Waits for frame |index| to be decoded and moves it into |bitmap|.
+    // Frames have to be taken in order.
+    void take(size_t index, SkBitmap* bitmap) {
+        std::unique_lock<std::mutex> lock(mLock);
+        mCondition.wait(lock, [&]() { return mDecoded.count(index) != 0; });
+        *bitmap = std::move(mDecoded[index]);
+        mDecoded.erase(index);
+        mNextToTake = index + 1;
+        mCondition.notify_all();
+    }
+
+private:
+    void decodeLoop() {
+        const size_t count = mPart.frames.size();
+        std::unique_lock<std::mutex> lock(mLock);
+        for (;;) {
+            mCondition.wait(lock, [&]() {
+                return mStopping || (mNextToDecode < count &&
+                                     mNextToDecode < mNextToTake + mCapacity);
+            });
+            if (mStopping) {
+                return;
+            }
+            const size_t index = mNextToDecode++;
+            const Animation::Frame& frame(mPart.frames[index]);
+
+            SkBitmap bitmap;
+            if (!isCompressedFrame(frame.name)) {
+                lock.unlock();
+                decodeFrame(frame.map, &bitmap);
+                lock.lock();
+            }
+            mDecoded[index] = std::move(bitmap);
+            mCondition.notify_all();
+        }
+    }
+
+    const Animation::Part& mPart;
+    const size_t mCapacity;
+    std::mutex mLock;
+    std::condition_variable mCondition;
+    size_t mNextToDecode = 0;
+    size_t mNextToTake = 0;
+    std::map<size_t, SkBitmap> mDecoded;
+    bool mStopping = false;
+    std::vector<std::thread> mThreads;
+};
+
 class BootAnimation::DisplayEventCallback : public LooperCallback {
     BootAnimation* mBootAnimation;
 
@@ -1063,6 +1203,9 @@ bool BootAnimation::movie() {
             (gl_extensions.find("GL_OES_texture_npot") != -1)) {
             mUseNpotTextures = true;
         }
+        if (gl_extensions.find("GL_OES_compressed_ETC1_RGB8_texture") != -1) {
+            mUseEtc1Textures = true;
+        }
     }
 
     // Blend required to draw time on top of animation frames.
@@ -1092,7 +1235,9 @@ bool BootAnimation::movie() {
         mTimeCheckThread->run("BootAnimation::TimeCheckThread", PRIORITY_NORMAL);
     }
 
+    mFrameStats = {};
     playAnimation(*mAnimation);
+    reportFrameStats();
 
     if (mTimeCheckThread != nullptr) {
         mTimeCheckThread->requestExit();
@@ -1118,6 +1263,7 @@ bool BootAnimation::playAnimation(const Animation& animation) {
     for (size_t i=0 ; i<pcount ; i++) {
         const Animation::Part& part(animation.parts[i]);
         const size_t fcount = part.frames.size();
+        FrameStats stats;
         glBindTexture(GL_TEXTURE_2D, 0);
 
         // Handle animation package
@@ -1141,6 +1287,14 @@ bool BootAnimation::playAnimation(const Animation& animation) {
                     part.backgroundColor[2],
                     1.0f);
 
+            // Looping parts keep their textures after the first pass, so only
+            // that pass needs frames decoded.
+            std::unique_ptr<FrameDecoder> decoder;
+            if (r == 0 && fcount > 1) {
+                decoder = std::make_unique<FrameDecoder>(part, DECODE_AHEAD_FRAMES,
+                                                         DECODE_THREADS);
+            }
+
             for (size_t j=0 ; j<fcount && (!exitPending() || part.playUntilComplete) ; j++) {
                 processDisplayEvents();
 
@@ -1159,8 +1313,23 @@ bool BootAnimation::playAnimation(const Animation& animation) {
                         glTexParameterx(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
                         glTexParameterx(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
                     }
+                    const nsecs_t textureStart = systemTime();
                     int w, h;
-                    initTexture(frame.map, &w, &h);
+                    if (isCompressedFrame(frame.name)) {
+                        if (decoder) {
+                            SkBitmap unused;
+                            decoder->take(j, &unused);
+                        }
+                        initCompressedTexture(frame.map, &w, &h);
+                    } else if (decoder) {
+                        SkBitmap bitmap;
+                        decoder->take(j, &bitmap);
+                        delete frame.map;
+                        initTexture(bitmap, &w, &h);
+                    } else {
+                        initTexture(frame.map, &w, &h);
+                    }
+                    stats.textureTime += systemTime() - textureStart;
                 }
 
                 const int xc = animationX + frame.trimX;
@@ -1194,6 +1363,12 @@ bool BootAnimation::playAnimation(const Animation& animation) {
                 //SLOGD("%lld, %lld", ns2ms(now - lastFrame), ns2ms(delay));
                 lastFrame = now;
 
+                stats.shown++;
+                if (delay < 0) {
+                    stats.late++;
+                    stats.maxLateness = std::max(stats.maxLateness, -delay);
+                }
+
                 if (delay > 0) {
                     struct timespec spec;
                     spec.tv_sec  = (now + delay) / 1000000000;
@@ -1214,6 +1389,16 @@ bool BootAnimation::playAnimation(const Animation& animation) {
                 break;
         }
 
+        if (stats.shown > 0) {
+            SLOGI("part%zu: %d frames shown, %d late (max %" PRId64 "ms), %" PRId64
+                    "ms loading textures", i, stats.shown, stats.late, ns2ms(stats.maxLateness),
+                    ns2ms(stats.textureTime));
+            mFrameStats.shown += stats.shown;
+            mFrameStats.late += stats.late;
+            mFrameStats.maxLateness = std::max(mFrameStats.maxLateness, stats.maxLateness);
+            mFrameStats.textureTime += stats.textureTime;
+        }
+
     }
 
     // Free textures created for looping parts now that the animation is done.
@@ -1230,6 +1415,18 @@ bool BootAnimation::playAnimation(const Animation& animation) {
     return true;
 }
 
+void BootAnimation::reportFrameStats() const {
+    SLOGI("%sAnimation frame stats: %d frames shown, %d late (max %" PRId64 "ms), %" PRId64
+            "ms loading textures", mShuttingDown ? "Shutdown" : "Boot", mFrameStats.shown,
+            mFrameStats.late, ns2ms(mFrameStats.maxLateness), ns2ms(mFrameStats.textureTime));
+
+    // shown,late,max lateness ms,texture loading ms
+    char value[PROPERTY_VALUE_MAX];
+    snprintf(value, sizeof(value), "%d,%d,%" PRId64 ",%" PRId64, mFrameStats.shown,
+            mFrameStats.late, ns2ms(mFrameStats.maxLateness), ns2ms(mFrameStats.textureTime));
+    property_set(FRAME_STATS_PROP_NAME, value);
+}
+
 void BootAnimation::processDisplayEvents() {
     // This will poll mDisplayEventReceiver and if there are new events it'll call
     // displayEventCallback synchronously.
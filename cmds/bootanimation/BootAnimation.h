@@ -148,13 +148,25 @@ private:
         BootAnimation* mBootAnimation;
     };
 
+    // Playback timing, logged per part and summarized in a property at exit.
+    struct FrameStats {
+        int shown = 0;
+        int late = 0;
+        nsecs_t maxLateness = 0;
+        nsecs_t textureTime = 0;
+    };
+
     // Display event handling
     class DisplayEventCallback;
     int displayEventCallback(int fd, int events, void* data);
     void processDisplayEvents();
 
+    class FrameDecoder;
+
     status_t initTexture(Texture* texture, AssetManager& asset, const char* name);
     status_t initTexture(FileMap* map, int* width, int* height);
+    status_t initTexture(const SkBitmap& bitmap, int* width, int* height);
+    status_t initCompressedTexture(FileMap* map, int* width, int* height);
     status_t initFont(Font* font, const char* fallback);
     bool android();
     bool movie();
@@ -163,6 +175,7 @@ private:
     bool validClock(const Animation::Part& part);
     Animation* loadAnimation(const String8&);
     bool playAnimation(const Animation&);
+    void reportFrameStats() const;
     void releaseAnimation(Animation*) const;
     bool parseAnimationDesc(Animation&);
     bool preloadZip(Animation &animation);
@@ -187,6 +200,7 @@ private:
     int         mCurrentInset;
     int         mTargetInset;
     bool        mUseNpotTextures = false;
+    bool        mUseEtc1Textures = false;
     EGLDisplay  mDisplay;
     EGLDisplay  mContext;
     EGLDisplay  mSurface;
@@ -202,6 +216,7 @@ private:
     sp<TimeCheckThread> mTimeCheckThread = nullptr;
     sp<Callbacks> mCallbacks;
     Animation* mAnimation = nullptr;
+    FrameStats mFrameStats;
     std::unique_ptr<DisplayEventReceiver> mDisplayEventReceiver;
     sp<Looper> mLooper;
 };
@@ -14,7 +14,6 @@
  * limitations under the License.
  */
 
-#include <fstream>
 #include <iostream>
 #include <memory>
 #include <sstream>
@@ -49,9 +48,7 @@ Result<Unit> Dump(const std::vector<std::string>& args) {
   if (!opts_ok) {
     return opts_ok.GetError();
   }
-  std::ifstream fin(idmap_path);
-  const auto idmap = Idmap::FromBinaryStream(fin);
-  fin.close();
+  const auto idmap = Idmap::FromFile(idmap_path);
   if (!idmap) {
     return Error(idmap.GetError(), "failed to load idmap");
   }
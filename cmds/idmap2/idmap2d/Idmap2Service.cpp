@@ -20,12 +20,17 @@
 #include <sys/types.h>  // umask
 #include <unistd.h>
 
+#include <algorithm>
+#include <atomic>
 #include <cerrno>
 #include <cstring>
 #include <fstream>
+#include <functional>
 #include <memory>
 #include <ostream>
 #include <string>
+#include <thread>
+#include <vector>
 
 #include "android-base/macros.h"
 #include "android-base/stringprintf.h"
@@ -35,17 +40,15 @@
 #include "idmap2/Idmap.h"
 #include "idmap2/Result.h"
 #include "idmap2/SysTrace.h"
-#include "idmap2/ZipFile.h"
 #include "utils/String8.h"
 
+using android::ApkAssets;
 using android::IPCThreadState;
 using android::base::StringPrintf;
 using android::binder::Status;
 using android::idmap2::BinaryStreamVisitor;
-using android::idmap2::GetPackageCrc;
 using android::idmap2::Idmap;
 using android::idmap2::IdmapHeader;
-using android::idmap2::ZipFile;
 using android::idmap2::utils::kIdmapCacheDir;
 using android::idmap2::utils::kIdmapFilePermissionMask;
 using android::idmap2::utils::UidHasWriteAccessToPath;
@@ -54,7 +57,7 @@ using PolicyBitmask = android::ResTable_overlayable_policy_header::PolicyBitmask
 
 namespace {
 
-constexpr const char* kFrameworkPath = "/system/framework/framework-res.apk";
+constexpr const char* kPackageCrcCacheFile = "/.idmap2d_package_crcs";
 
 Status ok() {
   return Status::ok();
@@ -69,18 +72,71 @@ PolicyBitmask ConvertAidlArgToPolicyBitmask(int32_t arg) {
   return static_cast<PolicyBitmask>(arg);
 }
 
-Status GetCrc(const std::string& apk_path, uint32_t* out_crc) {
-  const auto zip = ZipFile::Open(apk_path);
-  if (!zip) {
-    return error(StringPrintf("failed to open apk %s", apk_path.c_str()));
+// Upper bound of the threads a batch call uses.
+constexpr size_t kMaxBatchThreads = 4;
+
+// Runs fn(0) to fn(count - 1) on up to kMaxBatchThreads threads, the calling thread included.
+void ParallelFor(size_t count, const std::function<void(size_t)>& fn) {
+  std::atomic<size_t> next(0);
+  auto worker = [&]() {
+    for (size_t i = next++; i < count; i = next++) {
+      fn(i);
+    }
+  };
+  const size_t thread_count =
+      std::min({kMaxBatchThreads, count,
+                static_cast<size_t>(std::max(1U, std::thread::hardware_concurrency()))});
+  std::vector<std::thread> threads;
+  for (size_t i = 1; i < thread_count; i++) {
+    threads.emplace_back(worker);
+  }
+  worker();
+  for (std::thread& thread : threads) {
+    thread.join();
   }
+}
 
-  const auto crc = GetPackageCrc(*zip);
-  if (!crc) {
-    return error(crc.GetErrorMessage());
+Status VerifyIdmap(const std::string& idmap_path, const std::string& target_apk_path,
+                   uint32_t target_crc, const std::string& overlay_apk_path, uint32_t overlay_crc,
+                   PolicyBitmask fulfilled_policies, bool enforce_overlayable, bool* up_to_date) {
+  auto result =
+      IdmapHeader::IsFileUpToDate(idmap_path, target_apk_path.c_str(), overlay_apk_path.c_str(),
+                                  target_crc, overlay_crc, fulfilled_policies, enforce_overlayable);
+  *up_to_date = static_cast<bool>(result);
+  return *up_to_date ? ok() : error(result.GetErrorMessage());
+}
+
+Status WriteIdmap(const ApkAssets& target_apk, const std::string& overlay_apk_path,
+                  PolicyBitmask fulfilled_policies, bool enforce_overlayable,
+                  const std::string& idmap_path) {
+  const std::unique_ptr<const ApkAssets> overlay_apk = ApkAssets::Load(overlay_apk_path);
+  if (!overlay_apk) {
+    return error("failed to load apk " + overlay_apk_path);
   }
 
-  *out_crc = *crc;
+  const auto idmap =
+      Idmap::FromApkAssets(target_apk, *overlay_apk, fulfilled_policies, enforce_overlayable);
+  if (!idmap) {
+    return error(idmap.GetErrorMessage());
+  }
+
+  // idmap files are mapped with mmap in libandroidfw. Deleting and recreating the idmap guarantees
+  // that existing memory maps will continue to be valid and unaffected.
+  unlink(idmap_path.c_str());
+
+  umask(kIdmapFilePermissionMask);
+  std::ofstream fout(idmap_path);
+  if (fout.fail()) {
+    return error("failed to open idmap path " + idmap_path);
+  }
+
+  BinaryStreamVisitor visitor(fout);
+  (*idmap)->accept(&visitor);
+  fout.close();
+  if (fout.fail()) {
+    unlink(idmap_path.c_str());
+    return error("failed to write to idmap path " + idmap_path);
+  }
   return ok();
 }
 
@@ -88,6 +144,19 @@ Status GetCrc(const std::string& apk_path, uint32_t* out_crc) {
 
 namespace android::os {
 
+Idmap2Service::Idmap2Service()
+    : crc_cache_(std::string(kIdmapCacheDir) + kPackageCrcCacheFile) {
+}
+
+Status Idmap2Service::GetCrc(const std::string& apk_path, uint32_t* out_crc) {
+  const auto crc = crc_cache_.Get(apk_path);
+  if (!crc) {
+    return error(crc.GetErrorMessage());
+  }
+  *out_crc = *crc;
+  return ok();
+}
+
 Status Idmap2Service::getIdmapPath(const std::string& overlay_apk_path,
                                    int32_t user_id ATTRIBUTE_UNUSED, std::string* _aidl_return) {
   assert(_aidl_return);
@@ -123,44 +192,24 @@ Status Idmap2Service::verifyIdmap(const std::string& target_apk_path,
   assert(_aidl_return);
 
   const std::string idmap_path = Idmap::CanonicalIdmapPathFor(kIdmapCacheDir, overlay_apk_path);
-  std::ifstream fin(idmap_path);
-  const std::unique_ptr<const IdmapHeader> header = IdmapHeader::FromBinaryStream(fin);
-  fin.close();
-  if (!header) {
-    *_aidl_return = false;
-    return error("failed to parse idmap header");
-  }
-
+  *_aidl_return = false;
   uint32_t target_crc;
-  if (target_apk_path == kFrameworkPath && android_crc_) {
-    target_crc = *android_crc_;
-  } else {
-    auto target_crc_status = GetCrc(target_apk_path, &target_crc);
-    if (!target_crc_status.isOk()) {
-      *_aidl_return = false;
-      return target_crc_status;
-    }
-
-    // Loading the framework zip can take several milliseconds. Cache the crc of the framework
-    // resource APK to reduce repeated work during boot.
-    if (target_apk_path == kFrameworkPath) {
-      android_crc_ = target_crc;
-    }
+  auto crc_status = GetCrc(target_apk_path, &target_crc);
+  if (!crc_status.isOk()) {
+    return crc_status;
   }
 
   uint32_t overlay_crc;
-  auto overlay_crc_status = GetCrc(overlay_apk_path, &overlay_crc);
-  if (!overlay_crc_status.isOk()) {
-    *_aidl_return = false;
-    return overlay_crc_status;
+  crc_status = GetCrc(overlay_apk_path, &overlay_crc);
+  if (!crc_status.isOk()) {
+    return crc_status;
   }
 
-  auto up_to_date =
-      header->IsUpToDate(target_apk_path.c_str(), overlay_apk_path.c_str(), target_crc, overlay_crc,
-                         ConvertAidlArgToPolicyBitmask(fulfilled_policies), enforce_overlayable);
-
-  *_aidl_return = static_cast<bool>(up_to_date);
-  return *_aidl_return ? ok() : error(up_to_date.GetErrorMessage());
+  auto status = VerifyIdmap(idmap_path, target_apk_path, target_crc, overlay_apk_path, overlay_crc,
+                            ConvertAidlArgToPolicyBitmask(fulfilled_policies), enforce_overlayable,
+                            _aidl_return);
+  crc_cache_.Persist();
+  return status;
 }
 
 Status Idmap2Service::createIdmap(const std::string& target_apk_path,
@@ -185,36 +234,85 @@ Status Idmap2Service::createIdmap(const std::string& target_apk_path,
     return error("failed to load apk " + target_apk_path);
   }
 
-  const std::unique_ptr<const ApkAssets> overlay_apk = ApkAssets::Load(overlay_apk_path);
-  if (!overlay_apk) {
-    return error("failed to load apk " + overlay_apk_path);
+  auto status =
+      WriteIdmap(*target_apk, overlay_apk_path, policy_bitmask, enforce_overlayable, idmap_path);
+  if (!status.isOk()) {
+    return status;
   }
 
-  const auto idmap =
-      Idmap::FromApkAssets(*target_apk, *overlay_apk, policy_bitmask, enforce_overlayable);
-  if (!idmap) {
-    return error(idmap.GetErrorMessage());
+  *_aidl_return = aidl::make_nullable<std::string>(idmap_path);
+  return ok();
+}
+
+Status Idmap2Service::createIdmaps(const std::string& target_apk_path,
+                                   const std::vector<std::string>& overlay_apk_paths,
+                                   int32_t fulfilled_policies, bool enforce_overlayable,
+                                   int32_t user_id ATTRIBUTE_UNUSED,
+                                   std::vector<std::string>* _aidl_return) {
+  assert(_aidl_return);
+  SYSTRACE << "Idmap2Service::createIdmaps " << target_apk_path << " "
+           << overlay_apk_paths.size() << " overlays";
+  _aidl_return->assign(overlay_apk_paths.size(), "");
+
+  const PolicyBitmask policy_bitmask = ConvertAidlArgToPolicyBitmask(fulfilled_policies);
+  const uid_t uid = IPCThreadState::self()->getCallingUid();
+
+  uint32_t target_crc;
+  auto target_crc_status = GetCrc(target_apk_path, &target_crc);
+  if (!target_crc_status.isOk()) {
+    return target_crc_status;
   }
 
-  // idmap files are mapped with mmap in libandroidfw. Deleting and recreating the idmap guarantees
-  // that existing memory maps will continue to be valid and unaffected.
-  unlink(idmap_path.c_str());
+  // Most idmaps are up to date at boot, so check them all before loading the target.
+  std::vector<std::string> idmap_paths(overlay_apk_paths.size());
+  std::vector<char> stale(overlay_apk_paths.size(), false);
+  ParallelFor(overlay_apk_paths.size(), [&](size_t i) {
+    idmap_paths[i] = Idmap::CanonicalIdmapPathFor(kIdmapCacheDir, overlay_apk_paths[i]);
+    if (!UidHasWriteAccessToPath(uid, idmap_paths[i])) {
+      LOG(ERROR) << StringPrintf("will not write to %s: calling uid %d lacks write access",
+                                 idmap_paths[i].c_str(), uid);
+      return;
+    }
+    uint32_t overlay_crc;
+    bool up_to_date = false;
+    if (GetCrc(overlay_apk_paths[i], &overlay_crc).isOk()) {
+      VerifyIdmap(idmap_paths[i], target_apk_path, target_crc, overlay_apk_paths[i], overlay_crc,
+                  policy_bitmask, enforce_overlayable, &up_to_date);
+    }
+    if (up_to_date) {
+      (*_aidl_return)[i] = idmap_paths[i];
+    } else {
+      stale[i] = true;
+    }
+  });
 
-  umask(kIdmapFilePermissionMask);
-  std::ofstream fout(idmap_path);
-  if (fout.fail()) {
-    return error("failed to open idmap path " + idmap_path);
+  crc_cache_.Persist();
+
+  std::vector<size_t> stale_indices;
+  for (size_t i = 0; i < stale.size(); i++) {
+    if (stale[i]) {
+      stale_indices.push_back(i);
+    }
+  }
+  if (stale_indices.empty()) {
+    return ok();
   }
 
-  BinaryStreamVisitor visitor(fout);
-  (*idmap)->accept(&visitor);
-  fout.close();
-  if (fout.fail()) {
-    unlink(idmap_path.c_str());
-    return error("failed to write to idmap path " + idmap_path);
+  // The target is loaded once for all the overlays. ApkAssets is immutable once loaded, and
+  // every mapping uses its own AssetManager2, so the mappings can be computed in parallel.
+  const std::unique_ptr<const ApkAssets> target_apk = ApkAssets::Load(target_apk_path);
+  if (!target_apk) {
+    return error("failed to load apk " + target_apk_path);
   }
 
-  *_aidl_return = aidl::make_nullable<std::string>(idmap_path);
+  ParallelFor(stale_indices.size(), [&](size_t j) {
+    const size_t i = stale_indices[j];
+    if (WriteIdmap(*target_apk, overlay_apk_paths[i], policy_bitmask, enforce_overlayable,
+                   idmap_paths[i])
+            .isOk()) {
+      (*_aidl_return)[i] = idmap_paths[i];
+    }
+  });
   return ok();
 }
 
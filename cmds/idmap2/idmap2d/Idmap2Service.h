@@ -21,12 +21,19 @@
 #include <binder/BinderService.h>
 #include <binder/Nullable.h>
 
+#include <optional>
+#include <string>
+#include <vector>
+
 #include "android/os/BnIdmap2.h"
+#include "idmap2d/PackageCrcCache.h"
 
 namespace android::os {
 
 class Idmap2Service : public BinderService<Idmap2Service>, public BnIdmap2 {
  public:
+  Idmap2Service();
+
   static char const* getServiceName() {
     return "idmap";
   }
@@ -47,9 +54,21 @@ class Idmap2Service : public BinderService<Idmap2Service>, public BnIdmap2 {
                              bool enforce_overlayable, int32_t user_id,
                              aidl::nullable<std::string>* _aidl_return) override;
 
+  // Batch version of verifyIdmap and createIdmap for overlays of the same target, e.g. when
+  // all the overlays are scanned at boot. Stale idmaps are recreated, loading the target once
+  // and computing the mappings in parallel. Returns the idmap path of each overlay, or an
+  // empty string if its idmap could not be created.
+  binder::Status createIdmaps(const std::string& target_apk_path,
+                              const std::vector<std::string>& overlay_apk_paths,
+                              int32_t fulfilled_policies, bool enforce_overlayable,
+                              int32_t user_id, std::vector<std::string>* _aidl_return);
+
  private:
-  // Cache the crc of the android framework package since the crc cannot change without a reboot.
-  std::optional<uint32_t> android_crc_;
+  binder::Status GetCrc(const std::string& apk_path, uint32_t* out_crc);
+
+  // Computing the crc of a package opens its zip, which can take several milliseconds for the
+  // framework. The crcs are cached across calls and reboots.
+  PackageCrcCache crc_cache_;
 };
 
 }  // namespace android::os
@@ -0,0 +1,137 @@
+/*
+ * Copyright (C) 2020 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "idmap2d/PackageCrcCache.h"
+
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <cinttypes>
+#include <cstdio>
+#include <fstream>
+#include <sstream>
+#include <utility>
+
+#include "android-base/file.h"
+#include "android-base/logging.h"
+#include "android-base/stringprintf.h"
+#include "idmap2/Idmap.h"
+#include "idmap2/ZipFile.h"
+
+using android::base::StringPrintf;
+using android::idmap2::Error;
+using android::idmap2::GetPackageCrc;
+using android::idmap2::Result;
+using android::idmap2::ZipFile;
+
+namespace {
+
+// Bump when the way the crcs are computed changes.
+constexpr const char* kFileHeader = "idmap2d package crcs v1";
+
+int64_t MtimeNs(const struct stat& st) {
+  return static_cast<int64_t>(st.st_mtim.tv_sec) * 1000000000 + st.st_mtim.tv_nsec;
+}
+
+}  // namespace
+
+namespace android::os {
+
+PackageCrcCache::PackageCrcCache(std::string file_path) : file_path_(std::move(file_path)) {
+  Load();
+}
+
+void PackageCrcCache::Load() {
+  std::ifstream fin(file_path_);
+  std::string line;
+  if (!std::getline(fin, line) || line != kFileHeader) {
+    return;
+  }
+  while (std::getline(fin, line)) {
+    std::istringstream record(line);
+    Entry entry;
+    uint64_t dev;
+    uint64_t ino;
+    std::string path;
+    record >> std::hex >> entry.crc >> std::dec >> dev >> ino >> entry.size >> entry.mtime_ns;
+    if (record.fail() || record.get() != ' ' || !std::getline(record, path) || path.empty()) {
+      LOG(WARNING) << "ignoring malformed entry in " << file_path_;
+      entries_.clear();
+      return;
+    }
+    entry.dev = static_cast<dev_t>(dev);
+    entry.ino = static_cast<ino_t>(ino);
+    entries_[path] = entry;
+  }
+}
+
+Result<uint32_t> PackageCrcCache::Get(const std::string& apk_path) {
+  struct stat st;
+  if (stat(apk_path.c_str(), &st) != 0) {
+    return Error("failed to stat apk %s", apk_path.c_str());
+  }
+
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto it = entries_.find(apk_path);
+    if (it != entries_.end() && it->second.dev == st.st_dev && it->second.ino == st.st_ino &&
+        it->second.size == st.st_size && it->second.mtime_ns == MtimeNs(st)) {
+      return it->second.crc;
+    }
+  }
+
+  const auto zip = ZipFile::Open(apk_path);
+  if (!zip) {
+    return Error("failed to open apk %s", apk_path.c_str());
+  }
+  const auto crc = GetPackageCrc(*zip);
+  if (!crc) {
+    return crc.GetError();
+  }
+
+  std::lock_guard<std::mutex> lock(mutex_);
+  entries_[apk_path] = Entry{st.st_dev, st.st_ino, st.st_size, MtimeNs(st), *crc};
+  dirty_ = true;
+  return *crc;
+}
+
+void PackageCrcCache::Persist() {
+  std::string content;
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (!dirty_) {
+      return;
+    }
+    dirty_ = false;
+    content = std::string(kFileHeader) + "\n";
+    for (const auto& [path, entry] : entries_) {
+      content += StringPrintf("%08x %" PRIu64 " %" PRIu64 " %" PRId64 " %" PRId64 " %s\n",
+                              entry.crc, static_cast<uint64_t>(entry.dev),
+                              static_cast<uint64_t>(entry.ino), static_cast<int64_t>(entry.size),
+                              entry.mtime_ns, path.c_str());
+    }
+  }
+
+  // Write to a temporary file first so that a crash never leaves a truncated cache behind.
+  const std::string tmp_path = file_path_ + ".tmp";
+  if (!base::WriteStringToFile(content, tmp_path) ||
+      rename(tmp_path.c_str(), file_path_.c_str()) != 0) {
+    PLOG(WARNING) << "failed to write " << file_path_;
+    unlink(tmp_path.c_str());
+  }
+}
+
+}  // namespace android::os
@@ -0,0 +1,63 @@
+/*
+ * Copyright (C) 2020 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef IDMAP2_IDMAP2D_PACKAGECRCCACHE_H_
+#define IDMAP2_IDMAP2D_PACKAGECRCCACHE_H_
+
+#include <sys/types.h>
+
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+
+#include "idmap2/Result.h"
+
+namespace android::os {
+
+// Caches the package crcs (see idmap2::GetPackageCrc) of apks by path. An entry stays valid as
+// long as the device, inode, size and modification time of the apk are unchanged, so the crc of
+// an unchanged apk costs a stat instead of opening the zip. The cache is written to disk to keep
+// it across reboots. Thread safe.
+class PackageCrcCache {
+ public:
+  explicit PackageCrcCache(std::string file_path);
+
+  idmap2::Result<uint32_t> Get(const std::string& apk_path);
+
+  // Writes the cache to its file if entries were added since it was last written.
+  void Persist();
+
+ private:
+  struct Entry {
+    dev_t dev;
+    ino_t ino;
+    off_t size;
+    int64_t mtime_ns;
+    uint32_t crc;
+  };
+
+  void Load();
+
+  const std::string file_path_;
+  std::mutex mutex_;
+  std::unordered_map<std::string, Entry> entries_;  // GUARDED_BY(mutex_)
+  bool dirty_ = false;                              // GUARDED_BY(mutex_)
+};
+
+}  // namespace android::os
+
+#endif  // IDMAP2_IDMAP2D_PACKAGECRCCACHE_H_
@@ -94,6 +94,11 @@ static constexpr const uint32_t kIdmapCurrentVersion = android::kIdmapCurrentVer
 // terminating null)
 static constexpr const size_t kIdmapStringLength = 256;
 
+// size of the part of the idmap header before the debug info: magic, version, target and overlay
+// crcs, fulfilled policies, enforce overlayable and the target and overlay paths
+static constexpr const size_t kIdmapFixedHeaderSize = 5 * sizeof(uint32_t) + sizeof(uint8_t) +
+                                                       2 * kIdmapStringLength;
+
 // Retrieves a crc generated using all of the files within the zip that can affect idmap generation.
 Result<uint32_t> GetPackageCrc(const ZipFile& zip_info);
 
@@ -101,6 +106,9 @@ class IdmapHeader {
  public:
   static std::unique_ptr<const IdmapHeader> FromBinaryStream(std::istream& stream);
 
+  // Parses the header at the start of data and advances data past it.
+  static std::unique_ptr<const IdmapHeader> FromBuffer(StringPiece* data);
+
   inline uint32_t GetMagic() const {
     return magic_;
   }
@@ -146,6 +154,14 @@ class IdmapHeader {
                           uint32_t overlay_crc, PolicyBitmask fulfilled_policies,
                           bool enforce_overlayable) const;
 
+  // Same as IsUpToDate for the idmap file at idmap_path, but the header is not parsed: the first
+  // kIdmapFixedHeaderSize bytes of the file are compared to those of an up-to-date header. The
+  // header is only parsed to tell why an idmap is out of date.
+  static Result<Unit> IsFileUpToDate(const std::string& idmap_path, const char* target_path,
+                                     const char* overlay_path, uint32_t target_crc,
+                                     uint32_t overlay_crc, PolicyBitmask fulfilled_policies,
+                                     bool enforce_overlayable);
+
   void accept(Visitor* v) const;
 
  private:
@@ -224,6 +240,9 @@ class IdmapData {
 
   static std::unique_ptr<const IdmapData> FromBinaryStream(std::istream& stream);
 
+  // Parses the data block at the start of data and advances data past it.
+  static std::unique_ptr<const IdmapData> FromBuffer(StringPiece* data);
+
   static Result<std::unique_ptr<const IdmapData>> FromResourceMapping(
       const ResourceMapping& resource_mapping);
 
@@ -265,6 +284,14 @@ class Idmap {
 
   static Result<std::unique_ptr<const Idmap>> FromBinaryStream(std::istream& stream);
 
+  // Parses an idmap held in memory. The entry arrays are laid out as the packed structs shared
+  // with libandroidfw (Idmap_target_entry, Idmap_overlay_entry), which are read in place after a
+  // single bounds check per array.
+  static Result<std::unique_ptr<const Idmap>> FromBuffer(const StringPiece& data);
+
+  // Maps the idmap file at idmap_path and parses it with FromBuffer.
+  static Result<std::unique_ptr<const Idmap>> FromFile(const std::string& idmap_path);
+
   // In the current version of idmap, the first package in each resources.arsc
   // file is used; change this in the next version of idmap to use a named
   // package instead; also update FromApkAssets to take additional parameters:
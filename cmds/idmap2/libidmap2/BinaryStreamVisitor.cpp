@@ -19,6 +19,7 @@
 #include <algorithm>
 #include <cstring>
 #include <string>
+#include <vector>
 
 #include "android-base/macros.h"
 
@@ -74,16 +75,22 @@ void BinaryStreamVisitor::visit(const IdmapHeader& header) {
 }
 
 void BinaryStreamVisitor::visit(const IdmapData& data) {
+  // Lay the entries out as the packed structs read by libandroidfw and write each array at once.
+  std::vector<Idmap_target_entry> target_entries;
+  target_entries.reserve(data.GetTargetEntries().size());
   for (const auto& target_entry : data.GetTargetEntries()) {
-    Write32(target_entry.target_id);
-    Write8(target_entry.data_type);
-    Write32(target_entry.data_value);
+    target_entries.push_back(Idmap_target_entry{
+        htodl(target_entry.target_id), target_entry.data_type, htodl(target_entry.data_value)});
   }
+  Write(target_entries.data(), target_entries.size() * sizeof(Idmap_target_entry));
 
+  std::vector<Idmap_overlay_entry> overlay_entries;
+  overlay_entries.reserve(data.GetOverlayEntries().size());
   for (const auto& overlay_entry : data.GetOverlayEntries()) {
-    Write32(overlay_entry.overlay_id);
-    Write32(overlay_entry.target_id);
+    overlay_entries.push_back(
+        Idmap_overlay_entry{htodl(overlay_entry.overlay_id), htodl(overlay_entry.target_id)});
   }
+  Write(overlay_entries.data(), overlay_entries.size() * sizeof(Idmap_overlay_entry));
 
   Write(data.GetStringPoolData(), data.GetHeader()->GetStringPoolLength());
 }
@@ -16,7 +16,15 @@
 
 #include "idmap2/Idmap.h"
 
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
 #include <algorithm>
+#include <cstddef>
+#include <cstring>
+#include <fstream>
 #include <iostream>
 #include <iterator>
 #include <limits>
@@ -27,8 +35,11 @@
 #include <utility>
 #include <vector>
 
+#include "android-base/file.h"
 #include "android-base/macros.h"
+#include "android-base/mapped_file.h"
 #include "android-base/stringprintf.h"
+#include "android-base/unique_fd.h"
 #include "androidfw/AssetManager2.h"
 #include "idmap2/ResourceMapping.h"
 #include "idmap2/ResourceUtils.h"
@@ -60,44 +71,32 @@ bool WARN_UNUSED Read32(std::istream& stream, uint32_t* out) {
   return false;
 }
 
-bool WARN_UNUSED ReadBuffer(std::istream& stream, std::unique_ptr<uint8_t[]>* out, size_t length) {
-  auto buffer = std::unique_ptr<uint8_t[]>(new uint8_t[length]);
-  if (stream.read(reinterpret_cast<char*>(buffer.get()), length)) {
-    *out = std::move(buffer);
-    return true;
-  }
-  return false;
-}
-
-// a string is encoded as a kIdmapStringLength char array; the array is always null-terminated
-bool WARN_UNUSED ReadString256(std::istream& stream, char out[kIdmapStringLength]) {
-  char buf[kIdmapStringLength];
-  memset(buf, 0, sizeof(buf));
-  if (!stream.read(buf, sizeof(buf))) {
-    return false;
-  }
-  if (buf[sizeof(buf) - 1] != '\0') {
+// Sets out to the count consecutive T at the start of data and advances data past them. The idmap
+// structs shared with libandroidfw are packed, so they can be read in place.
+template <typename T>
+bool WARN_UNUSED ReadArray(StringPiece* data, size_t count, const T** out) {
+  if (data->size() / sizeof(T) < count) {
     return false;
   }
-  memcpy(out, buf, sizeof(buf));
+  *out = reinterpret_cast<const T*>(data->data());
+  *data = data->substr(count * sizeof(T));
   return true;
 }
 
-Result<std::string> ReadString(std::istream& stream) {
-  uint32_t size;
-  if (!Read32(stream, &size)) {
-    return Error("failed to read string size");
-  }
-  if (size == 0) {
-    return std::string("");
-  }
-  std::string buf(size, '\0');
-  if (!stream.read(buf.data(), size)) {
-    return Error("failed to read string of size %u", size);
-  }
-  // buf is guaranteed to be null terminated (with enough nulls to end on a word boundary)
-  buf.resize(strlen(buf.c_str()));
-  return buf;
+// Reads what is left of the stream, hands it to parse and leaves the stream positioned after the
+// bytes parse consumed, as if they had been read field by field.
+template <typename T>
+T ParseStream(std::istream& stream, T (*parse)(StringPiece*)) {
+  const std::streampos start = stream.tellg();
+  const std::string buffer{std::istreambuf_iterator<char>(stream),
+                           std::istreambuf_iterator<char>()};
+  StringPiece data(buffer);
+  T result = parse(&data);
+  if (result && start != std::streampos(-1)) {
+    stream.clear();
+    stream.seekg(start + std::streamoff(buffer.size() - data.size()));
+  }
+  return result;
 }
 
 }  // namespace
@@ -111,23 +110,55 @@ Result<uint32_t> GetPackageCrc(const ZipFile& zip) {
 }
 
 std::unique_ptr<const IdmapHeader> IdmapHeader::FromBinaryStream(std::istream& stream) {
-  std::unique_ptr<IdmapHeader> idmap_header(new IdmapHeader());
-  uint8_t enforce_overlayable;
-  if (!Read32(stream, &idmap_header->magic_) || !Read32(stream, &idmap_header->version_) ||
-      !Read32(stream, &idmap_header->target_crc_) || !Read32(stream, &idmap_header->overlay_crc_) ||
-      !Read32(stream, &idmap_header->fulfilled_policies_) || !Read8(stream, &enforce_overlayable) ||
-      !ReadString256(stream, idmap_header->target_path_) ||
-      !ReadString256(stream, idmap_header->overlay_path_)) {
+  // Only read as far as the header goes: callers often only need the header of a large idmap.
+  std::string buffer(sizeof(Idmap_header), '\0');
+  if (!stream.read(buffer.data(), buffer.size())) {
     return nullptr;
   }
+  const uint32_t debug_info_size =
+      dtohl(reinterpret_cast<const Idmap_header*>(buffer.data())->debug_info_size);
+  std::string debug_info(debug_info_size, '\0');
+  if (!stream.read(debug_info.data(), debug_info.size())) {
+    return nullptr;
+  }
+  buffer += debug_info;
+  StringPiece data(buffer);
+  return FromBuffer(&data);
+}
 
-  idmap_header->enforce_overlayable_ = static_cast<bool>(enforce_overlayable);
+std::unique_ptr<const IdmapHeader> IdmapHeader::FromBuffer(StringPiece* data) {
+  static_assert(sizeof(Idmap_header::target_path) == kIdmapStringLength);
+  static_assert(sizeof(Idmap_header::overlay_path) == kIdmapStringLength);
+  static_assert(offsetof(Idmap_header, debug_info_size) == kIdmapFixedHeaderSize);
 
-  auto debug_str = ReadString(stream);
-  if (!debug_str) {
+  const Idmap_header* header;
+  if (!ReadArray(data, 1, &header)) {
     return nullptr;
   }
-  idmap_header->debug_info_ = std::move(*debug_str);
+
+  // the strings are always null-terminated
+  if (header->target_path[kIdmapStringLength - 1] != '\0' ||
+      header->overlay_path[kIdmapStringLength - 1] != '\0') {
+    return nullptr;
+  }
+
+  const char* debug_info;
+  const uint32_t debug_info_size = dtohl(header->debug_info_size);
+  if (!ReadArray(data, debug_info_size, &debug_info)) {
+    return nullptr;
+  }
+
+  std::unique_ptr<IdmapHeader> idmap_header(new IdmapHeader());
+  idmap_header->magic_ = dtohl(header->magic);
+  idmap_header->version_ = dtohl(header->version);
+  idmap_header->target_crc_ = dtohl(header->target_crc32);
+  idmap_header->overlay_crc_ = dtohl(header->overlay_crc32);
+  idmap_header->fulfilled_policies_ = dtohl(header->fulfilled_policies);
+  idmap_header->enforce_overlayable_ = static_cast<bool>(header->enforce_overlayable);
+  memcpy(idmap_header->target_path_, header->target_path, kIdmapStringLength);
+  memcpy(idmap_header->overlay_path_, header->overlay_path, kIdmapStringLength);
+  // the debug info is padded with nulls to a word boundary
+  idmap_header->debug_info_.assign(debug_info, strnlen(debug_info, debug_info_size));
 
   return std::move(idmap_header);
 }
@@ -220,35 +251,57 @@ std::unique_ptr<const IdmapData::Header> IdmapData::Header::FromBinaryStream(std
 }
 
 std::unique_ptr<const IdmapData> IdmapData::FromBinaryStream(std::istream& stream) {
-  std::unique_ptr<IdmapData> data(new IdmapData());
-  data->header_ = IdmapData::Header::FromBinaryStream(stream);
-  if (!data->header_) {
+  return ParseStream(stream, &IdmapData::FromBuffer);
+}
+
+std::unique_ptr<const IdmapData> IdmapData::FromBuffer(StringPiece* buffer) {
+  const Idmap_data_header* header;
+  if (!ReadArray(buffer, 1, &header)) {
     return nullptr;
   }
+
+  std::unique_ptr<IdmapData::Header> data_header(new IdmapData::Header());
+  data_header->target_package_id_ = header->target_package_id;
+  data_header->overlay_package_id_ = header->overlay_package_id;
+  data_header->target_entry_count = dtohl(header->target_entry_count);
+  data_header->overlay_entry_count = dtohl(header->overlay_entry_count);
+  data_header->string_pool_index_offset = dtohl(header->string_pool_index_offset);
+  data_header->string_pool_len = dtohl(header->string_pool_length);
+
   // Read the mapping of target resource id to overlay resource value.
-  for (size_t i = 0; i < data->header_->GetTargetEntryCount(); i++) {
-    TargetEntry target_entry{};
-    if (!Read32(stream, &target_entry.target_id) || !Read8(stream, &target_entry.data_type) ||
-        !Read32(stream, &target_entry.data_value)) {
-      return nullptr;
-    }
-    data->target_entries_.emplace_back(target_entry);
+  const Idmap_target_entry* target_entries;
+  if (!ReadArray(buffer, data_header->target_entry_count, &target_entries)) {
+    return nullptr;
   }
 
   // Read the mapping of overlay resource id to target resource id.
-  for (size_t i = 0; i < data->header_->GetOverlayEntryCount(); i++) {
-    OverlayEntry overlay_entry{};
-    if (!Read32(stream, &overlay_entry.overlay_id) || !Read32(stream, &overlay_entry.target_id)) {
-      return nullptr;
-    }
-    data->overlay_entries_.emplace_back(overlay_entry);
+  const Idmap_overlay_entry* overlay_entries;
+  if (!ReadArray(buffer, data_header->overlay_entry_count, &overlay_entries)) {
+    return nullptr;
   }
 
   // Read raw string pool bytes.
-  if (!ReadBuffer(stream, &data->string_pool_, data->header_->string_pool_len)) {
+  const uint8_t* string_pool;
+  if (!ReadArray(buffer, data_header->string_pool_len, &string_pool)) {
     return nullptr;
   }
 
+  std::unique_ptr<IdmapData> data(new IdmapData());
+  data->target_entries_.reserve(data_header->target_entry_count);
+  for (size_t i = 0; i < data_header->target_entry_count; i++) {
+    data->target_entries_.emplace_back(TargetEntry{dtohl(target_entries[i].target_id),
+                                                   target_entries[i].type,
+                                                   dtohl(target_entries[i].value)});
+  }
+  data->overlay_entries_.reserve(data_header->overlay_entry_count);
+  for (size_t i = 0; i < data_header->overlay_entry_count; i++) {
+    data->overlay_entries_.emplace_back(
+        OverlayEntry{dtohl(overlay_entries[i].overlay_id), dtohl(overlay_entries[i].target_id)});
+  }
+  data->string_pool_ = std::unique_ptr<uint8_t[]>(new uint8_t[data_header->string_pool_len]);
+  memcpy(data->string_pool_.get(), string_pool, data_header->string_pool_len);
+  data->header_ = std::move(data_header);
+
   return std::move(data);
 }
 
@@ -263,9 +316,17 @@ std::string Idmap::CanonicalIdmapPathFor(const std::string& absolute_dir,
 
 Result<std::unique_ptr<const Idmap>> Idmap::FromBinaryStream(std::istream& stream) {
   SYSTRACE << "Idmap::FromBinaryStream";
+  const std::string buffer{std::istreambuf_iterator<char>(stream),
+                           std::istreambuf_iterator<char>()};
+  return FromBuffer(buffer);
+}
+
+Result<std::unique_ptr<const Idmap>> Idmap::FromBuffer(const StringPiece& data) {
+  SYSTRACE << "Idmap::FromBuffer";
   std::unique_ptr<Idmap> idmap(new Idmap());
+  StringPiece remaining = data;
 
-  idmap->header_ = IdmapHeader::FromBinaryStream(stream);
+  idmap->header_ = IdmapHeader::FromBuffer(&remaining);
   if (!idmap->header_) {
     return Error("failed to parse idmap header");
   }
@@ -273,16 +334,36 @@ Result<std::unique_ptr<const Idmap>> Idmap::FromBinaryStream(std::istream& strea
   // idmap version 0x01 does not specify the number of data blocks that follow
   // the idmap header; assume exactly one data block
   for (int i = 0; i < 1; i++) {
-    std::unique_ptr<const IdmapData> data = IdmapData::FromBinaryStream(stream);
-    if (!data) {
+    std::unique_ptr<const IdmapData> idmap_data = IdmapData::FromBuffer(&remaining);
+    if (!idmap_data) {
       return Error("failed to parse data block %d", i);
     }
-    idmap->data_.push_back(std::move(data));
+    idmap->data_.push_back(std::move(idmap_data));
   }
 
   return {std::move(idmap)};
 }
 
+Result<std::unique_ptr<const Idmap>> Idmap::FromFile(const std::string& idmap_path) {
+  SYSTRACE << "Idmap::FromFile " << idmap_path;
+  const base::unique_fd fd(TEMP_FAILURE_RETRY(open(idmap_path.c_str(), O_RDONLY | O_CLOEXEC)));
+  if (fd < 0) {
+    return Error("failed to open idmap %s", idmap_path.c_str());
+  }
+  struct stat st;
+  if (fstat(fd, &st) != 0) {
+    return Error("failed to stat idmap %s", idmap_path.c_str());
+  }
+  if (st.st_size == 0) {
+    return Error("failed to parse idmap header");
+  }
+  const auto map = base::MappedFile::FromFd(fd, 0, st.st_size, PROT_READ);
+  if (!map) {
+    return Error("failed to map idmap %s", idmap_path.c_str());
+  }
+  return FromBuffer(StringPiece(map->data(), map->size()));
+}
+
 Result<std::unique_ptr<const IdmapData>> IdmapData::FromResourceMapping(
     const ResourceMapping& resource_mapping) {
   if (resource_mapping.GetTargetToOverlayMap().empty()) {
@@ -392,6 +473,56 @@ Result<std::unique_ptr<const Idmap>> Idmap::FromApkAssets(const ApkAssets& targe
   return {std::move(idmap)};
 }
 
+Result<Unit> IdmapHeader::IsFileUpToDate(const std::string& idmap_path, const char* target_path,
+                                         const char* overlay_path, uint32_t target_crc,
+                                         uint32_t overlay_crc, PolicyBitmask fulfilled_policies,
+                                         bool enforce_overlayable) {
+  SYSTRACE << "IdmapHeader::IsFileUpToDate " << idmap_path;
+  const size_t target_path_length = strlen(target_path);
+  const size_t overlay_path_length = strlen(overlay_path);
+  if (target_path_length >= kIdmapStringLength || overlay_path_length >= kIdmapStringLength) {
+    return Error("path too long for idmap %s", idmap_path.c_str());
+  }
+
+  // The fixed part of an up-to-date header, as written by BinaryStreamVisitor.
+  uint8_t expected[kIdmapFixedHeaderSize];
+  memset(expected, 0, sizeof(expected));
+  uint8_t* p = expected;
+  for (uint32_t value :
+       {kIdmapMagic, kIdmapCurrentVersion, target_crc, overlay_crc,
+        static_cast<uint32_t>(fulfilled_policies)}) {
+    const uint32_t x = htodl(value);
+    memcpy(p, &x, sizeof(x));
+    p += sizeof(x);
+  }
+  *p++ = static_cast<uint8_t>(enforce_overlayable);
+  memcpy(p, target_path, target_path_length);
+  p += kIdmapStringLength;
+  memcpy(p, overlay_path, overlay_path_length);
+
+  uint8_t actual[kIdmapFixedHeaderSize];
+  {
+    const base::unique_fd fd(TEMP_FAILURE_RETRY(open(idmap_path.c_str(), O_RDONLY | O_CLOEXEC)));
+    if (fd < 0) {
+      return Error("failed to open idmap %s", idmap_path.c_str());
+    }
+    if (!base::ReadFully(fd, actual, sizeof(actual))) {
+      return Error("failed to read idmap header");
+    }
+  }
+  if (memcmp(expected, actual, sizeof(expected)) == 0) {
+    return Unit{};
+  }
+
+  std::ifstream fin(idmap_path);
+  const std::unique_ptr<const IdmapHeader> header = FromBinaryStream(fin);
+  if (!header) {
+    return Error("failed to parse idmap header");
+  }
+  return header->IsUpToDate(target_path, overlay_path, target_crc, overlay_crc, fulfilled_policies,
+                            enforce_overlayable);
+}
+
 void IdmapHeader::accept(Visitor* v) const {
   assert(v != nullptr);
   v->visit(*this);
@@ -20,6 +20,7 @@
 #include <memory>
 #include <set>
 #include <string>
+#include <unordered_map>
 #include <utility>
 #include <vector>
 
@@ -96,6 +97,44 @@ Result<Unit> CheckOverlayable(const LoadedPackage& target_package,
   return Result<Unit>({});
 }
 
+// Answers CheckOverlayable for the resources of one target package and one overlay. Whether an
+// <overlayable> accepts the overlay only depends on its name and policies, so it is decided once
+// per <overlayable> and checking a resource is a lookup. The reason a resource is rejected is only
+// worked out for the rejected resources.
+class OverlayableChecker {
+ public:
+  OverlayableChecker(const LoadedPackage& target_package, const OverlayManifestInfo& overlay_info,
+                     const PolicyBitmask& fulfilled_policies)
+      : target_package_(target_package),
+        overlay_info_(overlay_info),
+        fulfilled_policies_(fulfilled_policies) {
+  }
+
+  Result<Unit> Check(const ResourceId& target_resource) {
+    const OverlayableInfo* overlayable_info =
+        target_package_.DefinesOverlayable() ? target_package_.GetOverlayableInfo(target_resource)
+                                             : nullptr;
+    auto iter = accepted_.find(overlayable_info);
+    if (iter == accepted_.end()) {
+      const bool accepted = static_cast<bool>(
+          CheckOverlayable(target_package_, overlay_info_, fulfilled_policies_, target_resource));
+      iter = accepted_.emplace(overlayable_info, accepted).first;
+    }
+    return iter->second ? Result<Unit>({})
+                        : CheckOverlayable(target_package_, overlay_info_, fulfilled_policies_,
+                                           target_resource);
+  }
+
+ private:
+  const LoadedPackage& target_package_;
+  const OverlayManifestInfo& overlay_info_;
+  const PolicyBitmask fulfilled_policies_;
+
+  // Keyed by the <overlayable> of the resource, or null for the resources without one (and for
+  // every resource if the target defines no <overlayable>).
+  std::unordered_map<const OverlayableInfo*, bool> accepted_;
+};
+
 // TODO(martenkongstad): scan for package name instead of assuming package at index 0
 //
 // idmap version 0x01 naively assumes that the package to use is always the first ResTable_package
@@ -257,11 +296,11 @@ void ResourceMapping::FilterOverlayableResources(const AssetManager2* target_am,
                                                  const OverlayManifestInfo& overlay_info,
                                                  const PolicyBitmask& fulfilled_policies,
                                                  LogInfo& log_info) {
+  OverlayableChecker checker(*target_package, overlay_info, fulfilled_policies);
   std::set<ResourceId> remove_ids;
   for (const auto& target_map : target_map_) {
     const ResourceId target_resid = target_map.first;
-    Result<Unit> success =
-        CheckOverlayable(*target_package, overlay_info, fulfilled_policies, target_resid);
+    Result<Unit> success = checker.Check(target_resid);
     if (success) {
       continue;
     }
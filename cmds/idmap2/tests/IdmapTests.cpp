@@ -26,6 +26,7 @@
 #include "TestConstants.h"
 #include "TestHelpers.h"
 #include "android-base/macros.h"
+#include "android-base/file.h"
 #include "androidfw/ApkAssets.h"
 #include "gmock/gmock.h"
 #include "gtest/gtest.h"
@@ -166,6 +167,45 @@ TEST(IdmapTests, GracefullyFailToCreateIdmapFromCorruptBinaryStream) {
   ASSERT_FALSE(result);
 }
 
+TEST(IdmapTests, CreateIdmapFromFile) {
+  TemporaryFile idmap_file;
+  ASSERT_TRUE(base::WriteFully(idmap_file.fd, idmap_raw_data, idmap_raw_data_len));
+
+  auto result = Idmap::FromFile(idmap_file.path);
+  ASSERT_TRUE(result);
+  const auto idmap = std::move(*result);
+
+  ASSERT_THAT(idmap->GetHeader(), NotNull());
+  ASSERT_EQ(idmap->GetHeader()->GetTargetCrc(), 0x1234U);
+  ASSERT_EQ(idmap->GetHeader()->GetOverlayCrc(), 0x5678U);
+  ASSERT_EQ(idmap->GetHeader()->GetTargetPath().to_string(), "targetX.apk");
+  ASSERT_EQ(idmap->GetHeader()->GetOverlayPath().to_string(), "overlayX.apk");
+  ASSERT_EQ(idmap->GetData().size(), 1U);
+
+  const std::unique_ptr<const IdmapData>& data = idmap->GetData()[0];
+  ASSERT_THAT(data, NotNull());
+  const auto& target_entries = data->GetTargetEntries();
+  ASSERT_EQ(target_entries.size(), 3U);
+  ASSERT_TARGET_ENTRY(target_entries[2], 0x7f030002, Res_value::TYPE_REFERENCE, 0x7f030001);
+  const auto& overlay_entries = data->GetOverlayEntries();
+  ASSERT_EQ(overlay_entries.size(), 3U);
+  ASSERT_OVERLAY_ENTRY(overlay_entries[2], 0x7f030001, 0x7f030002);
+
+  // Writing the idmap back produces the same bytes.
+  std::stringstream stream;
+  BinaryStreamVisitor visitor(stream);
+  idmap->accept(&visitor);
+  ASSERT_EQ(stream.str(),
+            std::string(reinterpret_cast<const char*>(idmap_raw_data), idmap_raw_data_len));
+}
+
+TEST(IdmapTests, GracefullyFailToCreateIdmapFromTruncatedFile) {
+  TemporaryFile idmap_file;
+  ASSERT_TRUE(base::WriteFully(idmap_file.fd, idmap_raw_data, idmap_raw_data_len - 1));
+  ASSERT_FALSE(Idmap::FromFile(idmap_file.path));
+  ASSERT_FALSE(Idmap::FromFile(std::string(idmap_file.path) + ".missing"));
+}
+
 TEST(IdmapTests, CreateIdmapHeaderFromApkAssets) {
   std::string target_apk_path = GetTestDataPath() + "/target/target.apk";
   std::string overlay_apk_path = GetTestDataPath() + "/overlay/overlay.apk";
@@ -502,6 +542,53 @@ TEST(IdmapTests, IdmapHeaderIsUpToDate) {
                                             PolicyFlags::PUBLIC, /* enforce_overlayable */ true));
 }
 
+TEST(IdmapTests, IdmapFileIsUpToDate) {
+  fclose(stderr);  // silence expected warnings from libandroidfw
+
+  const std::string target_apk_path(GetTestDataPath() + "/target/target.apk");
+  std::unique_ptr<const ApkAssets> target_apk = ApkAssets::Load(target_apk_path);
+  ASSERT_THAT(target_apk, NotNull());
+
+  const std::string overlay_apk_path(GetTestDataPath() + "/overlay/overlay.apk");
+  std::unique_ptr<const ApkAssets> overlay_apk = ApkAssets::Load(overlay_apk_path);
+  ASSERT_THAT(overlay_apk, NotNull());
+
+  auto result = Idmap::FromApkAssets(*target_apk, *overlay_apk, PolicyFlags::PUBLIC,
+                                     /* enforce_overlayable */ true);
+  ASSERT_TRUE(result);
+  const auto idmap = std::move(*result);
+  const uint32_t target_crc = idmap->GetHeader()->GetTargetCrc();
+  const uint32_t overlay_crc = idmap->GetHeader()->GetOverlayCrc();
+
+  TemporaryFile idmap_file;
+  {
+    std::ofstream fout(idmap_file.path);
+    BinaryStreamVisitor visitor(fout);
+    idmap->accept(&visitor);
+  }
+
+  ASSERT_TRUE(IdmapHeader::IsFileUpToDate(idmap_file.path, target_apk_path.c_str(),
+                                          overlay_apk_path.c_str(), target_crc, overlay_crc,
+                                          PolicyFlags::PUBLIC, /* enforce_overlayable */ true));
+  ASSERT_FALSE(IdmapHeader::IsFileUpToDate(idmap_file.path, target_apk_path.c_str(),
+                                           overlay_apk_path.c_str(), target_crc, overlay_crc + 1,
+                                           PolicyFlags::PUBLIC, /* enforce_overlayable */ true));
+  ASSERT_FALSE(IdmapHeader::IsFileUpToDate(idmap_file.path, target_apk_path.c_str(),
+                                           overlay_apk_path.c_str(), target_crc, overlay_crc,
+                                           PolicyFlags::SYSTEM_PARTITION,
+                                           /* enforce_overlayable */ true));
+  ASSERT_FALSE(IdmapHeader::IsFileUpToDate(idmap_file.path, target_apk_path.c_str(),
+                                           overlay_apk_path.c_str(), target_crc, overlay_crc,
+                                           PolicyFlags::PUBLIC, /* enforce_overlayable */ false));
+  ASSERT_FALSE(IdmapHeader::IsFileUpToDate(idmap_file.path, target_apk_path.c_str(),
+                                           "/bad/path", target_crc, overlay_crc,
+                                           PolicyFlags::PUBLIC, /* enforce_overlayable */ true));
+  ASSERT_FALSE(IdmapHeader::IsFileUpToDate(std::string(idmap_file.path) + ".missing",
+                                           target_apk_path.c_str(), overlay_apk_path.c_str(),
+                                           target_crc, overlay_crc, PolicyFlags::PUBLIC,
+                                           /* enforce_overlayable */ true));
+}
+
 class TestVisitor : public Visitor {
  public:
   explicit TestVisitor(std::ostream& stream) : stream_(stream) {
@@ -20,6 +20,8 @@
 
 #include <algorithm>
 #include <sstream>
+#include <string.h>
+#include <strings.h>
 #include <unistd.h>
 
 bool isValidChar(char c) {
@@ -52,12 +54,51 @@ static inline std::string trimHeader(const std::string& s) {
     return toLowerStr(trimDefault(s));
 }
 
-static inline bool isNumber(const std::string& s) {
-    std::string::const_iterator it = s.begin();
+static inline std::string_view trimView(std::string_view s, const std::string& charset) {
+    const auto head = s.find_first_not_of(charset);
+    if (head == std::string_view::npos) return std::string_view();
+
+    const auto tail = s.find_last_not_of(charset);
+    return s.substr(head, tail - head + 1);
+}
+
+static inline bool isNumber(std::string_view s) {
+    std::string_view::const_iterator it = s.begin();
     while (it != s.end() && std::isdigit(*it)) ++it;
     return !s.empty() && it == s.end();
 }
 
+// Same as atoll, without needing a null terminated copy of the value.
+static long long parseLongLong(std::string_view s) {
+    size_t i = 0;
+    while (i < s.size() && isspace((unsigned char)s[i])) i++;
+    bool negative = false;
+    if (i < s.size() && (s[i] == '-' || s[i] == '+')) {
+        negative = s[i] == '-';
+        i++;
+    }
+    unsigned long long value = 0;
+    for (; i < s.size() && isdigit((unsigned char)s[i]); i++) {
+        value = value * 10 + (s[i] - '0');
+    }
+    return negative ? -(long long)value : (long long)value;
+}
+
+static double parseDouble(std::string_view s) {
+    char buf[64];
+    if (s.size() < sizeof(buf)) {
+        memcpy(buf, s.data(), s.size());
+        buf[s.size()] = '\0';
+        return atof(buf);
+    }
+    return atof(std::string(s).c_str());
+}
+
+static inline bool equalsIgnoreCase(std::string_view s, const char* word) {
+    const size_t len = strlen(word);
+    return s.size() == len && strncasecmp(s.data(), word, len) == 0;
+}
+
 // This is similiar to Split in android-base/file.h, but it won't add empty string
 static void split(const std::string& line, std::vector<std::string>& words,
         const trans_func& func, const std::string& delimiters) {
@@ -86,10 +127,27 @@ header_t parseHeader(const std::string& line, const std::string& delimiters) {
 }
 
 record_t parseRecord(const std::string& line, const std::string& delimiters) {
-    record_t record;
-    trans_func f = &trimDefault;
-    split(line, record, f, delimiters);
-    return record;
+    tokens_t tokens;
+    splitRecord(line, &tokens, delimiters);
+    return record_t(tokens.begin(), tokens.end());
+}
+
+void splitRecord(std::string_view line, tokens_t* tokens, const std::string& delimiters) {
+    tokens->clear();  // clear the buffer before split
+
+    size_t base = 0;
+    size_t found;
+    while (true) {
+        found = line.find_first_of(delimiters, base);
+        if (found != base) {
+            std::string_view word = trimView(line.substr(base, found - base), DEFAULT_WHITESPACE);
+            if (!word.empty()) {
+                tokens->push_back(word);
+            }
+        }
+        if (found == std::string_view::npos) break;
+        base = found + 1;
+    }
 }
 
 bool getColumnIndices(std::vector<int>& indices, const char** headerNames, const std::string& line) {
@@ -113,7 +171,14 @@ bool getColumnIndices(std::vector<int>& indices, const char** headerNames, const
 }
 
 record_t parseRecordByColumns(const std::string& line, const std::vector<int>& indices, const std::string& delimiters) {
-    record_t record;
+    tokens_t tokens;
+    splitRecordByColumns(line, indices, &tokens, delimiters);
+    return record_t(tokens.begin(), tokens.end());
+}
+
+bool splitRecordByColumns(std::string_view line, const std::vector<int>& indices, tokens_t* tokens,
+        const std::string& delimiters) {
+    tokens->clear();
     int lastIndex = 0;
     int lastBeginning = 0;
     int lineSize = (int)line.size();
@@ -132,25 +197,25 @@ record_t parseRecordByColumns(const std::string& line, const std::vector<int>& i
             }
             // If we're past the end of the line AND we've already saved everything up to the end.
             fprintf(stderr, "index wrong: lastIndex: %d, idx: %d, lineSize: %d\n", lastIndex, idx, lineSize);
-            record.clear(); // The indices are wrong, return empty.
-            return record;
+            tokens->clear(); // The indices are wrong, return empty.
+            return false;
         }
         while (idx < lineSize && delimiters.find(line[idx++]) == std::string::npos);
-        record.push_back(trimDefault(line.substr(lastIndex, idx - lastIndex)));
+        tokens->push_back(trimView(line.substr(lastIndex, idx - lastIndex), DEFAULT_WHITESPACE));
         lastBeginning = lastIndex;
         lastIndex = idx;
     }
     if (lineSize - lastIndex > 0) {
         int beginning = lastIndex;
-        if (record.size() == indices.size() && !record.empty()) {
+        if (tokens->size() == indices.size() && !tokens->empty()) {
             // We've already encountered all of the columns...put whatever is
             // left in the last column.
-            record.pop_back();
+            tokens->pop_back();
             beginning = lastBeginning;
         }
-        record.push_back(trimDefault(line.substr(beginning, lineSize - beginning)));
+        tokens->push_back(trimView(line.substr(beginning, lineSize - beginning), DEFAULT_WHITESPACE));
     }
-    return record;
+    return true;
 }
 
 void printRecord(const record_t& record) {
@@ -166,6 +231,10 @@ void printRecord(const record_t& record) {
     fprintf(stderr, "\" }\n");
 }
 
+void printRecord(const tokens_t& record) {
+    printRecord(record_t(record.begin(), record.end()));
+}
+
 bool stripPrefix(std::string* line, const char* key, bool endAtDelimiter) {
     const auto head = line->find_first_not_of(DEFAULT_WHITESPACE);
     if (head == std::string::npos) return false;
@@ -237,24 +306,24 @@ double toDouble(const std::string& s) {
 Reader::Reader(const int fd)
 {
     mFile = fdopen(fd, "r");
-    mBuffer = new char[1024];
+    // getline() grows the buffer with realloc().
+    mBufferSize = 1024;
+    mBuffer = (char*)malloc(mBufferSize);
     mStatus = mFile == nullptr ? "Invalid fd " + std::to_string(fd) : "";
 }
 
 Reader::~Reader()
 {
     if (mFile != nullptr) fclose(mFile);
-    delete[] mBuffer;
+    free(mBuffer);
 }
 
 bool Reader::readLine(std::string* line) {
     if (mFile == nullptr) return false;
 
-    size_t len = 0;
-    ssize_t read = getline(&mBuffer, &len, mFile);
+    ssize_t read = getline(&mBuffer, &mBufferSize, mFile);
     if (read != -1) {
-        std::string s(mBuffer);
-        line->assign(trim(s, DEFAULT_NEWLINE));
+        line->assign(trimView(std::string_view(mBuffer, read), DEFAULT_NEWLINE));
         return true;
     }
     if (!feof(mFile)) {
@@ -295,7 +364,7 @@ Table::addEnumTypeMap(const char* field, const char* enumNames[], const int enum
         return;
     }
 
-    std::map<std::string, int> enu;
+    enum_map_t enu;
     for (int i = 0; i < enumSize; i++) {
         enu[enumNames[i]] = enumValues[i];
     }
@@ -311,70 +380,84 @@ Table::addEnumNameToValue(const char* enumName, const int enumValue)
 bool
 Table::insertField(ProtoOutputStream* proto, const std::string& name, const std::string& value)
 {
-    if (mFields.find(name) == mFields.end()) return false;
+    auto field = mFields.find(name);
+    if (field == mFields.end()) return false;
+
+    auto enums = mEnums.find(name);
+    return insertValue(proto, field->second, enums == mEnums.end() ? nullptr : &enums->second,
+            value);
+}
 
-    uint64_t found = mFields[name];
-    record_t repeats; // used for repeated fields
+bool
+Table::insertValue(ProtoOutputStream* proto, uint64_t found, const enum_map_t* enums,
+        std::string_view value)
+{
+    tokens_t repeats; // used for repeated fields
     switch ((found & FIELD_COUNT_MASK) | (found & FIELD_TYPE_MASK)) {
         case FIELD_COUNT_SINGLE | FIELD_TYPE_DOUBLE:
         case FIELD_COUNT_SINGLE | FIELD_TYPE_FLOAT:
-            proto->write(found, toDouble(value));
+            proto->write(found, parseDouble(value));
             break;
         case FIELD_COUNT_SINGLE | FIELD_TYPE_STRING:
         case FIELD_COUNT_SINGLE | FIELD_TYPE_BYTES:
-            proto->write(found, value);
+            proto->write(found, value.data(), value.size());
             break;
         case FIELD_COUNT_SINGLE | FIELD_TYPE_INT64:
         case FIELD_COUNT_SINGLE | FIELD_TYPE_SINT64:
         case FIELD_COUNT_SINGLE | FIELD_TYPE_UINT64:
         case FIELD_COUNT_SINGLE | FIELD_TYPE_FIXED64:
         case FIELD_COUNT_SINGLE | FIELD_TYPE_SFIXED64:
-            proto->write(found, toLongLong(value));
+            proto->write(found, parseLongLong(value));
             break;
         case FIELD_COUNT_SINGLE | FIELD_TYPE_BOOL:
-            if (strcmp(toLowerStr(value).c_str(), "true") == 0 || strcmp(value.c_str(), "1") == 0) {
+            if (equalsIgnoreCase(value, "true") || value == "1") {
                 proto->write(found, true);
                 break;
             }
-            if (strcmp(toLowerStr(value).c_str(), "false") == 0 || strcmp(value.c_str(), "0") == 0) {
+            if (equalsIgnoreCase(value, "false") || value == "0") {
                 proto->write(found, false);
                 break;
             }
             return false;
-        case FIELD_COUNT_SINGLE | FIELD_TYPE_ENUM:
+        case FIELD_COUNT_SINGLE | FIELD_TYPE_ENUM: {
             // if the field has its own enum mapping, use this, otherwise use general name to value mapping.
-            if (mEnums.find(name) != mEnums.end()) {
-                if (mEnums[name].find(value) != mEnums[name].end()) {
-                    proto->write(found, mEnums[name][value]);
+            if (enums != nullptr) {
+                auto it = enums->find(value);
+                if (it != enums->end()) {
+                    proto->write(found, it->second);
                 } else {
                     proto->write(found, 0); // TODO: should get the default enum value (Unknown)
                 }
-            } else if (mEnumValuesByName.find(value) != mEnumValuesByName.end()) {
-                proto->write(found, mEnumValuesByName[value]);
+                break;
+            }
+            auto it = mEnumValuesByName.find(value);
+            if (it != mEnumValuesByName.end()) {
+                proto->write(found, it->second);
             } else if (isNumber(value)) {
-                proto->write(found, toInt(value));
+                proto->write(found, (int)parseLongLong(value));
             } else {
                 return false;
             }
             break;
+        }
         case FIELD_COUNT_SINGLE | FIELD_TYPE_INT32:
         case FIELD_COUNT_SINGLE | FIELD_TYPE_SINT32:
         case FIELD_COUNT_SINGLE | FIELD_TYPE_UINT32:
         case FIELD_COUNT_SINGLE | FIELD_TYPE_FIXED32:
         case FIELD_COUNT_SINGLE | FIELD_TYPE_SFIXED32:
-            proto->write(found, toInt(value));
+            proto->write(found, (int)parseLongLong(value));
             break;
         // REPEATED TYPE below:
         case FIELD_COUNT_REPEATED | FIELD_TYPE_INT32:
-            repeats = parseRecord(value, COMMA_DELIMITER);
+            splitRecord(value, &repeats, COMMA_DELIMITER);
             for (size_t i=0; i<repeats.size(); i++) {
-                proto->write(found, toInt(repeats[i]));
+                proto->write(found, (int)parseLongLong(repeats[i]));
             }
             break;
         case FIELD_COUNT_REPEATED | FIELD_TYPE_STRING:
-            repeats = parseRecord(value, COMMA_DELIMITER);
+            splitRecord(value, &repeats, COMMA_DELIMITER);
             for (size_t i=0; i<repeats.size(); i++) {
-                proto->write(found, repeats[i]);
+                proto->write(found, repeats[i].data(), repeats[i].size());
             }
             break;
         default:
@@ -383,6 +466,41 @@ Table::insertField(ProtoOutputStream* proto, const std::string& name, const std:
     return true;
 }
 
+// ================================================================================
+ColumnSchema::ColumnSchema()
+        :mTable(nullptr),
+         mColumns()
+{
+}
+
+ColumnSchema::~ColumnSchema()
+{
+}
+
+void
+ColumnSchema::resolve(Table* table, const header_t& header)
+{
+    mTable = table;
+    mColumns.clear();
+    for (const std::string& name : header) {
+        Column column;
+        column.name = name;
+        auto field = table->mFields.find(name);
+        column.found = field != table->mFields.end();
+        column.fieldId = column.found ? field->second : 0;
+        auto enums = table->mEnums.find(name);
+        column.enums = enums == table->mEnums.end() ? nullptr : &enums->second;
+        mColumns.push_back(column);
+    }
+}
+
+bool
+ColumnSchema::insertField(ProtoOutputStream* proto, size_t column, std::string_view value) const
+{
+    if (column >= mColumns.size() || !mColumns[column].found) return false;
+    return mTable->insertValue(proto, mColumns[column].fieldId, mColumns[column].enums, value);
+}
+
 // ================================================================================
 Message::Message(Table* table)
         :mTable(table),
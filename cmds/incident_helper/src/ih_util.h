@@ -20,6 +20,7 @@
 #include <map>
 #include <stack>
 #include <string>
+#include <string_view>
 #include <vector>
 
 #include <android/util/ProtoOutputStream.h>
@@ -28,6 +29,7 @@ using namespace android::util;
 
 typedef std::vector<std::string> header_t;
 typedef std::vector<std::string> record_t;
+typedef std::vector<std::string_view> tokens_t;
 typedef std::string (*trans_func) (const std::string&);
 
 const std::string DEFAULT_WHITESPACE = " \t";
@@ -72,8 +74,19 @@ bool getColumnIndices(std::vector<int>& indices, const char* headerNames[], cons
  */
 record_t parseRecordByColumns(const std::string& line, const std::vector<int>& indices, const std::string& delimiters = DEFAULT_WHITESPACE);
 
+/**
+ * Same as parseRecord and parseRecordByColumns, but the tokens point into the line instead of
+ * being copied, so the line must outlive them. The tokens vector is cleared and reused, so once
+ * it has grown to the number of columns splitting a record doesn't allocate.
+ */
+void splitRecord(std::string_view line, tokens_t* tokens,
+        const std::string& delimiters = DEFAULT_WHITESPACE);
+bool splitRecordByColumns(std::string_view line, const std::vector<int>& indices, tokens_t* tokens,
+        const std::string& delimiters = DEFAULT_WHITESPACE);
+
 /** Prints record_t to stderr */
 void printRecord(const record_t& record);
+void printRecord(const tokens_t& record);
 
 /**
  * When the line starts/ends with the given key, the function returns true
@@ -118,6 +131,7 @@ public:
 private:
     FILE* mFile;
     char* mBuffer;
+    size_t mBufferSize;
     std::string mStatus;
 };
 
@@ -132,9 +146,11 @@ private:
  * Advance feature: if some fields in the message are enums, user must explicitly add the
  * mapping from enum name string to its enum values.
  */
+class ColumnSchema;
 class Message;
 class Table
 {
+friend class ColumnSchema;
 friend class Message;
 public:
     Table(const char* names[], const uint64_t ids[], const int count);
@@ -151,9 +167,50 @@ public:
     // Return false if the given name can't be found.
     bool insertField(ProtoOutputStream* proto, const std::string& name, const std::string& value);
 private:
+    typedef std::map<std::string, int, std::less<>> enum_map_t;
+
     std::map<std::string, uint64_t> mFields;
-    std::map<std::string, std::map<std::string, int>> mEnums;
-    std::map<std::string, int> mEnumValuesByName;
+    std::map<std::string, enum_map_t> mEnums;
+    enum_map_t mEnumValuesByName;
+
+    // Parses the value for the field and writes it to proto. enums is the field's own enum
+    // mapping, or nullptr.
+    bool insertValue(ProtoOutputStream* proto, uint64_t fieldId, const enum_map_t* enums,
+            std::string_view value);
+};
+
+/**
+ * The fields of the columns of a text table, looked up in the Table once from the header.
+ * Records are then inserted by column index, so no name is looked up again and no value is
+ * copied while converting the rows.
+ */
+class ColumnSchema
+{
+public:
+    ColumnSchema();
+    ~ColumnSchema();
+
+    // Resolves each name of the header to its field in table. Unknown names are kept, but
+    // inserting their values fails.
+    void resolve(Table* table, const header_t& header);
+
+    size_t size() const { return mColumns.size(); }
+
+    const std::string& name(size_t column) const { return mColumns[column].name; }
+
+    // Parses the value of the column and writes it to its field in proto.
+    // Return false if the column has no field or the value can't be parsed.
+    bool insertField(ProtoOutputStream* proto, size_t column, std::string_view value) const;
+private:
+    struct Column {
+        std::string name;
+        bool found;
+        uint64_t fieldId;
+        const Table::enum_map_t* enums;
+    };
+
+    Table* mTable;
+    std::vector<Column> mColumns;
 };
 
 /**
@@ -29,7 +29,8 @@ KernelWakesParser::Parse(const int in, const int out) const
     Reader reader(in);
     string line;
     header_t header;  // the header of /d/wakeup_sources
-    record_t record;  // retain each record
+    ColumnSchema columns;  // the fields of the header's columns
+    tokens_t record;  // retain each record
     int nline = 0;
 
     ProtoOutputStream proto;
@@ -43,11 +44,12 @@ KernelWakesParser::Parse(const int in, const int out) const
         // parse head line
         if (nline++ == 0) {
             header = parseHeader(line, TAB_DELIMITER);
+            columns.resolve(&table, header);
             continue;
         }
 
         // parse for each record, the line delimiter is \t only!
-        record = parseRecord(line, TAB_DELIMITER);
+        splitRecord(line, &record, TAB_DELIMITER);
 
         if (record.size() < header.size()) {
             // TODO: log this to incident report!
@@ -61,9 +63,10 @@ KernelWakesParser::Parse(const int in, const int out) const
 
         uint64_t token = proto.start(KernelWakeSourcesProto::WAKEUP_SOURCES);
         for (int i=0; i<(int)record.size(); i++) {
-            if (!table.insertField(&proto, header[i], record[i])) {
-                fprintf(stderr, "[%s]Line %d has bad value %s of %s\n",
-                        this->name.string(), nline, header[i].c_str(), record[i].c_str());
+            if (!columns.insertField(&proto, i, record[i])) {
+                fprintf(stderr, "[%s]Line %d has bad value %s of %.*s\n",
+                        this->name.string(), nline, header[i].c_str(), (int)record[i].size(),
+                        record[i].data());
             }
         }
         proto.end(token);
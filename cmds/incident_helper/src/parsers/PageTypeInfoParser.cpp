@@ -31,6 +31,7 @@ PageTypeInfoParser::Parse(const int in, const int out) const
     bool migrateTypeSession = false;
     int pageBlockOrder;
     header_t blockHeader;
+    ColumnSchema blockColumns;  // the fields of blockHeader's columns
 
     ProtoOutputStream proto;
     Table table(PageTypeInfoProto::Block::_FIELD_NAMES,
@@ -59,6 +60,7 @@ PageTypeInfoParser::Parse(const int in, const int out) const
         }
         if (stripPrefix(&line, "Number of blocks type")) {
             blockHeader = parseHeader(line);
+            blockColumns.resolve(&table, blockHeader);
             continue;
         }
 
@@ -98,7 +100,7 @@ PageTypeInfoParser::Parse(const int in, const int out) const
                 proto.write(PageTypeInfoProto::Block::ZONE, blockCounts[0]);
 
                 for (size_t i=0; i<blockHeader.size(); i++) {
-                    if (!table.insertField(&proto, blockHeader[i], blockCounts[i+1])) {
+                    if (!blockColumns.insertField(&proto, i, blockCounts[i+1])) {
                         fprintf(stderr, "Header %s has bad data %s\n", blockHeader[i].c_str(),
                             blockCounts[i+1].c_str());
                     }
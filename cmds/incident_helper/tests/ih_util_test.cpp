@@ -99,6 +99,54 @@ TEST(IhUtilTest, ParseRecordByColumns) {
     EXPECT_EQ(expected, result);
 }
 
+TEST(IhUtilTest, SplitRecord) {
+    tokens_t result;
+    splitRecord(" \t \t\t ", &result);
+    EXPECT_TRUE(result.empty());
+
+    std::string line = " \t 100 00\toooh \t wqrw";
+    splitRecord(line, &result, "\t");
+    record_t expected = { "100 00", "oooh", "wqrw" };
+    EXPECT_EQ(expected, record_t(result.begin(), result.end()));
+
+    // The tokens point into the line.
+    EXPECT_EQ(line.data() + 3, result[0].data());
+
+    std::vector<int> indices = { 3, 10 };
+    ASSERT_TRUE(splitRecordByColumns("abc \t2345  6789 ", indices, &result));
+    expected = { "abc", "2345  6789" };
+    EXPECT_EQ(expected, record_t(result.begin(), result.end()));
+    EXPECT_FALSE(splitRecordByColumns("12345", indices, &result));
+    EXPECT_TRUE(result.empty());
+}
+
+TEST(IhUtilTest, ColumnSchema) {
+    const char* names[] = { "pid", "name", "rss" };
+    const uint64_t ids[] = {
+        FIELD_COUNT_SINGLE | FIELD_TYPE_INT32 | 1,
+        FIELD_COUNT_SINGLE | FIELD_TYPE_STRING | 2,
+        FIELD_COUNT_SINGLE | FIELD_TYPE_INT64 | 3,
+    };
+    Table table(names, ids, 3);
+    ColumnSchema columns;
+    columns.resolve(&table, parseHeader("NAME PID UNKNOWN RSS"));
+    ASSERT_EQ(4u, columns.size());
+    EXPECT_THAT(columns.name(2), StrEq("unknown"));
+
+    tokens_t record;
+    splitRecord("foo 150 bar 300", &record);
+    ProtoOutputStream proto;
+    EXPECT_TRUE(columns.insertField(&proto, 0, record[0]));
+    EXPECT_TRUE(columns.insertField(&proto, 1, record[1]));
+    EXPECT_FALSE(columns.insertField(&proto, 2, record[2]));
+    EXPECT_TRUE(columns.insertField(&proto, 3, record[3]));
+    EXPECT_FALSE(columns.insertField(&proto, 4, record[3]));
+
+    string actual;
+    ASSERT_TRUE(proto.serializeToString(&actual));
+    EXPECT_EQ(string("\x12\x03" "foo" "\x08\x96\x01" "\x18\xac\x02"), actual);
+}
+
 TEST(IhUtilTest, stripPrefix) {
     string data1 = "Swap: abc ";
     EXPECT_TRUE(stripPrefix(&data1, "Swap:"));
@@ -168,6 +216,22 @@ TEST(IhUtilTest, Reader) {
     ASSERT_TRUE(r.ok(&line));
 }
 
+TEST(IhUtilTest, ReaderLongLine) {
+    TemporaryFile tf;
+    ASSERT_NE(tf.fd, -1);
+    string longLine(5000, 'x');
+    ASSERT_TRUE(WriteStringToFile(longLine + "\r\nshort\n", tf.path));
+
+    Reader r(tf.fd);
+    string line;
+    ASSERT_TRUE(r.readLine(&line));
+    EXPECT_EQ(longLine, line);
+    ASSERT_TRUE(r.readLine(&line));
+    EXPECT_THAT(line, StrEq("short"));
+    ASSERT_FALSE(r.readLine(&line));
+    ASSERT_TRUE(r.ok(&line));
+}
+
 TEST(IhUtilTest, ReaderEmpty) {
     TemporaryFile tf;
     ASSERT_NE(tf.fd, -1);
@@ -24,8 +24,10 @@
 
 #include <fcntl.h>
 #include <poll.h>
+#include <string.h>
 #include <unistd.h>
 #include <wait.h>
+#include <zlib.h>
 
 namespace android {
 namespace os {
@@ -33,6 +35,9 @@ namespace incidentd {
 
 const ssize_t BUFFER_SIZE = 16 * 1024;  // 16 KB
 const ssize_t MAX_BUFFER_SIZE = 96 * 1024 * 1024;  // 96 MB
+// windowBits to make zlib emit a gzip header and trailer, same as the gzip binary.
+const int GZIP_WINDOW_BITS = MAX_WBITS + 16;
+const int GZIP_MEM_LEVEL = 8;
 
 FdBuffer::FdBuffer(): FdBuffer(get_buffer_from_pool(), /* isBufferPooled= */ true)  {
 }
@@ -157,7 +162,10 @@ status_t FdBuffer::readProcessedDataInStream(int fd, unique_fd toFd, unique_fd f
     fcntl(toFd.get(), F_SETFL, fcntl(toFd.get(), F_GETFL, 0) | O_NONBLOCK);
     fcntl(fromFd.get(), F_SETFL, fcntl(fromFd.get(), F_GETFL, 0) | O_NONBLOCK);
 
-    // A circular buffer holds data read from fd and writes to parsing process
+    // Data is moved from fd to the parsing process inside the kernel with splice(). If fd
+    // doesn't support it, fall back to a circular buffer which holds data read from fd and
+    // writes to parsing process.
+    bool useSplice = true;
     uint8_t cirBuf[BUFFER_SIZE];
     size_t cirSize = 0;
     int rpos = 0, wpos = 0;
@@ -204,8 +212,26 @@ status_t FdBuffer::readProcessedDataInStream(int fd, unique_fd toFd, unique_fd f
             }
         }
 
+        // splice from fd to parsing process
+        if (useSplice && pfds[0].fd != -1 && pfds[1].fd != -1) {
+            ssize_t amt = TEMP_FAILURE_RETRY(splice(fd, NULL, toFd.get(), NULL, BUFFER_SIZE,
+                                                    SPLICE_F_MOVE | SPLICE_F_NONBLOCK));
+            if (amt < 0) {
+                if (errno == EINVAL || errno == ENOSYS) {
+                    VLOG("fd %d doesn't support splice, copying instead", fd);
+                    useSplice = false;
+                } else if (!(errno == EAGAIN || errno == EWOULDBLOCK)) {
+                    VLOG("Fail to splice fd %d: %s", fd, strerror(errno));
+                    return -errno;
+                }  // otherwise just continue
+            } else if (amt == 0) {
+                VLOG("Reached EOF of input file %d", fd);
+                pfds[0].fd = -1;  // reach EOF so don't have to poll pfds[0].
+            }
+        }
+
         // read from fd
-        if (cirSize != BUFFER_SIZE && pfds[0].fd != -1) {
+        if (!useSplice && cirSize != BUFFER_SIZE && pfds[0].fd != -1) {
             ssize_t amt;
             if (rpos >= wpos) {
                 amt = TEMP_FAILURE_RETRY(::read(fd, cirBuf + rpos, BUFFER_SIZE - rpos));
@@ -280,6 +306,72 @@ status_t FdBuffer::readProcessedDataInStream(int fd, unique_fd toFd, unique_fd f
     return NO_ERROR;
 }
 
+status_t FdBuffer::readAndGzip(int fd, int64_t timeoutMs) {
+    mStartTime = uptimeMillis();
+
+    z_stream stream;
+    memset(&stream, 0, sizeof(stream));
+    if (deflateInit2(&stream, Z_DEFAULT_COMPRESSION, Z_DEFLATED, GZIP_WINDOW_BITS, GZIP_MEM_LEVEL,
+                     Z_DEFAULT_STRATEGY) != Z_OK) {
+        VLOG("Fail to init deflate: %s", stream.msg != NULL ? stream.msg : "unknown");
+        return NO_MEMORY;
+    }
+
+    // The file is read into inBuf and deflated straight into the chunks of mBuffer.
+    uint8_t inBuf[BUFFER_SIZE];
+    int flush = Z_NO_FLUSH;
+    status_t err = NO_ERROR;
+    while (true) {
+        if (mBuffer->size() >= MAX_BUFFER_SIZE) {
+            mTruncated = true;
+            VLOG("Truncating data");
+            break;
+        }
+        if (mBuffer->writeBuffer() == NULL) {
+            VLOG("No memory");
+            err = NO_MEMORY;
+            break;
+        }
+
+        if (stream.avail_in == 0 && flush != Z_FINISH) {
+            if (uptimeMillis() - mStartTime >= timeoutMs) {
+                VLOG("timed out due to long read");
+                mTimedOut = true;
+                break;
+            }
+            ssize_t amt = TEMP_FAILURE_RETRY(::read(fd, inBuf, sizeof(inBuf)));
+            if (amt < 0) {
+                VLOG("Fail to read %d: %s", fd, strerror(errno));
+                err = -errno;
+                break;
+            } else if (amt == 0) {
+                VLOG("Reached EOF of fd=%d", fd);
+                flush = Z_FINISH;
+            }
+            stream.next_in = inBuf;
+            stream.avail_in = amt;
+        }
+
+        size_t available = mBuffer->currentToWrite();
+        stream.next_out = mBuffer->writeBuffer();
+        stream.avail_out = available;
+        int ret = deflate(&stream, flush);
+        if (ret == Z_STREAM_ERROR) {
+            VLOG("Fail to deflate fd %d", fd);
+            err = UNKNOWN_ERROR;
+            break;
+        }
+        mBuffer->wp()->move(available - stream.avail_out);
+        if (ret == Z_STREAM_END) {
+            break;
+        }
+    }
+
+    deflateEnd(&stream);
+    mFinishTime = uptimeMillis();
+    return err;
+}
+
 status_t FdBuffer::write(uint8_t const* buf, size_t size) {
     return mBuffer->writeRaw(buf, size);
 }
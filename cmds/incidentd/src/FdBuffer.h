@@ -64,6 +64,13 @@ public:
     status_t readProcessedDataInStream(int fd, unique_fd toFd, unique_fd fromFd, int64_t timeoutMs,
                                        const bool isSysfs = false);
 
+    /**
+     * Read the data until the timeout is hit or we hit eof, and store it gzip compressed.
+     * The data is compressed in process, straight into the buffer.
+     * Returns NO_ERROR if there were no errors or if we timed out.
+     */
+    status_t readAndGzip(int fd, int64_t timeoutMs);
+
     /**
      * Write by hand into the buffer.
      */
@@ -24,6 +24,7 @@
 #include "incidentd_util.h"
 #include "section_list.h"
 
+#include <android-base/properties.h>
 #include <android/os/IncidentReportArgs.h>
 #include <binder/IPCThreadState.h>
 #include <binder/IResultReceiver.h>
@@ -45,6 +46,11 @@ enum {
 
 #define DEFAULT_BYTES_SIZE_LIMIT (96 * 1024 * 1024)        // 96MB
 #define DEFAULT_REFACTORY_PERIOD_MS (24 * 60 * 60 * 1000)  // 1 Day
+#define DEFAULT_SECTION_CACHE_BYTES (16 * 1024 * 1024)     // 16MB
+
+// How long the data of a section is reused by the following reports, 0 to always run the
+// sections again.
+#define SECTION_CACHE_TTL_PROPERTY "persist.incidentd.section_cache_ttl_ms"
 
 // Skip these sections (for dumpstate only)
 // Skip logs (1100 - 1108) and traces (1200 - 1202) because they are already in the bug report.
@@ -126,6 +132,7 @@ ReportHandler::ReportHandler(const sp<WorkDirectory>& workDirectory,
                              const sp<Broadcaster>& broadcaster,
                              const sp<Looper>& handlerLooper,
                              const sp<Throttler>& throttler,
+                             const sp<SectionCache>& sectionCache,
                              const vector<BringYourOwnSection*>& registeredSections)
         :mLock(),
          mWorkDirectory(workDirectory),
@@ -133,6 +140,7 @@ ReportHandler::ReportHandler(const sp<WorkDirectory>& workDirectory,
          mHandlerLooper(handlerLooper),
          mBacklogDelay(DEFAULT_DELAY_NS),
          mThrottler(throttler),
+         mSectionCache(sectionCache),
          mRegisteredSections(registeredSections),
          mBatch(new ReportBatch()) {
 }
@@ -190,7 +198,9 @@ void ReportHandler::take_report() {
         return;
     }
 
-    sp<Reporter> reporter = new Reporter(mWorkDirectory, batch, mRegisteredSections);
+    mSectionCache->setTtlMs(android::base::GetIntProperty(SECTION_CACHE_TTL_PROPERTY, 0));
+    sp<Reporter> reporter = new Reporter(mWorkDirectory, batch, mRegisteredSections,
+            mSectionCache);
 
     // Take the report, which might take a while. More requests might queue
     // up while we're doing this, and we'll handle them in their next batch.
@@ -239,10 +249,11 @@ void ReportHandler::send_broadcasts() {
 // ================================================================================
 IncidentService::IncidentService(const sp<Looper>& handlerLooper) {
     mThrottler = new Throttler(DEFAULT_BYTES_SIZE_LIMIT, DEFAULT_REFACTORY_PERIOD_MS);
+    mSectionCache = new SectionCache(DEFAULT_SECTION_CACHE_BYTES);
     mWorkDirectory = new WorkDirectory();
     mBroadcaster = new Broadcaster(mWorkDirectory);
     mHandler = new ReportHandler(mWorkDirectory, mBroadcaster, handlerLooper,
-            mThrottler, mRegisteredSections);
+            mThrottler, mSectionCache, mRegisteredSections);
     mBroadcaster->setHandler(mHandler);
 }
 
@@ -553,6 +564,14 @@ status_t IncidentService::command(FILE* in, FILE* out, FILE* err, Vector<String8
             mThrottler->dump(out);
             return NO_ERROR;
         }
+        if (!args[0].compare(String8("cache"))) {
+            mSectionCache->dump(out);
+            return NO_ERROR;
+        }
+        if (!args[0].compare(String8("buffers"))) {
+            dump_buffer_pool(out);
+            return NO_ERROR;
+        }
         if (!args[0].compare(String8("section"))) {
             if (argCount == 1) {
                 fprintf(out, "Not enough arguments for section\n");
@@ -581,7 +600,11 @@ status_t IncidentService::cmd_help(FILE* out) {
     fprintf(out, "usage: adb shell cmd incident section <section_id>\n");
     fprintf(out, "    Prints section id and its name.\n\n");
     fprintf(out, "usage: adb shell cmd incident throttler\n");
-    fprintf(out, "    Prints the current throttler state\n");
+    fprintf(out, "    Prints the current throttler state\n\n");
+    fprintf(out, "usage: adb shell cmd incident cache\n");
+    fprintf(out, "    Prints the sections cached for reuse by the next reports\n\n");
+    fprintf(out, "usage: adb shell cmd incident buffers\n");
+    fprintf(out, "    Prints the buffer pool hit/miss stats\n");
     return NO_ERROR;
 }
 
@@ -21,6 +21,7 @@
 #include "Reporter.h"
 
 #include "Broadcaster.h"
+#include "SectionCache.h"
 #include "Throttler.h"
 #include "WorkDirectory.h"
 
@@ -49,6 +50,7 @@ public:
                   const sp<Broadcaster>& broadcaster,
                   const sp<Looper>& handlerLooper,
                   const sp<Throttler>& throttler,
+                  const sp<SectionCache>& sectionCache,
                   const vector<BringYourOwnSection*>& registeredSections);
     virtual ~ReportHandler();
 
@@ -82,6 +84,7 @@ private:
     sp<Looper> mHandlerLooper;
     nsecs_t mBacklogDelay;
     sp<Throttler> mThrottler;
+    sp<SectionCache> mSectionCache;
 
     const vector<BringYourOwnSection*>& mRegisteredSections;
 
@@ -160,6 +163,7 @@ private:
     sp<Broadcaster> mBroadcaster;
     sp<ReportHandler> mHandler;
     sp<Throttler> mThrottler;
+    sp<SectionCache> mSectionCache;
     vector<BringYourOwnSection*> mRegisteredSections;
 
     /**
@@ -22,9 +22,14 @@
 #include "Section.h"
 
 #include <android-base/file.h>
+#include <android-base/mapped_file.h>
 #include <android/util/protobuf.h>
+#include <android/util/ProtoFieldIterator.h>
 #include <android/util/ProtoFileReader.h>
 #include <log/log.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
 
 namespace android {
 namespace os {
@@ -32,11 +37,12 @@ namespace incidentd {
 
 // ================================================================================
 /**
- * Write the field to buf based on the wire type, iterator will point to next field.
- * If skip is set to true, no data will be written to buf. Return number of bytes written.
+ * Write the field to each of the outputs in outMask (bit i for outs[i]) based on the wire
+ * type, iterator will point to next field. The field is read only once, and its payload is
+ * copied a contiguous span at a time. If outMask is 0, the field is skipped.
  */
-void write_field_or_skip(ProtoOutputStream* out, const sp<ProtoReader>& in,
-        uint32_t fieldTag, bool skip) {
+void write_field(const vector<ProtoOutputStream*>& outs, uint32_t outMask,
+        const sp<ProtoReader>& in, uint32_t fieldTag) {
     uint8_t wireType = read_wire_type(fieldTag);
     size_t bytesToWrite = 0;
     uint64_t varint = 0;
@@ -44,51 +50,65 @@ void write_field_or_skip(ProtoOutputStream* out, const sp<ProtoReader>& in,
     switch (wireType) {
         case WIRE_TYPE_VARINT:
             varint = in->readRawVarint();
-            if (!skip) {
-                out->writeRawVarint(fieldTag);
-                out->writeRawVarint(varint);
+            for (size_t i = 0; i < outs.size(); i++) {
+                if (outMask & (1u << i)) {
+                    outs[i]->writeRawVarint(fieldTag);
+                    outs[i]->writeRawVarint(varint);
+                }
             }
             return;
         case WIRE_TYPE_FIXED64:
-            if (!skip) {
-                out->writeRawVarint(fieldTag);
-            }
             bytesToWrite = 8;
             break;
         case WIRE_TYPE_LENGTH_DELIMITED:
             bytesToWrite = in->readRawVarint();
-            if (!skip) {
-                out->writeLengthDelimitedHeader(read_field_id(fieldTag), bytesToWrite);
-            }
             break;
         case WIRE_TYPE_FIXED32:
-            if (!skip) {
-                out->writeRawVarint(fieldTag);
-            }
             bytesToWrite = 4;
             break;
     }
-    if (skip) {
+    if (outMask == 0) {
         in->move(bytesToWrite);
-    } else {
-        for (size_t i = 0; i < bytesToWrite; i++) {
-            out->writeRawByte(in->next());
+        return;
+    }
+
+    for (size_t i = 0; i < outs.size(); i++) {
+        if (outMask & (1u << i)) {
+            if (wireType == WIRE_TYPE_LENGTH_DELIMITED) {
+                outs[i]->writeLengthDelimitedHeader(read_field_id(fieldTag), bytesToWrite);
+            } else {
+                outs[i]->writeRawVarint(fieldTag);
+            }
+        }
+    }
+    while (bytesToWrite > 0) {
+        uint8_t const* buf = in->readBuffer();
+        if (buf == NULL) {
+            break;
+        }
+        size_t toCopy = std::min(bytesToWrite, in->currentToRead());
+        for (size_t i = 0; i < outs.size(); i++) {
+            if (outMask & (1u << i)) {
+                outs[i]->writeRaw(buf, toCopy);
+            }
         }
+        in->move(toCopy);
+        bytesToWrite -= toCopy;
     }
 }
 
 /**
- * Strip next field based on its private policy and request spec, then stores data in buf.
- * Return NO_ERROR if succeeds, otherwise BAD_VALUE is returned to indicate bad data in
- * FdBuffer.
+ * Strip next field based on its private policy and each of the request specs, then stores
+ * data in the output of each spec that allows the field. Return NO_ERROR if succeeds,
+ * otherwise BAD_VALUE is returned to indicate bad data in FdBuffer.
  *
  * The iterator must point to the head of a protobuf formatted field for successful operation.
  * After exit with NO_ERROR, iterator points to the next protobuf field's head.
  *
  * depth is the depth of recursion, for debugging.
  */
-status_t strip_field(ProtoOutputStream* out, const sp<ProtoReader>& in,
-        const Privacy* parentPolicy, const PrivacySpec& spec, int depth) {
+status_t strip_field(const vector<ProtoOutputStream*>& outs, const vector<PrivacySpec>& specs,
+        const sp<ProtoReader>& in, const Privacy* parentPolicy, int depth) {
     if (!in->hasNext() || parentPolicy == NULL) {
         return BAD_VALUE;
     }
@@ -97,18 +117,25 @@ status_t strip_field(ProtoOutputStream* out, const sp<ProtoReader>& in,
     const Privacy* policy = lookup(parentPolicy, fieldId);
 
     if (policy == NULL || policy->children == NULL) {
-        bool skip = !spec.CheckPremission(policy, parentPolicy->policy);
+        uint32_t outMask = 0;
+        for (size_t i = 0; i < specs.size(); i++) {
+            if (specs[i].CheckPremission(policy, parentPolicy->policy)) {
+                outMask |= 1u << i;
+            }
+        }
         // iterator will point to head of next field
-        size_t currentAt = in->bytesRead();
-        write_field_or_skip(out, in, fieldTag, skip);
+        write_field(outs, outMask, in, fieldTag);
         return NO_ERROR;
     }
     // current field is message type and its sub-fields have extra privacy policies
     uint32_t msgSize = in->readRawVarint();
     size_t start = in->bytesRead();
-    uint64_t token = out->start(encode_field_id(policy));
+    vector<uint64_t> tokens(outs.size());
+    for (size_t i = 0; i < outs.size(); i++) {
+        tokens[i] = outs[i]->start(encode_field_id(policy));
+    }
     while (in->bytesRead() - start != msgSize) {
-        status_t err = strip_field(out, in, policy, spec, depth + 1);
+        status_t err = strip_field(outs, specs, in, policy, depth + 1);
         if (err != NO_ERROR) {
             ALOGW("Bad value when stripping id %d, wiretype %d, tag %#x, depth %d, size %d, "
                     "relative pos %zu, ", fieldId, read_wire_type(fieldTag), fieldTag, depth,
@@ -116,33 +143,47 @@ status_t strip_field(ProtoOutputStream* out, const sp<ProtoReader>& in,
             return err;
         }
     }
-    out->end(token);
+    for (size_t i = 0; i < outs.size(); i++) {
+        outs[i]->end(tokens[i]);
+    }
     return NO_ERROR;
 }
 
 // ================================================================================
 class FieldStripper {
 public:
-    FieldStripper(const Privacy* restrictions, const sp<ProtoReader>& data,
+    FieldStripper(const Privacy* restrictions, const sp<EncodedBuffer>& data,
             uint8_t bufferLevel);
 
     ~FieldStripper();
 
     /**
-     * Take the data that we have, and filter it down so that no fields
-     * are more sensitive than the given privacy policy.
+     * Ask for the data to be available filtered down so that no fields are more
+     * sensitive than the given privacy policy. Must be called before strip().
+     */
+    void addLevel(uint8_t privacyPolicy);
+
+    /**
+     * Take the data that we have, and filter it down to all of the added levels
+     * in a single pass over it.
+     */
+    status_t strip();
+
+    /**
+     * At the given filter level, how many bytes of data there is.
      */
-    status_t strip(uint8_t privacyPolicy);
+    ssize_t dataSize(uint8_t privacyPolicy);
 
     /**
-     * At the current filter level, how many bytes of data there is.
+     * Write the data from the given filter level to the file descriptor.
      */
-    ssize_t dataSize() const { return mSize; }
+    status_t writeData(uint8_t privacyPolicy, int fd);
 
     /**
-     * Write the data from the current filter level to the file descriptor.
+     * Whether the data has to be filtered for the given privacy policy, or can be
+     * written as it is.
      */
-    status_t writeData(int fd);
+    bool needsStrip(uint8_t privacyPolicy) const;
 
 private:
     /**
@@ -151,85 +192,110 @@ private:
     const Privacy* mRestrictions;
 
     /**
-     * The current buffer.
+     * The unfiltered data.
      */
-    sp<ProtoReader> mData;
+    sp<EncodedBuffer> mData;
 
     /**
-     * The current size of the buffer inside mData.
+     * The privacy policy that the data is already filtered to.
      */
-    ssize_t mSize;
+    uint8_t mBufferLevel;
 
     /**
-     * The current privacy policy that the data is filtered to, as an optimization
-     * so we don't always re-filter data that has already been filtered.
+     * The levels that need a filtered copy of the data, and the copies, in the same order.
+     * Levels that don't need any filtering use mData directly.
      */
-    uint8_t mCurrentLevel;
+    vector<uint8_t> mLevels;
+    vector<sp<EncodedBuffer>> mEncodedBuffers;
+    vector<unique_ptr<ProtoOutputStream>> mOutputs;
 
-    sp<EncodedBuffer> mEncodedBuffer;
+    // Returns the filtered output of the level, or nullptr to use mData.
+    ProtoOutputStream* outputOf(uint8_t privacyPolicy);
 };
 
-FieldStripper::FieldStripper(const Privacy* restrictions, const sp<ProtoReader>& data,
+FieldStripper::FieldStripper(const Privacy* restrictions, const sp<EncodedBuffer>& data,
             uint8_t bufferLevel)
         :mRestrictions(restrictions),
          mData(data),
-         mSize(data->size()),
-         mCurrentLevel(bufferLevel),
-         mEncodedBuffer(get_buffer_from_pool()) {
-    if (mSize < 0) {
-        ALOGW("FieldStripper constructed with a ProtoReader that doesn't support size."
-                " Data will be missing.");
-    }
+         mBufferLevel(bufferLevel) {
 }
 
 FieldStripper::~FieldStripper() {
-    return_buffer_to_pool(mEncodedBuffer);
+    mOutputs.clear();
+    for (const sp<EncodedBuffer>& buffer : mEncodedBuffers) {
+        return_buffer_to_pool(buffer);
+    }
 }
 
-status_t FieldStripper::strip(const uint8_t privacyPolicy) {
-    // If the current strip level is less (fewer fields retained) than what's already in the
-    // buffer, then we can skip it.
-    if (mCurrentLevel < privacyPolicy) {
-        PrivacySpec spec(privacyPolicy);
-        mEncodedBuffer->clear();
-        ProtoOutputStream proto(mEncodedBuffer);
-
-        // Optimization when no strip happens.
-        if (mRestrictions == NULL || spec.RequireAll()) {
-            if (spec.CheckPremission(mRestrictions)) {
-                mSize = mData->size();
-            }
-            return NO_ERROR;
-        }
+bool FieldStripper::needsStrip(uint8_t privacyPolicy) const {
+    // If the strip level is less (fewer fields retained) than what's already in the buffer,
+    // then we can skip it.
+    if (mBufferLevel >= privacyPolicy) {
+        return false;
+    }
+    // Optimization when no strip happens.
+    PrivacySpec spec(privacyPolicy);
+    return mRestrictions != NULL && !spec.RequireAll();
+}
 
-        while (mData->hasNext()) {
-            status_t err = strip_field(&proto, mData, mRestrictions, spec, 0);
-            if (err != NO_ERROR) {
-                return err; // Error logged in strip_field.
-            }
-        }
+void FieldStripper::addLevel(uint8_t privacyPolicy) {
+    if (!needsStrip(privacyPolicy)
+            || find(mLevels.begin(), mLevels.end(), privacyPolicy) != mLevels.end()) {
+        return;
+    }
+    sp<EncodedBuffer> buffer = get_buffer_from_pool();
+    mLevels.push_back(privacyPolicy);
+    mEncodedBuffers.push_back(buffer);
+    mOutputs.push_back(make_unique<ProtoOutputStream>(buffer));
+}
+
+status_t FieldStripper::strip() {
+    if (mLevels.empty()) {
+        return NO_ERROR;
+    }
 
-        if (mData->bytesRead() != mData->size()) {
-            ALOGW("Buffer corrupted: expect %zu bytes, read %zu bytes", mData->size(),
-                    mData->bytesRead());
-            return BAD_VALUE;
+    vector<PrivacySpec> specs;
+    vector<ProtoOutputStream*> outs;
+    for (size_t i = 0; i < mLevels.size(); i++) {
+        specs.push_back(PrivacySpec(mLevels[i]));
+        outs.push_back(mOutputs[i].get());
+    }
+
+    sp<ProtoReader> reader = mData->read();
+    while (reader->hasNext()) {
+        status_t err = strip_field(outs, specs, reader, mRestrictions, 0);
+        if (err != NO_ERROR) {
+            return err; // Error logged in strip_field.
         }
+    }
 
-        mData = proto.data();
-        mSize = proto.size();
-        mCurrentLevel = privacyPolicy;
+    if (reader->bytesRead() != reader->size()) {
+        ALOGW("Buffer corrupted: expect %zu bytes, read %zu bytes", reader->size(),
+                reader->bytesRead());
+        return BAD_VALUE;
     }
     return NO_ERROR;
 }
 
-status_t FieldStripper::writeData(int fd) {
-    status_t err = NO_ERROR;
-    sp<ProtoReader> reader = mData;
-    if (mData == nullptr) {
-        // There had been an error processing the data. We won't write anything,
-        // but we also won't return an error, because errors are fatal.
-        return NO_ERROR;
+ProtoOutputStream* FieldStripper::outputOf(uint8_t privacyPolicy) {
+    for (size_t i = 0; i < mLevels.size(); i++) {
+        if (mLevels[i] == privacyPolicy) {
+            return mOutputs[i].get();
+        }
     }
+    return nullptr;
+}
+
+ssize_t FieldStripper::dataSize(uint8_t privacyPolicy) {
+    ProtoOutputStream* out = outputOf(privacyPolicy);
+    return out != nullptr ? out->size() : mData->size();
+}
+
+status_t FieldStripper::writeData(uint8_t privacyPolicy, int fd) {
+    status_t err = NO_ERROR;
+    ProtoOutputStream* out = outputOf(privacyPolicy);
+    // A fresh reader for every fd, since reading moves it.
+    sp<ProtoReader> reader = out != nullptr ? out->data() : mData->read();
     while (reader->readBuffer() != NULL) {
         err = WriteFully(fd, reader->readBuffer(), reader->currentToRead()) ? NO_ERROR : -errno;
         reader->move(reader->currentToRead());
@@ -270,29 +336,29 @@ status_t PrivacyFilter::writeData(const FdBuffer& buffer, uint8_t bufferLevel,
         *maxSize = 0;
     }
 
-    // Order the writes by privacy filter, with increasing levels of filtration,k
-    // so we can do the filter once, and then write many times.
+    // Order the writes by privacy filter, with increasing levels of filtration.
     sort(mOutputs.begin(), mOutputs.end(),
         [](const sp<FilterFd>& a, const sp<FilterFd>& b) -> bool {
             return a->getPrivacyPolicy() < b->getPrivacyPolicy();
         });
 
-    uint8_t privacyPolicy = PRIVACY_POLICY_LOCAL; // a.k.a. no filtering
-    FieldStripper fieldStripper(mRestrictions, buffer.data()->read(), bufferLevel);
+    // Filter the data to every level needed in one pass, and then write many times.
+    FieldStripper fieldStripper(mRestrictions, buffer.data(), bufferLevel);
     for (const sp<FilterFd>& output: mOutputs) {
-        // Do another level of filtering if necessary
-        if (privacyPolicy != output->getPrivacyPolicy()) {
-            privacyPolicy = output->getPrivacyPolicy();
-            err = fieldStripper.strip(privacyPolicy);
-            if (err != NO_ERROR) {
-                // We can't successfully strip this data.  We will skip
-                // the rest of this section.
-                return NO_ERROR;
-            }
+        fieldStripper.addLevel(output->getPrivacyPolicy());
+    }
+    bool stripped = fieldStripper.strip() == NO_ERROR;
+
+    for (const sp<FilterFd>& output: mOutputs) {
+        const uint8_t privacyPolicy = output->getPrivacyPolicy();
+        if (!stripped && fieldStripper.needsStrip(privacyPolicy)) {
+            // We can't successfully strip this data.  We will skip
+            // the rest of this section.
+            return NO_ERROR;
         }
 
         // Write the resultant buffer to the fd, along with the header.
-        ssize_t dataSize = fieldStripper.dataSize();
+        ssize_t dataSize = fieldStripper.dataSize(privacyPolicy);
         if (dataSize > 0) {
             err = write_section_header(output->getFd(), mSectionId, dataSize);
             if (err != NO_ERROR) {
@@ -300,7 +366,7 @@ status_t PrivacyFilter::writeData(const FdBuffer& buffer, uint8_t bufferLevel,
                 continue;
             }
 
-            err = fieldStripper.writeData(output->getFd());
+            err = fieldStripper.writeData(privacyPolicy, output->getFd());
             if (err != NO_ERROR) {
                 output->onWriteError(err);
                 continue;
@@ -339,9 +405,69 @@ void ReadbackFilterFd::onWriteError(status_t err) {
 }
 
 // ================================================================================
+/**
+ * Filters and writes the wanted sections of a mapped report. Only those are copied, the
+ * others are skipped by their length without being read.
+ */
+static status_t filter_and_write_mapped_report(int to, const uint8_t* data, size_t size,
+        uint8_t bufferLevel, const IncidentReportArgs& args) {
+    status_t err;
+    ProtoFieldIterator fields(data, size);
+    ProtoField field;
+
+    while (fields.next(&field)) {
+        // Incident does not have any direct children other than sections.
+        if (field.wireType != WIRE_TYPE_LENGTH_DELIMITED
+                || !args.containsSection(field.id, section_requires_specific_mention(field.id))) {
+            continue;
+        }
+        // We need this field, but we need to strip it to the level provided in args.
+        PrivacyFilter filter(field.id, get_privacy_of_section(field.id));
+        filter.addFd(new ReadbackFilterFd(args.getPrivacyPolicy(), to));
+
+        FdBuffer sectionData;
+        err = sectionData.write(field.data, field.dataSize);
+        if (err != NO_ERROR) {
+            ALOGW("filter_and_write_report FdBuffer.write failed (this shouldn't happen): %s",
+                    strerror(-err));
+            return err;
+        }
+
+        err = filter.writeData(sectionData, bufferLevel, nullptr);
+        if (err != NO_ERROR) {
+            ALOGW("filter_and_write_report filter.writeData had an error: %s", strerror(-err));
+            return err;
+        }
+    }
+    clear_buffer_pool();
+    err = fields.getError();
+    if (err != NO_ERROR) {
+        ALOGW("filter_and_write_report report is malformed at %zu", fields.bytesRead());
+        return err;
+    }
+
+    return NO_ERROR;
+}
+
 status_t filter_and_write_report(int to, int from, uint8_t bufferLevel,
         const IncidentReportArgs& args) {
     status_t err;
+
+    // Stored reports are regular files, map them when possible.
+    struct stat st;
+    off64_t offset = lseek64(from, 0, SEEK_CUR);
+    if (offset >= 0 && fstat(from, &st) == 0 && S_ISREG(st.st_mode) && st.st_size > offset) {
+        std::unique_ptr<android::base::MappedFile> mapped = android::base::MappedFile::FromFd(
+                from, offset, st.st_size - offset, PROT_READ);
+        if (mapped != nullptr) {
+            return filter_and_write_mapped_report(to,
+                    reinterpret_cast<const uint8_t*>(mapped->data()), mapped->size(),
+                    bufferLevel, args);
+        }
+        ALOGW("filter_and_write_report can't map the report, reading it instead: %s",
+                strerror(errno));
+    }
+
     sp<ProtoFileReader> reader = new ProtoFileReader(from);
 
     while (reader->hasNext()) {
@@ -373,7 +499,7 @@ status_t filter_and_write_report(int to, int from, uint8_t bufferLevel,
         } else {
             // We don't need this field.  Incident does not have any direct children
             // other than sections.  So just skip them.
-            write_field_or_skip(NULL, reader, fieldTag, true);
+            write_field({}, 0, reader, fieldTag);
         }
     }
     clear_buffer_pool();
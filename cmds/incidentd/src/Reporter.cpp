@@ -38,6 +38,8 @@
 #include <sys/prctl.h>
 #include <sys/stat.h>
 #include <sys/types.h>
+#include <deque>
+#include <future>
 #include <string>
 #include <time.h>
 #include <wait.h>
@@ -55,6 +57,9 @@ using namespace android::util;
 const int FIELD_ID_METADATA = 2;
 // Args for exec gzip
 static const char* GZIP[] = {"/system/bin/gzip", NULL};
+// Most sections spend their time waiting on another process, so several of them are
+// executed at once.
+static const size_t MAX_CONCURRENT_SECTIONS = 4;
 
 IncidentMetadata_Destination privacy_policy_to_dest(uint8_t privacyPolicy) {
     switch (privacyPolicy) {
@@ -385,7 +390,9 @@ void ReportBatch::removeRequest(const sp<ReportRequest>& request) {
 ReportWriter::ReportWriter(const sp<ReportBatch>& batch)
         :mBatch(batch),
          mPersistedFile(),
-         mMaxPersistedPrivacyPolicy(PRIVACY_POLICY_UNSET) {
+         mMaxPersistedPrivacyPolicy(PRIVACY_POLICY_UNSET),
+         mMaxSectionDataFilteredSize(0),
+         mSpooling(false) {
 }
 
 ReportWriter::~ReportWriter() {
@@ -411,6 +418,7 @@ void ReportWriter::startSection(int sectionId) {
     mSectionBufferSuccess = false;
     mHadError = false;
     mSectionErrors.clear();
+    mMaxSectionDataFilteredSize = 0;
 }
 
 void ReportWriter::setSectionStats(const FdBuffer& buffer) {
@@ -493,6 +501,12 @@ void ReportWriter::vflog(const Section* section, status_t err, int level, const
 
 // Reads data from FdBuffer and writes it to the requests file descriptor.
 status_t ReportWriter::writeSection(const FdBuffer& buffer) {
+    if (mSpooling) {
+        // The buffer belongs to the section, so keep a copy until it is written out.
+        mSpooledData = make_unique<FdBuffer>();
+        return mSpooledData->write(buffer.data()->read());
+    }
+
     PrivacyFilter filter(mCurrentSectionId, get_privacy_of_section(mCurrentSectionId));
 
     // Add the fd for the persisted requests
@@ -514,15 +528,64 @@ status_t ReportWriter::writeSection(const FdBuffer& buffer) {
     return filter.writeData(buffer, PRIVACY_POLICY_LOCAL, &mMaxSectionDataFilteredSize);
 }
 
+void ReportWriter::setSpooling() {
+    mSpooling = true;
+}
+
+status_t ReportWriter::writeSpooledSection(ReportWriter* spool,
+        IncidentMetadata::SectionStats* sectionStats) {
+    mCurrentSectionId = spool->mCurrentSectionId;
+    mMaxSectionDataFilteredSize = 0;
+
+    status_t err = NO_ERROR;
+    if (spool->mSpooledData != nullptr) {
+        err = writeSection(*spool->mSpooledData);
+        spool->mSpooledData.reset();
+    }
+    sectionStats->set_report_size_bytes(mMaxSectionDataFilteredSize);
+    return err;
+}
+
+void ReportWriter::setSpooledData(const sp<EncodedBuffer>& data) {
+    mSectionStatsCalledForSectionId = mCurrentSectionId;
+    mSpooledData = make_unique<FdBuffer>(data);
+}
+
+// ================================================================================
+// A section executing on its own thread, with its own spooling writer.
+struct SpooledSection {
+    const Section* section;
+    ReportWriter writer;
+    IncidentMetadata::SectionStats stats;
+    status_t err;
+    // The id of the report the data was taken for, if it came from the section cache.
+    // Otherwise it is -1.
+    int64_t cachedFromReportId;
+    // Declared last, so that destroying the SpooledSection waits for the section to finish
+    // before the rest of it goes away. Not valid if the data came from the section cache.
+    future<void> done;
+
+    SpooledSection(const Section* s, const sp<ReportBatch>& batch)
+            :section(s),
+             writer(batch),
+             err(NO_ERROR),
+             cachedFromReportId(-1) {
+        writer.setSpooling();
+    }
+};
+
 
 // ================================================================================
 Reporter::Reporter(const sp<WorkDirectory>& workDirectory,
                    const sp<ReportBatch>& batch,
-                   const vector<BringYourOwnSection*>& registeredSections)
+                   const vector<BringYourOwnSection*>& registeredSections,
+                   const sp<SectionCache>& sectionCache)
         :mWorkDirectory(workDirectory),
          mWriter(batch),
          mBatch(batch),
-         mRegisteredSections(registeredSections) {
+         mRegisteredSections(registeredSections),
+         mSectionCache(sectionCache),
+         mReportId(0) {
 }
 
 Reporter::~Reporter() {
@@ -608,6 +671,7 @@ void Reporter::runReport(size_t* reportByteSize) {
         clock_gettime(CLOCK_REALTIME, &spec);
         reportId = (spec.tv_sec) * 1000 + spec.tv_nsec;
     }
+    mReportId = reportId;
 
     mBatch->forEachStreamingRequest([](const sp<ReportRequest>& request) {
         status_t err = request->initGzipIfNecessary();
@@ -635,19 +699,8 @@ void Reporter::runReport(size_t* reportByteSize) {
 
     // For each of the report fields, see if we need it, and if so, execute the command
     // and report to those that care that we're doing it.
-    for (const Section** section = SECTION_LIST; *section; section++) {
-        if (execute_section(*section, &metadata, reportByteSize) != NO_ERROR) {
-            goto DONE;
-        }
-    }
+    execute_sections(&metadata, reportByteSize);
 
-    for (const Section* section : mRegisteredSections) {
-        if (execute_section(section, &metadata, reportByteSize) != NO_ERROR) {
-            goto DONE;
-        }
-    }
-
-DONE:
     // Finish up the persisted file.
     if (mPersistedFile != nullptr) {
         mPersistedFile->closeDataFile();
@@ -702,17 +755,43 @@ DONE:
     ALOGI("Done taking incident report err=%s", strerror(-err));
 }
 
-status_t Reporter::execute_section(const Section* section, IncidentMetadata* metadata,
-        size_t* reportByteSize) {
-    const int sectionId = section->id;
+status_t Reporter::execute_sections(IncidentMetadata* metadata, size_t* reportByteSize) {
+    vector<const Section*> sections;
+    for (const Section** section = SECTION_LIST; *section; section++) {
+        sections.push_back(*section);
+    }
+    for (const Section* section : mRegisteredSections) {
+        sections.push_back(section);
+    }
+
+    // Up to MAX_CONCURRENT_SECTIONS sections run at once, each spooling its data. They are
+    // written out in list order, so the report is the same as if they had run one by one.
+    deque<unique_ptr<SpooledSection>> running;
+    vector<const Section*>::const_iterator next = sections.begin();
+    while (true) {
+        while (running.size() < MAX_CONCURRENT_SECTIONS && next != sections.end()) {
+            const Section* section = *next++;
+            // If nobody wants this section, skip it.
+            if (mBatch->containsSection(section->id)) {
+                running.push_back(start_section(section));
+            }
+        }
+        if (running.empty()) {
+            return NO_ERROR;
+        }
 
-    // If nobody wants this section, skip it.
-    if (!mBatch->containsSection(sectionId)) {
-        return NO_ERROR;
+        // On error, the sections still running are waited for as they are destroyed.
+        status_t err = finish_section(running.front().get(), metadata, reportByteSize);
+        running.pop_front();
+        if (err != NO_ERROR) {
+            return err;
+        }
     }
+}
 
+unique_ptr<SpooledSection> Reporter::start_section(const Section* section) {
+    const int sectionId = section->id;
     ALOGD("Start incident report section %d '%s'", sectionId, section->name.string());
-    IncidentMetadata::SectionStats* sectionMetadata = metadata->add_sections();
 
     // Notify listener of starting
     mBatch->forEachListener(sectionId, [sectionId](const auto& listener) {
@@ -720,10 +799,52 @@ status_t Reporter::execute_section(const Section* section, IncidentMetadata* met
                 sectionId, IIncidentReportStatusListener::STATUS_STARTING);
     });
 
-    // Go get the data and write it into the file descriptors.
-    mWriter.startSection(sectionId);
-    status_t err = section->Execute(&mWriter);
-    mWriter.endSection(sectionMetadata);
+    unique_ptr<SpooledSection> spooled = make_unique<SpooledSection>(section, mBatch);
+
+    // Reuse the data of a recent report if there is one.
+    if (mSectionCache != nullptr) {
+        sp<EncodedBuffer> data = mSectionCache->get(sectionId, &spooled->stats,
+                &spooled->cachedFromReportId);
+        if (data != nullptr) {
+            ALOGD("Section %d is reused from report %lld", sectionId,
+                    (long long)spooled->cachedFromReportId);
+            spooled->stats.set_exec_duration_ms(0);
+            spooled->writer.startSection(sectionId);
+            spooled->writer.setSpooledData(data);
+            return spooled;
+        }
+    }
+
+    // Go get the data. Only the spooling writer is touched from the section's thread.
+    SpooledSection* s = spooled.get();
+    s->done = async(launch::async, [s]() {
+        s->writer.startSection(s->section->id);
+        s->err = s->section->Execute(&s->writer);
+        s->writer.endSection(&s->stats);
+    });
+    return spooled;
+}
+
+status_t Reporter::finish_section(SpooledSection* spooled, IncidentMetadata* metadata,
+        size_t* reportByteSize) {
+    const Section* section = spooled->section;
+    const int sectionId = section->id;
+    if (spooled->done.valid()) {
+        spooled->done.wait();
+    }
+
+    // Write the data into the file descriptors.
+    IncidentMetadata::SectionStats* sectionMetadata = metadata->add_sections();
+    *sectionMetadata = spooled->stats;
+    status_t err = spooled->err;
+    const FdBuffer* data = spooled->writer.getSpooledData();
+    if (err == NO_ERROR && mSectionCache != nullptr && spooled->cachedFromReportId < 0
+            && data != nullptr && spooled->stats.success()) {
+        mSectionCache->put(sectionId, mReportId, *data, spooled->stats);
+    }
+    if (err == NO_ERROR) {
+        err = mWriter.writeSpooledSection(&spooled->writer, sectionMetadata);
+    }
 
     // Sections returning errors are fatal. Most errors should not be fatal.
     if (err != NO_ERROR) {
@@ -17,6 +17,7 @@
 
 #include "incidentd_util.h"
 #include "FdBuffer.h"
+#include "SectionCache.h"
 #include "WorkDirectory.h"
 
 #include "frameworks/base/core/proto/android/os/metadata.pb.h"
@@ -27,6 +28,7 @@
 #include <android/util/protobuf.h>
 
 #include <map>
+#include <memory>
 #include <string>
 #include <vector>
 
@@ -43,6 +45,7 @@ using namespace android::os;
 
 class BringYourOwnSection;
 class Section;
+struct SpooledSection;
 
 // ================================================================================
 class ReportRequest : public virtual RefBase {
@@ -207,6 +210,30 @@ public:
 
     status_t writeSection(const FdBuffer& buffer);
 
+    /**
+     * Make writeSection() keep a copy of the data instead of writing it to the requests, so
+     * that the section can be executed on another thread. The data is written out later by
+     * calling writeSpooledSection() on the real writer.
+     */
+    void setSpooling();
+
+    /**
+     * Write the data spooled by the section that was executed with spool, and record its
+     * filtered size in sectionStats.
+     */
+    status_t writeSpooledSection(ReportWriter* spool,
+                                 IncidentMetadata::SectionStats* sectionStats);
+
+    /**
+     * Make data the spooled data of the current section, as if the section had written it.
+     */
+    void setSpooledData(const sp<EncodedBuffer>& data);
+
+    /**
+     * The data spooled by the current section, or nullptr if it didn't write any.
+     */
+    const FdBuffer* getSpooledData() const { return mSpooledData.get(); }
+
 private:
     // Data about all requests
     sp<ReportBatch> mBatch;
@@ -251,6 +278,12 @@ private:
     string mSectionErrors;
     size_t mMaxSectionDataFilteredSize;
 
+    /**
+     * Whether writeSection() spools the data into mSpooledData.
+     */
+    bool mSpooling;
+    unique_ptr<FdBuffer> mSpooledData;
+
     void vflog(const Section* section, status_t err, int level, const char* levelText,
         const char* format, va_list args);
 };
@@ -260,7 +293,8 @@ class Reporter : public virtual RefBase {
 public:
     Reporter(const sp<WorkDirectory>& workDirectory,
              const sp<ReportBatch>& batch,
-             const vector<BringYourOwnSection*>& registeredSections);
+             const vector<BringYourOwnSection*>& registeredSections,
+             const sp<SectionCache>& sectionCache = nullptr);
 
     virtual ~Reporter();
 
@@ -273,8 +307,14 @@ private:
     sp<ReportBatch> mBatch;
     sp<ReportFile> mPersistedFile;
     const vector<BringYourOwnSection*>& mRegisteredSections;
+    sp<SectionCache> mSectionCache;
+    int64_t mReportId;
+
+    status_t execute_sections(IncidentMetadata* metadata, size_t* reportByteSize);
+
+    unique_ptr<SpooledSection> start_section(const Section* section);
 
-    status_t execute_section(const Section* section, IncidentMetadata* metadata,
+    status_t finish_section(SpooledSection* spooled, IncidentMetadata* metadata,
         size_t* reportByteSize);
 
     void cancel_and_remove_failed_requests();
@@ -20,6 +20,10 @@
 
 #include <dirent.h>
 #include <errno.h>
+#include <inttypes.h>
+#include <pwd.h>
+#include <algorithm>
+#include <atomic>
 #include <mutex>
 #include <set>
 #include <thread>
@@ -27,6 +31,7 @@
 #include <android-base/file.h>
 #include <android-base/properties.h>
 #include <android-base/stringprintf.h>
+#include <android-base/strings.h>
 #include <android/util/protobuf.h>
 #include <android/util/ProtoOutputStream.h>
 #include <binder/IServiceManager.h>
@@ -42,6 +47,8 @@
 #include "Privacy.h"
 #include "frameworks/base/core/proto/android/os/backtrace.proto.h"
 #include "frameworks/base/core/proto/android/os/data.proto.h"
+#include "frameworks/base/core/proto/android/os/procrank.proto.h"
+#include "frameworks/base/core/proto/android/os/ps.proto.h"
 #include "frameworks/base/core/proto/android/util/log.proto.h"
 #include "frameworks/base/core/proto/android/util/textdump.proto.h"
 #include "incidentd_util.h"
@@ -58,7 +65,6 @@ const int FIELD_ID_INCIDENT_METADATA = 2;
 
 // incident section parameters
 const char INCIDENT_HELPER[] = "/system/bin/incident_helper";
-const char* GZIP[] = {"/system/bin/gzip", NULL};
 
 static pid_t fork_execute_incident_helper(const int id, Fpipe* p2cPipe, Fpipe* c2pPipe) {
     const char* ihArgs[]{INCIDENT_HELPER, "-s", String8::format("%d", id).string(), NULL};
@@ -174,20 +180,6 @@ status_t GZipSection::Execute(ReportWriter* writer) const {
         return NO_ERROR;  // e.g. LAST_KMSG will reach here in user build.
     }
     FdBuffer buffer;
-    Fpipe p2cPipe;
-    Fpipe c2pPipe;
-    // initiate pipes to pass data to/from gzip
-    if (!p2cPipe.init() || !c2pPipe.init()) {
-        ALOGW("[%s] failed to setup pipes", this->name.string());
-        return -errno;
-    }
-
-    pid_t pid = fork_execute_cmd((char* const*)GZIP, &p2cPipe, &c2pPipe);
-    if (pid == -1) {
-        ALOGW("[%s] failed to fork", this->name.string());
-        return -errno;
-    }
-    // parent process
 
     // construct Fdbuffer to output GZippedfileProto, the reason to do this instead of using
     // ProtoOutputStream is to avoid allocation of another buffer inside ProtoOutputStream.
@@ -205,22 +197,15 @@ status_t GZipSection::Execute(ReportWriter* writer) const {
     size_t dataBeginAt = internalBuffer->wp()->pos();
     VLOG("[%s] editPos=%zu, dataBeginAt=%zu", this->name.string(), editPos, dataBeginAt);
 
-    status_t readStatus = buffer.readProcessedDataInStream(
-            fd.get(), std::move(p2cPipe.writeFd()), std::move(c2pPipe.readFd()), this->timeoutMs,
-            isSysfs(mFilenames[index]));
+    // The file is compressed in process, so there is no gzip process to pipe the data through.
+    status_t readStatus = buffer.readAndGzip(fd.get(), this->timeoutMs);
     writer->setSectionStats(buffer);
     if (readStatus != NO_ERROR || buffer.timedOut()) {
-        ALOGW("[%s] failed to read data from gzip: %s, timedout: %s", this->name.string(),
+        ALOGW("[%s] failed to gzip data: %s, timedout: %s", this->name.string(),
               strerror(-readStatus), buffer.timedOut() ? "true" : "false");
-        kill_child(pid);
         return readStatus;
     }
 
-    status_t gzipStatus = wait_child(pid);
-    if (gzipStatus != NO_ERROR) {
-        ALOGW("[%s] abnormal child process: %s", this->name.string(), strerror(-gzipStatus));
-        return gzipStatus;
-    }
     // Revisit the actual size from gzip result and edit the internal buffer accordingly.
     size_t dataSize = buffer.size() - dataBeginAt;
     internalBuffer->wp()->rewind()->move(editPos);
@@ -865,6 +850,308 @@ status_t TombstoneSection::BlockingCall(unique_fd& pipeWriteFd) const {
     return err;
 }
 
+// ================================================================================
+const int PROC_WORKERS_MAX = 4;
+
+// The fields of /proc/<pid>/stat that the process sections report.
+struct ProcStat {
+    std::string comm;
+    char state = '\0';
+    int ppid = 0;
+    uint64_t utime = 0;
+    uint64_t stime = 0;
+    int64_t priority = 0;
+    int64_t nice = 0;
+    uint64_t vsize = 0;  // in bytes
+    int64_t rss = 0;     // in pages
+};
+
+// The totals of /proc/<pid>/smaps_rollup, in kB.
+struct ProcMemory {
+    int64_t rss = 0;
+    int64_t pss = 0;
+    int64_t uss = 0;
+    int64_t swap = 0;
+    int64_t swapPss = 0;
+};
+
+struct ProcEntry {
+    int pid = 0;
+    bool valid = false;
+    std::string user;
+    std::string label;
+    std::string cmdline;
+    ProcMemory memory;
+    std::vector<std::pair<int, ProcStat>> tasks;  // tid and its stat, the main thread first
+};
+
+static std::vector<int> list_numeric_dirs(const char* path) {
+    std::vector<int> ids;
+    std::unique_ptr<DIR, decltype(&closedir)> dir(opendir(path), closedir);
+    if (dir.get() == nullptr) {
+        return ids;
+    }
+    struct dirent* d;
+    while ((d = readdir(dir.get()))) {
+        int id = atoi(d->d_name);
+        if (id > 0) {
+            ids.push_back(id);
+        }
+    }
+    std::sort(ids.begin(), ids.end());
+    return ids;
+}
+
+static bool parse_proc_stat(const std::string& data, ProcStat* stat) {
+    // comm may contain spaces and parentheses, it ends at the last ')'.
+    const size_t open = data.find('(');
+    const size_t close = data.rfind(')');
+    if (open == std::string::npos || close == std::string::npos || close < open ||
+            close + 2 >= data.size()) {
+        return false;
+    }
+    stat->comm = data.substr(open + 1, close - open - 1);
+
+    // Index 0 is the state, i.e. field 3 of proc(5).
+    const std::vector<std::string> fields = Split(data.substr(close + 2), " ");
+    if (fields.size() <= 21) {
+        return false;
+    }
+    stat->state = fields[0].empty() ? '\0' : fields[0][0];
+    stat->ppid = atoi(fields[1].c_str());
+    stat->utime = strtoull(fields[11].c_str(), nullptr, 10);
+    stat->stime = strtoull(fields[12].c_str(), nullptr, 10);
+    stat->priority = strtoll(fields[15].c_str(), nullptr, 10);
+    stat->nice = strtoll(fields[16].c_str(), nullptr, 10);
+    stat->vsize = strtoull(fields[20].c_str(), nullptr, 10);
+    stat->rss = strtoll(fields[21].c_str(), nullptr, 10);
+    return true;
+}
+
+static bool read_proc_stat(const std::string& path, ProcStat* stat) {
+    std::string data;
+    return ReadFileToString(path, &data) && parse_proc_stat(data, stat);
+}
+
+static std::string read_proc_user(int pid) {
+    std::string status;
+    if (!ReadFileToString(StringPrintf("/proc/%d/status", pid), &status)) {
+        return "";
+    }
+    const size_t pos = status.find("\nUid:");
+    if (pos == std::string::npos) {
+        return "";
+    }
+    const uid_t uid = strtoul(status.c_str() + pos + 5, nullptr, 10);
+    struct passwd pwd;
+    struct passwd* result = nullptr;
+    char buf[256];
+    if (getpwuid_r(uid, &pwd, buf, sizeof(buf), &result) == 0 && result != nullptr) {
+        return result->pw_name;
+    }
+    return std::to_string(uid);
+}
+
+static void read_proc_memory(int pid, ProcMemory* memory) {
+    std::string rollup;
+    if (!ReadFileToString(StringPrintf("/proc/%d/smaps_rollup", pid), &rollup)) {
+        return;
+    }
+    for (const std::string& line : Split(rollup, "\n")) {
+        const size_t colon = line.find(':');
+        if (colon == std::string::npos) {
+            continue;
+        }
+        const int64_t kb = strtoll(line.c_str() + colon + 1, nullptr, 10);
+        const std::string key = line.substr(0, colon);
+        if (key == "Rss") {
+            memory->rss = kb;
+        } else if (key == "Pss") {
+            memory->pss = kb;
+        } else if (key == "Private_Clean" || key == "Private_Dirty") {
+            memory->uss += kb;
+        } else if (key == "Swap") {
+            memory->swap = kb;
+        } else if (key == "SwapPss") {
+            memory->swapPss = kb;
+        }
+    }
+}
+
+// Reads everything a section type needs for one process. Processes may exit while we walk
+// /proc, those are left invalid and skipped.
+static void read_proc_entry(const std::string& type, ProcEntry* entry) {
+    const int pid = entry->pid;
+    ProcStat stat;
+    if (!read_proc_stat(StringPrintf("/proc/%d/stat", pid), &stat)) {
+        return;
+    }
+
+    if (type == "procrank") {
+        // Kernel threads have no memory of their own, procrank does not list them either.
+        if (stat.vsize == 0) {
+            return;
+        }
+        read_proc_memory(pid, &entry->memory);
+        std::string cmdline;
+        ReadFileToString(StringPrintf("/proc/%d/cmdline", pid), &cmdline);
+        // Only argv[0], like procrank.
+        entry->cmdline = cmdline.substr(0, cmdline.find('\0'));
+        if (entry->cmdline.empty()) {
+            entry->cmdline = stat.comm;
+        }
+        entry->tasks.emplace_back(pid, stat);
+        entry->valid = true;
+        return;
+    }
+
+    entry->user = read_proc_user(pid);
+    if (ReadFileToString(StringPrintf("/proc/%d/attr/current", pid), &entry->label)) {
+        entry->label = Trim(entry->label.substr(0, entry->label.find('\0')));
+    }
+    entry->tasks.emplace_back(pid, stat);
+    for (int tid : list_numeric_dirs(StringPrintf("/proc/%d/task", pid).c_str())) {
+        if (tid == pid) {
+            continue;
+        }
+        ProcStat taskStat;
+        if (read_proc_stat(StringPrintf("/proc/%d/task/%d/stat", pid, tid), &taskStat)) {
+            entry->tasks.emplace_back(tid, taskStat);
+        }
+    }
+    entry->valid = true;
+}
+
+static int ps_state(char state) {
+    switch (state) {
+        case 'D': return PsProto::Process::STATE_D;
+        case 'R': return PsProto::Process::STATE_R;
+        case 'S': return PsProto::Process::STATE_S;
+        case 'T': return PsProto::Process::STATE_T;
+        case 't': return PsProto::Process::STATE_TRACING;
+        case 'X': return PsProto::Process::STATE_X;
+        case 'Z': return PsProto::Process::STATE_Z;
+        default: return PsProto::Process::STATE_UNKNOWN;
+    }
+}
+
+static void write_ps_entry(ProtoOutputStream* proto, const ProcEntry& entry, long pageKb,
+                           long clockTicks) {
+    for (const auto& task : entry.tasks) {
+        const ProcStat& stat = task.second;
+        const uint64_t seconds = (stat.utime + stat.stime) / clockTicks;
+        uint64_t token = proto->start(PsProto::PROCESSES);
+        proto->write(PsProto::Process::LABEL, entry.label);
+        proto->write(PsProto::Process::USER, entry.user);
+        proto->write(PsProto::Process::PID, entry.pid);
+        proto->write(PsProto::Process::TID, task.first);
+        proto->write(PsProto::Process::PPID, stat.ppid);
+        proto->write(PsProto::Process::VSZ, (long long)(stat.vsize / 1024));
+        proto->write(PsProto::Process::RSS, (long long)(stat.rss * pageKb));
+        proto->write(PsProto::Process::S, ps_state(stat.state));
+        // Same as toybox ps, which reports 39 - priority.
+        proto->write(PsProto::Process::PRI, (long long)(39 - stat.priority));
+        proto->write(PsProto::Process::NI, (long long)stat.nice);
+        proto->write(PsProto::Process::TIME,
+                     StringPrintf("%02" PRIu64 ":%02" PRIu64 ":%02" PRIu64, seconds / 3600,
+                                  seconds / 60 % 60, seconds % 60));
+        proto->write(PsProto::Process::CMD, stat.comm);
+        proto->end(token);
+    }
+}
+
+static void write_procrank_entry(ProtoOutputStream* proto, const ProcEntry& entry) {
+    const ProcStat& stat = entry.tasks[0].second;
+    uint64_t token = proto->start(ProcrankProto::PROCESSES);
+    proto->write(ProcrankProto::Process::PID, entry.pid);
+    proto->write(ProcrankProto::Process::VSS, (long long)(stat.vsize / 1024));
+    proto->write(ProcrankProto::Process::RSS, (long long)entry.memory.rss);
+    proto->write(ProcrankProto::Process::PSS, (long long)entry.memory.pss);
+    proto->write(ProcrankProto::Process::USS, (long long)entry.memory.uss);
+    proto->write(ProcrankProto::Process::SWAP, (long long)entry.memory.swap);
+    proto->write(ProcrankProto::Process::PSWAP, (long long)entry.memory.swapPss);
+    proto->write(ProcrankProto::Process::CMDLINE, entry.cmdline);
+    proto->end(token);
+}
+
+ProcSection::ProcSection(int id, const char* type, const int64_t timeoutMs)
+    : WorkerThreadSection(id, timeoutMs), mType(type) {
+    name = "proc ";
+    name += type;
+}
+
+ProcSection::~ProcSection() {}
+
+status_t ProcSection::BlockingCall(unique_fd& pipeWriteFd) const {
+    if (mType != "ps" && mType != "procrank") {
+        ALOGE("[%s] unknown type", this->name.string());
+        return BAD_VALUE;
+    }
+
+    const std::vector<int> pids = list_numeric_dirs("/proc");
+    if (pids.empty()) {
+        ALOGE("[%s] no process found in /proc: %s", this->name.string(), strerror(errno));
+        return -errno;
+    }
+
+    // Most of the time is spent in the kernel generating the /proc files, so a few threads
+    // pulling pids from a shared counter keep up with it.
+    std::vector<ProcEntry> entries(pids.size());
+    for (size_t i = 0; i < pids.size(); i++) {
+        entries[i].pid = pids[i];
+    }
+    std::atomic<size_t> next(0);
+    auto worker = [&]() {
+        size_t i;
+        while ((i = next++) < entries.size()) {
+            read_proc_entry(mType, &entries[i]);
+        }
+    };
+    const size_t workerCount = std::min<size_t>(
+            PROC_WORKERS_MAX, std::max(1u, std::thread::hardware_concurrency()));
+    std::vector<std::thread> workers;
+    for (size_t i = 1; i < workerCount && i < entries.size(); i++) {
+        workers.emplace_back(worker);
+    }
+    worker();
+    for (std::thread& thread : workers) {
+        thread.join();
+    }
+
+    if (mType == "procrank") {
+        // procrank lists the processes by pss, largest first.
+        std::stable_sort(entries.begin(), entries.end(),
+                         [](const ProcEntry& a, const ProcEntry& b) {
+                             return a.memory.pss > b.memory.pss;
+                         });
+    }
+
+    const long pageKb = sysconf(_SC_PAGESIZE) / 1024;
+    const long clockTicks = sysconf(_SC_CLK_TCK);
+    auto pooledBuffer = get_buffer_from_pool();
+    ProtoOutputStream proto(pooledBuffer);
+    for (const ProcEntry& entry : entries) {
+        if (!entry.valid) {
+            continue;
+        }
+        if (mType == "ps") {
+            write_ps_entry(&proto, entry, pageKb, clockTicks);
+        } else {
+            write_procrank_entry(&proto, entry);
+        }
+    }
+
+    status_t err = NO_ERROR;
+    if (!proto.flush(pipeWriteFd.get())) {
+        if (errno == EPIPE) {
+            ALOGE("[%s] wrote to a broken pipe\n", this->name.string());
+        }
+        err = -errno;
+    }
+    return_buffer_to_pool(pooledBuffer);
+    return err;
+}
+
 // ================================================================================
 BringYourOwnSection::BringYourOwnSection(int id, const char* customName, const uid_t callingUid,
         const sp<IIncidentDumpCallback>& callback)
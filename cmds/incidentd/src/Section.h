@@ -193,6 +193,23 @@ private:
     std::string mType;
 };
 
+/**
+ * Section that walks /proc in process and writes the process table directly as a proto,
+ * instead of forking ps or procrank and parsing their text output in incident_helper.
+ * The type is "ps" (PsProto, one entry per thread) or "procrank" (ProcrankProto, one entry
+ * per process with its smaps_rollup totals). The pids are read by a few threads in parallel.
+ */
+class ProcSection : public WorkerThreadSection {
+public:
+    ProcSection(int id, const char* type, int64_t timeoutMs = 10000 /* 10 seconds */);
+    virtual ~ProcSection();
+
+    virtual status_t BlockingCall(unique_fd& pipeWriteFd) const;
+
+private:
+    std::string mType;
+};
+
 /**
  * Section that gets data from a registered dump callback.
  */
@@ -0,0 +1,136 @@
+/*
+ * Copyright (C) 2020 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#define DEBUG false
+#include "Log.h"
+
+#include "SectionCache.h"
+
+#include <inttypes.h>
+#include <utils/SystemClock.h>
+
+namespace android {
+namespace os {
+namespace incidentd {
+
+SectionCache::SectionCache(size_t maxBytes)
+    : mMaxBytes(maxBytes),
+      mTtlMs(0),
+      mBytes(0),
+      mHits(0),
+      mMisses(0) {}
+
+SectionCache::~SectionCache() {}
+
+void SectionCache::setTtlMs(int64_t ttlMs) {
+    std::unique_lock<std::mutex> lock(mLock);
+    mTtlMs = ttlMs > 0 ? ttlMs : 0;
+    if (mTtlMs == 0) {
+        mEntries.clear();
+        mBytes = 0;
+    }
+}
+
+sp<EncodedBuffer> SectionCache::get(int sectionId, IncidentMetadata::SectionStats* stats,
+                                    int64_t* reportId) {
+    std::unique_lock<std::mutex> lock(mLock);
+    if (mTtlMs == 0) {
+        return nullptr;
+    }
+    remove_expired_locked(android::elapsedRealtime());
+
+    auto it = mEntries.find(sectionId);
+    if (it == mEntries.end()) {
+        mMisses++;
+        return nullptr;
+    }
+    mHits++;
+    *stats = it->second.stats;
+    *reportId = it->second.reportId;
+    return it->second.data;
+}
+
+void SectionCache::put(int sectionId, int64_t reportId, const FdBuffer& data,
+                       const IncidentMetadata::SectionStats& stats) {
+    std::unique_lock<std::mutex> lock(mLock);
+    if (mTtlMs == 0 || data.size() > mMaxBytes) {
+        return;
+    }
+    const int64_t now = android::elapsedRealtime();
+    remove_expired_locked(now);
+
+    auto it = mEntries.find(sectionId);
+    if (it != mEntries.end()) {
+        remove_locked(it);
+    }
+    // Make room by dropping the oldest entries.
+    while (mBytes + data.size() > mMaxBytes) {
+        auto oldest = mEntries.begin();
+        for (auto e = mEntries.begin(); e != mEntries.end(); e++) {
+            if (e->second.takenAtMs < oldest->second.takenAtMs) {
+                oldest = e;
+            }
+        }
+        remove_locked(oldest);
+    }
+
+    // The section's buffer goes back to the buffer pool, so keep our own copy.
+    sp<EncodedBuffer> copy = new EncodedBuffer();
+    if (copy->writeRaw(data.data()->read()) != NO_ERROR) {
+        VLOG("Failed to cache section %d", sectionId);
+        return;
+    }
+    Entry& entry = mEntries[sectionId];
+    entry.data = copy;
+    entry.stats = stats;
+    entry.reportId = reportId;
+    entry.takenAtMs = now;
+    mBytes += copy->size();
+}
+
+void SectionCache::dump(FILE* out) {
+    std::unique_lock<std::mutex> lock(mLock);
+    fprintf(out, "mTtlMs=%" PRIi64 "\n", mTtlMs);
+    fprintf(out, "mMaxBytes=%zu\n", mMaxBytes);
+    fprintf(out, "mBytes=%zu\n", mBytes);
+    fprintf(out, "mHits=%zu\n", mHits);
+    fprintf(out, "mMisses=%zu\n", mMisses);
+    const int64_t now = android::elapsedRealtime();
+    for (const auto& entry : mEntries) {
+        fprintf(out, "section %d: %zu bytes from report %" PRIi64 ", %" PRIi64 " ms old\n",
+                entry.first, entry.second.data->size(), entry.second.reportId,
+                now - entry.second.takenAtMs);
+    }
+}
+
+void SectionCache::remove_expired_locked(int64_t now) {
+    auto it = mEntries.begin();
+    while (it != mEntries.end()) {
+        auto next = std::next(it);
+        if (now - it->second.takenAtMs >= mTtlMs) {
+            remove_locked(it);
+        }
+        it = next;
+    }
+}
+
+void SectionCache::remove_locked(std::map<int, Entry>::iterator it) {
+    mBytes -= it->second.data->size();
+    mEntries.erase(it);
+}
+
+}  // namespace incidentd
+}  // namespace os
+}  // namespace android
@@ -0,0 +1,90 @@
+/*
+ * Copyright (C) 2020 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include "FdBuffer.h"
+
+#include "frameworks/base/core/proto/android/os/metadata.pb.h"
+#include <android/util/EncodedBuffer.h>
+#include <utils/RefBase.h>
+
+#include <map>
+#include <mutex>
+#include <stdio.h>
+
+namespace android {
+namespace os {
+namespace incidentd {
+
+using namespace android::util;
+
+/**
+ * Keeps the unfiltered output of the sections of recent reports, so that reports triggered
+ * again within the TTL (e.g. by a storm of statsd anomaly alerts) reuse it instead of
+ * running the sections again. The data is filtered for each destination when it is written,
+ * so one entry serves every privacy level.
+ */
+class SectionCache : public virtual android::RefBase {
+public:
+    explicit SectionCache(size_t maxBytes);
+    ~SectionCache();
+
+    /**
+     * How long the data of a section stays usable. 0 disables the cache.
+     */
+    void setTtlMs(int64_t ttlMs);
+
+    /**
+     * Return the cached data of the section, or nullptr if there is none that is recent
+     * enough. On success, stats and reportId get the stats of the section and the id of the
+     * report the data was taken for.
+     */
+    sp<EncodedBuffer> get(int sectionId, IncidentMetadata::SectionStats* stats,
+                          int64_t* reportId);
+
+    /**
+     * Keep a copy of the data of the section that was taken for the report.
+     */
+    void put(int sectionId, int64_t reportId, const FdBuffer& data,
+             const IncidentMetadata::SectionStats& stats);
+
+    void dump(FILE* out);
+
+private:
+    struct Entry {
+        sp<EncodedBuffer> data;
+        IncidentMetadata::SectionStats stats;
+        int64_t reportId;
+        int64_t takenAtMs;
+    };
+
+    const size_t mMaxBytes;
+
+    std::mutex mLock;
+    int64_t mTtlMs;
+    std::map<int, Entry> mEntries;
+    size_t mBytes;
+    size_t mHits;
+    size_t mMisses;
+
+    void remove_expired_locked(int64_t now);
+    void remove_locked(std::map<int, Entry>::iterator it);
+};
+
+}  // namespace incidentd
+}  // namespace os
+}  // namespace android
@@ -67,8 +67,26 @@ void return_buffer_to_pool(sp<EncodedBuffer> buffer) {
 }
 
 void clear_buffer_pool() {
-    std::scoped_lock<std::mutex> lock(gBufferPoolLock);
-    gBufferPool.clear();
+    {
+        std::scoped_lock<std::mutex> lock(gBufferPoolLock);
+        gBufferPool.clear();
+    }
+    // The chunks of the buffers freed above went back to the chunk pool.
+    EncodedBuffer::trimChunkPool();
+}
+
+void dump_buffer_pool(FILE* out) {
+    size_t pooledBuffers;
+    {
+        std::scoped_lock<std::mutex> lock(gBufferPoolLock);
+        pooledBuffers = gBufferPool.size();
+    }
+    EncodedBuffer::ChunkPoolStats stats = EncodedBuffer::getChunkPoolStats();
+    fprintf(out, "pooledBuffers=%zu\n", pooledBuffers);
+    fprintf(out, "chunkPoolHits=%zu\n", stats.hits);
+    fprintf(out, "chunkPoolMisses=%zu\n", stats.misses);
+    fprintf(out, "chunkPoolCachedChunks=%zu\n", stats.cachedChunks);
+    fprintf(out, "chunkPoolCachedBytes=%zu\n", stats.cachedBytes);
 }
 
 // ================================================================================
@@ -19,6 +19,7 @@
 #define INCIDENTD_UTIL_H
 
 #include <stdarg.h>
+#include <stdio.h>
 #include <utils/Errors.h>
 
 #include "Privacy.h"
@@ -59,6 +60,12 @@ void return_buffer_to_pool(sp<EncodedBuffer> buffer);
  */
 void clear_buffer_pool();
 
+/**
+ * Print the state of the buffer pool and of the EncodedBuffer chunk pool.
+ * Thread safe.
+ */
+void dump_buffer_pool(FILE* out);
+
 /**
  * This class wraps android::base::Pipe.
  */
@@ -23,6 +23,7 @@
 
 #include <android-base/file.h>
 #include <gtest/gtest.h>
+#include <zlib.h>
 
 using namespace android;
 using namespace android::base;
@@ -326,3 +327,35 @@ TEST_F(FdBufferTest, ReadInStreamTimeOut) {
         kill(pid, SIGKILL);  // reap the child process
     }
 }
+
+TEST_F(FdBufferTest, ReadAndGzip) {
+    std::string testdata;
+    for (int i = 0; i < 10000; i++) {
+        testdata += "gzip test line " + std::to_string(i) + "\n";
+    }
+    ASSERT_TRUE(WriteStringToFile(testdata, tf.path));
+
+    ASSERT_EQ(NO_ERROR, buffer.readAndGzip(tf.fd, READ_TIMEOUT));
+    EXPECT_FALSE(buffer.timedOut());
+    EXPECT_FALSE(buffer.truncated());
+    EXPECT_LT(buffer.size(), testdata.size());
+
+    std::string compressed;
+    sp<ProtoReader> reader = buffer.data()->read();
+    while (reader->hasNext()) {
+        compressed += reader->next();
+    }
+
+    z_stream stream;
+    memset(&stream, 0, sizeof(stream));
+    ASSERT_EQ(Z_OK, inflateInit2(&stream, MAX_WBITS + 16));
+    std::string actual(testdata.size(), '\0');
+    stream.next_in = (Bytef*)compressed.data();
+    stream.avail_in = compressed.size();
+    stream.next_out = (Bytef*)&actual[0];
+    stream.avail_out = actual.size();
+    EXPECT_EQ(Z_STREAM_END, inflate(&stream, Z_FINISH));
+    EXPECT_EQ(0u, stream.avail_out);
+    inflateEnd(&stream);
+    EXPECT_EQ(testdata, actual);
+}
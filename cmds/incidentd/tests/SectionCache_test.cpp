@@ -0,0 +1,78 @@
+// Copyright (C) 2020 The Android Open Source Project
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+#define DEBUG false
+#include "Log.h"
+
+#include "SectionCache.h"
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+using namespace android;
+using namespace android::os;
+using namespace android::os::incidentd;
+
+static void fillBuffer(FdBuffer* buffer, const std::string& data) {
+    buffer->write((const uint8_t*)data.data(), data.size());
+}
+
+TEST(SectionCacheTest, DisabledByDefault) {
+    sp<SectionCache> cache = new SectionCache(1024);
+    FdBuffer buffer;
+    fillBuffer(&buffer, "section data");
+    IncidentMetadata::SectionStats stats;
+    cache->put(3000, 1, buffer, stats);
+
+    int64_t reportId;
+    EXPECT_EQ(nullptr, cache->get(3000, &stats, &reportId));
+}
+
+TEST(SectionCacheTest, ReuseWithinTtl) {
+    sp<SectionCache> cache = new SectionCache(1024);
+    cache->setTtlMs(500);
+    FdBuffer buffer;
+    fillBuffer(&buffer, "section data");
+    IncidentMetadata::SectionStats stats;
+    stats.set_id(3000);
+    stats.set_dump_size_bytes(12);
+    cache->put(3000, 42, buffer, stats);
+
+    IncidentMetadata::SectionStats cachedStats;
+    int64_t reportId = 0;
+    sp<EncodedBuffer> data = cache->get(3000, &cachedStats, &reportId);
+    ASSERT_NE(nullptr, data);
+    EXPECT_EQ(42, reportId);
+    EXPECT_EQ(12, cachedStats.dump_size_bytes());
+    EXPECT_EQ(buffer.size(), data->size());
+    EXPECT_EQ(nullptr, cache->get(3001, &cachedStats, &reportId));
+
+    sleep(1);  // sleep for 1 second to make sure the entry expires
+    EXPECT_EQ(nullptr, cache->get(3000, &cachedStats, &reportId));
+}
+
+TEST(SectionCacheTest, EvictOldestWhenFull) {
+    sp<SectionCache> cache = new SectionCache(16);
+    cache->setTtlMs(100000);
+    IncidentMetadata::SectionStats stats;
+    FdBuffer first;
+    fillBuffer(&first, "0123456789");
+    cache->put(1, 1, first, stats);
+    FdBuffer second;
+    fillBuffer(&second, "0123456789");
+    cache->put(2, 2, second, stats);
+
+    int64_t reportId;
+    EXPECT_EQ(nullptr, cache->get(1, &stats, &reportId));
+    EXPECT_NE(nullptr, cache->get(2, &stats, &reportId));
+}
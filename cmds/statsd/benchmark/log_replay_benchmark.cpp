@@ -0,0 +1,353 @@
+/*
+ * Copyright (C) 2020 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+// End-to-end ingestion benchmark: replays an atom trace through the same path a datagram from
+// the socket takes (LogEvent::parseBuffer -> LogEventQueue -> StatsLogProcessor::OnLogEvent)
+// against a full config.
+//
+// By default a synthetic trace with a realistic atom mix is used. To replay a captured load,
+// point these environment variables at the files:
+//   STATSD_REPLAY_CONFIG  a serialized StatsdConfig proto.
+//   STATSD_REPLAY_TRACE   a sequence of records, each a little endian uint32 uid, uint32 pid and
+//                         uint32 payload size followed by the payload: the AStatsEvent buffer
+//                         that follows the StatsEventTag in a statsd socket datagram.
+//
+// Besides the time per replay, the benchmark reports the p99 latency of one event through the
+// pipeline, the allocations made per event and the peak RSS of the process.
+
+#include <sys/resource.h>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <new>
+#include <vector>
+
+#include "android-base/file.h"
+#include "benchmark/benchmark.h"
+#include "logd/LogEvent.h"
+#include "logd/LogEventQueue.h"
+#include "metric_util.h"
+
+namespace {
+
+std::atomic<uint64_t> gAllocationCount(0);
+
+}  // namespace
+
+// Counts every allocation of the benchmark binary, so that the allocations made while replaying
+// can be reported.
+void* operator new(size_t size) {
+    gAllocationCount.fetch_add(1, std::memory_order_relaxed);
+    if (void* ptr = std::malloc(size == 0 ? 1 : size)) {
+        return ptr;
+    }
+    throw std::bad_alloc();
+}
+
+void operator delete(void* ptr) noexcept {
+    std::free(ptr);
+}
+
+void operator delete(void* ptr, size_t) noexcept {
+    std::free(ptr);
+}
+
+namespace android {
+namespace os {
+namespace statsd {
+
+using std::string;
+using std::vector;
+
+// One datagram of the trace.
+struct TraceRecord {
+    uint32_t uid;
+    uint32_t pid;
+    vector<uint8_t> payload;
+};
+
+static bool readUint32(const string& data, size_t* pos, uint32_t* value) {
+    if (data.size() - *pos < sizeof(uint32_t)) {
+        return false;
+    }
+    const uint8_t* p = reinterpret_cast<const uint8_t*>(data.data()) + *pos;
+    *value = p[0] | (p[1] << 8) | (p[2] << 16) | ((uint32_t)p[3] << 24);
+    *pos += sizeof(uint32_t);
+    return true;
+}
+
+static bool loadTrace(const char* path, vector<TraceRecord>* records) {
+    string data;
+    if (!android::base::ReadFileToString(path, &data)) {
+        return false;
+    }
+    size_t pos = 0;
+    while (pos < data.size()) {
+        TraceRecord record;
+        uint32_t size;
+        if (!readUint32(data, &pos, &record.uid) || !readUint32(data, &pos, &record.pid) ||
+            !readUint32(data, &pos, &size) || data.size() - pos < size) {
+            return false;
+        }
+        record.payload.assign(data.begin() + pos, data.begin() + pos + size);
+        pos += size;
+        records->push_back(std::move(record));
+    }
+    return true;
+}
+
+static bool loadConfig(const char* path, StatsdConfig* config) {
+    string data;
+    return android::base::ReadFileToString(path, &data) && config->ParseFromString(data);
+}
+
+static TraceRecord buildRecord(AStatsEvent* statsEvent, uint32_t uid) {
+    AStatsEvent_build(statsEvent);
+    size_t size;
+    uint8_t* buf = AStatsEvent_getBuffer(statsEvent, &size);
+    TraceRecord record{uid, 0, vector<uint8_t>(buf, buf + size)};
+    AStatsEvent_release(statsEvent);
+    return record;
+}
+
+static TraceRecord buildWakelockRecord(uint64_t timestampNs, int uid, const string& tag,
+                                       WakelockStateChanged::State state) {
+    AStatsEvent* statsEvent = AStatsEvent_obtain();
+    AStatsEvent_setAtomId(statsEvent, android::util::WAKELOCK_STATE_CHANGED);
+    AStatsEvent_overwriteTimestamp(statsEvent, timestampNs);
+    writeAttribution(statsEvent, {uid}, {""});
+    AStatsEvent_writeInt32(statsEvent, android::os::WakeLockLevelEnum::PARTIAL_WAKE_LOCK);
+    AStatsEvent_writeString(statsEvent, tag.c_str());
+    AStatsEvent_writeInt32(statsEvent, state);
+    return buildRecord(statsEvent, uid);
+}
+
+static TraceRecord buildScreenRecord(uint64_t timestampNs, android::view::DisplayStateEnum state) {
+    AStatsEvent* statsEvent = AStatsEvent_obtain();
+    AStatsEvent_setAtomId(statsEvent, android::util::SCREEN_STATE_CHANGED);
+    AStatsEvent_overwriteTimestamp(statsEvent, timestampNs);
+    AStatsEvent_writeInt32(statsEvent, state);
+    return buildRecord(statsEvent, 1000);
+}
+
+static TraceRecord buildScheduledJobRecord(uint64_t timestampNs, int uid, const string& jobName,
+                                           ScheduledJobStateChanged::State state) {
+    AStatsEvent* statsEvent = AStatsEvent_obtain();
+    AStatsEvent_setAtomId(statsEvent, android::util::SCHEDULED_JOB_STATE_CHANGED);
+    AStatsEvent_overwriteTimestamp(statsEvent, timestampNs);
+    writeAttribution(statsEvent, {uid}, {""});
+    AStatsEvent_writeString(statsEvent, jobName.c_str());
+    AStatsEvent_writeInt32(statsEvent, state);
+    return buildRecord(statsEvent, uid);
+}
+
+static TraceRecord buildSyncRecord(uint64_t timestampNs, int uid, const string& name,
+                                   SyncStateChanged::State state) {
+    AStatsEvent* statsEvent = AStatsEvent_obtain();
+    AStatsEvent_setAtomId(statsEvent, android::util::SYNC_STATE_CHANGED);
+    AStatsEvent_overwriteTimestamp(statsEvent, timestampNs);
+    writeAttribution(statsEvent, {uid}, {""});
+    AStatsEvent_writeString(statsEvent, name.c_str());
+    AStatsEvent_writeInt32(statsEvent, state);
+    return buildRecord(statsEvent, uid);
+}
+
+// A config in the shape of the ones seen in production: wakelock durations sliced by uid and
+// tag, conditioned on the screen, plus counts of jobs and syncs sliced by uid.
+static StatsdConfig createSyntheticConfig() {
+    StatsdConfig config;
+    *config.add_atom_matcher() = CreateAcquireWakelockAtomMatcher();
+    *config.add_atom_matcher() = CreateReleaseWakelockAtomMatcher();
+    *config.add_atom_matcher() = CreateScreenTurnedOnAtomMatcher();
+    *config.add_atom_matcher() = CreateScreenTurnedOffAtomMatcher();
+    *config.add_atom_matcher() = CreateStartScheduledJobAtomMatcher();
+    *config.add_atom_matcher() = CreateFinishScheduledJobAtomMatcher();
+    *config.add_atom_matcher() = CreateSyncStartAtomMatcher();
+    *config.add_atom_matcher() = CreateSyncEndAtomMatcher();
+
+    auto holdingWakelockPredicate = CreateHoldingWakelockPredicate();
+    *holdingWakelockPredicate.mutable_simple_predicate()->mutable_dimensions() =
+            CreateAttributionUidDimensions(android::util::WAKELOCK_STATE_CHANGED,
+                                           {Position::FIRST});
+    holdingWakelockPredicate.mutable_simple_predicate()->mutable_dimensions()->add_child()
+            ->set_field(3);  // tag field.
+    auto screenIsOffPredicate = CreateScreenIsOffPredicate();
+    *config.add_predicate() = holdingWakelockPredicate;
+    *config.add_predicate() = screenIsOffPredicate;
+
+    auto durationMetric = config.add_duration_metric();
+    durationMetric->set_id(StringToId("WakelockDuration"));
+    durationMetric->set_what(holdingWakelockPredicate.id());
+    durationMetric->set_condition(screenIsOffPredicate.id());
+    durationMetric->set_aggregation_type(DurationMetric::SUM);
+    durationMetric->set_bucket(FIVE_MINUTES);
+    *durationMetric->mutable_dimensions_in_what() = CreateAttributionUidDimensions(
+            android::util::WAKELOCK_STATE_CHANGED, {Position::FIRST});
+    durationMetric->mutable_dimensions_in_what()->add_child()->set_field(3);
+
+    auto maxDurationMetric = config.add_duration_metric();
+    maxDurationMetric->set_id(StringToId("WakelockMaxDuration"));
+    maxDurationMetric->set_what(holdingWakelockPredicate.id());
+    maxDurationMetric->set_aggregation_type(DurationMetric::MAX_SPARSE);
+    maxDurationMetric->set_bucket(FIVE_MINUTES);
+    *maxDurationMetric->mutable_dimensions_in_what() = CreateAttributionUidDimensions(
+            android::util::WAKELOCK_STATE_CHANGED, {Position::FIRST});
+
+    auto jobCountMetric = config.add_count_metric();
+    jobCountMetric->set_id(StringToId("ScheduledJobCount"));
+    jobCountMetric->set_what(StringToId("ScheduledJobStart"));
+    jobCountMetric->set_bucket(FIVE_MINUTES);
+    *jobCountMetric->mutable_dimensions_in_what() = CreateAttributionUidDimensions(
+            android::util::SCHEDULED_JOB_STATE_CHANGED, {Position::FIRST});
+
+    auto syncCountMetric = config.add_count_metric();
+    syncCountMetric->set_id(StringToId("SyncCount"));
+    syncCountMetric->set_what(StringToId("SyncStart"));
+    syncCountMetric->set_condition(screenIsOffPredicate.id());
+    syncCountMetric->set_bucket(FIVE_MINUTES);
+    *syncCountMetric->mutable_dimensions_in_what() = CreateAttributionUidDimensions(
+            android::util::SYNC_STATE_CHANGED, {Position::FIRST});
+    return config;
+}
+
+// Wakelocks dominate the atom volume, with many uid and tag pairs held at once. The screen
+// flips every few hundred events and jobs and syncs come in between.
+static vector<TraceRecord> createSyntheticTrace(uint64_t startTimeNs, int numEvents) {
+    const int kNumUids = 50;
+    const int kNumTagsPerUid = 40;
+    vector<TraceRecord> records;
+    records.reserve(numEvents);
+    uint64_t timestampNs = startTimeNs;
+    bool screenOn = true;
+    unsigned int seed = 1;
+    for (int i = 0; i < numEvents; i++) {
+        timestampNs += 1000000 + rand_r(&seed) % 50000000;
+        const int uid = 10000 + rand_r(&seed) % kNumUids;
+        const int kind = rand_r(&seed) % 100;
+        if (i % 300 == 0) {
+            screenOn = !screenOn;
+            records.push_back(buildScreenRecord(
+                    timestampNs, screenOn ? android::view::DISPLAY_STATE_ON
+                                          : android::view::DISPLAY_STATE_OFF));
+        } else if (kind < 80) {
+            const string tag = "wakelock" + std::to_string(rand_r(&seed) % kNumTagsPerUid);
+            records.push_back(buildWakelockRecord(
+                    timestampNs, uid, tag,
+                    kind % 2 ? WakelockStateChanged::ACQUIRE : WakelockStateChanged::RELEASE));
+        } else if (kind < 92) {
+            records.push_back(buildScheduledJobRecord(
+                    timestampNs, uid, "job" + std::to_string(kind % 4),
+                    kind % 2 ? ScheduledJobStateChanged::STARTED
+                             : ScheduledJobStateChanged::FINISHED));
+        } else {
+            records.push_back(buildSyncRecord(
+                    timestampNs, uid, "sync" + std::to_string(kind % 3),
+                    kind % 2 ? SyncStateChanged::ON : SyncStateChanged::OFF));
+        }
+    }
+    return records;
+}
+
+static void BM_LogReplay(benchmark::State& state) {
+    const int64_t kStartTimeSec = 10;
+    StatsdConfig config;
+    vector<TraceRecord> records;
+    const char* configPath = getenv("STATSD_REPLAY_CONFIG");
+    const char* tracePath = getenv("STATSD_REPLAY_TRACE");
+    if (configPath != nullptr || tracePath != nullptr) {
+        if (configPath == nullptr || tracePath == nullptr) {
+            state.SkipWithError("both STATSD_REPLAY_CONFIG and STATSD_REPLAY_TRACE must be set");
+            return;
+        }
+        if (!loadConfig(configPath, &config)) {
+            state.SkipWithError("failed to load the config");
+            return;
+        }
+        if (!loadTrace(tracePath, &records)) {
+            state.SkipWithError("failed to load the trace");
+            return;
+        }
+    } else {
+        config = createSyntheticConfig();
+        records = createSyntheticTrace((kStartTimeSec + 1) * NS_PER_SEC, state.range(0));
+    }
+    if (records.empty()) {
+        state.SkipWithError("the trace is empty");
+        return;
+    }
+
+    ConfigKey cfgKey;
+    std::shared_ptr<LogEventQueue> queue = std::make_shared<LogEventQueue>(16);
+    vector<int64_t> latenciesNs;
+    latenciesNs.reserve(records.size() * 8);
+    vector<uint8_t> buffer;
+    uint64_t allocations = 0;
+    int64_t events = 0;
+
+    while (state.KeepRunning()) {
+        // Every replay starts from a fresh processor, since the trace's timestamps start over.
+        state.PauseTiming();
+        sp<StatsLogProcessor> processor = CreateStatsLogProcessor(kStartTimeSec, config, cfgKey);
+        const bool sampleLatencies = latenciesNs.size() + records.size() <= latenciesNs.capacity();
+        const uint64_t allocationsBefore = gAllocationCount.load(std::memory_order_relaxed);
+        state.ResumeTiming();
+
+        for (const TraceRecord& record : records) {
+            const auto startTime = std::chrono::steady_clock::now();
+
+            // parseBuffer may modify the buffer, like the socket listener's receive buffer.
+            buffer.assign(record.payload.begin(), record.payload.end());
+            std::unique_ptr<LogEvent> logEvent =
+                    std::make_unique<LogEvent>(record.uid, record.pid);
+            logEvent->parseBuffer(buffer.data(), buffer.size());
+            int64_t oldestTimestampNs;
+            queue->push(std::move(logEvent), &oldestTimestampNs);
+            std::unique_ptr<LogEvent> event = queue->waitPop();
+            processor->OnLogEvent(event.get());
+
+            if (sampleLatencies) {
+                latenciesNs.push_back(std::chrono::duration_cast<std::chrono::nanoseconds>(
+                                              std::chrono::steady_clock::now() - startTime)
+                                              .count());
+            }
+        }
+
+        state.PauseTiming();
+        allocations += gAllocationCount.load(std::memory_order_relaxed) - allocationsBefore;
+        events += records.size();
+        processor.clear();
+        state.ResumeTiming();
+    }
+
+    state.SetItemsProcessed(events);
+    state.counters["allocs_per_event"] = (double)allocations / events;
+    if (!latenciesNs.empty()) {
+        auto p99 = latenciesNs.begin() + latenciesNs.size() * 99 / 100;
+        std::nth_element(latenciesNs.begin(), p99, latenciesNs.end());
+        state.counters["p99_latency_ns"] = *p99;
+    }
+    struct rusage usage;
+    if (getrusage(RUSAGE_SELF, &usage) == 0) {
+        state.counters["peak_rss_kb"] = usage.ru_maxrss;
+    }
+}
+BENCHMARK(BM_LogReplay)->Arg(10000)->Arg(100000);
+
+}  //  namespace statsd
+}  //  namespace os
+}  //  namespace android
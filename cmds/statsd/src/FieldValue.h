@@ -181,7 +181,7 @@ public:
         return false;
     }
 
-    bool matches(const Matcher& that) const;
+    inline bool matches(const Matcher& that) const;
 };
 
 /**
@@ -216,10 +216,16 @@ public:
  * TODO(b/110561213): ADD EXAMPLE HERE.
  */
 struct Matcher {
-    Matcher(const Field& matcher, int32_t mask) : mMatcher(matcher), mMask(mask){};
+    Matcher(const Field& matcher, int32_t mask)
+        : mMatcher(matcher),
+          mMask(mask),
+          mAllPositionMask(hasAllPositionMatcher() ? mask & kClearAllPositionMatcherMask : mask){};
 
     const Field mMatcher;
     const int32_t mMask;
+    // The mask that also matches every position of an ALL position matcher. Computed once here,
+    // as Field::matches is called for every field of every event.
+    const int32_t mAllPositionMask;
 
     inline const Field& getMatcher() const {
         return mMatcher;
@@ -258,6 +264,14 @@ struct Matcher {
     }
 };
 
+bool Field::matches(const Matcher& matcher) const {
+    if (mTag != matcher.mMatcher.getTag()) {
+        return false;
+    }
+    return (mField & matcher.mMask) == matcher.mMatcher.getField() ||
+           (mField & matcher.mAllPositionMask) == matcher.mMatcher.getField();
+}
+
 inline Matcher getSimpleMatcher(int32_t tag, size_t field) {
     return Matcher(Field(tag, getSimpleField(field)), 0xff7f0000);
 }
@@ -299,11 +313,19 @@ struct Value {
         type = STRING;
     }
 
+    Value(std::string&& v) : str_value(std::move(v)) {
+        type = STRING;
+    }
+
     Value(const std::vector<uint8_t>& v) {
         storage_value = v;
         type = STORAGE;
     }
 
+    Value(std::vector<uint8_t>&& v) : storage_value(std::move(v)) {
+        type = STORAGE;
+    }
+
     void setInt(int32_t v) {
         int_value = v;
         type = INT;
@@ -347,6 +369,10 @@ struct Value {
 
     Value(const Value& from);
 
+    // Takes over the string or byte storage of from instead of copying it, so that the
+    // FieldValues of a LogEvent can be built and grown without reallocating it.
+    Value(Value&& from) noexcept;
+
     bool operator==(const Value& that) const;
     bool operator!=(const Value& that) const;
 
@@ -356,6 +382,7 @@ struct Value {
     Value operator-(const Value& that) const;
     Value& operator+=(const Value& that);
     Value& operator=(const Value& that);
+    Value& operator=(Value&& that) noexcept;
 };
 
 class Annotations {
@@ -415,6 +442,8 @@ struct FieldValue {
     FieldValue() {}
     FieldValue(const Field& field, const Value& value) : mField(field), mValue(value) {
     }
+    FieldValue(const Field& field, Value&& value) : mField(field), mValue(std::move(value)) {
+    }
     bool operator==(const FieldValue& that) const {
         return mField == that.mField && mValue == that.mValue;
     }
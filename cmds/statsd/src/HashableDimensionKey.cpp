@@ -121,8 +121,12 @@ StatsDimensionsValueParcel HashableDimensionKey::toStatsDimensionsValueParcel()
 }
 
 android::hash_t hashDimension(const HashableDimensionKey& value) {
+    return value.getHash();
+}
+
+android::hash_t HashableDimensionKey::computeHash() const {
     android::hash_t hash = 0;
-    for (const auto& fieldValue : value.getValues()) {
+    for (const auto& fieldValue : mValues) {
         hash = android::JenkinsHashMix(hash, android::hash_type((int)fieldValue.mField.getField()));
         hash = android::JenkinsHashMix(hash, android::hash_type((int)fieldValue.mField.getTag()));
         hash = android::JenkinsHashMix(hash, android::hash_type((int)fieldValue.mValue.getType()));
@@ -164,20 +168,25 @@ bool filterValues(const Matcher& matcherField, const vector<FieldValue>& values,
 
 bool filterValues(const vector<Matcher>& matcherFields, const vector<FieldValue>& values,
                   HashableDimensionKey* output) {
-    size_t num_matches = 0;
+    if (matcherFields.empty()) {
+        return false;
+    }
+    // A dimension is usually built from a single atom and most of its fields match, so size the
+    // output for one value per matcher up front.
+    output->mutableValues()->reserve(output->getValues().size() + matcherFields.size());
+    size_t num_matches = output->getValues().size();
+    const size_t firstMatch = num_matches;
     for (const auto& value : values) {
-        for (size_t i = 0; i < matcherFields.size(); ++i) {
-            const auto& matcher = matcherFields[i];
+        for (const auto& matcher : matcherFields) {
             if (value.mField.matches(matcher)) {
                 output->addValue(value);
-                output->mutableValue(num_matches)->mField.setTag(value.mField.getTag());
                 output->mutableValue(num_matches)->mField.setField(
                     value.mField.getField() & matcher.mMask);
                 num_matches++;
             }
         }
     }
-    return num_matches > 0;
+    return num_matches > firstMatch;
 }
 
 bool filterPrimaryKey(const std::vector<FieldValue>& values, HashableDimensionKey* output) {
@@ -310,6 +319,10 @@ bool HashableDimensionKey::operator==(const HashableDimensionKey& that) const {
     if (mValues.size() != that.getValues().size()) {
         return false;
     }
+    // Keys with different hashes can't be equal. Only compare hashes that are already known.
+    if (mHashValid && that.mHashValid && mHash != that.mHash) {
+        return false;
+    }
     size_t count = mValues.size();
     for (size_t i = 0; i < count; i++) {
         if (mValues[i] != (that.getValues())[i]) {
@@ -49,10 +49,17 @@ public:
 
     HashableDimensionKey() {};
 
-    HashableDimensionKey(const HashableDimensionKey& that) : mValues(that.getValues()){};
+    HashableDimensionKey(const HashableDimensionKey& that) = default;
+
+    HashableDimensionKey(HashableDimensionKey&& that) = default;
+
+    HashableDimensionKey& operator=(const HashableDimensionKey& that) = default;
+
+    HashableDimensionKey& operator=(HashableDimensionKey&& that) = default;
 
     inline void addValue(const FieldValue& value) {
         mValues.push_back(value);
+        mHashValid = false;
     }
 
     inline const std::vector<FieldValue>& getValues() const {
@@ -60,16 +67,28 @@ public:
     }
 
     inline std::vector<FieldValue>* mutableValues() {
+        mHashValid = false;
         return &mValues;
     }
 
     inline FieldValue* mutableValue(size_t i) {
         if (i >= 0 && i < mValues.size()) {
+            mHashValid = false;
             return &(mValues[i]);
         }
         return nullptr;
     }
 
+    // Returns the hash of the values. It is computed the first time it is needed and kept until
+    // the values are changed, so that looking the key up in a hash map again is cheap.
+    inline android::hash_t getHash() const {
+        if (!mHashValid) {
+            mHash = computeHash();
+            mHashValid = true;
+        }
+        return mHash;
+    }
+
     StatsDimensionsValueParcel toStatsDimensionsValueParcel() const;
 
     std::string toString() const;
@@ -83,7 +102,12 @@ public:
     bool contains(const HashableDimensionKey& that) const;
 
 private:
+    android::hash_t computeHash() const;
+
     std::vector<FieldValue> mValues;
+
+    mutable android::hash_t mHash = 0;
+    mutable bool mHashValid = false;
 };
 
 class MetricDimensionKey {
@@ -94,12 +118,14 @@ public:
 
     MetricDimensionKey(){};
 
-    MetricDimensionKey(const MetricDimensionKey& that)
-        : mDimensionKeyInWhat(that.getDimensionKeyInWhat()),
-          mStateValuesKey(that.getStateValuesKey()){};
+    MetricDimensionKey(const MetricDimensionKey& that) = default;
+
+    MetricDimensionKey(MetricDimensionKey&& that) = default;
 
     MetricDimensionKey& operator=(const MetricDimensionKey& from) = default;
 
+    MetricDimensionKey& operator=(MetricDimensionKey&& from) = default;
+
     std::string toString() const;
 
     inline const HashableDimensionKey& getDimensionKeyInWhat() const {
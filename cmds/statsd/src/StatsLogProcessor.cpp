@@ -83,6 +83,10 @@ constexpr const char* kPermissionUsage = "android.permission.PACKAGE_USAGE_STATS
 // Cool down period for writing data to disk to avoid overwriting files.
 #define WRITE_DATA_COOL_DOWN_SEC 5
 
+// Most events held for a config while its report is being built, the same as the size of the
+// queue between the socket and the processor.
+constexpr size_t kMaxEventsPendingDump = 2000;
+
 StatsLogProcessor::StatsLogProcessor(const sp<UidMap>& uidMap,
                                      const sp<StatsPullerManager>& pullerManager,
                                      const sp<AlarmMonitor>& anomalyAlarmMonitor,
@@ -123,6 +127,7 @@ static void flushProtoToBuffer(ProtoOutputStream& proto, vector<uint8_t>* outDat
 void StatsLogProcessor::onAnomalyAlarmFired(
         const int64_t& timestampNs,
         unordered_set<sp<const InternalAlarm>, SpHash<InternalAlarm>> alarmSet) {
+    std::lock_guard<std::mutex> reportLock(mReportMutex);
     std::lock_guard<std::mutex> lock(mMetricsMutex);
     for (const auto& itr : mMetricsManagers) {
         itr.second->onAnomalyAlarmFired(timestampNs, alarmSet);
@@ -132,6 +137,7 @@ void StatsLogProcessor::onPeriodicAlarmFired(
         const int64_t& timestampNs,
         unordered_set<sp<const InternalAlarm>, SpHash<InternalAlarm>> alarmSet) {
 
+    std::lock_guard<std::mutex> reportLock(mReportMutex);
     std::lock_guard<std::mutex> lock(mMetricsMutex);
     for (const auto& itr : mMetricsManagers) {
         itr.second->onPeriodicAlarmFired(timestampNs, alarmSet);
@@ -369,6 +375,7 @@ vector<int64_t> StatsLogProcessor::processWatchdogRollbackOccurred(const int32_t
 }
 
 void StatsLogProcessor::resetConfigs() {
+    std::lock_guard<std::mutex> reportLock(mReportMutex);
     std::lock_guard<std::mutex> lock(mMetricsMutex);
     resetConfigsLocked(getElapsedRealtimeNs());
 }
@@ -414,7 +421,11 @@ void StatsLogProcessor::OnLogEvent(LogEvent* event, int64_t elapsedRealtimeNs) {
         ALOGI("%s", event->ToString().c_str());
     }
 #endif
-    resetIfConfigTtlExpiredLocked(eventElapsedTimeNs);
+    // Resetting a config writes every config to disk, which has to wait for any report being
+    // built without mMetricsMutex to be done.
+    if (mConfigsBeingDumped.empty()) {
+        resetIfConfigTtlExpiredLocked(eventElapsedTimeNs);
+    }
 
     // Hard-coded logic to update the isolated uid's in the uid-map.
     // The field numbers need to be currently updated by hand with atoms.proto
@@ -443,9 +454,26 @@ void StatsLogProcessor::OnLogEvent(LogEvent* event, int64_t elapsedRealtimeNs) {
     for (auto& pair : mMetricsManagers) {
         int uid = pair.first.GetUid();
         int64_t configId = pair.first.GetId();
-        bool isPrevActive = pair.second->isActive();
-        pair.second->onLogEvent(*event);
-        bool isCurActive = pair.second->isActive();
+        bool isPrevActive;
+        bool isCurActive;
+        auto dump = mConfigsBeingDumped.find(pair.first);
+        if (dump == mConfigsBeingDumped.end()) {
+            isPrevActive = pair.second->isActive();
+            pair.second->onLogEvent(*event);
+            isCurActive = pair.second->isActive();
+        } else {
+            // A report is being built for this config without mMetricsMutex. Hold on to a copy
+            // of the event and hand it over once the report is done, so that the config still
+            // sees its events in order.
+            auto& pendingEvents = dump->second.pendingEvents;
+            if (pendingEvents.size() >= kMaxEventsPendingDump) {
+                StatsdStats::getInstance().noteEventQueueOverflow(
+                        pendingEvents.front()->GetElapsedTimestampNs());
+                pendingEvents.pop_front();
+            }
+            pendingEvents.push_back(std::make_unique<LogEvent>(*event));
+            isPrevActive = isCurActive = dump->second.wasActive;
+        }
         // Map all active configs by uid.
         if (isCurActive) {
             auto activeConfigs = activeConfigsPerUid.find(uid);
@@ -463,38 +491,48 @@ void StatsLogProcessor::OnLogEvent(LogEvent* event, int64_t elapsedRealtimeNs) {
             uidsWithActiveConfigsChanged.insert(uid);
             StatsdStats::getInstance().noteActiveStatusChanged(pair.first, isCurActive);
         }
-        flushIfNecessaryLocked(pair.first, *(pair.second));
+        if (dump == mConfigsBeingDumped.end()) {
+            flushIfNecessaryLocked(pair.first, *(pair.second));
+        }
     }
 
     // Don't use the event timestamp for the guardrail.
+    const std::vector<int64_t> emptyActiveConfigs;
     for (int uid : uidsWithActiveConfigsChanged) {
-        // Send broadcast so that receivers can pull data.
-        auto lastBroadcastTime = mLastActivationBroadcastTimes.find(uid);
-        if (lastBroadcastTime != mLastActivationBroadcastTimes.end()) {
-            if (elapsedRealtimeNs - lastBroadcastTime->second <
-                StatsdStats::kMinActivationBroadcastPeriodNs) {
-                StatsdStats::getInstance().noteActivationBroadcastGuardrailHit(uid);
-                VLOG("StatsD would've sent an activation broadcast but the rate limit stopped us.");
-                return;
-            }
-        }
         auto activeConfigs = activeConfigsPerUid.find(uid);
-        if (activeConfigs != activeConfigsPerUid.end()) {
-            if (mSendActivationBroadcast(uid, activeConfigs->second)) {
-                VLOG("StatsD sent activation notice for uid %d", uid);
-                mLastActivationBroadcastTimes[uid] = elapsedRealtimeNs;
-            }
-        } else {
-            std::vector<int64_t> emptyActiveConfigs;
-            if (mSendActivationBroadcast(uid, emptyActiveConfigs)) {
-                VLOG("StatsD sent EMPTY activation notice for uid %d", uid);
-                mLastActivationBroadcastTimes[uid] = elapsedRealtimeNs;
-            }
+        if (!sendActivationBroadcastLocked(uid,
+                                           activeConfigs != activeConfigsPerUid.end()
+                                                   ? activeConfigs->second
+                                                   : emptyActiveConfigs,
+                                           elapsedRealtimeNs)) {
+            return;
         }
     }
 }
 
+bool StatsLogProcessor::sendActivationBroadcastLocked(const int uid,
+                                                      const vector<int64_t>& activeConfigs,
+                                                      const int64_t elapsedRealtimeNs) {
+    // Send broadcast so that receivers can pull data.
+    auto lastBroadcastTime = mLastActivationBroadcastTimes.find(uid);
+    if (lastBroadcastTime != mLastActivationBroadcastTimes.end()) {
+        if (elapsedRealtimeNs - lastBroadcastTime->second <
+            StatsdStats::kMinActivationBroadcastPeriodNs) {
+            StatsdStats::getInstance().noteActivationBroadcastGuardrailHit(uid);
+            VLOG("StatsD would've sent an activation broadcast but the rate limit stopped us.");
+            return false;
+        }
+    }
+    if (mSendActivationBroadcast(uid, activeConfigs)) {
+        VLOG("StatsD sent activation notice for uid %d with %zu active configs", uid,
+             activeConfigs.size());
+        mLastActivationBroadcastTimes[uid] = elapsedRealtimeNs;
+    }
+    return true;
+}
+
 void StatsLogProcessor::GetActiveConfigs(const int uid, vector<int64_t>& outActiveConfigs) {
+    std::lock_guard<std::mutex> reportLock(mReportMutex);
     std::lock_guard<std::mutex> lock(mMetricsMutex);
     GetActiveConfigsLocked(uid, outActiveConfigs);
 }
@@ -510,6 +548,7 @@ void StatsLogProcessor::GetActiveConfigsLocked(const int uid, vector<int64_t>& o
 
 void StatsLogProcessor::OnConfigUpdated(const int64_t timestampNs, const ConfigKey& key,
                                         const StatsdConfig& config) {
+    std::lock_guard<std::mutex> reportLock(mReportMutex);
     std::lock_guard<std::mutex> lock(mMetricsMutex);
     WriteDataToDiskLocked(key, timestampNs, CONFIG_UPDATED, NO_TIME_CONSTRAINTS);
     OnConfigUpdatedLocked(timestampNs, key, config);
@@ -536,6 +575,7 @@ void StatsLogProcessor::OnConfigUpdatedLocked(
 }
 
 size_t StatsLogProcessor::GetMetricsSize(const ConfigKey& key) const {
+    std::lock_guard<std::mutex> reportLock(mReportMutex);
     std::lock_guard<std::mutex> lock(mMetricsMutex);
     auto it = mMetricsManagers.find(key);
     if (it == mMetricsManagers.end()) {
@@ -546,6 +586,7 @@ size_t StatsLogProcessor::GetMetricsSize(const ConfigKey& key) const {
 }
 
 void StatsLogProcessor::dumpStates(int out, bool verbose) {
+    std::lock_guard<std::mutex> reportLock(mReportMutex);
     std::lock_guard<std::mutex> lock(mMetricsMutex);
     FILE* fout = fdopen(out, "w");
     if (fout == NULL) {
@@ -568,7 +609,10 @@ void StatsLogProcessor::onDumpReport(const ConfigKey& key, const int64_t dumpTim
                                      const DumpReportReason dumpReportReason,
                                      const DumpLatency dumpLatency,
                                      ProtoOutputStream* proto) {
-    std::lock_guard<std::mutex> lock(mMetricsMutex);
+    // Only the lookup and the hand-over of the events that arrive meanwhile hold mMetricsMutex,
+    // so that building and writing a large report does not hold up event processing.
+    // mReportMutex keeps everything else away from the config until the report is done.
+    std::lock_guard<std::mutex> reportLock(mReportMutex);
 
     // Start of ConfigKey.
     uint64_t configKeyToken = proto->start(FIELD_TYPE_MESSAGE | FIELD_ID_CONFIG_KEY);
@@ -577,9 +621,14 @@ void StatsLogProcessor::onDumpReport(const ConfigKey& key, const int64_t dumpTim
     proto->end(configKeyToken);
     // End of ConfigKey.
 
+    sp<MetricsManager> metricsManager;
+    {
+        std::lock_guard<std::mutex> lock(mMetricsMutex);
+        metricsManager = beginConfigDumpLocked(key);
+    }
+
     bool keepFile = false;
-    auto it = mMetricsManagers.find(key);
-    if (it != mMetricsManagers.end() && it->second->shouldPersistLocalHistory()) {
+    if (metricsManager != nullptr && metricsManager->shouldPersistLocalHistory()) {
         keepFile = true;
     }
 
@@ -589,22 +638,77 @@ void StatsLogProcessor::onDumpReport(const ConfigKey& key, const int64_t dumpTim
             key, proto, erase_data && !keepFile /* should remove file after appending it */,
             dumpReportReason == ADB_DUMP /*if caller is adb*/);
 
-    if (it != mMetricsManagers.end()) {
-        // This allows another broadcast to be sent within the rate-limit period if we get close to
-        // filling the buffer again soon.
-        mLastBroadcastTimes.erase(key);
-
-        vector<uint8_t> buffer;
-        onConfigMetricsReportLocked(key, dumpTimeStampNs, include_current_partial_bucket,
-                                    erase_data, dumpReportReason, dumpLatency,
-                                    false /* is this data going to be saved on disk */, &buffer);
-        proto->write(FIELD_TYPE_MESSAGE | FIELD_COUNT_REPEATED | FIELD_ID_REPORTS,
-                     reinterpret_cast<char*>(buffer.data()), buffer.size());
+    if (metricsManager != nullptr) {
+        if (erase_data && keepFile) {
+            // The report is also kept as a local history file, so it is serialized on its own.
+            vector<uint8_t> buffer;
+            onConfigMetricsReport(key, *metricsManager, dumpTimeStampNs,
+                                  include_current_partial_bucket, erase_data, dumpReportReason,
+                                  dumpLatency, false /* is this data going to be saved on disk */,
+                                  &buffer);
+            proto->write(FIELD_TYPE_MESSAGE | FIELD_COUNT_REPEATED | FIELD_ID_REPORTS,
+                         reinterpret_cast<char*>(buffer.data()), buffer.size());
+        } else {
+            // Otherwise the metrics write straight into the report list, which saves holding a
+            // second serialized copy of the whole report in memory.
+            uint64_t reportToken =
+                    proto->start(FIELD_TYPE_MESSAGE | FIELD_COUNT_REPEATED | FIELD_ID_REPORTS);
+            onConfigMetricsReport(key, *metricsManager, dumpTimeStampNs,
+                                  include_current_partial_bucket, erase_data, dumpReportReason,
+                                  dumpLatency, proto);
+            proto->end(reportToken);
+        }
+
+        std::lock_guard<std::mutex> lock(mMetricsMutex);
+        endConfigDumpLocked(key, getElapsedRealtimeNs());
     } else {
         ALOGW("Config source %s does not exist", key.ToString().c_str());
     }
 }
 
+sp<MetricsManager> StatsLogProcessor::beginConfigDumpLocked(const ConfigKey& key) {
+    auto it = mMetricsManagers.find(key);
+    if (it == mMetricsManagers.end()) {
+        return nullptr;
+    }
+    // This allows another broadcast to be sent within the rate-limit period if we get close to
+    // filling the buffer again soon.
+    mLastBroadcastTimes.erase(key);
+
+    mConfigsBeingDumped[key].wasActive = it->second->isActive();
+    return it->second;
+}
+
+void StatsLogProcessor::endConfigDumpLocked(const ConfigKey& key,
+                                            const int64_t elapsedRealtimeNs) {
+    auto dump = mConfigsBeingDumped.find(key);
+    if (dump == mConfigsBeingDumped.end()) {
+        return;
+    }
+    const bool wasActive = dump->second.wasActive;
+    std::deque<std::unique_ptr<LogEvent>> pendingEvents = std::move(dump->second.pendingEvents);
+    mConfigsBeingDumped.erase(dump);
+
+    auto it = mMetricsManagers.find(key);
+    if (it == mMetricsManagers.end()) {
+        return;
+    }
+    for (const auto& event : pendingEvents) {
+        it->second->onLogEvent(*event);
+    }
+    if (!pendingEvents.empty()) {
+        flushIfNecessaryLocked(key, *(it->second));
+    }
+
+    const bool isActive = it->second->isActive();
+    if (isActive != wasActive) {
+        StatsdStats::getInstance().noteActiveStatusChanged(key, isActive);
+        vector<int64_t> activeConfigs;
+        GetActiveConfigsLocked(key.GetUid(), activeConfigs);
+        sendActivationBroadcastLocked(key.GetUid(), activeConfigs, elapsedRealtimeNs);
+    }
+}
+
 /*
  * onDumpReport dumps serialized ConfigMetricsReportList into outData.
  */
@@ -626,6 +730,27 @@ void StatsLogProcessor::onDumpReport(const ConfigKey& key, const int64_t dumpTim
     StatsdStats::getInstance().noteMetricsReportSent(key, proto.size());
 }
 
+/*
+ * onDumpReport writes serialized ConfigMetricsReportList to outFd.
+ */
+void StatsLogProcessor::onDumpReport(const ConfigKey& key, const int64_t dumpTimeStampNs,
+                                     const bool include_current_partial_bucket,
+                                     const bool erase_data,
+                                     const DumpReportReason dumpReportReason,
+                                     const DumpLatency dumpLatency, const int outFd) {
+    ProtoOutputStream proto;
+    onDumpReport(key, dumpTimeStampNs, include_current_partial_bucket, erase_data,
+                 dumpReportReason, dumpLatency, &proto);
+
+    const size_t reportSize = proto.size();
+    if (!proto.flush(outFd)) {
+        ALOGW("Failed to write the report of %s", key.ToString().c_str());
+    }
+    VLOG("output data size %zu", reportSize);
+
+    StatsdStats::getInstance().noteMetricsReportSent(key, reportSize);
+}
+
 /*
  * onConfigMetricsReportLocked dumps serialized ConfigMetricsReport into outData.
  */
@@ -640,51 +765,69 @@ void StatsLogProcessor::onConfigMetricsReportLocked(
     if (it == mMetricsManagers.end()) {
         return;
     }
-    int64_t lastReportTimeNs = it->second->getLastReportTimeNs();
-    int64_t lastReportWallClockNs = it->second->getLastReportWallClockNs();
+    onConfigMetricsReport(key, *(it->second), dumpTimeStampNs, include_current_partial_bucket,
+                          erase_data, dumpReportReason, dumpLatency, dataSavedOnDisk, buffer);
+}
+
+void StatsLogProcessor::onConfigMetricsReport(
+        const ConfigKey& key, MetricsManager& metricsManager, const int64_t dumpTimeStampNs,
+        const bool include_current_partial_bucket, const bool erase_data,
+        const DumpReportReason dumpReportReason, const DumpLatency dumpLatency,
+        const bool dataSavedOnDisk, vector<uint8_t>* buffer) {
+    ProtoOutputStream tempProto;
+    onConfigMetricsReport(key, metricsManager, dumpTimeStampNs, include_current_partial_bucket,
+                          erase_data, dumpReportReason, dumpLatency, &tempProto);
+
+    flushProtoToBuffer(tempProto, buffer);
+
+    // save buffer to disk if needed
+    if (erase_data && !dataSavedOnDisk && metricsManager.shouldPersistLocalHistory()) {
+        VLOG("save history to disk");
+        string file_name = StorageManager::getDataHistoryFileName((long)getWallClockSec(),
+                                                                  key.GetUid(), key.GetId());
+        StorageManager::writeReportFile(file_name.c_str(), buffer->data(), buffer->size());
+    }
+}
+
+void StatsLogProcessor::onConfigMetricsReport(
+        const ConfigKey& key, MetricsManager& metricsManager, const int64_t dumpTimeStampNs,
+        const bool include_current_partial_bucket, const bool erase_data,
+        const DumpReportReason dumpReportReason, const DumpLatency dumpLatency,
+        ProtoOutputStream* proto) {
+    int64_t lastReportTimeNs = metricsManager.getLastReportTimeNs();
+    int64_t lastReportWallClockNs = metricsManager.getLastReportWallClockNs();
 
     std::set<string> str_set;
 
-    ProtoOutputStream tempProto;
     // First, fill in ConfigMetricsReport using current data on memory, which
     // starts from filling in StatsLogReport's.
-    it->second->onDumpReport(dumpTimeStampNs, include_current_partial_bucket, erase_data,
-                             dumpLatency, &str_set, &tempProto);
+    metricsManager.onDumpReport(dumpTimeStampNs, include_current_partial_bucket, erase_data,
+                             dumpLatency, &str_set, proto);
 
     // Fill in UidMap if there is at least one metric to report.
     // This skips the uid map if it's an empty config.
-    if (it->second->getNumMetrics() > 0) {
-        uint64_t uidMapToken = tempProto.start(FIELD_TYPE_MESSAGE | FIELD_ID_UID_MAP);
+    if (metricsManager.getNumMetrics() > 0) {
+        uint64_t uidMapToken = proto->start(FIELD_TYPE_MESSAGE | FIELD_ID_UID_MAP);
         mUidMap->appendUidMap(
-                dumpTimeStampNs, key, it->second->hashStringInReport() ? &str_set : nullptr,
-                it->second->versionStringsInReport(), it->second->installerInReport(), &tempProto);
-        tempProto.end(uidMapToken);
+                dumpTimeStampNs, key, metricsManager.hashStringInReport() ? &str_set : nullptr,
+                metricsManager.versionStringsInReport(), metricsManager.installerInReport(), proto);
+        proto->end(uidMapToken);
     }
 
     // Fill in the timestamps.
-    tempProto.write(FIELD_TYPE_INT64 | FIELD_ID_LAST_REPORT_ELAPSED_NANOS,
-                    (long long)lastReportTimeNs);
-    tempProto.write(FIELD_TYPE_INT64 | FIELD_ID_CURRENT_REPORT_ELAPSED_NANOS,
-                    (long long)dumpTimeStampNs);
-    tempProto.write(FIELD_TYPE_INT64 | FIELD_ID_LAST_REPORT_WALL_CLOCK_NANOS,
-                    (long long)lastReportWallClockNs);
-    tempProto.write(FIELD_TYPE_INT64 | FIELD_ID_CURRENT_REPORT_WALL_CLOCK_NANOS,
-                    (long long)getWallClockNs());
+    proto->write(FIELD_TYPE_INT64 | FIELD_ID_LAST_REPORT_ELAPSED_NANOS,
+                 (long long)lastReportTimeNs);
+    proto->write(FIELD_TYPE_INT64 | FIELD_ID_CURRENT_REPORT_ELAPSED_NANOS,
+                 (long long)dumpTimeStampNs);
+    proto->write(FIELD_TYPE_INT64 | FIELD_ID_LAST_REPORT_WALL_CLOCK_NANOS,
+                 (long long)lastReportWallClockNs);
+    proto->write(FIELD_TYPE_INT64 | FIELD_ID_CURRENT_REPORT_WALL_CLOCK_NANOS,
+                 (long long)getWallClockNs());
     // Dump report reason
-    tempProto.write(FIELD_TYPE_INT32 | FIELD_ID_DUMP_REPORT_REASON, dumpReportReason);
+    proto->write(FIELD_TYPE_INT32 | FIELD_ID_DUMP_REPORT_REASON, dumpReportReason);
 
     for (const auto& str : str_set) {
-        tempProto.write(FIELD_TYPE_STRING | FIELD_COUNT_REPEATED | FIELD_ID_STRINGS, str);
-    }
-
-    flushProtoToBuffer(tempProto, buffer);
-
-    // save buffer to disk if needed
-    if (erase_data && !dataSavedOnDisk && it->second->shouldPersistLocalHistory()) {
-        VLOG("save history to disk");
-        string file_name = StorageManager::getDataHistoryFileName((long)getWallClockSec(),
-                                                                  key.GetUid(), key.GetId());
-        StorageManager::writeFile(file_name.c_str(), buffer->data(), buffer->size());
+        proto->write(FIELD_TYPE_STRING | FIELD_COUNT_REPEATED | FIELD_ID_STRINGS, str);
     }
 }
 
@@ -719,6 +862,7 @@ void StatsLogProcessor::resetIfConfigTtlExpiredLocked(const int64_t timestampNs)
 }
 
 void StatsLogProcessor::OnConfigRemoved(const ConfigKey& key) {
+    std::lock_guard<std::mutex> reportLock(mReportMutex);
     std::lock_guard<std::mutex> lock(mMetricsMutex);
     auto it = mMetricsManagers.find(key);
     if (it != mMetricsManagers.end()) {
@@ -808,13 +952,14 @@ void StatsLogProcessor::WriteDataToDiskLocked(const ConfigKey& key,
                                 &buffer);
     string file_name =
             StorageManager::getDataFileName((long)getWallClockSec(), key.GetUid(), key.GetId());
-    StorageManager::writeFile(file_name.c_str(), buffer.data(), buffer.size());
+    StorageManager::writeReportFile(file_name.c_str(), buffer.data(), buffer.size());
 
     // We were able to write the ConfigMetricsReport to disk, so we should trigger collection ASAP.
     mOnDiskDataConfigs.insert(key);
 }
 
 void StatsLogProcessor::SaveActiveConfigsToDisk(int64_t currentTimeNs) {
+    std::lock_guard<std::mutex> reportLock(mReportMutex);
     std::lock_guard<std::mutex> lock(mMetricsMutex);
     const int64_t timeNs = getElapsedRealtimeNs();
     // Do not write to disk if we already have in the last few seconds.
@@ -842,6 +987,7 @@ void StatsLogProcessor::SaveActiveConfigsToDisk(int64_t currentTimeNs) {
 
 void StatsLogProcessor::SaveMetadataToDisk(int64_t currentWallClockTimeNs,
                                            int64_t systemElapsedTimeNs) {
+    std::lock_guard<std::mutex> reportLock(mReportMutex);
     std::lock_guard<std::mutex> lock(mMetricsMutex);
     // Do not write to disk if we already have in the last few seconds.
     if (static_cast<unsigned long long> (systemElapsedTimeNs) <
@@ -872,6 +1018,7 @@ void StatsLogProcessor::SaveMetadataToDisk(int64_t currentWallClockTimeNs,
 void StatsLogProcessor::WriteMetadataToProto(int64_t currentWallClockTimeNs,
                                              int64_t systemElapsedTimeNs,
                                              metadata::StatsMetadataList* metadataList) {
+    std::lock_guard<std::mutex> reportLock(mReportMutex);
     std::lock_guard<std::mutex> lock(mMetricsMutex);
     WriteMetadataToProtoLocked(currentWallClockTimeNs, systemElapsedTimeNs, metadataList);
 }
@@ -892,6 +1039,7 @@ void StatsLogProcessor::WriteMetadataToProtoLocked(int64_t currentWallClockTimeN
 
 void StatsLogProcessor::LoadMetadataFromDisk(int64_t currentWallClockTimeNs,
                                              int64_t systemElapsedTimeNs) {
+    std::lock_guard<std::mutex> reportLock(mReportMutex);
     std::lock_guard<std::mutex> lock(mMetricsMutex);
     string file_name = StringPrintf("%s/metadata", STATS_METADATA_DIR);
     int fd = open(file_name.c_str(), O_RDONLY | O_CLOEXEC);
@@ -923,6 +1071,7 @@ void StatsLogProcessor::LoadMetadataFromDisk(int64_t currentWallClockTimeNs,
 void StatsLogProcessor::SetMetadataState(const metadata::StatsMetadataList& statsMetadataList,
                                          int64_t currentWallClockTimeNs,
                                          int64_t systemElapsedTimeNs) {
+    std::lock_guard<std::mutex> reportLock(mReportMutex);
     std::lock_guard<std::mutex> lock(mMetricsMutex);
     SetMetadataStateLocked(statsMetadataList, currentWallClockTimeNs, systemElapsedTimeNs);
 }
@@ -946,6 +1095,7 @@ void StatsLogProcessor::SetMetadataStateLocked(
 
 void StatsLogProcessor::WriteActiveConfigsToProtoOutputStream(
         int64_t currentTimeNs, const DumpReportReason reason, ProtoOutputStream* proto) {
+    std::lock_guard<std::mutex> reportLock(mReportMutex);
     std::lock_guard<std::mutex> lock(mMetricsMutex);
     WriteActiveConfigsToProtoOutputStreamLocked(currentTimeNs, reason, proto);
 }
@@ -961,6 +1111,7 @@ void StatsLogProcessor::WriteActiveConfigsToProtoOutputStreamLocked(
     }
 }
 void StatsLogProcessor::LoadActiveConfigsFromDisk() {
+    std::lock_guard<std::mutex> reportLock(mReportMutex);
     std::lock_guard<std::mutex> lock(mMetricsMutex);
     string file_name = StringPrintf("%s/active_metrics", STATS_ACTIVE_METRIC_DIR);
     int fd = open(file_name.c_str(), O_RDONLY | O_CLOEXEC);
@@ -992,6 +1143,7 @@ void StatsLogProcessor::LoadActiveConfigsFromDisk() {
 
 void StatsLogProcessor::SetConfigsActiveState(const ActiveConfigList& activeConfigList,
                                                     int64_t currentTimeNs) {
+    std::lock_guard<std::mutex> reportLock(mReportMutex);
     std::lock_guard<std::mutex> lock(mMetricsMutex);
     SetConfigsActiveStateLocked(activeConfigList, currentTimeNs);
 }
@@ -1032,11 +1184,13 @@ void StatsLogProcessor::WriteDataToDiskLocked(const DumpReportReason dumpReportR
 
 void StatsLogProcessor::WriteDataToDisk(const DumpReportReason dumpReportReason,
                                         const DumpLatency dumpLatency) {
+    std::lock_guard<std::mutex> reportLock(mReportMutex);
     std::lock_guard<std::mutex> lock(mMetricsMutex);
     WriteDataToDiskLocked(dumpReportReason, dumpLatency);
 }
 
 void StatsLogProcessor::informPullAlarmFired(const int64_t timestampNs) {
+    std::lock_guard<std::mutex> reportLock(mReportMutex);
     std::lock_guard<std::mutex> lock(mMetricsMutex);
     mPullerManager->OnAlarmFired(timestampNs);
 }
@@ -1052,6 +1206,7 @@ int64_t StatsLogProcessor::getLastReportTimeNs(const ConfigKey& key) {
 
 void StatsLogProcessor::notifyAppUpgrade(const int64_t& eventTimeNs, const string& apk,
                                          const int uid, const int64_t version) {
+    std::lock_guard<std::mutex> reportLock(mReportMutex);
     std::lock_guard<std::mutex> lock(mMetricsMutex);
     VLOG("Received app upgrade");
     StateManager::getInstance().notifyAppChanged(apk, mUidMap);
@@ -1062,6 +1217,7 @@ void StatsLogProcessor::notifyAppUpgrade(const int64_t& eventTimeNs, const strin
 
 void StatsLogProcessor::notifyAppRemoved(const int64_t& eventTimeNs, const string& apk,
                                          const int uid) {
+    std::lock_guard<std::mutex> reportLock(mReportMutex);
     std::lock_guard<std::mutex> lock(mMetricsMutex);
     VLOG("Received app removed");
     StateManager::getInstance().notifyAppChanged(apk, mUidMap);
@@ -1071,6 +1227,7 @@ void StatsLogProcessor::notifyAppRemoved(const int64_t& eventTimeNs, const strin
 }
 
 void StatsLogProcessor::onUidMapReceived(const int64_t& eventTimeNs) {
+    std::lock_guard<std::mutex> reportLock(mReportMutex);
     std::lock_guard<std::mutex> lock(mMetricsMutex);
     VLOG("Received uid map");
     StateManager::getInstance().updateLogSources(mUidMap);
@@ -1080,6 +1237,7 @@ void StatsLogProcessor::onUidMapReceived(const int64_t& eventTimeNs) {
 }
 
 void StatsLogProcessor::onStatsdInitCompleted(const int64_t& elapsedTimeNs) {
+    std::lock_guard<std::mutex> reportLock(mReportMutex);
     std::lock_guard<std::mutex> lock(mMetricsMutex);
     VLOG("Received boot completed signal");
     for (const auto& it : mMetricsManagers) {
@@ -1088,6 +1246,7 @@ void StatsLogProcessor::onStatsdInitCompleted(const int64_t& elapsedTimeNs) {
 }
 
 void StatsLogProcessor::noteOnDiskData(const ConfigKey& key) {
+    std::lock_guard<std::mutex> reportLock(mReportMutex);
     std::lock_guard<std::mutex> lock(mMetricsMutex);
     mOnDiskDataConfigs.insert(key);
 }
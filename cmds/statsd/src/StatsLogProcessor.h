@@ -27,6 +27,9 @@
 #include "frameworks/base/cmds/statsd/src/statsd_metadata.pb.h"
 
 #include <stdio.h>
+
+#include <deque>
+#include <memory>
 #include <unordered_map>
 
 namespace android {
@@ -65,6 +68,12 @@ public:
                       const DumpReportReason dumpReportReason,
                       const DumpLatency dumpLatency,
                       ProtoOutputStream* proto);
+    // Writes the report straight to outFd rather than copying it into a buffer first.
+    void onDumpReport(const ConfigKey& key, const int64_t dumpTimeNs,
+                      const bool include_current_partial_bucket, const bool erase_data,
+                      const DumpReportReason dumpReportReason,
+                      const DumpLatency dumpLatency,
+                      const int outFd);
 
     /* Tells MetricsManager that the alarms in alarmSet have fired. Modifies anomaly alarmSet. */
     void onAnomalyAlarmFired(
@@ -158,10 +167,27 @@ private:
         return mPeriodicAlarmMonitor;
     }
 
+    // Held by every entry point that reads or changes the configs other than OnLogEvent, for
+    // its whole duration. onDumpReport holds it while it builds a report without mMetricsMutex,
+    // which keeps all other users away from the config being dumped. Acquired before
+    // mMetricsMutex.
+    mutable mutex mReportMutex;
+
     mutable mutex mMetricsMutex;
 
     std::unordered_map<ConfigKey, sp<MetricsManager>> mMetricsManagers;
 
+    // A config whose report is being built without mMetricsMutex.
+    struct ConfigDump {
+        // Whether the config was active when the report was started.
+        bool wasActive = false;
+
+        // Events for the config that arrived while its report was being built, in order.
+        std::deque<std::unique_ptr<LogEvent>> pendingEvents;
+    };
+
+    std::unordered_map<ConfigKey, ConfigDump> mConfigsBeingDumped;
+
     std::unordered_map<ConfigKey, int64_t> mLastBroadcastTimes;
 
     // Last time we sent a broadcast to this uid that the active configs had changed.
@@ -219,6 +245,35 @@ private:
              (e.g., before reboot). So no need to further persist local history.*/
             const bool dataSavedToDisk, vector<uint8_t>* proto);
 
+    // Same as onConfigMetricsReportLocked, for a MetricsManager that is not otherwise in use.
+    // Does not need mMetricsMutex.
+    void onConfigMetricsReport(const ConfigKey& key, MetricsManager& metricsManager,
+                               const int64_t dumpTimeStampNs,
+                               const bool include_current_partial_bucket, const bool erase_data,
+                               const DumpReportReason dumpReportReason,
+                               const DumpLatency dumpLatency, const bool dataSavedToDisk,
+                               vector<uint8_t>* proto);
+
+    // Writes the fields of the config's ConfigMetricsReport into proto, which may be a nested
+    // message the caller has started. Does not keep a local history copy.
+    void onConfigMetricsReport(const ConfigKey& key, MetricsManager& metricsManager,
+                               const int64_t dumpTimeStampNs,
+                               const bool include_current_partial_bucket, const bool erase_data,
+                               const DumpReportReason dumpReportReason,
+                               const DumpLatency dumpLatency, ProtoOutputStream* proto);
+
+    // Marks the config as being dumped, so that OnLogEvent holds on to its events, and returns
+    // its MetricsManager. Returns nullptr if there is no such config.
+    sp<MetricsManager> beginConfigDumpLocked(const ConfigKey& key);
+
+    // Hands the events held back during the dump over to the config.
+    void endConfigDumpLocked(const ConfigKey& key, const int64_t elapsedRealtimeNs);
+
+    // Tells the receivers of the uid which of its configs are active, unless the rate limit
+    // stops us. Returns false if it did.
+    bool sendActivationBroadcastLocked(const int uid, const vector<int64_t>& activeConfigs,
+                                       const int64_t elapsedRealtimeNs);
+
     /* Check if we should send a broadcast if approaching memory limits and if we're over, we
      * actually delete the data. */
     void flushIfNecessaryLocked(const ConfigKey& key, MetricsManager& metricsManager);
@@ -291,6 +346,7 @@ private:
     FRIEND_TEST(StatsLogProcessorTest,
             TestActivationOnBootMultipleActivationsDifferentActivationTypes);
     FRIEND_TEST(StatsLogProcessorTest, TestActivationsPersistAcrossSystemServerRestart);
+    FRIEND_TEST(StatsLogProcessorTest, TestEventsHeldDuringDump);
 
     FRIEND_TEST(WakelockDurationE2eTest, TestAggregatedPredicateDimensionsForSumDuration1);
     FRIEND_TEST(WakelockDurationE2eTest, TestAggregatedPredicateDimensionsForSumDuration2);
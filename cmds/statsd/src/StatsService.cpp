@@ -55,6 +55,9 @@ constexpr const char* kPermissionDump = "android.permission.DUMP";
 
 constexpr const char* kPermissionRegisterPullAtom = "android.permission.REGISTER_STATS_PULL_ATOM";
 
+// The most events taken from the LogEventQueue per wake up of the log reading thread.
+constexpr size_t kMaxLogEventBatchSize = 64;
+
 #define STATS_SERVICE_DIR "/data/misc/stats-service"
 
 // for StatsDataDumpProto
@@ -173,18 +176,23 @@ StatsService::~StatsService() {
 
 /* Runs on a dedicated thread to process pushed events. */
 void StatsService::readLogs() {
+    std::vector<std::unique_ptr<LogEvent>> events;
+    events.reserve(kMaxLogEventBatchSize);
     // Read forever..... long live statsd
     while (1) {
-        // Block until an event is available.
-        auto event = mEventQueue->waitPop();
-        // Pass it to StatsLogProcess to all configs/metrics
-        // At this point, the LogEventQueue is not blocked, so that the socketListener
-        // can read events from the socket and write to buffer to avoid data drop.
-        mProcessor->OnLogEvent(event.get());
-        // The ShellSubscriber is only used by shell for local debugging.
-        if (mShellSubscriber != nullptr) {
-            mShellSubscriber->onLogEvent(*event);
+        // Block until an event is available, then take everything that has queued up since.
+        mEventQueue->waitPopBatch(&events, kMaxLogEventBatchSize);
+        for (const auto& event : events) {
+            // Pass it to StatsLogProcess to all configs/metrics
+            // The LogEventQueue never blocks the socketListener, so it can keep reading
+            // events from the socket and writing them to the buffer to avoid data drop.
+            mProcessor->OnLogEvent(event.get());
+            // The ShellSubscriber is only used by shell for local debugging.
+            if (mShellSubscriber != nullptr) {
+                mShellSubscriber->onLogEvent(*event);
+            }
         }
+        events.clear();
     }
 }
 
@@ -682,16 +690,15 @@ status_t StatsService::cmd_dump_report(int out, const Vector<String8>& args) {
             name.assign(args[2].c_str(), args[2].size());
         }
         if (good) {
-            vector<uint8_t> data;
-            mProcessor->onDumpReport(ConfigKey(uid, StrToInt64(name)), getElapsedRealtimeNs(),
-                                     includeCurrentBucket, eraseData, ADB_DUMP,
-                                     NO_TIME_CONSTRAINTS,
-                                     &data);
             if (proto) {
-                for (size_t i = 0; i < data.size(); i ++) {
-                    dprintf(out, "%c", data[i]);
-                }
+                mProcessor->onDumpReport(ConfigKey(uid, StrToInt64(name)), getElapsedRealtimeNs(),
+                                         includeCurrentBucket, eraseData, ADB_DUMP,
+                                         NO_TIME_CONSTRAINTS, out);
             } else {
+                vector<uint8_t> data;
+                mProcessor->onDumpReport(ConfigKey(uid, StrToInt64(name)), getElapsedRealtimeNs(),
+                                         includeCurrentBucket, eraseData, ADB_DUMP,
+                                         NO_TIME_CONSTRAINTS, &data);
                 dprintf(out, "Non-proto stats data dump not currently supported.\n");
             }
             return android::OK;
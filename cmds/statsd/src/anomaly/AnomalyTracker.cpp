@@ -27,6 +27,7 @@
 #include "subscriber/SubscriberReporter.h"
 
 #include <inttypes.h>
+#include <algorithm>
 #include <statslog_statsd.h>
 #include <time.h>
 
@@ -55,9 +56,6 @@ AnomalyTracker::~AnomalyTracker() {
 void AnomalyTracker::resetStorage() {
     VLOG("resetStorage() called.");
     mPastBuckets.clear();
-    // Excludes the current bucket.
-    mPastBuckets.resize(mNumOfPastBuckets);
-    mSumOverPastBuckets.clear();
 }
 
 size_t AnomalyTracker::index(int64_t bucketNum) const {
@@ -84,13 +82,62 @@ void AnomalyTracker::advanceMostRecentBucketTo(const int64_t& bucketNum) {
         return;
     }
 
-    // Clear out space by emptying out old mPastBuckets[i] values and update mSumOverPastBuckets.
-    for (int64_t i = mMostRecentBucketNum + 1; i <= bucketNum; i++) {
-        const int idx = index(i);
-        subtractBucketFromSum(mPastBuckets[idx]);
-        mPastBuckets[idx] = nullptr;  // release (but not clear) the old bucket.
-    }
+    // Once per full turn of the window, drop the dimensions that have no data left in it, so
+    // that the cost of removing them is spread over mNumOfPastBuckets buckets.
+    const bool sweep = bucketNum / mNumOfPastBuckets > mMostRecentBucketNum / mNumOfPastBuckets;
     mMostRecentBucketNum = bucketNum;
+    if (sweep) {
+        removeExpiredDimensions();
+    }
+}
+
+void AnomalyTracker::advanceDimensionTo(DimensionPastBuckets& dimension,
+                                        const int64_t& bucketNum) {
+    if (bucketNum <= dimension.mostRecentBucketNum) {
+        return;
+    }
+    if (bucketNum >= dimension.mostRecentBucketNum + mNumOfPastBuckets) {
+        std::fill(dimension.values.begin(), dimension.values.end(), 0);
+        dimension.sum = 0;
+    } else {
+        for (int64_t i = dimension.mostRecentBucketNum + 1; i <= bucketNum; i++) {
+            int64_t& value = dimension.values[index(i)];
+            dimension.sum -= value;
+            value = 0;
+        }
+    }
+    dimension.mostRecentBucketNum = bucketNum;
+}
+
+void AnomalyTracker::removeExpiredDimensions() {
+    for (auto it = mPastBuckets.begin(); it != mPastBuckets.end();) {
+        if (it->second.mostRecentBucketNum <= mMostRecentBucketNum - mNumOfPastBuckets) {
+            it = mPastBuckets.erase(it);
+        } else {
+            it++;
+        }
+    }
+}
+
+void AnomalyTracker::setPastBucketValue(const MetricDimensionKey& key,
+                                        const int64_t& bucketValue, const int64_t& bucketNum) {
+    auto it = mPastBuckets.find(key);
+    if (it == mPastBuckets.end()) {
+        if (bucketValue == 0) {
+            return;
+        }
+        it = mPastBuckets.emplace(key, DimensionPastBuckets(mNumOfPastBuckets,
+                                                            mMostRecentBucketNum)).first;
+    }
+    DimensionPastBuckets& dimension = it->second;
+    advanceDimensionTo(dimension, mMostRecentBucketNum);
+
+    int64_t& value = dimension.values[index(bucketNum)];
+    dimension.sum += bucketValue - value;
+    value = bucketValue;
+    if (dimension.sum == 0) {
+        mPastBuckets.erase(it);
+    }
 }
 
 void AnomalyTracker::addPastBucket(const MetricDimensionKey& key,
@@ -102,29 +149,14 @@ void AnomalyTracker::addPastBucket(const MetricDimensionKey& key,
         return;
     }
 
-    const int bucketIndex = index(bucketNum);
-    if (bucketNum <= mMostRecentBucketNum && (mPastBuckets[bucketIndex] != nullptr)) {
-        // We need to insert into an already existing past bucket.
-        std::shared_ptr<DimToValMap>& bucket = mPastBuckets[bucketIndex];
-        auto itr = bucket->find(key);
-        if (itr != bucket->end()) {
-            // Old entry already exists; update it.
-            subtractValueFromSum(key, itr->second);
-            itr->second = bucketValue;
-        } else {
-            bucket->insert({key, bucketValue});
-        }
-        mSumOverPastBuckets[key] += bucketValue;
-    } else {
-        // Bucket does not exist yet (in future or was never made), so we must make it.
-        std::shared_ptr<DimToValMap> bucket = std::make_shared<DimToValMap>();
-        bucket->insert({key, bucketValue});
-        addPastBucket(bucket, bucketNum);
+    if (bucketNum > mMostRecentBucketNum) {
+        // Clear space for the new bucket to be at bucketNum.
+        advanceMostRecentBucketTo(bucketNum);
     }
+    setPastBucketValue(key, bucketValue, bucketNum);
 }
 
-void AnomalyTracker::addPastBucket(std::shared_ptr<DimToValMap> bucket,
-                                   const int64_t& bucketNum) {
+void AnomalyTracker::addPastBucket(const DimToValMap& bucket, const int64_t& bucketNum) {
     VLOG("addPastBucket(bucket) called.");
     if (mNumOfPastBuckets == 0 ||
             bucketNum < 0 || bucketNum <= mMostRecentBucketNum - mNumOfPastBuckets) {
@@ -132,45 +164,26 @@ void AnomalyTracker::addPastBucket(std::shared_ptr<DimToValMap> bucket,
     }
 
     if (bucketNum <= mMostRecentBucketNum) {
-        // We are updating an old bucket, not adding a new one.
-        subtractBucketFromSum(mPastBuckets[index(bucketNum)]);
+        // We are replacing an old bucket, not adding a new one, so the dimensions that are not
+        // in the new bucket need their value for it cleared.
+        const size_t bucketIndex = index(bucketNum);
+        for (auto it = mPastBuckets.begin(); it != mPastBuckets.end();) {
+            DimensionPastBuckets& dimension = it->second;
+            advanceDimensionTo(dimension, mMostRecentBucketNum);
+            dimension.sum -= dimension.values[bucketIndex];
+            dimension.values[bucketIndex] = 0;
+            if (dimension.sum == 0) {
+                it = mPastBuckets.erase(it);
+            } else {
+                it++;
+            }
+        }
     } else {
         // Clear space for the new bucket to be at bucketNum.
         advanceMostRecentBucketTo(bucketNum);
     }
-    mPastBuckets[index(bucketNum)] = bucket;
-    addBucketToSum(bucket);
-}
-
-void AnomalyTracker::subtractBucketFromSum(const shared_ptr<DimToValMap>& bucket) {
-    if (bucket == nullptr) {
-        return;
-    }
-    for (const auto& keyValuePair : *bucket) {
-        subtractValueFromSum(keyValuePair.first, keyValuePair.second);
-    }
-}
-
-
-void AnomalyTracker::subtractValueFromSum(const MetricDimensionKey& key,
-                                          const int64_t& bucketValue) {
-    auto itr = mSumOverPastBuckets.find(key);
-    if (itr == mSumOverPastBuckets.end()) {
-        return;
-    }
-    itr->second -= bucketValue;
-    if (itr->second == 0) {
-        mSumOverPastBuckets.erase(itr);
-    }
-}
-
-void AnomalyTracker::addBucketToSum(const shared_ptr<DimToValMap>& bucket) {
-    if (bucket == nullptr) {
-        return;
-    }
-    // For each dimension present in the bucket, add its value to its corresponding sum.
-    for (const auto& keyValuePair : *bucket) {
-        mSumOverPastBuckets[keyValuePair.first] += keyValuePair.second;
+    for (const auto& keyValuePair : bucket) {
+        setPastBucketValue(keyValuePair.first, keyValuePair.second, bucketNum);
     }
 }
 
@@ -182,20 +195,39 @@ int64_t AnomalyTracker::getPastBucketValue(const MetricDimensionKey& key,
         return 0;
     }
 
-    const auto& bucket = mPastBuckets[index(bucketNum)];
-    if (bucket == nullptr) {
+    const auto& it = mPastBuckets.find(key);
+    if (it == mPastBuckets.end() || bucketNum > it->second.mostRecentBucketNum) {
         return 0;
     }
-    const auto& itr = bucket->find(key);
-    return itr == bucket->end() ? 0 : itr->second;
+    return it->second.values[index(bucketNum)];
 }
 
 int64_t AnomalyTracker::getSumOverPastBuckets(const MetricDimensionKey& key) const {
-    const auto& itr = mSumOverPastBuckets.find(key);
-    if (itr != mSumOverPastBuckets.end()) {
-        return itr->second;
+    const auto& it = mPastBuckets.find(key);
+    if (it == mPastBuckets.end()) {
+        return 0;
+    }
+    const DimensionPastBuckets& dimension = it->second;
+    if (dimension.mostRecentBucketNum <= mMostRecentBucketNum - mNumOfPastBuckets) {
+        return 0;
+    }
+    // Leave out the buckets that have gone out of the window since the dimension was last
+    // advanced.
+    int64_t sum = dimension.sum;
+    for (int64_t i = dimension.mostRecentBucketNum + 1; i <= mMostRecentBucketNum; i++) {
+        sum -= dimension.values[index(i)];
+    }
+    return sum;
+}
+
+size_t AnomalyTracker::getNumOfDimensionsWithPastData() const {
+    size_t count = 0;
+    for (const auto& it : mPastBuckets) {
+        if (getSumOverPastBuckets(it.first) > 0) {
+            count++;
+        }
     }
-    return 0;
+    return count;
 }
 
 bool AnomalyTracker::detectAnomaly(const int64_t& currentBucketNum,
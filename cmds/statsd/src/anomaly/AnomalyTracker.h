@@ -50,7 +50,7 @@ public:
     // If a bucket for bucketNum already exists, it will be replaced.
     // Also, advances to bucketNum (if not in the past), effectively filling any intervening
     // buckets with 0s.
-    void addPastBucket(std::shared_ptr<DimToValMap> bucket, const int64_t& bucketNum);
+    void addPastBucket(const DimToValMap& bucket, const int64_t& bucketNum);
 
     // Inserts (or replaces) the bucket entry for the given bucketNum at the given key to be the
     // given bucketValue. If the bucket does not exist, it will be created.
@@ -145,13 +145,28 @@ protected:
     // for the anomaly detection (since the current bucket is not in the past).
     const int mNumOfPastBuckets;
 
-    // Values for each of the past mNumOfPastBuckets buckets. Always of size mNumOfPastBuckets.
-    // mPastBuckets[i] can be null, meaning that no data is present in that bucket.
-    std::vector<shared_ptr<DimToValMap>> mPastBuckets;
+    // The past bucket values of a single dimension.
+    struct DimensionPastBuckets {
+        explicit DimensionPastBuckets(int numOfPastBuckets, int64_t bucketNum)
+            : values(numOfPastBuckets, 0), mostRecentBucketNum(bucketNum) {
+        }
 
-    // Cached sum over all existing buckets in mPastBuckets.
-    // Its buckets never contain entries of 0.
-    DimToValMap mSumOverPastBuckets;
+        // Circular array of the values of the past mNumOfPastBuckets buckets, indexed by index().
+        // Only the buckets up to mostRecentBucketNum are valid.
+        std::vector<int64_t> values;
+
+        // Sum over the valid buckets in values.
+        int64_t sum = 0;
+
+        // The bucket number that values has been advanced to. Can lag behind
+        // mMostRecentBucketNum, in which case the later buckets are implicitly 0, so that
+        // advancing the tracker does not need to visit every dimension.
+        int64_t mostRecentBucketNum;
+    };
+
+    // Past bucket values for each dimension that has a non-zero value in some past bucket.
+    // Dimensions whose values have all gone out of the window are removed lazily.
+    unordered_map<MetricDimensionKey, DimensionPastBuckets> mPastBuckets;
 
     // The bucket number of the last added bucket.
     int64_t mMostRecentBucketNum = -1;
@@ -162,20 +177,24 @@ protected:
     // Entries may be, but are not guaranteed to be, removed after the period is finished.
     unordered_map<MetricDimensionKey, uint32_t> mRefractoryPeriodEndsSec;
 
-    // Advances mMostRecentBucketNum to bucketNum, deleting any data that is now too old.
-    // Specifically, since it is now too old, removes the data for
-    //   [mMostRecentBucketNum - mNumOfPastBuckets + 1, bucketNum - mNumOfPastBuckets].
+    // Advances mMostRecentBucketNum to bucketNum. The data that is now too old, i.e. that of
+    //   [mMostRecentBucketNum - mNumOfPastBuckets + 1, bucketNum - mNumOfPastBuckets],
+    // is dropped from each dimension the next time that dimension is used.
     void advanceMostRecentBucketTo(const int64_t& bucketNum);
 
-    // Add the information in the given bucket to mSumOverPastBuckets.
-    void addBucketToSum(const shared_ptr<DimToValMap>& bucket);
+    // Advances the dimension to bucketNum, zeroing the buckets that are now too old.
+    void advanceDimensionTo(DimensionPastBuckets& dimension, const int64_t& bucketNum);
 
-    // Subtract the information in the given bucket from mSumOverPastBuckets
-    // and remove any items with value 0.
-    void subtractBucketFromSum(const shared_ptr<DimToValMap>& bucket);
+    // Sets the value of the dimension in the given past bucket, which must be in the window.
+    void setPastBucketValue(const MetricDimensionKey& key, const int64_t& bucketValue,
+                            const int64_t& bucketNum);
 
-    // From mSumOverPastBuckets[key], subtracts bucketValue, removing it if it is now 0.
-    void subtractValueFromSum(const MetricDimensionKey& key, const int64_t& bucketValue);
+    // Removes the dimensions that no longer have data in any past bucket.
+    void removeExpiredDimensions();
+
+    // For testing only.
+    // Returns the number of dimensions with a non-zero sum over the past buckets.
+    size_t getNumOfDimensionsWithPastData() const;
 
     // Returns true if in the refractory period, else false.
     bool isInRefractoryPeriod(const int64_t& timestampNs, const MetricDimensionKey& key) const;
@@ -192,6 +211,7 @@ protected:
 
     FRIEND_TEST(AnomalyTrackerTest, TestConsecutiveBuckets);
     FRIEND_TEST(AnomalyTrackerTest, TestSparseBuckets);
+    FRIEND_TEST(AnomalyTrackerTest, TestExpiredDimensionsRemoved);
     FRIEND_TEST(GaugeMetricProducerTest, TestAnomalyDetection);
     FRIEND_TEST(CountMetricProducerTest, TestAnomalyDetectionUnSliced);
     FRIEND_TEST(AnomalyDetectionE2eTest, TestDurationMetric_SUM_single_bucket);
@@ -25,6 +25,7 @@
 
 #include <algorithm>
 #include <iostream>
+#include <thread>
 
 #include "../StatsService.h"
 #include "../logd/LogEvent.h"
@@ -107,22 +108,8 @@ bool StatsPullerManager::PullLocked(int tagId, const ConfigKey& configKey,
                                     const int64_t eventTimeNs, vector<shared_ptr<LogEvent>>* data,
                                     bool useUids) {
     vector<int32_t> uids;
-    if (useUids) {
-        auto uidProviderIt = mPullUidProviders.find(configKey);
-        if (uidProviderIt == mPullUidProviders.end()) {
-            ALOGE("Error pulling tag %d. No pull uid provider for config key %s", tagId,
-                  configKey.ToString().c_str());
-            StatsdStats::getInstance().notePullUidProviderNotFound(tagId);
-            return false;
-        }
-        sp<PullUidProvider> pullUidProvider = uidProviderIt->second.promote();
-        if (pullUidProvider == nullptr) {
-            ALOGE("Error pulling tag %d, pull uid provider for config %s is gone.", tagId,
-                  configKey.ToString().c_str());
-            StatsdStats::getInstance().notePullUidProviderNotFound(tagId);
-            return false;
-        }
-        uids = pullUidProvider->getPullAtomUids(tagId);
+    if (useUids && !getPullUidsLocked(tagId, configKey, &uids)) {
+        return false;
     }
     return PullLocked(tagId, uids, eventTimeNs, data, useUids);
 }
@@ -131,35 +118,59 @@ bool StatsPullerManager::PullLocked(int tagId, const vector<int32_t>& uids,
                                     const int64_t eventTimeNs, vector<shared_ptr<LogEvent>>* data,
                                     bool useUids) {
     VLOG("Initiating pulling %d", tagId);
+    sp<StatsPuller> puller = findPullerLocked(tagId, uids, useUids);
+    if (puller == nullptr) {
+        return false;  // Return early since we don't know what to pull.
+    }
+    bool ret = puller->Pull(eventTimeNs, data);
+    VLOG("pulled %zu items", data->size());
+    if (!ret) {
+        StatsdStats::getInstance().notePullFailed(tagId);
+    }
+    return ret;
+}
+
+bool StatsPullerManager::getPullUidsLocked(int tagId, const ConfigKey& configKey,
+                                           vector<int32_t>* uids) {
+    auto uidProviderIt = mPullUidProviders.find(configKey);
+    if (uidProviderIt == mPullUidProviders.end()) {
+        ALOGE("Error pulling tag %d. No pull uid provider for config key %s", tagId,
+              configKey.ToString().c_str());
+        StatsdStats::getInstance().notePullUidProviderNotFound(tagId);
+        return false;
+    }
+    sp<PullUidProvider> pullUidProvider = uidProviderIt->second.promote();
+    if (pullUidProvider == nullptr) {
+        ALOGE("Error pulling tag %d, pull uid provider for config %s is gone.", tagId,
+              configKey.ToString().c_str());
+        StatsdStats::getInstance().notePullUidProviderNotFound(tagId);
+        return false;
+    }
+    *uids = pullUidProvider->getPullAtomUids(tagId);
+    return true;
+}
+
+sp<StatsPuller> StatsPullerManager::findPullerLocked(int tagId, const vector<int32_t>& uids,
+                                                     bool useUids) {
     if (useUids) {
         for (int32_t uid : uids) {
             PullerKey key = {.atomTag = tagId, .uid = uid};
             auto pullerIt = kAllPullAtomInfo.find(key);
             if (pullerIt != kAllPullAtomInfo.end()) {
-                bool ret = pullerIt->second->Pull(eventTimeNs, data);
-                VLOG("pulled %zu items", data->size());
-                if (!ret) {
-                    StatsdStats::getInstance().notePullFailed(tagId);
-                }
-                return ret;
+                return pullerIt->second;
             }
         }
         StatsdStats::getInstance().notePullerNotFound(tagId);
         ALOGW("StatsPullerManager: Unknown tagId %d", tagId);
-        return false;  // Return early since we don't know what to pull.
+        return nullptr;
     } else {
         PullerKey key = {.atomTag = tagId, .uid = -1};
         auto pullerIt = kAllPullAtomInfo.find(key);
         if (pullerIt != kAllPullAtomInfo.end()) {
-            bool ret = pullerIt->second->Pull(eventTimeNs, data);
-            VLOG("pulled %zu items", data->size());
-            if (!ret) {
-                StatsdStats::getInstance().notePullFailed(tagId);
-            }
-            return ret;
+            return pullerIt->second;
         }
         ALOGW("StatsPullerManager: Unknown tagId %d", tagId);
-        return false;  // Return early since we don't know what to pull.
+        return nullptr;
     }
 }
 
@@ -290,10 +301,53 @@ void StatsPullerManager::OnAlarmFired(int64_t elapsedTimeNs) {
             }
         }
     }
+    // Find the puller for each atom and config. When several configs need the same puller, it is
+    // pulled once and the data goes to all of them.
+    vector<PendingPull> pulls;
     for (const auto& pullInfo : needToPull) {
-        vector<shared_ptr<LogEvent>> data;
-        bool pullSuccess = PullLocked(pullInfo.first->atomTag, pullInfo.first->configKey,
-                                      elapsedTimeNs, &data);
+        const int tagId = pullInfo.first->atomTag;
+        vector<int32_t> uids;
+        sp<StatsPuller> puller;
+        if (getPullUidsLocked(tagId, pullInfo.first->configKey, &uids)) {
+            puller = findPullerLocked(tagId, uids, true /* useUids */);
+        }
+        auto pull = std::find_if(pulls.begin(), pulls.end(), [&puller](const PendingPull& p) {
+            return puller != nullptr && p.puller == puller;
+        });
+        if (pull == pulls.end()) {
+            pull = pulls.insert(pulls.end(), PendingPull());
+            pull->tagId = tagId;
+            pull->puller = puller;
+        }
+        pull->receivers.insert(pull->receivers.end(), pullInfo.second.begin(),
+                               pullInfo.second.end());
+    }
+
+    // Run the pulls at the same time, so that a slow puller, such as a callback into another
+    // process, does not delay the others scheduled for the same bucket boundary. Each puller
+    // enforces its own timeout.
+    vector<std::thread> pullThreads;
+    for (size_t i = 1; i < pulls.size(); i++) {
+        if (pulls[i].puller != nullptr) {
+            PendingPull* pull = &pulls[i];
+            pullThreads.emplace_back([pull, elapsedTimeNs] {
+                pull->pullSuccess = pull->puller->Pull(elapsedTimeNs, &pull->data);
+            });
+        }
+    }
+    if (!pulls.empty() && pulls[0].puller != nullptr) {
+        pulls[0].pullSuccess = pulls[0].puller->Pull(elapsedTimeNs, &pulls[0].data);
+    }
+    for (std::thread& pullThread : pullThreads) {
+        pullThread.join();
+    }
+
+    for (auto& pull : pulls) {
+        vector<shared_ptr<LogEvent>>& data = pull.data;
+        const bool pullSuccess = pull.pullSuccess;
+        if (pull.puller != nullptr && !pullSuccess) {
+            StatsdStats::getInstance().notePullFailed(pull.tagId);
+        }
         if (!pullSuccess) {
             VLOG("pull failed at %lld, will try again later", (long long)elapsedTimeNs);
         }
@@ -310,7 +364,7 @@ void StatsPullerManager::OnAlarmFired(int64_t elapsedTimeNs) {
             event->setLogdWallClockTimestampNs(wallClockNs);
         }
 
-        for (const auto& receiverInfo : pullInfo.second) {
+        for (const auto& receiverInfo : pull.receivers) {
             sp<PullDataReceiver> receiverPtr = receiverInfo->receiver.promote();
             if (receiverPtr != nullptr) {
                 receiverPtr->onDataPulled(data, pullSuccess, elapsedTimeNs);
@@ -158,6 +158,21 @@ private:
     bool PullLocked(int tagId, const vector<int32_t>& uids, const int64_t eventTimeNs,
                     vector<std::shared_ptr<LogEvent>>* data, bool useUids);
 
+    // Gets the uids whose pullers the config may use for the atom.
+    bool getPullUidsLocked(int tagId, const ConfigKey& configKey, vector<int32_t>* uids);
+
+    // Returns the puller to use for the atom, or nullptr if there is none.
+    sp<StatsPuller> findPullerLocked(int tagId, const vector<int32_t>& uids, bool useUids);
+
+    // A puller to run when the pull alarm fires, and the receivers waiting for its data.
+    struct PendingPull {
+        int tagId = 0;
+        sp<StatsPuller> puller;
+        std::vector<ReceiverInfo*> receivers;
+        std::vector<std::shared_ptr<LogEvent>> data;
+        bool pullSuccess = false;
+    };
+
     // locks for data receiver and StatsCompanionService changes
     std::mutex mLock;
 
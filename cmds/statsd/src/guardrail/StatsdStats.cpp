@@ -52,11 +52,18 @@ const int FIELD_ID_SYSTEM_SERVER_RESTART = 15;
 const int FIELD_ID_LOGGER_ERROR_STATS = 16;
 const int FIELD_ID_OVERFLOW = 18;
 const int FIELD_ID_ACTIVATION_BROADCAST_GUARDRAIL = 19;
+const int FIELD_ID_REPORT_FILE_STATS = 20;
+const int FIELD_ID_ATOM_PROCESSING_COST = 21;
 
 const int FIELD_ID_ATOM_STATS_TAG = 1;
 const int FIELD_ID_ATOM_STATS_COUNT = 2;
 const int FIELD_ID_ATOM_STATS_ERROR_COUNT = 3;
 
+const int FIELD_ID_ATOM_PROCESSING_COST_TAG = 1;
+const int FIELD_ID_ATOM_PROCESSING_COST_SAMPLE_COUNT = 2;
+const int FIELD_ID_ATOM_PROCESSING_COST_AVERAGE_TIME_NS = 3;
+const int FIELD_ID_ATOM_PROCESSING_COST_MAX_TIME_NS = 4;
+
 const int FIELD_ID_ANOMALY_ALARMS_REGISTERED = 1;
 const int FIELD_ID_PERIODIC_ALARMS_REGISTERED = 1;
 
@@ -71,6 +78,10 @@ const int FIELD_ID_OVERFLOW_COUNT = 1;
 const int FIELD_ID_OVERFLOW_MAX_HISTORY = 2;
 const int FIELD_ID_OVERFLOW_MIN_HISTORY = 3;
 
+const int FIELD_ID_REPORT_FILE_STATS_FILES = 1;
+const int FIELD_ID_REPORT_FILE_STATS_REPORT_BYTES = 2;
+const int FIELD_ID_REPORT_FILE_STATS_STORED_BYTES = 3;
+
 const int FIELD_ID_CONFIG_STATS_UID = 1;
 const int FIELD_ID_CONFIG_STATS_ID = 2;
 const int FIELD_ID_CONFIG_STATS_CREATION = 3;
@@ -241,6 +252,13 @@ void StatsdStats::noteActiveStatusChanged(const ConfigKey& key, bool activated,
     vec.push_back(timeSec);
 }
 
+void StatsdStats::noteReportFileWritten(size_t reportBytes, size_t storedBytes) {
+    lock_guard<std::mutex> lock(mLock);
+    mReportFilesWritten++;
+    mReportFileBytes += reportBytes;
+    mReportFileStoredBytes += storedBytes;
+}
+
 void StatsdStats::noteActivationBroadcastGuardrailHit(const int uid) {
     noteActivationBroadcastGuardrailHit(uid, getWallClockSec());
 }
@@ -468,6 +486,22 @@ void StatsdStats::noteAtomLogged(int atomId, int32_t timeSec) {
     }
 }
 
+void StatsdStats::noteAtomProcessingCost(int atomId, int64_t timeNs) {
+    lock_guard<std::mutex> lock(mLock);
+
+    auto it = mAtomProcessingCost.find(atomId);
+    if (it == mAtomProcessingCost.end()) {
+        if (mAtomProcessingCost.size() >= kMaxProcessingCostAtoms) {
+            return;
+        }
+        it = mAtomProcessingCost.emplace(atomId, AtomProcessingCost()).first;
+    }
+    AtomProcessingCost& cost = it->second;
+    cost.sampleCount++;
+    cost.totalTimeNs += timeNs;
+    cost.maxTimeNs = std::max(cost.maxTimeNs, timeNs);
+}
+
 void StatsdStats::noteSystemServerRestart(int32_t timeSec) {
     lock_guard<std::mutex> lock(mLock);
 
@@ -541,6 +575,21 @@ void StatsdStats::noteBucketUnknownCondition(int64_t metricId) {
     getAtomMetricStats(metricId).bucketUnknownCondition++;
 }
 
+void StatsdStats::noteMetricProcessingCost(int64_t metricId, int64_t timeNs) {
+    lock_guard<std::mutex> lock(mLock);
+    AtomMetricStats& metricStats = getAtomMetricStats(metricId);
+    metricStats.processingSampleCount++;
+    metricStats.totalProcessingTimeNs += timeNs;
+    metricStats.maxProcessingTimeNs = std::max(metricStats.maxProcessingTimeNs, timeNs);
+}
+
+void StatsdStats::noteMetricByteSize(int64_t metricId, size_t byteSize) {
+    lock_guard<std::mutex> lock(mLock);
+    AtomMetricStats& metricStats = getAtomMetricStats(metricId);
+    metricStats.byteSize = byteSize;
+    metricStats.maxByteSize = std::max(metricStats.maxByteSize, byteSize);
+}
+
 void StatsdStats::noteConditionChangeInNextBucket(int64_t metricId) {
     lock_guard<std::mutex> lock(mLock);
     getAtomMetricStats(metricId).conditionChangeInNextBucket++;
@@ -599,12 +648,16 @@ void StatsdStats::resetInternalLocked() {
     mIceBox.clear();
     std::fill(mPushedAtomStats.begin(), mPushedAtomStats.end(), 0);
     mNonPlatformPushedAtomStats.clear();
+    mAtomProcessingCost.clear();
     mAnomalyAlarmRegisteredStats = 0;
     mPeriodicAlarmRegisteredStats = 0;
     mSystemServerRestartSec.clear();
     mLogLossStats.clear();
     mOverflowCount = 0;
     mMinQueueHistoryNs = kInt64Max;
+    mReportFilesWritten = 0;
+    mReportFileBytes = 0;
+    mReportFileStoredBytes = 0;
     mMaxQueueHistoryNs = 0;
     for (auto& config : mConfigStats) {
         config.second->broadcast_sent_time_sec.clear();
@@ -777,6 +830,31 @@ void StatsdStats::dumpStats(int out) const {
                 getPushedAtomErrors(pair.first));
     }
 
+    dprintf(out, "********Atom processing cost stats***********\n");
+    dprintf(out, "Sampling 1 in %d events\n", kProcessingCostSamplingRate);
+    for (const auto& pair : mAtomProcessingCost) {
+        const AtomProcessingCost& cost = pair.second;
+        dprintf(out, "Atom %d->(samples)%ld, (average time nanos)%lld, (max time nanos)%lld\n",
+                pair.first, cost.sampleCount, (long long)(cost.totalTimeNs / cost.sampleCount),
+                (long long)cost.maxTimeNs);
+    }
+
+    dprintf(out, "********Metric processing cost stats***********\n");
+    for (const auto& pair : mAtomMetricStats) {
+        const AtomMetricStats& stats = pair.second;
+        if (stats.processingSampleCount == 0 && stats.maxByteSize == 0) {
+            continue;
+        }
+        dprintf(out,
+                "Metric %lld->(samples)%ld, (average time nanos)%lld, (max time nanos)%lld, "
+                "(bytes)%zu, (max bytes)%zu\n",
+                (long long)pair.first, stats.processingSampleCount,
+                (long long)(stats.processingSampleCount > 0
+                                    ? stats.totalProcessingTimeNs / stats.processingSampleCount
+                                    : 0),
+                (long long)stats.maxProcessingTimeNs, stats.byteSize, stats.maxByteSize);
+    }
+
     dprintf(out, "********Pulled Atom stats***********\n");
     for (const auto& pair : mPulledAtomStats) {
         dprintf(out,
@@ -843,6 +921,9 @@ void StatsdStats::dumpStats(int out) const {
     dprintf(out, "Event queue overflow: %d; MaxHistoryNs: %lld; MinHistoryNs: %lld\n",
             mOverflowCount, (long long)mMaxQueueHistoryNs, (long long)mMinQueueHistoryNs);
 
+    dprintf(out, "Report files written: %d; ReportBytes: %lld; StoredBytes: %lld\n",
+            mReportFilesWritten, (long long)mReportFileBytes, (long long)mReportFileStoredBytes);
+
     if (mActivationBroadcastGuardrailStats.size() > 0) {
         dprintf(out, "********mActivationBroadcastGuardrail stats***********\n");
         for (const auto& pair: mActivationBroadcastGuardrailStats) {
@@ -1014,6 +1095,19 @@ void StatsdStats::dumpStats(std::vector<uint8_t>* output, bool reset) {
         android::os::statsd::writeAtomMetricStatsToStream(pair, &proto);
     }
 
+    for (const auto& pair : mAtomProcessingCost) {
+        uint64_t token = proto.start(FIELD_TYPE_MESSAGE | FIELD_ID_ATOM_PROCESSING_COST |
+                                     FIELD_COUNT_REPEATED);
+        proto.write(FIELD_TYPE_INT32 | FIELD_ID_ATOM_PROCESSING_COST_TAG, pair.first);
+        proto.write(FIELD_TYPE_INT64 | FIELD_ID_ATOM_PROCESSING_COST_SAMPLE_COUNT,
+                    (long long)pair.second.sampleCount);
+        proto.write(FIELD_TYPE_INT64 | FIELD_ID_ATOM_PROCESSING_COST_AVERAGE_TIME_NS,
+                    (long long)(pair.second.totalTimeNs / pair.second.sampleCount));
+        proto.write(FIELD_TYPE_INT64 | FIELD_ID_ATOM_PROCESSING_COST_MAX_TIME_NS,
+                    (long long)pair.second.maxTimeNs);
+        proto.end(token);
+    }
+
     if (mAnomalyAlarmRegisteredStats > 0) {
         uint64_t token = proto.start(FIELD_TYPE_MESSAGE | FIELD_ID_ANOMALY_ALARM_STATS);
         proto.write(FIELD_TYPE_INT32 | FIELD_ID_ANOMALY_ALARMS_REGISTERED,
@@ -1057,6 +1151,16 @@ void StatsdStats::dumpStats(std::vector<uint8_t>* output, bool reset) {
         proto.end(token);
     }
 
+    if (mReportFilesWritten > 0) {
+        uint64_t token = proto.start(FIELD_TYPE_MESSAGE | FIELD_ID_REPORT_FILE_STATS);
+        proto.write(FIELD_TYPE_INT32 | FIELD_ID_REPORT_FILE_STATS_FILES, mReportFilesWritten);
+        proto.write(FIELD_TYPE_INT64 | FIELD_ID_REPORT_FILE_STATS_REPORT_BYTES,
+                    (long long)mReportFileBytes);
+        proto.write(FIELD_TYPE_INT64 | FIELD_ID_REPORT_FILE_STATS_STORED_BYTES,
+                    (long long)mReportFileStoredBytes);
+        proto.end(token);
+    }
+
     for (const auto& restart : mSystemServerRestartSec) {
         proto.write(FIELD_TYPE_INT32 | FIELD_ID_SYSTEM_SERVER_RESTART | FIELD_COUNT_REPEATED,
                     restart);
@@ -165,6 +165,12 @@ public:
     // Maximum number of pushed atoms statsd stats will track above kMaxPushedAtomId.
     static const int kMaxNonPlatformPushedAtoms = 100;
 
+    // One in this many events is timed for the processing cost stats.
+    static const int kProcessingCostSamplingRate = 100;
+
+    // Maximum number of atoms the processing cost stats are tracked for.
+    static const int kMaxProcessingCostAtoms = 200;
+
     // Maximum atom id value that we consider a platform pushed atom.
     // This should be updated once highest pushed atom id in atoms.proto approaches this value.
     static const int kMaxPushedAtomId = 500;
@@ -291,6 +297,12 @@ public:
      */
     void noteAtomLogged(int atomId, int32_t timeSec);
 
+    /**
+     * Report the time a sampled event of atomId took to be processed by a config's
+     * MetricsManager.
+     */
+    void noteAtomProcessingCost(int atomId, int64_t timeNs);
+
     /**
      * Report that statsd modified the anomaly alarm registered with StatsCompanionService.
      */
@@ -459,10 +471,26 @@ public:
      */
     void noteBucketUnknownCondition(int64_t metricId);
 
+    /**
+     * Report the time a metric took to process a sampled matched event.
+     */
+    void noteMetricProcessingCost(int64_t metricId, int64_t timeNs);
+
+    /**
+     * Report the bytes currently held in the buckets of a metric.
+     */
+    void noteMetricByteSize(int64_t metricId, size_t byteSize);
+
     /* Reports one event has been dropped due to queue overflow, and the oldest event timestamp in
      * the queue */
     void noteEventQueueOverflow(int64_t oldestEventTimestampNs);
 
+    /**
+     * Reports that a report file of reportBytes was written to disk, taking up storedBytes after
+     * compression.
+     */
+    void noteReportFileWritten(size_t reportBytes, size_t storedBytes);
+
     /**
      * Reports that the activation broadcast guardrail was hit for this uid. Namely, the broadcast
      * should have been sent, but instead was skipped due to hitting the guardrail.
@@ -542,8 +570,19 @@ public:
         int64_t maxBucketBoundaryDelayNs = 0;
         long bucketUnknownCondition = 0;
         long bucketCount = 0;
+        long processingSampleCount = 0;
+        int64_t totalProcessingTimeNs = 0;
+        int64_t maxProcessingTimeNs = 0;
+        size_t byteSize = 0;
+        size_t maxByteSize = 0;
     } AtomMetricStats;
 
+    typedef struct {
+        long sampleCount = 0;
+        int64_t totalTimeNs = 0;
+        int64_t maxTimeNs = 0;
+    } AtomProcessingCost;
+
 private:
     StatsdStats();
 
@@ -572,6 +611,10 @@ private:
     // The max size of the map is kMaxNonPlatformPushedAtoms.
     std::unordered_map<int, int> mNonPlatformPushedAtomStats;
 
+    // Maps atom id to the cost of processing its sampled events, summed over all configs.
+    // The max size of the map is kMaxProcessingCostAtoms.
+    std::map<int, AtomProcessingCost> mAtomProcessingCost;
+
     // Maps PullAtomId to its stats. The size is capped by the puller atom counts.
     std::map<int, PulledAtomStats> mPulledAtomStats;
 
@@ -618,6 +661,11 @@ private:
     // Total number of events that are lost due to queue overflow.
     int32_t mOverflowCount = 0;
 
+    // Number of report files written to disk, and their total size before and after compression.
+    int32_t mReportFilesWritten = 0;
+    int64_t mReportFileBytes = 0;
+    int64_t mReportFileStoredBytes = 0;
+
     // Timestamps when we detect log loss, and the number of logs lost.
     std::list<LogLossStats> mLogLossStats;
 
@@ -667,6 +715,7 @@ private:
     FRIEND_TEST(StatsdStatsTest, TestSystemServerCrash);
     FRIEND_TEST(StatsdStatsTest, TestPullAtomStats);
     FRIEND_TEST(StatsdStatsTest, TestAtomMetricsStats);
+    FRIEND_TEST(StatsdStatsTest, TestProcessingCostStats);
     FRIEND_TEST(StatsdStatsTest, TestActivationBroadcastGuardrailHit);
     FRIEND_TEST(StatsdStatsTest, TestAtomErrorStats);
 
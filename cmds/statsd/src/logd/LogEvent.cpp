@@ -127,7 +127,7 @@ void LogEvent::parseString(int32_t* pos, int32_t depth, bool* last, uint8_t numA
     string value = string((char*)mBuf, numBytes);
     mBuf += numBytes;
     mRemainingLen -= numBytes;
-    addToValues(pos, depth, value, last);
+    addToValues(pos, depth, std::move(value), last);
     parseAnnotations(numAnnotations);
 }
 
@@ -154,7 +154,7 @@ void LogEvent::parseByteArray(int32_t* pos, int32_t depth, bool* last, uint8_t n
     vector<uint8_t> value(mBuf, mBuf + numBytes);
     mBuf += numBytes;
     mRemainingLen -= numBytes;
-    addToValues(pos, depth, value, last);
+    addToValues(pos, depth, std::move(value), last);
     parseAnnotations(numAnnotations);
 }
 
@@ -355,6 +355,9 @@ bool LogEvent::parseBuffer(uint8_t* buf, size_t len) {
 
     uint8_t numElements = readNextValue<uint8_t>();
     if (numElements < 2 || numElements > 127) mValid = false;
+    // Every element other than the timestamp and the atom id is at least one FieldValue.
+    // Attribution chains and key value pairs may still grow the vector.
+    if (mValid) mValues.reserve(numElements - 2);
 
     typeInfo = readNextValue<uint8_t>();
     if (getTypeId(typeInfo) != INT64_TYPE) mValid = false;
@@ -278,15 +278,14 @@ private:
     }
 
     template <class T>
-    void addToValues(int32_t* pos, int32_t depth, T& value, bool* last) {
+    void addToValues(int32_t* pos, int32_t depth, T&& value, bool* last) {
         Field f = Field(mTagId, pos, depth);
         // do not decorate last position at depth 0
         for (int i = 1; i < depth; i++) {
             if (last[i]) f.decorateLastPos(i);
         }
 
-        Value v = Value(value);
-        mValues.push_back(FieldValue(f, v));
+        mValues.emplace_back(f, Value(std::forward<T>(value)));
     }
 
     uint8_t getTypeId(uint8_t typeInfo);
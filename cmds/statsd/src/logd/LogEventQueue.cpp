@@ -26,35 +26,150 @@ namespace statsd {
 using std::unique_lock;
 using std::unique_ptr;
 
-unique_ptr<LogEvent> LogEventQueue::waitPop() {
-    std::unique_lock<std::mutex> lock(mMutex);
+LogEventQueue::LogEventQueue(size_t maxSize)
+    : mQueueLimit(maxSize),
+      mSlots(new Slot[maxSize]),
+      mPushPosition(0),
+      mPopPosition(0),
+      mReaderWaiting(false) {
+    for (size_t i = 0; i < mQueueLimit; i++) {
+        mSlots[i].sequence.store(i, std::memory_order_relaxed);
+        mSlots[i].timestampNs.store(0, std::memory_order_relaxed);
+    }
+}
 
-    if (mQueue.empty()) {
-        mCondition.wait(lock, [this] { return !this->mQueue.empty(); });
+unique_ptr<LogEvent> LogEventQueue::tryPop() {
+    const size_t position = mPopPosition.load(std::memory_order_relaxed);
+    Slot& slot = mSlots[position % mQueueLimit];
+    if (slot.sequence.load(std::memory_order_acquire) != position + 1) {
+        return nullptr;
     }
+    unique_ptr<LogEvent> item = std::move(slot.event);
+    // Hand the slot back to the writers for the next lap around the ring.
+    slot.sequence.store(position + mQueueLimit, std::memory_order_release);
+    mPopPosition.store(position + 1, std::memory_order_relaxed);
+    return item;
+}
 
-    unique_ptr<LogEvent> item = std::move(mQueue.front());
-    mQueue.pop();
+bool LogEventQueue::isEmpty() const {
+    const size_t position = mPopPosition.load(std::memory_order_relaxed);
+    return mSlots[position % mQueueLimit].sequence.load(std::memory_order_acquire) != position + 1;
+}
 
-    return item;
+void LogEventQueue::waitForEvent() {
+    if (!isEmpty()) {
+        return;
+    }
+    std::unique_lock<std::mutex> lock(mMutex);
+    // Writers check this flag after publishing an event, and the queue is checked again after
+    // setting it, so either the writer sees the flag and notifies, or the event is seen here.
+    mReaderWaiting.store(true, std::memory_order_seq_cst);
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    mCondition.wait(lock, [this] { return !this->isEmpty(); });
+    mReaderWaiting.store(false, std::memory_order_relaxed);
+}
+
+unique_ptr<LogEvent> LogEventQueue::waitPop() {
+    waitForEvent();
+    return tryPop();
+}
+
+size_t LogEventQueue::waitPopBatch(std::vector<unique_ptr<LogEvent>>* events, size_t maxCount) {
+    waitForEvent();
+    size_t count = 0;
+    while (count < maxCount) {
+        unique_ptr<LogEvent> item = tryPop();
+        if (item == nullptr) {
+            break;
+        }
+        events->push_back(std::move(item));
+        count++;
+    }
+    return count;
 }
 
 bool LogEventQueue::push(unique_ptr<LogEvent> item, int64_t* oldestTimestampNs) {
-    bool success;
-    {
-        std::unique_lock<std::mutex> lock(mMutex);
-        if (mQueue.size() < mQueueLimit) {
-            mQueue.push(std::move(item));
-            success = true;
+    size_t position = mPushPosition.load(std::memory_order_relaxed);
+    while (true) {
+        const size_t sequence =
+                mSlots[position % mQueueLimit].sequence.load(std::memory_order_acquire);
+        const intptr_t lap = static_cast<intptr_t>(sequence) - static_cast<intptr_t>(position);
+        if (lap == 0) {
+            // The slot is free, claim it unless another writer got there first.
+            if (mPushPosition.compare_exchange_weak(position, position + 1,
+                                                    std::memory_order_relaxed)) {
+                break;
+            }
+        } else if (lap < 0) {
+            // The slot still holds an event from the previous lap, so the queue is full.
+            const size_t oldest = mPopPosition.load(std::memory_order_relaxed);
+            *oldestTimestampNs =
+                    mSlots[oldest % mQueueLimit].timestampNs.load(std::memory_order_relaxed);
+            return false;
         } else {
-            // safe operation as queue must not be empty.
-            *oldestTimestampNs = mQueue.front()->GetElapsedTimestampNs();
-            success = false;
+            position = mPushPosition.load(std::memory_order_relaxed);
         }
     }
 
-    mCondition.notify_one();
-    return success;
+    publish(position, std::move(item));
+    wakeReader();
+    return true;
+}
+
+size_t LogEventQueue::pushBatch(std::vector<unique_ptr<LogEvent>>* events,
+                                int64_t* oldestTimestampNs) {
+    size_t pushed = 0;
+    while (pushed < events->size()) {
+        size_t position = mPushPosition.load(std::memory_order_relaxed);
+        // The reader frees slots in order, so if the last slot wanted is free, every slot before
+        // it is too. Shrink the run until it fits.
+        size_t count = std::min(events->size() - pushed, mQueueLimit);
+        while (count > 0 && mSlots[(position + count - 1) % mQueueLimit].sequence.load(
+                                    std::memory_order_acquire) != position + count - 1) {
+            count--;
+        }
+        if (count == 0) {
+            const size_t sequence =
+                    mSlots[position % mQueueLimit].sequence.load(std::memory_order_acquire);
+            if (static_cast<intptr_t>(sequence) - static_cast<intptr_t>(position) < 0) {
+                const size_t oldest = mPopPosition.load(std::memory_order_relaxed);
+                *oldestTimestampNs =
+                        mSlots[oldest % mQueueLimit].timestampNs.load(std::memory_order_relaxed);
+                break;
+            }
+            // Another writer claimed the slot first, try again from its new position.
+            continue;
+        }
+        if (!mPushPosition.compare_exchange_weak(position, position + count,
+                                                 std::memory_order_relaxed)) {
+            continue;
+        }
+        for (size_t i = 0; i < count; i++) {
+            publish(position + i, std::move((*events)[pushed + i]));
+        }
+        pushed += count;
+    }
+
+    if (pushed > 0) {
+        events->erase(events->begin(), events->begin() + pushed);
+        wakeReader();
+    }
+    return pushed;
+}
+
+void LogEventQueue::publish(size_t position, unique_ptr<LogEvent> event) {
+    Slot& slot = mSlots[position % mQueueLimit];
+    slot.timestampNs.store(event->GetElapsedTimestampNs(), std::memory_order_relaxed);
+    slot.event = std::move(event);
+    slot.sequence.store(position + 1, std::memory_order_release);
+}
+
+void LogEventQueue::wakeReader() {
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    if (mReaderWaiting.load(std::memory_order_seq_cst)) {
+        std::lock_guard<std::mutex> lock(mMutex);
+        mCondition.notify_one();
+    }
 }
 
 }  // namespace statsd
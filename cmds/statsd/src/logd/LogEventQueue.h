@@ -18,9 +18,11 @@
 
 #include "LogEvent.h"
 
+#include <atomic>
 #include <condition_variable>
+#include <memory>
 #include <mutex>
-#include <queue>
+#include <vector>
 
 namespace android {
 namespace os {
@@ -28,16 +30,27 @@ namespace statsd {
 
 /**
  * A zero copy thread safe queue buffer for producing and consuming LogEvent.
+ *
+ * The queue is a bounded ring of slots that any number of threads may push to without taking a
+ * lock, and that a single thread pops from. Pushing only touches the mutex to wake the reader
+ * when it is asleep on an empty queue, so a writer never waits for the reader.
  */
 class LogEventQueue {
 public:
-    explicit LogEventQueue(size_t maxSize) : mQueueLimit(maxSize){};
+    explicit LogEventQueue(size_t maxSize);
 
     /**
      * Blocking read one event from the queue.
      */
     std::unique_ptr<LogEvent> waitPop();
 
+    /**
+     * Blocks until the queue is not empty, then moves up to maxCount events to the end of
+     * events, oldest first. Returns the number of events moved.
+     * Must only be called from one thread at a time, like waitPop().
+     */
+    size_t waitPopBatch(std::vector<std::unique_ptr<LogEvent>>* events, size_t maxCount);
+
     /**
      * Puts a LogEvent ptr to the end of the queue.
      * Returns false on failure when the queue is full, and output the oldest event timestamp
@@ -45,11 +58,40 @@ public:
      */
     bool push(std::unique_ptr<LogEvent> event, int64_t* oldestTimestampNs);
 
+    /**
+     * Puts as many of the given events as fit to the end of the queue, in order, claiming their
+     * slots together. Returns the number of events pushed from the front of events; the events
+     * that did not fit are left in place and the oldest event timestamp in the queue is output.
+     */
+    size_t pushBatch(std::vector<std::unique_ptr<LogEvent>>* events, int64_t* oldestTimestampNs);
+
 private:
+    struct Slot {
+        // Equal to the position that may be pushed into this slot while it is free, and to that
+        // position + 1 once the event is readable.
+        std::atomic<size_t> sequence;
+        // Kept next to the event so that a writer finding the queue full can read the oldest
+        // timestamp without racing with the reader taking the event.
+        std::atomic<int64_t> timestampNs;
+        std::unique_ptr<LogEvent> event;
+    };
+
+    // Pops one event, or returns nullptr if the queue is empty. Reader only.
+    std::unique_ptr<LogEvent> tryPop();
+    bool isEmpty() const;
+    void waitForEvent();
+    void publish(size_t position, std::unique_ptr<LogEvent> event);
+    void wakeReader();
+
     const size_t mQueueLimit;
+    std::unique_ptr<Slot[]> mSlots;
+    std::atomic<size_t> mPushPosition;
+    std::atomic<size_t> mPopPosition;
+
+    // Only used to put the reader to sleep while the queue is empty.
+    std::atomic<bool> mReaderWaiting;
     std::condition_variable mCondition;
     std::mutex mMutex;
-    std::queue<std::unique_ptr<LogEvent>> mQueue;
 };
 
 }  // namespace statsd
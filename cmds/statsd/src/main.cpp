@@ -75,8 +75,8 @@ int main(int /*argc*/, char** /*argv*/) {
     ABinderProcess_setThreadPoolMaxThreadCount(9);
     ABinderProcess_startThreadPool();
 
-    std::shared_ptr<LogEventQueue> eventQueue =
-            std::make_shared<LogEventQueue>(2000 /*buffer limit. Buffer is NOT pre-allocated*/);
+    // Buffer limit. The slots are pre-allocated, the events themselves are not.
+    std::shared_ptr<LogEventQueue> eventQueue = std::make_shared<LogEventQueue>(2000);
 
     // Create the service
     gStatsService = SharedRefBase::make<StatsService>(looper, eventQueue);
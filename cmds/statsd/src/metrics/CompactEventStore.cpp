@@ -0,0 +1,257 @@
+/*
+ * Copyright (C) 2020 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#define DEBUG false  // STOPSHIP if true
+#include "Log.h"
+
+#include "CompactEventStore.h"
+
+#include <string.h>
+
+using std::string;
+using std::vector;
+
+namespace android {
+namespace os {
+namespace statsd {
+
+namespace {
+
+void writeVarint(uint64_t value, vector<uint8_t>* out) {
+    while (value >= 0x80) {
+        out->push_back(static_cast<uint8_t>(value | 0x80));
+        value >>= 7;
+    }
+    out->push_back(static_cast<uint8_t>(value));
+}
+
+uint64_t readVarint(const vector<uint8_t>& buffer, size_t* pos) {
+    uint64_t value = 0;
+    int shift = 0;
+    uint8_t byte;
+    do {
+        byte = buffer[(*pos)++];
+        value |= static_cast<uint64_t>(byte & 0x7f) << shift;
+        shift += 7;
+    } while (byte & 0x80);
+    return value;
+}
+
+size_t varintSize(uint64_t value) {
+    size_t size = 1;
+    while (value >= 0x80) {
+        value >>= 7;
+        size++;
+    }
+    return size;
+}
+
+inline uint64_t zigzagEncode(int64_t value) {
+    return (static_cast<uint64_t>(value) << 1) ^ static_cast<uint64_t>(value >> 63);
+}
+
+inline int64_t zigzagDecode(uint64_t value) {
+    return static_cast<int64_t>(value >> 1) ^ -static_cast<int64_t>(value & 1);
+}
+
+template <typename T>
+void writeFixed(T value, vector<uint8_t>* out) {
+    const size_t pos = out->size();
+    out->resize(pos + sizeof(T));
+    memcpy(out->data() + pos, &value, sizeof(T));
+}
+
+template <typename T>
+T readFixed(const vector<uint8_t>& buffer, size_t* pos) {
+    T value;
+    memcpy(&value, buffer.data() + *pos, sizeof(T));
+    *pos += sizeof(T);
+    return value;
+}
+
+}  // namespace
+
+CompactEventStore::CompactEventStore(const int64_t maxBytes, const bool dropOldest)
+    : mMaxBytes(maxBytes > 0 ? maxBytes : 0), mDropOldest(dropOldest) {
+}
+
+uint32_t CompactEventStore::internString(const string& str) {
+    auto it = mStringIds.find(str);
+    if (it != mStringIds.end()) {
+        return it->second;
+    }
+    const uint32_t id = mStrings.size();
+    it = mStringIds.emplace(str, id).first;
+    mStrings.push_back(&it->first);
+    mStringBytes += str.size();
+    return id;
+}
+
+void CompactEventStore::encodeEvent(const int64_t elapsedTimeNs, const LogEvent& event) {
+    mScratch.clear();
+    const vector<FieldValue>& values = event.getValues();
+    writeVarint(static_cast<uint32_t>(event.GetTagId()), &mScratch);
+    writeVarint(zigzagEncode(elapsedTimeNs), &mScratch);
+    writeVarint(values.size(), &mScratch);
+    for (const FieldValue& fieldValue : values) {
+        const Value& value = fieldValue.mValue;
+        writeVarint(static_cast<uint32_t>(fieldValue.mField.getField()), &mScratch);
+        mScratch.push_back(static_cast<uint8_t>(value.getType()));
+        switch (value.getType()) {
+            case INT:
+                writeVarint(zigzagEncode(value.int_value), &mScratch);
+                break;
+            case LONG:
+                writeVarint(zigzagEncode(value.long_value), &mScratch);
+                break;
+            case FLOAT:
+                writeFixed(value.float_value, &mScratch);
+                break;
+            case DOUBLE:
+                writeFixed(value.double_value, &mScratch);
+                break;
+            case STRING:
+                writeVarint(internString(value.str_value), &mScratch);
+                break;
+            case STORAGE:
+                writeVarint(value.storage_value.size(), &mScratch);
+                mScratch.insert(mScratch.end(), value.storage_value.begin(),
+                                value.storage_value.end());
+                break;
+            default:
+                break;
+        }
+    }
+}
+
+bool CompactEventStore::dropOldestRecord() {
+    if (mRecordCount == 0) {
+        return false;
+    }
+    const size_t length = readVarint(mBuffer, &mHead);
+    mHead += length;
+    mRecordCount--;
+    if (mRecordCount == 0) {
+        mBuffer.clear();
+        mHead = 0;
+    } else if (mHead > mBuffer.size() / 2) {
+        // Reclaim the evicted prefix. The head has to pass half of the buffer first, so the
+        // bytes moved here are amortized over the records that were evicted.
+        mBuffer.erase(mBuffer.begin(), mBuffer.begin() + mHead);
+        mHead = 0;
+    }
+    return true;
+}
+
+size_t CompactEventStore::append(const int64_t elapsedTimeNs, const LogEvent& event) {
+    if (mRecordCount == 0 && !mStrings.empty()) {
+        // Nothing references the dictionary anymore.
+        clear();
+    }
+
+    const size_t stringCount = mStrings.size();
+    encodeEvent(elapsedTimeNs, event);
+    const size_t recordBytes = varintSize(mScratch.size()) + mScratch.size();
+
+    size_t dropped = 0;
+    if (mMaxBytes > 0) {
+        if (mDropOldest) {
+            while (byteSize() + recordBytes > mMaxBytes && dropOldestRecord()) {
+                dropped++;
+            }
+        }
+        if (byteSize() + recordBytes > mMaxBytes) {
+            // Forget the strings only this record introduced so the dictionary stays bounded.
+            while (mStrings.size() > stringCount) {
+                mStringBytes -= mStrings.back()->size();
+                const string* str = mStrings.back();
+                mStrings.pop_back();
+                mStringIds.erase(*str);
+            }
+            VLOG("Compact event store full, dropping event of atom %d", event.GetTagId());
+            return dropped + 1;
+        }
+    }
+
+    writeVarint(mScratch.size(), &mBuffer);
+    mBuffer.insert(mBuffer.end(), mScratch.begin(), mScratch.end());
+    mRecordCount++;
+    return dropped;
+}
+
+void CompactEventStore::forEachEvent(const EventCallback& callback) const {
+    vector<FieldValue> values;
+    size_t pos = mHead;
+    while (pos < mBuffer.size()) {
+        const size_t length = readVarint(mBuffer, &pos);
+        const size_t end = pos + length;
+        const int32_t tagId = static_cast<int32_t>(readVarint(mBuffer, &pos));
+        const int64_t elapsedTimeNs = zigzagDecode(readVarint(mBuffer, &pos));
+        const size_t count = readVarint(mBuffer, &pos);
+
+        values.clear();
+        values.reserve(count);
+        for (size_t i = 0; i < count; i++) {
+            const Field field(tagId, static_cast<int32_t>(readVarint(mBuffer, &pos)));
+            const Type type = static_cast<Type>(mBuffer[pos++]);
+            switch (type) {
+                case INT:
+                    values.emplace_back(
+                            field, Value(static_cast<int32_t>(
+                                           zigzagDecode(readVarint(mBuffer, &pos)))));
+                    break;
+                case LONG:
+                    values.emplace_back(field, Value(zigzagDecode(readVarint(mBuffer, &pos))));
+                    break;
+                case FLOAT:
+                    values.emplace_back(field, Value(readFixed<float>(mBuffer, &pos)));
+                    break;
+                case DOUBLE:
+                    values.emplace_back(field, Value(readFixed<double>(mBuffer, &pos)));
+                    break;
+                case STRING:
+                    values.emplace_back(field, Value(*mStrings[readVarint(mBuffer, &pos)]));
+                    break;
+                case STORAGE: {
+                    const size_t size = readVarint(mBuffer, &pos);
+                    values.emplace_back(field, Value(vector<uint8_t>(
+                                                       mBuffer.begin() + pos,
+                                                       mBuffer.begin() + pos + size)));
+                    pos += size;
+                    break;
+                }
+                default:
+                    values.emplace_back(field, Value());
+                    break;
+            }
+        }
+        pos = end;
+        callback(elapsedTimeNs, tagId, values);
+    }
+}
+
+void CompactEventStore::clear() {
+    mBuffer.clear();
+    mHead = 0;
+    mRecordCount = 0;
+    mStringIds.clear();
+    mStrings.clear();
+    mStringBytes = 0;
+}
+
+}  // namespace statsd
+}  // namespace os
+}  // namespace android
@@ -0,0 +1,103 @@
+/*
+ * Copyright (C) 2020 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef COMPACT_EVENT_STORE_H
+#define COMPACT_EVENT_STORE_H
+
+#include <functional>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "FieldValue.h"
+#include "logd/LogEvent.h"
+
+namespace android {
+namespace os {
+namespace statsd {
+
+// Stores matched events as compact binary records in a single contiguous buffer. Each record holds
+// the elapsed timestamp, the atom tag and the flattened FieldValues of the event. Strings are
+// interned in a dictionary so repeated values (package names, tags) are only stored once. Records
+// are only expanded back into FieldValues when the data is read, e.g. at dump time.
+//
+// When a byte limit is set, the store behaves as a ring buffer: once the limit is hit either the
+// oldest records are evicted to make room, or the new record is dropped.
+class CompactEventStore {
+public:
+    using EventCallback = std::function<void(int64_t elapsedTimeNs, int32_t tagId,
+                                             const std::vector<FieldValue>& values)>;
+
+    // maxBytes <= 0 means the store is not bounded by itself.
+    CompactEventStore(const int64_t maxBytes, const bool dropOldest);
+
+    // Appends an event. Returns the number of events dropped to honor the byte limit, which
+    // includes the new event itself if it could not be stored.
+    size_t append(const int64_t elapsedTimeNs, const LogEvent& event);
+
+    // Decodes every stored event, oldest first.
+    void forEachEvent(const EventCallback& callback) const;
+
+    void clear();
+
+    inline bool empty() const {
+        return mRecordCount == 0;
+    }
+
+    inline size_t recordCount() const {
+        return mRecordCount;
+    }
+
+    // Bytes used by the records and the string dictionary.
+    inline size_t byteSize() const {
+        return mBuffer.size() - mHead + mStringBytes;
+    }
+
+private:
+    void encodeEvent(const int64_t elapsedTimeNs, const LogEvent& event);
+
+    uint32_t internString(const std::string& str);
+
+    // Removes the oldest record. Returns false if the store is empty.
+    bool dropOldestRecord();
+
+    const size_t mMaxBytes;
+
+    const bool mDropOldest;
+
+    // Records are [varint length][payload]. The live records start at mHead; the bytes before it
+    // belong to evicted records and are reclaimed lazily.
+    std::vector<uint8_t> mBuffer;
+
+    size_t mHead = 0;
+
+    size_t mRecordCount = 0;
+
+    // Scratch space for encoding a record before its length is known.
+    std::vector<uint8_t> mScratch;
+
+    std::unordered_map<std::string, uint32_t> mStringIds;
+
+    // Indexed by string id. Points at the keys of mStringIds, which are stable.
+    std::vector<const std::string*> mStrings;
+
+    size_t mStringBytes = 0;
+};
+
+}  // namespace statsd
+}  // namespace os
+}  // namespace android
+#endif  // COMPACT_EVENT_STORE_H
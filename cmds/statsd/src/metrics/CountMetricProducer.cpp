@@ -358,13 +358,13 @@ void CountMetricProducer::flushCurrentBucketLocked(const int64_t& eventTimeNs,
                 (*mCurrentFullCounters)[keyValuePair.first] += keyValuePair.second;
             }
             for (auto& tracker : mAnomalyTrackers) {
-                tracker->addPastBucket(mCurrentFullCounters, mCurrentBucketNum);
+                tracker->addPastBucket(*mCurrentFullCounters, mCurrentBucketNum);
             }
             mCurrentFullCounters = std::make_shared<DimToValMap>();
         } else {
             // Skip aggregating the partial buckets since there's no previous partial bucket.
             for (auto& tracker : mAnomalyTrackers) {
-                tracker->addPastBucket(mCurrentSlicedCounter, mCurrentBucketNum);
+                tracker->addPastBucket(*mCurrentSlicedCounter, mCurrentBucketNum);
             }
         }
     } else {
@@ -376,7 +376,6 @@ void CountMetricProducer::flushCurrentBucketLocked(const int64_t& eventTimeNs,
 
     StatsdStats::getInstance().noteBucketCount(mMetricId);
     // Only resets the counters, but doesn't setup the times nor numbers.
-    // (Do not clear since the old one is still referenced in mAnomalyTrackers).
     mCurrentSlicedCounter = std::make_shared<DimToValMap>();
     mCurrentBucketStartTimeNs = nextBucketStartTimeNs;
 }
@@ -72,7 +72,13 @@ EventMetricProducer::EventMetricProducer(
         }
         mConditionSliced = true;
     }
-    mProto = std::make_unique<ProtoOutputStream>();
+    if (metric.use_compact_storage()) {
+        mCompactStore = std::make_unique<CompactEventStore>(
+                metric.max_compact_storage_bytes(),
+                metric.storage_overflow_policy() == EventMetric::DROP_OLDEST);
+    } else {
+        mProto = std::make_unique<ProtoOutputStream>();
+    }
     VLOG("metric %lld created. bucket size %lld start_time: %lld", (long long)metric.id(),
          (long long)mBucketSizeNs, (long long)mTimeBaseNs);
 }
@@ -81,8 +87,16 @@ EventMetricProducer::~EventMetricProducer() {
     VLOG("~EventMetricProducer() called");
 }
 
+void EventMetricProducer::clearDataLocked() {
+    if (mCompactStore != nullptr) {
+        mCompactStore->clear();
+    } else {
+        mProto->clear();
+    }
+}
+
 void EventMetricProducer::dropDataLocked(const int64_t dropTimeNs) {
-    mProto->clear();
+    clearDataLocked();
     StatsdStats::getInstance().noteBucketDropped(mMetricId);
 }
 
@@ -108,7 +122,23 @@ std::unique_ptr<std::vector<uint8_t>> serializeProtoLocked(ProtoOutputStream& pr
 }
 
 void EventMetricProducer::clearPastBucketsLocked(const int64_t dumpTimeNs) {
-    mProto->clear();
+    clearDataLocked();
+}
+
+void EventMetricProducer::writeCompactEventsLocked(ProtoOutputStream* protoOutput) const {
+    uint64_t metricsToken = protoOutput->start(FIELD_TYPE_MESSAGE | FIELD_ID_EVENT_METRICS);
+    mCompactStore->forEachEvent([protoOutput](int64_t elapsedTimeNs, int32_t tagId,
+                                              const vector<FieldValue>& values) {
+        uint64_t wrapperToken =
+                protoOutput->start(FIELD_TYPE_MESSAGE | FIELD_COUNT_REPEATED | FIELD_ID_DATA);
+        protoOutput->write(FIELD_TYPE_INT64 | FIELD_ID_ELAPSED_TIMESTAMP_NANOS,
+                           (long long)elapsedTimeNs);
+        uint64_t eventToken = protoOutput->start(FIELD_TYPE_MESSAGE | FIELD_ID_ATOMS);
+        writeFieldValueTreeToStream(tagId, values, protoOutput);
+        protoOutput->end(eventToken);
+        protoOutput->end(wrapperToken);
+    });
+    protoOutput->end(metricsToken);
 }
 
 void EventMetricProducer::onDumpReportLocked(const int64_t dumpTimeNs,
@@ -119,6 +149,18 @@ void EventMetricProducer::onDumpReportLocked(const int64_t dumpTimeNs,
                                              ProtoOutputStream* protoOutput) {
     protoOutput->write(FIELD_TYPE_INT64 | FIELD_ID_ID, (long long)mMetricId);
     protoOutput->write(FIELD_TYPE_BOOL | FIELD_ID_IS_ACTIVE, isActiveLocked());
+    if (mCompactStore != nullptr) {
+        if (mCompactStore->empty()) {
+            return;
+        }
+        VLOG("metric %lld dump report now... %zu compact events", (long long)mMetricId,
+             mCompactStore->recordCount());
+        writeCompactEventsLocked(protoOutput);
+        if (erase_data) {
+            mCompactStore->clear();
+        }
+        return;
+    }
     if (mProto->size() <= 0) {
         return;
     }
@@ -150,6 +192,11 @@ void EventMetricProducer::onMatchedLogEventInternalLocked(
         return;
     }
 
+    if (mCompactStore != nullptr) {
+        mDroppedEventCount += mCompactStore->append(truncateTimestampIfNecessary(event), event);
+        return;
+    }
+
     uint64_t wrapperToken =
             mProto->start(FIELD_TYPE_MESSAGE | FIELD_COUNT_REPEATED | FIELD_ID_DATA);
     const int64_t elapsedTimeNs = truncateTimestampIfNecessary(event);
@@ -162,9 +209,21 @@ void EventMetricProducer::onMatchedLogEventInternalLocked(
 }
 
 size_t EventMetricProducer::byteSizeLocked() const {
+    if (mCompactStore != nullptr) {
+        return mCompactStore->byteSize();
+    }
     return mProto->bytesWritten();
 }
 
+void EventMetricProducer::dumpStatesLocked(FILE* out, bool verbose) const {
+    if (mCompactStore == nullptr) {
+        return;
+    }
+    fprintf(out, "EventMetric %lld compact events %zu, %zu bytes, %zu dropped\n",
+            (long long)mMetricId, mCompactStore->recordCount(), mCompactStore->byteSize(),
+            mDroppedEventCount);
+}
+
 }  // namespace statsd
 }  // namespace os
 }  // namespace android
@@ -20,9 +20,11 @@
 #include <unordered_map>
 
 #include <android/util/ProtoOutputStream.h>
+#include <gtest/gtest_prod.h>
 
 #include "../condition/ConditionTracker.h"
 #include "../matchers/matcher_util.h"
+#include "CompactEventStore.h"
 #include "MetricProducer.h"
 #include "frameworks/base/cmds/statsd/src/statsd_config.pb.h"
 #include "stats_util.h"
@@ -59,6 +61,10 @@ private:
                             android::util::ProtoOutputStream* protoOutput) override;
     void clearPastBucketsLocked(const int64_t dumpTimeNs) override;
 
+    void clearDataLocked();
+
+    void writeCompactEventsLocked(android::util::ProtoOutputStream* protoOutput) const;
+
     // Internal interface to handle condition change.
     void onConditionChangedLocked(const bool conditionMet, const int64_t eventTime) override;
 
@@ -70,11 +76,21 @@ private:
     // Internal function to calculate the current used bytes.
     size_t byteSizeLocked() const override;
 
-    void dumpStatesLocked(FILE* out, bool verbose) const override{};
+    void dumpStatesLocked(FILE* out, bool verbose) const override;
 
     // Maps to a EventMetricDataWrapper. Storing atom events in ProtoOutputStream
     // is more space efficient than storing LogEvent.
     std::unique_ptr<android::util::ProtoOutputStream> mProto;
+
+    // Set instead of mProto when the metric uses compact storage. Events are kept as compact
+    // records and only expanded to EventMetricData when the report is dumped.
+    std::unique_ptr<CompactEventStore> mCompactStore;
+
+    // Events dropped by mCompactStore to stay within max_compact_storage_bytes.
+    size_t mDroppedEventCount = 0;
+
+    FRIEND_TEST(EventMetricProducerTest, TestCompactStorageMatchesProtoStorage);
+    FRIEND_TEST(EventMetricProducerTest, TestCompactStorageOverflow);
 };
 
 }  // namespace statsd
@@ -588,7 +588,7 @@ void GaugeMetricProducer::flushCurrentBucketLocked(const int64_t& eventTimeNs,
         if (eventTimeNs > fullBucketEndTimeNs) {
             // This is known to be a full bucket, so send this data to the anomaly tracker.
             for (auto& tracker : mAnomalyTrackers) {
-                tracker->addPastBucket(mCurrentSlicedBucketForAnomaly, mCurrentBucketNum);
+                tracker->addPastBucket(*mCurrentSlicedBucketForAnomaly, mCurrentBucketNum);
             }
             mCurrentSlicedBucketForAnomaly = std::make_shared<DimToValMap>();
         }
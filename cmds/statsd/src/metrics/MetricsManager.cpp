@@ -84,6 +84,15 @@ MetricsManager::MetricsManager(const ConfigKey& key, const StatsdConfig& config,
             mActivationAtomTrackerToMetricMap, mDeactivationAtomTrackerToMetricMap,
             mAlertTrackerMap, mMetricIndexesWithActivation, mNoReportMetricIds);
 
+    if (mConfigValid) {
+        initTagIdToMatcherMap(mAllAtomMatchers, mTagIdToMatcherMap);
+        mMatcherCache.resize(mAllAtomMatchers.size(), MatchingState::kNotComputed);
+        mConditionCache.resize(mAllConditionTrackers.size(), ConditionState::kNotEvaluated);
+        mConditionChangedCache.resize(mAllConditionTrackers.size(), false);
+        mConditionToBeEvaluated.resize(mAllConditionTrackers.size(), false);
+        mConditionsToBeEvaluated.reserve(mAllConditionTrackers.size());
+    }
+
     mHashStringsInReport = config.hash_strings_in_metric_report();
     mVersionStringsInReport = config.version_strings_in_metric_report();
     mInstallerInReport = config.installer_in_metric_report();
@@ -450,6 +459,19 @@ void MetricsManager::onLogEvent(const LogEvent& event) {
         return;
     }
 
+    if (++mEventsSinceCostSample < StatsdStats::kProcessingCostSamplingRate) {
+        onLogEventInternal(event, false /*sampleCost*/);
+        return;
+    }
+    mEventsSinceCostSample = 0;
+    const int64_t startNs = getElapsedRealtimeNs();
+    onLogEventInternal(event, true /*sampleCost*/);
+    StatsdStats::getInstance().noteAtomProcessingCost(event.GetTagId(),
+                                                      getElapsedRealtimeNs() - startNs);
+}
+
+void MetricsManager::onLogEventInternal(const LogEvent& event, const bool sampleCost) {
+
     if (!checkLogCredentials(event)) {
         return;
     }
@@ -479,16 +501,21 @@ void MetricsManager::onLogEvent(const LogEvent& event) {
 
     mIsActive = isActive || !activeMetricsIndices.empty();
 
-    if (mTagIds.find(tagId) == mTagIds.end()) {
+    auto matchersIt = mTagIdToMatcherMap.find(tagId);
+    if (matchersIt == mTagIdToMatcherMap.end()) {
         // Not interesting...
         return;
     }
+    const vector<int>& matcherIndices = matchersIt->second;
 
-    vector<MatchingState> matcherCache(mAllAtomMatchers.size(), MatchingState::kNotComputed);
+    // Matchers that don't care about this atom are left as kNotComputed, which every consumer
+    // of the cache treats the same as kNotMatched.
+    vector<MatchingState>& matcherCache = mMatcherCache;
+    std::fill(matcherCache.begin(), matcherCache.end(), MatchingState::kNotComputed);
 
-    // Evaluate all atom matchers.
-    for (auto& matcher : mAllAtomMatchers) {
-        matcher->onLogEvent(event, mAllAtomMatchers, matcherCache);
+    // Evaluate the atom matchers that can match this atom.
+    for (const int matcherIndex : matcherIndices) {
+        mAllAtomMatchers[matcherIndex]->onLogEvent(event, mAllAtomMatchers, matcherCache);
     }
 
     // Set of metrics that received an activation cancellation.
@@ -528,57 +555,70 @@ void MetricsManager::onLogEvent(const LogEvent& event) {
 
     mIsActive = isActive;
 
-    // A bitmap to see which ConditionTracker needs to be re-evaluated.
-    vector<bool> conditionToBeEvaluated(mAllConditionTrackers.size(), false);
-
-    for (const auto& pair : mTrackerToConditionMap) {
-        if (matcherCache[pair.first] == MatchingState::kMatched) {
-            const auto& conditionList = pair.second;
-            for (const int conditionIndex : conditionList) {
-                conditionToBeEvaluated[conditionIndex] = true;
-            }
+    // Collect the conditions that use a matcher that matched this event. Only these can change;
+    // each list is ordered children first, so that combination conditions mostly find their
+    // children already evaluated.
+    vector<int>& conditionsToBeEvaluated = mConditionsToBeEvaluated;
+    conditionsToBeEvaluated.clear();
+    for (const int matcherIndex : matcherIndices) {
+        if (matcherCache[matcherIndex] != MatchingState::kMatched) {
+            continue;
         }
-    }
-
-    vector<ConditionState> conditionCache(mAllConditionTrackers.size(),
-                                          ConditionState::kNotEvaluated);
-    // A bitmap to track if a condition has changed value.
-    vector<bool> changedCache(mAllConditionTrackers.size(), false);
-    for (size_t i = 0; i < mAllConditionTrackers.size(); i++) {
-        if (conditionToBeEvaluated[i] == false) {
+        auto pair = mTrackerToConditionMap.find(matcherIndex);
+        if (pair == mTrackerToConditionMap.end()) {
             continue;
         }
-        sp<ConditionTracker>& condition = mAllConditionTrackers[i];
-        condition->evaluateCondition(event, matcherCache, mAllConditionTrackers, conditionCache,
-                                     changedCache);
+        for (const int conditionIndex : pair->second) {
+            if (!mConditionToBeEvaluated[conditionIndex]) {
+                mConditionToBeEvaluated[conditionIndex] = true;
+                conditionsToBeEvaluated.push_back(conditionIndex);
+            }
+        }
     }
 
-    for (size_t i = 0; i < mAllConditionTrackers.size(); i++) {
-        if (changedCache[i] == false) {
-            continue;
+    if (!conditionsToBeEvaluated.empty()) {
+        vector<ConditionState>& conditionCache = mConditionCache;
+        std::fill(conditionCache.begin(), conditionCache.end(), ConditionState::kNotEvaluated);
+        // A bitmap to track if a condition has changed value.
+        vector<bool>& changedCache = mConditionChangedCache;
+        std::fill(changedCache.begin(), changedCache.end(), false);
+        for (const int i : conditionsToBeEvaluated) {
+            mConditionToBeEvaluated[i] = false;
+            sp<ConditionTracker>& condition = mAllConditionTrackers[i];
+            condition->evaluateCondition(event, matcherCache, mAllConditionTrackers,
+                                         conditionCache, changedCache);
         }
-        auto pair = mConditionToMetricMap.find(i);
-        if (pair != mConditionToMetricMap.end()) {
-            auto& metricList = pair->second;
-            for (auto metricIndex : metricList) {
-                // Metric cares about non sliced condition, and it's changed.
-                // Push the new condition to it directly.
-                if (!mAllMetricProducers[metricIndex]->isConditionSliced()) {
-                    mAllMetricProducers[metricIndex]->onConditionChanged(conditionCache[i],
-                                                                         eventTimeNs);
-                    // Metric cares about sliced conditions, and it may have changed. Send
-                    // notification, and the metric can query the sliced conditions that are
-                    // interesting to it.
-                } else {
-                    mAllMetricProducers[metricIndex]->onSlicedConditionMayChange(conditionCache[i],
-                                                                                 eventTimeNs);
+
+        // A condition that is not in the list was at most evaluated as the child of one that is,
+        // and then it did not change, since none of its matchers matched.
+        for (const int i : conditionsToBeEvaluated) {
+            if (changedCache[i] == false) {
+                continue;
+            }
+            auto pair = mConditionToMetricMap.find(i);
+            if (pair != mConditionToMetricMap.end()) {
+                auto& metricList = pair->second;
+                for (auto metricIndex : metricList) {
+                    // Metric cares about non sliced condition, and it's changed.
+                    // Push the new condition to it directly.
+                    if (!mAllMetricProducers[metricIndex]->isConditionSliced()) {
+                        mAllMetricProducers[metricIndex]->onConditionChanged(conditionCache[i],
+                                                                             eventTimeNs);
+                        // Metric cares about sliced conditions, and it may have changed. Send
+                        // notification, and the metric can query the sliced conditions that are
+                        // interesting to it.
+                    } else {
+                        mAllMetricProducers[metricIndex]->onSlicedConditionMayChange(
+                                conditionCache[i], eventTimeNs);
+                    }
                 }
             }
         }
     }
 
-    // For matched AtomMatchers, tell relevant metrics that a matched event has come.
-    for (size_t i = 0; i < mAllAtomMatchers.size(); i++) {
+    // For matched AtomMatchers, tell relevant metrics that a matched event has come. Only the
+    // matchers listed for this atom can have matched it.
+    for (const int i : matcherIndices) {
         if (matcherCache[i] == MatchingState::kMatched) {
             StatsdStats::getInstance().noteMatcherMatched(mConfigKey,
                                                           mAllAtomMatchers[i]->getId());
@@ -586,8 +626,16 @@ void MetricsManager::onLogEvent(const LogEvent& event) {
             if (pair != mTrackerToMetricMap.end()) {
                 auto& metricList = pair->second;
                 for (const int metricIndex : metricList) {
-                    // pushed metrics are never scheduled pulls
-                    mAllMetricProducers[metricIndex]->onMatchedLogEvent(i, event);
+                    const sp<MetricProducer>& metric = mAllMetricProducers[metricIndex];
+                    if (!sampleCost) {
+                        // pushed metrics are never scheduled pulls
+                        metric->onMatchedLogEvent(i, event);
+                        continue;
+                    }
+                    const int64_t startNs = getElapsedRealtimeNs();
+                    metric->onMatchedLogEvent(i, event);
+                    StatsdStats::getInstance().noteMetricProcessingCost(
+                            metric->getMetricId(), getElapsedRealtimeNs() - startNs);
                 }
             }
         }
@@ -614,7 +662,9 @@ void MetricsManager::onPeriodicAlarmFired(
 size_t MetricsManager::byteSize() {
     size_t totalSize = 0;
     for (const auto& metricProducer : mAllMetricProducers) {
-        totalSize += metricProducer->byteSize();
+        const size_t metricSize = metricProducer->byteSize();
+        StatsdStats::getInstance().noteMetricByteSize(metricProducer->getMetricId(), metricSize);
+        totalSize += metricSize;
     }
     return totalSize;
 }
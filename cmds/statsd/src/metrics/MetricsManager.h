@@ -238,9 +238,9 @@ private:
     // To make the log processing more efficient, we want to do as much filtering as possible
     // before we go into individual trackers and conditions to match.
 
-    // 1st filter: check if the event tag id is in mTagIds.
+    // 1st filter: check if the event tag id is in mTagIdToMatcherMap.
     // 2nd filter: if it is, we parse the event because there is at least one member is interested.
-    //             then pass to all LogMatchingTrackers (itself also filter events by ids).
+    //             then pass to the LogMatchingTrackers listed for the tag id.
     // 3nd filter: for LogMatchingTrackers that matched this event, we pass this event to the
     //             ConditionTrackers and MetricProducers that use this matcher.
     // 4th filter: for ConditionTrackers that changed value due to this event, we pass
@@ -248,6 +248,24 @@ private:
 
     // The following map is initialized from the statsd_config.
 
+    // Maps from atom id to the indices of the LogMatchingTrackers that can match it.
+    std::unordered_map<int, std::vector<int>> mTagIdToMatcherMap;
+
+    // Matching results of the event being processed, reused across events.
+    std::vector<MatchingState> mMatcherCache;
+
+    // Scratch space for evaluating the conditions of an event, kept across events so that they
+    // are not allocated for each one. Sized to mAllConditionTrackers.
+    std::vector<ConditionState> mConditionCache;
+    std::vector<bool> mConditionChangedCache;
+    // Marks the conditions already in mConditionsToBeEvaluated. All false between events.
+    std::vector<bool> mConditionToBeEvaluated;
+    // The conditions to evaluate for the current event, in evaluation order.
+    std::vector<int> mConditionsToBeEvaluated;
+
+    // Events seen since the last one whose processing cost was sampled.
+    int mEventsSinceCostSample = 0;
+
     // Maps from the index of the LogMatchingTracker to index of MetricProducer.
     std::unordered_map<int, std::vector<int>> mTrackerToMetricMap;
 
@@ -269,6 +287,10 @@ private:
 
     std::vector<int> mMetricIndexesWithActivation;
 
+    // Handles onLogEvent. When sampleCost is true, the time spent in each metric is noted in
+    // StatsdStats.
+    void onLogEventInternal(const LogEvent& event, const bool sampleCost);
+
     void initLogSourceWhiteList();
 
     void initPullAtomSources();
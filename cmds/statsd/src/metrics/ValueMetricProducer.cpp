@@ -604,10 +604,13 @@ void ValueMetricProducer::accumulateEvents(const std::vector<std::shared_ptr<Log
     }
 
     mMatchedMetricDimensionKeys.clear();
+    mMatchedMetricDimensionKeys.reserve(allData.size());
     for (const auto& data : allData) {
-        LogEvent localCopy = data->makeCopy();
-        if (mEventMatcherWizard->matchLogEvent(localCopy, mWhatMatcherIndex) ==
+        // Matching does not change the event, so only the rows that match need to be copied to
+        // move them to the bucket boundary.
+        if (mEventMatcherWizard->matchLogEvent(*data, mWhatMatcherIndex) ==
             MatchingState::kMatched) {
+            LogEvent localCopy = data->makeCopy();
             localCopy.setElapsedTimestampNs(eventElapsedTimeNs);
             onMatchedLogEventLocked(mWhatMatcherIndex, localCopy);
         }
@@ -737,8 +740,8 @@ void ValueMetricProducer::onMatchedLogEventInternalLocked(
         const size_t matcherIndex, const MetricDimensionKey& eventKey,
         const ConditionKey& conditionKey, bool condition, const LogEvent& event,
         const map<int, HashableDimensionKey>& statePrimaryKeys) {
-    auto whatKey = eventKey.getDimensionKeyInWhat();
-    auto stateKey = eventKey.getStateValuesKey();
+    const auto& whatKey = eventKey.getDimensionKeyInWhat();
+    const auto& stateKey = eventKey.getStateValuesKey();
 
     // Skip this event if a state changed occurred for a different primary key.
     auto it = statePrimaryKeys.find(mStateChangePrimaryKey.first);
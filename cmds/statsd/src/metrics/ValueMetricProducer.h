@@ -17,6 +17,9 @@
 #pragma once
 
 #include <gtest/gtest_prod.h>
+
+#include <unordered_set>
+
 #include "anomaly/AnomalyTracker.h"
 #include "condition/ConditionTimer.h"
 #include "condition/ConditionTracker.h"
@@ -161,8 +164,8 @@ private:
     // Value fields for matching.
     std::vector<Matcher> mFieldMatchers;
 
-    // Value fields for matching.
-    std::set<HashableDimensionKey> mMatchedMetricDimensionKeys;
+    // Dimensions in what seen in the pull being processed.
+    std::unordered_set<HashableDimensionKey> mMatchedMetricDimensionKeys;
 
     // Holds the atom id, primary key pair from a state change.
     pair<int32_t, HashableDimensionKey> mStateChangePrimaryKey;
@@ -83,6 +83,7 @@ void MaxDurationTracker::noteStart(const HashableDimensionKey& key, bool conditi
             } else {
                 duration.state = DurationState::kStarted;
                 duration.lastStartTime = eventTime;
+                addStartedDuration(duration);
                 startAnomalyAlarm(eventTime);
             }
             duration.startCount = 1;
@@ -93,11 +94,12 @@ void MaxDurationTracker::noteStart(const HashableDimensionKey& key, bool conditi
 void MaxDurationTracker::noteStop(const HashableDimensionKey& key, const int64_t eventTime,
                                   bool forceStop) {
     VLOG("MaxDuration: key %s stop", key.toString().c_str());
-    if (mInfos.find(key) == mInfos.end()) {
+    auto it = mInfos.find(key);
+    if (it == mInfos.end()) {
         // we didn't see a start event before. do nothing.
         return;
     }
-    DurationInfo& duration = mInfos[key];
+    DurationInfo& duration = it->second;
 
     switch (duration.state) {
         case DurationState::kStopped:
@@ -107,6 +109,7 @@ void MaxDurationTracker::noteStop(const HashableDimensionKey& key, const int64_t
             duration.startCount--;
             if (forceStop || !mNested || duration.startCount <= 0) {
                 stopAnomalyAlarm(eventTime);
+                removeStartedDuration(duration);
                 duration.state = DurationState::kStopped;
                 int64_t durationTime = eventTime - duration.lastStartTime;
                 VLOG("Max, key %s, Stop %lld %lld %lld", key.toString().c_str(),
@@ -138,23 +141,30 @@ void MaxDurationTracker::noteStop(const HashableDimensionKey& key, const int64_t
     // Once an atom duration ends, we erase it. Next time, if we see another atom event with the
     // same name, they are still considered as different atom durations.
     if (duration.state == DurationState::kStopped) {
-        mInfos.erase(key);
+        mInfos.erase(it);
     }
 }
 
-bool MaxDurationTracker::anyStarted() {
-    for (auto& pair : mInfos) {
-        if (pair.second.state == kStarted) {
-            return true;
-        }
+bool MaxDurationTracker::anyStarted() const {
+    return !mStartedDurationOffsets.empty();
+}
+
+void MaxDurationTracker::addStartedDuration(const DurationInfo& duration) {
+    mStartedDurationOffsets.insert(duration.lastDuration - duration.lastStartTime);
+}
+
+void MaxDurationTracker::removeStartedDuration(const DurationInfo& duration) {
+    auto it = mStartedDurationOffsets.find(duration.lastDuration - duration.lastStartTime);
+    if (it != mStartedDurationOffsets.end()) {
+        mStartedDurationOffsets.erase(it);
     }
-    return false;
 }
 
 void MaxDurationTracker::noteStopAll(const int64_t eventTime) {
-    std::set<HashableDimensionKey> keys;
+    std::vector<HashableDimensionKey> keys;
+    keys.reserve(mInfos.size());
     for (const auto& pair : mInfos) {
-        keys.insert(pair.first);
+        keys.push_back(pair.first);
     }
     for (auto& key : keys) {
         noteStop(key, eventTime, true);
@@ -224,6 +234,9 @@ bool MaxDurationTracker::flushIfNeeded(
 void MaxDurationTracker::onSlicedConditionMayChange(bool overallCondition,
                                                     const int64_t timestamp) {
     // Now for each of the on-going event, check if the condition has changed for them.
+    // The anomaly alarm is only updated once all the durations have been updated.
+    bool anyPaused = false;
+    bool anyResumed = false;
     for (auto& pair : mInfos) {
         if (pair.second.state == kStopped) {
             continue;
@@ -234,8 +247,11 @@ void MaxDurationTracker::onSlicedConditionMayChange(bool overallCondition,
         bool conditionMet = (conditionState == ConditionState::kTrue);
 
         VLOG("key: %s, condition: %d", pair.first.toString().c_str(), conditionMet);
-        noteConditionChanged(pair.first, conditionMet, timestamp);
+        if (updateConditionState(&pair.second, conditionMet, timestamp)) {
+            (conditionMet ? anyResumed : anyPaused) = true;
+        }
     }
+    updateAnomalyAlarm(anyPaused, anyResumed, timestamp);
 }
 
 void MaxDurationTracker::onStateChanged(const int64_t timestamp, const int32_t atomId,
@@ -244,9 +260,11 @@ void MaxDurationTracker::onStateChanged(const int64_t timestamp, const int32_t a
 }
 
 void MaxDurationTracker::onConditionChanged(bool condition, const int64_t timestamp) {
+    bool anyChanged = false;
     for (auto& pair : mInfos) {
-        noteConditionChanged(pair.first, condition, timestamp);
+        anyChanged |= updateConditionState(&pair.second, condition, timestamp);
     }
+    updateAnomalyAlarm(anyChanged && !condition, anyChanged && condition, timestamp);
 }
 
 void MaxDurationTracker::noteConditionChanged(const HashableDimensionKey& key, bool conditionMet,
@@ -256,19 +274,23 @@ void MaxDurationTracker::noteConditionChanged(const HashableDimensionKey& key, b
         return;
     }
 
-    switch (it->second.state) {
+    if (updateConditionState(&it->second, conditionMet, timestamp)) {
+        VLOG("MaxDurationTracker Key: %s %s", key.toString().c_str(),
+             conditionMet ? "Paused->Started" : "Started->Paused");
+        updateAnomalyAlarm(!conditionMet, conditionMet, timestamp);
+    }
+}
+
+bool MaxDurationTracker::updateConditionState(DurationInfo* duration, bool conditionMet,
+                                              const int64_t timestamp) {
+    switch (duration->state) {
         case kStarted:
-            // If condition becomes false, kStarted -> kPaused. Record the current duration and
-            // stop anomaly alarm.
+            // If condition becomes false, kStarted -> kPaused. Record the current duration.
             if (!conditionMet) {
-                stopAnomalyAlarm(timestamp);
-                it->second.state = DurationState::kPaused;
-                it->second.lastDuration += (timestamp - it->second.lastStartTime);
-                if (anyStarted()) {
-                    // In case any other dimensions are still started, we need to set the alarm.
-                    startAnomalyAlarm(timestamp);
-                }
-                VLOG("MaxDurationTracker Key: %s Started->Paused ", key.toString().c_str());
+                removeStartedDuration(*duration);
+                duration->state = DurationState::kPaused;
+                duration->lastDuration += (timestamp - duration->lastStartTime);
+                return true;
             }
             break;
         case kStopped:
@@ -278,14 +300,29 @@ void MaxDurationTracker::noteConditionChanged(const HashableDimensionKey& key, b
             // If condition becomes true, kPaused -> kStarted. and the start time is the condition
             // change time.
             if (conditionMet) {
-                it->second.state = DurationState::kStarted;
-                it->second.lastStartTime = timestamp;
-                startAnomalyAlarm(timestamp);
-                VLOG("MaxDurationTracker Key: %s Paused->Started", key.toString().c_str());
+                duration->state = DurationState::kStarted;
+                duration->lastStartTime = timestamp;
+                addStartedDuration(*duration);
+                return true;
             }
             break;
     }
     // Note that we don't update mDuration here since it's only updated during noteStop.
+    return false;
+}
+
+void MaxDurationTracker::updateAnomalyAlarm(bool anyPaused, bool anyResumed,
+                                            const int64_t timestamp) {
+    if (anyPaused) {
+        // Stop the alarm for the paused durations. In case any other dimensions are still
+        // started, we need to set the alarm again.
+        stopAnomalyAlarm(timestamp);
+        if (anyStarted()) {
+            startAnomalyAlarm(timestamp);
+        }
+    } else if (anyResumed) {
+        startAnomalyAlarm(timestamp);
+    }
 }
 
 int64_t MaxDurationTracker::predictAnomalyTimestampNs(const DurationAnomalyTracker& anomalyTracker,
@@ -293,14 +330,8 @@ int64_t MaxDurationTracker::predictAnomalyTimestampNs(const DurationAnomalyTrack
     // The allowed time we can continue in the current state is the
     // (anomaly threshold) - max(elapsed time of the started mInfos).
     int64_t maxElapsed = 0;
-    for (auto it = mInfos.begin(); it != mInfos.end(); ++it) {
-        if (it->second.state == DurationState::kStarted) {
-            int64_t duration =
-                    it->second.lastDuration + (currentTimestamp - it->second.lastStartTime);
-            if (duration > maxElapsed) {
-                maxElapsed = duration;
-            }
-        }
+    if (!mStartedDurationOffsets.empty()) {
+        maxElapsed = std::max(maxElapsed, currentTimestamp + *mStartedDurationOffsets.rbegin());
     }
     int64_t anomalyTimeNs = currentTimestamp + anomalyTracker.getAnomalyThreshold() - maxElapsed;
     int64_t refractoryEndNs = anomalyTracker.getRefractoryPeriodEndsSec(mEventKey) * NS_PER_SEC;
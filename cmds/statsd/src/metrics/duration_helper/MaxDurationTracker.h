@@ -19,6 +19,8 @@
 
 #include "DurationTracker.h"
 
+#include <set>
+
 namespace android {
 namespace os {
 namespace statsd {
@@ -69,13 +71,30 @@ public:
 
 private:
     // Returns true if at least one of the mInfos is started.
-    bool anyStarted();
+    bool anyStarted() const;
+
+    // Must be called when a duration becomes started, and before the lastDuration or
+    // lastStartTime of a started duration change, respectively.
+    void addStartedDuration(const DurationInfo& duration);
+    void removeStartedDuration(const DurationInfo& duration);
 
     std::unordered_map<HashableDimensionKey, DurationInfo> mInfos;
 
+    // (lastDuration - lastStartTime) of every started duration in mInfos. The elapsed time of a
+    // started duration at time t is t + offset, so the longest started duration is found from
+    // the largest offset without walking mInfos.
+    std::multiset<int64_t> mStartedDurationOffsets;
+
     void noteConditionChanged(const HashableDimensionKey& key, bool conditionMet,
                               const int64_t timestamp);
 
+    // Moves the duration between kStarted and kPaused for the new condition. Returns true if the
+    // state changed. The anomaly alarm is not updated.
+    bool updateConditionState(DurationInfo* duration, bool conditionMet, const int64_t timestamp);
+
+    // Updates the anomaly alarm after some durations were paused and/or resumed.
+    void updateAnomalyAlarm(bool anyPaused, bool anyResumed, const int64_t timestamp);
+
     // return true if we should not allow newKey to be tracked because we are above the threshold
     bool hitGuardRail(const HashableDimensionKey& newKey);
 
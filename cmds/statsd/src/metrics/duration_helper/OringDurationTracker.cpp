@@ -37,6 +37,18 @@ OringDurationTracker::OringDurationTracker(
     mLastStartTime = 0;
 }
 
+void OringDurationTracker::moveAll(std::unordered_map<HashableDimensionKey, int>* from,
+                                   std::unordered_map<HashableDimensionKey, int>* to) {
+    if (to->empty()) {
+        // Every key changes state together, e.g. on an unsliced condition change. Swapping keeps
+        // the work independent of the number of keys.
+        from->swap(*to);
+    } else {
+        to->insert(from->begin(), from->end());
+    }
+    from->clear();
+}
+
 bool OringDurationTracker::hitGuardRail(const HashableDimensionKey& newKey) {
     // ===========GuardRail==============
     // 1. Report the tuple count if the tuple count > soft limit
@@ -307,16 +319,14 @@ void OringDurationTracker::onConditionChanged(bool condition, const int64_t time
             if (mStarted.empty() && !mPaused.empty()) {
                 startAnomalyAlarm(timestamp);
             }
-            mStarted.insert(mPaused.begin(), mPaused.end());
-            mPaused.clear();
+            moveAll(&mPaused, &mStarted);
         }
     } else {
         if (!mStarted.empty()) {
             VLOG("Condition false, all paused");
             mStateKeyDurationMap[mEventKey.getStateValuesKey()].mDuration +=
                     (timestamp - mLastStartTime);
-            mPaused.insert(mStarted.begin(), mStarted.end());
-            mStarted.clear();
+            moveAll(&mStarted, &mPaused);
             detectAndDeclareAnomaly(
                     timestamp, mCurrentBucketNum,
                     getCurrentStateKeyDuration() + getCurrentStateKeyFullBucketDuration());
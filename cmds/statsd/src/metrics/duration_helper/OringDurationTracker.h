@@ -78,6 +78,10 @@ private:
     // return true if we should not allow newKey to be tracked because we are above the threshold
     bool hitGuardRail(const HashableDimensionKey& newKey);
 
+    // Moves every key of |from| to |to|, leaving |from| empty.
+    static void moveAll(std::unordered_map<HashableDimensionKey, int>* from,
+                        std::unordered_map<HashableDimensionKey, int>* to);
+
     FRIEND_TEST(OringDurationTrackerTest, TestDurationOverlap);
     FRIEND_TEST(OringDurationTrackerTest, TestCrossBucketBoundary);
     FRIEND_TEST(OringDurationTrackerTest, TestDurationConditionChange);
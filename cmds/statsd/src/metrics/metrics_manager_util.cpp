@@ -281,6 +281,49 @@ bool initLogTrackers(const StatsdConfig& config, const UidMap& uidMap,
     return true;
 }
 
+void initTagIdToMatcherMap(const vector<sp<LogMatchingTracker>>& allAtomMatchers,
+                           unordered_map<int, vector<int>>& tagIdToMatcherMap) {
+    // A combination matcher's atom ids are the union of its children's, so it is listed under
+    // every atom that any of its children can match.
+    for (size_t i = 0; i < allAtomMatchers.size(); i++) {
+        for (const int tagId : allAtomMatchers[i]->getAtomIds()) {
+            tagIdToMatcherMap[tagId].push_back(i);
+        }
+    }
+}
+
+static void addConditionInEvaluationOrder(const StatsdConfig& config,
+                                          const unordered_map<int64_t, int>& conditionTrackerMap,
+                                          const int index, vector<bool>& visited,
+                                          vector<int>& conditionEvaluationOrder) {
+    if (visited[index]) {
+        return;
+    }
+    visited[index] = true;
+    const Predicate& condition = config.predicate(index);
+    if (condition.contents_case() == Predicate::ContentsCase::kCombination) {
+        for (const int64_t child : condition.combination().predicate()) {
+            const auto& it = conditionTrackerMap.find(child);
+            if (it != conditionTrackerMap.end()) {
+                addConditionInEvaluationOrder(config, conditionTrackerMap, it->second, visited,
+                                              conditionEvaluationOrder);
+            }
+        }
+    }
+    conditionEvaluationOrder.push_back(index);
+}
+
+void initConditionEvaluationOrder(const StatsdConfig& config,
+                                  const unordered_map<int64_t, int>& conditionTrackerMap,
+                                  vector<int>& conditionEvaluationOrder) {
+    vector<bool> visited(config.predicate_size(), false);
+    conditionEvaluationOrder.reserve(config.predicate_size());
+    for (int i = 0; i < config.predicate_size(); i++) {
+        addConditionInEvaluationOrder(config, conditionTrackerMap, i, visited,
+                                      conditionEvaluationOrder);
+    }
+}
+
 bool initConditions(const ConfigKey& key, const StatsdConfig& config,
                     const unordered_map<int64_t, int>& logTrackerMap,
                     unordered_map<int64_t, int>& conditionTrackerMap,
@@ -327,7 +370,14 @@ bool initConditions(const ConfigKey& key, const StatsdConfig& config,
                                     stackTracker, initialConditionCache)) {
             return false;
         }
-        for (const int trackerIndex : conditionTracker->getLogTrackerIndex()) {
+    }
+
+    // List the conditions of each log tracker children first, so that evaluating them in order
+    // finds the children of a combination condition already evaluated.
+    vector<int> conditionEvaluationOrder;
+    initConditionEvaluationOrder(config, conditionTrackerMap, conditionEvaluationOrder);
+    for (const int i : conditionEvaluationOrder) {
+        for (const int trackerIndex : allConditionTrackers[i]->getLogTrackerIndex()) {
             auto& conditionList = trackerToConditionMap[trackerIndex];
             conditionList.push_back(i);
         }
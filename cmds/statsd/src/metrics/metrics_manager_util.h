@@ -50,6 +50,27 @@ bool initLogTrackers(const StatsdConfig& config,
                      std::vector<sp<LogMatchingTracker>>& allAtomMatchers,
                      std::set<int>& allTagIds);
 
+// Index the LogMatchingTrackers by the atoms they care about.
+// input:
+// [allAtomMatchers]: the initialized LogMatchingTrackers
+// output:
+// [tagIdToMatcherMap]: contains the mapping from atom id to the indices of the matchers that can
+//                      match it, including combination matchers that depend on it, in order
+void initTagIdToMatcherMap(const std::vector<sp<LogMatchingTracker>>& allAtomMatchers,
+                           std::unordered_map<int, std::vector<int>>& tagIdToMatcherMap);
+
+// Computes an order in which to evaluate the conditions such that every combination condition
+// comes after all of its children. Requires a config whose conditions initialized successfully,
+// so that there is no cycle.
+// input:
+// [config]: the input config
+// [conditionTrackerMap]: condition name to index mapping from initConditions
+// output:
+// [conditionEvaluationOrder]: the indices of all conditions, children before their parents
+void initConditionEvaluationOrder(const StatsdConfig& config,
+                                  const std::unordered_map<int64_t, int>& conditionTrackerMap,
+                                  std::vector<int>& conditionEvaluationOrder);
+
 // Initialize ConditionTrackers
 // input:
 // [key]: the config key that this config belongs to
@@ -59,7 +80,8 @@ bool initLogTrackers(const StatsdConfig& config,
 // [conditionTrackerMap]: this map should contain condition name to index mapping
 // [allConditionTrackers]: stores the sp to all the ConditionTrackers
 // [trackerToConditionMap]: contain the mapping from index of
-//                        log tracker to condition trackers that use the log tracker
+//                        log tracker to condition trackers that use the log tracker, with
+//                        children listed before the combination conditions that use them
 // [initialConditionCache]: stores the initial conditions for each ConditionTracker
 bool initConditions(const ConfigKey& key, const StatsdConfig& config,
                     const std::unordered_map<int64_t, int>& logTrackerMap,
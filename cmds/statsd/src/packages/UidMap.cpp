@@ -23,6 +23,8 @@
 
 #include <inttypes.h>
 
+#include <algorithm>
+
 using namespace android;
 
 using android::base::StringPrintf;
@@ -94,14 +96,62 @@ std::set<string> UidMap::getAppNamesFromUid(const int32_t& uid, bool returnNorma
 
 std::set<string> UidMap::getAppNamesFromUidLocked(const int32_t& uid, bool returnNormalized) const {
     std::set<string> names;
-    for (const auto& kv : mMap) {
-        if (kv.first.first == uid && !kv.second.deleted) {
-            names.insert(returnNormalized ? normalizeAppName(kv.first.second) : kv.first.second);
+    auto it = mUidToAppNames.find(uid);
+    if (it != mUidToAppNames.end()) {
+        for (const string* name : it->second) {
+            names.insert(returnNormalized ? normalizeAppName(*name) : *name);
         }
     }
     return names;
 }
 
+bool UidMap::hasAppWithNormalizedName(const int32_t uid, const string& normalizedName) const {
+    lock_guard<mutex> lock(mMutex);
+
+    auto it = mUidToAppNames.find(uid);
+    if (it == mUidToAppNames.end()) {
+        return false;
+    }
+    for (const string* name : it->second) {
+        if (name->size() == normalizedName.size() &&
+            std::equal(name->begin(), name->end(), normalizedName.begin(),
+                       [](char a, char b) { return ::tolower(a) == b; })) {
+            return true;
+        }
+    }
+    return false;
+}
+
+void UidMap::addAppToUidIndexLocked(const std::pair<int, string>& key) {
+    auto it = mMap.find(key);
+    if (it != mMap.end()) {
+        mUidToAppNames[key.first].push_back(&it->first.second);
+    }
+}
+
+void UidMap::removeAppFromUidIndexLocked(const std::pair<int, string>& key) {
+    auto it = mUidToAppNames.find(key.first);
+    if (it == mUidToAppNames.end()) {
+        return;
+    }
+    std::vector<const string*>& names = it->second;
+    names.erase(std::remove_if(names.begin(), names.end(),
+                               [&key](const string* name) { return *name == key.second; }),
+                names.end());
+    if (names.empty()) {
+        mUidToAppNames.erase(it);
+    }
+}
+
+void UidMap::rebuildUidIndexLocked() {
+    mUidToAppNames.clear();
+    for (const auto& kv : mMap) {
+        if (!kv.second.deleted) {
+            mUidToAppNames[kv.first.first].push_back(&kv.first.second);
+        }
+    }
+}
+
 int64_t UidMap::getAppVersion(int uid, const string& packageName) const {
     lock_guard<mutex> lock(mMutex);
 
@@ -143,6 +193,7 @@ void UidMap::updateMap(const int64_t& timestamp, const vector<int32_t>& uid,
                 mMap[kv.first] = kv.second;
             }
         }
+        rebuildUidIndexLocked();
 
         ensureBytesUsedBelowLimit();
         StatsdStats::getInstance().setCurrentUidMapMemory(mBytesUsed);
@@ -169,7 +220,8 @@ void UidMap::updateApp(const int64_t& timestamp, const String16& app_16, const i
         string prevVersionString = "";
         string newVersionString = string(String8(versionString).string());
         bool found = false;
-        auto it = mMap.find(std::make_pair(uid, appName));
+        auto key = std::make_pair(uid, appName);
+        auto it = mMap.find(key);
         if (it != mMap.end()) {
             found = true;
             prevVersion = it->second.versionCode;
@@ -177,12 +229,15 @@ void UidMap::updateApp(const int64_t& timestamp, const String16& app_16, const i
             it->second.versionCode = versionCode;
             it->second.versionString = newVersionString;
             it->second.installer = string(String8(installer).string());
-            it->second.deleted = false;
+            if (it->second.deleted) {
+                it->second.deleted = false;
+                addAppToUidIndexLocked(key);
+            }
         }
         if (!found) {
             // Otherwise, we need to add an app at this uid.
-            mMap[std::make_pair(uid, appName)] =
-                    AppData(versionCode, newVersionString, string(String8(installer).string()));
+            mMap[key] = AppData(versionCode, newVersionString, string(String8(installer).string()));
+            addAppToUidIndexLocked(key);
         } else {
             // Only notify the listeners if this is an app upgrade. If this app is being installed
             // for the first time, then we don't notify the listeners.
@@ -235,12 +290,15 @@ void UidMap::removeApp(const int64_t& timestamp, const String16& app_16, const i
             prevVersion = it->second.versionCode;
             prevVersionString = it->second.versionString;
             it->second.deleted = true;
+            removeAppFromUidIndexLocked(key);
             mDeletedApps.push_back(key);
         }
         if (mDeletedApps.size() > StatsdStats::kMaxDeletedAppsInUidMap) {
-            // Delete the oldest one.
+            // Delete the oldest one. It may have been installed again since, so drop it from the
+            // index before its name goes away.
             auto oldest = mDeletedApps.front();
             mDeletedApps.pop_front();
+            removeAppFromUidIndexLocked(oldest);
             mMap.erase(oldest);
             StatsdStats::getInstance().noteUidMapAppDeletionDropped();
         }
@@ -31,6 +31,7 @@
 #include <set>
 #include <string>
 #include <unordered_map>
+#include <vector>
 
 using namespace android;
 using namespace std;
@@ -111,6 +112,10 @@ public:
     // Returns the app names from uid.
     std::set<string> getAppNamesFromUid(const int32_t& uid, bool returnNormalized) const;
 
+    // Returns true if the given uid contains an app whose normalized (lower case) name is
+    // normalizedName. Unlike getAppNamesFromUid, this does not allocate.
+    bool hasAppWithNormalizedName(const int32_t uid, const string& normalizedName) const;
+
     int64_t getAppVersion(int uid, const string& packageName) const;
 
     // Helper for debugging contents of this uid map. Can be triggered with:
@@ -168,18 +173,29 @@ private:
                                    bool includeInstaller, const std::set<int32_t>& interestingUids,
                                    std::set<string>* str_set, ProtoOutputStream* proto);
 
+    // Keep mUidToAppNames in sync with the apps in mMap that are not deleted.
+    void addAppToUidIndexLocked(const std::pair<int, string>& key);
+    void removeAppFromUidIndexLocked(const std::pair<int, string>& key);
+    void rebuildUidIndexLocked();
+
     mutable mutex mMutex;
     mutable mutex mIsolatedMutex;
 
     struct PairHash {
-        size_t operator()(std::pair<int, string> p) const noexcept {
-            std::hash<std::string> hash_fn;
-            return hash_fn(std::to_string(p.first) + p.second);
+        size_t operator()(const std::pair<int, string>& p) const noexcept {
+            // Combine the hashes rather than hashing a concatenated string, which would allocate.
+            size_t hash = std::hash<std::string>()(p.second);
+            return hash ^ (std::hash<int>()(p.first) + 0x9e3779b9 + (hash << 6) + (hash >> 2));
         }
     };
     // Maps uid and package name to application data.
     std::unordered_map<std::pair<int, string>, AppData, PairHash> mMap;
 
+    // Maps uid to the names of its apps in mMap that are not deleted, so that the apps of a uid
+    // are found without walking mMap. The names point at the keys of mMap, whose nodes are
+    // stable until they are erased.
+    std::unordered_map<int, std::vector<const string*>> mUidToAppNames;
+
     // Maps isolated uid to the parent uid. Any metrics for an isolated uid will instead contribute
     // to the parent uid.
     std::unordered_map<int, int> mIsolatedUidMap;
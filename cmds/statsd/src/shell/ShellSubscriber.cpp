@@ -20,6 +20,8 @@
 
 #include <android-base/file.h>
 
+#include <algorithm>
+
 #include "matchers/matcher_util.h"
 #include "stats_log_util.h"
 
@@ -41,11 +43,17 @@ void ShellSubscriber::startNewSubscription(int in, int out, int timeoutSec) {
 
     {
         std::unique_lock<std::mutex> lock(mMutex);
+        // Pending data of the previous subscription is for its output fd.
+        mPendingData.clear();
         mSubscriptionInfo = mySubscriptionInfo;
         spawnHelperThread(myToken);
         waitForSubscriptionToEndLocked(mySubscriptionInfo, myToken, lock, timeoutSec);
 
         if (mSubscriptionInfo == mySubscriptionInfo) {
+            if (mSubscriptionInfo->mClientAlive) {
+                flushPendingDataLocked();
+            }
+            mPendingData.clear();
             mSubscriptionInfo = nullptr;
         }
 
@@ -126,16 +134,20 @@ bool ShellSubscriber::readConfig(shared_ptr<SubscriptionInfo> subscriptionInfo)
 
 void ShellSubscriber::pullAndSendHeartbeats(int myToken) {
     VLOG("ShellSubscriber: helper thread %d starting", myToken);
+    std::unique_lock<std::mutex> lock(mMutex);
     while (true) {
         int64_t sleepTimeMs = INT_MAX;
         {
-            std::lock_guard<std::mutex> lock(mMutex);
             if (!mSubscriptionInfo || mToken != myToken) {
                 VLOG("ShellSubscriber: helper thread %d done!", myToken);
                 return;
             }
 
             int64_t nowMillis = getElapsedRealtimeMillis();
+            if (!mPendingData.empty() && nowMillis - mPendingSinceMs >= kMaxPendingDelayMs) {
+                flushPendingDataLocked();
+            }
+
             int64_t nowNanos = getElapsedRealtimeNs();
             for (PullInfo& pullInfo : mSubscriptionInfo->mPulledInfo) {
                 if (pullInfo.mPrevPullElapsedRealtimeMs + pullInfo.mInterval >= nowMillis) {
@@ -157,7 +169,7 @@ void ShellSubscriber::pullAndSendHeartbeats(int myToken) {
             // data from statsd. When it receives the data size of 0, perfd will not expect any
             // atoms and recheck whether the subscription should end.
             if (nowMillis - mLastWriteMs > kMsBetweenHeartbeats) {
-                attemptWriteToPipeLocked(/*dataSize=*/0);
+                sendHeartbeatLocked();
             }
 
             // Determine how long to sleep before doing more work.
@@ -168,11 +180,18 @@ void ShellSubscriber::pullAndSendHeartbeats(int myToken) {
             }
             int64_t timeBeforeHeartbeat = (mLastWriteMs + kMsBetweenHeartbeats) - nowMillis;
             if (timeBeforeHeartbeat < sleepTimeMs) sleepTimeMs = timeBeforeHeartbeat;
+            if (!mPendingData.empty()) {
+                int64_t timeBeforeFlush = (mPendingSinceMs + kMaxPendingDelayMs) - nowMillis;
+                if (timeBeforeFlush < sleepTimeMs) sleepTimeMs = timeBeforeFlush;
+            }
         }
 
         VLOG("ShellSubscriber: helper thread %d sleeping for %lld ms", myToken,
              (long long)sleepTimeMs);
-        std::this_thread::sleep_for(std::chrono::milliseconds(sleepTimeMs));
+        // Releases mMutex while sleeping. onLogEvent wakes us up early when it starts a new
+        // batch of pending data, so that it is flushed in time.
+        mPendingDataAvailable.wait_for(lock,
+                                       std::chrono::milliseconds(std::max<int64_t>(sleepTimeMs, 0)));
     }
 }
 
@@ -200,38 +219,55 @@ void ShellSubscriber::writePulledAtomsLocked(const vector<std::shared_ptr<LogEve
         }
     }
 
-    if (count > 0) attemptWriteToPipeLocked(mProto.size());
+    if (count > 0) {
+        // Pulled atoms are written right away, after the pushed atoms that came before them.
+        appendToPendingDataLocked();
+        flushPendingDataLocked();
+    }
 }
 
 void ShellSubscriber::onLogEvent(const LogEvent& event) {
     std::lock_guard<std::mutex> lock(mMutex);
-    if (!mSubscriptionInfo) return;
+    if (!mSubscriptionInfo || !mSubscriptionInfo->mClientAlive) return;
 
-    mProto.clear();
+    const bool hadPendingData = !mPendingData.empty();
     for (const auto& matcher : mSubscriptionInfo->mPushedMatchers) {
         if (matchesSimple(*mUidMap, matcher, event)) {
+            mProto.clear();
             uint64_t atomToken = mProto.start(util::FIELD_TYPE_MESSAGE |
                                               util::FIELD_COUNT_REPEATED | FIELD_ID_ATOM);
             event.ToProto(mProto);
             mProto.end(atomToken);
-            attemptWriteToPipeLocked(mProto.size());
+            appendToPendingDataLocked();
         }
     }
+
+    if (mPendingData.size() >= kMaxPendingBytes) {
+        flushPendingDataLocked();
+    } else if (!hadPendingData && !mPendingData.empty()) {
+        mPendingSinceMs = getElapsedRealtimeMillis();
+        mPendingDataAvailable.notify_one();
+    }
 }
 
-// Tries to write the atom encoded in mProto to the pipe. If the write fails
-// because the read end of the pipe has closed, signals to other threads that
-// the subscription should end.
-void ShellSubscriber::attemptWriteToPipeLocked(size_t dataSize) {
-    // First, write the payload size.
-    if (!android::base::WriteFully(mSubscriptionInfo->mOutputFd, &dataSize, sizeof(dataSize))) {
-        mSubscriptionInfo->mClientAlive = false;
-        mSubscriptionShouldEnd.notify_one();
+void ShellSubscriber::appendToPendingDataLocked() {
+    const size_t dataSize = mProto.size();
+    const uint8_t* sizeBytes = reinterpret_cast<const uint8_t*>(&dataSize);
+    mPendingData.insert(mPendingData.end(), sizeBytes, sizeBytes + sizeof(dataSize));
+    mProto.serializeToVector(&mPendingData);
+}
+
+void ShellSubscriber::flushPendingDataLocked() {
+    if (mPendingData.empty()) {
         return;
     }
 
-    // Then, write the payload if this is not just a heartbeat.
-    if (dataSize > 0 && !mProto.flush(mSubscriptionInfo->mOutputFd)) {
+    // The size headers and payloads are already laid out contiguously, so the whole batch is
+    // written at once.
+    const bool success = android::base::WriteFully(mSubscriptionInfo->mOutputFd,
+                                                   mPendingData.data(), mPendingData.size());
+    mPendingData.clear();
+    if (!success) {
         mSubscriptionInfo->mClientAlive = false;
         mSubscriptionShouldEnd.notify_one();
         return;
@@ -240,6 +276,13 @@ void ShellSubscriber::attemptWriteToPipeLocked(size_t dataSize) {
     mLastWriteMs = getElapsedRealtimeMillis();
 }
 
+void ShellSubscriber::sendHeartbeatLocked() {
+    const size_t dataSize = 0;
+    const uint8_t* sizeBytes = reinterpret_cast<const uint8_t*>(&dataSize);
+    mPendingData.insert(mPendingData.end(), sizeBytes, sizeBytes + sizeof(dataSize));
+    flushPendingDataLocked();
+}
+
 }  // namespace statsd
 }  // namespace os
 }  // namespace android
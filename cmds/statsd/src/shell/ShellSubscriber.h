@@ -22,6 +22,7 @@
 #include <condition_variable>
 #include <mutex>
 #include <thread>
+#include <vector>
 
 #include "external/StatsPullerManager.h"
 #include "frameworks/base/cmds/statsd/src/shell/shell_config.pb.h"
@@ -54,6 +55,11 @@ namespace statsd {
  * The stream would be in the following format:
  * |size_t|shellData proto|size_t|shellData proto|....
  *
+ * Pushed atoms are not written from the caller's thread one at a time. They are appended to a
+ * pending buffer, which is written to the output fd in one write call once it is large enough,
+ * or by the helper thread once the oldest pending atom has waited long enough. This keeps the
+ * cost of a subscription on the atom processing path to encoding the atom.
+ *
  * Only one shell subscriber is allowed at a time because each shell subscriber blocks one thread
  * until it exits.
  */
@@ -117,7 +123,15 @@ private:
 
     void getUidsForPullAtom(vector<int32_t>* uids, const PullInfo& pullInfo);
 
-    void attemptWriteToPipeLocked(size_t dataSize);
+    // Appends the ShellData encoded in mProto, preceded by its size, to mPendingData.
+    void appendToPendingDataLocked();
+
+    // Writes mPendingData to the pipe. If the write fails because the read end of the pipe has
+    // closed, signals to other threads that the subscription should end.
+    void flushPendingDataLocked();
+
+    // Sends a heartbeat, consisting of a data size of 0, along with any pending data.
+    void sendHeartbeatLocked();
 
     sp<UidMap> mUidMap;
 
@@ -129,6 +143,10 @@ private:
 
     std::condition_variable mSubscriptionShouldEnd;
 
+    // Wakes the helper thread up when mPendingData goes from empty to non-empty, so that it can
+    // flush it in time.
+    std::condition_variable mPendingDataAvailable;
+
     std::shared_ptr<SubscriptionInfo> mSubscriptionInfo = nullptr;
 
     int mToken = 0;
@@ -139,6 +157,18 @@ private:
     // when next to send a heartbeat.
     int64_t mLastWriteMs = 0;
     const int64_t kMsBetweenHeartbeats = 1000;
+
+    // Size-prefixed ShellData messages that have not been written to the pipe yet. The buffer
+    // is reused across flushes.
+    std::vector<uint8_t> mPendingData;
+
+    // When the oldest message in mPendingData was appended.
+    int64_t mPendingSinceMs = 0;
+
+    // Pending data is flushed once it reaches this size, which is well below the pipe buffer,
+    // or once the oldest message has been pending this long.
+    const size_t kMaxPendingBytes = 16 * 1024;
+    const int64_t kMaxPendingDelayMs = 50;
 };
 
 }  // namespace statsd
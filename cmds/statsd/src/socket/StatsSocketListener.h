@@ -15,8 +15,14 @@
  */
 #pragma once
 
+#include <private/android_logger.h>
+#include <sys/socket.h>
 #include <sysutils/SocketListener.h>
 #include <utils/RefBase.h>
+
+#include <memory>
+#include <vector>
+
 #include "logd/LogEventQueue.h"
 
 // DEFAULT_OVERFLOWUID is defined in linux/highuid.h, which is not part of
@@ -43,11 +49,35 @@ protected:
     virtual bool onDataAvailable(SocketClient* cli);
 
 private:
+    // Most datagrams that can be read with a single recvmmsg call.
+    static constexpr size_t kMaxMessagesPerRead = 16;
+
+    struct MessageBuffer {
+        // + 1 to ensure null terminator if MAX_PAYLOAD buffer is received
+        char data[sizeof(android_log_header_t) + LOGGER_ENTRY_MAX_PAYLOAD + 1];
+        alignas(struct cmsghdr) char control[CMSG_SPACE(sizeof(struct ucred))];
+    };
+
     static int getLogSocket();
+
+    /**
+     * Parses one received datagram, adding its LogEvent to mEvents unless it is a report of
+     * dropped events.
+     */
+    void processMessage(struct msghdr* hdr, char* buffer, ssize_t n);
+
     /**
      * Who is going to get the events when they're read.
      */
     std::shared_ptr<LogEventQueue> mQueue;
+
+    // Receive buffers, allocated once and reused for every read.
+    std::unique_ptr<MessageBuffer[]> mBuffers;
+    struct iovec mIovecs[kMaxMessagesPerRead];
+    struct mmsghdr mMessages[kMaxMessagesPerRead];
+
+    // Events parsed from the current read, pushed to the queue together.
+    std::vector<std::unique_ptr<LogEvent>> mEvents;
 };
 }  // namespace statsd
 }  // namespace os
@@ -14,13 +14,15 @@
  * limitations under the License.
  */
 
-#define DEBUG true  // STOPSHIP if true
+#define DEBUG false  // STOPSHIP if true
 #include "Log.h"
 
 #include "stats_util.h"
 
 #include "StateTracker.h"
 
+#include <algorithm>
+
 namespace android {
 namespace os {
 namespace statsd {
@@ -53,22 +55,40 @@ void StateTracker::onLogEvent(const LogEvent& event) {
 
     if (int resetState = event.getResetState(); resetState != -1) {
         VLOG("StateTracker new reset state: %d", resetState);
-        const FieldValue resetStateFieldValue(mField, Value(resetState));
-        handleReset(eventTimeNs, resetStateFieldValue);
+        handleReset(eventTimeNs, resetState);
         return;
     }
 
-    const bool nested = newState.mAnnotations.isNested();
-    StateValueInfo* stateValueInfo = &mStateMap[primaryKey];
-    updateStateForPrimaryKey(eventTimeNs, primaryKey, newState, nested, stateValueInfo);
+    const int32_t newStateValue = newState.mValue.int_value;
+    auto it = mStateMap.find(primaryKey);
+    if (it == mStateMap.end()) {
+        if (kStateUnknown == newStateValue) {
+            // The state is already kStateUnknown.
+            return;
+        }
+        it = mStateMap.emplace(primaryKey, StateValueInfo()).first;
+    }
+
+    const int32_t oldStateValue = it->second.state;
+    const bool changed = updateStateForPrimaryKey(newStateValue, newState.mAnnotations.isNested(),
+                                                  &it->second);
+    if (kStateUnknown == newStateValue) {
+        mStateMap.erase(it);
+    }
+    if (changed) {
+        notifyListeners(eventTimeNs, primaryKey, oldStateValue, newStateValue);
+    }
 }
 
 void StateTracker::registerListener(wp<StateListener> listener) {
-    mListeners.insert(listener);
+    if (std::find(mListeners.begin(), mListeners.end(), listener) == mListeners.end()) {
+        mListeners.push_back(listener);
+    }
 }
 
 void StateTracker::unregisterListener(wp<StateListener> listener) {
-    mListeners.erase(listener);
+    mListeners.erase(std::remove(mListeners.begin(), mListeners.end(), listener),
+                     mListeners.end());
 }
 
 bool StateTracker::getStateValue(const HashableDimensionKey& queryKey, FieldValue* output) const {
@@ -84,44 +104,57 @@ bool StateTracker::getStateValue(const HashableDimensionKey& queryKey, FieldValu
     return false;
 }
 
-void StateTracker::handleReset(const int64_t eventTimeNs, const FieldValue& newState) {
+void StateTracker::handleReset(const int64_t eventTimeNs, const int32_t newStateValue) {
     VLOG("StateTracker handle reset");
+    // Primary keys whose state changed, with their old state.
+    std::vector<std::pair<HashableDimensionKey, int32_t>> changes;
     for (auto& [primaryKey, stateValueInfo] : mStateMap) {
-        updateStateForPrimaryKey(eventTimeNs, primaryKey, newState,
-                                 false /* nested; treat this state change as not nested */,
-                                 &stateValueInfo);
+        const int32_t oldStateValue = stateValueInfo.state;
+        if (updateStateForPrimaryKey(newStateValue,
+                                     false /* nested; treat this state change as not nested */,
+                                     &stateValueInfo)) {
+            changes.emplace_back(primaryKey, oldStateValue);
+        }
+    }
+    if (kStateUnknown == newStateValue) {
+        mStateMap.clear();
+    }
+    if (changes.empty()) {
+        return;
+    }
+
+    // Promote the listeners once for all the primary keys.
+    const std::vector<sp<StateListener>> listeners = promoteListeners();
+    FieldValue oldState(mField, Value(kStateUnknown));
+    const FieldValue newState(mField, Value(newStateValue));
+    for (const auto& [primaryKey, oldStateValue] : changes) {
+        oldState.mValue.setInt(oldStateValue);
+        for (const sp<StateListener>& listener : listeners) {
+            listener->onStateChanged(eventTimeNs, mField.getTag(), primaryKey, oldState,
+                                     newState);
+        }
     }
 }
 
 void StateTracker::clearStateForPrimaryKey(const int64_t eventTimeNs,
                                            const HashableDimensionKey& primaryKey) {
     VLOG("StateTracker clear state for primary key");
-    const std::unordered_map<HashableDimensionKey, StateValueInfo>::iterator it =
-            mStateMap.find(primaryKey);
+    const auto it = mStateMap.find(primaryKey);
 
     // If there is no entry for the primaryKey in mStateMap, then the state is already
     // kStateUnknown.
-    const FieldValue state(mField, Value(kStateUnknown));
     if (it != mStateMap.end()) {
-        updateStateForPrimaryKey(eventTimeNs, primaryKey, state,
-                                 false /* nested; treat this state change as not nested */,
-                                 &it->second);
+        const int32_t oldStateValue = it->second.state;
+        mStateMap.erase(it);
+        if (kStateUnknown != oldStateValue) {
+            notifyListeners(eventTimeNs, primaryKey, oldStateValue, kStateUnknown);
+        }
     }
 }
 
-void StateTracker::updateStateForPrimaryKey(const int64_t eventTimeNs,
-                                            const HashableDimensionKey& primaryKey,
-                                            const FieldValue& newState, const bool nested,
+bool StateTracker::updateStateForPrimaryKey(const int32_t newStateValue, const bool nested,
                                             StateValueInfo* stateValueInfo) {
-    FieldValue oldState;
-    oldState.mField = mField;
-    oldState.mValue.setInt(stateValueInfo->state);
     const int32_t oldStateValue = stateValueInfo->state;
-    const int32_t newStateValue = newState.mValue.int_value;
-
-    if (kStateUnknown == newStateValue) {
-        mStateMap.erase(primaryKey);
-    }
 
     // Update state map for non-nested counting case.
     // Every state event triggers a state overwrite.
@@ -130,10 +163,7 @@ void StateTracker::updateStateForPrimaryKey(const int64_t eventTimeNs,
         stateValueInfo->count = 1;
 
         // Notify listeners if state has changed.
-        if (oldStateValue != newStateValue) {
-            notifyListeners(eventTimeNs, primaryKey, oldState, newState);
-        }
-        return;
+        return oldStateValue != newStateValue;
     }
 
     // Update state map for nested counting case.
@@ -147,27 +177,40 @@ void StateTracker::updateStateForPrimaryKey(const int64_t eventTimeNs,
     // must only have 2 states. There is no enforcemnt here of this requirement.
     // The atom must be logged correctly.
     if (kStateUnknown == newStateValue) {
-        if (kStateUnknown != oldStateValue) {
-            notifyListeners(eventTimeNs, primaryKey, oldState, newState);
-        }
+        return kStateUnknown != oldStateValue;
     } else if (oldStateValue == kStateUnknown) {
         stateValueInfo->state = newStateValue;
         stateValueInfo->count = 1;
-        notifyListeners(eventTimeNs, primaryKey, oldState, newState);
+        return true;
     } else if (oldStateValue == newStateValue) {
         stateValueInfo->count++;
     } else if (--stateValueInfo->count == 0) {
         stateValueInfo->state = newStateValue;
         stateValueInfo->count = 1;
-        notifyListeners(eventTimeNs, primaryKey, oldState, newState);
+        return true;
+    }
+    return false;
+}
+
+std::vector<sp<StateListener>> StateTracker::promoteListeners() const {
+    std::vector<sp<StateListener>> listeners;
+    listeners.reserve(mListeners.size());
+    for (const wp<StateListener>& l : mListeners) {
+        sp<StateListener> sl = l.promote();
+        if (sl != nullptr) {
+            listeners.push_back(std::move(sl));
+        }
     }
+    return listeners;
 }
 
 void StateTracker::notifyListeners(const int64_t eventTimeNs,
                                    const HashableDimensionKey& primaryKey,
-                                   const FieldValue& oldState, const FieldValue& newState) {
-    for (auto l : mListeners) {
-        auto sl = l.promote();
+                                   const int32_t oldStateValue, const int32_t newStateValue) {
+    const FieldValue oldState(mField, Value(oldStateValue));
+    const FieldValue newState(mField, Value(newStateValue));
+    for (const wp<StateListener>& l : mListeners) {
+        sp<StateListener> sl = l.promote();
         if (sl != nullptr) {
             sl->onStateChanged(eventTimeNs, mField.getTag(), primaryKey, oldState, newState);
         }
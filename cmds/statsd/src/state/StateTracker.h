@@ -22,6 +22,7 @@
 #include "state/StateListener.h"
 
 #include <unordered_map>
+#include <vector>
 
 namespace android {
 namespace os {
@@ -68,23 +69,28 @@ private:
     // Maps primary key to state value info
     std::unordered_map<HashableDimensionKey, StateValueInfo> mStateMap;
 
-    // Set of all StateListeners (objects listening for state changes)
-    std::set<wp<StateListener>> mListeners;
+    // All StateListeners (objects listening for state changes), without duplicates.
+    // Kept in an array, which is cheaper to walk on every state change than a set.
+    std::vector<wp<StateListener>> mListeners;
 
     // Reset all state values in map to the given state.
-    void handleReset(const int64_t eventTimeNs, const FieldValue& newState);
+    void handleReset(const int64_t eventTimeNs, const int32_t newStateValue);
 
     // Clears the state value mapped to the given primary key by setting it to kStateUnknown.
     void clearStateForPrimaryKey(const int64_t eventTimeNs, const HashableDimensionKey& primaryKey);
 
-    // Update the StateMap based on the received state value.
-    void updateStateForPrimaryKey(const int64_t eventTimeNs, const HashableDimensionKey& primaryKey,
-                                  const FieldValue& newState, const bool nested,
+    // Update the state value info based on the received state value. Returns true if the
+    // listeners need to be notified of a state change. The caller removes the entry from
+    // mStateMap if the new state is kStateUnknown.
+    bool updateStateForPrimaryKey(const int32_t newStateValue, const bool nested,
                                   StateValueInfo* stateValueInfo);
 
+    // Returns the listeners that are still alive.
+    std::vector<sp<StateListener>> promoteListeners() const;
+
     // Notify registered state listeners of state change.
     void notifyListeners(const int64_t eventTimeNs, const HashableDimensionKey& primaryKey,
-                         const FieldValue& oldState, const FieldValue& newState);
+                         const int32_t oldStateValue, const int32_t newStateValue);
 };
 
 bool getStateFieldValueFromLogEvent(const LogEvent& event, FieldValue* output);
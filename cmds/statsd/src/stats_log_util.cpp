@@ -99,6 +99,11 @@ const int FIELD_ID_MIN_BUCKET_BOUNDARY_DELAY_NS = 9;
 const int FIELD_ID_MAX_BUCKET_BOUNDARY_DELAY_NS = 10;
 const int FIELD_ID_BUCKET_UNKNOWN_CONDITION = 11;
 const int FIELD_ID_BUCKET_COUNT = 12;
+const int FIELD_ID_PROCESSING_SAMPLE_COUNT = 13;
+const int FIELD_ID_AVERAGE_PROCESSING_TIME_NS = 14;
+const int FIELD_ID_MAX_PROCESSING_TIME_NS = 15;
+const int FIELD_ID_BYTE_SIZE = 16;
+const int FIELD_ID_MAX_BYTE_SIZE = 17;
 
 namespace {
 
@@ -540,6 +545,18 @@ void writeAtomMetricStatsToStream(const std::pair<int64_t, StatsdStats::AtomMetr
                        (long long)pair.second.bucketUnknownCondition);
     protoOutput->write(FIELD_TYPE_INT64 | FIELD_ID_BUCKET_COUNT,
                        (long long)pair.second.bucketCount);
+    if (pair.second.processingSampleCount > 0) {
+        protoOutput->write(FIELD_TYPE_INT64 | FIELD_ID_PROCESSING_SAMPLE_COUNT,
+                           (long long)pair.second.processingSampleCount);
+        protoOutput->write(FIELD_TYPE_INT64 | FIELD_ID_AVERAGE_PROCESSING_TIME_NS,
+                           (long long)(pair.second.totalProcessingTimeNs /
+                                       pair.second.processingSampleCount));
+        protoOutput->write(FIELD_TYPE_INT64 | FIELD_ID_MAX_PROCESSING_TIME_NS,
+                           (long long)pair.second.maxProcessingTimeNs);
+    }
+    protoOutput->write(FIELD_TYPE_INT64 | FIELD_ID_BYTE_SIZE, (long long)pair.second.byteSize);
+    protoOutput->write(FIELD_TYPE_INT64 | FIELD_ID_MAX_BYTE_SIZE,
+                       (long long)pair.second.maxByteSize);
     protoOutput->end(token);
 }
 
@@ -24,6 +24,9 @@
 
 #include <android-base/file.h>
 #include <private/android_filesystem_config.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <zlib.h>
 #include <fstream>
 
 namespace android {
@@ -50,6 +53,18 @@ const uint32_t TRAIN_INFO_FILE_MAGIC = 0xfb7447bf;
 const int FIELD_ID_REPORTS = 2;
 
 std::mutex StorageManager::sTrainInfoMutex;
+std::atomic<bool> StorageManager::sCompressReportFiles(true);
+
+// Report files are written as gzip streams. A serialized proto never starts with these bytes,
+// since 0x1f would be a field with the invalid wire type 7, so raw files written before
+// compression was enabled are still recognized.
+const uint8_t kGzipMagic[] = {0x1f, 0x8b};
+// The gzip trailer ends with the size of the uncompressed data (modulo 2^32).
+const size_t kGzipTrailerSizeBytes = 4;
+// Favour speed: most of the win comes from writing less to slow flash.
+const int kReportCompressionLevel = Z_BEST_SPEED;
+// windowBits to make zlib emit and expect a gzip header and trailer.
+const int kGzipWindowBits = MAX_WBITS + 16;
 
 using android::base::StringPrintf;
 using std::unique_ptr;
@@ -123,6 +138,97 @@ static void parseFileName(char* name, FileName* output) {
     output->mIsHistory = (substr != nullptr && strcmp("history", substr) == 0);
 }
 
+static bool compressReport(const void* buffer, int numBytes, vector<uint8_t>* out) {
+    z_stream stream = {};
+    if (deflateInit2(&stream, kReportCompressionLevel, Z_DEFLATED, kGzipWindowBits, 8,
+                     Z_DEFAULT_STRATEGY) != Z_OK) {
+        return false;
+    }
+    out->resize(deflateBound(&stream, numBytes));
+    stream.next_in = static_cast<Bytef*>(const_cast<void*>(buffer));
+    stream.avail_in = numBytes;
+    stream.next_out = out->data();
+    stream.avail_out = out->size();
+    const bool success = deflate(&stream, Z_FINISH) == Z_STREAM_END;
+    out->resize(stream.total_out);
+    deflateEnd(&stream);
+    return success;
+}
+
+static bool isCompressedReport(const uint8_t* content, size_t size) {
+    return size > sizeof(kGzipMagic) + kGzipTrailerSizeBytes &&
+           content[0] == kGzipMagic[0] && content[1] == kGzipMagic[1];
+}
+
+static bool decompressReport(const uint8_t* content, size_t size, string* out) {
+    const uint8_t* trailer = content + size - kGzipTrailerSizeBytes;
+    const size_t uncompressedSize = trailer[0] | (trailer[1] << 8) | (trailer[2] << 16) |
+                                    ((uint32_t)trailer[3] << 24);
+    z_stream stream = {};
+    if (inflateInit2(&stream, kGzipWindowBits) != Z_OK) {
+        return false;
+    }
+    out->resize(uncompressedSize);
+    stream.next_in = const_cast<Bytef*>(content);
+    stream.avail_in = size;
+    stream.next_out = reinterpret_cast<Bytef*>(&(*out)[0]);
+    stream.avail_out = out->size();
+    const bool success = inflate(&stream, Z_FINISH) == Z_STREAM_END &&
+                         stream.total_out == uncompressedSize;
+    inflateEnd(&stream);
+    return success;
+}
+
+// Appends the report stored in fd to proto, decompressing it first if needed.
+static void appendReportFileToProto(int fd, const string& fileName, ProtoOutputStream* proto) {
+    // Map the file rather than reading it into a string, so that the report is not held
+    // in memory twice while it is copied into proto.
+    struct stat fileStat;
+    if (fstat(fd, &fileStat) != 0) {
+        ALOGE("file %s cannot be read", fileName.c_str());
+        return;
+    }
+    if (fileStat.st_size == 0) {
+        proto->write(FIELD_TYPE_MESSAGE | FIELD_COUNT_REPEATED | FIELD_ID_REPORTS, "", 0);
+        return;
+    }
+    void* content = mmap(nullptr, fileStat.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    if (content == MAP_FAILED) {
+        ALOGE("file %s cannot be mapped", fileName.c_str());
+        return;
+    }
+    const uint8_t* bytes = static_cast<const uint8_t*>(content);
+    if (isCompressedReport(bytes, fileStat.st_size)) {
+        string report;
+        if (decompressReport(bytes, fileStat.st_size, &report)) {
+            proto->write(FIELD_TYPE_MESSAGE | FIELD_COUNT_REPEATED | FIELD_ID_REPORTS,
+                         report.data(), report.size());
+        } else {
+            ALOGE("file %s is corrupted", fileName.c_str());
+        }
+    } else {
+        proto->write(FIELD_TYPE_MESSAGE | FIELD_COUNT_REPEATED | FIELD_ID_REPORTS,
+                     static_cast<const char*>(content), fileStat.st_size);
+    }
+    munmap(content, fileStat.st_size);
+}
+
+void StorageManager::writeReportFile(const char* file, const void* buffer, int numBytes) {
+    vector<uint8_t> compressed;
+    if (sCompressReportFiles && compressReport(buffer, numBytes, &compressed) &&
+        compressed.size() < (size_t)numBytes) {
+        writeFile(file, compressed.data(), compressed.size());
+        StatsdStats::getInstance().noteReportFileWritten(numBytes, compressed.size());
+    } else {
+        writeFile(file, buffer, numBytes);
+        StatsdStats::getInstance().noteReportFileWritten(numBytes, numBytes);
+    }
+}
+
+void StorageManager::setCompressReportFiles(bool compress) {
+    sCompressReportFiles = compress;
+}
+
 void StorageManager::writeFile(const char* file, const void* buffer, int numBytes) {
     int fd = open(file, O_WRONLY | O_CREAT | O_CLOEXEC, S_IRUSR | S_IWUSR);
     if (fd == -1) {
@@ -529,11 +635,7 @@ void StorageManager::appendConfigMetricsReport(const ConfigKey& key, ProtoOutput
         auto fullPathName = StringPrintf("%s/%s", STATS_DATA_DIR, fileName.c_str());
         int fd = open(fullPathName.c_str(), O_RDONLY | O_CLOEXEC);
         if (fd != -1) {
-            string content;
-            if (android::base::ReadFdToString(fd, &content)) {
-                proto->write(FIELD_TYPE_MESSAGE | FIELD_COUNT_REPEATED | FIELD_ID_REPORTS,
-                             content.c_str(), content.size());
-            }
+            appendReportFileToProto(fd, fullPathName, proto);
             close(fd);
         } else {
             ALOGE("file cannot be opened");
@@ -18,6 +18,7 @@
 #define STORAGE_MANAGER_H
 
 #include <android/util/ProtoOutputStream.h>
+#include <atomic>
 #include <utils/Log.h>
 #include <utils/RefBase.h>
 
@@ -49,6 +50,17 @@ public:
      */
     static void writeFile(const char* file, const void* buffer, int numBytes);
 
+    /**
+     * Writes a serialized ConfigMetricsReport to the specified file path, compressed unless
+     * compression is turned off. appendConfigMetricsReport reads both forms.
+     */
+    static void writeReportFile(const char* file, const void* buffer, int numBytes);
+
+    /**
+     * Turns compression of report files written from now on on or off.
+     */
+    static void setCompressReportFiles(bool compress);
+
     /**
      * Writes train info.
      */
@@ -159,6 +171,8 @@ private:
     static void printDirStats(int out, const char* path);
 
     static std::mutex sTrainInfoMutex;
+
+    static std::atomic<bool> sCompressReportFiles;
 };
 
 }  // namespace statsd
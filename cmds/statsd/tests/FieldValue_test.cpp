@@ -651,6 +651,23 @@ TEST(AtomMatcherTest, TestSubsetDimensions4) {
     EXPECT_FALSE(subsetDimensions(matchers2, matchers1));
 }
 
+TEST(AtomMatcherTest, TestMoveValue) {
+    Value str(std::string("some string"));
+    Value movedStr(std::move(str));
+    EXPECT_EQ(STRING, movedStr.getType());
+    EXPECT_EQ("some string", movedStr.str_value);
+
+    Value storage;
+    storage = Value(std::vector<uint8_t>{1, 2, 3});
+    EXPECT_EQ(STORAGE, storage.getType());
+    EXPECT_EQ(std::vector<uint8_t>({1, 2, 3}), storage.storage_value);
+
+    Value number;
+    number = Value((int64_t)7);
+    EXPECT_EQ(LONG, number.getType());
+    EXPECT_EQ(7, number.long_value);
+}
+
 }  // namespace statsd
 }  // namespace os
 }  // namespace android
@@ -129,6 +129,28 @@ TEST(HashableDimensionKeyTest, TestContainsLinkedStateValues_AllConditionsMet) {
     EXPECT_TRUE(containsLinkedStateValues(whatKey, primaryKey, mMetric2StateLinks, stateAtomId));
 }
 
+/**
+ * Test that the cached hash follows changes to the values.
+ */
+TEST(HashableDimensionKeyTest, TestHashFollowsValues) {
+    HashableDimensionKey key1;
+    getUidProcessKey(1000, &key1);
+    HashableDimensionKey key2;
+    getUidProcessKey(1001, &key2);
+    EXPECT_NE(key1.getHash(), key2.getHash());
+    EXPECT_FALSE(key1 == key2);
+
+    key2.mutableValue(0)->mValue = key1.getValues()[0].mValue;
+    EXPECT_EQ(key1.getHash(), key2.getHash());
+    EXPECT_TRUE(key1 == key2);
+
+    HashableDimensionKey copy = key1;
+    EXPECT_EQ(key1.getHash(), copy.getHash());
+    copy.addValue(key1.getValues()[0]);
+    EXPECT_NE(key1.getHash(), copy.getHash());
+    EXPECT_EQ(hashDimension(copy), copy.getHash());
+}
+
 }  // namespace statsd
 }  // namespace os
 }  // namespace android
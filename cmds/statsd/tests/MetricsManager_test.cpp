@@ -464,6 +464,62 @@ TEST(MetricsManagerTest, TestGoodConfig) {
     EXPECT_EQ(alertTrackerMap.find(kAlertId)->second, 0);
 }
 
+TEST(MetricsManagerTest, TestTagIdToMatcherMap) {
+    UidMap uidMap;
+    StatsdConfig config = buildGoodConfig();
+    AtomMatcher* eventMatcher = config.add_atom_matcher();
+    eventMatcher->set_id(StringToId("BATTERY_LOW"));
+    eventMatcher->mutable_simple_atom_matcher()->set_atom_id(21 /*BATTERY_LEVEL_CHANGED*/);
+
+    unordered_map<int64_t, int> logTrackerMap;
+    vector<sp<LogMatchingTracker>> allAtomMatchers;
+    set<int> allTagIds;
+    EXPECT_TRUE(initLogTrackers(config, uidMap, logTrackerMap, allAtomMatchers, allTagIds));
+
+    unordered_map<int, vector<int>> tagIdToMatcherMap;
+    initTagIdToMatcherMap(allAtomMatchers, tagIdToMatcherMap);
+    ASSERT_EQ(2u, tagIdToMatcherMap.size());
+    // The two screen matchers and the combination of them.
+    EXPECT_EQ(vector<int>({0, 1, 2}), tagIdToMatcherMap[2]);
+    EXPECT_EQ(vector<int>({3}), tagIdToMatcherMap[21]);
+}
+
+TEST(MetricsManagerTest, TestConditionEvaluationOrder) {
+    StatsdConfig config;
+    // The combination conditions are listed before their children.
+    Predicate outer;
+    outer.set_id(StringToId("OUTER"));
+    outer.mutable_combination()->set_operation(LogicalOperation::NOT);
+    outer.mutable_combination()->add_predicate(StringToId("INNER"));
+    *config.add_predicate() = outer;
+
+    Predicate inner;
+    inner.set_id(StringToId("INNER"));
+    inner.mutable_combination()->set_operation(LogicalOperation::OR);
+    inner.mutable_combination()->add_predicate(StringToId("SCREEN_IS_ON"));
+    inner.mutable_combination()->add_predicate(StringToId("SCREEN_IS_OFF"));
+    *config.add_predicate() = inner;
+
+    Predicate screenIsOn;
+    screenIsOn.set_id(StringToId("SCREEN_IS_ON"));
+    screenIsOn.mutable_simple_predicate()->set_start(StringToId("SCREEN_TURNED_ON"));
+    *config.add_predicate() = screenIsOn;
+
+    Predicate screenIsOff;
+    screenIsOff.set_id(StringToId("SCREEN_IS_OFF"));
+    screenIsOff.mutable_simple_predicate()->set_start(StringToId("SCREEN_TURNED_OFF"));
+    *config.add_predicate() = screenIsOff;
+
+    unordered_map<int64_t, int> conditionTrackerMap;
+    for (int i = 0; i < config.predicate_size(); i++) {
+        conditionTrackerMap[config.predicate(i).id()] = i;
+    }
+
+    vector<int> conditionEvaluationOrder;
+    initConditionEvaluationOrder(config, conditionTrackerMap, conditionEvaluationOrder);
+    EXPECT_EQ(vector<int>({2, 3, 1, 0}), conditionEvaluationOrder);
+}
+
 TEST(MetricsManagerTest, TestDimensionMetricsWithMultiTags) {
     UidMap uidMap;
     sp<StatsPullerManager> pullerManager = new StatsPullerManager();
@@ -300,6 +300,95 @@ TEST(StatsLogProcessorTest, TestOnDumpReportEraseData) {
     EXPECT_TRUE(noData);
 }
 
+TEST(StatsLogProcessorTest, TestOnDumpReportToFd) {
+    // Setup a simple config.
+    StatsdConfig config;
+    config.add_allowed_log_source("AID_ROOT");  // LogEvent defaults to UID of root.
+    auto wakelockAcquireMatcher = CreateAcquireWakelockAtomMatcher();
+    *config.add_atom_matcher() = wakelockAcquireMatcher;
+
+    auto countMetric = config.add_count_metric();
+    countMetric->set_id(123456);
+    countMetric->set_what(wakelockAcquireMatcher.id());
+    countMetric->set_bucket(FIVE_MINUTES);
+
+    ConfigKey cfgKey;
+    sp<StatsLogProcessor> processor = CreateStatsLogProcessor(1, 1, config, cfgKey);
+
+    std::vector<int> attributionUids = {111};
+    std::vector<string> attributionTags = {"App1"};
+    std::unique_ptr<LogEvent> event =
+            CreateAcquireWakelockEvent(2 /*timestamp*/, attributionUids, attributionTags, "wl1");
+    processor->OnLogEvent(event.get());
+
+    // The report written to the fd is the same as the one returned in a buffer.
+    vector<uint8_t> bytes;
+    processor->onDumpReport(cfgKey, 3, true, false /* Do NOT erase data. */, ADB_DUMP, FAST,
+                            &bytes);
+    ConfigMetricsReportList bufferOutput;
+    ASSERT_TRUE(bufferOutput.ParseFromArray(bytes.data(), bytes.size()));
+
+    TemporaryFile tmpFile;
+    processor->onDumpReport(cfgKey, 3, true, true /* DO erase data. */, ADB_DUMP, FAST,
+                            tmpFile.fd);
+    string fdBytes;
+    ASSERT_TRUE(android::base::ReadFileToString(tmpFile.path, &fdBytes));
+    ConfigMetricsReportList fdOutput;
+    ASSERT_TRUE(fdOutput.ParseFromString(fdBytes));
+
+    ASSERT_EQ(1, fdOutput.reports_size());
+    ASSERT_EQ(1, fdOutput.reports(0).metrics_size());
+    ASSERT_EQ(1, fdOutput.reports(0).metrics(0).count_metrics().data_size());
+    EXPECT_EQ(bufferOutput.reports(0).metrics(0).count_metrics().data(0).SerializeAsString(),
+              fdOutput.reports(0).metrics(0).count_metrics().data(0).SerializeAsString());
+}
+
+TEST(StatsLogProcessorTest, TestEventsHeldDuringDump) {
+    StatsdConfig config;
+    config.add_allowed_log_source("AID_ROOT");  // LogEvent defaults to UID of root.
+    auto wakelockAcquireMatcher = CreateAcquireWakelockAtomMatcher();
+    *config.add_atom_matcher() = wakelockAcquireMatcher;
+
+    auto countMetric = config.add_count_metric();
+    countMetric->set_id(123456);
+    countMetric->set_what(wakelockAcquireMatcher.id());
+    countMetric->set_bucket(FIVE_MINUTES);
+
+    ConfigKey cfgKey;
+    sp<StatsLogProcessor> processor = CreateStatsLogProcessor(1, 1, config, cfgKey);
+
+    {
+        std::lock_guard<std::mutex> lock(processor->mMetricsMutex);
+        EXPECT_NE(nullptr, processor->beginConfigDumpLocked(cfgKey));
+        EXPECT_EQ(nullptr, processor->beginConfigDumpLocked(ConfigKey(1, 54321)));
+    }
+
+    // The event is held back while the config is being dumped.
+    std::vector<int> attributionUids = {111};
+    std::vector<string> attributionTags = {"App1"};
+    std::unique_ptr<LogEvent> event =
+            CreateAcquireWakelockEvent(2 /*timestamp*/, attributionUids, attributionTags, "wl1");
+    processor->OnLogEvent(event.get());
+    ASSERT_EQ(1u, processor->mConfigsBeingDumped.size());
+    EXPECT_EQ(1u, processor->mConfigsBeingDumped[cfgKey].pendingEvents.size());
+
+    {
+        std::lock_guard<std::mutex> lock(processor->mMetricsMutex);
+        processor->endConfigDumpLocked(cfgKey, 3);
+    }
+    EXPECT_TRUE(processor->mConfigsBeingDumped.empty());
+
+    // The config got the event once the dump was done.
+    vector<uint8_t> bytes;
+    ConfigMetricsReportList output;
+    processor->onDumpReport(cfgKey, 4, true, true, ADB_DUMP, FAST, &bytes);
+    output.ParseFromArray(bytes.data(), bytes.size());
+    ASSERT_EQ(output.reports_size(), 1);
+    ASSERT_EQ(output.reports(0).metrics_size(), 1);
+    ASSERT_EQ(output.reports(0).metrics(0).count_metrics().data_size(), 1);
+    EXPECT_TRUE(processor->mConfigsBeingDumped.empty());
+}
+
 TEST(StatsLogProcessorTest, TestPullUidProviderSetOnConfigUpdate) {
     // Setup simple config key corresponding to empty config.
     sp<UidMap> m = new UidMap();
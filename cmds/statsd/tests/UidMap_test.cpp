@@ -170,6 +170,28 @@ TEST(UidMapTest, TestUpdateApp) {
     EXPECT_TRUE(name_set.find("new_app1_name") != name_set.end());
 }
 
+TEST(UidMapTest, TestHasAppWithNormalizedName) {
+    UidMap m;
+    m.updateMap(1, {1000, 1000}, {4, 5}, {String16("v4"), String16("v5")},
+                {String16("NeW_aPP1_NAmE"), String16(kApp2.c_str())},
+                {String16(""), String16("")});
+    EXPECT_TRUE(m.hasAppWithNormalizedName(1000, "new_app1_name"));
+    EXPECT_FALSE(m.hasAppWithNormalizedName(1000, "NeW_aPP1_NAmE"));
+    EXPECT_TRUE(m.hasAppWithNormalizedName(1000, kApp2));
+    EXPECT_FALSE(m.hasAppWithNormalizedName(2000, kApp2));
+
+    m.removeApp(2, String16("NeW_aPP1_NAmE"), 1000);
+    EXPECT_FALSE(m.hasAppWithNormalizedName(1000, "new_app1_name"));
+    EXPECT_TRUE(m.hasAppWithNormalizedName(1000, kApp2));
+
+    // Installing the app again brings it back.
+    m.updateApp(3, String16("NeW_aPP1_NAmE"), 1000, 6, String16("v6"), String16(""));
+    EXPECT_TRUE(m.hasAppWithNormalizedName(1000, "new_app1_name"));
+    std::set<string> name_set = m.getAppNamesFromUid(1000, false /* returnNormalized */);
+    ASSERT_EQ(2u, name_set.size());
+    EXPECT_TRUE(name_set.find("NeW_aPP1_NAmE") != name_set.end());
+}
+
 static void protoOutputStreamToUidMapping(ProtoOutputStream* proto, UidMapping* results) {
     vector<uint8_t> bytes;
     bytes.resize(proto->size());
@@ -86,6 +86,19 @@ public:
     }
 };
 
+class FakePullDataReceiver : public PullDataReceiver {
+public:
+    void onDataPulled(const vector<shared_ptr<LogEvent>>& data, bool pullSuccess,
+                      int64_t originalPullTimeNs) override {
+        mData = data;
+        mPullSuccess = pullSuccess;
+        mPullCount++;
+    }
+    vector<shared_ptr<LogEvent>> mData;
+    bool mPullSuccess = false;
+    int mPullCount = 0;
+};
+
 sp<StatsPullerManager> createPullerManagerAndRegister() {
     sp<StatsPullerManager> pullerManager = new StatsPullerManager();
     shared_ptr<FakePullAtomCallback> cb1 = SharedRefBase::make<FakePullAtomCallback>(uid1);
@@ -145,6 +158,37 @@ TEST(StatsPullerManagerTest, TestPullConfigKeyNoPullerWithUid) {
     EXPECT_FALSE(pullerManager->Pull(pullTagId2, configKey, /*timestamp =*/1, &data, true));
 }
 
+TEST(StatsPullerManagerTest, TestOnAlarmFiredPullsForEveryReceiver) {
+    sp<StatsPullerManager> pullerManager = createPullerManagerAndRegister();
+    sp<FakePullUidProvider> uidProvider = new FakePullUidProvider();
+    ConfigKey otherConfigKey(70, 67890);
+    pullerManager->RegisterPullUidProvider(configKey, uidProvider);
+    pullerManager->RegisterPullUidProvider(otherConfigKey, uidProvider);
+
+    // Both configs use the same puller for pullTagId1. No puller matches the uids of pullTagId2.
+    sp<FakePullDataReceiver> receiver1 = new FakePullDataReceiver();
+    sp<FakePullDataReceiver> receiver2 = new FakePullDataReceiver();
+    sp<FakePullDataReceiver> receiver3 = new FakePullDataReceiver();
+    const int64_t pullTimeNs = 10 * NS_PER_SEC;
+    pullerManager->RegisterReceiver(pullTagId1, configKey, receiver1, pullTimeNs, 60 * NS_PER_SEC);
+    pullerManager->RegisterReceiver(pullTagId1, otherConfigKey, receiver2, pullTimeNs,
+                                    60 * NS_PER_SEC);
+    pullerManager->RegisterReceiver(pullTagId2, configKey, receiver3, pullTimeNs,
+                                    60 * NS_PER_SEC);
+
+    pullerManager->OnAlarmFired(pullTimeNs);
+
+    for (const auto& receiver : {receiver1, receiver2}) {
+        EXPECT_EQ(1, receiver->mPullCount);
+        EXPECT_TRUE(receiver->mPullSuccess);
+        ASSERT_EQ(1, receiver->mData.size());
+        EXPECT_EQ(pullTimeNs, receiver->mData[0]->GetElapsedTimestampNs());
+        EXPECT_EQ(uid2, receiver->mData[0]->getValues()[0].mValue.int_value);
+    }
+    EXPECT_EQ(1, receiver3->mPullCount);
+    EXPECT_FALSE(receiver3->mPullSuccess);
+}
+
 }  // namespace statsd
 }  // namespace os
 }  // namespace android
\ No newline at end of file
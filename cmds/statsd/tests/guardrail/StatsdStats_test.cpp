@@ -372,6 +372,45 @@ TEST(StatsdStatsTest, TestAtomMetricsStats) {
     EXPECT_EQ(1L, atomStats2.max_bucket_boundary_delay_ns());
 }
 
+TEST(StatsdStatsTest, TestProcessingCostStats) {
+    StatsdStats stats;
+    stats.noteAtomProcessingCost(10, 100);
+    stats.noteAtomProcessingCost(10, 300);
+    stats.noteMetricProcessingCost(1000L, 50);
+    stats.noteMetricProcessingCost(1000L, 10);
+    stats.noteMetricByteSize(1000L, 2048);
+    stats.noteMetricByteSize(1000L, 1024);
+
+    vector<uint8_t> output;
+    stats.dumpStats(&output, false);
+    StatsdStatsReport report;
+    EXPECT_TRUE(report.ParseFromArray(&output[0], output.size()));
+
+    ASSERT_EQ(1, report.atom_processing_cost_size());
+    const auto& atomCost = report.atom_processing_cost(0);
+    EXPECT_EQ(10, atomCost.tag());
+    EXPECT_EQ(2L, atomCost.sample_count());
+    EXPECT_EQ(200L, atomCost.average_time_ns());
+    EXPECT_EQ(300L, atomCost.max_time_ns());
+
+    ASSERT_EQ(1, report.atom_metric_stats_size());
+    const auto& metricStats = report.atom_metric_stats(0);
+    EXPECT_EQ(1000L, metricStats.metric_id());
+    EXPECT_EQ(2L, metricStats.processing_sample_count());
+    EXPECT_EQ(30L, metricStats.average_processing_time_ns());
+    EXPECT_EQ(50L, metricStats.max_processing_time_ns());
+    EXPECT_EQ(1024L, metricStats.byte_size());
+    EXPECT_EQ(2048L, metricStats.max_byte_size());
+
+    // Atoms beyond the cap are not tracked.
+    for (int i = 0; i < StatsdStats::kMaxProcessingCostAtoms; i++) {
+        stats.noteAtomProcessingCost(100 + i, 1);
+    }
+    EXPECT_EQ((size_t)StatsdStats::kMaxProcessingCostAtoms, stats.mAtomProcessingCost.size());
+    EXPECT_EQ(stats.mAtomProcessingCost.end(),
+              stats.mAtomProcessingCost.find(100 + StatsdStats::kMaxProcessingCostAtoms - 1));
+}
+
 TEST(StatsdStatsTest, TestAnomalyMonitor) {
     StatsdStats stats;
     stats.noteRegisteredAnomalyAlarmChanged();
@@ -19,6 +19,7 @@
 #include <stdio.h>
 
 #include <thread>
+#include <vector>
 
 #include "stats_event.h"
 #include "tests/statsd_test_util.h"
@@ -106,6 +107,78 @@ TEST(LogEventQueue_test, TestSlowConsumer) {
     writer.join();
 }
 
+TEST(LogEventQueue_test, TestMultipleWriters) {
+    LogEventQueue queue(50);
+    const int kWriters = 4;
+    const int kEventsPerWriter = 100;
+    std::vector<std::thread> writers;
+    for (int w = 0; w < kWriters; w++) {
+        writers.emplace_back([&queue, w, kEventsPerWriter] {
+            for (int i = 0; i < kEventsPerWriter; i++) {
+                int64_t oldestEventNs;
+                // Retry on overflow so that every event gets through.
+                while (!queue.push(makeLogEvent(w * kEventsPerWriter + i), &oldestEventNs)) {
+                    std::this_thread::yield();
+                }
+            }
+        });
+    }
+
+    // Each writer's events come out in the order that writer pushed them.
+    std::vector<int64_t> lastEventNs(kWriters, -1);
+    std::vector<unique_ptr<LogEvent>> events;
+    int total = 0;
+    while (total < kWriters * kEventsPerWriter) {
+        events.clear();
+        size_t count = queue.waitPopBatch(&events, 16);
+        EXPECT_GE(count, 1u);
+        EXPECT_LE(count, 16u);
+        EXPECT_EQ(count, events.size());
+        for (const auto& event : events) {
+            int64_t timestampNs = event->GetElapsedTimestampNs();
+            int writer = timestampNs / kEventsPerWriter;
+            EXPECT_GT(timestampNs, lastEventNs[writer]);
+            lastEventNs[writer] = timestampNs;
+            total++;
+        }
+    }
+
+    for (auto& writer : writers) {
+        writer.join();
+    }
+    EXPECT_EQ(kWriters * kEventsPerWriter, total);
+}
+
+TEST(LogEventQueue_test, TestPushBatch) {
+    LogEventQueue queue(4);
+    std::vector<unique_ptr<LogEvent>> events;
+    for (int i = 0; i < 6; i++) {
+        events.push_back(makeLogEvent(i));
+    }
+
+    // Only the events that fit are pushed, and the rest stay in the batch.
+    int64_t oldestEventNs = -1;
+    EXPECT_EQ(4u, queue.pushBatch(&events, &oldestEventNs));
+    ASSERT_EQ(2u, events.size());
+    EXPECT_EQ(4, events[0]->GetElapsedTimestampNs());
+    EXPECT_EQ(5, events[1]->GetElapsedTimestampNs());
+
+    EXPECT_EQ(0u, queue.pushBatch(&events, &oldestEventNs));
+    EXPECT_EQ(0, oldestEventNs);
+    EXPECT_EQ(2u, events.size());
+
+    EXPECT_EQ(0, queue.waitPop()->GetElapsedTimestampNs());
+    EXPECT_EQ(1u, queue.pushBatch(&events, &oldestEventNs));
+    ASSERT_EQ(1u, events.size());
+    EXPECT_EQ(5, events[0]->GetElapsedTimestampNs());
+
+    std::vector<unique_ptr<LogEvent>> popped;
+    EXPECT_EQ(4u, queue.waitPopBatch(&popped, 16));
+    for (int i = 0; i < 4; i++) {
+        EXPECT_EQ(i + 1, popped[i]->GetElapsedTimestampNs());
+    }
+}
+
 #else
 GTEST_LOG_(INFO) << "This test does nothing.\n";
 #endif
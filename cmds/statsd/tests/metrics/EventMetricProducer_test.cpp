@@ -47,6 +47,27 @@ void makeLogEvent(LogEvent* logEvent, int32_t atomId, int64_t timestampNs, strin
 
     parseStatsEventToLogEvent(statsEvent, logEvent);
 }
+
+void makeMixedLogEvent(LogEvent* logEvent, int32_t atomId, int64_t timestampNs, string str) {
+    AStatsEvent* statsEvent = AStatsEvent_obtain();
+    AStatsEvent_setAtomId(statsEvent, atomId);
+    AStatsEvent_overwriteTimestamp(statsEvent, timestampNs);
+    AStatsEvent_writeInt32(statsEvent, -5);
+    AStatsEvent_writeInt64(statsEvent, timestampNs);
+    AStatsEvent_writeString(statsEvent, str.c_str());
+    AStatsEvent_writeFloat(statsEvent, 1.5f);
+    AStatsEvent_writeBool(statsEvent, true);
+
+    parseStatsEventToLogEvent(statsEvent, logEvent);
+}
+
+StatsLogReport dumpReport(EventMetricProducer* producer, int64_t dumpTimeNs) {
+    ProtoOutputStream output;
+    std::set<string> strSet;
+    producer->onDumpReport(dumpTimeNs, true /*include current partial bucket*/,
+                           true /*erase data*/, FAST, &strSet, &output);
+    return outputStreamToProto(&output);
+}
 }  // anonymous namespace
 
 TEST(EventMetricProducerTest, TestNoCondition) {
@@ -174,6 +195,83 @@ TEST(EventMetricProducerTest, TestEventsWithSlicedCondition) {
     EXPECT_EQ(bucketStartTimeNs + 10, report.event_metrics().data(0).elapsed_timestamp_nanos());
 }
 
+TEST(EventMetricProducerTest, TestCompactStorageMatchesProtoStorage) {
+    int64_t bucketStartTimeNs = 10000000000;
+
+    EventMetric metric;
+    metric.set_id(1);
+    EventMetric compactMetric = metric;
+    compactMetric.set_use_compact_storage(true);
+
+    sp<MockConditionWizard> wizard = new NaggyMock<MockConditionWizard>();
+    EventMetricProducer protoProducer(kConfigKey, metric, -1 /*no condition*/, {}, wizard,
+                                      bucketStartTimeNs);
+    EventMetricProducer compactProducer(kConfigKey, compactMetric, -1 /*no condition*/, {},
+                                        wizard, bucketStartTimeNs);
+
+    for (int i = 0; i < 10; i++) {
+        LogEvent event(/*uid=*/0, /*pid=*/0);
+        makeMixedLogEvent(&event, 1 /*tagId*/, bucketStartTimeNs + i, i % 2 ? "odd" : "even");
+        protoProducer.onMatchedLogEvent(1 /*matcher index*/, event);
+        compactProducer.onMatchedLogEvent(1 /*matcher index*/, event);
+    }
+    // Two distinct strings are stored once each.
+    EXPECT_LT(compactProducer.byteSizeLocked(), protoProducer.byteSizeLocked());
+
+    StatsLogReport protoReport = dumpReport(&protoProducer, bucketStartTimeNs + 20);
+    StatsLogReport compactReport = dumpReport(&compactProducer, bucketStartTimeNs + 20);
+    ASSERT_EQ(10, compactReport.event_metrics().data_size());
+    EXPECT_EQ(protoReport.event_metrics().SerializeAsString(),
+              compactReport.event_metrics().SerializeAsString());
+
+    // Data is erased by the dump.
+    EXPECT_FALSE(dumpReport(&compactProducer, bucketStartTimeNs + 30).has_event_metrics());
+}
+
+TEST(EventMetricProducerTest, TestCompactStorageOverflow) {
+    int64_t bucketStartTimeNs = 10000000000;
+
+    EventMetric metric;
+    metric.set_id(1);
+    metric.set_use_compact_storage(true);
+
+    sp<MockConditionWizard> wizard = new NaggyMock<MockConditionWizard>();
+
+    // Measure a single event to size the store for exactly three of them.
+    EventMetricProducer probe(kConfigKey, metric, -1 /*no condition*/, {}, wizard,
+                              bucketStartTimeNs);
+    LogEvent probeEvent(/*uid=*/0, /*pid=*/0);
+    makeLogEvent(&probeEvent, 1 /*tagId*/, bucketStartTimeNs, "a");
+    probe.onMatchedLogEvent(1 /*matcher index*/, probeEvent);
+    const size_t singleEventBytes = probe.byteSizeLocked() - 1;  // Minus the interned "a".
+    metric.set_max_compact_storage_bytes(singleEventBytes * 3 + 1);
+
+    EventMetricProducer dropOldest(kConfigKey, metric, -1 /*no condition*/, {}, wizard,
+                                   bucketStartTimeNs);
+    metric.set_storage_overflow_policy(EventMetric::DROP_NEWEST);
+    EventMetricProducer dropNewest(kConfigKey, metric, -1 /*no condition*/, {}, wizard,
+                                   bucketStartTimeNs);
+
+    for (int i = 1; i <= 5; i++) {
+        LogEvent event(/*uid=*/0, /*pid=*/0);
+        makeLogEvent(&event, 1 /*tagId*/, bucketStartTimeNs + i, "a");
+        dropOldest.onMatchedLogEvent(1 /*matcher index*/, event);
+        dropNewest.onMatchedLogEvent(1 /*matcher index*/, event);
+    }
+    EXPECT_EQ(2u, dropOldest.mDroppedEventCount);
+    EXPECT_EQ(2u, dropNewest.mDroppedEventCount);
+
+    StatsLogReport report = dumpReport(&dropOldest, bucketStartTimeNs + 20);
+    ASSERT_EQ(3, report.event_metrics().data_size());
+    EXPECT_EQ(bucketStartTimeNs + 3, report.event_metrics().data(0).elapsed_timestamp_nanos());
+    EXPECT_EQ(bucketStartTimeNs + 5, report.event_metrics().data(2).elapsed_timestamp_nanos());
+
+    report = dumpReport(&dropNewest, bucketStartTimeNs + 20);
+    ASSERT_EQ(3, report.event_metrics().data_size());
+    EXPECT_EQ(bucketStartTimeNs + 1, report.event_metrics().data(0).elapsed_timestamp_nanos());
+    EXPECT_EQ(bucketStartTimeNs + 3, report.event_metrics().data(2).elapsed_timestamp_nanos());
+}
+
 }  // namespace statsd
 }  // namespace os
 }  // namespace android
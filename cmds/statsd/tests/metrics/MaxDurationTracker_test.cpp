@@ -416,6 +416,60 @@ TEST(MaxDurationTrackerTest, TestAnomalyPredictedTimestamp_UpdatedOnStop) {
               (unsigned long long)(alarm->timestampSec * NS_PER_SEC));
 }
 
+// Suppose that within one tracker there are two dimensions A and B, both started. When the
+// condition turns false and then true again, the anomaly alarm must be based on the longest
+// elapsed duration, and updated again once that dimension stops.
+TEST(MaxDurationTrackerTest, TestAnomalyPredictedTimestamp_ConditionChange) {
+    sp<MockConditionWizard> wizard = new NaggyMock<MockConditionWizard>();
+
+    MetricDimensionKey eventKey = getMockedMetricDimensionKey(TagId, 2, "maps");
+
+    int64_t bucketSizeNs = 30 * 1000 * 1000 * 1000LL;
+    int64_t bucketStartTimeNs = 10000000000;
+    int64_t bucketNum = 0;
+    int64_t eventStartTimeNs1 = bucketStartTimeNs + 5 * NS_PER_SEC;
+    int64_t eventStartTimeNs2 = bucketStartTimeNs + 8 * NS_PER_SEC;
+    int64_t conditionStopsNs = bucketStartTimeNs + 13 * NS_PER_SEC;
+    int64_t conditionStartsNs = bucketStartTimeNs + 20 * NS_PER_SEC;
+    int64_t eventStopTimeNs1 = bucketStartTimeNs + 22 * NS_PER_SEC;
+
+    int64_t metricId = 1;
+    Alert alert;
+    alert.set_id(101);
+    alert.set_metric_id(1);
+    alert.set_trigger_if_sum_gt(40 * NS_PER_SEC);
+    alert.set_num_buckets(2);
+    alert.set_refractory_period_secs(45);
+    sp<AlarmMonitor> alarmMonitor;
+    sp<DurationAnomalyTracker> anomalyTracker =
+        new DurationAnomalyTracker(alert, kConfigKey, alarmMonitor);
+    MaxDurationTracker tracker(kConfigKey, metricId, eventKey, wizard, 1, false, bucketStartTimeNs,
+                               bucketNum, bucketStartTimeNs, bucketSizeNs, false, false,
+                               {anomalyTracker});
+
+    tracker.noteStart(key1, true, eventStartTimeNs1, ConditionKey());
+    tracker.noteStart(key2, true, eventStartTimeNs2, ConditionKey());
+    ASSERT_EQ(1U, anomalyTracker->mAlarms.size());
+
+    // Both durations are paused, so there is nothing to alarm on.
+    tracker.onConditionChanged(false, conditionStopsNs);
+    EXPECT_EQ(0U, anomalyTracker->mAlarms.size());
+
+    // key1 has been started for 8 seconds, key2 for 5 seconds.
+    tracker.onConditionChanged(true, conditionStartsNs);
+    ASSERT_EQ(1U, anomalyTracker->mAlarms.size());
+    auto alarm = anomalyTracker->mAlarms.begin()->second;
+    EXPECT_EQ(conditionStartsNs + 32 * NS_PER_SEC,
+              (unsigned long long)(alarm->timestampSec * NS_PER_SEC));
+
+    // key2 has now been started for 7 seconds.
+    tracker.noteStop(key1, eventStopTimeNs1, false);
+    ASSERT_EQ(1U, anomalyTracker->mAlarms.size());
+    alarm = anomalyTracker->mAlarms.begin()->second;
+    EXPECT_EQ(eventStopTimeNs1 + 33 * NS_PER_SEC,
+              (unsigned long long)(alarm->timestampSec * NS_PER_SEC));
+}
+
 }  // namespace statsd
 }  // namespace os
 }  // namespace android
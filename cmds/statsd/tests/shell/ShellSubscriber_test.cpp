@@ -142,6 +142,61 @@ TEST(ShellSubscriberTest, testPushedSubscription) {
     runShellTest(config, uidMap, pullerManager, pushedList, shellData);
 }
 
+// Pushed atoms are batched before being written. Make sure every atom still arrives, in order,
+// each as its own size-prefixed ShellData.
+TEST(ShellSubscriberTest, testPushedSubscriptionBatched) {
+    sp<MockUidMap> uidMap = new NaggyMock<MockUidMap>();
+    sp<MockStatsPullerManager> pullerManager = new StrictMock<MockStatsPullerManager>();
+
+    int fds_config[2];
+    ASSERT_EQ(0, pipe(fds_config));
+    int fds_data[2];
+    ASSERT_EQ(0, pipe(fds_data));
+
+    ShellSubscription config;
+    config.add_pushed()->set_atom_id(29);
+    size_t bufferSize = config.ByteSize();
+    write(fds_config[1], &bufferSize, sizeof(bufferSize));
+    vector<uint8_t> buffer(bufferSize);
+    config.SerializeToArray(&buffer[0], bufferSize);
+    write(fds_config[1], buffer.data(), bufferSize);
+    close(fds_config[1]);
+
+    sp<ShellSubscriber> shellClient = new ShellSubscriber(uidMap, pullerManager);
+    std::thread reader([&shellClient, &fds_config, &fds_data] {
+        shellClient->startNewSubscription(fds_config[0], fds_data[1], /*timeoutSec=*/-1);
+    });
+    reader.detach();
+    std::this_thread::sleep_for(100ms);
+
+    const vector<::android::view::DisplayStateEnum> states = {
+            ::android::view::DisplayStateEnum::DISPLAY_STATE_ON,
+            ::android::view::DisplayStateEnum::DISPLAY_STATE_OFF,
+            ::android::view::DisplayStateEnum::DISPLAY_STATE_DOZE};
+    for (size_t i = 0; i < states.size(); i++) {
+        std::unique_ptr<LogEvent> event = CreateScreenStateChangedEvent(1000 + i, states[i]);
+        shellClient->onLogEvent(*event);
+    }
+
+    size_t received = 0;
+    while (received < states.size()) {
+        // Skip heartbeats.
+        size_t dataSize = 0;
+        ASSERT_EQ((int)sizeof(dataSize), read(fds_data[0], &dataSize, sizeof(dataSize)));
+        if (dataSize == 0) continue;
+
+        vector<uint8_t> dataBuffer(dataSize);
+        ASSERT_EQ((int)dataSize, read(fds_data[0], dataBuffer.data(), dataSize));
+        ShellData receivedData;
+        ASSERT_TRUE(receivedData.ParseFromArray(dataBuffer.data(), dataSize));
+        ASSERT_EQ(1, receivedData.atom_size());
+        EXPECT_EQ(states[received], receivedData.atom(0).screen_state_changed().state());
+        received++;
+    }
+
+    close(fds_data[0]);
+}
+
 namespace {
 
 int kUid1 = 1000;
@@ -237,6 +237,26 @@ TEST(StateTrackerTest, TestUnregisterListener) {
     EXPECT_EQ(-1, mgr.getListenersCount(util::SCREEN_STATE_CHANGED));
 }
 
+/**
+ * Test that a listener registered more than once is only notified once per state change,
+ * and that listeners which have been destroyed are skipped.
+ */
+TEST(StateTrackerTest, TestNotifyListenersOnce) {
+    sp<TestStateListener> listener1 = new TestStateListener();
+    sp<TestStateListener> listener2 = new TestStateListener();
+    StateManager mgr;
+    mgr.registerListener(util::SCREEN_STATE_CHANGED, listener1);
+    mgr.registerListener(util::SCREEN_STATE_CHANGED, listener1);
+    mgr.registerListener(util::SCREEN_STATE_CHANGED, listener2);
+    listener2.clear();
+
+    std::unique_ptr<LogEvent> event = CreateScreenStateChangedEvent(
+            timestampNs, android::view::DisplayStateEnum::DISPLAY_STATE_ON);
+    mgr.onLogEvent(*event);
+    ASSERT_EQ(1, listener1->updates.size());
+    EXPECT_EQ(android::view::DisplayStateEnum::DISPLAY_STATE_ON, listener1->updates[0].mState);
+}
+
 /**
  * Test a binary state atom with nested counting.
  *
@@ -16,6 +16,7 @@
 #include <gmock/gmock.h>
 #include <gtest/gtest.h>
 #include <stdio.h>
+#include "frameworks/base/cmds/statsd/src/stats_log.pb.h"
 #include "src/storage/StorageManager.h"
 
 #ifdef __ANDROID__
@@ -196,6 +197,44 @@ TEST(StorageManagerTest, AppendConfigReportTest4) {
     clearLocalHistoryTestFiles();
 }
 
+TEST(StorageManagerTest, ReportFileReadWriteTest) {
+    ConfigMetricsReport report;
+    report.set_last_report_elapsed_nanos(1);
+    report.set_current_report_elapsed_nanos(2);
+    for (int i = 0; i < 100; i++) {
+        report.add_strings("string that compresses well");
+    }
+    string reportBytes;
+    report.SerializeToString(&reportBytes);
+
+    const ConfigKey key(1066, 2);
+    for (bool compress : {true, false}) {
+        StorageManager::setCompressReportFiles(compress);
+        string fileName = StorageManager::getDataFileName(1000, key.GetUid(), key.GetId());
+        StorageManager::writeReportFile(fileName.c_str(), reportBytes.data(), reportBytes.size());
+
+        string fileContent;
+        ASSERT_TRUE(StorageManager::readFileToString(fileName.c_str(), &fileContent));
+        if (compress) {
+            EXPECT_LT(fileContent.size(), reportBytes.size());
+        } else {
+            EXPECT_EQ(reportBytes, fileContent);
+        }
+
+        ProtoOutputStream out;
+        StorageManager::appendConfigMetricsReport(key, &out, true /*erase?*/, true /*isAdb?*/);
+        EXPECT_FALSE(fileExist(fileName));
+
+        string outBytes;
+        ASSERT_TRUE(out.serializeToString(&outBytes));
+        ConfigMetricsReportList reports;
+        ASSERT_TRUE(reports.ParseFromString(outBytes));
+        ASSERT_EQ(1, reports.reports_size());
+        EXPECT_EQ(reportBytes, reports.reports(0).SerializeAsString());
+    }
+    StorageManager::setCompressReportFiles(true);
+}
+
 }  // namespace statsd
 }  // namespace os
 }  // namespace android
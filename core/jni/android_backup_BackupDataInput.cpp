@@ -113,6 +113,24 @@ readEntityData_native(JNIEnv* env, jobject clazz, jlong r, jbyteArray data, jint
     return err;
 }
 
+static jint
+readEntityDataDirect_native(JNIEnv* env, jobject clazz, jlong r, jobject buffer, jint offset,
+        jint size)
+{
+    BackupDataReader* reader = (BackupDataReader*)r;
+
+    jbyte* dataBytes = (jbyte*)env->GetDirectBufferAddress(buffer);
+    if (dataBytes == NULL) {
+        return -2;
+    }
+    if (env->GetDirectBufferCapacity(buffer) < (jlong)offset + size) {
+        // size mismatch
+        return -1;
+    }
+
+    return reader->ReadEntityData(dataBytes + offset, size);
+}
+
 static jint
 skipEntityData_native(JNIEnv* env, jobject clazz, jlong r)
 {
@@ -130,6 +148,8 @@ static const JNINativeMethod g_methods[] = {
     { "readNextHeader_native", "(JLandroid/app/backup/BackupDataInput$EntityHeader;)I",
             (void*)readNextHeader_native },
     { "readEntityData_native", "(J[BII)I", (void*)readEntityData_native },
+    { "readEntityDataDirect_native", "(JLjava/nio/ByteBuffer;II)I",
+            (void*)readEntityDataDirect_native },
     { "skipEntityData_native", "(J)I", (void*)skipEntityData_native },
 };
 
@@ -82,6 +82,20 @@ writeEntityData_native(JNIEnv* env, jobject clazz, jlong w, jbyteArray data, jin
     return (jint)err;
 }
 
+static jint
+writeEntityDataDirect_native(JNIEnv* env, jobject clazz, jlong w, jobject buffer, jint offset,
+        jint size)
+{
+    BackupDataWriter* writer = (BackupDataWriter*)w;
+
+    jbyte* dataBytes = (jbyte*)env->GetDirectBufferAddress(buffer);
+    if (dataBytes == NULL || env->GetDirectBufferCapacity(buffer) < (jlong)offset + size) {
+        return -1;
+    }
+
+    return (jint)writer->WriteEntityData(dataBytes + offset, size);
+}
+
 static void
 setKeyPrefix_native(JNIEnv* env, jobject clazz, jlong w, jstring keyPrefixObj)
 {
@@ -100,6 +114,8 @@ static const JNINativeMethod g_methods[] = {
     { "dtor", "(J)V", (void*)dtor_native },
     { "writeEntityHeader_native", "(JLjava/lang/String;I)I", (void*)writeEntityHeader_native },
     { "writeEntityData_native", "(J[BI)I", (void*)writeEntityData_native },
+    { "writeEntityDataDirect_native", "(JLjava/nio/ByteBuffer;II)I",
+            (void*)writeEntityDataDirect_native },
     { "setKeyPrefix_native", "(JLjava/lang/String;)V", (void*)setKeyPrefix_native },
 };
 
@@ -43,8 +43,8 @@ static void android_content_res_ObbScanner_getObbInfo(JNIEnv* env, jobject clazz
 {
     const char* filePath = env->GetStringUTFChars(file, NULL);
 
-    sp<ObbFile> obb = new ObbFile();
-    if (!obb->readFrom(filePath)) {
+    sp<ObbFile> obb = ObbFile::readCached(filePath, false /* wantDigest */);
+    if (obb == NULL) {
         env->ReleaseStringUTFChars(file, filePath);
         jniThrowException(env, "java/io/IOException", "Could not read OBB file");
         return;
@@ -73,6 +73,27 @@ static void android_content_res_ObbScanner_getObbInfo(JNIEnv* env, jobject clazz
     }
 }
 
+static jbyteArray android_content_res_ObbScanner_getObbDigest(JNIEnv* env, jobject clazz,
+        jstring file)
+{
+    const char* filePath = env->GetStringUTFChars(file, NULL);
+
+    sp<ObbFile> obb = ObbFile::readCached(filePath, true /* wantDigest */);
+    env->ReleaseStringUTFChars(file, filePath);
+    if (obb == NULL) {
+        jniThrowException(env, "java/io/IOException", "Could not hash OBB file");
+        return NULL;
+    }
+
+    size_t digestLen;
+    const unsigned char* digest = obb->getDigest(&digestLen);
+    jbyteArray digestArray = env->NewByteArray(digestLen);
+    if (digestArray != NULL) {
+        env->SetByteArrayRegion(digestArray, 0, digestLen, (jbyte*)digest);
+    }
+    return digestArray;
+}
+
 /*
  * JNI registration.
  */
@@ -80,6 +101,8 @@ static const JNINativeMethod gMethods[] = {
     /* name, signature, funcPtr */
     { "getObbInfo_native", "(Ljava/lang/String;Landroid/content/res/ObbInfo;)V",
             (void*) android_content_res_ObbScanner_getObbInfo },
+    { "getObbDigest_native", "(Ljava/lang/String;)[B",
+            (void*) android_content_res_ObbScanner_getObbDigest },
 };
 
 int register_android_content_res_ObbScanner(JNIEnv* env)
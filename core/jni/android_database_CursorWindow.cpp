@@ -90,7 +90,7 @@ static jlong nativeCreate(JNIEnv* env, jclass clazz, jstring nameObj, jint curso
     env->ReleaseStringUTFChars(nameObj, nameStr);
 
     CursorWindow* window;
-    status_t status = CursorWindow::create(name, cursorWindowSize, &window);
+    status_t status = CursorWindow::createPooled(name, cursorWindowSize, &window);
     if (status || !window) {
         jniThrowExceptionFmt(env,
                 "android/database/CursorWindowAllocationException",
@@ -125,7 +125,7 @@ static void nativeDispose(JNIEnv* env, jclass clazz, jlong windowPtr) {
     CursorWindow* window = reinterpret_cast<CursorWindow*>(windowPtr);
     if (window) {
         LOG_WINDOW("Closing window %p", window);
-        delete window;
+        CursorWindow::recycle(window);
     }
 }
 
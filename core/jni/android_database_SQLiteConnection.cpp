@@ -30,6 +30,8 @@
 #include <string.h>
 #include <unistd.h>
 
+#include <vector>
+
 #include <androidfw/CursorWindow.h>
 
 #include <sqlite3.h>
@@ -66,6 +68,21 @@ static struct {
     jmethodID apply;
 } gBinaryOperator;
 
+// Classes and methods used to bind boxed Java arguments without calling back
+// into SQLiteConnection.bindArguments() for each one.
+static struct {
+    jclass stringClass;
+    jclass byteArrayClass;
+    jclass floatClass;
+    jclass doubleClass;
+    jclass numberClass;
+    jclass booleanClass;
+    jmethodID longValue;
+    jmethodID doubleValue;
+    jmethodID booleanValue;
+    jmethodID toString;
+} gBindArgs;
+
 struct SQLiteConnection {
     // Open flags.
     // Must be kept in sync with the constants defined in SQLiteDatabase.java.
@@ -442,6 +459,15 @@ static jstring nativeGetColumnName(JNIEnv* env, jclass clazz, jlong connectionPt
     return NULL;
 }
 
+static int bindText(JNIEnv* env, sqlite3_stmt* statement, int index, jstring valueString) {
+    jsize valueLength = env->GetStringLength(valueString);
+    const jchar* value = env->GetStringCritical(valueString, NULL);
+    int err = sqlite3_bind_text16(statement, index, value, valueLength * sizeof(jchar),
+            SQLITE_TRANSIENT);
+    env->ReleaseStringCritical(valueString, value);
+    return err;
+}
+
 static void nativeBindNull(JNIEnv* env, jclass clazz, jlong connectionPtr,
         jlong statementPtr, jint index) {
     SQLiteConnection* connection = reinterpret_cast<SQLiteConnection*>(connectionPtr);
@@ -480,11 +506,7 @@ static void nativeBindString(JNIEnv* env, jclass clazz, jlong connectionPtr,
     SQLiteConnection* connection = reinterpret_cast<SQLiteConnection*>(connectionPtr);
     sqlite3_stmt* statement = reinterpret_cast<sqlite3_stmt*>(statementPtr);
 
-    jsize valueLength = env->GetStringLength(valueString);
-    const jchar* value = env->GetStringCritical(valueString, NULL);
-    int err = sqlite3_bind_text16(statement, index, value, valueLength * sizeof(jchar),
-            SQLITE_TRANSIENT);
-    env->ReleaseStringCritical(valueString, value);
+    int err = bindText(env, statement, index, valueString);
     if (err != SQLITE_OK) {
         throw_sqlite3_exception(env, connection->db, NULL);
     }
@@ -504,6 +526,79 @@ static void nativeBindBlob(JNIEnv* env, jclass clazz, jlong connectionPtr,
     }
 }
 
+// Binds one boxed argument, following the type rules of
+// SQLiteConnection.bindArguments(): floating point numbers bind as doubles,
+// other numbers and booleans as longs, byte[] as a blob and anything else as
+// its string form.
+static int bindArgument(JNIEnv* env, sqlite3_stmt* statement, int index, jobject arg) {
+    if (arg == NULL) {
+        return sqlite3_bind_null(statement, index);
+    }
+    if (env->IsInstanceOf(arg, gBindArgs.stringClass)) {
+        return bindText(env, statement, index, static_cast<jstring>(arg));
+    }
+    if (env->IsInstanceOf(arg, gBindArgs.byteArrayClass)) {
+        jbyteArray valueArray = static_cast<jbyteArray>(arg);
+        jsize valueLength = env->GetArrayLength(valueArray);
+        jbyte* value = static_cast<jbyte*>(env->GetPrimitiveArrayCritical(valueArray, NULL));
+        int err = sqlite3_bind_blob(statement, index, value, valueLength, SQLITE_TRANSIENT);
+        env->ReleasePrimitiveArrayCritical(valueArray, value, JNI_ABORT);
+        return err;
+    }
+    if (env->IsInstanceOf(arg, gBindArgs.floatClass)
+            || env->IsInstanceOf(arg, gBindArgs.doubleClass)) {
+        return sqlite3_bind_double(statement, index,
+                env->CallDoubleMethod(arg, gBindArgs.doubleValue));
+    }
+    if (env->IsInstanceOf(arg, gBindArgs.numberClass)) {
+        return sqlite3_bind_int64(statement, index, env->CallLongMethod(arg, gBindArgs.longValue));
+    }
+    if (env->IsInstanceOf(arg, gBindArgs.booleanClass)) {
+        return sqlite3_bind_int64(statement, index,
+                env->CallBooleanMethod(arg, gBindArgs.booleanValue) ? 1 : 0);
+    }
+
+    jstring valueString = static_cast<jstring>(env->CallObjectMethod(arg, gBindArgs.toString));
+    if (env->ExceptionCheck() || valueString == NULL) {
+        return SQLITE_MISUSE;
+    }
+    int err = bindText(env, statement, index, valueString);
+    env->DeleteLocalRef(valueString);
+    return err;
+}
+
+// Binds args[offset, offset + count) to parameters 1..count.  Returns false
+// with an exception pending on failure.
+static bool bindArguments(JNIEnv* env, SQLiteConnection* connection, sqlite3_stmt* statement,
+        jobjectArray args, jsize offset, jsize count) {
+    for (jsize i = 0; i < count; i++) {
+        jobject arg = env->GetObjectArrayElement(args, offset + i);
+        int err = bindArgument(env, statement, i + 1, arg);
+        env->DeleteLocalRef(arg);
+        if (env->ExceptionCheck()) {
+            return false;
+        }
+        if (err != SQLITE_OK) {
+            throw_sqlite3_exception(env, connection->db, NULL);
+            return false;
+        }
+    }
+    return true;
+}
+
+static void nativeBindArguments(JNIEnv* env, jclass clazz, jlong connectionPtr,
+        jlong statementPtr, jobjectArray args) {
+    SQLiteConnection* connection = reinterpret_cast<SQLiteConnection*>(connectionPtr);
+    sqlite3_stmt* statement = reinterpret_cast<sqlite3_stmt*>(statementPtr);
+
+    jsize count = args ? env->GetArrayLength(args) : 0;
+    if (count != sqlite3_bind_parameter_count(statement)) {
+        throw_sqlite3_exception(env, "Expected a different number of bind arguments.");
+        return;
+    }
+    bindArguments(env, connection, statement, args, 0, count);
+}
+
 static void nativeResetStatementAndClearBindings(JNIEnv* env, jclass clazz, jlong connectionPtr,
         jlong statementPtr) {
     SQLiteConnection* connection = reinterpret_cast<SQLiteConnection*>(connectionPtr);
@@ -556,6 +651,69 @@ static jlong nativeExecuteForLastInsertedRowId(JNIEnv* env, jclass clazz,
             ? sqlite3_last_insert_rowid(connection->db) : -1;
 }
 
+/*
+ * Executes a prepared non-query statement once per row of |rows|, a flattened
+ * array holding the bind arguments of each row in turn.  If the connection
+ * is not already in a transaction, the rows are wrapped in one so that the
+ * whole batch commits (or rolls back) together.  Returns the total number of
+ * changed rows.
+ */
+static jint nativeExecuteBatchForChangedRowCount(JNIEnv* env, jclass clazz,
+        jlong connectionPtr, jlong statementPtr, jobjectArray rows) {
+    SQLiteConnection* connection = reinterpret_cast<SQLiteConnection*>(connectionPtr);
+    sqlite3_stmt* statement = reinterpret_cast<sqlite3_stmt*>(statementPtr);
+
+    const jsize paramCount = sqlite3_bind_parameter_count(statement);
+    const jsize argCount = rows ? env->GetArrayLength(rows) : 0;
+    if (paramCount == 0 || argCount % paramCount != 0) {
+        throw_sqlite3_exception(env, "Expected a whole number of rows of bind arguments.");
+        return -1;
+    }
+
+    const bool ownTransaction = sqlite3_get_autocommit(connection->db) != 0;
+    if (ownTransaction) {
+        int err = sqlite3_exec(connection->db, "BEGIN IMMEDIATE", NULL, NULL, NULL);
+        if (err != SQLITE_OK) {
+            throw_sqlite3_exception(env, connection->db, "Could not begin batch transaction.");
+            return -1;
+        }
+    }
+
+    jint changes = 0;
+    bool ok = true;
+    for (jsize offset = 0; offset < argCount; offset += paramCount) {
+        int err = sqlite3_reset(statement);
+        if (err == SQLITE_OK) {
+            err = sqlite3_clear_bindings(statement);
+        }
+        if (err != SQLITE_OK) {
+            throw_sqlite3_exception(env, connection->db, NULL);
+            ok = false;
+            break;
+        }
+        if (!bindArguments(env, connection, statement, rows, offset, paramCount)
+                || executeNonQuery(env, connection, statement) != SQLITE_DONE) {
+            ok = false;
+            break;
+        }
+        changes += sqlite3_changes(connection->db);
+    }
+    sqlite3_reset(statement);
+
+    if (ownTransaction) {
+        if (ok) {
+            if (sqlite3_exec(connection->db, "COMMIT", NULL, NULL, NULL) != SQLITE_OK) {
+                throw_sqlite3_exception(env, connection->db, "Could not commit batch.");
+                ok = false;
+            }
+        }
+        if (!ok && sqlite3_get_autocommit(connection->db) == 0) {
+            sqlite3_exec(connection->db, "ROLLBACK", NULL, NULL, NULL);
+        }
+    }
+    return ok ? changes : -1;
+}
+
 static int executeOneRowQuery(JNIEnv* env, SQLiteConnection* connection, sqlite3_stmt* statement) {
     int err = sqlite3_step(statement);
     if (err != SQLITE_ROW) {
@@ -651,96 +809,59 @@ enum CopyRowResult {
 };
 
 static CopyRowResult copyRow(JNIEnv* env, CursorWindow* window,
-        sqlite3_stmt* statement, int numColumns, int startPos, int addedRows) {
-    // Allocate a new field directory for the row.
-    status_t status = window->allocRow();
-    if (status) {
-        LOG_WINDOW("Failed allocating fieldDir at startPos %d row %d, error=%d",
-                startPos, addedRows, status);
-        return CPR_FULL;
-    }
-
-    // Pack the row into the window.
-    CopyRowResult result = CPR_OK;
+        sqlite3_stmt* statement, int numColumns, int startPos, int addedRows,
+        std::vector<CursorWindow::Field>* fields) {
+    // Collect the values of the row, then pack the whole row into the window at once.
+    fields->resize(numColumns);
     for (int i = 0; i < numColumns; i++) {
+        CursorWindow::Field& field = (*fields)[i];
         int type = sqlite3_column_type(statement, i);
         if (type == SQLITE_TEXT) {
             // TEXT data
-            const char* text = reinterpret_cast<const char*>(
-                    sqlite3_column_text(statement, i));
+            field.type = CursorWindow::FIELD_TYPE_STRING;
+            field.data.buffer.value = sqlite3_column_text(statement, i);
             // SQLite does not include the NULL terminator in size, but does
             // ensure all strings are NULL terminated, so increase size by
             // one to make sure we store the terminator.
-            size_t sizeIncludingNull = sqlite3_column_bytes(statement, i) + 1;
-            status = window->putString(addedRows, i, text, sizeIncludingNull);
-            if (status) {
-                LOG_WINDOW("Failed allocating %zu bytes for text at %d,%d, error=%d",
-                        sizeIncludingNull, startPos + addedRows, i, status);
-                result = CPR_FULL;
-                break;
-            }
+            field.data.buffer.size = sqlite3_column_bytes(statement, i) + 1;
             LOG_WINDOW("%d,%d is TEXT with %zu bytes",
-                    startPos + addedRows, i, sizeIncludingNull);
+                    startPos + addedRows, i, field.data.buffer.size);
         } else if (type == SQLITE_INTEGER) {
             // INTEGER data
-            int64_t value = sqlite3_column_int64(statement, i);
-            status = window->putLong(addedRows, i, value);
-            if (status) {
-                LOG_WINDOW("Failed allocating space for a long in column %d, error=%d",
-                        i, status);
-                result = CPR_FULL;
-                break;
-            }
-            LOG_WINDOW("%d,%d is INTEGER %" PRId64, startPos + addedRows, i, value);
+            field.type = CursorWindow::FIELD_TYPE_INTEGER;
+            field.data.l = sqlite3_column_int64(statement, i);
+            LOG_WINDOW("%d,%d is INTEGER %" PRId64, startPos + addedRows, i, field.data.l);
         } else if (type == SQLITE_FLOAT) {
             // FLOAT data
-            double value = sqlite3_column_double(statement, i);
-            status = window->putDouble(addedRows, i, value);
-            if (status) {
-                LOG_WINDOW("Failed allocating space for a double in column %d, error=%d",
-                        i, status);
-                result = CPR_FULL;
-                break;
-            }
-            LOG_WINDOW("%d,%d is FLOAT %lf", startPos + addedRows, i, value);
+            field.type = CursorWindow::FIELD_TYPE_FLOAT;
+            field.data.d = sqlite3_column_double(statement, i);
+            LOG_WINDOW("%d,%d is FLOAT %lf", startPos + addedRows, i, field.data.d);
         } else if (type == SQLITE_BLOB) {
             // BLOB data
-            const void* blob = sqlite3_column_blob(statement, i);
-            size_t size = sqlite3_column_bytes(statement, i);
-            status = window->putBlob(addedRows, i, blob, size);
-            if (status) {
-                LOG_WINDOW("Failed allocating %zu bytes for blob at %d,%d, error=%d",
-                        size, startPos + addedRows, i, status);
-                result = CPR_FULL;
-                break;
-            }
+            field.type = CursorWindow::FIELD_TYPE_BLOB;
+            field.data.buffer.value = sqlite3_column_blob(statement, i);
+            field.data.buffer.size = sqlite3_column_bytes(statement, i);
             LOG_WINDOW("%d,%d is Blob with %zu bytes",
-                    startPos + addedRows, i, size);
+                    startPos + addedRows, i, field.data.buffer.size);
         } else if (type == SQLITE_NULL) {
             // NULL field
-            status = window->putNull(addedRows, i);
-            if (status) {
-                LOG_WINDOW("Failed allocating space for a null in column %d, error=%d",
-                        i, status);
-                result = CPR_FULL;
-                break;
-            }
-
+            field.type = CursorWindow::FIELD_TYPE_NULL;
             LOG_WINDOW("%d,%d is NULL", startPos + addedRows, i);
         } else {
             // Unknown data
             ALOGE("Unknown column type when filling database window");
             throw_sqlite3_exception(env, "Unknown column type when filling window");
-            result = CPR_ERROR;
-            break;
+            return CPR_ERROR;
         }
     }
 
-    // Free the last row if if was not successfully copied.
-    if (result != CPR_OK) {
-        window->freeLastRow();
+    status_t status = window->putRow(fields->data(), numColumns);
+    if (status) {
+        LOG_WINDOW("Failed allocating row at startPos %d row %d, error=%d",
+                startPos, addedRows, status);
+        return CPR_FULL;
     }
-    return result;
+    return CPR_OK;
 }
 
 static jlong nativeExecuteForCursorWindow(JNIEnv* env, jclass clazz,
@@ -768,6 +889,7 @@ static jlong nativeExecuteForCursorWindow(JNIEnv* env, jclass clazz,
         return 0;
     }
 
+    std::vector<CursorWindow::Field> fields;
     int retryCount = 0;
     int totalRows = 0;
     int addedRows = 0;
@@ -785,7 +907,8 @@ static jlong nativeExecuteForCursorWindow(JNIEnv* env, jclass clazz,
                 continue;
             }
 
-            CopyRowResult cpr = copyRow(env, window, statement, numColumns, startPos, addedRows);
+            CopyRowResult cpr = copyRow(env, window, statement, numColumns, startPos, addedRows,
+                    &fields);
             if (cpr == CPR_FULL && addedRows && startPos + addedRows <= requiredPos) {
                 // We filled the window before we got to the one row that we really wanted.
                 // Clear the window and start filling it again from here.
@@ -794,7 +917,8 @@ static jlong nativeExecuteForCursorWindow(JNIEnv* env, jclass clazz,
                 window->setNumColumns(numColumns);
                 startPos += addedRows;
                 addedRows = 0;
-                cpr = copyRow(env, window, statement, numColumns, startPos, addedRows);
+                cpr = copyRow(env, window, statement, numColumns, startPos, addedRows,
+                    &fields);
             }
 
             if (cpr == CPR_OK) {
@@ -910,6 +1034,8 @@ static const JNINativeMethod sMethods[] =
             (void*)nativeBindString },
     { "nativeBindBlob", "(JJI[B)V",
             (void*)nativeBindBlob },
+    { "nativeBindArguments", "(JJ[Ljava/lang/Object;)V",
+            (void*)nativeBindArguments },
     { "nativeResetStatementAndClearBindings", "(JJ)V",
             (void*)nativeResetStatementAndClearBindings },
     { "nativeExecute", "(JJ)V",
@@ -922,6 +1048,8 @@ static const JNINativeMethod sMethods[] =
             (void*)nativeExecuteForBlobFileDescriptor },
     { "nativeExecuteForChangedRowCount", "(JJ)I",
             (void*)nativeExecuteForChangedRowCount },
+    { "nativeExecuteBatchForChangedRowCount", "(JJ[Ljava/lang/Object;)I",
+            (void*)nativeExecuteBatchForChangedRowCount },
     { "nativeExecuteForLastInsertedRowId", "(JJ)J",
             (void*)nativeExecuteForLastInsertedRowId },
     { "nativeExecuteForCursorWindow", "(JJJIIZ)J",
@@ -944,6 +1072,18 @@ int register_android_database_SQLiteConnection(JNIEnv *env)
     gBinaryOperator.apply = GetMethodIDOrDie(env, binaryClazz,
             "apply", "(Ljava/lang/Object;Ljava/lang/Object;)Ljava/lang/Object;");
 
+    gBindArgs.stringClass = MakeGlobalRefOrDie(env, FindClassOrDie(env, "java/lang/String"));
+    gBindArgs.byteArrayClass = MakeGlobalRefOrDie(env, FindClassOrDie(env, "[B"));
+    gBindArgs.floatClass = MakeGlobalRefOrDie(env, FindClassOrDie(env, "java/lang/Float"));
+    gBindArgs.doubleClass = MakeGlobalRefOrDie(env, FindClassOrDie(env, "java/lang/Double"));
+    gBindArgs.numberClass = MakeGlobalRefOrDie(env, FindClassOrDie(env, "java/lang/Number"));
+    gBindArgs.booleanClass = MakeGlobalRefOrDie(env, FindClassOrDie(env, "java/lang/Boolean"));
+    gBindArgs.longValue = GetMethodIDOrDie(env, gBindArgs.numberClass, "longValue", "()J");
+    gBindArgs.doubleValue = GetMethodIDOrDie(env, gBindArgs.numberClass, "doubleValue", "()D");
+    gBindArgs.booleanValue = GetMethodIDOrDie(env, gBindArgs.booleanClass, "booleanValue", "()Z");
+    jclass objectClazz = FindClassOrDie(env, "java/lang/Object");
+    gBindArgs.toString = GetMethodIDOrDie(env, objectClazz, "toString", "()Ljava/lang/String;");
+
     return RegisterMethodsOrDie(env, "android/database/sqlite/SQLiteConnection", sMethods,
                                 NELEM(sMethods));
 }
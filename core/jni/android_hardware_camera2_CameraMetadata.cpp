@@ -68,6 +68,8 @@ static struct metadata_java_key_offsets_t {
     jclass mArrayList;
     jmethodID mArrayListConstr;
     jmethodID mArrayListAdd;
+    jclass mByteBuffer;
+    jmethodID mByteBufferAsReadOnly;
 } gMetadataOffsets;
 
 struct fields_t {
@@ -322,6 +324,107 @@ static jbyteArray CameraMetadata_readValues(JNIEnv *env, jclass thiz, jint tag,
     return byteArray;
 }
 
+/**
+ * Reads the raw data of several tags in one call.
+ *
+ * The data of all present tags is packed into the returned array; outLayout receives an
+ * (offset, length) pair per tag, with a length of -1 for tags that have no entry.
+ */
+static jbyteArray CameraMetadata_readValuesBulk(JNIEnv *env, jclass thiz, jlong ptr,
+        jintArray tags, jintArray outLayout) {
+    ALOGV("%s", __FUNCTION__);
+
+    CameraMetadata* metadata = CameraMetadata_getPointerThrow(env, ptr);
+    if (metadata == NULL) return NULL;
+
+    ScopedIntArrayRO tagArray(env, tags);
+    if (tagArray.get() == NULL) return NULL;
+    const size_t tagCount = tagArray.size();
+    if (static_cast<size_t>(env->GetArrayLength(outLayout)) < tagCount * 2) {
+        jniThrowException(env, "java/lang/IllegalArgumentException",
+                          "Layout array is too small");
+        return NULL;
+    }
+
+    std::vector<jint> layout(tagCount * 2);
+    std::vector<camera_metadata_ro_entry> entries(tagCount);
+    size_t totalBytes = 0;
+
+    const camera_metadata_t *metaBuffer = metadata->getAndLock();
+    for (size_t i = 0; i < tagCount; ++i) {
+        int tagType = get_local_camera_metadata_tag_type(tagArray[i], metaBuffer);
+        if (tagType == -1) {
+            metadata->unlock(metaBuffer);
+            jniThrowExceptionFmt(env, "java/lang/IllegalArgumentException",
+                                 "Tag (%d) did not have a type", tagArray[i]);
+            return NULL;
+        }
+        if (find_camera_metadata_ro_entry(metaBuffer, tagArray[i], &entries[i]) != OK) {
+            entries[i].count = 0;
+            layout[i * 2] = 0;
+            layout[i * 2 + 1] = -1;
+            continue;
+        }
+        size_t byteCount = entries[i].count * Helpers::getTypeSize(tagType);
+        layout[i * 2] = totalBytes;
+        layout[i * 2 + 1] = byteCount;
+        totalBytes += byteCount;
+    }
+
+    jbyteArray byteArray = env->NewByteArray(totalBytes);
+    if (env->ExceptionCheck()) {
+        metadata->unlock(metaBuffer);
+        return NULL;
+    }
+    {
+        ScopedByteArrayRW arrayWriter(env, byteArray);
+        for (size_t i = 0; i < tagCount; ++i) {
+            if (layout[i * 2 + 1] > 0) {
+                memcpy(arrayWriter.get() + layout[i * 2], entries[i].data.u8, layout[i * 2 + 1]);
+            }
+        }
+    }
+    metadata->unlock(metaBuffer);
+
+    env->SetIntArrayRegion(outLayout, 0, tagCount * 2, layout.data());
+    return byteArray;
+}
+
+/**
+ * Returns a read-only direct ByteBuffer over the data of one tag, or null if the tag has no
+ * entry.
+ *
+ * The buffer aliases the native metadata and is only valid until the metadata is next modified,
+ * swapped or closed; callers must not hold on to it past that point.
+ */
+static jobject CameraMetadata_getValuesBuffer(JNIEnv *env, jclass thiz, jlong ptr, jint tag) {
+    ALOGV("%s (tag = %d)", __FUNCTION__, tag);
+
+    CameraMetadata* metadata = CameraMetadata_getPointerThrow(env, ptr);
+    if (metadata == NULL) return NULL;
+
+    const camera_metadata_t *metaBuffer = metadata->getAndLock();
+    int tagType = get_local_camera_metadata_tag_type(tag, metaBuffer);
+    camera_metadata_ro_entry entry;
+    status_t res = find_camera_metadata_ro_entry(metaBuffer, tag, &entry);
+    metadata->unlock(metaBuffer);
+    if (tagType == -1) {
+        jniThrowExceptionFmt(env, "java/lang/IllegalArgumentException",
+                             "Tag (%d) did not have a type", tag);
+        return NULL;
+    }
+    if (res != OK) {
+        return NULL;
+    }
+
+    jobject buffer = env->NewDirectByteBuffer(const_cast<uint8_t*>(entry.data.u8),
+            entry.count * Helpers::getTypeSize(tagType));
+    if (buffer == NULL) return NULL;
+    jobject readOnly = env->CallObjectMethod(buffer, gMetadataOffsets.mByteBufferAsReadOnly);
+    env->DeleteLocalRef(buffer);
+    return readOnly;
+}
+
 static void CameraMetadata_writeValues(JNIEnv *env, jclass thiz, jint tag, jbyteArray src,
         jlong ptr) {
     ALOGV("%s (tag = %d)", __FUNCTION__, tag);
@@ -580,6 +683,12 @@ static const JNINativeMethod gCameraMetadataMethods[] = {
   { "nativeReadValues",
     "(IJ)[B",
     (void *)CameraMetadata_readValues },
+  { "nativeReadValuesBulk",
+    "(J[I[I)[B",
+    (void *)CameraMetadata_readValuesBulk },
+  { "nativeGetValuesBuffer",
+    "(JI)Ljava/nio/ByteBuffer;",
+    (void *)CameraMetadata_getValuesBuffer },
   { "nativeWriteValues",
     "(I[BJ)V",
     (void *)CameraMetadata_writeValues },
@@ -639,6 +748,12 @@ int register_android_hardware_camera2_CameraMetadata(JNIEnv *env)
     gMetadataOffsets.mArrayListAdd = GetMethodIDOrDie(env, gMetadataOffsets.mArrayList,
             "add", "(Ljava/lang/Object;)Z");
 
+    // Store global references for ByteBuffer methods used
+    jclass byteBufferClazz = FindClassOrDie(env, "java/nio/ByteBuffer");
+    gMetadataOffsets.mByteBuffer = MakeGlobalRefOrDie(env, byteBufferClazz);
+    gMetadataOffsets.mByteBufferAsReadOnly = GetMethodIDOrDie(env, gMetadataOffsets.mByteBuffer,
+            "asReadOnlyBuffer", "()Ljava/nio/ByteBuffer;");
+
     jclass cameraMetadataClazz = FindClassOrDie(env, CAMERA_METADATA_CLASS_NAME);
     fields.metadata_ptr = GetFieldIDOrDie(env, cameraMetadataClazz, "mMetadataPtr", "J");
 
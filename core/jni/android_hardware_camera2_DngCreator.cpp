@@ -16,8 +16,10 @@
 
 //#define LOG_NDEBUG 0
 #define LOG_TAG "DngCreator_JNI"
+#include <errno.h>
 #include <inttypes.h>
 #include <string.h>
+#include <unistd.h>
 #include <algorithm>
 #include <array>
 #include <memory>
@@ -322,11 +324,18 @@ public:
     status_t close();
 private:
     enum {
-        BYTE_ARRAY_LENGTH = 4096
+        // TiffWriter emits the header and IFD entries a few bytes at a time; writes are
+        // collected here so that each call into Java moves a large block.
+        BYTE_ARRAY_LENGTH = 256 * 1024
     };
+
+    status_t writeToJava(const uint8_t* buf, size_t count);
+    status_t flush();
+
     jobject mOutputStream;
     JNIEnv* mEnv;
     jbyteArray mByteArray;
+    std::vector<uint8_t> mPending;
 };
 
 JniOutputStream::JniOutputStream(JNIEnv* env, jobject outStream) : mOutputStream(outStream),
@@ -335,6 +344,7 @@ JniOutputStream::JniOutputStream(JNIEnv* env, jobject outStream) : mOutputStream
     if (mByteArray == nullptr) {
         jniThrowException(env, "java/lang/OutOfMemoryError", "Could not allocate byte array.");
     }
+    mPending.reserve(BYTE_ARRAY_LENGTH);
 }
 
 JniOutputStream::~JniOutputStream() {
@@ -347,33 +357,144 @@ status_t JniOutputStream::open() {
 }
 
 status_t JniOutputStream::write(const uint8_t* buf, size_t offset, size_t count) {
-    while(count > 0) {
-        size_t len = BYTE_ARRAY_LENGTH;
-        len = (count > len) ? len : count;
-        mEnv->SetByteArrayRegion(mByteArray, 0, len, reinterpret_cast<const jbyte*>(buf + offset));
+    while (count > 0) {
+        if (mPending.empty() && count >= BYTE_ARRAY_LENGTH) {
+            // Full blocks skip the pending buffer.
+            status_t ret = writeToJava(buf + offset, BYTE_ARRAY_LENGTH);
+            if (ret != OK) {
+                return ret;
+            }
+            count -= BYTE_ARRAY_LENGTH;
+            offset += BYTE_ARRAY_LENGTH;
+            continue;
+        }
 
-        if (mEnv->ExceptionCheck()) {
-            return BAD_VALUE;
+        size_t len = std::min(count, BYTE_ARRAY_LENGTH - mPending.size());
+        mPending.insert(mPending.end(), buf + offset, buf + offset + len);
+        count -= len;
+        offset += len;
+        if (mPending.size() == BYTE_ARRAY_LENGTH) {
+            status_t ret = flush();
+            if (ret != OK) {
+                return ret;
+            }
         }
+    }
+    return OK;
+}
 
-        mEnv->CallVoidMethod(mOutputStream, gOutputStreamClassInfo.mWriteMethod, mByteArray,
-                0, len);
+status_t JniOutputStream::writeToJava(const uint8_t* buf, size_t count) {
+    mEnv->SetByteArrayRegion(mByteArray, 0, count, reinterpret_cast<const jbyte*>(buf));
 
-        if (mEnv->ExceptionCheck()) {
-            return BAD_VALUE;
-        }
+    if (mEnv->ExceptionCheck()) {
+        return BAD_VALUE;
+    }
 
-        count -= len;
-        offset += len;
+    mEnv->CallVoidMethod(mOutputStream, gOutputStreamClassInfo.mWriteMethod, mByteArray,
+            0, count);
+
+    if (mEnv->ExceptionCheck()) {
+        return BAD_VALUE;
     }
     return OK;
 }
 
+status_t JniOutputStream::flush() {
+    if (mPending.empty()) {
+        return OK;
+    }
+    status_t ret = writeToJava(mPending.data(), mPending.size());
+    mPending.clear();
+    return ret;
+}
+
 status_t JniOutputStream::close() {
-    // Do nothing
+    return flush();
+}
+
+// End of JniOutputStream
+// ----------------------------------------------------------------------------
+
+/**
+ * Output that writes directly to a file descriptor, bypassing Java streams entirely.
+ *
+ * Small writes are collected into a large buffer; writes at least as large as the buffer go
+ * straight to the file.
+ */
+class FdOutputStream : public Output, public LightRefBase<FdOutputStream> {
+public:
+    explicit FdOutputStream(int fd);
+
+    virtual ~FdOutputStream();
+
+    status_t open();
+
+    status_t write(const uint8_t* buf, size_t offset, size_t count);
+
+    status_t close();
+private:
+    enum {
+        BUFFER_LENGTH = 1024 * 1024
+    };
+
+    status_t writeFully(const uint8_t* buf, size_t count);
+    status_t flush();
+
+    int mFd;
+    std::vector<uint8_t> mPending;
+};
+
+FdOutputStream::FdOutputStream(int fd) : mFd(fd) {
+    mPending.reserve(BUFFER_LENGTH);
+}
+
+FdOutputStream::~FdOutputStream() {}
+
+status_t FdOutputStream::open() {
+    // Do nothing, the caller owns the file descriptor.
     return OK;
 }
 
+status_t FdOutputStream::write(const uint8_t* buf, size_t offset, size_t count) {
+    if (mPending.size() + count > BUFFER_LENGTH) {
+        status_t ret = flush();
+        if (ret != OK) {
+            return ret;
+        }
+    }
+    if (count >= BUFFER_LENGTH) {
+        return writeFully(buf + offset, count);
+    }
+    mPending.insert(mPending.end(), buf + offset, buf + offset + count);
+    return OK;
+}
+
+status_t FdOutputStream::writeFully(const uint8_t* buf, size_t count) {
+    while (count > 0) {
+        ssize_t written = TEMP_FAILURE_RETRY(::write(mFd, buf, count));
+        if (written < 0) {
+            ALOGE("%s: write failed: %s", __FUNCTION__, strerror(errno));
+            return -errno;
+        }
+        buf += written;
+        count -= written;
+    }
+    return OK;
+}
+
+status_t FdOutputStream::flush() {
+    if (mPending.empty()) {
+        return OK;
+    }
+    status_t ret = writeFully(mPending.data(), mPending.size());
+    mPending.clear();
+    return ret;
+}
+
+status_t FdOutputStream::close() {
+    return flush();
+}
+
 // End of JniOutputStream
 // ----------------------------------------------------------------------------
 
@@ -2407,11 +2528,10 @@ static void DngCreator_nativeSetThumbnail(JNIEnv* env, jobject thiz, jobject buf
 }
 
 // TODO: Refactor out common preamble for the two nativeWrite methods.
-static void DngCreator_nativeWriteImage(JNIEnv* env, jobject thiz, jobject outStream, jint width,
+static void DngCreator_writeImage(JNIEnv* env, jobject thiz, Output* out, jint width,
         jint height, jobject inBuffer, jint rowStride, jint pixStride, jlong offset,
         jboolean isDirect) {
-    ALOGV("%s:", __FUNCTION__);
-    ALOGV("%s: nativeWriteImage called with: width=%d, height=%d, "
+    ALOGV("%s: writeImage called with: width=%d, height=%d, "
           "rowStride=%d, pixStride=%d, offset=%" PRId64, __FUNCTION__, width,
           height, rowStride, pixStride, offset);
     uint32_t rStride = static_cast<uint32_t>(rowStride);
@@ -2420,12 +2540,6 @@ static void DngCreator_nativeWriteImage(JNIEnv* env, jobject thiz, jobject outSt
     uint32_t uHeight = static_cast<uint32_t>(height);
     uint64_t uOffset = static_cast<uint64_t>(offset);
 
-    sp<JniOutputStream> out = new JniOutputStream(env, outStream);
-    if(env->ExceptionCheck()) {
-        ALOGE("%s: Could not allocate buffers for output stream", __FUNCTION__);
-        return;
-    }
-
     NativeContext* context = DngCreator_getNativeContext(env, thiz);
     if (context == nullptr) {
         ALOGE("%s: Failed to initialize DngCreator", __FUNCTION__);
@@ -2486,7 +2600,7 @@ static void DngCreator_nativeWriteImage(JNIEnv* env, jobject thiz, jobject outSt
         sources.add(&stripSource);
 
         status_t ret = OK;
-        if ((ret = writer->write(out.get(), sources.editArray(), sources.size())) != OK) {
+        if ((ret = writer->write(out, sources.editArray(), sources.size())) != OK) {
             ALOGE("%s: write failed with error %d.", __FUNCTION__, ret);
             if (!env->ExceptionCheck()) {
                 jniThrowExceptionFmt(env, "java/io/IOException",
@@ -2503,7 +2617,7 @@ static void DngCreator_nativeWriteImage(JNIEnv* env, jobject thiz, jobject outSt
         sources.add(&stripSource);
 
         status_t ret = OK;
-        if ((ret = writer->write(out.get(), sources.editArray(), sources.size())) != OK) {
+        if ((ret = writer->write(out, sources.editArray(), sources.size())) != OK) {
             ALOGE("%s: write failed with error %d.", __FUNCTION__, ret);
             if (!env->ExceptionCheck()) {
                 jniThrowExceptionFmt(env, "java/io/IOException",
@@ -2512,6 +2626,42 @@ static void DngCreator_nativeWriteImage(JNIEnv* env, jobject thiz, jobject outSt
             return;
         }
     }
+
+    status_t ret = OK;
+    if ((ret = out->close()) != OK) {
+        ALOGE("%s: flushing output failed with error %d.", __FUNCTION__, ret);
+        if (!env->ExceptionCheck()) {
+            jniThrowExceptionFmt(env, "java/io/IOException",
+                    "Encountered error %d while writing file.", ret);
+        }
+    }
+}
+
+static void DngCreator_nativeWriteImage(JNIEnv* env, jobject thiz, jobject outStream, jint width,
+        jint height, jobject inBuffer, jint rowStride, jint pixStride, jlong offset,
+        jboolean isDirect) {
+    ALOGV("%s:", __FUNCTION__);
+    sp<JniOutputStream> out = new JniOutputStream(env, outStream);
+    if(env->ExceptionCheck()) {
+        ALOGE("%s: Could not allocate buffers for output stream", __FUNCTION__);
+        return;
+    }
+    DngCreator_writeImage(env, thiz, out.get(), width, height, inBuffer, rowStride, pixStride,
+            offset, isDirect);
+}
+
+static void DngCreator_nativeWriteImageToFd(JNIEnv* env, jobject thiz, jobject fileDescriptor,
+        jint width, jint height, jobject inBuffer, jint rowStride, jint pixStride, jlong offset,
+        jboolean isDirect) {
+    ALOGV("%s:", __FUNCTION__);
+    int fd = jniGetFDFromFileDescriptor(env, fileDescriptor);
+    if (fd < 0) {
+        jniThrowException(env, "java/lang/IllegalArgumentException", "Invalid file descriptor");
+        return;
+    }
+    sp<FdOutputStream> out = new FdOutputStream(fd);
+    DngCreator_writeImage(env, thiz, out.get(), width, height, inBuffer, rowStride, pixStride,
+            offset, isDirect);
 }
 
 static void DngCreator_nativeWriteInputStream(JNIEnv* env, jobject thiz, jobject outStream,
@@ -2585,6 +2735,13 @@ static void DngCreator_nativeWriteInputStream(JNIEnv* env, jobject thiz, jobject
         }
         return;
     }
+    if ((ret = out->close()) != OK) {
+        ALOGE("%s: flushing output failed with error %d.", __FUNCTION__, ret);
+        if (!env->ExceptionCheck()) {
+            jniThrowExceptionFmt(env, "java/io/IOException",
+                    "Encountered error %d while writing file.", ret);
+        }
+    }
 }
 
 } /*extern "C" */
@@ -2602,6 +2759,8 @@ static const JNINativeMethod gDngCreatorMethods[] = {
     {"nativeSetThumbnail","(Ljava/nio/ByteBuffer;II)V", (void*) DngCreator_nativeSetThumbnail},
     {"nativeWriteImage",        "(Ljava/io/OutputStream;IILjava/nio/ByteBuffer;IIJZ)V",
             (void*) DngCreator_nativeWriteImage},
+    {"nativeWriteImageToFd",    "(Ljava/io/FileDescriptor;IILjava/nio/ByteBuffer;IIJZ)V",
+            (void*) DngCreator_nativeWriteImageToFd},
     {"nativeWriteInputStream",    "(Ljava/io/OutputStream;Ljava/io/InputStream;IIJ)V",
             (void*) DngCreator_nativeWriteInputStream},
 };
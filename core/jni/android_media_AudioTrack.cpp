@@ -42,6 +42,7 @@
 #include "android_media_VolumeShaper.h"
 
 #include <cinttypes>
+#include <type_traits>
 
 // ----------------------------------------------------------------------------
 
@@ -673,6 +674,25 @@ void envReleaseArrayElements(JNIEnv *env, jfloatArray array, jfloat *elems, jint
     env->ReleaseFloatArrayElements(array, elems, mode);
 }
 
+static inline
+void envGetArrayRegion(JNIEnv *env, jbyteArray array, jsize start, jsize len, jbyte *buf) {
+    env->GetByteArrayRegion(array, start, len, buf);
+}
+
+static inline
+void envGetArrayRegion(JNIEnv *env, jshortArray array, jsize start, jsize len, jshort *buf) {
+    env->GetShortArrayRegion(array, start, len, buf);
+}
+
+static inline
+void envGetArrayRegion(JNIEnv *env, jfloatArray array, jsize start, jsize len, jfloat *buf) {
+    env->GetFloatArrayRegion(array, start, len, buf);
+}
+
+// Writes up to this size are copied out of the Java array on the stack; this
+// covers typical 10-20 ms frames, even for multichannel float.
+static constexpr size_t kMaxStackWriteBytes = 16 * 1024;
+
 static inline
 jint interpretWriteSizeError(ssize_t writeSize) {
     if (writeSize == WOULD_BLOCK) {
@@ -739,6 +759,21 @@ static jint android_media_AudioTrack_writeArray(JNIEnv *env, jobject thiz,
     // AudioSystem callback to be called while in critical section (in case of media server
     // process crash for instance)
 
+    // Small writes copy just the samples being written instead of pinning or
+    // copying the whole array, which ART does for movable arrays.
+    using sample_t = typename std::remove_pointer<
+            decltype(envGetArrayElements(env, javaAudioData, NULL))>::type;
+    if (sizeInSamples >= 0 && (size_t)sizeInSamples * sizeof(sample_t) <= kMaxStackWriteBytes) {
+        sample_t samples[kMaxStackWriteBytes / sizeof(sample_t)];
+        envGetArrayRegion(env, javaAudioData, offsetInSamples, sizeInSamples, samples);
+        if (env->ExceptionCheck()) {
+            ALOGE("Error retrieving source of audio data to play");
+            return (jint)AUDIO_JAVA_BAD_VALUE;
+        }
+        return writeToTrack(lpTrack, javaAudioFormat, samples, 0 /* offsetInSamples */,
+                sizeInSamples, isWriteBlocking == JNI_TRUE /* blocking */);
+    }
+
     // get the pointer for the audio data from the java array
     auto cAudioData = envGetArrayElements(env, javaAudioData, NULL);
     if (cAudioData == NULL) {
@@ -749,7 +784,8 @@ static jint android_media_AudioTrack_writeArray(JNIEnv *env, jobject thiz,
     jint samplesWritten = writeToTrack(lpTrack, javaAudioFormat, cAudioData,
             offsetInSamples, sizeInSamples, isWriteBlocking == JNI_TRUE /* blocking */);
 
-    envReleaseArrayElements(env, javaAudioData, cAudioData, 0);
+    // The samples are only read, so don't copy them back if a copy was made.
+    envReleaseArrayElements(env, javaAudioData, cAudioData, JNI_ABORT);
 
     //ALOGV("write wrote %d (tried %d) samples in the native AudioTrack with offset %d",
     //        (int)samplesWritten, (int)(sizeInSamples), (int)offsetInSamples);
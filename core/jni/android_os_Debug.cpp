@@ -29,8 +29,11 @@
 #include <time.h>
 #include <unistd.h>
 
+#include <algorithm>
+#include <atomic>
 #include <iomanip>
 #include <string>
+#include <thread>
 #include <vector>
 
 #include <android-base/logging.h>
@@ -492,12 +495,26 @@ static void android_os_Debug_getDirtyPages(JNIEnv *env, jobject clazz, jobject o
     android_os_Debug_getDirtyPagesPid(env, clazz, getpid(), object);
 }
 
-static jlong android_os_Debug_getPssPid(JNIEnv *env, jobject clazz, jint pid,
-        jlongArray outUssSwapPssRss, jlongArray outMemtrack)
+// The 1:1 mapping of PSS_STATS_* enums here must match with the constants from
+// Debug.java.
+enum {
+    PSS_STATS_PSS,
+    PSS_STATS_USS,
+    PSS_STATS_SWAP_PSS,
+    PSS_STATS_RSS,
+    PSS_STATS_MEMTRACK,
+    PSS_STATS_COUNT
+};
+
+/*
+ * Reads the PSS summary of a process into |out|, indexed by PSS_STATS_*.
+ * Uses /proc/pid/smaps_rollup when the kernel provides it. Returns false if
+ * the process could not be read, e.g. because it has exited.
+ */
+static bool read_pss_stats(int pid, jlong* out)
 {
     jlong pss = 0;
     jlong rss = 0;
-    jlong swapPss = 0;
     jlong uss = 0;
     jlong memtrack = 0;
 
@@ -508,15 +525,34 @@ static jlong android_os_Debug_getPssPid(JNIEnv *env, jobject clazz, jint pid,
 
     ::android::meminfo::ProcMemInfo proc_mem(pid);
     ::android::meminfo::MemUsage stats;
-    if (proc_mem.SmapsOrRollup(&stats)) {
-        pss += stats.pss;
-        uss += stats.uss;
-        rss += stats.rss;
-        swapPss = stats.swap_pss;
-        pss += swapPss; // Also in swap, those pages would be accounted as Pss without SWAP
-    } else {
+    if (!proc_mem.SmapsOrRollup(&stats)) {
+        return false;
+    }
+    pss += stats.pss;
+    uss += stats.uss;
+    rss += stats.rss;
+    pss += stats.swap_pss; // Also in swap, those pages would be accounted as Pss without SWAP
+
+    out[PSS_STATS_PSS] = pss;
+    out[PSS_STATS_USS] = uss;
+    out[PSS_STATS_SWAP_PSS] = stats.swap_pss;
+    out[PSS_STATS_RSS] = rss;
+    out[PSS_STATS_MEMTRACK] = memtrack;
+    return true;
+}
+
+static jlong android_os_Debug_getPssPid(JNIEnv *env, jobject clazz, jint pid,
+        jlongArray outUssSwapPssRss, jlongArray outMemtrack)
+{
+    jlong stats[PSS_STATS_COUNT];
+    if (!read_pss_stats(pid, stats)) {
         return 0;
     }
+    jlong pss = stats[PSS_STATS_PSS];
+    jlong uss = stats[PSS_STATS_USS];
+    jlong swapPss = stats[PSS_STATS_SWAP_PSS];
+    jlong rss = stats[PSS_STATS_RSS];
+    jlong memtrack = stats[PSS_STATS_MEMTRACK];
 
     if (outUssSwapPssRss != NULL) {
         if (env->GetArrayLength(outUssSwapPssRss) >= 1) {
@@ -552,6 +588,63 @@ static jlong android_os_Debug_getPss(JNIEnv *env, jobject clazz)
     return android_os_Debug_getPssPid(env, clazz, getpid(), NULL, NULL);
 }
 
+// Upper bound on reader threads for getPssPids(); reading smaps is mostly
+// kernel time spent walking page tables, so a few threads are enough.
+static constexpr size_t MAX_PSS_THREADS = 4;
+
+/*
+ * Collects the PSS summary of every process in |pids| in one call, reading
+ * them in parallel. |out| receives PSS_STATS_COUNT values per pid, in the
+ * order of |pids|; a process that could not be read reports all zeros.
+ */
+static void android_os_Debug_getPssPids(JNIEnv *env, jobject clazz, jintArray pids,
+        jlongArray out)
+{
+    if (pids == NULL || out == NULL) {
+        jniThrowNullPointerException(env, pids == NULL ? "pids == null" : "out == null");
+        return;
+    }
+
+    const jsize pidCount = env->GetArrayLength(pids);
+    if (env->GetArrayLength(out) < pidCount * PSS_STATS_COUNT) {
+        jniThrowException(env, "java/lang/IllegalArgumentException",
+                "out.length < pids.length * PSS_STATS_COUNT");
+        return;
+    }
+    if (pidCount == 0) {
+        return;
+    }
+
+    std::vector<jint> pidValues(pidCount);
+    env->GetIntArrayRegion(pids, 0, pidCount, pidValues.data());
+    std::vector<jlong> stats(pidCount * PSS_STATS_COUNT, 0);
+
+    std::atomic<size_t> nextPid(0);
+    auto collect = [&]() {
+        for (size_t i = nextPid++; i < pidValues.size(); i = nextPid++) {
+            jlong* pidStats = &stats[i * PSS_STATS_COUNT];
+            if (!read_pss_stats(pidValues[i], pidStats)) {
+                std::fill(pidStats, pidStats + PSS_STATS_COUNT, 0);
+            }
+        }
+    };
+
+    const size_t hardwareThreads = std::max(1u, std::thread::hardware_concurrency());
+    const size_t threadCount = std::min({pidValues.size(), hardwareThreads, MAX_PSS_THREADS});
+
+    // The calling thread reads processes too.
+    std::vector<std::thread> threads;
+    for (size_t i = 1; i < threadCount; i++) {
+        threads.emplace_back(collect);
+    }
+    collect();
+    for (std::thread& thread : threads) {
+        thread.join();
+    }
+
+    env->SetLongArrayRegion(out, 0, stats.size(), stats.data());
+}
+
 // The 1:1 mapping of MEMINFO_* enums here must match with the constants from
 // Debug.java.
 enum {
@@ -883,6 +976,8 @@ static const JNINativeMethod gMethods[] = {
             (void*) android_os_Debug_getPss },
     { "getPss",                 "(I[J[J)J",
             (void*) android_os_Debug_getPssPid },
+    { "getPssPids",             "([I[J)V",
+            (void*) android_os_Debug_getPssPids },
     { "getMemInfo",             "([J)V",
             (void*) android_os_Debug_getMemInfo },
     { "dumpNativeHeap",         "(Ljava/io/FileDescriptor;)V",
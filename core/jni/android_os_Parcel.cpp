@@ -68,6 +68,8 @@ static struct parcel_offsets_t
     jmethodID recycle;
 } gParcelOffsets;
 
+static jclass gStringClass;
+
 Parcel* parcelForJavaObject(JNIEnv* env, jobject obj)
 {
     if (obj) {
@@ -316,6 +318,92 @@ static void android_os_Parcel_writeString16(JNIEnv* env, jclass clazz, jlong nat
     }
 }
 
+// Writes |length| elements of a primitive Java array as a length-prefixed run,
+// in the same layout the Java per-element writeInt/writeLong loops produce.
+template <typename T>
+static void writePrimitiveArray(JNIEnv* env, jclass clazz, jlong nativePtr, jarray data,
+                                jint offset, jint length)
+{
+    Parcel* parcel = reinterpret_cast<Parcel*>(nativePtr);
+    if (parcel == NULL) {
+        return;
+    }
+
+    if (data == NULL) {
+        const status_t err = parcel->writeInt32(-1);
+        if (err != NO_ERROR) {
+            signalExceptionForError(env, clazz, err);
+        }
+        return;
+    }
+
+    if (offset < 0 || length < 0 || length > INT32_MAX / (jint)sizeof(T)
+            || length > env->GetArrayLength(data) - offset) {
+        jniThrowException(env, "java/lang/ArrayIndexOutOfBoundsException", NULL);
+        return;
+    }
+
+    const status_t err = parcel->writeInt32(length);
+    if (err != NO_ERROR) {
+        signalExceptionForError(env, clazz, err);
+        return;
+    }
+
+    void* dest = parcel->writeInplace(length * sizeof(T));
+    if (dest == NULL) {
+        signalExceptionForError(env, clazz, NO_MEMORY);
+        return;
+    }
+
+    T* ar = (T*)env->GetPrimitiveArrayCritical(data, 0);
+    if (ar) {
+        memcpy(dest, ar + offset, length * sizeof(T));
+        env->ReleasePrimitiveArrayCritical(data, ar, JNI_ABORT);
+    }
+}
+
+static void android_os_Parcel_writeIntArray(JNIEnv* env, jclass clazz, jlong nativePtr,
+                                            jintArray data, jint offset, jint length)
+{
+    writePrimitiveArray<jint>(env, clazz, nativePtr, data, offset, length);
+}
+
+static void android_os_Parcel_writeLongArray(JNIEnv* env, jclass clazz, jlong nativePtr,
+                                             jlongArray data, jint offset, jint length)
+{
+    writePrimitiveArray<jlong>(env, clazz, nativePtr, data, offset, length);
+}
+
+static void android_os_Parcel_writeString16Array(JNIEnv* env, jclass clazz, jlong nativePtr,
+                                                 jobjectArray val)
+{
+    Parcel* parcel = reinterpret_cast<Parcel*>(nativePtr);
+    if (parcel == NULL) {
+        return;
+    }
+
+    const jsize count = val ? env->GetArrayLength(val) : -1;
+    status_t err = parcel->writeInt32(count);
+    for (jsize i = 0; i < count && err == NO_ERROR; i++) {
+        ScopedLocalRef<jstring> str(env, (jstring)env->GetObjectArrayElement(val, i));
+        if (str.get() == NULL) {
+            err = parcel->writeString16(NULL, 0);
+            continue;
+        }
+        const jchar* chars = env->GetStringCritical(str.get(), 0);
+        if (chars == NULL) {
+            err = NO_MEMORY;
+            break;
+        }
+        err = parcel->writeString16(reinterpret_cast<const char16_t*>(chars),
+                                    env->GetStringLength(str.get()));
+        env->ReleaseStringCritical(str.get(), chars);
+    }
+    if (err != NO_ERROR) {
+        signalExceptionForError(env, clazz, err);
+    }
+}
+
 static void android_os_Parcel_writeStrongBinder(JNIEnv* env, jclass clazz, jlong nativePtr, jobject object)
 {
     Parcel* parcel = reinterpret_cast<Parcel*>(nativePtr);
@@ -493,6 +581,84 @@ static jstring android_os_Parcel_readString16(JNIEnv* env, jclass clazz, jlong n
     return NULL;
 }
 
+// Reads a length-prefixed run written by writePrimitiveArray (or the Java
+// per-element loops) into a new Java array.  Returns NULL for a null array or
+// if the stored length does not fit in the remaining data.
+template <typename T, typename ArrayT>
+static ArrayT createPrimitiveArray(JNIEnv* env, jlong nativePtr, ArrayT (JNIEnv::*newArray)(jsize))
+{
+    Parcel* parcel = reinterpret_cast<Parcel*>(nativePtr);
+    if (parcel == NULL) {
+        return NULL;
+    }
+
+    int32_t len = parcel->readInt32();
+
+    // sanity check the stored length against the true data size
+    if (len < 0 || len > (int32_t)(parcel->dataAvail() / sizeof(T))) {
+        return NULL;
+    }
+
+    const void* data = parcel->readInplace(len * sizeof(T));
+    if (data == NULL) {
+        return NULL;
+    }
+
+    ArrayT ret = (env->*newArray)(len);
+    if (ret != NULL) {
+        T* ar = (T*)env->GetPrimitiveArrayCritical(ret, 0);
+        if (ar) {
+            memcpy(ar, data, len * sizeof(T));
+            env->ReleasePrimitiveArrayCritical(ret, ar, 0);
+        }
+    }
+    return ret;
+}
+
+static jintArray android_os_Parcel_createIntArray(JNIEnv* env, jclass clazz, jlong nativePtr)
+{
+    return createPrimitiveArray<jint>(env, nativePtr, &JNIEnv::NewIntArray);
+}
+
+static jlongArray android_os_Parcel_createLongArray(JNIEnv* env, jclass clazz, jlong nativePtr)
+{
+    return createPrimitiveArray<jlong>(env, nativePtr, &JNIEnv::NewLongArray);
+}
+
+static jobjectArray android_os_Parcel_createString16Array(JNIEnv* env, jclass clazz,
+                                                          jlong nativePtr)
+{
+    Parcel* parcel = reinterpret_cast<Parcel*>(nativePtr);
+    if (parcel == NULL) {
+        return NULL;
+    }
+
+    // Every element takes at least its 4-byte length.
+    int32_t count = parcel->readInt32();
+    if (count < 0 || count > (int32_t)(parcel->dataAvail() / sizeof(int32_t))) {
+        return NULL;
+    }
+
+    jobjectArray ret = env->NewObjectArray(count, gStringClass, NULL);
+    if (ret == NULL) {
+        return NULL;
+    }
+    for (int32_t i = 0; i < count; i++) {
+        size_t len;
+        const char16_t* str = parcel->readString16Inplace(&len);
+        if (str == NULL) {
+            continue;
+        }
+        ScopedLocalRef<jstring> jstr(env,
+                env->NewString(reinterpret_cast<const jchar*>(str), len));
+        if (jstr.get() == NULL) {
+            return NULL;
+        }
+        env->SetObjectArrayElement(ret, i, jstr.get());
+    }
+    return ret;
+}
+
 static jobject android_os_Parcel_readStrongBinder(JNIEnv* env, jclass clazz, jlong nativePtr)
 {
     Parcel* parcel = reinterpret_cast<Parcel*>(nativePtr);
@@ -747,6 +913,9 @@ static const JNINativeMethod gParcelMethods[] = {
     {"nativeRestoreAllowFds",     "(JZ)V", (void*)android_os_Parcel_restoreAllowFds},
 
     {"nativeWriteByteArray",      "(J[BII)V", (void*)android_os_Parcel_writeByteArray},
+    {"nativeWriteIntArray",       "(J[III)V", (void*)android_os_Parcel_writeIntArray},
+    {"nativeWriteLongArray",      "(J[JII)V", (void*)android_os_Parcel_writeLongArray},
+    {"nativeWriteString16Array",  "(J[Ljava/lang/String;)V", (void*)android_os_Parcel_writeString16Array},
     {"nativeWriteBlob",           "(J[BII)V", (void*)android_os_Parcel_writeBlob},
     // @FastNative
     {"nativeWriteInt",            "(JI)V", (void*)android_os_Parcel_writeInt},
@@ -768,6 +937,9 @@ static const JNINativeMethod gParcelMethods[] = {
     {"nativeCreateByteArray",     "(J)[B", (void*)android_os_Parcel_createByteArray},
     {"nativeReadByteArray",       "(J[BI)Z", (void*)android_os_Parcel_readByteArray},
     {"nativeReadBlob",            "(J)[B", (void*)android_os_Parcel_readBlob},
+    {"nativeCreateIntArray",      "(J)[I", (void*)android_os_Parcel_createIntArray},
+    {"nativeCreateLongArray",     "(J)[J", (void*)android_os_Parcel_createLongArray},
+    {"nativeCreateString16Array", "(J)[Ljava/lang/String;", (void*)android_os_Parcel_createString16Array},
     // @CriticalNative
     {"nativeReadInt",             "(J)I", (void*)android_os_Parcel_readInt},
     // @CriticalNative
@@ -821,6 +993,8 @@ int register_android_os_Parcel(JNIEnv* env)
     gParcelOffsets.obtain = GetStaticMethodIDOrDie(env, clazz, "obtain", "()Landroid/os/Parcel;");
     gParcelOffsets.recycle = GetMethodIDOrDie(env, clazz, "recycle", "()V");
 
+    gStringClass = MakeGlobalRefOrDie(env, FindClassOrDie(env, "java/lang/String"));
+
     return RegisterMethodsOrDie(env, kParcelPathName, gParcelMethods, NELEM(gParcelMethods));
 }
 
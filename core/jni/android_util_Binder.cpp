@@ -20,11 +20,14 @@
 #include "android_os_Parcel.h"
 #include "android_util_Binder.h"
 
+#include <algorithm>
 #include <atomic>
 #include <fcntl.h>
 #include <inttypes.h>
 #include <mutex>
 #include <stdio.h>
+#include <string>
+#include <unordered_map>
 #include <sys/stat.h>
 #include <sys/types.h>
 #include <unistd.h>
@@ -45,6 +48,7 @@
 #include <utils/Log.h>
 #include <utils/String8.h>
 #include <utils/SystemClock.h>
+#include <utils/Timers.h>
 #include <utils/threads.h>
 
 #include <nativehelper/JNIHelp.h>
@@ -199,6 +203,114 @@ static void gcIfManyNewRefs(JNIEnv* env)
     }
 }
 
+// ----------------------------------------------------------------------------
+
+/*
+ * Sampled latency histograms of Java binder transactions, keyed by direction,
+ * interface descriptor and transaction code.  One in kSampleInterval
+ * transactions per thread is timed, so unsampled calls only pay for a
+ * thread-local counter increment; the lock is only taken to record a sample.
+ * Outgoing latencies cover the whole round trip including time queued for a
+ * binder thread in the remote process; incoming latencies cover the Java
+ * onTransact handler.
+ */
+class BinderLatencyStats
+{
+public:
+    static constexpr uint32_t kSampleInterval = 32;
+    // Bucket i counts samples below 2^(i+1) microseconds; the last is open-ended.
+    static constexpr size_t kNumBuckets = 16;
+    // Bounds memory use; samples for new keys beyond this are dropped.
+    static constexpr size_t kMaxEntries = 1024;
+
+    static bool shouldSample()
+    {
+        static thread_local uint32_t sCallCount = 0;
+        return ++sCallCount % kSampleInterval == 0;
+    }
+
+    void record(bool incoming, const String16& descriptor, uint32_t code, nsecs_t latency)
+    {
+        String8 desc(descriptor);
+        Key key{incoming, code, std::string(desc.string(), desc.length())};
+
+        std::lock_guard<std::mutex> _l(mLock);
+        auto it = mHistograms.find(key);
+        if (it == mHistograms.end()) {
+            if (mHistograms.size() >= kMaxEntries) {
+                return;
+            }
+            it = mHistograms.emplace(std::move(key), Histogram()).first;
+        }
+        Histogram& histogram = it->second;
+        histogram.count++;
+        histogram.totalNs += latency;
+        histogram.maxNs = std::max(histogram.maxNs, latency);
+        histogram.buckets[bucketFor(latency)]++;
+    }
+
+    void dump(int fd, bool reset)
+    {
+        std::lock_guard<std::mutex> _l(mLock);
+        dprintf(fd, "Binder transaction latency (1 in %u sampled, bucket i < 2^(i+1) us):\n",
+                kSampleInterval);
+        for (const auto& [key, histogram] : mHistograms) {
+            dprintf(fd, "  %s %s#%u: count=%" PRIu64 " avg=%" PRId64 "us max=%" PRId64 "us [",
+                    key.incoming ? "in " : "out", key.descriptor.c_str(), key.code,
+                    histogram.count, ns2us(histogram.totalNs / histogram.count),
+                    ns2us(histogram.maxNs));
+            for (size_t i = 0; i < kNumBuckets; i++) {
+                dprintf(fd, i == 0 ? "%" PRIu64 : ",%" PRIu64, histogram.buckets[i]);
+            }
+            dprintf(fd, "]\n");
+        }
+        if (reset) {
+            mHistograms.clear();
+        }
+    }
+
+private:
+    struct Key {
+        bool incoming;
+        uint32_t code;
+        std::string descriptor;
+
+        bool operator==(const Key& other) const {
+            return incoming == other.incoming && code == other.code
+                    && descriptor == other.descriptor;
+        }
+    };
+
+    struct KeyHash {
+        size_t operator()(const Key& key) const {
+            return std::hash<std::string>()(key.descriptor) ^ (key.code * 31 + key.incoming);
+        }
+    };
+
+    struct Histogram {
+        uint64_t count = 0;
+        nsecs_t totalNs = 0;
+        nsecs_t maxNs = 0;
+        uint64_t buckets[kNumBuckets] = {};
+    };
+
+    static size_t bucketFor(nsecs_t latency)
+    {
+        uint64_t us = ns2us(latency);
+        size_t bucket = 0;
+        while (us > 1 && bucket < kNumBuckets - 1) {
+            us >>= 1;
+            bucket++;
+        }
+        return bucket;
+    }
+
+    std::mutex mLock;
+    std::unordered_map<Key, Histogram, KeyHash> mHistograms;
+};
+
+static BinderLatencyStats gBinderLatencyStats;
+
 static JavaVM* jnienv_to_javavm(JNIEnv* env)
 {
     JavaVM* vm;
@@ -397,12 +509,20 @@ protected:
         IPCThreadState* thread_state = IPCThreadState::self();
         const int32_t strict_policy_before = thread_state->getStrictModePolicy();
 
+        const bool sample_latency = BinderLatencyStats::shouldSample();
+        const nsecs_t start_ns = sample_latency ? systemTime(SYSTEM_TIME_MONOTONIC) : 0;
+
         //printf("Transact from %p to Java code sending: ", this);
         //data.print();
         //printf("\n");
         jboolean res = env->CallBooleanMethod(mObject, gBinderOffsets.mExecTransact,
             code, reinterpret_cast<jlong>(&data), reinterpret_cast<jlong>(reply), flags);
 
+        if (sample_latency) {
+            gBinderLatencyStats.record(true /* incoming */, getInterfaceDescriptor(), code,
+                    systemTime(SYSTEM_TIME_MONOTONIC) - start_ns);
+        }
+
         if (env->ExceptionCheck()) {
             ScopedLocalRef<jthrowable> excep(env, env->ExceptionOccurred());
             report_exception(env, excep.get(),
@@ -1197,6 +1317,17 @@ static void android_os_BinderInternal_setBinderProxyCountWatermarks(JNIEnv* env,
     BpBinder::setBinderProxyCountWatermarks(high, low);
 }
 
+static void android_os_BinderInternal_dumpBinderLatencyStats(JNIEnv* env, jobject clazz,
+                                                             jobject fileDescriptor, jboolean reset)
+{
+    int fd = jniGetFDFromFileDescriptor(env, fileDescriptor);
+    if (fd < 0) {
+        jniThrowException(env, "java/lang/IllegalArgumentException", "invalid file descriptor");
+        return;
+    }
+    gBinderLatencyStats.dump(fd, reset);
+}
+
 // ----------------------------------------------------------------------------
 
 static const JNINativeMethod gBinderInternalMethods[] = {
@@ -1209,7 +1340,8 @@ static const JNINativeMethod gBinderInternalMethods[] = {
     { "nSetBinderProxyCountEnabled", "(Z)V", (void*)android_os_BinderInternal_setBinderProxyCountEnabled },
     { "nGetBinderProxyPerUidCounts", "()Landroid/util/SparseIntArray;", (void*)android_os_BinderInternal_getBinderProxyPerUidCounts },
     { "nGetBinderProxyCount", "(I)I", (void*)android_os_BinderInternal_getBinderProxyCount },
-    { "nSetBinderProxyCountWatermarks", "(II)V", (void*)android_os_BinderInternal_setBinderProxyCountWatermarks}
+    { "nSetBinderProxyCountWatermarks", "(II)V", (void*)android_os_BinderInternal_setBinderProxyCountWatermarks},
+    { "nDumpBinderLatencyStats", "(Ljava/io/FileDescriptor;Z)V", (void*)android_os_BinderInternal_dumpBinderLatencyStats }
 };
 
 const char* const kBinderInternalPathName = "com/android/internal/os/BinderInternal";
@@ -1409,10 +1541,18 @@ static jboolean android_os_BinderProxy_transact(JNIEnv* env, jobject obj,
         }
     }
 
+    const bool sample_latency = BinderLatencyStats::shouldSample();
+    const nsecs_t start_ns = sample_latency ? systemTime(SYSTEM_TIME_MONOTONIC) : 0;
+
     //printf("Transact from Java code to %p sending: ", target); data->print();
     status_t err = target->transact(code, *data, reply, flags);
     //if (reply) printf("Transact from Java code to %p received: ", target); reply->print();
 
+    if (sample_latency) {
+        gBinderLatencyStats.record(false /* incoming */, target->getInterfaceDescriptor(), code,
+                systemTime(SYSTEM_TIME_MONOTONIC) - start_ns);
+    }
+
     if (kEnableBinderSample) {
         if (time_binder_calls) {
             conditionally_log_binder_call(start_millis, target, code);
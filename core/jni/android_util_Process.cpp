@@ -43,6 +43,7 @@
 
 #include "android_util_Binder.h"
 #include <nativehelper/JNIHelp.h>
+#include <nativehelper/ScopedUtfChars.h>
 #include "android_os_Debug.h"
 
 #include <dirent.h>
@@ -980,6 +981,15 @@ enum {
     PROC_OUT_FLOAT = 0x4000,
 };
 
+// Parses one proc line with already-pinned format and output arrays.
+// outStrings may be NULL when the caller only wants primitive fields.
+static jboolean parseProcLineFields(JNIEnv* env, char* buffer, jint startIndex, jint endIndex,
+        const jint* formatData, jsize NF, jobjectArray outStrings, jsize NS,
+        jlong* longsData, jsize NL, jfloat* floatsData, jsize NR)
+{
+    return res;
+}
+
 jboolean android_os_Process_parseProcLineArray(JNIEnv* env, jobject clazz,
         char* buffer, jint startIndex, jint endIndex, jintArray format,
         jobjectArray outStrings, jlongArray outLongs, jfloatArray outFloats)
@@ -1010,6 +1020,21 @@ jboolean android_os_Process_parseProcLineArray(JNIEnv* env, jobject clazz,
         return JNI_FALSE;
     }
 
+    jboolean res = parseProcLineFields(env, buffer, startIndex, endIndex, formatData, NF,
+            outStrings, NS, longsData, NL, floatsData, NR);
+
+    env->ReleaseIntArrayElements(format, formatData, 0);
+        }
+        if (longsData != NULL) {
+            env->ReleaseLongArrayElements(outLongs, longsData, 0);
+        }
+        if (floatsData != NULL) {
+            env->ReleaseFloatArrayElements(outFloats, floatsData, 0);
+        }
+        jniThrowException(env, "java/lang/OutOfMemoryError", NULL);
+        return JNI_FALSE;
+    }
+
     jsize i = startIndex;
     jsize di = 0;
 
@@ -1119,6 +1144,50 @@ jboolean android_os_Process_parseProcLine(JNIEnv* env, jobject clazz,
         return result;
 }
 
+// Reads the whole of the proc file |fd| from offset 0 into |*buffer|,
+// growing it into |*heapBuffer| when it is too small. Returns the number
+// of bytes read, or -1 on failure (with an exception pending if out of memory).
+static ssize_t readProcFd(JNIEnv* env, int fd, char** buffer, ssize_t* bufferSize,
+        std::unique_ptr<char[]>* heapBuffer)
+{
+    // Most proc files we read are small, so we only go through the
+    // loop once and use the initial buffer.  We allocate a buffer big
+    // enough for the whole file.
+    ssize_t numberBytesRead;
+    for (;;) {
+        // By using pread, we can avoid an lseek to rewind the FD
+        // before retry, saving a system call.
+        numberBytesRead = pread(fd, *buffer, *bufferSize, 0);
+        if (numberBytesRead < 0 && errno == EINTR) {
+            continue;
+        }
+        if (numberBytesRead < 0) {
+            if (kDebugProc) {
+                ALOGW("Unable to read process file: fd=%d\n", fd);
+            }
+            return -1;
+        }
+        if (numberBytesRead < *bufferSize) {
+            break;
+        }
+        if (*bufferSize > std::numeric_limits<ssize_t>::max() / 2) {
+            if (kDebugProc) {
+                ALOGW("Proc file too big: fd=%d\n", fd);
+            }
+            return -1;
+        }
+        *bufferSize = std::max(*bufferSize * 2, kProcReadMinHeapBufferSize);
+        heapBuffer->reset();  // Free address space before getting more.
+        *heapBuffer = std::make_unique<char[]>(*bufferSize);
+        if (!*heapBuffer) {
+            jniThrowException(env, "java/lang/OutOfMemoryError", NULL);
+            return -1;
+        }
+        *buffer = heapBuffer->get();
+    }
+    return numberBytesRead;
+}
+
 jboolean android_os_Process_readProcFile(JNIEnv* env, jobject clazz,
         jstring file, jintArray format, jobjectArray outStrings,
         jlongArray outLongs, jfloatArray outFloats)
@@ -1144,52 +1213,128 @@ jboolean android_os_Process_readProcFile(JNIEnv* env, jobject clazz,
     }
     env->ReleaseStringUTFChars(file, file8);
 
-    // Most proc files we read are small, so we only go through the
-    // loop once and use the stack buffer.  We allocate a buffer big
-    // enough for the whole file.
-
     char readBufferStack[kProcReadStackBufferSize];
     std::unique_ptr<char[]> readBufferHeap;
     char* readBuffer = &readBufferStack[0];
     ssize_t readBufferSize = kProcReadStackBufferSize;
-    ssize_t numberBytesRead;
-    for (;;) {
-        // By using pread, we can avoid an lseek to rewind the FD
-        // before retry, saving a system call.
-        numberBytesRead = pread(fd, readBuffer, readBufferSize, 0);
-        if (numberBytesRead < 0 && errno == EINTR) {
-            continue;
-        }
-        if (numberBytesRead < 0) {
-            if (kDebugProc) {
-                ALOGW("Unable to open process file: %s fd=%d\n", file8, fd.get());
+    ssize_t numberBytesRead = readProcFd(env, fd, &readBuffer, &readBufferSize, &readBufferHeap);
+    if (numberBytesRead < 0) {
+        return JNI_FALSE;
+    }
+
+    // parseProcLineArray below modifies the buffer while parsing!
+    return android_os_Process_parseProcLineArray(
+        env, clazz, readBuffer, 0, numberBytesRead,
+        format, outStrings, outLongs, outFloats);
+}
+
+jint android_os_Process_openProcFile(JNIEnv* env, jobject clazz, jstring file)
+{
+    if (file == NULL) {
+        jniThrowNullPointerException(env, NULL);
+        return -1;
+    }
+
+    ScopedUtfChars file8(env, file);
+    if (file8.c_str() == NULL) {
+        return -1;
+    }
+    int fd = open(file8.c_str(), O_RDONLY | O_CLOEXEC);
+    if (fd < 0 && kDebugProc) {
+        ALOGW("Unable to open process file: %s\n", file8.c_str());
+    }
+    return fd;
+}
+
+void android_os_Process_closeProcFile(JNIEnv* env, jobject clazz, jint fd)
+{
+    if (fd >= 0) {
+        close(fd);
+    }
+}
+
+/*
+ * Re-reads every proc file in |fds| (opened with openProcFile(), read from
+ * offset 0 so the fds can be kept across updates) and parses each with the
+ * same |format|. The output fields of file i are stored at i * stride in
+ * outLongs/outFloats, where stride is the number of output fields in
+ * |format|. outOk[i] reports whether file i was read and parsed; the number
+ * of such files is returned. String fields are not supported, so nothing
+ * is allocated per file.
+ */
+jint android_os_Process_readProcFds(JNIEnv* env, jobject clazz,
+        jintArray fds, jintArray format, jlongArray outLongs, jfloatArray outFloats,
+        jbooleanArray outOk)
+{
+    if (fds == NULL || format == NULL || outOk == NULL) {
+        jniThrowNullPointerException(env, NULL);
+        return 0;
+    }
+
+    const jsize NFD = env->GetArrayLength(fds);
+    const jsize NF = env->GetArrayLength(format);
+    if (env->GetArrayLength(outOk) < NFD) {
+        jniThrowException(env, "java/lang/IllegalArgumentException", "outOk too small");
+        return 0;
+    }
+
+    std::vector<jint> fdValues(NFD);
+    env->GetIntArrayRegion(fds, 0, NFD, fdValues.data());
+    std::vector<jint> formatData(NF);
+    env->GetIntArrayRegion(format, 0, NF, formatData.data());
+
+    jsize stride = 0;
+    for (jint mode : formatData) {
+        if ((mode&(PROC_OUT_FLOAT|PROC_OUT_LONG|PROC_OUT_STRING)) != 0) {
+            if ((mode&PROC_OUT_STRING) != 0) {
+                jniThrowException(env, "java/lang/IllegalArgumentException",
+                        "PROC_OUT_STRING not supported");
+                return 0;
             }
-            return JNI_FALSE;
-        }
-        if (numberBytesRead < readBufferSize) {
-            break;
+            stride++;
         }
-        if (readBufferSize > std::numeric_limits<ssize_t>::max() / 2) {
-            if (kDebugProc) {
-                ALOGW("Proc file too big: %s fd=%d\n", file8, fd.get());
+    }
+
+    const jsize NL = outLongs ? env->GetArrayLength(outLongs) : 0;
+    const jsize NR = outFloats ? env->GetArrayLength(outFloats) : 0;
+    std::vector<jlong> longsData(NL);
+    std::vector<jfloat> floatsData(NR);
+    std::vector<jboolean> okData(NFD, JNI_FALSE);
+
+    char readBufferStack[kProcReadStackBufferSize];
+    std::unique_ptr<char[]> readBufferHeap;
+    char* readBuffer = &readBufferStack[0];
+    ssize_t readBufferSize = kProcReadStackBufferSize;
+
+    jint okCount = 0;
+    for (jsize i = 0; i < NFD; i++) {
+        const jsize offset = i * stride;
+        ssize_t numberBytesRead = readProcFd(env, fdValues[i], &readBuffer, &readBufferSize,
+                &readBufferHeap);
+        if (numberBytesRead < 0) {
+            if (env->ExceptionCheck()) {
+                return 0;
             }
-            return JNI_FALSE;
+            continue;
         }
-        readBufferSize = std::max(readBufferSize * 2,
-                                  kProcReadMinHeapBufferSize);
-        readBufferHeap.reset();  // Free address space before getting more.
-        readBufferHeap = std::make_unique<char[]>(readBufferSize);
-        if (!readBufferHeap) {
-            jniThrowException(env, "java/lang/OutOfMemoryError", NULL);
-            return JNI_FALSE;
+        // parseProcLineFields modifies the buffer while parsing!
+        okData[i] = parseProcLineFields(env, readBuffer, 0, numberBytesRead,
+                formatData.data(), NF, NULL, 0,
+                offset < NL ? &longsData[offset] : NULL, std::max(0, std::min(stride, NL - offset)),
+                offset < NR ? &floatsData[offset] : NULL, std::max(0, std::min(stride, NR - offset)));
+        if (okData[i]) {
+            okCount++;
         }
-        readBuffer = readBufferHeap.get();
     }
 
-    // parseProcLineArray below modifies the buffer while parsing!
-    return android_os_Process_parseProcLineArray(
-        env, clazz, readBuffer, 0, numberBytesRead,
-        format, outStrings, outLongs, outFloats);
+    if (NL > 0) {
+        env->SetLongArrayRegion(outLongs, 0, NL, longsData.data());
+    }
+    if (NR > 0) {
+        env->SetFloatArrayRegion(outFloats, 0, NR, floatsData.data());
+    }
+    env->SetBooleanArrayRegion(outOk, 0, NFD, okData.data());
+    return okCount;
 }
 
 void android_os_Process_setApplicationObject(JNIEnv* env, jobject clazz,
@@ -1438,6 +1583,9 @@ static const JNINativeMethod methods[] = {
          (void*)android_os_Process_readProcFile},
         {"parseProcLine", "([BII[I[Ljava/lang/String;[J[F)Z",
          (void*)android_os_Process_parseProcLine},
+        {"openProcFile", "(Ljava/lang/String;)I", (void*)android_os_Process_openProcFile},
+        {"closeProcFile", "(I)V", (void*)android_os_Process_closeProcFile},
+        {"readProcFds", "([I[I[J[F[Z)I", (void*)android_os_Process_readProcFds},
         {"getElapsedCpuTime", "()J", (void*)android_os_Process_getElapsedCpuTime},
         {"getPss", "(I)J", (void*)android_os_Process_getPss},
         {"getRss", "(I)[J", (void*)android_os_Process_getRss},
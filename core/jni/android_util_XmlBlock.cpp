@@ -27,6 +27,8 @@
 
 #include <stdio.h>
 
+#include <algorithm>
+
 namespace android {
 
 // ----------------------------------------------------------------------------
@@ -126,6 +128,70 @@ bad:
     return ResXMLParser::BAD_DOCUMENT;
 }
 
+// Layout of the int array filled by nativeNextWithAttributes().  These must be
+// kept in sync with XmlBlock.java.
+enum {
+    START_TAG_NAMESPACE = 0,
+    START_TAG_NAME = 1,
+    START_TAG_LINE_NUMBER = 2,
+    START_TAG_ATTRIBUTE_COUNT = 3,
+    START_TAG_HEADER_SIZE = 4,
+
+    ATTRIBUTE_NAMESPACE = 0,
+    ATTRIBUTE_NAME = 1,
+    ATTRIBUTE_RESOURCE = 2,
+    ATTRIBUTE_DATA_TYPE = 3,
+    ATTRIBUTE_DATA = 4,
+    ATTRIBUTE_STRING_VALUE = 5,
+    ATTRIBUTE_SIZE = 6,
+};
+
+/*
+ * Advances the parser like nativeNext().  When it lands on a start tag, the
+ * element and all of its attributes are also written to |outData| (see the
+ * layout above), so inflating a view does not need a JNI call per attribute
+ * getter.  The attribute count is always the element's full count; only as
+ * many attributes as fit in |outData| are written.
+ */
+static jint android_content_XmlBlock_nativeNextWithAttributes(JNIEnv* env, jobject clazz,
+                                                              jlong token, jintArray outData)
+{
+    jint event = android_content_XmlBlock_nativeNext(env, clazz, token);
+    if (event != 2 /* START_TAG */ || outData == NULL) {
+        return event;
+    }
+
+    ResXMLParser* st = reinterpret_cast<ResXMLParser*>(token);
+    const jsize capacity = env->GetArrayLength(outData);
+    if (capacity < START_TAG_HEADER_SIZE) {
+        return event;
+    }
+
+    const size_t count = st->getAttributeCount();
+    const size_t written = std::min<size_t>(count,
+            (capacity - START_TAG_HEADER_SIZE) / ATTRIBUTE_SIZE);
+    jint* data = static_cast<jint*>(env->GetPrimitiveArrayCritical(outData, NULL));
+    if (data == NULL) {
+        return event;
+    }
+
+    data[START_TAG_NAMESPACE] = static_cast<jint>(st->getElementNamespaceID());
+    data[START_TAG_NAME] = static_cast<jint>(st->getElementNameID());
+    data[START_TAG_LINE_NUMBER] = static_cast<jint>(st->getLineNumber());
+    data[START_TAG_ATTRIBUTE_COUNT] = static_cast<jint>(count);
+    for (size_t i = 0; i < written; i++) {
+        jint* attr = &data[START_TAG_HEADER_SIZE + i * ATTRIBUTE_SIZE];
+        attr[ATTRIBUTE_NAMESPACE] = static_cast<jint>(st->getAttributeNamespaceID(i));
+        attr[ATTRIBUTE_NAME] = static_cast<jint>(st->getAttributeNameID(i));
+        attr[ATTRIBUTE_RESOURCE] = static_cast<jint>(st->getAttributeNameResID(i));
+        attr[ATTRIBUTE_DATA_TYPE] = static_cast<jint>(st->getAttributeDataType(i));
+        attr[ATTRIBUTE_DATA] = static_cast<jint>(st->getAttributeData(i));
+        attr[ATTRIBUTE_STRING_VALUE] = static_cast<jint>(st->getAttributeValueStringID(i));
+    }
+    env->ReleasePrimitiveArrayCritical(outData, data, 0);
+    return event;
+}
+
 static jint android_content_XmlBlock_nativeGetNamespace(JNIEnv* env, jobject clazz,
                                                    jlong token)
 {
@@ -393,6 +459,8 @@ static const JNINativeMethod gXmlBlockMethods[] = {
 
     { "nativeNext",                 "(J)I",
             (void*) android_content_XmlBlock_nativeNext },
+    { "nativeNextWithAttributes",   "(J[I)I",
+            (void*) android_content_XmlBlock_nativeNextWithAttributes },
     { "nativeGetNamespace",         "(J)I",
             (void*) android_content_XmlBlock_nativeGetNamespace },
     { "nativeGetName",              "(J)I",
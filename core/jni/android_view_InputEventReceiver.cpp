@@ -20,6 +20,8 @@
 
 #include <inttypes.h>
 
+#include <vector>
+
 #include <nativehelper/JNIHelp.h>
 
 #include <android_runtime/AndroidRuntime.h>
@@ -40,6 +42,10 @@ namespace android {
 
 static const bool kDebugDispatchCycle = false;
 
+// Upper bound on the events delivered by one dispatchInputEvents() upcall when
+// batched dispatch is enabled.  Each pending event holds a JNI local reference.
+static const size_t kMaxDispatchBatchSize = 32;
+
 static const char* toString(bool value) {
     return value ? "true" : "false";
 }
@@ -48,11 +54,16 @@ static struct {
     jclass clazz;
 
     jmethodID dispatchInputEvent;
+    jmethodID dispatchInputEvents;
     jmethodID onFocusEvent;
     jmethodID onBatchedInputEventPending;
     jmethodID dispatchMotionEventInfo;
 } gInputEventReceiverClassInfo;
 
+static struct {
+    jclass clazz;
+} gInputEventClassInfo;
+
 
 class NativeInputEventReceiver : public LooperCallback {
 public:
@@ -65,6 +76,7 @@ public:
     status_t finishInputEvent(uint32_t seq, bool handled);
     status_t consumeEvents(JNIEnv* env, bool consumeBatches, nsecs_t frameTime,
             bool* outConsumedBatch);
+    void setBatchedDispatch(bool enabled) { mBatchedDispatch = enabled; }
 
 protected:
     virtual ~NativeInputEventReceiver();
@@ -84,8 +96,13 @@ private:
     Vector<Finish> mFinishQueue;
     int mLastMotionEventType = -1;
     int mLastTouchMoveNum = -1;
+    // When set, key and motion events consumed together are delivered to Java
+    // in one dispatchInputEvents() upcall instead of one upcall per event.
+    bool mBatchedDispatch = false;
 
     void setFdEvents(int events);
+    bool dispatchInputEventBatch(JNIEnv* env, jobject receiverObj,
+            std::vector<jint>& seqs, std::vector<jobject>& events);
 
     const std::string getInputChannelName() {
         return mInputConsumer.getChannel()->getName();
@@ -223,6 +240,51 @@ int NativeInputEventReceiver::handleEvent(int receiveFd, int events, void* data)
     return 1;
 }
 
+// Delivers the pending |events| (local refs, consumed in order) with one upcall
+// and clears both vectors.  Returns false if the upcall threw.
+bool NativeInputEventReceiver::dispatchInputEventBatch(JNIEnv* env, jobject receiverObj,
+        std::vector<jint>& seqs, std::vector<jobject>& events) {
+    if (seqs.empty()) {
+        return true;
+    }
+
+    if (kDebugDispatchCycle) {
+        ALOGD("channel '%s' ~ Dispatching batch of %zu input events.",
+              getInputChannelName().c_str(), seqs.size());
+    }
+
+    bool dispatched = false;
+    ScopedLocalRef<jintArray> seqArray(env, env->NewIntArray(seqs.size()));
+    ScopedLocalRef<jobjectArray> eventArray(env,
+            env->NewObjectArray(events.size(), gInputEventClassInfo.clazz, nullptr));
+    if (seqArray.get() && eventArray.get()) {
+        env->SetIntArrayRegion(seqArray.get(), 0, seqs.size(), seqs.data());
+        for (size_t i = 0; i < events.size(); i++) {
+            env->SetObjectArrayElement(eventArray.get(), i, events[i]);
+        }
+        env->CallVoidMethod(receiverObj, gInputEventReceiverClassInfo.dispatchInputEvents,
+                seqArray.get(), eventArray.get());
+        dispatched = true;
+    }
+
+    if (env->ExceptionCheck()) {
+        ALOGE("Exception dispatching input events.");
+        if (!dispatched) {
+            // The events never reached Java, so nobody else will finish them.
+            for (jint seq : seqs) {
+                mInputConsumer.sendFinishedSignal(seq, false);
+            }
+        }
+    }
+
+    for (jobject event : events) {
+        env->DeleteLocalRef(event);
+    }
+    seqs.clear();
+    events.clear();
+    return !env->ExceptionCheck();
+}
+
 status_t NativeInputEventReceiver::consumeEvents(JNIEnv* env,
         bool consumeBatches, nsecs_t frameTime, bool* outConsumedBatch) {
     if (kDebugDispatchCycle) {
@@ -239,6 +301,8 @@ status_t NativeInputEventReceiver::consumeEvents(JNIEnv* env,
 
     ScopedLocalRef<jobject> receiverObj(env, nullptr);
     bool skipCallbacks = false;
+    std::vector<jint> batchSeqs;
+    std::vector<jobject> batchEvents;
     for (;;) {
         uint32_t seq;
         int motionEventType = -1;
@@ -262,8 +326,13 @@ status_t NativeInputEventReceiver::consumeEvents(JNIEnv* env,
 
         if (flag && ((mLastMotionEventType != motionEventType) ||
                (mLastTouchMoveNum != touchMoveNum))) {
-           env->CallVoidMethod(receiverObj.get(),
-               gInputEventReceiverClassInfo.dispatchMotionEventInfo, motionEventType, touchMoveNum);
+           if (!dispatchInputEventBatch(env, receiverObj.get(), batchSeqs, batchEvents)) {
+               skipCallbacks = true;
+           } else {
+               env->CallVoidMethod(receiverObj.get(),
+                   gInputEventReceiverClassInfo.dispatchMotionEventInfo, motionEventType,
+                   touchMoveNum);
+           }
            mLastMotionEventType = motionEventType;
            mLastTouchMoveNum = touchMoveNum;
            flag = false;
@@ -272,10 +341,14 @@ status_t NativeInputEventReceiver::consumeEvents(JNIEnv* env,
         if (status != OK && status != WOULD_BLOCK) {
             ALOGE("channel '%s' ~ Failed to consume input event.  status=%d",
                   getInputChannelName().c_str(), status);
+            dispatchInputEventBatch(env, receiverObj.get(), batchSeqs, batchEvents);
             return status;
         }
 
         if (status == WOULD_BLOCK) {
+            if (!dispatchInputEventBatch(env, receiverObj.get(), batchSeqs, batchEvents)) {
+                skipCallbacks = true;
+            }
             if (!skipCallbacks && !mBatchedInputEventPending && mInputConsumer.hasPendingBatch()) {
                 // There is a pending batch.  Come back later.
                 if (!receiverObj.get()) {
@@ -344,6 +417,11 @@ status_t NativeInputEventReceiver::consumeEvents(JNIEnv* env,
                           getInputChannelName().c_str(), toString(focusEvent->getHasFocus()),
                           toString(focusEvent->getInTouchMode()));
                 }
+                if (!dispatchInputEventBatch(env, receiverObj.get(), batchSeqs, batchEvents)) {
+                    skipCallbacks = true;
+                    finishInputEvent(seq, false /* handled */);
+                    continue;
+                }
                 env->CallVoidMethod(receiverObj.get(), gInputEventReceiverClassInfo.onFocusEvent,
                                     jboolean(focusEvent->getHasFocus()),
                                     jboolean(focusEvent->getInTouchMode()));
@@ -356,7 +434,16 @@ status_t NativeInputEventReceiver::consumeEvents(JNIEnv* env,
                 inputEventObj = nullptr;
             }
 
-            if (inputEventObj) {
+            if (inputEventObj && mBatchedDispatch) {
+                batchSeqs.push_back(seq);
+                batchEvents.push_back(inputEventObj);
+                if (batchSeqs.size() >= kMaxDispatchBatchSize
+                        && !dispatchInputEventBatch(env, receiverObj.get(), batchSeqs,
+                                                    batchEvents)) {
+                    skipCallbacks = true;
+                }
+                continue;
+            } else if (inputEventObj) {
                 if (kDebugDispatchCycle) {
                     ALOGD("channel '%s' ~ Dispatching input event.", getInputChannelName().c_str());
                 }
@@ -429,6 +516,13 @@ static void nativeFinishInputEvent(JNIEnv* env, jclass clazz, jlong receiverPtr,
     }
 }
 
+static void nativeSetBatchedDispatch(JNIEnv* env, jclass clazz, jlong receiverPtr,
+        jboolean enabled) {
+    sp<NativeInputEventReceiver> receiver =
+            reinterpret_cast<NativeInputEventReceiver*>(receiverPtr);
+    receiver->setBatchedDispatch(enabled);
+}
+
 static jboolean nativeConsumeBatchedInputEvents(JNIEnv* env, jclass clazz, jlong receiverPtr,
         jlong frameTimeNanos) {
     sp<NativeInputEventReceiver> receiver =
@@ -457,6 +551,8 @@ static const JNINativeMethod gMethods[] = {
             (void*)nativeFinishInputEvent },
     { "nativeConsumeBatchedInputEvents", "(JJ)Z",
             (void*)nativeConsumeBatchedInputEvents },
+    { "nativeSetBatchedDispatch", "(JZ)V",
+            (void*)nativeSetBatchedDispatch },
 };
 
 int register_android_view_InputEventReceiver(JNIEnv* env) {
@@ -469,6 +565,9 @@ int register_android_view_InputEventReceiver(JNIEnv* env) {
     gInputEventReceiverClassInfo.dispatchInputEvent = GetMethodIDOrDie(env,
             gInputEventReceiverClassInfo.clazz,
             "dispatchInputEvent", "(ILandroid/view/InputEvent;)V");
+    gInputEventReceiverClassInfo.dispatchInputEvents = GetMethodIDOrDie(env,
+            gInputEventReceiverClassInfo.clazz,
+            "dispatchInputEvents", "([I[Landroid/view/InputEvent;)V");
     gInputEventReceiverClassInfo.onFocusEvent =
             GetMethodIDOrDie(env, gInputEventReceiverClassInfo.clazz, "onFocusEvent", "(ZZ)V");
     gInputEventReceiverClassInfo.onBatchedInputEventPending =
@@ -477,6 +576,9 @@ int register_android_view_InputEventReceiver(JNIEnv* env) {
     gInputEventReceiverClassInfo.dispatchMotionEventInfo = GetMethodIDOrDie(env,
             gInputEventReceiverClassInfo.clazz, "dispatchMotionEventInfo", "(II)V");
 
+    jclass inputEventClazz = FindClassOrDie(env, "android/view/InputEvent");
+    gInputEventClassInfo.clazz = MakeGlobalRefOrDie(env, inputEventClazz);
+
     return res;
 }
 
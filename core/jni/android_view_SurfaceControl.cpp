@@ -34,6 +34,7 @@
 #include <gui/SurfaceComposerClient.h>
 #include <jni.h>
 #include <nativehelper/JNIHelp.h>
+#include <nativehelper/ScopedPrimitiveArray.h>
 #include <nativehelper/ScopedUtfChars.h>
 #include <private/gui/ComposerService.h>
 #include <stdio.h>
@@ -543,6 +544,95 @@ static void nativeSetMetadata(JNIEnv* env, jclass clazz, jlong transactionObj,
     transaction->setMetadata(ctrl, id, *parcel);
 }
 
+// The 1:1 mapping of LAYER_PROPERTY_* enums here must match with the constants
+// from SurfaceControl.java.  Each property consumes the listed number of values.
+enum {
+    LAYER_PROPERTY_POSITION = 0,      // x, y
+    LAYER_PROPERTY_ALPHA = 1,         // alpha
+    LAYER_PROPERTY_MATRIX = 2,        // dsdx, dtdx, dtdy, dsdy
+    LAYER_PROPERTY_WINDOW_CROP = 3,   // left, top, right, bottom
+    LAYER_PROPERTY_CORNER_RADIUS = 4, // radius
+    LAYER_PROPERTY_SHADOW_RADIUS = 5, // radius
+};
+
+static int valueCountForLayerProperty(jint property) {
+    switch (property) {
+        case LAYER_PROPERTY_POSITION:
+            return 2;
+        case LAYER_PROPERTY_ALPHA:
+        case LAYER_PROPERTY_CORNER_RADIUS:
+        case LAYER_PROPERTY_SHADOW_RADIUS:
+            return 1;
+        case LAYER_PROPERTY_MATRIX:
+        case LAYER_PROPERTY_WINDOW_CROP:
+            return 4;
+        default:
+            return -1;
+    }
+}
+
+/*
+ * Applies a batch of per-layer setters to a transaction in one call.  Entry i
+ * sets properties[i] on the SurfaceControl nativeObjects[i], taking its
+ * arguments in order from the next values of |values|.  Lets animations that
+ * touch many layers per frame avoid one JNI transition per setter.
+ */
+static void nativeSetLayerProperties(JNIEnv* env, jclass clazz, jlong transactionObj,
+        jlongArray nativeObjectsArray, jintArray propertiesArray, jfloatArray valuesArray) {
+    auto transaction = reinterpret_cast<SurfaceComposerClient::Transaction*>(transactionObj);
+    if (nativeObjectsArray == NULL || propertiesArray == NULL || valuesArray == NULL) {
+        doThrowNPE(env);
+        return;
+    }
+
+    ScopedLongArrayRO nativeObjects(env, nativeObjectsArray);
+    ScopedIntArrayRO properties(env, propertiesArray);
+    ScopedFloatArrayRO values(env, valuesArray);
+    if (nativeObjects.size() != properties.size()) {
+        doThrowIAE(env, "nativeObjects and properties lengths differ");
+        return;
+    }
+
+    size_t v = 0;
+    for (size_t i = 0; i < properties.size(); i++) {
+        const int count = valueCountForLayerProperty(properties[i]);
+        if (count < 0) {
+            doThrowIAE(env, "Unknown layer property");
+            return;
+        }
+        if (v + count > values.size()) {
+            doThrowIAE(env, "Not enough values for layer properties");
+            return;
+        }
+
+        SurfaceControl* const ctrl = reinterpret_cast<SurfaceControl *>(nativeObjects[i]);
+        const jfloat* const value = &values[v];
+        switch (properties[i]) {
+            case LAYER_PROPERTY_POSITION:
+                transaction->setPosition(ctrl, value[0], value[1]);
+                break;
+            case LAYER_PROPERTY_ALPHA:
+                transaction->setAlpha(ctrl, value[0]);
+                break;
+            case LAYER_PROPERTY_MATRIX:
+                transaction->setMatrix(ctrl, value[0], value[1], value[2], value[3]);
+                break;
+            case LAYER_PROPERTY_WINDOW_CROP:
+                transaction->setCrop_legacy(ctrl, Rect(static_cast<int32_t>(value[0]),
+                        static_cast<int32_t>(value[1]), static_cast<int32_t>(value[2]),
+                        static_cast<int32_t>(value[3])));
+                break;
+            case LAYER_PROPERTY_CORNER_RADIUS:
+                transaction->setCornerRadius(ctrl, value[0]);
+                break;
+            case LAYER_PROPERTY_SHADOW_RADIUS:
+                transaction->setShadowRadius(ctrl, value[0]);
+                break;
+        }
+        v += count;
+    }
+}
+
 static void nativeSetColor(JNIEnv* env, jclass clazz, jlong transactionObj,
         jlong nativeObject, jfloatArray fColor) {
     auto transaction = reinterpret_cast<SurfaceComposerClient::Transaction*>(transactionObj);
@@ -1531,6 +1621,8 @@ static const JNINativeMethod sSurfaceControlMethods[] = {
             (void*)nativeSetColor },
     {"nativeSetMatrix", "(JJFFFF)V",
             (void*)nativeSetMatrix },
+    {"nativeSetLayerProperties", "(J[J[I[F)V",
+            (void*)nativeSetLayerProperties },
     {"nativeSetColorTransform", "(JJ[F[F)V",
             (void*)nativeSetColorTransform },
     {"nativeSetColorSpaceAgnostic", "(JJZ)V",
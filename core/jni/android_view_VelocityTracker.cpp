@@ -18,6 +18,8 @@
 
 #include <nativehelper/JNIHelp.h>
 
+#include <algorithm>
+
 #include <android_runtime/AndroidRuntime.h>
 #include <utils/Log.h>
 #include <input/Input.h>
@@ -51,6 +53,7 @@ public:
     void addMovement(const MotionEvent* event);
     void computeCurrentVelocity(int32_t units, float maxVelocity);
     void getVelocity(int32_t id, float* outVx, float* outVy);
+    size_t getVelocities(int32_t* outIds, float* outVelocities, size_t maxPointers);
     bool getEstimator(int32_t id, VelocityTracker::Estimator* outEstimator);
 
 private:
@@ -62,20 +65,28 @@ private:
     int32_t mActivePointerId;
     BitSet32 mCalculatedIdBits;
     Velocity mCalculatedVelocity[MAX_POINTERS];
+
+    // Unscaled fits (pixels per millisecond) from the last computation.  The
+    // least-squares fits only change when movements are added or cleared, so
+    // repeated computeCurrentVelocity() calls in between just rescale these.
+    bool mRawVelocityValid;
+    Velocity mRawVelocity[MAX_POINTERS];
 };
 
 VelocityTrackerState::VelocityTrackerState(const char* strategy) :
-        mVelocityTracker(strategy), mActivePointerId(-1) {
+        mVelocityTracker(strategy), mActivePointerId(-1), mRawVelocityValid(false) {
 }
 
 void VelocityTrackerState::clear() {
     mVelocityTracker.clear();
     mActivePointerId = -1;
     mCalculatedIdBits.clear();
+    mRawVelocityValid = false;
 }
 
 void VelocityTrackerState::addMovement(const MotionEvent* event) {
     mVelocityTracker.addMovement(event);
+    mRawVelocityValid = false;
 }
 
 void VelocityTrackerState::computeCurrentVelocity(int32_t units, float maxVelocity) {
@@ -85,8 +96,12 @@ void VelocityTrackerState::computeCurrentVelocity(int32_t units, float maxVeloci
     for (uint32_t index = 0; !idBits.isEmpty(); index++) {
         uint32_t id = idBits.clearFirstMarkedBit();
 
-        float vx, vy;
-        mVelocityTracker.getVelocity(id, &vx, &vy);
+        Velocity& rawVelocity = mRawVelocity[index];
+        if (!mRawVelocityValid) {
+            mVelocityTracker.getVelocity(id, &rawVelocity.vx, &rawVelocity.vy);
+        }
+        float vx = rawVelocity.vx;
+        float vy = rawVelocity.vy;
 
         vx = vx * units / 1000;
         vy = vy * units / 1000;
@@ -106,6 +121,7 @@ void VelocityTrackerState::computeCurrentVelocity(int32_t units, float maxVeloci
         velocity.vx = vx;
         velocity.vy = vy;
     }
+    mRawVelocityValid = true;
 }
 
 void VelocityTrackerState::getVelocity(int32_t id, float* outVx, float* outVy) {
@@ -132,6 +148,19 @@ void VelocityTrackerState::getVelocity(int32_t id, float* outVx, float* outVy) {
     }
 }
 
+size_t VelocityTrackerState::getVelocities(int32_t* outIds, float* outVelocities,
+        size_t maxPointers) {
+    BitSet32 idBits(mCalculatedIdBits);
+    size_t count = 0;
+    for (uint32_t index = 0; !idBits.isEmpty() && count < maxPointers; index++) {
+        outIds[count] = idBits.clearFirstMarkedBit();
+        outVelocities[count * 2] = mCalculatedVelocity[index].vx;
+        outVelocities[count * 2 + 1] = mCalculatedVelocity[index].vy;
+        count++;
+    }
+    return count;
+}
+
 bool VelocityTrackerState::getEstimator(int32_t id, VelocityTracker::Estimator* outEstimator) {
     return mVelocityTracker.getEstimator(id, outEstimator);
 }
@@ -192,6 +221,27 @@ static jfloat android_view_VelocityTracker_nativeGetYVelocity(JNIEnv* env, jclas
     return vy;
 }
 
+/*
+ * Copies the velocities from the last computeCurrentVelocity() for all pointers
+ * at once: outIds[i] receives a pointer id and outVelocities[2 * i] and
+ * [2 * i + 1] its x and y velocity.  Returns the number of pointers written.
+ */
+static jint android_view_VelocityTracker_nativeGetVelocities(JNIEnv* env, jclass clazz,
+        jlong ptr, jintArray outIdsObj, jfloatArray outVelocitiesObj) {
+    VelocityTrackerState* state = reinterpret_cast<VelocityTrackerState*>(ptr);
+    const size_t maxPointers = std::min<size_t>(env->GetArrayLength(outIdsObj),
+            env->GetArrayLength(outVelocitiesObj) / 2);
+
+    int32_t ids[MAX_POINTERS];
+    float velocities[MAX_POINTERS * 2];
+    size_t count = state->getVelocities(ids, velocities,
+            std::min<size_t>(maxPointers, MAX_POINTERS));
+
+    env->SetIntArrayRegion(outIdsObj, 0, count, ids);
+    env->SetFloatArrayRegion(outVelocitiesObj, 0, count * 2, velocities);
+    return count;
+}
+
 static jboolean android_view_VelocityTracker_nativeGetEstimator(JNIEnv* env, jclass clazz,
         jlong ptr, jint id, jobject outEstimatorObj) {
     VelocityTrackerState* state = reinterpret_cast<VelocityTrackerState*>(ptr);
@@ -238,6 +288,9 @@ static const JNINativeMethod gVelocityTrackerMethods[] = {
     { "nativeGetYVelocity",
             "(JI)F",
             (void*)android_view_VelocityTracker_nativeGetYVelocity },
+    { "nativeGetVelocities",
+            "(J[I[F)I",
+            (void*)android_view_VelocityTracker_nativeGetVelocities },
     { "nativeGetEstimator",
             "(JILandroid/view/VelocityTracker$Estimator;)Z",
             (void*)android_view_VelocityTracker_nativeGetEstimator },
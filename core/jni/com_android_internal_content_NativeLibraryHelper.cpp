@@ -37,7 +37,12 @@
 #include <sys/stat.h>
 #include <sys/types.h>
 
+#include <algorithm>
+#include <atomic>
 #include <memory>
+#include <string>
+#include <thread>
+#include <vector>
 
 #define APK_LIB "lib/"
 #define APK_LIB_LEN (sizeof(APK_LIB) - 1)
@@ -53,6 +58,9 @@
 #define TMP_FILE_PATTERN "/tmp.XXXXXX"
 #define TMP_FILE_PATTERN_LEN (sizeof(TMP_FILE_PATTERN) - 1)
 
+// The maximum number of threads that extract native libraries concurrently.
+#define MAX_EXTRACTION_THREADS 4
+
 namespace android {
 
 // These match PackageManager.java install codes
@@ -171,14 +179,9 @@ sumFiles(JNIEnv*, void* arg, ZipFileRO* zipFile, ZipEntryRO zipEntry, const char
  * This function assumes the library and path names passed in are considered safe.
  */
 static install_status_t
-copyFileIfChanged(JNIEnv *env, void* arg, ZipFileRO* zipFile, ZipEntryRO zipEntry, const char* fileName)
+copyFileIfChanged(const char* nativeLibPath, size_t nativeLibPathLen, bool extractNativeLibs,
+        ZipFileRO* zipFile, ZipEntryRO zipEntry, const char* fileName)
 {
-    void** args = reinterpret_cast<void**>(arg);
-    jstring* javaNativeLibPath = (jstring*) args[0];
-    jboolean extractNativeLibs = *(jboolean*) args[1];
-
-    ScopedUtfChars nativeLibPath(env, *javaNativeLibPath);
-
     uint32_t uncompLen;
     uint32_t when;
     uint32_t crc;
@@ -210,17 +213,17 @@ copyFileIfChanged(JNIEnv *env, void* arg, ZipFileRO* zipFile, ZipEntryRO zipEntr
 
     // Build local file path
     const size_t fileNameLen = strlen(fileName);
-    char localFileName[nativeLibPath.size() + fileNameLen + 2];
+    char localFileName[nativeLibPathLen + fileNameLen + 2];
 
-    if (strlcpy(localFileName, nativeLibPath.c_str(), sizeof(localFileName)) != nativeLibPath.size()) {
+    if (strlcpy(localFileName, nativeLibPath, sizeof(localFileName)) != nativeLibPathLen) {
         ALOGE("Couldn't allocate local file name for library");
         return INSTALL_FAILED_INTERNAL_ERROR;
     }
 
-    *(localFileName + nativeLibPath.size()) = '/';
+    *(localFileName + nativeLibPathLen) = '/';
 
-    if (strlcpy(localFileName + nativeLibPath.size() + 1, fileName, sizeof(localFileName)
-                    - nativeLibPath.size() - 1) != fileNameLen) {
+    if (strlcpy(localFileName + nativeLibPathLen + 1, fileName, sizeof(localFileName)
+                    - nativeLibPathLen - 1) != fileNameLen) {
         ALOGE("Couldn't allocate local file name for library");
         return INSTALL_FAILED_INTERNAL_ERROR;
     }
@@ -234,14 +237,14 @@ copyFileIfChanged(JNIEnv *env, void* arg, ZipFileRO* zipFile, ZipEntryRO zipEntr
         return INSTALL_SUCCEEDED;
     }
 
-    char localTmpFileName[nativeLibPath.size() + TMP_FILE_PATTERN_LEN + 1];
-    if (strlcpy(localTmpFileName, nativeLibPath.c_str(), sizeof(localTmpFileName))
-            != nativeLibPath.size()) {
+    char localTmpFileName[nativeLibPathLen + TMP_FILE_PATTERN_LEN + 1];
+    if (strlcpy(localTmpFileName, nativeLibPath, sizeof(localTmpFileName))
+            != nativeLibPathLen) {
         ALOGE("Couldn't allocate local file name for library");
         return INSTALL_FAILED_INTERNAL_ERROR;
     }
 
-    if (strlcpy(localTmpFileName + nativeLibPath.size(), TMP_FILE_PATTERN,
+    if (strlcpy(localTmpFileName + nativeLibPathLen, TMP_FILE_PATTERN,
                     TMP_FILE_PATTERN_LEN + 1) != TMP_FILE_PATTERN_LEN) {
         ALOGE("Couldn't allocate temporary file name for library");
         return INSTALL_FAILED_INTERNAL_ERROR;
@@ -293,6 +296,83 @@ copyFileIfChanged(JNIEnv *env, void* arg, ZipFileRO* zipFile, ZipEntryRO zipEntr
     return INSTALL_SUCCEEDED;
 }
 
+static install_status_t
+copyFileIfChanged(JNIEnv *env, void* arg, ZipFileRO* zipFile, ZipEntryRO zipEntry, const char* fileName)
+{
+    void** args = reinterpret_cast<void**>(arg);
+    jstring* javaNativeLibPath = (jstring*) args[0];
+    jboolean extractNativeLibs = *(jboolean*) args[1];
+
+    ScopedUtfChars nativeLibPath(env, *javaNativeLibPath);
+    return copyFileIfChanged(nativeLibPath.c_str(), nativeLibPath.size(), extractNativeLibs,
+            zipFile, zipEntry, fileName);
+}
+
+static install_status_t
+collectEntryName(JNIEnv*, void* arg, ZipFileRO* zipFile, ZipEntryRO zipEntry, const char*)
+{
+    std::vector<std::string>* entryNames = reinterpret_cast<std::vector<std::string>*>(arg);
+
+    char entryName[PATH_MAX];
+    if (zipFile->getEntryFileName(zipEntry, entryName, sizeof(entryName))) {
+        return INSTALL_FAILED_INVALID_APK;
+    }
+    entryNames->push_back(entryName);
+
+    return INSTALL_SUCCEEDED;
+}
+
+/*
+ * Extracts the named native libraries that changed, using a small pool of threads since
+ * inflating large libraries is CPU bound. Returns the failure of one of the libraries that
+ * could not be extracted, if any.
+ */
+static install_status_t
+copyFilesIfChanged(const char* nativeLibPath, size_t nativeLibPathLen, ZipFileRO* zipFile,
+        const std::vector<std::string>& entryNames)
+{
+    std::atomic<size_t> nextEntry(0);
+    std::atomic<int> status(INSTALL_SUCCEEDED);
+
+    auto extract = [&]() {
+        size_t i;
+        while (status.load() == INSTALL_SUCCEEDED && (i = nextEntry++) < entryNames.size()) {
+            const std::string& entryName = entryNames[i];
+            const char* fileName = entryName.c_str() + entryName.rfind('/') + 1;
+
+            install_status_t ret = INSTALL_FAILED_INVALID_APK;
+            ZipEntryRO zipEntry = zipFile->findEntryByName(entryName.c_str());
+            if (zipEntry != NULL) {
+                ret = copyFileIfChanged(nativeLibPath, nativeLibPathLen,
+                        true /* extractNativeLibs */, zipFile, zipEntry, fileName);
+                zipFile->releaseEntry(zipEntry);
+            }
+
+            if (ret != INSTALL_SUCCEEDED) {
+                ALOGV("Failure for entry %s", fileName);
+                int expected = INSTALL_SUCCEEDED;
+                status.compare_exchange_strong(expected, ret);
+            }
+        }
+    };
+
+    const size_t hardwareThreads = std::max(1u, std::thread::hardware_concurrency());
+    const size_t threadCount = std::min({entryNames.size(), hardwareThreads,
+            static_cast<size_t>(MAX_EXTRACTION_THREADS)});
+
+    // The calling thread extracts libraries too.
+    std::vector<std::thread> threads;
+    for (size_t i = 1; i < threadCount; i++) {
+        threads.emplace_back(extract);
+    }
+    extract();
+    for (std::thread& thread : threads) {
+        thread.join();
+    }
+
+    return static_cast<install_status_t>(status.load());
+}
+
 /*
  * An iterator over all shared libraries in a zip file. An entry is
  * considered to be a shared library if all of the conditions below are
@@ -488,9 +568,26 @@ com_android_internal_content_NativeLibraryHelper_copyNativeBinaries(JNIEnv *env,
         jlong apkHandle, jstring javaNativeLibPath, jstring javaCpuAbi,
         jboolean extractNativeLibs, jboolean debuggable)
 {
-    void* args[] = { &javaNativeLibPath, &extractNativeLibs };
-    return (jint) iterateOverNativeFiles(env, apkHandle, javaCpuAbi, debuggable,
-            copyFileIfChanged, reinterpret_cast<void*>(args));
+    if (!extractNativeLibs) {
+        // Only checks that the libraries can be loaded directly from the APK.
+        void* args[] = { &javaNativeLibPath, &extractNativeLibs };
+        return (jint) iterateOverNativeFiles(env, apkHandle, javaCpuAbi, debuggable,
+                copyFileIfChanged, reinterpret_cast<void*>(args));
+    }
+
+    std::vector<std::string> entryNames;
+    install_status_t ret = iterateOverNativeFiles(env, apkHandle, javaCpuAbi, debuggable,
+            collectEntryName, &entryNames);
+    if (ret != INSTALL_SUCCEEDED) {
+        return (jint) ret;
+    }
+
+    ScopedUtfChars nativeLibPath(env, javaNativeLibPath);
+    if (nativeLibPath.c_str() == NULL) {
+        return (jint) INSTALL_FAILED_INTERNAL_ERROR;
+    }
+    return (jint) copyFilesIfChanged(nativeLibPath.c_str(), nativeLibPath.size(),
+            reinterpret_cast<ZipFileRO*>(apkHandle), entryNames);
 }
 
 static jlong
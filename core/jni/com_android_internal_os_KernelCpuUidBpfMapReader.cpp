@@ -53,6 +53,32 @@ static void copy2DVecToArray(JNIEnv *env, jlongArray ar, std::vector<std::vector
     }
 }
 
+// Packs uids and their times into a single array of |stride| longs per uid:
+// the uid followed by its times in milliseconds. |getTimes| passes each time of
+// an entry of |data| to the callback it is given. Returns NULL on failure.
+template <typename Map, typename GetTimes>
+static jlongArray packUidTimes(JNIEnv *env, Map &data, jsize timesSize, GetTimes getTimes) {
+    const jsize stride = 1 + timesSize;
+    jlongArray ar = env->NewLongArray(data.size() * stride);
+    if (ar == NULL) return NULL;
+
+    jlong *base = (jlong *)env->GetPrimitiveArrayCritical(ar, NULL);
+    if (base == NULL) return NULL;
+    jlong *out = base;
+    for (auto &[uid, times] : data) {
+        out[0] = uid;
+        jsize i = 1;
+        getTimes(times, [&](uint64_t time) {
+            if (i < stride) out[i++] = time / NSEC_PER_MSEC;
+        });
+        // uids added after the dimensions were read may report fewer values
+        while (i < stride) out[i++] = 0;
+        out += stride;
+    }
+    env->ReleasePrimitiveArrayCritical(ar, base, 0);
+    return ar;
+}
+
 static jboolean KernelCpuUidFreqTimeBpfMapReader_removeUidRange(JNIEnv *env, jclass, jint startUid,
                                                                 jint endUid) {
     for (uint32_t uid = startUid; uid <= endUid; ++uid) {
@@ -61,8 +87,10 @@ static jboolean KernelCpuUidFreqTimeBpfMapReader_removeUidRange(JNIEnv *env, jcl
     return true;
 }
 
+static uint64_t gFreqTimeLastUpdate = 0;
+
 static jboolean KernelCpuUidFreqTimeBpfMapReader_readBpfData(JNIEnv *env, jobject thiz) {
-    static uint64_t lastUpdate = 0;
+    uint64_t &lastUpdate = gFreqTimeLastUpdate;
     uint64_t newLastUpdate = lastUpdate;
     auto sparseAr = env->GetObjectField(thiz, gmData);
     if (sparseAr == NULL) return false;
@@ -82,6 +110,23 @@ static jboolean KernelCpuUidFreqTimeBpfMapReader_readBpfData(JNIEnv *env, jobjec
     return true;
 }
 
+// Packed alternative to readBpfData(): returns only the uids updated since the
+// previous read as [uid, times...] records in one array, or NULL on failure.
+static jlongArray KernelCpuUidFreqTimeBpfMapReader_readBpfDataPacked(JNIEnv *env, jobject,
+                                                                     jint timesSize) {
+    uint64_t newLastUpdate = gFreqTimeLastUpdate;
+    auto data = android::bpf::getUidsUpdatedCpuFreqTimes(&newLastUpdate);
+    if (!data.has_value()) return NULL;
+
+    jlongArray ar = packUidTimes(env, *data, timesSize, [](const auto &times, auto emit) {
+        for (const auto &subVec : times) {
+            for (uint64_t time : subVec) emit(time);
+        }
+    });
+    if (ar != NULL) gFreqTimeLastUpdate = newLastUpdate;
+    return ar;
+}
+
 static jlongArray KernelCpuUidFreqTimeBpfMapReader_getDataDimensions(JNIEnv *env, jobject) {
     auto freqs = android::bpf::getCpuFreqs();
     if (!freqs) return NULL;
@@ -100,11 +145,15 @@ static jlongArray KernelCpuUidFreqTimeBpfMapReader_getDataDimensions(JNIEnv *env
 static const JNINativeMethod gFreqTimeMethods[] = {
         {"removeUidRange", "(II)Z", (void *)KernelCpuUidFreqTimeBpfMapReader_removeUidRange},
         {"readBpfData", "()Z", (void *)KernelCpuUidFreqTimeBpfMapReader_readBpfData},
+        {"readBpfDataPacked", "(I)[J",
+         (void *)KernelCpuUidFreqTimeBpfMapReader_readBpfDataPacked},
         {"getDataDimensions", "()[J", (void *)KernelCpuUidFreqTimeBpfMapReader_getDataDimensions},
 };
 
+static uint64_t gActiveTimeLastUpdate = 0;
+
 static jboolean KernelCpuUidActiveTimeBpfMapReader_readBpfData(JNIEnv *env, jobject thiz) {
-    static uint64_t lastUpdate = 0;
+    uint64_t &lastUpdate = gActiveTimeLastUpdate;
     uint64_t newLastUpdate = lastUpdate;
     auto sparseAr = env->GetObjectField(thiz, gmData);
     if (sparseAr == NULL) return false;
@@ -123,6 +172,19 @@ static jboolean KernelCpuUidActiveTimeBpfMapReader_readBpfData(JNIEnv *env, jobj
     return true;
 }
 
+static jlongArray KernelCpuUidActiveTimeBpfMapReader_readBpfDataPacked(JNIEnv *env, jobject,
+                                                                       jint timesSize) {
+    uint64_t newLastUpdate = gActiveTimeLastUpdate;
+    auto data = android::bpf::getUidsUpdatedConcurrentTimes(&newLastUpdate);
+    if (!data.has_value()) return NULL;
+
+    jlongArray ar = packUidTimes(env, *data, timesSize, [](const auto &times, auto emit) {
+        for (uint64_t time : times.active) emit(time);
+    });
+    if (ar != NULL) gActiveTimeLastUpdate = newLastUpdate;
+    return ar;
+}
+
 static jlongArray KernelCpuUidActiveTimeBpfMapReader_getDataDimensions(JNIEnv *env, jobject) {
     jlong nCpus = get_nprocs_conf();
 
@@ -133,11 +195,15 @@ static jlongArray KernelCpuUidActiveTimeBpfMapReader_getDataDimensions(JNIEnv *e
 
 static const JNINativeMethod gActiveTimeMethods[] = {
         {"readBpfData", "()Z", (void *)KernelCpuUidActiveTimeBpfMapReader_readBpfData},
+        {"readBpfDataPacked", "(I)[J",
+         (void *)KernelCpuUidActiveTimeBpfMapReader_readBpfDataPacked},
         {"getDataDimensions", "()[J", (void *)KernelCpuUidActiveTimeBpfMapReader_getDataDimensions},
 };
 
+static uint64_t gClusterTimeLastUpdate = 0;
+
 static jboolean KernelCpuUidClusterTimeBpfMapReader_readBpfData(JNIEnv *env, jobject thiz) {
-    static uint64_t lastUpdate = 0;
+    uint64_t &lastUpdate = gClusterTimeLastUpdate;
     uint64_t newLastUpdate = lastUpdate;
     auto sparseAr = env->GetObjectField(thiz, gmData);
     if (sparseAr == NULL) return false;
@@ -157,6 +223,21 @@ static jboolean KernelCpuUidClusterTimeBpfMapReader_readBpfData(JNIEnv *env, job
     return true;
 }
 
+static jlongArray KernelCpuUidClusterTimeBpfMapReader_readBpfDataPacked(JNIEnv *env, jobject,
+                                                                        jint timesSize) {
+    uint64_t newLastUpdate = gClusterTimeLastUpdate;
+    auto data = android::bpf::getUidsUpdatedConcurrentTimes(&newLastUpdate);
+    if (!data.has_value()) return NULL;
+
+    jlongArray ar = packUidTimes(env, *data, timesSize, [](const auto &times, auto emit) {
+        for (const auto &subVec : times.policy) {
+            for (uint64_t time : subVec) emit(time);
+        }
+    });
+    if (ar != NULL) gClusterTimeLastUpdate = newLastUpdate;
+    return ar;
+}
+
 static jlongArray KernelCpuUidClusterTimeBpfMapReader_getDataDimensions(JNIEnv *env, jobject) {
     auto times = android::bpf::getUidConcurrentTimes(0);
     if (!times.has_value()) return NULL;
@@ -170,6 +251,8 @@ static jlongArray KernelCpuUidClusterTimeBpfMapReader_getDataDimensions(JNIEnv *
 
 static const JNINativeMethod gClusterTimeMethods[] = {
         {"readBpfData", "()Z", (void *)KernelCpuUidClusterTimeBpfMapReader_readBpfData},
+        {"readBpfDataPacked", "(I)[J",
+         (void *)KernelCpuUidClusterTimeBpfMapReader_readBpfDataPacked},
         {"getDataDimensions", "()[J",
          (void *)KernelCpuUidClusterTimeBpfMapReader_getDataDimensions},
 };
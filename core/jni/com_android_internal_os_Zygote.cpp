@@ -34,6 +34,7 @@
 #include <sys/types.h>
 #include <dirent.h>
 
+#include <algorithm>
 #include <array>
 #include <atomic>
 #include <functional>
@@ -88,6 +89,7 @@
 #include <selinux/android.h>
 #include <stats_socket.h>
 #include <utils/String8.h>
+#include <utils/Timers.h>
 #include <utils/Trace.h>
 #include <dlfcn.h>
 
@@ -185,6 +187,36 @@ static constexpr const char* kCurProfileDirPath = "/data/misc/profiles/cur";
  */
 static constexpr int USAP_POOL_SIZE_MAX_LIMIT = 100;
 
+/**
+ * Launch rate accounting used to size the USAP pool.  Only touched from the
+ * Zygote's main thread (via nativeRemoveUsapTableEntry and
+ * nativeGetUsapPoolRefillTarget), never from the signal handler.
+ */
+struct UsapLaunchStats {
+  /** Time of the most recent USAP specialization, or 0 if none yet. */
+  nsecs_t last_launch_ns = 0;
+
+  /** Exponentially weighted moving average of the time between launches. */
+  nsecs_t launch_interval_ewma_ns = 0;
+};
+
+static UsapLaunchStats gUsapLaunchStats;
+
+/** Weight, in 1/8ths, given to the newest launch interval in the moving average. */
+static constexpr int USAP_LAUNCH_INTERVAL_EWMA_WEIGHT = 3;
+
+/** The pool is sized to cover the launches expected within this window. */
+static constexpr nsecs_t USAP_POOL_REFILL_HORIZON_NS = s2ns(10);
+
+/** After this long without a launch the pool is allowed to shrink back to its minimum. */
+static constexpr nsecs_t USAP_POOL_IDLE_TIMEOUT_NS = s2ns(120);
+
+/**
+ * Memory PSI "some" avg10 percentage above which the pool is kept at its
+ * minimum size, as pre-forked processes would only add to the pressure.
+ */
+static constexpr float USAP_POOL_MEMORY_PRESSURE_THRESHOLD = 10.0f;
+
 /** The numeric value for the maximum priority a process may possess. */
 static constexpr int PROCESS_PRIORITY_MAX = -20;
 
@@ -2348,7 +2380,80 @@ static jintArray com_android_internal_os_Zygote_nativeGetUsapPipeFDs(JNIEnv* env
  */
 static jboolean com_android_internal_os_Zygote_nativeRemoveUsapTableEntry(JNIEnv* env, jclass,
                                                                           jint usap_pid) {
-  return RemoveUsapTableEntry(usap_pid);
+  if (!RemoveUsapTableEntry(usap_pid)) {
+    return false;
+  }
+
+  // The ZygoteServer only removes entries for USAPs that have been handed an
+  // application, so each removal here is one launch served from the pool.
+  const nsecs_t now = systemTime(SYSTEM_TIME_MONOTONIC);
+  UsapLaunchStats& stats = gUsapLaunchStats;
+  if (stats.last_launch_ns != 0) {
+    const nsecs_t interval = now - stats.last_launch_ns;
+    stats.launch_interval_ewma_ns = stats.launch_interval_ewma_ns == 0
+        ? interval
+        : stats.launch_interval_ewma_ns
+              + (interval - stats.launch_interval_ewma_ns) * USAP_LAUNCH_INTERVAL_EWMA_WEIGHT / 8;
+  }
+  stats.last_launch_ns = now;
+  return true;
+}
+
+/**
+ * Reads the memory PSI "some avg10" value, the percentage of the last ten
+ * seconds in which at least one task was stalled on memory.
+ *
+ * @return The stall percentage, or a negative value if PSI is unavailable.
+ */
+static float GetMemoryPressureAvg10() {
+  std::string pressure;
+  if (!ReadFileToString("/proc/pressure/memory", &pressure)) {
+    return -1.0f;
+  }
+
+  float avg10;
+  if (sscanf(pressure.c_str(), "some avg10=%f", &avg10) != 1) {
+    return -1.0f;
+  }
+  return avg10;
+}
+
+/**
+ * Computes how many USAPs the pool should hold, based on the observed launch
+ * rate and memory pressure.  Enough USAPs are kept to serve the launches
+ * expected within USAP_POOL_REFILL_HORIZON_NS, so bursts do not drain the
+ * pool, while long idle periods and memory pressure shrink it back to
+ * |pool_size_min|.
+ *
+ * @param env  Managed runtime environment
+ * @param pool_size_min  The configured minimum pool size
+ * @param pool_size_max  The configured maximum pool size
+ * @return The target pool size, in [pool_size_min, pool_size_max]
+ */
+static jint com_android_internal_os_Zygote_nativeGetUsapPoolRefillTarget(JNIEnv* env, jclass,
+                                                                         jint pool_size_min,
+                                                                         jint pool_size_max) {
+  pool_size_max = std::min(pool_size_max, USAP_POOL_SIZE_MAX_LIMIT);
+  pool_size_min = std::clamp(pool_size_min, 0, pool_size_max);
+
+  const UsapLaunchStats& stats = gUsapLaunchStats;
+  if (stats.launch_interval_ewma_ns <= 0) {
+    // Not enough launches observed yet to estimate a rate.
+    return pool_size_max;
+  }
+
+  const nsecs_t now = systemTime(SYSTEM_TIME_MONOTONIC);
+  if (now - stats.last_launch_ns > USAP_POOL_IDLE_TIMEOUT_NS) {
+    return pool_size_min;
+  }
+
+  if (GetMemoryPressureAvg10() > USAP_POOL_MEMORY_PRESSURE_THRESHOLD) {
+    return pool_size_min;
+  }
+
+  const nsecs_t expected_launches =
+      USAP_POOL_REFILL_HORIZON_NS / stats.launch_interval_ewma_ns + 1;
+  return static_cast<jint>(std::clamp<nsecs_t>(expected_launches, pool_size_min, pool_size_max));
 }
 
 /**
@@ -2493,6 +2598,8 @@ static const JNINativeMethod gMethods[] = {
          (void*)com_android_internal_os_Zygote_nativeGetUsapPoolEventFD},
         {"nativeGetUsapPoolCount", "()I",
          (void*)com_android_internal_os_Zygote_nativeGetUsapPoolCount},
+        {"nativeGetUsapPoolRefillTarget", "(II)I",
+         (void*)com_android_internal_os_Zygote_nativeGetUsapPoolRefillTarget},
         {"nativeEmptyUsapPool", "()V", (void*)com_android_internal_os_Zygote_nativeEmptyUsapPool},
         {"nativeBlockSigTerm", "()V", (void*)com_android_internal_os_Zygote_nativeBlockSigTerm},
         {"nativeUnblockSigTerm", "()V", (void*)com_android_internal_os_Zygote_nativeUnblockSigTerm},
@@ -72,16 +72,9 @@ static bool IsArtMemfd(const std::string& path) {
 }
 
 bool FileDescriptorWhitelist::IsAllowed(const std::string& path) const {
-  // Check the static whitelist path.
-  for (const auto& whitelist_path : kPathWhitelist) {
-    if (path == whitelist_path)
-      return true;
-  }
-
-  // Check any paths added to the dynamic whitelist.
-  for (const auto& whitelist_path : whitelist_) {
-    if (path == whitelist_path)
-      return true;
+  // Check the static and dynamic whitelist paths.
+  if (whitelist_.find(path) != whitelist_.end()) {
+    return true;
   }
 
   // Framework jars are allowed.
@@ -160,7 +153,7 @@ bool FileDescriptorWhitelist::IsAllowed(const std::string& path) const {
 }
 
 FileDescriptorWhitelist::FileDescriptorWhitelist()
-    : whitelist_() {
+    : whitelist_(std::begin(kPathWhitelist), std::end(kPathWhitelist)) {
 }
 
 FileDescriptorWhitelist* FileDescriptorWhitelist::instance_ = nullptr;
@@ -502,7 +495,7 @@ FileDescriptorTable* FileDescriptorTable::Create(const std::vector<int>& fds_to_
 }
 
 void FileDescriptorTable::Restat(const std::vector<int>& fds_to_ignore, fail_fn_t fail_fn) {
-  std::set<int> open_fds;
+  std::unordered_set<int> open_fds;
 
   // First get the list of open descriptors.
   DIR* proc_fd_dir = opendir(kFdPath);
@@ -552,7 +545,8 @@ FileDescriptorTable::FileDescriptorTable(
     : open_fd_map_(map) {
 }
 
-void FileDescriptorTable::RestatInternal(std::set<int>& open_fds, fail_fn_t fail_fn) {
+void FileDescriptorTable::RestatInternal(std::unordered_set<int>& open_fds,
+                                         fail_fn_t fail_fn) {
   // ART creates a file through memfd for optimization purposes. We make sure
   // there is at most one being created.
   bool art_memfd_seen = false;
@@ -566,7 +560,7 @@ void FileDescriptorTable::RestatInternal(std::set<int>& open_fds, fail_fn_t fail
   // We'll only store the last error message.
   std::unordered_map<int, FileDescriptorInfo*>::iterator it = open_fd_map_.begin();
   while (it != open_fd_map_.end()) {
-    std::set<int>::const_iterator element = open_fds.find(it->first);
+    std::unordered_set<int>::const_iterator element = open_fds.find(it->first);
     if (element == open_fds.end()) {
       // The entry from the file descriptor table is no longer in the list
       // of open files. We warn about this condition and remove it from
@@ -614,7 +608,7 @@ void FileDescriptorTable::RestatInternal(std::set<int>& open_fds, fail_fn_t fail
     // ALOGW("Zygote opened %zd new file descriptor(s).", open_fds.size());
 
     // TODO(narayan): This code will be removed in a future android release.
-    std::set<int>::const_iterator it;
+    std::unordered_set<int>::const_iterator it;
     for (it = open_fds.begin(); it != open_fds.end(); ++it) {
       const int fd = (*it);
       open_fd_map_[fd] = FileDescriptorInfo::CreateFromFd(fd, fail_fn);
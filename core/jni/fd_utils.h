@@ -17,9 +17,9 @@
 #ifndef FRAMEWORKS_BASE_CORE_JNI_FD_UTILS_H_
 #define FRAMEWORKS_BASE_CORE_JNI_FD_UTILS_H_
 
-#include <set>
 #include <string>
 #include <unordered_map>
+#include <unordered_set>
 #include <vector>
 
 #include <dirent.h>
@@ -52,7 +52,7 @@ class FileDescriptorWhitelist {
 
   // Adds a path to the whitelist.
   void Allow(const std::string& path) {
-    whitelist_.push_back(path);
+    whitelist_.insert(path);
   }
 
   // Returns true iff. a given path is whitelisted. A path is whitelisted
@@ -66,7 +66,9 @@ class FileDescriptorWhitelist {
 
   static FileDescriptorWhitelist* instance_;
 
-  std::vector<std::string> whitelist_;
+  // Exact paths allowed: kPathWhitelist plus any added with Allow(). Kept
+  // as a hash set since every zygote fd is checked against it on each fork.
+  std::unordered_set<std::string> whitelist_;
 
   DISALLOW_COPY_AND_ASSIGN(FileDescriptorWhitelist);
 };
@@ -91,7 +93,7 @@ class FileDescriptorTable {
  private:
   explicit FileDescriptorTable(const std::unordered_map<int, FileDescriptorInfo*>& map);
 
-  void RestatInternal(std::set<int>& open_fds, fail_fn_t fail_fn);
+  void RestatInternal(std::unordered_set<int>& open_fds, fail_fn_t fail_fn);
 
   static int ParseFd(dirent* e, int dir_fd);
 
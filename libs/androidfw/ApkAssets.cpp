@@ -16,7 +16,12 @@
 
 #include "androidfw/ApkAssets.h"
 
+#include <sys/stat.h>
+#include <unistd.h>
+
 #include <algorithm>
+#include <atomic>
+#include <thread>
 
 #include "android-base/errors.h"
 #include "android-base/file.h"
@@ -34,6 +39,10 @@
 #include "androidfw/ResourceTypes.h"
 #include "androidfw/Util.h"
 
+#ifdef __ANDROID__
+#include "cutils/ashmem.h"
+#endif
+
 namespace android {
 
 using base::SystemErrorCodeToString;
@@ -374,6 +383,52 @@ std::unique_ptr<const ApkAssets> ApkAssets::LoadTableFromFd(
                   : nullptr;
 }
 
+// Returns the size of the shared memory region of `fd`, or -1 if it cannot be determined.
+// Seeking to the end does not work for ashmem regions, so ask the driver for their size.
+static off64_t GetSharedMemorySize(int fd) {
+#ifdef __ANDROID__
+  const int ashmem_size = ashmem_get_size_region(fd);
+  if (ashmem_size > 0) {
+    return ashmem_size;
+  }
+#endif
+  struct stat st;
+  if (fstat(fd, &st) != 0) {
+    return -1;
+  }
+  return st.st_size;
+}
+
+std::unique_ptr<const ApkAssets> ApkAssets::LoadTableFromSharedMemory(
+    int fd, const std::string& friendly_name, const package_property_t flags,
+    std::unique_ptr<const AssetsProvider> override_asset, const off64_t offset,
+    off64_t length) {
+  CHECK(length != kUnknownLength || offset == 0) << "offset must be 0 if length is "
+                                                 << kUnknownLength;
+  if (length == kUnknownLength) {
+    length = GetSharedMemorySize(fd);
+    if (length <= 0) {
+      LOG(ERROR) << "Failed to get size of shared memory '" << friendly_name << "': "
+                 << SystemErrorCodeToString(errno);
+      return {};
+    }
+  }
+
+  // The region stays owned by the caller. The asset keeps a duplicate of the descriptor so that
+  // Asset::openFileDescriptor keeps working after the caller closes its own.
+  unique_fd dup_fd(dup(fd));
+  if (!dup_fd.ok()) {
+    LOG(ERROR) << "Failed to duplicate shared memory '" << friendly_name << "': "
+               << SystemErrorCodeToString(errno);
+    return {};
+  }
+
+  auto assets = CreateAssetFromFd(std::move(dup_fd), nullptr /* path */, offset, length);
+  return (assets) ? LoadTableImpl(std::move(assets), friendly_name, flags,
+                                  std::move(override_asset))
+                  : nullptr;
+}
+
 std::unique_ptr<const ApkAssets> ApkAssets::LoadOverlay(const std::string& idmap_path,
                                                         const package_property_t flags) {
   CHECK((flags & PROPERTY_LOADER) == 0U) << "Cannot load RROs through loaders";
@@ -408,6 +463,42 @@ std::unique_ptr<const ApkAssets> ApkAssets::LoadFromDir(
                   : nullptr;
 }
 
+std::vector<std::unique_ptr<const ApkAssets>> ApkAssets::LoadAll(
+    const std::vector<LoadRequest>& requests, size_t max_threads) {
+  std::vector<std::unique_ptr<const ApkAssets>> results(requests.size());
+
+  // Each thread claims the next request that has not been loaded yet. The ApkAssets are
+  // independent of each other, so the only shared state is the index of the next request.
+  std::atomic<size_t> next_request(0u);
+  auto load_requests = [&]() {
+    for (size_t i = next_request++; i < requests.size(); i = next_request++) {
+      const LoadRequest& request = requests[i];
+      results[i] = request.overlay ? LoadOverlay(request.path, request.flags)
+                                   : Load(request.path, request.flags);
+    }
+  };
+
+  if (max_threads == 0u) {
+    max_threads = std::max(std::thread::hardware_concurrency(), 1u);
+  }
+
+  // The calling thread loads requests too, so it counts towards `max_threads`.
+  std::vector<std::thread> workers;
+  if (requests.size() > 1u) {
+    const size_t worker_count = std::min(max_threads, requests.size()) - 1u;
+    workers.reserve(worker_count);
+    for (size_t i = 0; i < worker_count; i++) {
+      workers.emplace_back(load_requests);
+    }
+  }
+
+  load_requests();
+  for (std::thread& worker : workers) {
+    worker.join();
+  }
+  return results;
+}
+
 std::unique_ptr<const ApkAssets> ApkAssets::LoadEmpty(
     const package_property_t flags, std::unique_ptr<const AssetsProvider> override_asset) {
 
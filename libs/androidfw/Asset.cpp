@@ -295,6 +295,39 @@ Asset::Asset(void)
 }
 #endif
 
+/*
+ * Tell the kernel how a mapped asset is going to be accessed, so that it
+ * can read ahead or drop pages as appropriate.
+ *
+ * The compressed data of an asset is always consumed from start to end by
+ * the inflater, regardless of how the uncompressed data is accessed.
+ */
+static void adviseMap(FileMap* map, Asset::AccessMode mode, bool compressed)
+{
+    FileMap::MapAdvice advice;
+    if (compressed) {
+        advice = FileMap::SEQUENTIAL;
+    } else {
+        switch (mode) {
+            case Asset::ACCESS_RANDOM:
+                advice = FileMap::RANDOM;
+                break;
+            case Asset::ACCESS_STREAMING:
+                advice = FileMap::SEQUENTIAL;
+                break;
+            case Asset::ACCESS_BUFFER:
+                advice = FileMap::WILLNEED;
+                break;
+            default:
+                return;
+        }
+    }
+
+    if (map->advise(advice) != 0) {
+        ALOGV("Failed to advise map %p (advice=%d)", map, (int) advice);
+    }
+}
+
 /*
  * Create a new Asset from a memory mapping.
  */
@@ -311,6 +344,7 @@ Asset::Asset(void)
     }
 
     pAsset->mAccessMode = mode;
+    adviseMap(dataMap, mode, false /* compressed */);
     return pAsset;
 }
 
@@ -325,7 +359,7 @@ Asset::Asset(void)
     }
 
     // We succeeded, so relinquish control of dataMap
-    (void) dataMap.release();
+    adviseMap(dataMap.release(), mode, false /* compressed */);
     pAsset->mAccessMode = mode;
     return std::move(pAsset);
 }
@@ -347,6 +381,7 @@ Asset::Asset(void)
     }
 
     pAsset->mAccessMode = mode;
+    adviseMap(dataMap, mode, true /* compressed */);
     return pAsset;
 }
 
@@ -361,7 +396,7 @@ Asset::Asset(void)
   }
 
   // We succeeded, so relinquish control of dataMap
-  (void) dataMap.release();
+  adviseMap(dataMap.release(), mode, true /* compressed */);
   pAsset->mAccessMode = mode;
   return std::move(pAsset);
 }
@@ -681,6 +716,7 @@ const void* _FileAsset::getBuffer(bool wordAligned)
 
         ALOGV(" getBuffer: mapped\n");
 
+        adviseMap(map, getAccessMode(), false /* compressed */);
         mMap = map;
         if (!wordAligned) {
             return  mMap->getDataPtr();
@@ -963,10 +999,14 @@ const void* _CompressedAsset::getBuffer(bool)
 
     /*
      * Success - now that we have the full asset in RAM we
-     * no longer need the streaming inflater
+     * no longer need the streaming inflater, nor the pages
+     * of compressed data.
      */
     delete mZipInflater;
     mZipInflater = NULL;
+    if (mMap != NULL) {
+        mMap->advise(FileMap::DONTNEED);
+    }
 
     mBuf = buf;
     buf = NULL;
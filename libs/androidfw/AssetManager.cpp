@@ -140,7 +140,7 @@ int32_t AssetManager::getGlobalCount() {
 }
 
 AssetManager::AssetManager() :
-        mLocale(NULL), mResources(NULL), mConfig(new ResTable_config) {
+        mLocale(NULL), mResources(NULL), mPublishedResources(NULL), mConfig(new ResTable_config) {
     int count = android_atomic_inc(&gCount) + 1;
     if (kIsDebug) {
         ALOGI("Creating AssetManager %p #%d\n", this, count);
@@ -631,7 +631,9 @@ bool AssetManager::appendPathToResTable(asset_path& ap, bool appAsLib) const {
 
 const ResTable* AssetManager::getResTable(bool required) const
 {
-    ResTable* rt = mResources;
+    // mPublishedResources is only set once the table has been fully populated, so readers that
+    // skip the lock never observe a partially built ResTable.
+    ResTable* rt = mPublishedResources.load(std::memory_order_acquire);
     if (rt) {
         return rt;
     }
@@ -665,6 +667,7 @@ const ResTable* AssetManager::getResTable(bool required) const
         mResources = NULL;
     }
 
+    mPublishedResources.store(mResources, std::memory_order_release);
     return mResources;
 }
 
@@ -766,7 +769,7 @@ bool AssetManager::isUpToDate()
 
 void AssetManager::getLocales(Vector<String8>* locales, bool includeSystemLocales) const
 {
-    ResTable* res = mResources;
+    ResTable* res = mPublishedResources.load(std::memory_order_acquire);
     if (res != NULL) {
         res->getLocales(locales, includeSystemLocales, true /* mergeEquivalentLangs */);
     }
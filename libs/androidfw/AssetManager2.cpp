@@ -19,12 +19,14 @@
 #include "androidfw/AssetManager2.h"
 
 #include <algorithm>
+#include <cinttypes>
 #include <iterator>
 #include <map>
 #include <set>
 
 #include "android-base/logging.h"
 #include "android-base/stringprintf.h"
+#include "androidfw/MutexGuard.h"
 #include "androidfw/ResourceUtils.h"
 #include "androidfw/Util.h"
 #include "utils/ByteOrder.h"
@@ -38,41 +40,77 @@
 
 namespace android {
 
-struct FindEntryResult {
-  // A pointer to the resource table entry for this resource.
-  // If the size of the entry is > sizeof(ResTable_entry), it can be cast to
-  // a ResTable_map_entry and processed as a bag/map.
-  ResTable_entry_handle entry;
-
-  // The configuration for which the resulting entry was defined. This is already swapped to host
-  // endianness.
-  ResTable_config config;
+namespace {
 
-  // The bitmask of configuration axis with which the resource value varies.
-  uint32_t type_flags;
+// The maximum number of resolved entries kept by AssetManager2::FindEntry(). When this is
+// exceeded the cache is dropped and repopulated by subsequent lookups.
+constexpr size_t kMaxCachedEntries = 4096u;
 
-  // The dynamic package ID map for the package from which this resource came from.
-  const DynamicRefTable* dynamic_ref_table;
+// The maximum number of attributes memoized by a Theme. When this is exceeded the cache is dropped
+// and repopulated by subsequent lookups.
+constexpr size_t kMaxCachedThemeAttributes = 1024u;
 
-  // The package name of the resource.
-  const std::string* package_name;
+// The maximum number of bags kept by the process-wide shared bag cache. Bags in the shared cache
+// are never evicted since AssetManagers hold pointers to them.
+constexpr size_t kMaxSharedBags = 4096u;
 
-  // The string pool reference to the type's name. This uses a different string pool than
-  // the global string pool, but this is hidden from the caller.
-  StringPoolRef type_string_ref;
+// A bag resolved by one AssetManager that can be used by any other AssetManager that has the same
+// ApkAssets at the same cookie, as long as its configuration does not differ along the axis the
+// bag varies with.
+struct SharedBag {
+  ApkAssetsCookie cookie;
+  ResTable_config configuration;
+  util::unique_cptr<ResolvedBag> bag;
+};
 
-  // The string pool reference to the entry's name. This uses a different string pool than
-  // the global string pool, but this is hidden from the caller.
-  StringPoolRef entry_string_ref;
+struct SharedBagCache {
+  bool enabled = false;
+  std::map<std::pair<const ApkAssets*, uint32_t>, SharedBag> bags;
 };
 
+Guarded<SharedBagCache>& GetSharedBagCache() {
+  static Guarded<SharedBagCache>* shared_bag_cache = new Guarded<SharedBagCache>();
+  return *shared_bag_cache;
+}
+
+}  // namespace
+
 AssetManager2::AssetManager2() {
   memset(&configuration_, 0, sizeof(configuration_));
+  package_ids_.fill(0xff);
 }
 
 bool AssetManager2::SetApkAssets(const std::vector<const ApkAssets*>& apk_assets,
                                  bool invalidate_caches, bool filter_incompatible_configs) {
+  // Overlay packages are assigned package ids after all other packages. A single ApkAssets can
+  // therefore be appended or removed without renumbering any other package when it is an overlay,
+  // or, when appending, when no overlay has been added yet. Other package groups and their caches
+  // are left untouched in that case.
+  if (filter_incompatible_configs == filter_incompatible_configs_) {
+    if (apk_assets.size() == apk_assets_.size() + 1U
+        && std::equal(apk_assets_.begin(), apk_assets_.end(), apk_assets.begin())
+        && std::find(apk_assets_.begin(), apk_assets_.end(), apk_assets.back()) == apk_assets_.end()
+        && (apk_assets.back()->IsOverlay()
+            || std::none_of(apk_assets_.begin(), apk_assets_.end(),
+                            std::mem_fn(&ApkAssets::IsOverlay)))) {
+      AppendApkAssets(apk_assets.back(), invalidate_caches);
+      return true;
+    }
+
+    if (apk_assets.size() + 1U == apk_assets_.size()
+        && std::equal(apk_assets.begin(), apk_assets.end(), apk_assets_.begin())
+        && apk_assets_.back()->IsOverlay()
+        && std::find(apk_assets.begin(), apk_assets.end(), apk_assets_.back()) == apk_assets.end()) {
+      RemoveLastOverlay(invalidate_caches);
+      return true;
+    }
+  }
+
   apk_assets_ = apk_assets;
+
+  // Cached entries point to the dynamic reference tables of the package groups, which are
+  // recreated below, so they must be purged even if the other caches are kept.
+  cached_entries_.clear();
   BuildDynamicRefTable();
   RebuildFilterList(filter_incompatible_configs);
   if (invalidate_caches) {
@@ -81,12 +119,86 @@ bool AssetManager2::SetApkAssets(const std::vector<const ApkAssets*>& apk_assets
   return true;
 }
 
+void AssetManager2::AppendApkAssets(const ApkAssets* apk_assets, bool invalidate_caches) {
+  const ApkAssetsCookie cookie = static_cast<ApkAssetsCookie>(apk_assets_.size());
+  apk_assets_.push_back(apk_assets);
+
+  std::vector<uint8_t> affected_package_ids;
+  const size_t package_count = AddPackageGroups(apk_assets, cookie, &affected_package_ids);
+  AssignRuntimePackageIds();
+
+  // Only the packages that were just added need their configurations filtered.
+  for (PackageGroup& package_group : package_groups_) {
+    const size_t group_size = package_group.packages_.size();
+    for (size_t i = group_size; i > 0U && package_group.cookies_[i - 1U] == cookie; i--) {
+      RebuildFilteredConfigs(&package_group.packages_[i - 1U], filter_incompatible_configs_);
+    }
+  }
+
+  if (package_count > 0U) {
+    InvalidateCachesForPackages(affected_package_ids, cookie, invalidate_caches);
+  }
+}
+
+void AssetManager2::RemoveLastOverlay(bool invalidate_caches) {
+  const ApkAssets* apk_assets = apk_assets_.back();
+  const ApkAssetsCookie cookie = static_cast<ApkAssetsCookie>(apk_assets_.size() - 1U);
+  apk_assets_.pop_back();
+
+  std::vector<uint8_t> affected_package_ids;
+  for (PackageGroup& package_group : package_groups_) {
+    const uint8_t package_id = package_group.dynamic_ref_table->mAssignedPackageId;
+    auto overlays_end = std::remove_if(package_group.overlays_.begin(),
+                                       package_group.overlays_.end(),
+                                       [&](const ConfiguredOverlay& overlay) {
+                                         return overlay.cookie == cookie;
+                                       });
+    if (overlays_end != package_group.overlays_.end()) {
+      package_group.overlays_.erase(overlays_end, package_group.overlays_.end());
+      affected_package_ids.push_back(package_id);
+    }
+
+    // The packages of the overlay were added last, so they are at the end of each group.
+    bool removed_package = false;
+    while (!package_group.cookies_.empty() && package_group.cookies_.back() == cookie) {
+      package_group.packages_.pop_back();
+      package_group.cookies_.pop_back();
+      removed_package = true;
+    }
+    if (removed_package) {
+      affected_package_ids.push_back(package_id);
+    }
+  }
+
+  // Groups created for the overlay were created after all other groups.
+  while (!package_groups_.empty() && package_groups_.back().packages_.empty()) {
+    package_ids_[package_groups_.back().dynamic_ref_table->mAssignedPackageId] = 0xff;
+    package_groups_.pop_back();
+  }
+
+  for (const std::unique_ptr<const LoadedPackage>& package :
+       apk_assets->GetLoadedArsc()->GetPackages()) {
+    if (package->IsDynamic()) {
+      next_dynamic_package_id_--;
+    }
+  }
+
+  if (std::none_of(apk_assets_.begin(), apk_assets_.end(), [&](const ApkAssets* a) {
+        return a->GetPath() == apk_assets->GetPath();
+      })) {
+    apk_assets_package_ids_.erase(apk_assets->GetPath());
+  }
+
+  InvalidateCachesForPackages(affected_package_ids, cookie, invalidate_caches);
+}
+
 void AssetManager2::BuildDynamicRefTable() {
   package_groups_.clear();
   package_ids_.fill(0xff);
+  apk_assets_package_ids_.clear();
 
-  // A mapping from apk assets path to the runtime package id of its first loaded package.
-  std::unordered_map<std::string, uint8_t> apk_assets_package_ids;
+  // 0x01 is reserved for the android package.
+  next_dynamic_package_id_ = 0x02;
 
   // Overlay resources are not directly referenced by an application so their resource ids
   // can change throughout the application's lifetime. Assign overlay package ids last.
@@ -102,76 +214,89 @@ void AssetManager2::BuildDynamicRefTable() {
     apk_assets_cookies[apk_assets_[i]] = static_cast<ApkAssetsCookie>(i);
   }
 
-  // 0x01 is reserved for the android package.
-  int next_package_id = 0x02;
   for (const ApkAssets* apk_assets : sorted_apk_assets) {
-    const LoadedArsc* loaded_arsc = apk_assets->GetLoadedArsc();
-    for (const std::unique_ptr<const LoadedPackage>& package : loaded_arsc->GetPackages()) {
-      // Get the package ID or assign one if a shared library.
-      int package_id;
-      if (package->IsDynamic()) {
-        package_id = next_package_id++;
-      } else {
-        package_id = package->GetPackageId();
-      }
+    AddPackageGroups(apk_assets, apk_assets_cookies[apk_assets], nullptr);
+  }
+  AssignRuntimePackageIds();
+}
 
-      // Add the mapping for package ID to index if not present.
-      uint8_t idx = package_ids_[package_id];
-      if (idx == 0xff) {
-        package_ids_[package_id] = idx = static_cast<uint8_t>(package_groups_.size());
-        package_groups_.push_back({});
-
-        if (apk_assets->IsOverlay()) {
-          // The target package must precede the overlay package in the apk assets paths in order
-          // to take effect.
-          const auto& loaded_idmap = apk_assets->GetLoadedIdmap();
-          auto target_package_iter = apk_assets_package_ids.find(loaded_idmap->TargetApkPath());
-          if (target_package_iter == apk_assets_package_ids.end()) {
-             LOG(INFO) << "failed to find target package for overlay "
-                       << loaded_idmap->OverlayApkPath();
-          } else {
-            const uint8_t target_package_id = target_package_iter->second;
-            const uint8_t target_idx = package_ids_[target_package_id];
-            CHECK(target_idx != 0xff) << "overlay added to apk_assets_package_ids but does not"
-                                      << " have an assigned package group";
-
-            PackageGroup& target_package_group = package_groups_[target_idx];
-
-            // Create a special dynamic reference table for the overlay to rewrite references to
-            // overlay resources as references to the target resources they overlay.
-            auto overlay_table = std::make_shared<OverlayDynamicRefTable>(
-                loaded_idmap->GetOverlayDynamicRefTable(target_package_id));
-            package_groups_.back().dynamic_ref_table = overlay_table;
-
-            // Add the overlay resource map to the target package's set of overlays.
-            target_package_group.overlays_.push_back(
-                ConfiguredOverlay{loaded_idmap->GetTargetResourcesMap(target_package_id,
-                                                                      overlay_table.get()),
-                                  apk_assets_cookies[apk_assets]});
+size_t AssetManager2::AddPackageGroups(const ApkAssets* apk_assets, ApkAssetsCookie cookie,
+                                       std::vector<uint8_t>* out_affected_package_ids) {
+  const LoadedArsc* loaded_arsc = apk_assets->GetLoadedArsc();
+  for (const std::unique_ptr<const LoadedPackage>& package : loaded_arsc->GetPackages()) {
+    // Get the package ID or assign one if a shared library.
+    int package_id;
+    if (package->IsDynamic()) {
+      package_id = next_dynamic_package_id_++;
+    } else {
+      package_id = package->GetPackageId();
+    }
+
+    // Add the mapping for package ID to index if not present.
+    uint8_t idx = package_ids_[package_id];
+    if (idx == 0xff) {
+      package_ids_[package_id] = idx = static_cast<uint8_t>(package_groups_.size());
+      package_groups_.push_back({});
+
+      if (apk_assets->IsOverlay()) {
+        // The target package must precede the overlay package in the apk assets paths in order
+        // to take effect.
+        const auto& loaded_idmap = apk_assets->GetLoadedIdmap();
+        auto target_package_iter = apk_assets_package_ids_.find(loaded_idmap->TargetApkPath());
+        if (target_package_iter == apk_assets_package_ids_.end()) {
+           LOG(INFO) << "failed to find target package for overlay "
+                     << loaded_idmap->OverlayApkPath();
+        } else {
+          const uint8_t target_package_id = target_package_iter->second;
+          const uint8_t target_idx = package_ids_[target_package_id];
+          CHECK(target_idx != 0xff) << "overlay added to apk_assets_package_ids but does not"
+                                    << " have an assigned package group";
+
+          PackageGroup& target_package_group = package_groups_[target_idx];
+
+          // Create a special dynamic reference table for the overlay to rewrite references to
+          // overlay resources as references to the target resources they overlay.
+          auto overlay_table = std::make_shared<OverlayDynamicRefTable>(
+              loaded_idmap->GetOverlayDynamicRefTable(target_package_id));
+          package_groups_.back().dynamic_ref_table = overlay_table;
+
+          // Add the overlay resource map to the target package's set of overlays.
+          target_package_group.overlays_.push_back(
+              ConfiguredOverlay{loaded_idmap->GetTargetResourcesMap(target_package_id,
+                                                                    overlay_table.get()),
+                                cookie});
+          if (out_affected_package_ids != nullptr) {
+            out_affected_package_ids->push_back(target_package_id);
           }
         }
-
-        DynamicRefTable* ref_table = package_groups_.back().dynamic_ref_table.get();
-        ref_table->mAssignedPackageId = package_id;
-        ref_table->mAppAsLib = package->IsDynamic() && package->GetPackageId() == 0x7f;
       }
-      PackageGroup* package_group = &package_groups_[idx];
 
-      // Add the package and to the set of packages with the same ID.
-      package_group->packages_.push_back(ConfiguredPackage{package.get(), {}});
-      package_group->cookies_.push_back(apk_assets_cookies[apk_assets]);
+      DynamicRefTable* ref_table = package_groups_.back().dynamic_ref_table.get();
+      ref_table->mAssignedPackageId = package_id;
+      ref_table->mAppAsLib = package->IsDynamic() && package->GetPackageId() == 0x7f;
+    }
+    PackageGroup* package_group = &package_groups_[idx];
 
-      // Add the package name -> build time ID mappings.
-      for (const DynamicPackageEntry& entry : package->GetDynamicPackageMap()) {
-        String16 package_name(entry.package_name.c_str(), entry.package_name.size());
-        package_group->dynamic_ref_table->mEntries.replaceValueFor(
-            package_name, static_cast<uint8_t>(entry.package_id));
-      }
+    // Add the package and to the set of packages with the same ID.
+    package_group->packages_.push_back(ConfiguredPackage{package.get(), {}});
+    package_group->cookies_.push_back(cookie);
+    if (out_affected_package_ids != nullptr) {
+      out_affected_package_ids->push_back(static_cast<uint8_t>(package_id));
+    }
 
-      apk_assets_package_ids.insert(std::make_pair(apk_assets->GetPath(), package_id));
+    // Add the package name -> build time ID mappings.
+    for (const DynamicPackageEntry& entry : package->GetDynamicPackageMap()) {
+      String16 package_name(entry.package_name.c_str(), entry.package_name.size());
+      package_group->dynamic_ref_table->mEntries.replaceValueFor(
+          package_name, static_cast<uint8_t>(entry.package_id));
     }
+
+    apk_assets_package_ids_.insert(std::make_pair(apk_assets->GetPath(), package_id));
   }
+  return loaded_arsc->GetPackages().size();
+}
 
+void AssetManager2::AssignRuntimePackageIds() {
   // Now assign the runtime IDs so that we have a build-time to runtime ID map.
   const auto package_groups_end = package_groups_.end();
   for (auto iter = package_groups_.begin(); iter != package_groups_end; ++iter) {
@@ -202,6 +327,12 @@ void AssetManager2::DumpToLog() const {
   }
   LOG(INFO) << "Package ID map: " << list;
 
+  const uint64_t theme_lookups = theme_attribute_cache_hits_ + theme_attribute_cache_misses_;
+  LOG(INFO) << base::StringPrintf(
+      "Theme attribute cache: %" PRIu64 " hits, %" PRIu64 " misses (%.1f%% hit rate)",
+      theme_attribute_cache_hits_, theme_attribute_cache_misses_,
+      theme_lookups == 0u ? 0.0 : 100.0 * theme_attribute_cache_hits_ / theme_lookups);
+
   for (const auto& package_group: package_groups_) {
     list = "";
     for (const auto& package : package_group.packages_) {
@@ -524,6 +655,18 @@ ApkAssetsCookie AssetManager2::FindEntry(uint32_t resid, uint16_t density_overri
     desired_config = &density_override_config;
   }
 
+  // Only lookups against the set configuration are cached. Resolution logging needs to record
+  // every step taken, so it always performs the full search.
+  const bool use_cache = !ignore_configuration && desired_config == &configuration_ &&
+                         !resource_resolution_logging_enabled_;
+  if (use_cache) {
+    auto cached_iter = cached_entries_.find(resid);
+    if (cached_iter != cached_entries_.end()) {
+      *out_entry = cached_iter->second.result;
+      return cached_iter->second.cookie;
+    }
+  }
+
   // Retrieve the package group from the package id of the resource id.
   if (!is_valid_resid(resid)) {
     LOG(ERROR) << base::StringPrintf("Invalid ID 0x%08x.", resid);
@@ -548,6 +691,9 @@ ApkAssetsCookie AssetManager2::FindEntry(uint32_t resid, uint16_t density_overri
     return kInvalidCookie;
   }
 
+  // The axis with which the overlays of this resource vary must also purge the cached entry.
+  uint32_t cache_type_flags = out_entry->type_flags;
+
   if (!apk_assets_[cookie]->IsLoader()) {
     for (const auto& id_map : package_group.overlays_) {
       auto overlay_entry = id_map.overlay_res_maps_.Lookup(resid);
@@ -572,6 +718,7 @@ ApkAssetsCookie AssetManager2::FindEntry(uint32_t resid, uint16_t density_overri
         continue;
       }
 
+      cache_type_flags |= overlay_result.type_flags;
       if (!overlay_result.config.isBetterThan(out_entry->config, desired_config)
           && overlay_result.config.compare(out_entry->config) != 0) {
         // The configuration of the entry for the overlay must be equal to or better than the target
@@ -597,6 +744,13 @@ ApkAssetsCookie AssetManager2::FindEntry(uint32_t resid, uint16_t density_overri
     last_resolution_.entry_string_ref = out_entry->entry_string_ref;
   }
 
+  if (use_cache) {
+    if (cached_entries_.size() >= kMaxCachedEntries) {
+      cached_entries_.clear();
+    }
+    cached_entries_[resid] = CachedEntry{cookie, cache_type_flags, *out_entry};
+  }
+
   return cookie;
 }
 
@@ -621,6 +775,9 @@ ApkAssetsCookie AssetManager2::FindEntryInternal(const PackageGroup& package_gro
   // and we don't need to match the configurations, since they already matched.
   const bool use_fast_path = !ignore_configuration && &desired_config == &configuration_;
 
+  // Resolution logging records every candidate configuration, so it can't stop early.
+  const bool stop_at_best_in_package = !resource_resolution_logging_enabled_;
+
   const size_t package_count = package_group.packages_.size();
   for (size_t pi = 0; pi < package_count; pi++) {
     const ConfiguredPackage& loaded_package_impl = package_group.packages_[pi];
@@ -695,6 +852,11 @@ ApkAssetsCookie AssetManager2::FindEntryInternal(const PackageGroup& package_gro
                                                             this_config.toString(),
                                                             &loaded_package->GetPackageName()});
         }
+
+        if (filtered_group.sorted_by_match && stop_at_best_in_package) {
+          // The remaining configurations of this package are worse matches than this one.
+          break;
+        }
       }
     } else {
       // This is the slower path, which doesn't use the filtered list of configurations.
@@ -995,6 +1157,15 @@ const ResolvedBag* AssetManager2::GetBag(uint32_t resid, std::vector<uint32_t>&
     return cached_iter->second.get();
   }
 
+  auto cached_shared_iter = cached_shared_bags_.find(resid);
+  if (cached_shared_iter != cached_shared_bags_.end()) {
+    return cached_shared_iter->second;
+  }
+
+  if (const ResolvedBag* shared_bag = FindSharedBag(resid)) {
+    return shared_bag;
+  }
+
   FindEntryResult entry;
   ApkAssetsCookie cookie = FindEntry(resid, 0u /* density_override */,
                                      false /* stop_at_first_match */,
@@ -1069,9 +1240,7 @@ const ResolvedBag* AssetManager2::GetBag(uint32_t resid, std::vector<uint32_t>&
 
     new_bag->type_spec_flags = entry.type_flags;
     new_bag->entry_count = static_cast<uint32_t>(entry_count);
-    ResolvedBag* result = new_bag.get();
-    cached_bags_[resid] = std::move(new_bag);
-    return result;
+    return CacheBag(resid, std::move(new_bag));
   }
 
   // In case the parent is a dynamic reference, resolve it.
@@ -1190,8 +1359,90 @@ const ResolvedBag* AssetManager2::GetBag(uint32_t resid, std::vector<uint32_t>&
   // Combine flags from the parent and our own bag.
   new_bag->type_spec_flags = entry.type_flags | parent_bag->type_spec_flags;
   new_bag->entry_count = static_cast<uint32_t>(actual_count);
-  ResolvedBag* result = new_bag.get();
-  cached_bags_[resid] = std::move(new_bag);
+  return CacheBag(resid, std::move(new_bag));
+}
+
+void AssetManager2::SetBagSharingEnabled(bool enabled) {
+  ScopedLock<SharedBagCache> shared_bag_cache(GetSharedBagCache());
+  shared_bag_cache->enabled = enabled;
+  if (!enabled) {
+    shared_bag_cache->bags.clear();
+  }
+}
+
+ApkAssetsCookie AssetManager2::GetSharedBagCookie(uint32_t resid) const {
+  const uint8_t package_idx = package_ids_[get_package_id(resid)];
+  if (package_idx == 0xff) {
+    return kInvalidCookie;
+  }
+
+  // Overlays and split packages make the resolved bag depend on the set of ApkAssets, and dynamic
+  // packages have their references rewritten per AssetManager.
+  const PackageGroup& package_group = package_groups_[package_idx];
+  if (package_group.packages_.size() != 1u || !package_group.overlays_.empty()) {
+    return kInvalidCookie;
+  }
+
+  const LoadedPackage* package = package_group.packages_[0].loaded_package_;
+  if (!package->IsSystem() || package->IsDynamic() || package->IsCustomLoader()) {
+    return kInvalidCookie;
+  }
+  return package_group.cookies_[0];
+}
+
+const ResolvedBag* AssetManager2::FindSharedBag(uint32_t resid) {
+  const ApkAssetsCookie cookie = GetSharedBagCookie(resid);
+  if (cookie == kInvalidCookie) {
+    return nullptr;
+  }
+
+  ScopedLock<SharedBagCache> shared_bag_cache(GetSharedBagCache());
+  if (!shared_bag_cache->enabled) {
+    return nullptr;
+  }
+
+  auto iter = shared_bag_cache->bags.find(std::make_pair(apk_assets_[cookie], resid));
+  if (iter == shared_bag_cache->bags.end()) {
+    return nullptr;
+  }
+
+  const SharedBag& shared_bag = iter->second;
+  if (shared_bag.cookie != cookie ||
+      (shared_bag.configuration.diff(configuration_) & shared_bag.bag->type_spec_flags) != 0) {
+    return nullptr;
+  }
+
+  const ResolvedBag* bag = shared_bag.bag.get();
+  cached_shared_bags_[resid] = bag;
+  return bag;
+}
+
+const ResolvedBag* AssetManager2::CacheBag(uint32_t resid, util::unique_cptr<ResolvedBag> bag) {
+  ResolvedBag* result = bag.get();
+
+  const ApkAssetsCookie cookie = GetSharedBagCookie(resid);
+  const bool shareable = cookie != kInvalidCookie &&
+      std::all_of(begin(result), end(result), [&](const ResolvedBag::Entry& entry) {
+        return entry.cookie == cookie;
+      });
+
+  if (shareable) {
+    ScopedLock<SharedBagCache> shared_bag_cache(GetSharedBagCache());
+    if (shared_bag_cache->enabled && shared_bag_cache->bags.size() < kMaxSharedBags) {
+      // Bags of a resource resolved for a different configuration stay owned by the AssetManager
+      // that resolved them.
+      auto inserted = shared_bag_cache->bags.emplace(
+          std::make_pair(apk_assets_[cookie], resid),
+          SharedBag{cookie, configuration_, util::unique_cptr<ResolvedBag>()});
+      if (inserted.second) {
+        inserted.first->second.bag = std::move(bag);
+        cached_shared_bags_[resid] = result;
+        return result;
+      }
+    }
+  }
+
+  cached_bags_[resid] = std::move(bag);
   return result;
 }
 
@@ -1265,37 +1516,71 @@ uint32_t AssetManager2::GetResourceId(const std::string& resource_name,
 }
 
 void AssetManager2::RebuildFilterList(bool filter_incompatible_configs) {
+  filter_incompatible_configs_ = filter_incompatible_configs;
   for (PackageGroup& group : package_groups_) {
     for (ConfiguredPackage& impl : group.packages_) {
-      // Destroy it.
-      impl.filtered_configs_.~ByteBucketArray();
-
-      // Re-create it.
-      new (&impl.filtered_configs_) ByteBucketArray<FilteredConfigGroup>();
-
-      // Create the filters here.
-      impl.loaded_package_->ForEachTypeSpec([&](const TypeSpec* spec, uint8_t type_index) {
-        FilteredConfigGroup& group = impl.filtered_configs_.editItemAt(type_index);
-        const auto iter_end = spec->types + spec->type_count;
-        for (auto iter = spec->types; iter != iter_end; ++iter) {
-          ResTable_config this_config;
-          this_config.copyFromDtoH((*iter)->config);
-          if (!filter_incompatible_configs || this_config.match(configuration_)) {
-            group.configurations.push_back(this_config);
-            group.types.push_back(*iter);
-          }
-        }
-      });
+      RebuildFilteredConfigs(&impl, filter_incompatible_configs);
     }
   }
 }
 
+void AssetManager2::RebuildFilteredConfigs(ConfiguredPackage* impl,
+                                           bool filter_incompatible_configs) {
+  // Destroy it.
+  impl->filtered_configs_.~ByteBucketArray();
+
+  // Re-create it.
+  new (&impl->filtered_configs_) ByteBucketArray<FilteredConfigGroup>();
+
+  // Create the filters here.
+  impl->loaded_package_->ForEachTypeSpec([&](const TypeSpec* spec, uint8_t type_index) {
+    FilteredConfigGroup& group = impl->filtered_configs_.editItemAt(type_index);
+    const auto iter_end = spec->types + spec->type_count;
+    for (auto iter = spec->types; iter != iter_end; ++iter) {
+      ResTable_config this_config;
+      this_config.copyFromDtoH((*iter)->config);
+      if (!filter_incompatible_configs || this_config.match(configuration_)) {
+        group.configurations.push_back(this_config);
+        group.types.push_back(*iter);
+      }
+    }
+
+    if (filter_incompatible_configs) {
+      SortFilteredConfigGroup(&group);
+    }
+  });
+}
+
+void AssetManager2::SortFilteredConfigGroup(FilteredConfigGroup* group) const {
+  // Order the configurations by repeatedly selecting the best remaining match, the same way
+  // FindEntryInternal() selects the best configuration during a lookup. This keeps the selection
+  // identical to the linear search even though ResTable_config::isBetterThan() does not
+  // guarantee a strict weak ordering. Types rarely have more than a few dozen configurations.
+  const size_t count = group->configurations.size();
+  for (size_t i = 0; i + 1 < count; i++) {
+    size_t best = i;
+    for (size_t j = i + 1; j < count; j++) {
+      if (group->configurations[j].isBetterThan(group->configurations[best], &configuration_)) {
+        best = j;
+      }
+    }
+
+    if (best != i) {
+      std::swap(group->configurations[i], group->configurations[best]);
+      std::swap(group->types[i], group->types[best]);
+    }
+  }
+  group->sorted_by_match = true;
+}
+
 void AssetManager2::InvalidateCaches(uint32_t diff) {
   cached_bag_resid_stacks_.clear();
 
   if (diff == 0xffffffffu) {
     // Everything must go.
     cached_bags_.clear();
+    cached_shared_bags_.clear();
+    cached_entries_.clear();
     return;
   }
 
@@ -1308,6 +1593,90 @@ void AssetManager2::InvalidateCaches(uint32_t diff) {
       ++iter;
     }
   }
+
+  for (auto iter = cached_shared_bags_.cbegin(); iter != cached_shared_bags_.cend();) {
+    if (diff & iter->second->type_spec_flags) {
+      iter = cached_shared_bags_.erase(iter);
+    } else {
+      ++iter;
+    }
+  }
+
+  for (auto iter = cached_entries_.cbegin(); iter != cached_entries_.cend();) {
+    if (diff & iter->second.type_flags) {
+      iter = cached_entries_.erase(iter);
+    } else {
+      ++iter;
+    }
+  }
+}
+
+void AssetManager2::InvalidateCachesForPackages(const std::vector<uint8_t>& package_ids,
+                                                ApkAssetsCookie changed_cookie,
+                                                bool invalidate_bags) {
+  std::array<bool, std::numeric_limits<uint8_t>::max() + 1> affected{};
+  std::set<ApkAssetsCookie> affected_cookies = {changed_cookie};
+  for (uint8_t package_id : package_ids) {
+    affected[package_id] = true;
+    const uint8_t idx = package_ids_[package_id];
+    if (idx != 0xff) {
+      affected_cookies.insert(package_groups_[idx].cookies_.begin(),
+                              package_groups_[idx].cookies_.end());
+    }
+  }
+  auto is_affected = [&](uint32_t resid) { return affected[get_package_id(resid)]; };
+
+  for (auto iter = cached_entries_.cbegin(); iter != cached_entries_.cend();) {
+    if (is_affected(iter->first)) {
+      iter = cached_entries_.erase(iter);
+    } else {
+      ++iter;
+    }
+  }
+
+  if (!invalidate_bags) {
+    return;
+  }
+
+  // A bag inherits the entries of its parents, which may reside in other packages, so a bag is
+  // also purged if any of its entries or known parents come from an affected package.
+  auto is_bag_affected = [&](uint32_t resid, const ResolvedBag* bag) {
+    if (is_affected(resid)) {
+      return true;
+    }
+    auto stack_iter = cached_bag_resid_stacks_.find(resid);
+    if (stack_iter != cached_bag_resid_stacks_.end()
+        && std::any_of(stack_iter->second.begin(), stack_iter->second.end(), is_affected)) {
+      return true;
+    }
+    return std::any_of(begin(bag), end(bag), [&](const ResolvedBag::Entry& entry) {
+      return affected_cookies.find(entry.cookie) != affected_cookies.end();
+    });
+  };
+
+  for (auto iter = cached_bags_.cbegin(); iter != cached_bags_.cend();) {
+    if (is_bag_affected(iter->first, iter->second.get())) {
+      iter = cached_bags_.erase(iter);
+    } else {
+      ++iter;
+    }
+  }
+
+  for (auto iter = cached_shared_bags_.cbegin(); iter != cached_shared_bags_.cend();) {
+    if (is_bag_affected(iter->first, iter->second)) {
+      iter = cached_shared_bags_.erase(iter);
+    } else {
+      ++iter;
+    }
+  }
+
+  for (auto iter = cached_bag_resid_stacks_.cbegin(); iter != cached_bag_resid_stacks_.cend();) {
+    if (std::any_of(iter->second.begin(), iter->second.end(), is_affected)) {
+      iter = cached_bag_resid_stacks_.erase(iter);
+    } else {
+      ++iter;
+    }
+  }
 }
 
 uint8_t AssetManager2::GetAssignedPackageId(const LoadedPackage* package) const {
@@ -1361,6 +1730,8 @@ bool Theme::ApplyStyle(uint32_t resid, bool force) {
     return false;
   }
 
+  ClearAttributeCache();
+
   // Merge the flags from this style.
   type_spec_flags_ |= bag->type_spec_flags;
 
@@ -1439,6 +1810,8 @@ ApkAssetsCookie Theme::GetAttribute(uint32_t resid, Res_value* out_value,
                                     uint32_t* out_flags) const {
   int cnt = 20;
 
+  const uint32_t requested_resid = resid;
+  bool cache_result = false;
   uint32_t type_spec_flags = 0u;
 
   do {
@@ -1455,18 +1828,43 @@ ApkAssetsCookie Theme::GetAttribute(uint32_t resid, Res_value* out_value,
           type_spec_flags |= entry.type_spec_flags;
 
           if (entry.value.dataType == Res_value::TYPE_ATTRIBUTE) {
+            if (!cache_result) {
+              // Following attribute references is the expensive part of the lookup, so check
+              // whether this attribute was already resolved.
+              auto cached_iter = cached_attributes_.find(requested_resid);
+              if (cached_iter != cached_attributes_.end()) {
+                asset_manager_->theme_attribute_cache_hits_++;
+                const CachedAttribute& cached = cached_iter->second;
+                if (cached.cookie == kInvalidCookie) {
+                  return kInvalidCookie;
+                }
+                *out_value = cached.value;
+                *out_flags = cached.type_spec_flags;
+                return cached.cookie;
+              }
+              asset_manager_->theme_attribute_cache_misses_++;
+              cache_result = true;
+            }
+
             if (cnt > 0) {
               cnt--;
               resid = entry.value.data;
               continue;
             }
-            return kInvalidCookie;
+            break;
           }
 
           // @null is different than @empty.
           if (entry.value.dataType == Res_value::TYPE_NULL &&
               entry.value.data != Res_value::DATA_NULL_EMPTY) {
-            return kInvalidCookie;
+            break;
+          }
+
+          if (cache_result) {
+            if (cached_attributes_.size() >= kMaxCachedThemeAttributes) {
+              cached_attributes_.clear();
+            }
+            cached_attributes_[requested_resid] = {entry.cookie, type_spec_flags, entry.value};
           }
 
           *out_value = entry.value;
@@ -1477,6 +1875,14 @@ ApkAssetsCookie Theme::GetAttribute(uint32_t resid, Res_value* out_value,
     }
     break;
   } while (true);
+
+  if (cache_result) {
+    // Remember that the chain of attribute references does not resolve to a value.
+    if (cached_attributes_.size() >= kMaxCachedThemeAttributes) {
+      cached_attributes_.clear();
+    }
+    cached_attributes_[requested_resid] = {kInvalidCookie, 0u, Res_value{}};
+  }
   return kInvalidCookie;
 }
 
@@ -1499,7 +1905,12 @@ ApkAssetsCookie Theme::ResolveAttributeReference(ApkAssetsCookie cookie, Res_val
                                           in_out_type_spec_flags, out_last_ref);
 }
 
+void Theme::ClearAttributeCache() {
+  cached_attributes_.clear();
+}
+
 void Theme::Clear() {
+  ClearAttributeCache();
   type_spec_flags_ = 0u;
   for (std::unique_ptr<Package>& package : packages_) {
     package.reset();
@@ -1511,6 +1922,7 @@ void Theme::SetTo(const Theme& o) {
     return;
   }
 
+  ClearAttributeCache();
   type_spec_flags_ = o.type_spec_flags_;
 
   if (asset_manager_ == o.asset_manager_) {
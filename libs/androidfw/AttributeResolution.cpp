@@ -17,6 +17,7 @@
 #include "androidfw/AttributeResolution.h"
 
 #include <cstdint>
+#include <vector>
 
 #include <log/log.h>
 
@@ -202,20 +203,32 @@ bool ResolveAttrs(Theme* theme, uint32_t def_style_attr, uint32_t def_style_res,
   return true;
 }
 
-void ApplyStyle(Theme* theme, ResXMLParser* xml_parser, uint32_t def_style_attr,
-                uint32_t def_style_resid, const uint32_t* attrs, size_t attrs_length,
-                uint32_t* out_values, uint32_t* out_indices) {
-  if (kDebugStyles) {
-    ALOGI("APPLY STYLE: theme=0x%p defStyleAttr=0x%x defStyleRes=0x%x xml=0x%p", theme,
-          def_style_attr, def_style_resid, xml_parser);
-  }
+namespace {
 
-  AssetManager2* assetmanager = theme->GetAssetManager();
-  ResTable_config config;
+// The result of resolving an attribute that is only defined by the theme. It only depends on the
+// theme and the requested attribute, so it can be reused between elements styled in a batch.
+struct ThemeAttributeValue {
+  bool resolved = false;
+  ApkAssetsCookie cookie = kInvalidCookie;
   Res_value value;
+  uint32_t type_set_flags = 0u;
+  uint32_t resid = 0u;
+  uint16_t density = 0u;
+};
 
-  int indices_idx = 0;
+// State of ApplyStyleBatch() that is shared by all of the elements of a batch.
+struct ApplyStyleBatchState {
+  // The default style entry for each of the requested attributes, or nullptr if the default style
+  // does not define the attribute.
+  std::vector<const ResolvedBag::Entry*> def_style_entries;
+
+  // The theme values of each of the requested attributes, resolved on first use.
+  std::vector<ThemeAttributeValue> theme_values;
+};
 
+// Resolves the default style used for an element from `def_style_attr` and `def_style_resid`.
+const ResolvedBag* GetDefaultStyleBag(Theme* theme, uint32_t def_style_attr,
+                                      uint32_t def_style_resid, uint32_t* out_def_style_flags) {
   // Load default style from attribute, if specified...
   uint32_t def_style_flags = 0u;
   if (def_style_attr != 0) {
@@ -227,6 +240,31 @@ void ApplyStyle(Theme* theme, ResXMLParser* xml_parser, uint32_t def_style_attr,
     }
   }
 
+  // Retrieve the default style bag, if requested.
+  const ResolvedBag* default_style_bag = nullptr;
+  if (def_style_resid != 0) {
+    default_style_bag = theme->GetAssetManager()->GetBag(def_style_resid);
+    if (default_style_bag != nullptr) {
+      def_style_flags |= default_style_bag->type_spec_flags;
+    }
+  }
+
+  *out_def_style_flags = def_style_flags;
+  return default_style_bag;
+}
+
+// Applies the style of a single element. If `batch_state` is set, the default style entries are
+// taken from it and the values resolved from the theme are shared with the rest of the batch.
+void ApplyStyleImpl(Theme* theme, ResXMLParser* xml_parser, const ResolvedBag* default_style_bag,
+                    uint32_t def_style_flags, const uint32_t* attrs, size_t attrs_length,
+                    ApplyStyleBatchState* batch_state, uint32_t* out_values,
+                    uint32_t* out_indices) {
+  AssetManager2* assetmanager = theme->GetAssetManager();
+  ResTable_config config;
+  Res_value value;
+
+  int indices_idx = 0;
+
   // Retrieve the style resource ID associated with the current XML tag's style attribute.
   uint32_t style_resid = 0u;
   uint32_t style_flags = 0u;
@@ -246,15 +284,6 @@ void ApplyStyle(Theme* theme, ResXMLParser* xml_parser, uint32_t def_style_attr,
     }
   }
 
-  // Retrieve the default style bag, if requested.
-  const ResolvedBag* default_style_bag = nullptr;
-  if (def_style_resid != 0) {
-    default_style_bag = assetmanager->GetBag(def_style_resid);
-    if (default_style_bag != nullptr) {
-      def_style_flags |= default_style_bag->type_spec_flags;
-    }
-  }
-
   BagAttributeFinder def_style_attr_finder(default_style_bag);
 
   // Retrieve the style class bag, if requested.
@@ -321,8 +350,17 @@ void ApplyStyle(Theme* theme, ResXMLParser* xml_parser, uint32_t def_style_attr,
 
     if (value.dataType == Res_value::TYPE_NULL && value.data != Res_value::DATA_NULL_EMPTY) {
       // Walk through the default style values looking for the requested attribute.
-      const ResolvedBag::Entry* entry = def_style_attr_finder.Find(cur_ident);
-      if (entry != def_style_attr_finder.end()) {
+      const ResolvedBag::Entry* entry = nullptr;
+      if (batch_state != nullptr) {
+        entry = batch_state->def_style_entries[ii];
+      } else {
+        entry = def_style_attr_finder.Find(cur_ident);
+        if (entry == def_style_attr_finder.end()) {
+          entry = nullptr;
+        }
+      }
+
+      if (entry != nullptr) {
         // We found the attribute we were looking for.
         cookie = entry->cookie;
         type_set_flags = def_style_flags;
@@ -348,21 +386,41 @@ void ApplyStyle(Theme* theme, ResXMLParser* xml_parser, uint32_t def_style_attr,
         ALOGI("-> Resolved attr: type=0x%x, data=0x%08x", value.dataType, value.data);
       }
     } else if (value.data != Res_value::DATA_NULL_EMPTY) {
-      // If we still don't have a value for this attribute, try to find it in the theme!
-      ApkAssetsCookie new_cookie = theme->GetAttribute(cur_ident, &value, &type_set_flags);
-      // TODO: set value_source_resid for the style in the theme that was used.
-      if (new_cookie != kInvalidCookie) {
-        if (kDebugStyles) {
-          ALOGI("-> From theme: type=0x%x, data=0x%08x", value.dataType, value.data);
-        }
-        new_cookie =
-            assetmanager->ResolveReference(new_cookie, &value, &config, &type_set_flags, &resid);
+      ThemeAttributeValue* theme_value =
+          batch_state != nullptr ? &batch_state->theme_values[ii] : nullptr;
+      if (theme_value != nullptr && theme_value->resolved) {
+        // Another element of the batch already resolved this attribute from the theme.
+        cookie = theme_value->cookie;
+        value = theme_value->value;
+        type_set_flags = theme_value->type_set_flags;
+        resid = theme_value->resid;
+        config.density = theme_value->density;
+      } else {
+        // If we still don't have a value for this attribute, try to find it in the theme!
+        ApkAssetsCookie new_cookie = theme->GetAttribute(cur_ident, &value, &type_set_flags);
+        // TODO: set value_source_resid for the style in the theme that was used.
         if (new_cookie != kInvalidCookie) {
-          cookie = new_cookie;
+          if (kDebugStyles) {
+            ALOGI("-> From theme: type=0x%x, data=0x%08x", value.dataType, value.data);
+          }
+          new_cookie =
+              assetmanager->ResolveReference(new_cookie, &value, &config, &type_set_flags, &resid);
+          if (new_cookie != kInvalidCookie) {
+            cookie = new_cookie;
+          }
+
+          if (kDebugStyles) {
+            ALOGI("-> Resolved theme: type=0x%x, data=0x%08x", value.dataType, value.data);
+          }
         }
 
-        if (kDebugStyles) {
-          ALOGI("-> Resolved theme: type=0x%x, data=0x%08x", value.dataType, value.data);
+        if (theme_value != nullptr) {
+          theme_value->resolved = true;
+          theme_value->cookie = cookie;
+          theme_value->value = value;
+          theme_value->type_set_flags = type_set_flags;
+          theme_value->resid = resid;
+          theme_value->density = config.density;
         }
       }
     }
@@ -403,6 +461,55 @@ void ApplyStyle(Theme* theme, ResXMLParser* xml_parser, uint32_t def_style_attr,
   out_indices[0] = indices_idx;
 }
 
+}  // namespace
+
+void ApplyStyle(Theme* theme, ResXMLParser* xml_parser, uint32_t def_style_attr,
+                uint32_t def_style_resid, const uint32_t* attrs, size_t attrs_length,
+                uint32_t* out_values, uint32_t* out_indices) {
+  if (kDebugStyles) {
+    ALOGI("APPLY STYLE: theme=0x%p defStyleAttr=0x%x defStyleRes=0x%x xml=0x%p", theme,
+          def_style_attr, def_style_resid, xml_parser);
+  }
+
+  uint32_t def_style_flags = 0u;
+  const ResolvedBag* default_style_bag =
+      GetDefaultStyleBag(theme, def_style_attr, def_style_resid, &def_style_flags);
+  ApplyStyleImpl(theme, xml_parser, default_style_bag, def_style_flags, attrs, attrs_length,
+                 nullptr /*batch_state*/, out_values, out_indices);
+}
+
+void ApplyStyleBatch(Theme* theme, ResXMLParser* const* xml_parsers, size_t xml_parsers_length,
+                     uint32_t def_style_attr, uint32_t def_style_resid, const uint32_t* attrs,
+                     size_t attrs_length, uint32_t* out_values, uint32_t* out_indices) {
+  if (kDebugStyles) {
+    ALOGI("APPLY STYLE BATCH: theme=0x%p defStyleAttr=0x%x defStyleRes=0x%x count=%zu", theme,
+          def_style_attr, def_style_resid, xml_parsers_length);
+  }
+
+  uint32_t def_style_flags = 0u;
+  const ResolvedBag* default_style_bag =
+      GetDefaultStyleBag(theme, def_style_attr, def_style_resid, &def_style_flags);
+
+  // The requested attributes are sorted, so the default style entries of every attribute are
+  // found in a single pass over the default style bag.
+  ApplyStyleBatchState batch_state;
+  batch_state.def_style_entries.resize(attrs_length, nullptr);
+  batch_state.theme_values.resize(attrs_length);
+  BagAttributeFinder def_style_attr_finder(default_style_bag);
+  for (size_t ii = 0; ii < attrs_length; ii++) {
+    const ResolvedBag::Entry* entry = def_style_attr_finder.Find(attrs[ii]);
+    if (entry != def_style_attr_finder.end()) {
+      batch_state.def_style_entries[ii] = entry;
+    }
+  }
+
+  for (size_t i = 0; i < xml_parsers_length; i++) {
+    ApplyStyleImpl(theme, xml_parsers[i], default_style_bag, def_style_flags, attrs, attrs_length,
+                   &batch_state, out_values + (i * attrs_length * STYLE_NUM_ENTRIES),
+                   out_indices + (i * (attrs_length + 1)));
+  }
+}
+
 bool RetrieveAttributes(AssetManager2* assetmanager, ResXMLParser* xml_parser, uint32_t* attrs,
                         size_t attrs_length, uint32_t* out_values, uint32_t* out_indices) {
   ResTable_config config;
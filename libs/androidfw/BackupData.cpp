@@ -17,7 +17,9 @@
 #define LOG_TAG "backup_data"
 
 #include <stdio.h>
+#include <stdlib.h>
 #include <string.h>
+#include <sys/uio.h>
 #include <unistd.h>
 
 #include <androidfw/BackupHelpers.h>
@@ -49,6 +51,10 @@ padding_extra(size_t n)
     return ROUND_UP[n % 4];
 }
 
+// Restore data is read through a buffer of this size, so that the small header, key
+// and padding reads of each entity don't each cost a syscall.
+static const size_t kReadBufferSize = 64 * 1024;
+
 BackupDataWriter::BackupDataWriter(int fd)
     :m_fd(fd),
      m_status(NO_ERROR),
@@ -62,27 +68,6 @@ BackupDataWriter::~BackupDataWriter()
 {
 }
 
-// Pad out anything they've previously written to the next 4 byte boundary.
-status_t
-BackupDataWriter::write_padding_for(int n)
-{
-    ssize_t amt;
-    ssize_t paddingSize;
-
-    paddingSize = padding_extra(n);
-    if (paddingSize > 0) {
-        uint32_t padding = 0xbcbcbcbc;
-        if (kIsDebug) ALOGI("writing %zd padding bytes for %d", paddingSize, n);
-        amt = write(m_fd, &padding, paddingSize);
-        if (amt != paddingSize) {
-            m_status = errno;
-            return m_status;
-        }
-        m_pos += amt;
-    }
-    return NO_ERROR;
-}
-
 status_t
 BackupDataWriter::WriteEntityHeader(const String8& key, size_t dataSize)
 {
@@ -90,13 +75,6 @@ BackupDataWriter::WriteEntityHeader(const String8& key, size_t dataSize)
         return m_status;
     }
 
-    ssize_t amt;
-
-    amt = write_padding_for(m_pos);
-    if (amt != 0) {
-        return amt;
-    }
-
     String8 k;
     if (m_keyPrefix.length() > 0) {
         k = m_keyPrefix;
@@ -119,27 +97,34 @@ BackupDataWriter::WriteEntityHeader(const String8& key, size_t dataSize)
     header.keyLen = tolel(keyLen);
     header.dataSize = tolel(dataSize);
 
-    if (kIsDebug) ALOGI("writing entity header, %zu bytes", sizeof(entity_header_v1));
-    amt = write(m_fd, &header, sizeof(entity_header_v1));
-    if (amt != sizeof(entity_header_v1)) {
-        m_status = errno;
-        return m_status;
+    // Pad out anything they've previously written to the next 4 byte boundary, then
+    // write the header, the key and the key's padding with a single syscall.
+    uint32_t padding = 0xbcbcbcbc;
+    struct iovec iov[4];
+    iov[0].iov_base = &padding;
+    iov[0].iov_len = padding_extra(m_pos);
+    iov[1].iov_base = &header;
+    iov[1].iov_len = sizeof(entity_header_v1);
+    iov[2].iov_base = const_cast<char*>(k.string());
+    iov[2].iov_len = keyLen+1;
+    iov[3].iov_base = &padding;
+    iov[3].iov_len = padding_extra(keyLen+1);
+
+    ssize_t total = 0;
+    for (const struct iovec& v : iov) {
+        total += v.iov_len;
     }
-    m_pos += amt;
-
-    if (kIsDebug) ALOGI("writing entity header key, %zd bytes", keyLen+1);
-    amt = write(m_fd, k.string(), keyLen+1);
-    if (amt != keyLen+1) {
+    if (kIsDebug) ALOGI("writing entity header and key '%s', %zd bytes", k.string(), total);
+    ssize_t amt = writev(m_fd, iov, 4);
+    if (amt != total) {
         m_status = errno;
         return m_status;
     }
     m_pos += amt;
 
-    amt = write_padding_for(keyLen+1);
-
     m_entityCount++;
 
-    return amt;
+    return NO_ERROR;
 }
 
 status_t
@@ -183,10 +168,51 @@ BackupDataReader::BackupDataReader(int fd)
     memset(&m_header, 0, sizeof(m_header));
     m_pos = (ssize_t) lseek(fd, 0, SEEK_CUR);
     if (kIsDebug) ALOGI("BackupDataReader(%d) @ %ld", fd, (long)m_pos);
+    m_buf = malloc(kReadBufferSize);
+    m_bufPos = m_bufLen = 0;
 }
 
 BackupDataReader::~BackupDataReader()
 {
+    free(m_buf);
+}
+
+// Reads up to size bytes, returning fewer only at end of file.  Returns -1 with errno
+// set if nothing could be read because of an error.
+ssize_t
+BackupDataReader::read_buffered(void* data, size_t size)
+{
+    uint8_t* out = (uint8_t*)data;
+    size_t total = 0;
+    while (total < size) {
+        if (m_bufPos == m_bufLen) {
+            size_t wanted = size - total;
+            // Large reads go straight to the caller's memory.
+            bool direct = m_buf == NULL || wanted >= kReadBufferSize;
+            ssize_t amt = direct ? read(m_fd, out + total, wanted)
+                                 : read(m_fd, m_buf, kReadBufferSize);
+            if (amt < 0) {
+                return total > 0 ? (ssize_t)total : -1;
+            }
+            if (amt == 0) {
+                break;
+            }
+            if (direct) {
+                total += amt;
+                continue;
+            }
+            m_bufPos = 0;
+            m_bufLen = amt;
+        }
+        size_t n = size - total;
+        if (n > m_bufLen - m_bufPos) {
+            n = m_bufLen - m_bufPos;
+        }
+        memcpy(out + total, (uint8_t*)m_buf + m_bufPos, n);
+        m_bufPos += n;
+        total += n;
+    }
+    return total;
 }
 
 status_t
@@ -237,7 +263,7 @@ BackupDataReader::ReadNextHeader(bool* done, int* type)
     else if (amt != NO_ERROR) {
         return amt;
     }
-    amt = read(m_fd, &m_header, sizeof(m_header));
+    amt = read_buffered(&m_header, sizeof(m_header));
     *done = m_done = (amt == 0);
     if (*done) {
         return NO_ERROR;
@@ -270,7 +296,7 @@ BackupDataReader::ReadNextHeader(bool* done, int* type)
                 m_status = ENOMEM;
                 return m_status;
             }
-            int amt = read(m_fd, buf, size+1);
+            int amt = read_buffered(buf, size+1);
             CHECK_SIZE(amt, (int)size+1);
             m_key.unlockBuffer(size);
             m_pos += size+1;
@@ -318,11 +344,18 @@ BackupDataReader::SkipEntityData()
         return EINVAL;
     }
     if (m_header.entity.dataSize > 0) {
-        int pos = lseek(m_fd, m_dataEndPos, SEEK_SET);
-        if (pos == -1) {
-            return errno;
+        size_t skip = m_dataEndPos - m_pos;
+        if (skip <= m_bufLen - m_bufPos) {
+            m_bufPos += skip;
+            m_pos = m_dataEndPos;
+        } else {
+            int pos = lseek(m_fd, m_dataEndPos, SEEK_SET);
+            if (pos == -1) {
+                return errno;
+            }
+            m_bufPos = m_bufLen = 0;
+            m_pos = pos;
         }
-        m_pos = pos;
     }
     SKIP_PADDING();
     return NO_ERROR;
@@ -348,7 +381,7 @@ BackupDataReader::ReadEntityData(void* data, size_t size)
     if (kIsDebug) {
         ALOGD("   reading %zu bytes", size);
     }
-    int amt = read(m_fd, data, size);
+    int amt = read_buffered(data, size);
     if (amt < 0) {
         m_status = errno;
         return -1;
@@ -370,7 +403,7 @@ BackupDataReader::skip_padding()
     paddingSize = padding_extra(m_pos);
     if (paddingSize > 0) {
         uint32_t padding;
-        amt = read(m_fd, &padding, paddingSize);
+        amt = read_buffered(&padding, paddingSize);
         CHECK_SIZE(amt, paddingSize);
         m_pos += amt;
     }
@@ -30,6 +30,11 @@
 #include <utime.h>
 #include <zlib.h>
 
+#include <algorithm>
+#include <atomic>
+#include <thread>
+#include <vector>
+
 #include <log/log.h>
 #include <utils/ByteOrder.h>
 #include <utils/KeyedVector.h>
@@ -68,6 +73,13 @@ struct file_metadata_v1 {
 const static int CURRENT_METADATA_VERSION = 1;
 
 static const bool kIsDebug = false;
+
+// Size of the buffer used to read file contents, both for hashing and for streaming
+// into the backup data.
+static const int kFileBufferSize = 64*1024;
+
+// Maximum number of threads used to stat and checksum files ahead of writing them.
+static const size_t kMaxHashThreads = 4;
 #if TEST_BACKUP_HELPERS
 #define LOGP(f, x...) if (kIsDebug) printf(f "\n", x)
 #else
@@ -207,13 +219,15 @@ write_delete_file(BackupDataWriter* dataStream, const String8& key)
     return dataStream->WriteEntityHeader(key, -1);
 }
 
+// Writes the file's metadata and contents as an entity.  If outCrc is non-null it
+// receives the CRC32 of the contents, computed from the same reads that stream them.
 static int
 write_update_file(BackupDataWriter* dataStream, int fd, int mode, const String8& key,
-        char const* realFilename)
+        char const* realFilename, int* outCrc = nullptr)
 {
     LOGP("write_update_file %s (%s) : mode 0%o\n", realFilename, key.string(), mode);
 
-    const int bufsize = 4*1024;
+    const int bufsize = kFileBufferSize;
     int err;
     int amt;
     int fileSize;
@@ -248,11 +262,13 @@ write_update_file(BackupDataWriter* dataStream, int fd, int mode, const String8&
     bytesLeft -= sizeof(metadata); // bytesLeft should == fileSize now
 
     // now store the file content
-    while ((amt = read(fd, buf, bufsize)) != 0 && bytesLeft > 0) {
+    int crc = crc32(0L, Z_NULL, 0);
+    while ((amt = read(fd, buf, bufsize)) > 0 && bytesLeft > 0) {
         bytesLeft -= amt;
         if (bytesLeft < 0) {
             amt += bytesLeft; // Plus a negative is minus.  Don't write more than we promised.
         }
+        crc = crc32(crc, (Bytef*)buf, amt);
         err = dataStream->WriteEntityData(buf, amt);
         if (err != 0) {
             free(buf);
@@ -278,12 +294,16 @@ write_update_file(BackupDataWriter* dataStream, int fd, int mode, const String8&
                 " You aren't doing proper locking!", realFilename, fileSize, fileSize-bytesLeft);
     }
 
+    if (outCrc != nullptr) {
+        *outCrc = crc;
+    }
     free(buf);
     return NO_ERROR;
 }
 
 static int
-write_update_file(BackupDataWriter* dataStream, const String8& key, char const* realFilename)
+write_update_file(BackupDataWriter* dataStream, const String8& key, char const* realFilename,
+        int* outCrc = nullptr)
 {
     int err;
     struct stat st;
@@ -298,7 +318,7 @@ write_update_file(BackupDataWriter* dataStream, const String8& key, char const*
         return errno;
     }
 
-    err = write_update_file(dataStream, fd, st.st_mode, key, realFilename);
+    err = write_update_file(dataStream, fd, st.st_mode, key, realFilename, outCrc);
     close(fd);
     return err;
 }
@@ -310,7 +330,7 @@ compute_crc32(const char* file, FileRec* out) {
         return -1;
     }
 
-    const int bufsize = 4*1024;
+    const int bufsize = kFileBufferSize;
     int amt;
 
     char* buf = (char*)malloc(bufsize);
@@ -318,7 +338,7 @@ compute_crc32(const char* file, FileRec* out) {
 
     lseek(fd, 0, SEEK_SET);
 
-    while ((amt = read(fd, buf, bufsize)) != 0) {
+    while ((amt = read(fd, buf, bufsize)) > 0) {
         crc = crc32(crc, (Bytef*)buf, amt);
     }
 
@@ -345,37 +365,70 @@ back_up_files(int oldSnapshotFD, BackupDataWriter* dataStream, int newSnapshotFD
         }
     }
 
-    for (int i=0; i<fileCount; i++) {
-        String8 key(keys[i]);
-        FileRec r;
-        char const* file = files[i];
-        r.file = file;
-        struct stat st;
-
-        err = stat(file, &st);
-        if (err != 0) {
-            // not found => treat as deleted
-            continue;
-        } else {
+    // Stat every file, and checksum the ones whose stat matches the old snapshot, on a few
+    // threads.  A CRC is only needed to notice content changes that left the stat alone;
+    // files that are new or visibly changed are written anyway, and get their CRC while
+    // being streamed into the backup.
+    enum { kMissing, kNeedsCrc, kReady, kCrcFailed };
+    std::vector<FileRec> records(fileCount);
+    std::vector<int> states(fileCount, kMissing);
+    std::atomic<int> next(0);
+    auto worker = [&]() {
+        for (int i = next++; i < fileCount; i = next++) {
+            FileRec& r = records[i];
+            r.file = files[i];
+            struct stat st;
+            if (stat(files[i], &st) != 0) {
+                // not found => treat as deleted
+                continue;
+            }
             r.deleted = false;
             r.s.modTime_sec = st.st_mtime;
             r.s.modTime_nsec = 0; // workaround sim breakage
             //r.s.modTime_nsec = st.st_mtime_nsec;
             r.s.mode = st.st_mode;
             r.s.size = st.st_size;
+            r.s.crc32 = 0;
 
-            if (newSnapshot.indexOfKey(key) >= 0) {
-                LOGP("back_up_files key already in use '%s'", key.string());
-                return -1;
+            ssize_t old = oldSnapshot.indexOfKey(String8(keys[i]));
+            if (old < 0) {
+                states[i] = kNeedsCrc;
+                continue;
             }
-
-            // compute the CRC
-            if (compute_crc32(file, &r) != NO_ERROR) {
-                ALOGW("Unable to open file %s", file);
+            const FileState& f = oldSnapshot.valueAt(old);
+            if (f.modTime_sec != r.s.modTime_sec || f.modTime_nsec != r.s.modTime_nsec
+                    || f.mode != r.s.mode || f.size != r.s.size) {
+                states[i] = kNeedsCrc;
                 continue;
             }
+            states[i] = compute_crc32(files[i], &r) == NO_ERROR ? kReady : kCrcFailed;
+        }
+    };
+    const size_t threadCount = std::min(static_cast<size_t>(std::max(fileCount, 0)),
+            kMaxHashThreads);
+    std::vector<std::thread> threads;
+    for (size_t i = 1; i < threadCount; i++) {
+        threads.emplace_back(worker);
+    }
+    worker();
+    for (std::thread& thread : threads) {
+        thread.join();
+    }
+
+    for (int i=0; i<fileCount; i++) {
+        if (states[i] == kMissing) {
+            continue;
+        }
+        String8 key(keys[i]);
+        if (newSnapshot.indexOfKey(key) >= 0) {
+            LOGP("back_up_files key already in use '%s'", key.string());
+            return -1;
+        }
+        if (states[i] == kCrcFailed) {
+            ALOGW("Unable to open file %s", files[i]);
+            continue;
         }
-        newSnapshot.add(key, r);
+        newSnapshot.add(key, records[i]);
     }
 
     int n = 0;
@@ -395,8 +448,8 @@ back_up_files(int oldSnapshotFD, BackupDataWriter* dataStream, int newSnapshotFD
             n++;
         } else if (cmp > 0) {
             // file added
-            LOGP("file added: %s crc=0x%08x", g.file.string(), g.s.crc32);
-            write_update_file(dataStream, q, g.file.string());
+            LOGP("file added: %s", g.file.string());
+            write_update_file(dataStream, q, g.file.string(), &g.s.crc32);
             m++;
         } else {
             // same file exists in both old and new; check whether to update
@@ -413,7 +466,8 @@ back_up_files(int oldSnapshotFD, BackupDataWriter* dataStream, int newSnapshotFD
                 if (fd < 0) {
                     ALOGE("Unable to read file for backup: %s", g.file.string());
                 } else {
-                    write_update_file(dataStream, fd, g.s.mode, p, g.file.string());
+                    write_update_file(dataStream, fd, g.s.mode, p, g.file.string(),
+                            &g.s.crc32);
                     close(fd);
                 }
             }
@@ -432,7 +486,7 @@ back_up_files(int oldSnapshotFD, BackupDataWriter* dataStream, int newSnapshotFD
     while (m<M) {
         const String8& q = newSnapshot.keyAt(m);
         FileRec& g = newSnapshot.editValueAt(m);
-        write_update_file(dataStream, q, g.file.string());
+        write_update_file(dataStream, q, g.file.string(), &g.s.crc32);
         m++;
     }
 
@@ -20,6 +20,8 @@
 #include <androidfw/CursorWindow.h>
 #include <binder/Parcel.h>
 #include <utils/Log.h>
+#include <utils/Mutex.h>
+#include <utils/Timers.h>
 
 #include <cutils/ashmem.h>
 #include <sys/mman.h>
@@ -28,11 +30,59 @@
 #include <string.h>
 #include <stdlib.h>
 
+#include <map>
+#include <vector>
+
 namespace android {
 
+// The maximum number of released windows kept for reuse by createPooled().
+static const size_t kMaxPooledWindows = 2;
+
+// The maximum number of distinct window names that statistics are kept for.
+// Windows with other names are accounted under kOtherWindowsName.
+static const size_t kMaxStatsNames = 64;
+static const char* const kOtherWindowsName = "<other>";
+
+namespace {
+
+struct WindowStats {
+    uint32_t createCount = 0;
+    nsecs_t createTime = 0;
+    uint32_t reuseCount = 0;
+    uint32_t mapCount = 0;
+    nsecs_t mapTime = 0;
+};
+
+struct WindowPool {
+    Mutex lock;
+    std::vector<CursorWindow*> windows;
+    std::map<String8, WindowStats> stats;
+};
+
+WindowPool& getWindowPool() {
+    // Intentionally leaked so that windows can be recycled during process exit.
+    static WindowPool* pool = new WindowPool();
+    return *pool;
+}
+
+// Must be called with the pool lock held.
+WindowStats& getStatsLocked(WindowPool& pool, const String8& name) {
+    auto iter = pool.stats.find(name);
+    if (iter != pool.stats.end()) {
+        return iter->second;
+    }
+    if (pool.stats.size() >= kMaxStatsNames) {
+        return pool.stats[String8(kOtherWindowsName)];
+    }
+    return pool.stats[name];
+}
+
+} // namespace
+
 CursorWindow::CursorWindow(const String8& name, int ashmemFd,
         void* data, size_t size, bool readOnly) :
-        mName(name), mAshmemFd(ashmemFd), mData(data), mSize(size), mReadOnly(readOnly) {
+        mName(name), mAshmemFd(ashmemFd), mData(data), mSize(size), mReadOnly(readOnly),
+        mShared(false), mCachedChunkIndex(0), mCachedChunkOffset(0) {
     mHeader = static_cast<Header*>(mData);
 }
 
@@ -42,6 +92,73 @@ CursorWindow::~CursorWindow() {
 }
 
 status_t CursorWindow::create(const String8& name, size_t size, CursorWindow** outCursorWindow) {
+    const nsecs_t startTime = systemTime(SYSTEM_TIME_MONOTONIC);
+    status_t result = createAshmemWindow(name, size, outCursorWindow);
+    if (result == OK) {
+        WindowPool& pool = getWindowPool();
+        AutoMutex _l(pool.lock);
+        WindowStats& stats = getStatsLocked(pool, name);
+        stats.createCount++;
+        stats.createTime += systemTime(SYSTEM_TIME_MONOTONIC) - startTime;
+    }
+    return result;
+}
+
+status_t CursorWindow::createPooled(const String8& name, size_t size,
+        CursorWindow** outCursorWindow) {
+    {
+        WindowPool& pool = getWindowPool();
+        AutoMutex _l(pool.lock);
+        for (auto iter = pool.windows.begin(); iter != pool.windows.end(); ++iter) {
+            CursorWindow* window = *iter;
+            if (window->mSize == size) {
+                pool.windows.erase(iter);
+                window->mName = name;
+                getStatsLocked(pool, name).reuseCount++;
+                LOG_WINDOW("Reusing pooled CursorWindow %p of size %zu", window, size);
+                *outCursorWindow = window;
+                return OK;
+            }
+        }
+    }
+    return create(name, size, outCursorWindow);
+}
+
+void CursorWindow::recycle(CursorWindow* window) {
+    if (window == NULL) {
+        return;
+    }
+
+    if (!window->mReadOnly && !window->mShared) {
+        WindowPool& pool = getWindowPool();
+        AutoMutex _l(pool.lock);
+        if (pool.windows.size() < kMaxPooledWindows) {
+            // The next user of the window may share it with another process, which must not be
+            // able to see the data of this one.
+            memset(window->mData, 0, window->mHeader->freeOffset);
+            if (window->clear() == OK) {
+                pool.windows.push_back(window);
+                return;
+            }
+        }
+    }
+    delete window;
+}
+
+void CursorWindow::dumpStats(String8* out) {
+    WindowPool& pool = getWindowPool();
+    AutoMutex _l(pool.lock);
+    out->appendFormat("CursorWindow stats (%zu pooled windows):\n", pool.windows.size());
+    for (const auto& entry : pool.stats) {
+        const WindowStats& stats = entry.second;
+        out->appendFormat("  %s: created=%u (%.3f ms) reused=%u mapped=%u (%.3f ms)\n",
+                entry.first.string(), stats.createCount, stats.createTime / 1000000.0,
+                stats.reuseCount, stats.mapCount, stats.mapTime / 1000000.0);
+    }
+}
+
+status_t CursorWindow::createAshmemWindow(const String8& name, size_t size,
+        CursorWindow** outCursorWindow) {
     String8 ashmemName("CursorWindow: ");
     ashmemName.append(name);
 
@@ -89,6 +206,19 @@ status_t CursorWindow::create(const String8& name, size_t size, CursorWindow** o
 }
 
 status_t CursorWindow::createFromParcel(Parcel* parcel, CursorWindow** outCursorWindow) {
+    const nsecs_t startTime = systemTime(SYSTEM_TIME_MONOTONIC);
+    status_t result = mapFromParcel(parcel, outCursorWindow);
+    if (result == OK) {
+        WindowPool& pool = getWindowPool();
+        AutoMutex _l(pool.lock);
+        WindowStats& stats = getStatsLocked(pool, (*outCursorWindow)->mName);
+        stats.mapCount++;
+        stats.mapTime += systemTime(SYSTEM_TIME_MONOTONIC) - startTime;
+    }
+    return result;
+}
+
+status_t CursorWindow::mapFromParcel(Parcel* parcel, CursorWindow** outCursorWindow) {
     String8 name = parcel->readString8();
 
     status_t result;
@@ -141,6 +271,7 @@ status_t CursorWindow::createFromParcel(Parcel* parcel, CursorWindow** outCursor
 }
 
 status_t CursorWindow::writeToParcel(Parcel* parcel) {
+    mShared = true;
     status_t status = parcel->writeString8(mName);
     if (!status) {
         status = parcel->writeDupFileDescriptor(mAshmemFd);
@@ -160,6 +291,9 @@ status_t CursorWindow::clear() {
 
     RowSlotChunk* firstChunk = static_cast<RowSlotChunk*>(offsetToPtr(mHeader->firstChunkOffset));
     firstChunk->nextChunkOffset = 0;
+
+    mCachedChunkIndex = 0;
+    mCachedChunkOffset = 0;
     return OK;
 }
 
@@ -178,6 +312,11 @@ status_t CursorWindow::setNumColumns(uint32_t numColumns) {
 }
 
 status_t CursorWindow::allocRow() {
+    FieldSlot* fieldDir;
+    return allocRow(&fieldDir);
+}
+
+status_t CursorWindow::allocRow(FieldSlot** outFieldDir) {
     if (mReadOnly) {
         return INVALID_OPERATION;
     }
@@ -203,6 +342,7 @@ status_t CursorWindow::allocRow() {
     LOG_WINDOW("Allocated row %u, rowSlot is at offset %u, fieldDir is %zu bytes at offset %u\n",
             mHeader->numRows - 1, offsetFromPtr(rowSlot), fieldDirSize, fieldDirOffset);
     rowSlot->offset = fieldDirOffset;
+    *outFieldDir = fieldDir;
     return OK;
 }
 
@@ -239,35 +379,64 @@ uint32_t CursorWindow::alloc(size_t size, bool aligned) {
     return offset;
 }
 
-CursorWindow::RowSlot* CursorWindow::getRowSlot(uint32_t row) {
-    uint32_t chunkPos = row;
-    RowSlotChunk* chunk = static_cast<RowSlotChunk*>(
-            offsetToPtr(mHeader->firstChunkOffset));
-    while (chunkPos >= ROW_SLOT_CHUNK_NUM_ROWS) {
+CursorWindow::RowSlotChunk* CursorWindow::getRowSlotChunk(uint32_t chunkIndex) {
+    // Start from the last chunk that was looked up if it is on the way.
+    uint32_t index = 0;
+    uint32_t offset = mHeader->firstChunkOffset;
+    if (mCachedChunkOffset != 0 && mCachedChunkIndex <= chunkIndex) {
+        index = mCachedChunkIndex;
+        offset = mCachedChunkOffset;
+    }
+
+    RowSlotChunk* chunk = static_cast<RowSlotChunk*>(offsetToPtr(offset));
+    while (chunk != NULL && index < chunkIndex) {
         chunk = static_cast<RowSlotChunk*>(offsetToPtr(chunk->nextChunkOffset));
-        chunkPos -= ROW_SLOT_CHUNK_NUM_ROWS;
+        index++;
     }
-    return &chunk->slots[chunkPos];
+    if (chunk == NULL) {
+        return NULL;
+    }
+
+    mCachedChunkIndex = index;
+    mCachedChunkOffset = offsetFromPtr(chunk);
+    return chunk;
 }
 
-CursorWindow::RowSlot* CursorWindow::allocRowSlot() {
-    uint32_t chunkPos = mHeader->numRows;
-    RowSlotChunk* chunk = static_cast<RowSlotChunk*>(
-            offsetToPtr(mHeader->firstChunkOffset));
-    while (chunkPos > ROW_SLOT_CHUNK_NUM_ROWS) {
-        chunk = static_cast<RowSlotChunk*>(offsetToPtr(chunk->nextChunkOffset));
-        chunkPos -= ROW_SLOT_CHUNK_NUM_ROWS;
+CursorWindow::RowSlot* CursorWindow::getRowSlot(uint32_t row) {
+    RowSlotChunk* chunk = getRowSlotChunk(row / ROW_SLOT_CHUNK_NUM_ROWS);
+    if (chunk == NULL) {
+        return NULL;
     }
-    if (chunkPos == ROW_SLOT_CHUNK_NUM_ROWS) {
-        if (!chunk->nextChunkOffset) {
-            chunk->nextChunkOffset = alloc(sizeof(RowSlotChunk), true /*aligned*/);
-            if (!chunk->nextChunkOffset) {
+    return &chunk->slots[row % ROW_SLOT_CHUNK_NUM_ROWS];
+}
+
+CursorWindow::RowSlot* CursorWindow::allocRowSlot() {
+    const uint32_t chunkIndex = mHeader->numRows / ROW_SLOT_CHUNK_NUM_ROWS;
+    const uint32_t chunkPos = mHeader->numRows % ROW_SLOT_CHUNK_NUM_ROWS;
+    RowSlotChunk* chunk;
+    if (chunkIndex > 0 && chunkPos == 0) {
+        // The row starts a new chunk.
+        RowSlotChunk* prevChunk = getRowSlotChunk(chunkIndex - 1);
+        if (prevChunk == NULL) {
+            return NULL;
+        }
+        if (!prevChunk->nextChunkOffset) {
+            prevChunk->nextChunkOffset = alloc(sizeof(RowSlotChunk), true /*aligned*/);
+            if (!prevChunk->nextChunkOffset) {
                 return NULL;
             }
         }
-        chunk = static_cast<RowSlotChunk*>(offsetToPtr(chunk->nextChunkOffset));
+        chunk = static_cast<RowSlotChunk*>(offsetToPtr(prevChunk->nextChunkOffset));
         chunk->nextChunkOffset = 0;
-        chunkPos = 0;
+
+        // Any chunk that followed this one is no longer linked, so it must not stay cached.
+        mCachedChunkIndex = chunkIndex;
+        mCachedChunkOffset = offsetFromPtr(chunk);
+    } else {
+        chunk = getRowSlotChunk(chunkIndex);
+        if (chunk == NULL) {
+            return NULL;
+        }
     }
     mHeader->numRows += 1;
     return &chunk->slots[chunkPos];
@@ -322,6 +491,82 @@ status_t CursorWindow::putBlobOrString(uint32_t row, uint32_t column,
     return OK;
 }
 
+status_t CursorWindow::putRow(const Field* fields, uint32_t numFields) {
+    if (mReadOnly) {
+        return INVALID_OPERATION;
+    }
+
+    if (numFields != mHeader->numColumns) {
+        ALOGE("Trying to put a row of %d fields into a CursorWindow with %d columns",
+                numFields, mHeader->numColumns);
+        return BAD_VALUE;
+    }
+
+    // Validate the fields and size the single allocation for their data up front.
+    size_t dataSize = 0;
+    for (uint32_t i = 0; i < numFields; i++) {
+        switch (fields[i].type) {
+            case FIELD_TYPE_STRING:
+            case FIELD_TYPE_BLOB:
+                if (fields[i].data.buffer.size > mSize - dataSize) {
+                    return NO_MEMORY;
+                }
+                dataSize += fields[i].data.buffer.size;
+                break;
+            case FIELD_TYPE_NULL:
+            case FIELD_TYPE_INTEGER:
+            case FIELD_TYPE_FLOAT:
+                break;
+            default:
+                ALOGE("Unknown field type %d for column %d", fields[i].type, i);
+                return BAD_TYPE;
+        }
+    }
+
+    FieldSlot* fieldDir;
+    status_t status = allocRow(&fieldDir);
+    if (status) {
+        return status;
+    }
+
+    uint32_t dataOffset = 0;
+    if (dataSize > 0) {
+        dataOffset = alloc(dataSize);
+        if (!dataOffset) {
+            freeLastRow();
+            return NO_MEMORY;
+        }
+    }
+
+    for (uint32_t i = 0; i < numFields; i++) {
+        const Field& field = fields[i];
+        FieldSlot& fieldSlot = fieldDir[i];
+        fieldSlot.type = field.type;
+        switch (field.type) {
+            case FIELD_TYPE_INTEGER:
+                fieldSlot.data.l = field.data.l;
+                break;
+            case FIELD_TYPE_FLOAT:
+                fieldSlot.data.d = field.data.d;
+                break;
+            case FIELD_TYPE_STRING:
+            case FIELD_TYPE_BLOB:
+                if (field.data.buffer.size > 0) {
+                    memcpy(offsetToPtr(dataOffset), field.data.buffer.value,
+                            field.data.buffer.size);
+                }
+                fieldSlot.data.buffer.offset = dataOffset;
+                fieldSlot.data.buffer.size = field.data.buffer.size;
+                dataOffset += field.data.buffer.size;
+                break;
+            default:
+                // The field directory of a new row is already all null fields.
+                break;
+        }
+    }
+    return OK;
+}
+
 status_t CursorWindow::putLong(uint32_t row, uint32_t column, int64_t value) {
     if (mReadOnly) {
         return INVALID_OPERATION;
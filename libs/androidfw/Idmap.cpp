@@ -44,6 +44,97 @@ static bool compare_overlay_entries(const Idmap_overlay_entry& e1, const uint32_
   return dtohl(e1.overlay_id) < overlay_id;
 }
 
+static uint32_t target_entry_id(const Idmap_target_entry& entry) {
+  return dtohl(entry.target_id);
+}
+
+static uint32_t overlay_entry_id(const Idmap_overlay_entry& entry) {
+  return dtohl(entry.overlay_id);
+}
+
+// A type is indexed directly by entry id when at least one in this many resources in the range of
+// entry ids of the type is overlaid, which bounds the index to this many positions per entry.
+constexpr size_t kDenseTypeIndexRatio = 4U;
+
+template <typename Entry>
+void IdmapEntryIndex::Build(const Entry* entries, size_t entry_count,
+                            uint32_t (*id_of)(const Entry&)) {
+  types_.clear();
+  if (entry_count == 0U || entry_count > UINT32_MAX - 1U) {
+    return;
+  }
+
+  // All of the entries must belong to the same package and be sorted, otherwise lookups fall back
+  // to searching every entry.
+  const uint32_t package_id = id_of(entries[0]) >> 24U;
+  for (size_t i = 0U; i < entry_count; i++) {
+    const uint32_t id = id_of(entries[i]);
+    if ((id >> 24U) != package_id || ((id >> 16U) & 0xFFU) == 0U
+        || (i > 0U && id <= id_of(entries[i - 1U]))) {
+      return;
+    }
+  }
+
+  const size_t type_count = (id_of(entries[entry_count - 1U]) >> 16U) & 0xFFU;
+  std::vector<TypeIndex> types(type_count);
+  size_t begin = 0U;
+  while (begin < entry_count) {
+    const uint32_t type_id = (id_of(entries[begin]) >> 16U) & 0xFFU;
+    size_t end = begin + 1U;
+    while (end < entry_count && ((id_of(entries[end]) >> 16U) & 0xFFU) == type_id) {
+      end++;
+    }
+
+    TypeIndex& type_index = types[type_id - 1U];
+    type_index.begin = static_cast<uint32_t>(begin);
+    type_index.end = static_cast<uint32_t>(end);
+
+    const uint16_t first_entry_id = id_of(entries[begin]) & 0xFFFFU;
+    const size_t entry_id_range = (id_of(entries[end - 1U]) & 0xFFFFU) - first_entry_id + 1U;
+    if (entry_id_range <= (end - begin) * kDenseTypeIndexRatio) {
+      type_index.first_entry_id = first_entry_id;
+      type_index.positions.resize(entry_id_range, 0U);
+      for (size_t i = begin; i < end; i++) {
+        type_index.positions[(id_of(entries[i]) & 0xFFFFU) - first_entry_id] =
+            static_cast<uint32_t>(i + 1U);
+      }
+    }
+    begin = end;
+  }
+  types_ = std::move(types);
+}
+
+bool IdmapEntryIndex::Narrow(uint32_t res_id, size_t* begin, size_t* end) const {
+  if (types_.empty()) {
+    return true;
+  }
+
+  const size_t type_id = (res_id >> 16U) & 0xFFU;
+  if (type_id == 0U || type_id > types_.size()) {
+    return false;
+  }
+
+  const TypeIndex& type_index = types_[type_id - 1U];
+  if (type_index.begin == type_index.end) {
+    return false;
+  }
+
+  if (type_index.positions.empty()) {
+    *begin = type_index.begin;
+    *end = type_index.end;
+    return true;
+  }
+
+  const size_t offset = static_cast<size_t>(res_id & 0xFFFFU) - type_index.first_entry_id;
+  if ((res_id & 0xFFFFU) < type_index.first_entry_id || offset >= type_index.positions.size()
+      || type_index.positions[offset] == 0U) {
+    return false;
+  }
+  *begin = type_index.positions[offset] - 1U;
+  *end = *begin + 1U;
+  return true;
+}
+
 size_t Idmap_header::Size() const {
   return sizeof(Idmap_header) + sizeof(uint8_t) * dtohl(debug_info_size);
 }
@@ -80,14 +171,23 @@ size_t OverlayStringPool::size() const {
 
 OverlayDynamicRefTable::OverlayDynamicRefTable(const Idmap_data_header* data_header,
                                                const Idmap_overlay_entry* entries,
+                                               const IdmapEntryIndex* entry_index,
                                                uint8_t target_assigned_package_id)
     : data_header_(data_header),
       entries_(entries),
+      entry_index_(entry_index),
       target_assigned_package_id_(target_assigned_package_id) { };
 
 status_t OverlayDynamicRefTable::lookupResourceId(uint32_t* resId) const {
-  const Idmap_overlay_entry* first_entry = entries_;
-  const Idmap_overlay_entry* end_entry = entries_ + dtohl(data_header_->overlay_entry_count);
+  size_t begin = 0U;
+  size_t end = dtohl(data_header_->overlay_entry_count);
+  if (!entry_index_->Narrow(*resId, &begin, &end)) {
+    // A mapping for the target resource id could not be found.
+    return DynamicRefTable::lookupResourceId(resId);
+  }
+
+  const Idmap_overlay_entry* first_entry = entries_ + begin;
+  const Idmap_overlay_entry* end_entry = entries_ + end;
   auto entry = std::lower_bound(first_entry, end_entry, *resId, compare_overlay_entries);
 
   if (entry == end_entry || dtohl(entry->overlay_id) != *resId) {
@@ -106,10 +206,12 @@ status_t OverlayDynamicRefTable::lookupResourceIdNoRewrite(uint32_t* resId) cons
 
 IdmapResMap::IdmapResMap(const Idmap_data_header* data_header,
                          const Idmap_target_entry* entries,
+                         const IdmapEntryIndex* entry_index,
                          uint8_t target_assigned_package_id,
                          const OverlayDynamicRefTable* overlay_ref_table)
     : data_header_(data_header),
       entries_(entries),
+      entry_index_(entry_index),
       target_assigned_package_id_(target_assigned_package_id),
       overlay_ref_table_(overlay_ref_table) { };
 
@@ -123,8 +225,15 @@ IdmapResMap::Result IdmapResMap::Lookup(uint32_t target_res_id) const {
   target_res_id = (0x00FFFFFFU & target_res_id)
       | (((uint32_t) data_header_->target_package_id) << 24);
 
-  const Idmap_target_entry* first_entry = entries_;
-  const Idmap_target_entry* end_entry = entries_ + dtohl(data_header_->target_entry_count);
+  size_t begin = 0U;
+  size_t end = dtohl(data_header_->target_entry_count);
+  if (!entry_index_->Narrow(target_res_id, &begin, &end)) {
+    // A mapping for the target resource id could not be found.
+    return {};
+  }
+
+  const Idmap_target_entry* first_entry = entries_ + begin;
+  const Idmap_target_entry* end_entry = entries_ + end;
   auto entry = std::lower_bound(first_entry, end_entry, target_res_id, compare_target_entries);
 
   if (entry == end_entry || dtohl(entry->target_id) != target_res_id) {
@@ -215,6 +324,11 @@ LoadedIdmap::LoadedIdmap(std::string&& idmap_path,
   length = strnlen(reinterpret_cast<const char*>(header_->target_path),
                           arraysize(header_->target_path));
   target_apk_path_.assign(reinterpret_cast<const char*>(header_->target_path), length);
+
+  target_entry_index_.Build(target_entries_, dtohl(data_header_->target_entry_count),
+                            target_entry_id);
+  overlay_entry_index_.Build(overlay_entries_, dtohl(data_header_->overlay_entry_count),
+                             overlay_entry_id);
 }
 
 std::unique_ptr<const LoadedIdmap> LoadedIdmap::Load(const StringPiece& idmap_path,
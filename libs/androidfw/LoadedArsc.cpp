@@ -21,6 +21,7 @@
 #include <algorithm>
 #include <cstddef>
 #include <limits>
+#include <mutex>
 
 #include "android-base/logging.h"
 #include "android-base/stringprintf.h"
@@ -59,6 +60,14 @@ class TypeSpecPtrBuilder {
     types_.push_back(type);
   }
 
+  const ResTable_typeSpec* GetHeader() const {
+    return header_;
+  }
+
+  const std::vector<const ResTable_type*>& GetTypes() const {
+    return types_;
+  }
+
   TypeSpecPtr Build() {
     // Check for overflow.
     using ElementType = const ResTable_type*;
@@ -83,6 +92,22 @@ class TypeSpecPtrBuilder {
 
 }  // namespace
 
+struct LoadedPackage::LazyTypeSpec {
+  // The package chunk the type chunks belong to.
+  const ResChunk_header* package_chunk;
+
+  // Holds the type spec and, when the package was not loaded from an index, the type chunks that
+  // were found for it. The type chunks have not been verified yet.
+  std::unique_ptr<TypeSpecPtrBuilder> builder;
+
+  // The offsets of the type chunks from the start of the package chunk, when the package was
+  // loaded from an index. These chunks have not been read yet.
+  std::vector<uint32_t> type_offsets;
+
+  std::once_flag once;
+  TypeSpecPtr type_spec;
+};
+
 LoadedPackage::LoadedPackage() = default;
 LoadedPackage::~LoadedPackage() = default;
 
@@ -297,7 +322,7 @@ void LoadedPackage::CollectConfigurations(bool exclude_mipmap,
   const static std::u16string kMipMap = u"mipmap";
   const size_t type_count = type_specs_.size();
   for (size_t i = 0; i < type_count; i++) {
-    const TypeSpecPtr& type_spec = type_specs_[i];
+    const TypeSpec* type_spec = GetTypeSpec(i);
     if (type_spec != nullptr) {
       if (exclude_mipmap) {
         const int type_idx = type_spec->type_spec->id - 1;
@@ -332,7 +357,7 @@ void LoadedPackage::CollectLocales(bool canonicalize, std::set<std::string>* out
   char temp_locale[RESTABLE_MAX_LOCALE_LEN];
   const size_t type_count = type_specs_.size();
   for (size_t i = 0; i < type_count; i++) {
-    const TypeSpecPtr& type_spec = type_specs_[i];
+    const TypeSpec* type_spec = GetTypeSpec(i);
     if (type_spec != nullptr) {
       const auto iter_end = type_spec->types + type_spec->type_count;
       for (auto iter = type_spec->types; iter != iter_end; ++iter) {
@@ -360,7 +385,7 @@ uint32_t LoadedPackage::FindEntryByName(const std::u16string& type_name,
     return 0u;
   }
 
-  const TypeSpec* type_spec = type_specs_[type_idx].get();
+  const TypeSpec* type_spec = GetTypeSpec(type_idx);
   if (type_spec == nullptr) {
     return 0u;
   }
@@ -396,8 +421,103 @@ const LoadedPackage* LoadedArsc::GetPackageById(uint8_t package_id) const {
   return nullptr;
 }
 
+// Returns the chunk of type `type` at `offset` bytes from the start of `chunk`, or nullptr if the
+// offset does not point to a well formed chunk of that type that is contained within `chunk`.
+template <typename T, size_t MinSize = sizeof(T)>
+static const T* GetIndexedChunk(const Chunk& chunk, uint32_t offset, uint16_t type) {
+  const size_t chunk_size = chunk.size();
+  if ((offset & 0x03) != 0 || offset < chunk.header_size() || offset > chunk_size ||
+      chunk_size - offset < MinSize) {
+    return nullptr;
+  }
+
+  const ResChunk_header* header = reinterpret_cast<const ResChunk_header*>(
+      reinterpret_cast<const uint8_t*>(chunk.header<ResChunk_header>()) + offset);
+  const Chunk indexed_chunk(header);
+  if (indexed_chunk.type() != type || indexed_chunk.header_size() < MinSize ||
+      indexed_chunk.size() < indexed_chunk.header_size() ||
+      indexed_chunk.size() > chunk_size - offset) {
+    return nullptr;
+  }
+  return indexed_chunk.header<T, MinSize>();
+}
+
+const TypeSpec* LoadedPackage::GetLazyTypeSpec(size_t type_idx) const {
+  if (type_idx >= lazy_type_specs_->size()) {
+    return nullptr;
+  }
+
+  LazyTypeSpec* lazy = (*lazy_type_specs_)[type_idx].get();
+  if (lazy == nullptr) {
+    return nullptr;
+  }
+
+  std::call_once(lazy->once, [&]() {
+    ATRACE_NAME("LoadedPackage::GetLazyTypeSpec");
+    const ResTable_typeSpec* type_spec_header = lazy->builder->GetHeader();
+    TypeSpecPtrBuilder builder(type_spec_header);
+    for (const ResTable_type* type : lazy->builder->GetTypes()) {
+      if (!VerifyResTableType(type)) {
+        LOG(ERROR) << StringPrintf("Failed to load type %02x of package '%s'.",
+                                   type_spec_header->id, package_name_.c_str());
+        return;
+      }
+      builder.AddType(type);
+    }
+
+    const Chunk package_chunk(lazy->package_chunk);
+    for (uint32_t type_offset : lazy->type_offsets) {
+      const ResTable_type* type = GetIndexedChunk<ResTable_type, kResTableTypeMinSize>(
+          package_chunk, type_offset, RES_TABLE_TYPE_TYPE);
+      if (type == nullptr || type->id != type_spec_header->id || !VerifyResTableType(type)) {
+        LOG(ERROR) << StringPrintf("Indexed type %02x of package '%s' invalid.",
+                                   type_spec_header->id, package_name_.c_str());
+        return;
+      }
+      builder.AddType(type);
+    }
+
+    lazy->type_spec = builder.Build();
+    if (lazy->type_spec == nullptr) {
+      LOG(ERROR) << "Too many type configurations, overflow detected.";
+    }
+
+    // The chunks are now referenced by the TypeSpec.
+    lazy->builder.reset();
+    lazy->type_offsets = {};
+  });
+  return lazy->type_spec.get();
+}
+
+bool LoadedPackage::BuildIndex(const Chunk& chunk, PackageIndex* out_index) const {
+  const uint8_t* chunk_start = reinterpret_cast<const uint8_t*>(chunk.header<ResChunk_header>());
+  const uint8_t* chunk_end = chunk_start + chunk.size();
+  auto offset_of = [&](const void* ptr, uint32_t* out_offset) -> bool {
+    const uint8_t* p = reinterpret_cast<const uint8_t*>(ptr);
+    if (p < chunk_start || p >= chunk_end) {
+      return false;
+    }
+    *out_offset = static_cast<uint32_t>(p - chunk_start);
+    return true;
+  };
+
+  out_index->clear();
+  bool success = true;
+  ForEachTypeSpec([&](const TypeSpec* type_spec, uint8_t /* type_index */) {
+    TypeSpecIndex type_spec_index{};
+    success &= offset_of(type_spec->type_spec, &type_spec_index.type_spec_offset);
+    type_spec_index.type_offsets.resize(type_spec->type_count);
+    for (size_t i = 0; i < type_spec->type_count; i++) {
+      success &= offset_of(type_spec->types[i], &type_spec_index.type_offsets[i]);
+    }
+    out_index->push_back(std::move(type_spec_index));
+  });
+  return success;
+}
+
 std::unique_ptr<const LoadedPackage> LoadedPackage::Load(const Chunk& chunk,
-                                                         package_property_t property_flags) {
+                                                         package_property_t property_flags,
+                                                         const PackageIndex* index) {
   ATRACE_NAME("LoadedPackage::Load");
   std::unique_ptr<LoadedPackage> loaded_package(new LoadedPackage());
 
@@ -448,6 +568,79 @@ std::unique_ptr<const LoadedPackage> LoadedPackage::Load(const Chunk& chunk,
   // contiguous block of memory that holds all the Types together with the TypeSpec.
   std::unordered_map<int, std::unique_ptr<TypeSpecPtrBuilder>> type_builder_map;
 
+  // When the types are loaded lazily, the offsets of the indexed type chunks of each type index.
+  const bool lazy_types = (property_flags & PROPERTY_LAZY_TYPES) != 0;
+  std::unordered_map<int, std::vector<uint32_t>> lazy_type_offsets;
+
+  auto add_type_spec = [&](const ResTable_typeSpec* type_spec) -> bool {
+    if (type_spec == nullptr) {
+      LOG(ERROR) << "RES_TABLE_TYPE_SPEC_TYPE too small.";
+      return false;
+    }
+
+    if (type_spec->id == 0) {
+      LOG(ERROR) << "RES_TABLE_TYPE_SPEC_TYPE has invalid ID 0.";
+      return false;
+    }
+
+    if (loaded_package->type_id_offset_ + static_cast<int>(type_spec->id) >
+        std::numeric_limits<uint8_t>::max()) {
+      LOG(ERROR) << "RES_TABLE_TYPE_SPEC_TYPE has out of range ID.";
+      return false;
+    }
+
+    // The data portion of this chunk contains entry_count 32bit entries,
+    // each one representing a set of flags.
+    // Here we only validate that the chunk is well formed.
+    const size_t entry_count = dtohl(type_spec->entryCount);
+
+    // There can only be 2^16 entries in a type, because that is the ID
+    // space for entries (EEEE) in the resource ID 0xPPTTEEEE.
+    if (entry_count > std::numeric_limits<uint16_t>::max()) {
+      LOG(ERROR) << "RES_TABLE_TYPE_SPEC_TYPE has too many entries (" << entry_count << ").";
+      return false;
+    }
+
+    if (entry_count * sizeof(uint32_t) > chunk.data_size()) {
+      LOG(ERROR) << "RES_TABLE_TYPE_SPEC_TYPE too small to hold entries.";
+      return false;
+    }
+
+    std::unique_ptr<TypeSpecPtrBuilder>& builder_ptr = type_builder_map[type_spec->id - 1];
+    if (builder_ptr == nullptr) {
+      builder_ptr = util::make_unique<TypeSpecPtrBuilder>(type_spec);
+      loaded_package->resource_ids_.set(type_spec->id, entry_count);
+    } else {
+      LOG(WARNING) << StringPrintf("RES_TABLE_TYPE_SPEC_TYPE already defined for ID %02x",
+                                   type_spec->id);
+    }
+    return true;
+  };
+
+  auto add_type = [&](const ResTable_type* type) -> bool {
+    if (type == nullptr) {
+      LOG(ERROR) << "RES_TABLE_TYPE_TYPE too small.";
+      return false;
+    }
+
+    // Lazily loaded types are verified when they are first accessed.
+    if (!lazy_types && !VerifyResTableType(type)) {
+      return false;
+    }
+
+    // Type chunks must be preceded by their TypeSpec chunks.
+    std::unique_ptr<TypeSpecPtrBuilder>& builder_ptr = type_builder_map[type->id - 1];
+    if (builder_ptr != nullptr) {
+      builder_ptr->AddType(type);
+    } else {
+      LOG(ERROR) << StringPrintf(
+          "RES_TABLE_TYPE_TYPE with ID %02x found without preceding RES_TABLE_TYPE_SPEC_TYPE.",
+          type->id);
+      return false;
+    }
+    return true;
+  };
+
   ChunkIterator iter(chunk.data_ptr(), chunk.data_size());
   while (iter.HasNext()) {
     const Chunk child_chunk = iter.Next();
@@ -478,69 +671,23 @@ std::unique_ptr<const LoadedPackage> LoadedPackage::Load(const Chunk& chunk,
       } break;
 
       case RES_TABLE_TYPE_SPEC_TYPE: {
-        const ResTable_typeSpec* type_spec = child_chunk.header<ResTable_typeSpec>();
-        if (type_spec == nullptr) {
-          LOG(ERROR) << "RES_TABLE_TYPE_SPEC_TYPE too small.";
-          return {};
+        if (index != nullptr) {
+          // The type specs are located through the index below.
+          break;
         }
 
-        if (type_spec->id == 0) {
-          LOG(ERROR) << "RES_TABLE_TYPE_SPEC_TYPE has invalid ID 0.";
+        if (!add_type_spec(child_chunk.header<ResTable_typeSpec>())) {
           return {};
         }
-
-        if (loaded_package->type_id_offset_ + static_cast<int>(type_spec->id) >
-            std::numeric_limits<uint8_t>::max()) {
-          LOG(ERROR) << "RES_TABLE_TYPE_SPEC_TYPE has out of range ID.";
-          return {};
-        }
-
-        // The data portion of this chunk contains entry_count 32bit entries,
-        // each one representing a set of flags.
-        // Here we only validate that the chunk is well formed.
-        const size_t entry_count = dtohl(type_spec->entryCount);
-
-        // There can only be 2^16 entries in a type, because that is the ID
-        // space for entries (EEEE) in the resource ID 0xPPTTEEEE.
-        if (entry_count > std::numeric_limits<uint16_t>::max()) {
-          LOG(ERROR) << "RES_TABLE_TYPE_SPEC_TYPE has too many entries (" << entry_count << ").";
-          return {};
-        }
-
-        if (entry_count * sizeof(uint32_t) > chunk.data_size()) {
-          LOG(ERROR) << "RES_TABLE_TYPE_SPEC_TYPE too small to hold entries.";
-          return {};
-        }
-
-        std::unique_ptr<TypeSpecPtrBuilder>& builder_ptr = type_builder_map[type_spec->id - 1];
-        if (builder_ptr == nullptr) {
-          builder_ptr = util::make_unique<TypeSpecPtrBuilder>(type_spec);
-          loaded_package->resource_ids_.set(type_spec->id, entry_count);
-        } else {
-          LOG(WARNING) << StringPrintf("RES_TABLE_TYPE_SPEC_TYPE already defined for ID %02x",
-                                       type_spec->id);
-        }
       } break;
 
       case RES_TABLE_TYPE_TYPE: {
-        const ResTable_type* type = child_chunk.header<ResTable_type, kResTableTypeMinSize>();
-        if (type == nullptr) {
-          LOG(ERROR) << "RES_TABLE_TYPE_TYPE too small.";
-          return {};
+        if (index != nullptr) {
+          // The types are located through the index below.
+          break;
         }
 
-        if (!VerifyResTableType(type)) {
-          return {};
-        }
-
-        // Type chunks must be preceded by their TypeSpec chunks.
-        std::unique_ptr<TypeSpecPtrBuilder>& builder_ptr = type_builder_map[type->id - 1];
-        if (builder_ptr != nullptr) {
-          builder_ptr->AddType(type);
-        } else {
-          LOG(ERROR) << StringPrintf(
-              "RES_TABLE_TYPE_TYPE with ID %02x found without preceding RES_TABLE_TYPE_SPEC_TYPE.",
-              type->id);
+        if (!add_type(child_chunk.header<ResTable_type, kResTableTypeMinSize>())) {
           return {};
         }
       } break;
@@ -619,21 +766,25 @@ std::unique_ptr<const LoadedPackage> LoadedPackage::Load(const Chunk& chunk,
                 return {};
               }
 
-              // Retrieve all the resource ids belonging to this policy chunk
-              std::unordered_set<uint32_t> ids;
+              // Add the overlayable properties to the package
+              const uint32_t overlayable_index = loaded_package->overlayable_infos_.size();
+              OverlayableInfo overlayable_info{};
+              overlayable_info.name = name;
+              overlayable_info.actor = actor;
+              overlayable_info.policy_flags = policy_header->policy_flags;
+              loaded_package->overlayable_infos_.push_back(std::move(overlayable_info));
+
+              // Index all the resource ids belonging to this policy chunk. A resource declared
+              // by several policy chunks keeps the first one.
               const auto ids_begin =
                   reinterpret_cast<const ResTable_ref*>(overlayable_child_chunk.data_ptr());
               const auto ids_end = ids_begin + dtohl(policy_header->entry_count);
+              loaded_package->overlayable_ids_.reserve(loaded_package->overlayable_ids_.size() +
+                                                       dtohl(policy_header->entry_count));
               for (auto id_iter = ids_begin; id_iter != ids_end; ++id_iter) {
-                ids.insert(dtohl(id_iter->ident));
+                loaded_package->overlayable_ids_.emplace(dtohl(id_iter->ident),
+                                                         overlayable_index);
               }
-
-              // Add the pairing of overlayable properties and resource ids to the package
-              OverlayableInfo overlayable_info{};
-              overlayable_info.name = name;
-              overlayable_info.actor = actor;
-              overlayable_info.policy_flags = policy_header->policy_flags;
-              loaded_package->overlayable_infos_.push_back(std::make_pair(overlayable_info, ids));
               loaded_package->defines_overlayable_ = true;
               break;
             }
@@ -666,6 +817,47 @@ std::unique_ptr<const LoadedPackage> LoadedPackage::Load(const Chunk& chunk,
     }
   }
 
+  if (index != nullptr) {
+    for (const TypeSpecIndex& type_spec_index : *index) {
+      const ResTable_typeSpec* type_spec = GetIndexedChunk<ResTable_typeSpec>(
+          chunk, type_spec_index.type_spec_offset, RES_TABLE_TYPE_SPEC_TYPE);
+      if (type_spec == nullptr || !add_type_spec(type_spec)) {
+        LOG(ERROR) << "Indexed RES_TABLE_TYPE_SPEC_TYPE invalid.";
+        return {};
+      }
+
+      if (lazy_types) {
+        std::vector<uint32_t>& type_offsets = lazy_type_offsets[type_spec->id - 1];
+        type_offsets.insert(type_offsets.end(), type_spec_index.type_offsets.begin(),
+                            type_spec_index.type_offsets.end());
+        continue;
+      }
+
+      for (uint32_t type_offset : type_spec_index.type_offsets) {
+        const ResTable_type* type = GetIndexedChunk<ResTable_type, kResTableTypeMinSize>(
+            chunk, type_offset, RES_TABLE_TYPE_TYPE);
+        if (type == nullptr || type->id != type_spec->id || !add_type(type)) {
+          LOG(ERROR) << "Indexed RES_TABLE_TYPE_TYPE invalid.";
+          return {};
+        }
+      }
+    }
+  }
+
+  if (lazy_types) {
+    // Keep the builders around so that the TypeSpecs can be constructed on first access.
+    loaded_package->lazy_type_specs_ =
+        util::make_unique<std::array<std::unique_ptr<LazyTypeSpec>, 256>>();
+    for (auto& entry : type_builder_map) {
+      auto lazy = util::make_unique<LazyTypeSpec>();
+      lazy->package_chunk = chunk.header<ResChunk_header>();
+      lazy->builder = std::move(entry.second);
+      lazy->type_offsets = std::move(lazy_type_offsets[entry.first]);
+      (*loaded_package->lazy_type_specs_)[static_cast<uint8_t>(entry.first)] = std::move(lazy);
+    }
+    return std::move(loaded_package);
+  }
+
   // Flatten and construct the TypeSpecs.
   for (auto& entry : type_builder_map) {
     uint8_t type_idx = static_cast<uint8_t>(entry.first);
@@ -682,7 +874,8 @@ std::unique_ptr<const LoadedPackage> LoadedPackage::Load(const Chunk& chunk,
 }
 
 bool LoadedArsc::LoadTable(const Chunk& chunk, const LoadedIdmap* loaded_idmap,
-                           package_property_t property_flags) {
+                           package_property_t property_flags,
+                           const std::vector<PackageIndex>* package_indices) {
   const ResTable_header* header = chunk.header<ResTable_header>();
   if (header == nullptr) {
     LOG(ERROR) << "RES_TABLE_TYPE too small.";
@@ -722,10 +915,18 @@ bool LoadedArsc::LoadTable(const Chunk& chunk, const LoadedIdmap* loaded_idmap,
                      << " declared in the header.";
           return false;
         }
+        const PackageIndex* package_index = nullptr;
+        if (package_indices != nullptr) {
+          if (packages_seen >= package_indices->size()) {
+            LOG(ERROR) << "Index is missing package " << packages_seen << ".";
+            return false;
+          }
+          package_index = &(*package_indices)[packages_seen];
+        }
         packages_seen++;
 
         std::unique_ptr<const LoadedPackage> loaded_package =
-            LoadedPackage::Load(child_chunk, property_flags);
+            LoadedPackage::Load(child_chunk, property_flags, package_index);
         if (!loaded_package) {
           return false;
         }
@@ -786,4 +987,205 @@ std::unique_ptr<const LoadedArsc> LoadedArsc::CreateEmpty() {
   return std::unique_ptr<LoadedArsc>(new LoadedArsc());
 }
 
+namespace {
+
+// The index is a sequence of 32-bit words:
+//   header: kIndexMagic, kIndexVersion, key (low, high), data size, package count
+//   per package: type spec count
+//     per type spec: type spec offset, type count, type offsets...
+constexpr uint32_t kIndexMagic = 0x58444941u;  // "AIDX"
+constexpr uint32_t kIndexVersion = 1u;
+
+class IndexWriter {
+ public:
+  explicit IndexWriter(std::string* out) : out_(out) {
+  }
+
+  void Write(uint32_t value) {
+    const uint32_t device_value = htodl(value);
+    out_->append(reinterpret_cast<const char*>(&device_value), sizeof(device_value));
+  }
+
+ private:
+  std::string* out_;
+};
+
+class IndexReader {
+ public:
+  explicit IndexReader(const StringPiece& index)
+      : data_(index.data()), remaining_(index.size() / sizeof(uint32_t)) {
+  }
+
+  bool Read(uint32_t* out_value) {
+    if (remaining_ == 0u) {
+      return false;
+    }
+
+    // The index may not be aligned, so copy the value out.
+    uint32_t device_value;
+    memcpy(&device_value, data_, sizeof(device_value));
+    *out_value = dtohl(device_value);
+    data_ += sizeof(device_value);
+    remaining_--;
+    return true;
+  }
+
+  size_t Remaining() const {
+    return remaining_;
+  }
+
+ private:
+  const char* data_;
+  size_t remaining_;
+};
+
+}  // namespace
+
+bool LoadedArsc::SerializeIndex(const StringPiece& data, uint64_t key, std::string* out) const {
+  // Find the package chunks this table was loaded from, in the order they were loaded.
+  std::vector<Chunk> package_chunks;
+  size_t table_count = 0u;
+  ChunkIterator iter(data.data(), data.size());
+  while (iter.HasNext()) {
+    const Chunk chunk = iter.Next();
+    if (chunk.type() != RES_TABLE_TYPE || chunk.header<ResTable_header>() == nullptr) {
+      continue;
+    }
+
+    // Packages are indexed relative to the table they are defined in, which is only unambiguous
+    // when there is a single table.
+    if (++table_count > 1u) {
+      LOG(ERROR) << "Cannot index data with multiple RES_TABLE_TYPEs.";
+      return false;
+    }
+
+    ChunkIterator table_iter(chunk.data_ptr(), chunk.data_size());
+    while (table_iter.HasNext()) {
+      const Chunk child_chunk = table_iter.Next();
+      if (child_chunk.type() == RES_TABLE_PACKAGE_TYPE) {
+        package_chunks.push_back(child_chunk);
+      }
+    }
+  }
+
+  if (package_chunks.size() < packages_.size()) {
+    LOG(ERROR) << "Data does not contain the packages of this LoadedArsc.";
+    return false;
+  }
+
+  std::string index;
+  IndexWriter writer(&index);
+  writer.Write(kIndexMagic);
+  writer.Write(kIndexVersion);
+  writer.Write(static_cast<uint32_t>(key));
+  writer.Write(static_cast<uint32_t>(key >> 32u));
+  writer.Write(static_cast<uint32_t>(data.size()));
+  writer.Write(static_cast<uint32_t>(packages_.size()));
+
+  for (size_t i = 0; i < packages_.size(); i++) {
+    PackageIndex package_index;
+    if (!packages_[i]->BuildIndex(package_chunks[i], &package_index)) {
+      LOG(ERROR) << "Package " << packages_[i]->GetPackageName()
+                 << " was not loaded from the data.";
+      return false;
+    }
+
+    writer.Write(static_cast<uint32_t>(package_index.size()));
+    for (const TypeSpecIndex& type_spec_index : package_index) {
+      writer.Write(type_spec_index.type_spec_offset);
+      writer.Write(static_cast<uint32_t>(type_spec_index.type_offsets.size()));
+      for (uint32_t type_offset : type_spec_index.type_offsets) {
+        writer.Write(type_offset);
+      }
+    }
+  }
+
+  *out = std::move(index);
+  return true;
+}
+
+std::unique_ptr<const LoadedArsc> LoadedArsc::LoadWithIndex(const StringPiece& data,
+                                                            const StringPiece& index,
+                                                            uint64_t key,
+                                                            const LoadedIdmap* loaded_idmap,
+                                                            package_property_t property_flags) {
+  ATRACE_NAME("LoadedArsc::LoadWithIndex");
+
+  IndexReader reader(index);
+  uint32_t magic, version, key_low, key_high, data_size, package_count;
+  if (!reader.Read(&magic) || !reader.Read(&version) || !reader.Read(&key_low) ||
+      !reader.Read(&key_high) || !reader.Read(&data_size) || !reader.Read(&package_count)) {
+    LOG(WARNING) << "Resource table index too small.";
+    return {};
+  }
+
+  if (magic != kIndexMagic || version != kIndexVersion) {
+    LOG(WARNING) << StringPrintf("Resource table index has unsupported version %u.", version);
+    return {};
+  }
+
+  if ((static_cast<uint64_t>(key_high) << 32u | key_low) != key || data_size != data.size()) {
+    LOG(WARNING) << "Resource table index is stale.";
+    return {};
+  }
+
+  std::vector<PackageIndex> package_indices(std::min<size_t>(package_count, reader.Remaining()));
+  if (package_indices.size() != package_count) {
+    LOG(WARNING) << "Resource table index truncated.";
+    return {};
+  }
+
+  for (PackageIndex& package_index : package_indices) {
+    uint32_t type_spec_count;
+    if (!reader.Read(&type_spec_count) || type_spec_count > reader.Remaining()) {
+      LOG(WARNING) << "Resource table index truncated.";
+      return {};
+    }
+
+    package_index.resize(type_spec_count);
+    for (TypeSpecIndex& type_spec_index : package_index) {
+      uint32_t type_count;
+      if (!reader.Read(&type_spec_index.type_spec_offset) || !reader.Read(&type_count) ||
+          type_count > reader.Remaining()) {
+        LOG(WARNING) << "Resource table index truncated.";
+        return {};
+      }
+
+      type_spec_index.type_offsets.resize(type_count);
+      for (uint32_t& type_offset : type_spec_index.type_offsets) {
+        reader.Read(&type_offset);
+      }
+    }
+  }
+
+  // Not using make_unique because the constructor is private.
+  std::unique_ptr<LoadedArsc> loaded_arsc(new LoadedArsc());
+
+  ChunkIterator iter(data.data(), data.size());
+  while (iter.HasNext()) {
+    const Chunk chunk = iter.Next();
+    switch (chunk.type()) {
+      case RES_TABLE_TYPE:
+        if (!loaded_arsc->LoadTable(chunk, loaded_idmap, property_flags, &package_indices)) {
+          return {};
+        }
+        break;
+
+      default:
+        LOG(WARNING) << StringPrintf("Unknown chunk type '%02x'.", chunk.type());
+        break;
+    }
+  }
+
+  if (iter.HadError()) {
+    LOG(ERROR) << iter.GetLastError();
+    if (iter.HadFatalError()) {
+      return {};
+    }
+  }
+
+  // Need to force a move for mingw32.
+  return std::move(loaded_arsc);
+}
+
 }  // namespace android
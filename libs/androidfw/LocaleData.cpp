@@ -14,20 +14,58 @@
  * limitations under the License.
  */
 
+#include <algorithm>
 #include <array>
 #include <cstdint>
 #include <cstdlib>
 #include <cstring>
 #include <string>
-#include <unordered_map>
-#include <unordered_set>
 
 #include <androidfw/LocaleData.h>
 
 namespace android {
 
+// The generated tables below are constant arrays sorted by key, so that they
+// live in read-only data instead of being built into hash maps at static
+// initialization time in every process.
+struct LikelyScript {
+    uint32_t locale;
+    uint8_t script;
+};
+
+struct LocaleParent {
+    uint32_t locale;
+    uint32_t parent;
+};
+
 #include "LocaleDataTables.cpp"
 
+template <typename T, size_t N, typename KeyOf>
+constexpr bool isSortedByKey(const T (&table)[N], KeyOf key_of) {
+    for (size_t i = 1; i < N; i++) {
+        if (!(key_of(table[i - 1]) < key_of(table[i]))) {
+            return false;
+        }
+    }
+    return true;
+}
+
+static_assert(isSortedByKey(LIKELY_SCRIPTS, [](const LikelyScript& e) { return e.locale; }),
+              "LIKELY_SCRIPTS must be sorted by locale");
+static_assert(isSortedByKey(REPRESENTATIVE_LOCALES, [](uint64_t e) { return e; }),
+              "REPRESENTATIVE_LOCALES must be sorted");
+static_assert(isSortedByKey(LATN_PARENTS, [](const LocaleParent& e) { return e.locale; }),
+              "LATN_PARENTS must be sorted by locale");
+
+// Returns the entry of 'table' whose locale is 'packed_locale', or nullptr.
+template <typename T>
+inline const T* findLocaleEntry(const T* table, size_t table_size, uint32_t packed_locale) {
+    const T* end = table + table_size;
+    const T* entry = std::lower_bound(table, end, packed_locale,
+                                      [](const T& e, uint32_t key) { return e.locale < key; });
+    return (entry != end && entry->locale == packed_locale) ? entry : nullptr;
+}
+
 inline uint32_t packLocale(const char* language, const char* region) {
     return (((uint8_t) language[0]) << 24u) | (((uint8_t) language[1]) << 16u) |
            (((uint8_t) region[0]) << 8u) | ((uint8_t) region[1]);
@@ -49,10 +87,10 @@ uint32_t findParent(uint32_t packed_locale, const char* script) {
     if (hasRegion(packed_locale)) {
         for (size_t i = 0; i < SCRIPT_PARENTS_COUNT; i++) {
             if (memcmp(script, SCRIPT_PARENTS[i].script, SCRIPT_LENGTH) == 0) {
-                auto map = SCRIPT_PARENTS[i].map;
-                auto lookup_result = map->find(packed_locale);
-                if (lookup_result != map->end()) {
-                    return lookup_result->second;
+                const LocaleParent* lookup_result = findLocaleEntry(
+                        SCRIPT_PARENTS[i].map, SCRIPT_PARENTS[i].map_size, packed_locale);
+                if (lookup_result != nullptr) {
+                    return lookup_result->parent;
                 }
                 break;
             }
@@ -119,7 +157,8 @@ inline bool isRepresentative(uint32_t language_and_region, const char* script) {
             (((uint64_t) script[2]) <<  8u) |
             ((uint64_t) script[3]));
 
-    return (REPRESENTATIVE_LOCALES.count(packed_locale) != 0);
+    return std::binary_search(std::begin(REPRESENTATIVE_LOCALES),
+                              std::end(REPRESENTATIVE_LOCALES), packed_locale);
 }
 
 const uint32_t US_SPANISH = 0x65735553LU; // es-US
@@ -203,15 +242,17 @@ void localeDataComputeScript(char out[4], const char* language, const char* regi
         memset(out, '\0', SCRIPT_LENGTH);
         return;
     }
+    const size_t likely_scripts_count = sizeof(LIKELY_SCRIPTS)/sizeof(LIKELY_SCRIPTS[0]);
     uint32_t lookup_key = packLocale(language, region);
-    auto lookup_result = LIKELY_SCRIPTS.find(lookup_key);
-    if (lookup_result == LIKELY_SCRIPTS.end()) {
+    const LikelyScript* lookup_result =
+            findLocaleEntry(LIKELY_SCRIPTS, likely_scripts_count, lookup_key);
+    if (lookup_result == nullptr) {
         // We couldn't find the locale. Let's try without the region
         if (region[0] != '\0') {
             lookup_key = dropRegion(lookup_key);
-            lookup_result = LIKELY_SCRIPTS.find(lookup_key);
-            if (lookup_result != LIKELY_SCRIPTS.end()) {
-                memcpy(out, SCRIPT_CODES[lookup_result->second], SCRIPT_LENGTH);
+            lookup_result = findLocaleEntry(LIKELY_SCRIPTS, likely_scripts_count, lookup_key);
+            if (lookup_result != nullptr) {
+                memcpy(out, SCRIPT_CODES[lookup_result->script], SCRIPT_LENGTH);
                 return;
             }
         }
@@ -220,7 +261,7 @@ void localeDataComputeScript(char out[4], const char* language, const char* regi
         return;
     } else {
         // We found the locale.
-        memcpy(out, SCRIPT_CODES[lookup_result->second], SCRIPT_LENGTH);
+        memcpy(out, SCRIPT_CODES[lookup_result->script], SCRIPT_LENGTH);
     }
 }
 
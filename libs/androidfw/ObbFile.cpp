@@ -19,14 +19,27 @@
 #include <stdint.h>
 #include <stdlib.h>
 #include <string.h>
+#include <sys/stat.h>
 #include <unistd.h>
 
+#include <algorithm>
+#include <atomic>
+#include <map>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
 #define LOG_TAG "ObbFile"
 
 #include <androidfw/ObbFile.h>
 #include <utils/Compat.h>
 #include <utils/Log.h>
 
+#ifdef __ANDROID__
+#include <openssl/sha.h>
+#endif
+
 //#define DEBUG 1
 
 #define kFooterTagSize 8  /* last two 32-bit integers */
@@ -47,6 +60,8 @@
 
 #define kSigVersion    1 /* We only know about signature version 1 */
 
+#define kDigestBlockSize (4 * 1024 * 1024) /* Contents are hashed in blocks this large */
+
 /* offsets in version 1 of the header */
 #define kPackageVersionOffset 4
 #define kFlagsOffset          8
@@ -76,8 +91,11 @@ ObbFile::ObbFile()
         : mPackageName("")
         , mVersion(-1)
         , mFlags(0)
+        , mFooterStart(0)
+        , mHasDigest(false)
 {
     memset(mSalt, 0, sizeof(mSalt));
+    memset(mDigest, 0, sizeof(mDigest));
 }
 
 ObbFile::~ObbFile() {
@@ -169,6 +187,7 @@ bool ObbFile::parseObbFile(int fd)
     }
 
     mFooterStart = fileOffset;
+    mHasDigest = false;
 
     char* scanBuf = (char*)malloc(footerSize);
     if (scanBuf == NULL) {
@@ -344,4 +363,160 @@ bool ObbFile::removeFrom(int fd)
     return true;
 }
 
+#ifdef __ANDROID__
+bool ObbFile::computeDigest(int fd, size_t maxThreads)
+{
+    if (fd < 0 || mPackageName.size() == 0) {
+        ALOGW("attempt to compute digest of unread ObbFile\n");
+        return false;
+    }
+
+    const int64_t contentLength = mFooterStart;
+    const size_t blockCount = (contentLength + kDigestBlockSize - 1) / kDigestBlockSize;
+    std::vector<unsigned char> blockDigests(blockCount * SHA256_DIGEST_LENGTH);
+
+    // Blocks are independent, so each thread claims the next unhashed block
+    // and reads it with pread; the only shared state is the block index.
+    std::atomic<size_t> nextBlock(0);
+    std::atomic<bool> failed(false);
+    auto hashBlocks = [&]() {
+        std::vector<unsigned char> buf;
+        for (size_t i = nextBlock++; i < blockCount && !failed; i = nextBlock++) {
+            const off64_t offset = (off64_t)i * kDigestBlockSize;
+            const size_t length = std::min<int64_t>(kDigestBlockSize, contentLength - offset);
+            buf.resize(length);
+            size_t done = 0;
+            while (done < length) {
+                ssize_t actual = TEMP_FAILURE_RETRY(
+                        pread64(fd, buf.data() + done, length - done, offset + done));
+                if (actual <= 0) {
+                    ALOGW("couldn't read OBB block at %lld: %s\n", (long long int)offset,
+                            actual < 0 ? strerror(errno) : "unexpected end of file");
+                    failed = true;
+                    return;
+                }
+                done += actual;
+            }
+            SHA256(buf.data(), length, &blockDigests[i * SHA256_DIGEST_LENGTH]);
+        }
+    };
+
+    if (maxThreads == 0) {
+        maxThreads = std::max(std::thread::hardware_concurrency(), 1u);
+    }
+
+    // The calling thread hashes blocks too, so it counts towards maxThreads.
+    std::vector<std::thread> workers;
+    if (blockCount > 1) {
+        const size_t workerCount = std::min(maxThreads, blockCount) - 1;
+        workers.reserve(workerCount);
+        for (size_t i = 0; i < workerCount; i++) {
+            workers.emplace_back(hashBlocks);
+        }
+    }
+    hashBlocks();
+    for (std::thread& worker : workers) {
+        worker.join();
+    }
+    if (failed) {
+        return false;
+    }
+
+    static_assert(SHA256_DIGEST_LENGTH == OBB_DIGEST_SIZE, "OBB digest size mismatch");
+    SHA256(blockDigests.data(), blockDigests.size(), mDigest);
+    mHasDigest = true;
+    return true;
+}
+#else
+bool ObbFile::computeDigest(int /* fd */, size_t /* maxThreads */)
+{
+    ALOGW("ObbFile digests are not supported on this platform\n");
+    return false;
+}
+#endif
+
+namespace {
+
+struct CachedObb {
+    int64_t size;
+    int64_t mtimeNs;
+    sp<ObbFile> obb;
+};
+
+std::mutex gObbCacheLock;
+std::map<std::string, CachedObb> gObbCache;
+
+int64_t mtimeNanos(const struct stat& st)
+{
+#ifdef __linux__
+    return (int64_t)st.st_mtim.tv_sec * 1000000000LL + st.st_mtim.tv_nsec;
+#else
+    return (int64_t)st.st_mtime * 1000000000LL;
+#endif
+}
+
+} // namespace
+
+void ObbFile::copyFrom(const ObbFile& other)
+{
+    mPackageName = other.mPackageName;
+    mVersion = other.mVersion;
+    mFlags = other.mFlags;
+    memcpy(mSalt, other.mSalt, sizeof(mSalt));
+    mFooterStart = other.mFooterStart;
+    mHasDigest = other.mHasDigest;
+    memcpy(mDigest, other.mDigest, sizeof(mDigest));
+}
+
+sp<ObbFile> ObbFile::readCached(const char* filename, bool wantDigest)
+{
+    int fd = ::open(filename, O_RDONLY);
+    if (fd < 0) {
+        ALOGW("couldn't open file %s: %s", filename, strerror(errno));
+        return NULL;
+    }
+
+    // Stat through the fd we read from so the key matches the contents.
+    struct stat st;
+    if (fstat(fd, &st) != 0) {
+        ALOGW("couldn't stat %s: %s", filename, strerror(errno));
+        close(fd);
+        return NULL;
+    }
+    const int64_t mtimeNs = mtimeNanos(st);
+
+    sp<ObbFile> cached;
+    {
+        std::lock_guard<std::mutex> lock(gObbCacheLock);
+        auto it = gObbCache.find(filename);
+        if (it != gObbCache.end() && it->second.size == st.st_size
+                && it->second.mtimeNs == mtimeNs) {
+            cached = it->second.obb;
+        }
+    }
+
+    sp<ObbFile> obb = new ObbFile();
+    if (cached != NULL && (cached->mHasDigest || !wantDigest)) {
+        // Hand out a copy; callers are free to modify what they get.
+        obb->copyFrom(*cached);
+        close(fd);
+        return obb;
+    }
+
+    bool success = obb->readFrom(fd) && (!wantDigest || obb->computeDigest(fd));
+    close(fd);
+    if (!success) {
+        ALOGW("failed to read from %s\n", filename);
+        return NULL;
+    }
+
+    sp<ObbFile> entry = new ObbFile();
+    entry->copyFrom(*obb);
+    {
+        std::lock_guard<std::mutex> lock(gObbCacheLock);
+        gObbCache[filename] = {st.st_size, mtimeNs, entry};
+    }
+    return obb;
+}
+
 }
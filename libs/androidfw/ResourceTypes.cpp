@@ -77,6 +77,10 @@ static const bool kDebugTableTheme = false;
 static const bool kDebugResXMLTree = false;
 static const bool kDebugLibNoisy = false;
 
+// Unsorted string pools with at least this many strings get a hash index the
+// first time indexOfString() is called on them.
+static const size_t kMinStringsForIndex = 64;
+
 // TODO: This code uses 0xFFFFFFFF converted to bag_set* as a sentinel value. This is bad practice.
 
 // Standard C isspace() is only required to look at the low byte of its input, so
@@ -420,12 +424,14 @@ Res_png_9patch* Res_png_9patch::deserialize(void* inData)
 // --------------------------------------------------------------------
 
 ResStringPool::ResStringPool()
-    : mError(NO_INIT), mOwnedData(NULL), mHeader(NULL), mCache(NULL)
+    : mError(NO_INIT), mOwnedData(NULL), mHeader(NULL), mCache(NULL),
+      mIndexBuilt(false)
 {
 }
 
 ResStringPool::ResStringPool(const void* data, size_t size, bool copyData)
-    : mError(NO_INIT), mOwnedData(NULL), mHeader(NULL), mCache(NULL)
+    : mError(NO_INIT), mOwnedData(NULL), mHeader(NULL), mCache(NULL),
+      mIndexBuilt(false)
 {
     setTo(data, size, copyData);
 }
@@ -668,6 +674,12 @@ void ResStringPool::uninit()
         free(mOwnedData);
         mOwnedData = NULL;
     }
+    {
+        AutoMutex lock(mIndexLock);
+        mIndexTable.clear();
+        mIndexTable.shrink_to_fit();
+        mIndexBuilt = false;
+    }
 }
 
 /**
@@ -714,6 +726,40 @@ decodeLength(const uint8_t** str)
     return len;
 }
 
+/**
+ * Returns true if the first `len` bytes of `str` are all 7-bit ASCII, in
+ * which case the UTF-16 form of the string is just the widened bytes. The
+ * check is done a machine word at a time, which the compiler vectorizes.
+ */
+static inline bool
+isAscii(const uint8_t* str, size_t len)
+{
+    uint64_t bits = 0;
+    size_t i = 0;
+    for (; i + sizeof(uint64_t) <= len; i += sizeof(uint64_t)) {
+        uint64_t word;
+        memcpy(&word, str + i, sizeof(word));
+        bits |= word;
+    }
+    for (; i < len; i++) {
+        bits |= str[i];
+    }
+    return (bits & UINT64_C(0x8080808080808080)) == 0;
+}
+
+/**
+ * Widens an ASCII string to UTF-16 and null-terminates it. `dst` must have
+ * room for `len + 1` characters.
+ */
+static inline void
+widenAscii(const uint8_t* src, size_t len, char16_t* dst)
+{
+    for (size_t i = 0; i < len; i++) {
+        dst[i] = src[i];
+    }
+    dst[len] = 0;
+}
+
 const char16_t* ResStringPool::stringAt(size_t idx, size_t* u16len) const
 {
     if (mError == NO_ERROR && idx < mHeader->stringCount) {
@@ -758,10 +804,15 @@ const char16_t* ResStringPool::stringAt(size_t idx, size_t* u16len) const
                         return NULL;
                     }
 
+                    // Most strings in resource tables are plain ASCII, and their
+                    // UTF-16 length is the same as their UTF-8 length.
+                    const bool ascii = isAscii(u8str, u8len);
+
                     // Since AAPT truncated lengths longer than 0x7FFF, check
                     // that the bits that remain after truncation at least match
                     // the bits of the actual length
-                    ssize_t actualLen = utf8_to_utf16_length(u8str, u8len);
+                    ssize_t actualLen = ascii ? (ssize_t)u8len
+                                              : utf8_to_utf16_length(u8str, u8len);
                     if (actualLen < 0 || ((size_t)actualLen & 0x7FFF) != *u16len) {
                         ALOGW("Bad string block: string #%lld decoded length is not correct "
                                 "%lld vs %llu\n",
@@ -777,7 +828,11 @@ const char16_t* ResStringPool::stringAt(size_t idx, size_t* u16len) const
                         return NULL;
                     }
 
-                    utf8_to_utf16(u8str, u8len, u16str, *u16len + 1);
+                    if (ascii) {
+                        widenAscii(u8str, u8len, u16str);
+                    } else {
+                        utf8_to_utf16(u8str, u8len, u16str, *u16len + 1);
+                    }
 
                     if (mCache == NULL) {
 #ifndef __ANDROID__
@@ -981,6 +1036,10 @@ ssize_t ResStringPool::indexOfString(const char16_t* str, size_t strLen) const
             // block, start searching at the back.
             String8 str8(str, strLen);
             const size_t str8Len = str8.size();
+            if (mHeader->stringCount >= kMinStringsForIndex) {
+                AutoMutex lock(mIndexLock);
+                return indexOfStringLocked(str8.string(), str8Len);
+            }
             for (int i=mHeader->stringCount-1; i>=0; i--) {
                 const char* s = string8At(i, &len);
                 if (kDebugStringPoolNoisy) {
@@ -1030,6 +1089,10 @@ ssize_t ResStringPool::indexOfString(const char16_t* str, size_t strLen) const
             // most often this happens because we want to get IDs for style
             // span tags; since those always appear at the end of the string
             // block, start searching at the back.
+            if (mHeader->stringCount >= kMinStringsForIndex) {
+                AutoMutex lock(mIndexLock);
+                return indexOfStringLocked(str, strLen);
+            }
             for (int i=mHeader->stringCount-1; i>=0; i--) {
                 const char16_t* s = stringAt(i, &len);
                 if (kDebugStringPoolNoisy) {
@@ -1048,6 +1111,118 @@ ssize_t ResStringPool::indexOfString(const char16_t* str, size_t strLen) const
     return NAME_NOT_FOUND;
 }
 
+/**
+ * FNV-1a hash of the raw code units of a string pool string, so that UTF-8
+ * pools can be indexed without converting their strings to UTF-16.
+ */
+template <typename T>
+static inline uint32_t
+hashStringUnits(const T* str, size_t len)
+{
+    uint32_t hash = 2166136261u;
+    for (size_t i = 0; i < len; i++) {
+        hash = (hash ^ static_cast<uint32_t>(str[i])) * 16777619u;
+    }
+    return hash;
+}
+
+void ResStringPool::buildIndexLocked() const
+{
+    mIndexBuilt = true;
+
+    // Keep the table at most half full so that probe sequences stay short.
+    size_t capacity = 1;
+    while (capacity < mHeader->stringCount * 2) {
+        capacity <<= 1;
+    }
+    mIndexTable.assign(capacity, 0u);
+    const size_t mask = capacity - 1;
+
+    const bool isUTF8 = (mHeader->flags&ResStringPool_header::UTF8_FLAG) != 0;
+
+    // The linear search returns the last matching string, so insert strings
+    // from the back and skip duplicates of strings that are already present.
+    for (ssize_t i = mHeader->stringCount - 1; i >= 0; i--) {
+        size_t len;
+        const void* str;
+        uint32_t hash;
+        if (isUTF8) {
+            const char* s = string8At(i, &len);
+            str = s;
+            hash = s != NULL ? hashStringUnits(s, len) : 0u;
+        } else {
+            const char16_t* s = stringAt(i, &len);
+            str = s;
+            hash = s != NULL ? hashStringUnits(s, len) : 0u;
+        }
+        if (str == NULL) {
+            continue;
+        }
+
+        for (size_t slot = hash & mask;; slot = (slot + 1) & mask) {
+            const uint32_t entry = mIndexTable[slot];
+            if (entry == 0u) {
+                mIndexTable[slot] = static_cast<uint32_t>(i) + 1;
+                break;
+            }
+
+            size_t otherLen;
+            if (isUTF8) {
+                const char* other = string8At(entry - 1, &otherLen);
+                if (otherLen == len && memcmp(other, str, len) == 0) {
+                    break;
+                }
+            } else {
+                const char16_t* other = stringAt(entry - 1, &otherLen);
+                if (otherLen == len && memcmp(other, str, len * sizeof(char16_t)) == 0) {
+                    break;
+                }
+            }
+        }
+    }
+
+    if (kDebugStringPoolNoisy) {
+        ALOGI("Built string pool index of %zu slots for %u strings", capacity,
+              (unsigned)mHeader->stringCount);
+    }
+}
+
+/**
+ * Looks up `str` in the hash index of this pool, building the index on first
+ * use. `str` holds `strLen` UTF-8 bytes for UTF-8 pools and `strLen` UTF-16
+ * characters otherwise.
+ */
+ssize_t ResStringPool::indexOfStringLocked(const void* str, size_t strLen) const
+{
+    if (!mIndexBuilt) {
+        buildIndexLocked();
+    }
+
+    const bool isUTF8 = (mHeader->flags&ResStringPool_header::UTF8_FLAG) != 0;
+    const uint32_t hash = isUTF8 ? hashStringUnits((const char*)str, strLen)
+                                 : hashStringUnits((const char16_t*)str, strLen);
+    const size_t mask = mIndexTable.size() - 1;
+    for (size_t slot = hash & mask;; slot = (slot + 1) & mask) {
+        const uint32_t entry = mIndexTable[slot];
+        if (entry == 0u) {
+            return NAME_NOT_FOUND;
+        }
+
+        size_t len;
+        if (isUTF8) {
+            const char* s = string8At(entry - 1, &len);
+            if (len == strLen && memcmp(s, str, len) == 0) {
+                return entry - 1;
+            }
+        } else {
+            const char16_t* s = stringAt(entry - 1, &len);
+            if (len == strLen && memcmp(s, str, len * sizeof(char16_t)) == 0) {
+                return entry - 1;
+            }
+        }
+    }
+}
+
 size_t ResStringPool::size() const
 {
     return (mError == NO_ERROR) ? mHeader->stringCount : 0;
@@ -167,8 +167,12 @@ ssize_t StreamingZipInflater::read(void* outBuf, size_t count) {
             }
             // we know we've drained whatever is in the out buffer now, so just
             // start from scratch there, reading all the input we have at present.
-            mInflateState.next_out = (Bytef*) mOutBuf;
-            mInflateState.avail_out = mOutBufSize;
+            // Requests of at least a whole output chunk are decoded straight into
+            // the caller's buffer instead, which saves copying them out of mOutBuf.
+            const bool decodeToDest = (dest != NULL) && (toRead >= mOutBufSize);
+            const size_t outSize = decodeToDest ? min_of(toRead, size_t(~(uInt) 0)) : mOutBufSize;
+            mInflateState.next_out = (Bytef*) (decodeToDest ? dest : mOutBuf);
+            mInflateState.avail_out = outSize;
 
             /*
             ALOGV("Inflating to outbuf: avail_in=%u avail_out=%u next_in=%p next_out=%p",
@@ -196,8 +200,17 @@ ssize_t StreamingZipInflater::read(void* outBuf, size_t count) {
                 }
 
                 // Note how much data we got, and off we go
+                const size_t decoded = outSize - mInflateState.avail_out;
                 mOutDeliverable = 0;
-                mOutLastDecoded = mOutBufSize - mInflateState.avail_out;
+                if (decodeToDest) {
+                    mOutLastDecoded = 0;
+                    mOutCurPosition += decoded;
+                    dest += decoded;
+                    bytesRead += decoded;
+                    toRead -= decoded;
+                } else {
+                    mOutLastDecoded = decoded;
+                }
             }
         }
     }
@@ -19,6 +19,7 @@
 
 #include <memory>
 #include <string>
+#include <vector>
 
 #include "android-base/macros.h"
 #include "android-base/unique_fd.h"
@@ -103,6 +104,15 @@ class ApkAssets {
       std::unique_ptr<const AssetsProvider> override_asset = nullptr, off64_t offset = 0,
       off64_t length = kUnknownLength);
 
+  // Creates an ApkAssets from a resources.arsc held in a shared memory region, such as an ashmem
+  // or ASharedMemory region, which remains owned by the caller. The table is mapped directly from
+  // the region rather than copied, so the region must not be modified while the ApkAssets exists.
+  // If `length` equals kUnknownLength, offset must equal 0 and the whole region is used.
+  static std::unique_ptr<const ApkAssets> LoadTableFromSharedMemory(
+      int fd, const std::string& friendly_name, package_property_t flags = 0U,
+      std::unique_ptr<const AssetsProvider> override_asset = nullptr, off64_t offset = 0,
+      off64_t length = kUnknownLength);
+
   // Creates an ApkAssets from an IDMAP, which contains the original APK path, and the overlay
   // data.
   static std::unique_ptr<const ApkAssets> LoadOverlay(const std::string& idmap_path,
@@ -114,6 +124,22 @@ class ApkAssets {
       const std::string& path, package_property_t flags = 0U,
       std::unique_ptr<const AssetsProvider> override_asset = nullptr);
 
+  // Describes an ApkAssets to be loaded by LoadAll().
+  struct LoadRequest {
+    // The path of the APK, or of the idmap if `overlay` is true.
+    std::string path;
+    package_property_t flags = 0U;
+    bool overlay = false;
+  };
+
+  // Loads the ApkAssets described by `requests` concurrently, using at most `max_threads` threads
+  // including the calling thread. If `max_threads` is 0, the number of CPU cores is used.
+  // The results are in the same order as `requests`, with nullptr for the ApkAssets that failed to
+  // load. Pass them to AssetManager2::SetApkAssets() once to build the package groups for the whole
+  // set, such as an APK together with its splits and overlays.
+  static std::vector<std::unique_ptr<const ApkAssets>> LoadAll(
+      const std::vector<LoadRequest>& requests, size_t max_threads = 0U);
+
   // Creates a totally empty ApkAssets with no resources table and no file entries.
   static std::unique_ptr<const ApkAssets> LoadEmpty(
       package_property_t flags = 0U,
@@ -30,6 +30,8 @@
 #include <utils/threads.h>
 #include <utils/Vector.h>
 
+#include <atomic>
+
 /*
  * Native-app access is via the opaque typedef struct AAssetManager in the C namespace.
  */
@@ -348,6 +350,9 @@ private:
     char*           mLocale;
 
     mutable ResTable* mResources;
+    // The same table as mResources, set only after it has been fully built. Safe to read without
+    // holding mLock.
+    mutable std::atomic<ResTable*> mPublishedResources;
     ResTable_config* mConfig;
 };
 
@@ -72,7 +72,33 @@ struct ResolvedBag {
   Entry entries[0];
 };
 
-struct FindEntryResult;
+struct FindEntryResult {
+  // A pointer to the resource table entry for this resource.
+  // If the size of the entry is > sizeof(ResTable_entry), it can be cast to
+  // a ResTable_map_entry and processed as a bag/map.
+  ResTable_entry_handle entry;
+
+  // The configuration for which the resulting entry was defined. This is already swapped to host
+  // endianness.
+  ResTable_config config;
+
+  // The bitmask of configuration axis with which the resource value varies.
+  uint32_t type_flags;
+
+  // The dynamic package ID map for the package from which this resource came from.
+  const DynamicRefTable* dynamic_ref_table;
+
+  // The package name of the resource.
+  const std::string* package_name;
+
+  // The string pool reference to the type's name. This uses a different string pool than
+  // the global string pool, but this is hidden from the caller.
+  StringPoolRef type_string_ref;
+
+  // The string pool reference to the entry's name. This uses a different string pool than
+  // the global string pool, but this is hidden from the caller.
+  StringPoolRef entry_string_ref;
+};
 
 // AssetManager2 is the main entry point for accessing assets and resources.
 // AssetManager2 provides caching of resources retrieved via the underlying ApkAssets.
@@ -269,6 +295,16 @@ class AssetManager2 {
   // Creates a new Theme from this AssetManager.
   std::unique_ptr<Theme> NewTheme();
 
+  // Enables or disables sharing of bags between all the AssetManagers of this process. Only bags
+  // that are resolved entirely from a single system package without overlays are shared. When
+  // enabled in zygote, the bags resolved while preloading are inherited by every forked process
+  // and don't need to be resolved again.
+  //
+  // The ApkAssets whose bags are shared must never be destroyed while sharing is enabled.
+  // Disabling sharing frees the shared bags, so it must only be done when no AssetManager
+  // references them.
+  static void SetBagSharingEnabled(bool enabled);
+
   void ForEachPackage(const std::function<bool(const std::string&, uint8_t)> func,
                       package_property_t excluded_property_flags = 0U) const {
     for (const PackageGroup& package_group : package_groups_) {
@@ -291,6 +327,11 @@ class AssetManager2 {
   struct FilteredConfigGroup {
       std::vector<ResTable_config> configurations;
       std::vector<const ResTable_type*> types;
+
+      // Whether `configurations` is ordered from the best to the worst match for the current
+      // AssetManager configuration. When set, the first type that contains an entry holds the
+      // best value for that entry within the package.
+      bool sorted_by_match = false;
   };
 
   // Represents an single package.
@@ -359,6 +400,28 @@ class AssetManager2 {
   // Should be called whenever the ApkAssets are changed.
   void BuildDynamicRefTable();
 
+  // Adds the packages of `apk_assets` to the package groups, creating groups as needed. The ids
+  // of the package groups that were modified are appended to `out_affected_package_ids` when it
+  // is not nullptr. Returns the number of packages added.
+  size_t AddPackageGroups(const ApkAssets* apk_assets, ApkAssetsCookie cookie,
+                          std::vector<uint8_t>* out_affected_package_ids);
+
+  // Maps the build-time package ids of every package group to the runtime ids of the groups.
+  void AssignRuntimePackageIds();
+
+  // Appends `apk_assets` to the ApkAssets without rebuilding the existing package groups. Only
+  // valid if the packages of no other ApkAssets would be assigned a different package id.
+  void AppendApkAssets(const ApkAssets* apk_assets, bool invalidate_caches);
+
+  // Removes the last ApkAssets, which must be an overlay, without rebuilding the other package
+  // groups.
+  void RemoveLastOverlay(bool invalidate_caches);
+
+  // Purges the cached entries, and bags if `invalidate_bags` is true, that may be affected by a
+  // change to the package groups with the given ids or to the ApkAssets of `changed_cookie`.
+  void InvalidateCachesForPackages(const std::vector<uint8_t>& package_ids,
+                                   ApkAssetsCookie changed_cookie, bool invalidate_bags);
+
   // Purge all resources that are cached and vary by the configuration axis denoted by the
   // bitmask `diff`.
   void InvalidateCaches(uint32_t diff);
@@ -367,6 +430,13 @@ class AssetManager2 {
   // This should always be called when mutating the AssetManager's configuration or ApkAssets set.
   void RebuildFilterList(bool filter_incompatible_configs = true);
 
+  // Re-constructs the lists of types of `package` that match the set configuration.
+  void RebuildFilteredConfigs(ConfiguredPackage* package, bool filter_incompatible_configs);
+
+  // Orders the configurations of `group` from the best to the worst match for the current
+  // configuration. All configurations of `group` must match the current configuration.
+  void SortFilteredConfigGroup(FilteredConfigGroup* group) const;
+
   // Retrieves the APK paths of overlays that overlay non-system packages.
   std::set<std::string> GetNonSystemOverlayPaths() const;
 
@@ -374,6 +444,17 @@ class AssetManager2 {
   // been seen while traversing bag parents.
   const ResolvedBag* GetBag(uint32_t resid, std::vector<uint32_t>& child_resids);
 
+  // Returns the cookie of the system package that defines `resid` if bags with that ID can be
+  // shared with other AssetManagers, or kInvalidCookie otherwise.
+  ApkAssetsCookie GetSharedBagCookie(uint32_t resid) const;
+
+  // Finds a bag resolved by another AssetManager that is valid for this AssetManager's ApkAssets
+  // and configuration.
+  const ResolvedBag* FindSharedBag(uint32_t resid);
+
+  // Takes ownership of the newly resolved `bag`, caching it for subsequent lookups.
+  const ResolvedBag* CacheBag(uint32_t resid, util::unique_cptr<ResolvedBag> bag);
+
   // The ordered list of ApkAssets to search. These are not owned by the AssetManager, and must
   // have a longer lifetime.
   std::vector<const ApkAssets*> apk_assets_;
@@ -388,6 +469,15 @@ class AssetManager2 {
   // without taking too much memory.
   std::array<uint8_t, std::numeric_limits<uint8_t>::max() + 1> package_ids_;
 
+  // The runtime package id to assign to the next shared library package, and the runtime package
+  // id of the first package of each ApkAssets path. Kept so that ApkAssets can be appended
+  // without rebuilding the package groups.
+  int next_dynamic_package_id_ = 0x02;
+  std::unordered_map<std::string, uint8_t> apk_assets_package_ids_;
+
+  // Whether the filter list was last built with incompatible configurations filtered out.
+  bool filter_incompatible_configs_ = true;
+
   // The current configuration set for this AssetManager. When this changes, cached resources
   // may need to be purged.
   ResTable_config configuration_;
@@ -396,10 +486,35 @@ class AssetManager2 {
   // which involves some calculation.
   std::unordered_map<uint32_t, util::unique_cptr<ResolvedBag>> cached_bags_;
 
+  // Bags that are owned by the process-wide shared bag cache and were found to be valid for this
+  // AssetManager. These are purged the same way as `cached_bags_`.
+  std::unordered_map<uint32_t, const ResolvedBag*> cached_shared_bags_;
+
   // Cached set of bag resid stacks for each bag. These are cached because they might be requested
   // a number of times for each view during View inspection.
   std::unordered_map<uint32_t, std::vector<uint32_t>> cached_bag_resid_stacks_;
 
+  // A FindEntry() result resolved against the current configuration.
+  struct CachedEntry {
+    ApkAssetsCookie cookie;
+
+    // The configuration axis with which the target resource and any of its overlays vary.
+    // If the configuration changes with respect to one of these axis, the entry is purged.
+    uint32_t type_flags;
+
+    FindEntryResult result;
+  };
+
+  // Cached set of resolved entries for the current configuration. These are cached because the
+  // same resource IDs are looked up many times during inflation, and each lookup otherwise walks
+  // every package, configuration and overlay of the package group.
+  mutable std::unordered_map<uint32_t, CachedEntry> cached_entries_;
+
+  // Number of Theme::GetAttribute() lookups of the themes created by this AssetManager that were
+  // answered from, or had to populate, the theme's resolved attribute cache.
+  uint64_t theme_attribute_cache_hits_ = 0u;
+  uint64_t theme_attribute_cache_misses_ = 0u;
+
   // Whether or not to save resource resolution steps
   bool resource_resolution_logging_enabled_ = false;
 
@@ -511,9 +626,24 @@ class Theme {
   // Called by AssetManager2.
   explicit Theme(AssetManager2* asset_manager);
 
+  // Drops the attributes memoized by GetAttribute(). Must be called whenever the entries of this
+  // theme change.
+  void ClearAttributeCache();
+
   AssetManager2* asset_manager_;
   uint32_t type_spec_flags_ = 0u;
 
+  // The result of a GetAttribute() call that had to follow attribute references.
+  struct CachedAttribute {
+    ApkAssetsCookie cookie;
+    uint32_t type_spec_flags;
+    Res_value value;
+  };
+
+  // Attributes resolved by GetAttribute() keyed by the requested attribute. Attributes defined
+  // directly by the theme are not cached since looking them up is already constant time.
+  mutable std::unordered_map<uint32_t, CachedAttribute> cached_attributes_;
+
   // Defined in the cpp.
   struct Package;
 
@@ -55,6 +55,16 @@ void ApplyStyle(Theme* theme, ResXMLParser* xml_parser, uint32_t def_style_attr,
                 uint32_t def_style_resid, const uint32_t* attrs, size_t attrs_length,
                 uint32_t* out_values, uint32_t* out_indices);
 
+// Applies the same default style and attributes to every element in `xml_parsers`, as if
+// ApplyStyle() was called for each of them. The default style and the values that come from the
+// theme are resolved once for the whole batch. `attrs` must be sorted.
+// `out_values` must hold `xml_parsers_length * attrs_length * STYLE_NUM_ENTRIES` elements.
+// `out_indices` must hold `xml_parsers_length * (attrs_length + 1)` elements.
+// Entries of `xml_parsers` may be nullptr.
+void ApplyStyleBatch(Theme* theme, ResXMLParser* const* xml_parsers, size_t xml_parsers_length,
+                     uint32_t def_style_attr, uint32_t def_style_resid, const uint32_t* attrs,
+                     size_t attrs_length, uint32_t* out_values, uint32_t* out_indices);
+
 // `out_values` must NOT be nullptr.
 // `out_indices` may be nullptr.
 bool RetrieveAttributes(AssetManager2* assetmanager, ResXMLParser* xml_parser, uint32_t* attrs,
@@ -86,8 +86,7 @@ public:
 
 private:
     explicit BackupDataWriter();
-    status_t write_padding_for(int n);
-    
+
     int m_fd;
     status_t m_status;
     ssize_t m_pos;
@@ -119,7 +118,8 @@ public:
 private:
     explicit BackupDataReader();
     status_t skip_padding();
-    
+    ssize_t read_buffered(void* data, size_t size);
+
     int m_fd;
     bool m_done;
     status_t m_status;
@@ -131,6 +131,11 @@ private:
         entity_header_v1 entity;
     } m_header;
     String8 m_key;
+    // Read-ahead buffer; m_pos is the logical position, behind the file's own offset
+    // by whatever is still unconsumed here.
+    void* m_buf;
+    size_t m_bufPos;
+    size_t m_bufLen;
 };
 
 int back_up_files(int oldSnapshotFD, BackupDataWriter* dataStream, int newSnapshotFD,
@@ -33,6 +33,21 @@ class ByteBucketArray {
  public:
   ByteBucketArray() : default_() { memset(buckets_, 0, sizeof(buckets_)); }
 
+  // Moving transfers the buckets, so that containers of ByteBucketArrays can grow.
+  ByteBucketArray(ByteBucketArray&& other) : default_() {
+    memcpy(buckets_, other.buckets_, sizeof(buckets_));
+    memset(other.buckets_, 0, sizeof(other.buckets_));
+  }
+
+  ByteBucketArray& operator=(ByteBucketArray&& other) {
+    if (this != &other) {
+      this->~ByteBucketArray();
+      memcpy(buckets_, other.buckets_, sizeof(buckets_));
+      memset(other.buckets_, 0, sizeof(other.buckets_));
+    }
+    return *this;
+  }
+
   ~ByteBucketArray() {
     for (size_t i = 0; i < kNumBuckets; i++) {
       if (buckets_[i] != NULL) {
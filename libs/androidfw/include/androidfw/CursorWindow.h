@@ -79,11 +79,46 @@ public:
         friend class CursorWindow;
     } __attribute((packed));
 
+    /* Describes the value of one field of a row passed to putRow(). */
+    struct Field {
+        int32_t type;
+        union {
+            double d;
+            int64_t l;
+            struct {
+                const void* value;
+                // For strings, this includes the null terminator.
+                size_t size;
+            } buffer;
+        } data;
+    };
+
     ~CursorWindow();
 
     static status_t create(const String8& name, size_t size, CursorWindow** outCursorWindow);
     static status_t createFromParcel(Parcel* parcel, CursorWindow** outCursorWindow);
 
+    /**
+     * Like create(), but reuses a window of the same size that was released with
+     * recycle() when one is available, which avoids creating and mapping a new
+     * ashmem region.
+     */
+    static status_t createPooled(const String8& name, size_t size,
+            CursorWindow** outCursorWindow);
+
+    /**
+     * Releases a window. Writable windows that were never written to a parcel are
+     * wiped and kept for reuse by createPooled() while there is room in the pool.
+     * All other windows are deleted, since another process may still be reading them.
+     */
+    static void recycle(CursorWindow* window);
+
+    /**
+     * Appends the number of windows created, reused and mapped from parcels by this
+     * process, and the time spent creating and mapping them, for each window name.
+     */
+    static void dumpStats(String8* out);
+
     status_t writeToParcel(Parcel* parcel);
 
     inline String8 name() { return mName; }
@@ -108,6 +143,14 @@ public:
     status_t putDouble(uint32_t row, uint32_t column, double value);
     status_t putNull(uint32_t row, uint32_t column);
 
+    /**
+     * Allocates a new row and fills in all of its fields at once. `fields` must
+     * have one entry per column. The string and blob values of the row are copied
+     * into a single allocation, so either the whole row is added or, if it does
+     * not fit, no row is added and NO_MEMORY is returned.
+     */
+    status_t putRow(const Field* fields, uint32_t numFields);
+
     /**
      * Gets the field slot at the specified row and column.
      * Returns null if the requested row or column is not in the window.
@@ -166,8 +209,16 @@ private:
     void* mData;
     size_t mSize;
     bool mReadOnly;
+    // Whether the window was written to a parcel, so other processes may have it mapped.
+    bool mShared;
     Header* mHeader;
 
+    // The row slot chunk that was last looked up, so that accessing rows in order
+    // doesn't need to walk the list of chunks from the start every time. This is
+    // local to the process and not part of the shared window data.
+    uint32_t mCachedChunkIndex;
+    uint32_t mCachedChunkOffset;
+
     inline void* offsetToPtr(uint32_t offset, uint32_t bufferSize = 0) {
         if (offset >= mSize) {
             ALOGE("Offset %" PRIu32 " out of bounds, max value %zu", offset, mSize);
@@ -192,9 +243,19 @@ private:
      */
     uint32_t alloc(size_t size, bool aligned = false);
 
+    static status_t createAshmemWindow(const String8& name, size_t size,
+            CursorWindow** outCursorWindow);
+    static status_t mapFromParcel(Parcel* parcel, CursorWindow** outCursorWindow);
+
+    RowSlotChunk* getRowSlotChunk(uint32_t chunkIndex);
     RowSlot* getRowSlot(uint32_t row);
     RowSlot* allocRowSlot();
 
+    /**
+     * Allocates a row like allocRow() and returns its field directory.
+     */
+    status_t allocRow(FieldSlot** outFieldDir);
+
     status_t putBlobOrString(uint32_t row, uint32_t column,
             const void* value, size_t size, int32_t type);
 };
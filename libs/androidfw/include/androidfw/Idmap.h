@@ -21,6 +21,7 @@
 #include <string>
 #include <unordered_map>
 #include <variant>
+#include <vector>
 
 #include "android-base/macros.h"
 #include "androidfw/StringPiece.h"
@@ -32,6 +33,36 @@ namespace android {
 class LoadedIdmap;
 class IdmapResMap;
 
+// An index over idmap entries sorted by resource id. The entries of a resource type that is
+// densely overlaid are found by indexing directly with the entry id of the resource, while the
+// entries of sparsely overlaid types are found by binary searching only the entries of that type.
+class IdmapEntryIndex {
+ public:
+  // Narrows the range of entry positions [*begin, *end) that may hold the resource id. Returns
+  // false if no entry holds the resource id.
+  bool Narrow(uint32_t res_id, size_t* begin, size_t* end) const;
+
+ private:
+  template <typename Entry>
+  void Build(const Entry* entries, size_t entry_count, uint32_t (*id_of)(const Entry&));
+
+  struct TypeIndex {
+    // The range of positions of the entries of this type.
+    uint32_t begin = 0U;
+    uint32_t end = 0U;
+
+    // When the type is densely overlaid, maps (entry id - first_entry_id) to the position of the
+    // idmap entry plus one, or to zero if the resource is not present.
+    uint16_t first_entry_id = 0U;
+    std::vector<uint32_t> positions;
+  };
+
+  // Indexed by type id - 1. Empty when the entries could not be indexed.
+  std::vector<TypeIndex> types_;
+
+  friend LoadedIdmap;
+};
+
 // A string pool for overlay apk assets. The string pool holds the strings of the overlay resources
 // table and additionally allows for loading strings from the idmap string pool. The idmap string
 // pool strings are offset after the end of the overlay resource table string pool entries so
@@ -60,6 +91,7 @@ class OverlayDynamicRefTable : public DynamicRefTable {
  private:
   explicit OverlayDynamicRefTable(const Idmap_data_header* data_header,
                                   const Idmap_overlay_entry* entries,
+                                  const IdmapEntryIndex* entry_index,
                                   uint8_t target_assigned_package_id);
 
   // Rewrites a compile-time overlay resource id to the runtime resource id of corresponding target
@@ -68,6 +100,7 @@ class OverlayDynamicRefTable : public DynamicRefTable {
 
   const Idmap_data_header* data_header_;
   const Idmap_overlay_entry* entries_;
+  const IdmapEntryIndex* entry_index_;
   const int8_t target_assigned_package_id_;
 
   friend LoadedIdmap;
@@ -123,11 +156,13 @@ class IdmapResMap {
  private:
   explicit IdmapResMap(const Idmap_data_header* data_header,
                        const Idmap_target_entry* entries,
+                       const IdmapEntryIndex* entry_index,
                        uint8_t target_assigned_package_id,
                        const OverlayDynamicRefTable* overlay_ref_table);
 
   const Idmap_data_header* data_header_;
   const Idmap_target_entry* entries_;
+  const IdmapEntryIndex* entry_index_;
   const uint8_t target_assigned_package_id_;
   const OverlayDynamicRefTable* overlay_ref_table_;
 
@@ -163,14 +198,15 @@ class LoadedIdmap {
   // Returns a mapping from target resource ids to overlay values.
   inline const IdmapResMap GetTargetResourcesMap(
       uint8_t target_assigned_package_id, const OverlayDynamicRefTable* overlay_ref_table) const {
-    return IdmapResMap(data_header_, target_entries_, target_assigned_package_id,
-                       overlay_ref_table);
+    return IdmapResMap(data_header_, target_entries_, &target_entry_index_,
+                       target_assigned_package_id, overlay_ref_table);
   }
 
   // Returns a dynamic reference table for a loaded overlay package.
   inline const OverlayDynamicRefTable GetOverlayDynamicRefTable(
       uint8_t target_assigned_package_id) const {
-    return OverlayDynamicRefTable(data_header_, overlay_entries_, target_assigned_package_id);
+    return OverlayDynamicRefTable(data_header_, overlay_entries_, &overlay_entry_index_,
+                                  target_assigned_package_id);
   }
 
   // Returns whether the idmap file on disk has not been modified since the construction of this
@@ -186,6 +222,8 @@ class LoadedIdmap {
   const Idmap_target_entry* target_entries_;
   const Idmap_overlay_entry* overlay_entries_;
   const std::unique_ptr<ResStringPool> string_pool_;
+  IdmapEntryIndex target_entry_index_;
+  IdmapEntryIndex overlay_entry_index_;
 
   const std::string idmap_path_;
   std::string overlay_apk_path_;
@@ -17,6 +17,7 @@
 #ifndef LOADEDARSC_H_
 #define LOADEDARSC_H_
 
+#include <array>
 #include <memory>
 #include <set>
 #include <vector>
@@ -87,6 +88,10 @@ enum : package_property_t {
 
   // The package is a RRO.
   PROPERTY_OVERLAY = 1U << 3U,
+
+  // The type chunks of the package are only located and verified the first time a resource of
+  // their type is looked up. This is only used natively and is not exposed to ApkAssets.java.
+  PROPERTY_LAZY_TYPES = 1U << 4U,
 };
 
 // TypeSpecPtr points to a block of memory that holds a TypeSpec struct, followed by an array of
@@ -100,6 +105,16 @@ struct OverlayableInfo {
   uint32_t policy_flags;
 };
 
+// The location of a type spec chunk and of the type chunks that belong to it, as byte offsets from
+// the start of the package chunk that contains them.
+struct TypeSpecIndex {
+  uint32_t type_spec_offset;
+  std::vector<uint32_t> type_offsets;
+};
+
+// The locations of every type spec chunk of a package. See LoadedArsc::SerializeIndex().
+using PackageIndex = std::vector<TypeSpecIndex>;
+
 class LoadedPackage {
  public:
   class iterator {
@@ -151,8 +166,15 @@ class LoadedPackage {
     return iterator(this, resource_ids_.size() + 1, 0);
   }
 
+  // Loads the package from `chunk`. If `index` is set, the type spec and type chunks are located
+  // using the index instead of walking the package chunk.
   static std::unique_ptr<const LoadedPackage> Load(const Chunk& chunk,
-                                                   package_property_t property_flags);
+                                                   package_property_t property_flags,
+                                                   const PackageIndex* index = nullptr);
+
+  // Populates `out_index` with the locations of the type spec and type chunks of this package.
+  // `chunk` must be the chunk this package was loaded from.
+  bool BuildIndex(const Chunk& chunk, PackageIndex* out_index) const;
 
   ~LoadedPackage();
 
@@ -231,16 +253,16 @@ class LoadedPackage {
   inline const TypeSpec* GetTypeSpecByTypeIndex(uint8_t type_index) const {
     // If the type IDs are offset in this package, we need to take that into account when searching
     // for a type.
-    return type_specs_[type_index - type_id_offset_].get();
+    return GetTypeSpec(type_index - type_id_offset_);
   }
 
   template <typename Func>
   void ForEachTypeSpec(Func f) const {
     for (size_t i = 0; i < type_specs_.size(); i++) {
-      const TypeSpecPtr& ptr = type_specs_[i];
+      const TypeSpec* ptr = GetTypeSpec(i);
       if (ptr != nullptr) {
         uint8_t type_id = ptr->type_spec->id;
-        f(ptr.get(), type_id - 1);
+        f(ptr, type_id - 1);
       }
     }
   }
@@ -248,13 +270,8 @@ class LoadedPackage {
   // Retrieves the overlayable properties of the specified resource. If the resource is not
   // overlayable, this will return a null pointer.
   const OverlayableInfo* GetOverlayableInfo(uint32_t resid) const {
-    for (const std::pair<OverlayableInfo, std::unordered_set<uint32_t>>& overlayable_info_ids
-        : overlayable_infos_) {
-      if (overlayable_info_ids.second.find(resid) != overlayable_info_ids.second.end()) {
-        return &overlayable_info_ids.first;
-      }
-    }
-    return nullptr;
+    const auto iter = overlayable_ids_.find(resid);
+    return iter != overlayable_ids_.end() ? &overlayable_infos_[iter->second] : nullptr;
   }
 
   // Retrieves whether or not the package defines overlayable resources.
@@ -273,6 +290,17 @@ class LoadedPackage {
 
   LoadedPackage();
 
+  inline const TypeSpec* GetTypeSpec(size_t type_idx) const {
+    if (lazy_type_specs_ != nullptr) {
+      return GetLazyTypeSpec(type_idx);
+    }
+    return type_specs_[type_idx].get();
+  }
+
+  // Returns the TypeSpec at `type_idx` of a package loaded with PROPERTY_LAZY_TYPES, building it
+  // on first access. This is safe to call from multiple threads.
+  const TypeSpec* GetLazyTypeSpec(size_t type_idx) const;
+
   ResStringPool type_string_pool_;
   ResStringPool key_string_pool_;
   std::string package_name_;
@@ -282,9 +310,20 @@ class LoadedPackage {
   package_property_t property_flags_ = 0U;
 
   ByteBucketArray<TypeSpecPtr> type_specs_;
+
+  // Defined in the cpp.
+  struct LazyTypeSpec;
+
+  // When loaded with PROPERTY_LAZY_TYPES, the not yet built TypeSpecs of the package indexed by
+  // type index. `type_specs_` is not used in this case.
+  std::unique_ptr<std::array<std::unique_ptr<LazyTypeSpec>, 256>> lazy_type_specs_;
   ByteBucketArray<uint32_t> resource_ids_;
   std::vector<DynamicPackageEntry> dynamic_package_map_;
-  std::vector<const std::pair<OverlayableInfo, std::unordered_set<uint32_t>>> overlayable_infos_;
+  std::vector<OverlayableInfo> overlayable_infos_;
+
+  // Maps the id of each overlayable resource to the index of its overlayable properties in
+  // `overlayable_infos_`, so looking them up does not scan every <overlayable> of the package.
+  std::unordered_map<uint32_t, uint32_t> overlayable_ids_;
 
   // A map of overlayable name to actor
   std::unordered_map<std::string, std::string> overlayable_map_;
@@ -304,9 +343,25 @@ class LoadedArsc {
                                                 const LoadedIdmap* loaded_idmap = nullptr,
                                                 package_property_t property_flags = 0U);
 
+  // Loads a resource table using an index previously created by SerializeIndex() for `data`.
+  // The index locates the type spec and type chunks of every package so they don't need to be
+  // discovered by walking the table. `key` identifies the data the index was created for, for
+  // example a hash of the APK path, its modification time and the idmap. Returns nullptr if the
+  // index is malformed or was not created for this data, in which case the caller should fall
+  // back to Load().
+  static std::unique_ptr<const LoadedArsc> LoadWithIndex(const StringPiece& data,
+                                                         const StringPiece& index, uint64_t key,
+                                                         const LoadedIdmap* loaded_idmap = nullptr,
+                                                         package_property_t property_flags = 0U);
+
   // Create an empty LoadedArsc. This is used when an APK has no resources.arsc.
   static std::unique_ptr<const LoadedArsc> CreateEmpty();
 
+  // Serializes the locations of the type spec and type chunks of every package into `out`, so that
+  // the table can later be loaded with LoadWithIndex(). `data` must be the data this LoadedArsc was
+  // loaded from. The index must be stored where only trusted writers can modify it.
+  bool SerializeIndex(const StringPiece& data, uint64_t key, std::string* out) const;
+
   // Returns the string pool where all string resource values
   // (Res_value::dataType == Res_value::TYPE_STRING) are indexed.
   inline const ResStringPool* GetStringPool() const {
@@ -327,7 +382,8 @@ class LoadedArsc {
 
   LoadedArsc() = default;
   bool LoadTable(
-      const Chunk& chunk, const LoadedIdmap* loaded_idmap, package_property_t property_flags);
+      const Chunk& chunk, const LoadedIdmap* loaded_idmap, package_property_t property_flags,
+      const std::vector<PackageIndex>* package_indices = nullptr);
 
   std::unique_ptr<ResStringPool> global_string_pool_ = util::make_unique<ResStringPool>();
   std::vector<std::unique_ptr<const LoadedPackage>> packages_;
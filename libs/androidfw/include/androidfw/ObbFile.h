@@ -29,6 +29,9 @@ namespace android {
 #define OBB_OVERLAY         (1 << 0)
 #define OBB_SALTED          (1 << 1)
 
+// Size in bytes of the digest produced by ObbFile::computeDigest()
+#define OBB_DIGEST_SIZE     32
+
 class ObbFile : public RefBase {
 protected:
     virtual ~ObbFile();
@@ -43,6 +46,23 @@ public:
     bool removeFrom(const char* filename);
     bool removeFrom(int fd);
 
+    /*
+     * Computes a SHA-256 based digest of the OBB contents, not counting the
+     * footer, for a file that was successfully read with readFrom(). The
+     * contents are hashed in independent blocks on up to maxThreads threads
+     * (0 for one per CPU) and the digest is taken over the block digests.
+     * Only supported on device; returns false elsewhere.
+     */
+    bool computeDigest(int fd, size_t maxThreads = 0);
+
+    /*
+     * Reads the OBB footer and, if wantDigest is set, the content digest of
+     * filename. Results are cached per process by path, size and modification
+     * time, so scanning and mounting the same unchanged OBB only hashes it
+     * once. Returns NULL on failure.
+     */
+    static sp<ObbFile> readCached(const char* filename, bool wantDigest);
+
     const char* getFileName() const {
         return mFileName;
     }
@@ -95,6 +115,16 @@ public:
         return (mFlags & OBB_OVERLAY) == OBB_OVERLAY;
     }
 
+    const unsigned char* getDigest(size_t* length) const {
+        if (!mHasDigest) {
+            *length = 0;
+            return NULL;
+        }
+
+        *length = sizeof(mDigest);
+        return mDigest;
+    }
+
     void setOverlay(bool overlay) {
         if (overlay) {
             mFlags |= OBB_OVERLAY;
@@ -129,9 +159,14 @@ private:
 
     const char* mFileName;
 
-    size_t mFooterStart;
+    int64_t mFooterStart;
+
+    /* Digest of the contents, valid if mHasDigest is set. */
+    bool mHasDigest;
+    unsigned char mDigest[OBB_DIGEST_SIZE];
 
     bool parseObbFile(int fd);
+    void copyFrom(const ObbFile& other);
 };
 
 }
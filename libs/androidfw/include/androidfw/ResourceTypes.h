@@ -37,6 +37,7 @@
 
 #include <array>
 #include <memory>
+#include <vector>
 
 namespace android {
 
@@ -545,8 +546,17 @@ private:
     const uint32_t*             mStyles;
     uint32_t                    mStylePoolSize;    // number of uint32_t
 
+    // Lazily built open addressing hash table used by indexOfString() on large unsorted pools.
+    // Each slot holds a string index + 1, or 0 if the slot is empty.
+    mutable Mutex               mIndexLock;
+    mutable std::vector<uint32_t> mIndexTable;
+    mutable bool                mIndexBuilt;
+
     const char* stringDecodeAt(size_t idx, const uint8_t* str, const size_t encLen,
                                size_t* outLen) const;
+
+    void buildIndexLocked() const;
+    ssize_t indexOfStringLocked(const void* str, size_t strLen) const;
 };
 
 /**
@@ -59,6 +59,49 @@ TEST(ApkAssetsTest, LoadApkFromFd) {
   ASSERT_THAT(loaded_apk->GetAssetsProvider()->Open("res/layout/main.xml"), NotNull());
 }
 
+TEST(ApkAssetsTest, LoadTableFromSharedMemory) {
+  std::string contents;
+  ASSERT_TRUE(ReadFileFromZipToString(GetTestDataPath() + "/basic/basic.apk", "resources.arsc",
+                                      &contents));
+
+  TemporaryFile region;
+  ASSERT_TRUE(base::WriteStringToFd(contents, region.fd));
+
+  std::unique_ptr<const ApkAssets> loaded_apk =
+      ApkAssets::LoadTableFromSharedMemory(region.fd, "basic resources");
+  ASSERT_THAT(loaded_apk, NotNull());
+
+  // The region remains owned by the caller.
+  ASSERT_THAT(fcntl(region.fd, F_GETFD), Ge(0));
+
+  const LoadedArsc* loaded_arsc = loaded_apk->GetLoadedArsc();
+  ASSERT_THAT(loaded_arsc, NotNull());
+  ASSERT_THAT(loaded_arsc->GetPackageById(0x7fu), NotNull());
+}
+
+TEST(ApkAssetsTest, LoadAllApksConcurrently) {
+  std::vector<ApkAssets::LoadRequest> requests = {
+      {GetTestDataPath() + "/basic/basic.apk"},
+      {GetTestDataPath() + "/basic/basic_hdpi-v4.apk"},
+      {GetTestDataPath() + "/basic/does_not_exist.apk"},
+      {GetTestDataPath() + "/basic/basic_xxhdpi-v4.apk"},
+  };
+
+  std::vector<std::unique_ptr<const ApkAssets>> loaded_apks =
+      ApkAssets::LoadAll(requests, 2u /* max_threads */);
+  ASSERT_THAT(loaded_apks, SizeIs(requests.size()));
+
+  for (size_t i = 0; i < requests.size(); i++) {
+    if (i == 2) {
+      EXPECT_EQ(nullptr, loaded_apks[i]);
+      continue;
+    }
+    ASSERT_THAT(loaded_apks[i], NotNull());
+    EXPECT_THAT(loaded_apks[i]->GetPath(), StrEq(requests[i].path));
+    ASSERT_THAT(loaded_apks[i]->GetLoadedArsc()->GetPackageById(0x7fu), NotNull());
+  }
+}
+
 TEST(ApkAssetsTest, LoadApkAsSharedLibrary) {
   std::unique_ptr<const ApkAssets> loaded_apk =
       ApkAssets::Load(GetTestDataPath() + "/appaslib/appaslib.apk");
@@ -158,6 +158,83 @@ TEST_F(AssetManager2Test, FindsResourceFromMultipleApkAssets) {
   EXPECT_EQ(Res_value::TYPE_STRING, value.dataType);
 }
 
+TEST_F(AssetManager2Test, CachedResourceIsPurgedOnConfigurationChange) {
+  ResTable_config desired_config;
+  memset(&desired_config, 0, sizeof(desired_config));
+
+  AssetManager2 assetmanager;
+  assetmanager.SetConfiguration(desired_config);
+  assetmanager.SetApkAssets({basic_assets_.get(), basic_de_fr_assets_.get()});
+
+  Res_value value;
+  ResTable_config selected_config;
+  uint32_t flags;
+
+  // Look up the resource twice so that the second lookup is served from the cache.
+  for (int i = 0; i < 2; i++) {
+    ApkAssetsCookie cookie =
+        assetmanager.GetResource(basic::R::string::test1, false /*may_be_bag*/,
+                                 0 /*density_override*/, &value, &selected_config, &flags);
+    ASSERT_EQ(0, cookie);
+    EXPECT_EQ(0, selected_config.language[0]);
+    EXPECT_EQ(Res_value::TYPE_STRING, value.dataType);
+  }
+
+  desired_config.language[0] = 'd';
+  desired_config.language[1] = 'e';
+  assetmanager.SetConfiguration(desired_config);
+
+  ApkAssetsCookie cookie =
+      assetmanager.GetResource(basic::R::string::test1, false /*may_be_bag*/,
+                               0 /*density_override*/, &value, &selected_config, &flags);
+  ASSERT_EQ(1, cookie);
+  EXPECT_EQ('d', selected_config.language[0]);
+  EXPECT_EQ('e', selected_config.language[1]);
+
+  // Replacing the ApkAssets without invalidating caches must not return stale entries.
+  assetmanager.SetApkAssets({basic_assets_.get()}, false /*invalidate_caches*/);
+  cookie = assetmanager.GetResource(basic::R::string::test1, false /*may_be_bag*/,
+                                    0 /*density_override*/, &value, &selected_config, &flags);
+  ASSERT_EQ(0, cookie);
+  EXPECT_EQ(0, selected_config.language[0]);
+}
+
+TEST_F(AssetManager2Test, SelectsBestDensityAcrossSplits) {
+  std::unique_ptr<const ApkAssets> hdpi_assets =
+      ApkAssets::Load(GetTestDataPath() + "/basic/basic_hdpi-v4.apk");
+  ASSERT_NE(nullptr, hdpi_assets);
+  std::unique_ptr<const ApkAssets> xhdpi_assets =
+      ApkAssets::Load(GetTestDataPath() + "/basic/basic_xhdpi-v4.apk");
+  ASSERT_NE(nullptr, xhdpi_assets);
+  std::unique_ptr<const ApkAssets> xxhdpi_assets =
+      ApkAssets::Load(GetTestDataPath() + "/basic/basic_xxhdpi-v4.apk");
+  ASSERT_NE(nullptr, xxhdpi_assets);
+
+  ResTable_config desired_config;
+  memset(&desired_config, 0, sizeof(desired_config));
+  desired_config.density = ResTable_config::DENSITY_XHIGH;
+  desired_config.sdkVersion = 21;
+
+  AssetManager2 assetmanager;
+  assetmanager.SetConfiguration(desired_config);
+  assetmanager.SetApkAssets({basic_assets_.get(), hdpi_assets.get(), xxhdpi_assets.get(),
+                             xhdpi_assets.get()});
+
+  // The selection must be the same whether or not every candidate is visited for logging.
+  for (bool logging_enabled : {false, true}) {
+    assetmanager.SetResourceResolutionLoggingEnabled(logging_enabled);
+
+    Res_value value;
+    ResTable_config selected_config;
+    uint32_t flags;
+    ApkAssetsCookie cookie =
+        assetmanager.GetResource(basic::R::string::density, false /*may_be_bag*/,
+                                 0 /*density_override*/, &value, &selected_config, &flags);
+    ASSERT_EQ(3, cookie);
+    EXPECT_EQ(ResTable_config::DENSITY_XHIGH, selected_config.density);
+  }
+}
+
 TEST_F(AssetManager2Test, FindsResourceFromSharedLibrary) {
   AssetManager2 assetmanager;
 
@@ -399,6 +476,37 @@ TEST_F(AssetManager2Test, MergesStylesWithParentFromSingleApkAssets) {
   EXPECT_EQ(app::R::style::StyleTwo, bag_two->entries[5].style);
 }
 
+TEST_F(AssetManager2Test, SharesSystemBagsBetweenAssetManagers) {
+  AssetManager2::SetBagSharingEnabled(true);
+
+  AssetManager2 assetmanager;
+  assetmanager.SetApkAssets({system_assets_.get(), style_assets_.get()});
+  const ResolvedBag* bag = assetmanager.GetBag(R::style::Theme_One);
+  ASSERT_NE(nullptr, bag);
+
+  AssetManager2 other_assetmanager;
+  other_assetmanager.SetApkAssets({system_assets_.get(), basic_assets_.get()});
+  EXPECT_EQ(bag, other_assetmanager.GetBag(R::style::Theme_One));
+
+  // The system package is at a different cookie, so the bag can't be shared.
+  AssetManager2 reordered_assetmanager;
+  reordered_assetmanager.SetApkAssets({basic_assets_.get(), system_assets_.get()});
+  const ResolvedBag* reordered_bag = reordered_assetmanager.GetBag(R::style::Theme_One);
+  ASSERT_NE(nullptr, reordered_bag);
+  EXPECT_NE(bag, reordered_bag);
+  EXPECT_EQ(1, reordered_bag->entries[0].cookie);
+
+  // Bags of non-system packages are never shared.
+  const ResolvedBag* app_bag = assetmanager.GetBag(app::R::style::StyleOne);
+  ASSERT_NE(nullptr, app_bag);
+
+  AssetManager2 app_assetmanager;
+  app_assetmanager.SetApkAssets({system_assets_.get(), style_assets_.get()});
+  EXPECT_NE(app_bag, app_assetmanager.GetBag(app::R::style::StyleOne));
+
+  AssetManager2::SetBagSharingEnabled(false);
+}
+
 TEST_F(AssetManager2Test, MergeStylesCircularDependency) {
   AssetManager2 assetmanager;
   assetmanager.SetApkAssets({style_assets_.get()});
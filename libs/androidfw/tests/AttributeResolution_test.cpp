@@ -16,6 +16,7 @@
 
 #include "androidfw/AttributeResolution.h"
 
+#include <algorithm>
 #include <array>
 
 #include "android-base/file.h"
@@ -272,5 +273,43 @@ TEST_F(AttributeResolutionXmlTest, ThemeAndXmlParser) {
   EXPECT_EQ(expected_indices, indices);
 }
 
+TEST_F(AttributeResolutionXmlTest, ApplyStyleBatchMatchesApplyStyle) {
+  std::unique_ptr<Theme> theme = assetmanager_.NewTheme();
+  ASSERT_TRUE(theme->ApplyStyle(R::style::StyleTwo));
+
+  std::array<uint32_t, 6> attrs{{R::attr::attr_one, R::attr::attr_two, R::attr::attr_three,
+                                 R::attr::attr_four, R::attr::attr_five, R::attr::attr_empty}};
+  std::array<uint32_t, attrs.size() * STYLE_NUM_ENTRIES> values;
+  std::array<uint32_t, attrs.size() + 1> indices;
+
+  ApplyStyle(theme.get(), &xml_parser_, 0u /*def_style_attr*/, 0u /*def_style_res*/, attrs.data(),
+             attrs.size(), values.data(), indices.data());
+
+  // Style the same element twice, followed by an element without XML attributes.
+  std::array<ResXMLParser*, 3> parsers{{&xml_parser_, &xml_parser_, nullptr}};
+  std::array<uint32_t, parsers.size() * attrs.size() * STYLE_NUM_ENTRIES> batch_values;
+  std::array<uint32_t, parsers.size() * (attrs.size() + 1)> batch_indices;
+
+  ApplyStyleBatch(theme.get(), parsers.data(), parsers.size(), 0u /*def_style_attr*/,
+                  0u /*def_style_res*/, attrs.data(), attrs.size(), batch_values.data(),
+                  batch_indices.data());
+
+  for (size_t i = 0; i < 2; i++) {
+    EXPECT_TRUE(std::equal(values.begin(), values.end(),
+                           batch_values.begin() + (i * values.size())));
+    EXPECT_TRUE(std::equal(indices.begin(), indices.end(),
+                           batch_indices.begin() + (i * indices.size())));
+  }
+
+  std::array<uint32_t, attrs.size() * STYLE_NUM_ENTRIES> theme_values;
+  std::array<uint32_t, attrs.size() + 1> theme_indices;
+  ApplyStyle(theme.get(), nullptr /*xml_parser*/, 0u /*def_style_attr*/, 0u /*def_style_res*/,
+             attrs.data(), attrs.size(), theme_values.data(), theme_indices.data());
+  EXPECT_TRUE(std::equal(theme_values.begin(), theme_values.end(),
+                         batch_values.begin() + (2 * values.size())));
+  EXPECT_TRUE(std::equal(theme_indices.begin(), theme_indices.end(),
+                         batch_indices.begin() + (2 * indices.size())));
+}
+
 } // namespace android
 
@@ -434,4 +434,62 @@ TEST_F(BackupDataTest, ReadDeletedEntityData) {
   delete reader;
 }
 
+
+TEST_F(BackupDataTest, SkipEntityLargerThanReadBuffer) {
+  // Larger than the reader's read-ahead buffer, so skipping it has to seek.
+  const size_t largeSize = 100 * 1024 + 3;
+  char* largeData = new char[largeSize];
+  memset(largeData, 'x', largeSize);
+
+  int fd = ::open(mFilename.string(), O_WRONLY);
+  BackupDataWriter* writer = new BackupDataWriter(fd);
+  writer->WriteEntityHeader(mKey1, largeSize);
+  writer->WriteEntityData(largeData, largeSize);
+  writer->WriteEntityHeader(mKey2, sizeof(DATA2));
+  writer->WriteEntityData(DATA2, sizeof(DATA2));
+  writer->WriteEntityHeader(mKey3, largeSize);
+  writer->WriteEntityData(largeData, largeSize);
+
+  ::close(fd);
+  fd = ::open(mFilename.string(), O_RDONLY);
+  BackupDataReader* reader = new BackupDataReader(fd);
+
+  bool done;
+  int type;
+  String8 key;
+  size_t dataSize;
+
+  // skip first entity
+  reader->ReadNextHeader(&done, &type);
+  reader->ReadEntityHeader(&key, &dataSize);
+  EXPECT_EQ(largeSize, dataSize);
+  EXPECT_EQ(NO_ERROR, reader->SkipEntityData());
+
+  // read and verify second entity
+  reader->ReadNextHeader(&done, &type);
+  EXPECT_EQ(NO_ERROR, reader->ReadEntityHeader(&key, &dataSize))
+          << "ReadEntityHeader returned an error on second entity";
+  EXPECT_EQ(mKey2, key);
+  char* dataBytes = new char[dataSize];
+  EXPECT_EQ((int) dataSize, reader->ReadEntityData(dataBytes, dataSize));
+  EXPECT_EQ(0, memcmp(DATA2, dataBytes, sizeof(DATA2)));
+  delete[] dataBytes;
+
+  // read the third entity in one go, bypassing the read-ahead buffer
+  reader->ReadNextHeader(&done, &type);
+  EXPECT_EQ(NO_ERROR, reader->ReadEntityHeader(&key, &dataSize));
+  EXPECT_EQ(mKey3, key);
+  dataBytes = new char[dataSize];
+  EXPECT_EQ((int) largeSize, reader->ReadEntityData(dataBytes, dataSize));
+  EXPECT_EQ(0, memcmp(largeData, dataBytes, largeSize));
+  delete[] dataBytes;
+
+  reader->ReadNextHeader(&done, &type);
+  EXPECT_TRUE(done);
+
+  delete[] largeData;
+  delete writer;
+  delete reader;
+}
+
 }
@@ -16,12 +16,51 @@
 
 #include "BenchmarkHelpers.h"
 
+#include <cstdlib>
+#include <new>
+
 #include "android-base/stringprintf.h"
 #include "androidfw/AssetManager.h"
 #include "androidfw/AssetManager2.h"
 
+static thread_local size_t sThreadAllocationCount = 0u;
+
+// Replace the global allocation functions so that benchmarks can report allocations per operation.
+void* operator new(size_t size) {
+  sThreadAllocationCount++;
+  void* ptr = malloc(size == 0u ? 1u : size);
+  if (ptr == nullptr) {
+    throw std::bad_alloc();
+  }
+  return ptr;
+}
+
+void* operator new[](size_t size) {
+  return operator new(size);
+}
+
+void operator delete(void* ptr) noexcept {
+  free(ptr);
+}
+
+void operator delete[](void* ptr) noexcept {
+  free(ptr);
+}
+
+void operator delete(void* ptr, size_t) noexcept {
+  free(ptr);
+}
+
+void operator delete[](void* ptr, size_t) noexcept {
+  free(ptr);
+}
+
 namespace android {
 
+size_t GetThreadAllocationCount() {
+  return sThreadAllocationCount;
+}
+
 void GetResourceBenchmarkOld(const std::vector<std::string>& paths, const ResTable_config* config,
                              uint32_t resid, benchmark::State& state) {
   AssetManager assetmanager;
@@ -76,6 +115,7 @@ void GetResourceBenchmark(const std::vector<std::string>& paths, const ResTable_
   uint32_t flags;
   uint32_t last_id = 0u;
 
+  ScopedAllocationCounter allocation_counter(state);
   while (state.KeepRunning()) {
     ApkAssetsCookie cookie = assetmanager.GetResource(
         resid, false /* may_be_bag */, 0u /* density_override */, &value, &selected_config, &flags);
@@ -33,6 +33,28 @@ void GetResourceBenchmarkOld(const std::vector<std::string>& paths, const ResTab
 void GetResourceBenchmark(const std::vector<std::string>& paths, const ResTable_config* config,
                           uint32_t resid, benchmark::State& state);
 
+// Returns the number of heap allocations made by the calling thread so far.
+size_t GetThreadAllocationCount();
+
+// Counts the heap allocations made by the calling thread during its lifetime and reports them as
+// the "allocs/op" counter of the benchmark.
+class ScopedAllocationCounter {
+ public:
+  explicit ScopedAllocationCounter(benchmark::State& state)
+      : state_(state), start_count_(GetThreadAllocationCount()) {
+  }
+
+  ~ScopedAllocationCounter() {
+    state_.counters["allocs/op"] =
+        benchmark::Counter(static_cast<double>(GetThreadAllocationCount() - start_count_),
+                           benchmark::Counter::kAvgIterations);
+  }
+
+ private:
+  benchmark::State& state_;
+  const size_t start_count_;
+};
+
 }  // namespace android
 
 #endif  // ANDROIDFW_TESTS_BENCHMARKHELPERS_H
@@ -87,6 +87,55 @@ TEST_F(IdmapTest, OverlayOverridesResourceValue) {
   ASSERT_EQ(GetStringFromApkAssets(asset_manager, val, cookie), "Overlay One");
 }
 
+TEST_F(IdmapTest, OverlayCanBeAppendedAndRemoved) {
+  AssetManager2 asset_manager;
+  asset_manager.SetApkAssets({system_assets_.get(), overlayable_assets_.get()});
+  Res_value val;
+  ResTable_config config;
+  uint32_t flags;
+  ApkAssetsCookie cookie = asset_manager.GetResource(overlayable::R::string::overlayable5,
+                                                    false /* may_be_bag */,
+                                                    0 /* density_override */, &val, &config,
+                                                    &flags);
+  ASSERT_EQ(cookie, 1U);
+
+  asset_manager.SetApkAssets({system_assets_.get(), overlayable_assets_.get(),
+                              overlay_assets_.get()});
+  cookie = asset_manager.GetResource(overlayable::R::string::overlayable5, false /* may_be_bag */,
+                                     0 /* density_override */, &val, &config, &flags);
+  ASSERT_EQ(cookie, 2U);
+  ASSERT_EQ(val.dataType, Res_value::TYPE_STRING);
+  ASSERT_EQ(GetStringFromApkAssets(asset_manager, val, cookie), "Overlay One");
+
+  asset_manager.SetApkAssets({system_assets_.get(), overlayable_assets_.get()});
+  cookie = asset_manager.GetResource(overlayable::R::string::overlayable5, false /* may_be_bag */,
+                                     0 /* density_override */, &val, &config, &flags);
+  ASSERT_EQ(cookie, 1U);
+  const LoadedPackage* overlay_package =
+      overlay_assets_->GetLoadedArsc()->GetPackages()[0].get();
+  ASSERT_EQ(asset_manager.GetAssignedPackageId(overlay_package), 0U);
+}
+
+TEST_F(IdmapTest, ResourceNotInIdmapIsNotOverlaid) {
+  AssetManager2 asset_manager;
+  asset_manager.SetApkAssets({system_assets_.get(), overlayable_assets_.get(),
+                              overlay_assets_.get()});
+  Res_value val;
+  ResTable_config config;
+  uint32_t flags;
+  ApkAssetsCookie cookie = asset_manager.GetResource(overlayable::R::string::not_overlayable,
+                                                    false /* may_be_bag */,
+                                                    0 /* density_override */, &val, &config,
+                                                    &flags);
+  ASSERT_EQ(cookie, 1U);
+  ASSERT_EQ(val.dataType, Res_value::TYPE_STRING);
+
+  cookie = asset_manager.GetResource(overlayable::R::string::overlayable11 + 1U,
+                                     false /* may_be_bag */, 0 /* density_override */, &val,
+                                     &config, &flags);
+  ASSERT_EQ(cookie, kInvalidCookie);
+}
+
 TEST_F(IdmapTest, OverlayOverridesResourceValueUsingDifferentPackage) {
   AssetManager2 asset_manager;
   asset_manager.SetApkAssets({system_assets_.get(), overlayable_assets_.get(),
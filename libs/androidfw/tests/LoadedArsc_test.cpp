@@ -16,6 +16,8 @@
 
 #include "androidfw/LoadedArsc.h"
 
+#include <algorithm>
+
 #include "android-base/file.h"
 #include "androidfw/ResourceUtils.h"
 
@@ -71,6 +73,45 @@ TEST(LoadedArscTest, LoadSinglePackageArsc) {
   ASSERT_THAT(LoadedPackage::GetEntry(type, entry_index), NotNull());
 }
 
+TEST(LoadedArscTest, LoadTypesLazily) {
+  std::string contents;
+  ASSERT_TRUE(ReadFileFromZipToString(GetTestDataPath() + "/styles/styles.apk", "resources.arsc",
+                                      &contents));
+
+  std::unique_ptr<const LoadedArsc> loaded_arsc =
+      LoadedArsc::Load(StringPiece(contents), nullptr /* loaded_idmap */, PROPERTY_LAZY_TYPES);
+  ASSERT_THAT(loaded_arsc, NotNull());
+
+  const LoadedPackage* package =
+      loaded_arsc->GetPackageById(get_package_id(app::R::string::string_one));
+  ASSERT_THAT(package, NotNull());
+
+  const uint8_t type_index = get_type_id(app::R::string::string_one) - 1;
+  const uint16_t entry_index = get_entry_id(app::R::string::string_one);
+
+  const TypeSpec* type_spec = package->GetTypeSpecByTypeIndex(type_index);
+  ASSERT_THAT(type_spec, NotNull());
+  ASSERT_THAT(type_spec->type_count, Ge(1u));
+  EXPECT_THAT(package->GetTypeSpecByTypeIndex(type_index), Eq(type_spec));
+
+  const ResTable_type* type = type_spec->types[0];
+  ASSERT_THAT(type, NotNull());
+  ASSERT_THAT(LoadedPackage::GetEntry(type, entry_index), NotNull());
+
+  // Lazily loaded packages report the same configurations as eagerly loaded ones.
+  std::unique_ptr<const LoadedArsc> eager_arsc = LoadedArsc::Load(StringPiece(contents));
+  ASSERT_THAT(eager_arsc, NotNull());
+  std::set<ResTable_config> lazy_configs;
+  std::set<ResTable_config> eager_configs;
+  package->CollectConfigurations(false /* exclude_mipmap */, &lazy_configs);
+  eager_arsc->GetPackages()[0]->CollectConfigurations(false /* exclude_mipmap */, &eager_configs);
+  ASSERT_EQ(eager_configs.size(), lazy_configs.size());
+  EXPECT_TRUE(std::equal(eager_configs.begin(), eager_configs.end(), lazy_configs.begin(),
+                         [](const ResTable_config& a, const ResTable_config& b) {
+                           return a.compare(b) == 0;
+                         }));
+}
+
 TEST(LoadedArscTest, LoadSparseEntryApp) {
   std::string contents;
   ASSERT_TRUE(ReadFileFromZipToString(GetTestDataPath() + "/sparse/sparse.apk", "resources.arsc",
@@ -223,6 +264,50 @@ TEST(LoadedArscTest, LoadOutOfOrderTypeSpecs) {
   ASSERT_THAT(type_spec->types[0], NotNull());
 }
 
+TEST(LoadedArscTest, LoadWithIndex) {
+  std::string contents;
+  ASSERT_TRUE(ReadFileFromZipToString(GetTestDataPath() + "/styles/styles.apk", "resources.arsc",
+                                      &contents));
+
+  std::unique_ptr<const LoadedArsc> loaded_arsc = LoadedArsc::Load(StringPiece(contents));
+  ASSERT_THAT(loaded_arsc, NotNull());
+
+  constexpr uint64_t kKey = 0x0123456789abcdefu;
+  std::string index;
+  ASSERT_TRUE(loaded_arsc->SerializeIndex(StringPiece(contents), kKey, &index));
+
+  std::unique_ptr<const LoadedArsc> indexed_arsc =
+      LoadedArsc::LoadWithIndex(StringPiece(contents), StringPiece(index), kKey);
+  ASSERT_THAT(indexed_arsc, NotNull());
+  ASSERT_THAT(indexed_arsc->GetPackages(), SizeIs(loaded_arsc->GetPackages().size()));
+
+  const LoadedPackage* package =
+      indexed_arsc->GetPackageById(get_package_id(app::R::string::string_one));
+  ASSERT_THAT(package, NotNull());
+  EXPECT_THAT(package->GetPackageName(), StrEq("com.android.app"));
+
+  const uint8_t type_index = get_type_id(app::R::string::string_one) - 1;
+  const TypeSpec* type_spec = package->GetTypeSpecByTypeIndex(type_index);
+  ASSERT_THAT(type_spec, NotNull());
+  ASSERT_THAT(type_spec->type_count, Ge(1u));
+
+  const TypeSpec* expected_type_spec =
+      loaded_arsc->GetPackages()[0]->GetTypeSpecByTypeIndex(type_index);
+  ASSERT_THAT(expected_type_spec, NotNull());
+  EXPECT_THAT(type_spec->type_count, Eq(expected_type_spec->type_count));
+  EXPECT_THAT(type_spec->types[0], Eq(expected_type_spec->types[0]));
+  EXPECT_THAT(LoadedPackage::GetEntry(type_spec->types[0],
+                                      get_entry_id(app::R::string::string_one)),
+              NotNull());
+
+  // An index created for other data must be rejected.
+  EXPECT_THAT(LoadedArsc::LoadWithIndex(StringPiece(contents), StringPiece(index), kKey + 1),
+              IsNull());
+  EXPECT_THAT(LoadedArsc::LoadWithIndex(StringPiece(contents),
+                                        StringPiece(index.data(), index.size() - 4), kKey),
+              IsNull());
+}
+
 TEST(LoadedArscTest, LoadOverlayable) {
   std::string contents;
   ASSERT_TRUE(ReadFileFromZipToString(GetTestDataPath() + "/overlayable/overlayable.apk",
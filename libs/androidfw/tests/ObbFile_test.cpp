@@ -26,6 +26,9 @@
 #include <sys/stat.h>
 #include <fcntl.h>
 #include <string.h>
+#include <unistd.h>
+
+#include <string>
 
 namespace android {
 
@@ -97,4 +100,42 @@ TEST_F(ObbFileTest, WriteThenRead) {
             << "salts should be the same";
 }
 
+TEST_F(ObbFileTest, DigestIsIndependentOfThreadCount) {
+    int fd = ::open(mFileName.string(), O_WRONLY);
+    ASSERT_GE(fd, 0);
+    // Spans several digest blocks with a partial one at the end.
+    std::string contents(9 * 1024 * 1024 + 123, 'x');
+    ASSERT_EQ((ssize_t)contents.size(), write(fd, contents.data(), contents.size()));
+    close(fd);
+
+    mObbFile->setPackageName(String8("com.example.obbfile"));
+    mObbFile->setVersion(1);
+    ASSERT_TRUE(mObbFile->writeTo(mFileName.string()));
+
+    fd = ::open(mFileName.string(), O_RDONLY);
+    ASSERT_GE(fd, 0);
+    sp<ObbFile> serial = new ObbFile();
+    sp<ObbFile> parallel = new ObbFile();
+    ASSERT_TRUE(serial->readFrom(fd));
+    ASSERT_TRUE(serial->computeDigest(fd, 1));
+    ASSERT_TRUE(parallel->readFrom(fd));
+    ASSERT_TRUE(parallel->computeDigest(fd, 4));
+    close(fd);
+
+    size_t serialLen, parallelLen;
+    const unsigned char* serialDigest = serial->getDigest(&serialLen);
+    const unsigned char* parallelDigest = parallel->getDigest(&parallelLen);
+    ASSERT_EQ((size_t)OBB_DIGEST_SIZE, serialLen);
+    ASSERT_EQ(serialLen, parallelLen);
+    EXPECT_EQ(0, memcmp(serialDigest, parallelDigest, serialLen));
+
+    sp<ObbFile> cached = ObbFile::readCached(mFileName.string(), true);
+    ASSERT_TRUE(cached != NULL);
+    size_t cachedLen;
+    const unsigned char* cachedDigest = cached->getDigest(&cachedLen);
+    ASSERT_EQ(serialLen, cachedLen);
+    EXPECT_EQ(0, memcmp(serialDigest, cachedDigest, cachedLen));
+    EXPECT_STREQ("com.example.obbfile", cached->getPackageName().string());
+}
+
 }
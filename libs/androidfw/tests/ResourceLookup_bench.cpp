@@ -0,0 +1,225 @@
+/*
+ * Copyright (C) 2020 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <unistd.h>
+
+#include <array>
+#include <vector>
+
+#include "benchmark/benchmark.h"
+
+#include "android-base/file.h"
+#include "androidfw/ApkAssets.h"
+#include "androidfw/AssetManager2.h"
+#include "androidfw/AttributeResolution.h"
+#include "androidfw/ResourceTypes.h"
+
+#include "BenchmarkHelpers.h"
+#include "data/basic/R.h"
+#include "data/overlayable/R.h"
+#include "data/styles/R.h"
+
+namespace app = com::android::app;
+namespace basic = com::android::basic;
+namespace overlayable = com::android::overlayable;
+
+namespace android {
+
+constexpr const static char* kFrameworkPath = "/system/framework/framework-res.apk";
+constexpr const static uint32_t Theme_Material_Light = 0x01030237u;
+
+// Loads the overlay test data. The idmap refers to the overlay APK by a path relative to the test
+// data directory, so the working directory is changed for the lifetime of this object.
+class OverlayAssets {
+ public:
+  explicit OverlayAssets(benchmark::State& state) {
+    original_path_ = base::GetExecutableDirectory();
+    if (chdir(GetTestDataPath().c_str()) != 0) {
+      state.SkipWithError("failed to change to the test data directory");
+      return;
+    }
+
+    system_ = ApkAssets::Load("system/system.apk");
+    target_ = ApkAssets::Load("overlayable/overlayable.apk");
+    overlay_ = ApkAssets::LoadOverlay("overlay/overlay.idmap");
+    if (system_ == nullptr || target_ == nullptr || overlay_ == nullptr) {
+      state.SkipWithError("failed to load overlay assets");
+      return;
+    }
+    assets_.SetApkAssets({system_.get(), target_.get(), overlay_.get()});
+  }
+
+  ~OverlayAssets() {
+    chdir(original_path_.c_str());
+  }
+
+  AssetManager2& assets() {
+    return assets_;
+  }
+
+ private:
+  std::string original_path_;
+  std::unique_ptr<const ApkAssets> system_;
+  std::unique_ptr<const ApkAssets> target_;
+  std::unique_ptr<const ApkAssets> overlay_;
+  AssetManager2 assets_;
+};
+
+static void BM_AssetManagerGetOverlaidResource(benchmark::State& state, uint32_t resid) {
+  OverlayAssets overlay_assets(state);
+  AssetManager2& assets = overlay_assets.assets();
+
+  Res_value value;
+  ResTable_config selected_config;
+  uint32_t flags;
+
+  ScopedAllocationCounter allocation_counter(state);
+  while (state.KeepRunning()) {
+    ApkAssetsCookie cookie = assets.GetResource(resid, false /* may_be_bag */,
+                                                0u /* density_override */, &value,
+                                                &selected_config, &flags);
+    benchmark::DoNotOptimize(cookie);
+  }
+}
+BENCHMARK_CAPTURE(BM_AssetManagerGetOverlaidResource, overlaid,
+                  overlayable::R::string::overlayable5);
+BENCHMARK_CAPTURE(BM_AssetManagerGetOverlaidResource, inline_value,
+                  overlayable::R::string::overlayable10);
+BENCHMARK_CAPTURE(BM_AssetManagerGetOverlaidResource, not_overlaid,
+                  overlayable::R::string::not_overlayable);
+
+static void BM_AssetManagerSetApkAssetsSplits(benchmark::State& state) {
+  const std::vector<std::string> paths = {
+      GetTestDataPath() + "/basic/basic.apk",
+      GetTestDataPath() + "/basic/basic_de_fr.apk",
+      GetTestDataPath() + "/basic/basic_hdpi-v4.apk",
+      GetTestDataPath() + "/basic/basic_xhdpi-v4.apk",
+      GetTestDataPath() + "/basic/basic_xxhdpi-v4.apk",
+  };
+
+  std::vector<std::unique_ptr<const ApkAssets>> apk_assets;
+  std::vector<const ApkAssets*> apk_assets_ptrs;
+  for (const std::string& path : paths) {
+    std::unique_ptr<const ApkAssets> apk = ApkAssets::Load(path);
+    if (apk == nullptr) {
+      state.SkipWithError("failed to load assets");
+      return;
+    }
+    apk_assets_ptrs.push_back(apk.get());
+    apk_assets.push_back(std::move(apk));
+  }
+
+  AssetManager2 assets;
+  ScopedAllocationCounter allocation_counter(state);
+  while (state.KeepRunning()) {
+    assets.SetApkAssets(apk_assets_ptrs);
+  }
+}
+BENCHMARK(BM_AssetManagerSetApkAssetsSplits);
+
+static void BM_AssetManagerGetResourceSplits(benchmark::State& state) {
+  ResTable_config config;
+  memset(&config, 0, sizeof(config));
+  memcpy(config.language, "de", 2);
+  config.density = ResTable_config::DENSITY_XHIGH;
+  GetResourceBenchmark(
+      {GetTestDataPath() + "/basic/basic.apk", GetTestDataPath() + "/basic/basic_de_fr.apk",
+       GetTestDataPath() + "/basic/basic_hdpi-v4.apk",
+       GetTestDataPath() + "/basic/basic_xhdpi-v4.apk",
+       GetTestDataPath() + "/basic/basic_xxhdpi-v4.apk"},
+      &config, basic::R::string::test1, state);
+}
+BENCHMARK(BM_AssetManagerGetResourceSplits);
+
+// Resolves the bag of a style with a deep parent hierarchy. A new AssetManager2 is used for every
+// iteration so that the bag cache does not hide the cost of resolving it.
+static void BM_AssetManagerResolveBagFramework(benchmark::State& state) {
+  std::unique_ptr<const ApkAssets> apk = ApkAssets::Load(kFrameworkPath);
+  if (apk == nullptr) {
+    state.SkipWithError("failed to load framework assets");
+    return;
+  }
+
+  ScopedAllocationCounter allocation_counter(state);
+  while (state.KeepRunning()) {
+    state.PauseTiming();
+    AssetManager2 assets;
+    assets.SetApkAssets({apk.get()});
+    state.ResumeTiming();
+
+    const ResolvedBag* bag = assets.GetBag(Theme_Material_Light);
+    benchmark::DoNotOptimize(bag);
+  }
+}
+BENCHMARK(BM_AssetManagerResolveBagFramework);
+
+// Applies the same style to a batch of views, as when inflating a list of identical items.
+static void BM_ApplyStyleBatch(benchmark::State& state) {
+  std::unique_ptr<const ApkAssets> styles_apk =
+      ApkAssets::Load(GetTestDataPath() + "/styles/styles.apk");
+  if (styles_apk == nullptr) {
+    state.SkipWithError("failed to load assets");
+    return;
+  }
+
+  AssetManager2 assetmanager;
+  assetmanager.SetApkAssets({styles_apk.get()});
+
+  std::unique_ptr<Asset> asset =
+      assetmanager.OpenNonAsset("res/layout/layout.xml", Asset::ACCESS_BUFFER);
+  if (asset == nullptr) {
+    state.SkipWithError("failed to load layout");
+    return;
+  }
+
+  ResXMLTree xml_tree;
+  if (xml_tree.setTo(asset->getBuffer(true), asset->getLength(), false /*copyData*/) != NO_ERROR) {
+    state.SkipWithError("corrupt xml layout");
+    return;
+  }
+
+  // Skip to the first tag.
+  while (xml_tree.next() != ResXMLParser::START_TAG) {
+  }
+
+  const size_t batch_size = static_cast<size_t>(state.range(0));
+  // Every parser starts at the current position of the tree.
+  std::vector<ResXMLParser> parsers(batch_size, static_cast<const ResXMLParser&>(xml_tree));
+  std::vector<ResXMLParser*> parser_ptrs;
+  for (ResXMLParser& parser : parsers) {
+    parser_ptrs.push_back(&parser);
+  }
+
+  std::unique_ptr<Theme> theme = assetmanager.NewTheme();
+  theme->ApplyStyle(app::R::style::StyleTwo);
+
+  std::array<uint32_t, 6> attrs{{app::R::attr::attr_one, app::R::attr::attr_two,
+                                 app::R::attr::attr_three, app::R::attr::attr_four,
+                                 app::R::attr::attr_five, app::R::attr::attr_empty}};
+  std::vector<uint32_t> values(batch_size * attrs.size() * STYLE_NUM_ENTRIES);
+  std::vector<uint32_t> indices(batch_size * (attrs.size() + 1));
+
+  ScopedAllocationCounter allocation_counter(state);
+  while (state.KeepRunning()) {
+    ApplyStyleBatch(theme.get(), parser_ptrs.data(), parser_ptrs.size(),
+                    0u /*def_style_attr*/, app::R::style::StyleOne /*def_style_res*/,
+                    attrs.data(), attrs.size(), values.data(), indices.data());
+  }
+  state.SetItemsProcessed(state.iterations() * batch_size);
+}
+BENCHMARK(BM_ApplyStyleBatch)->Arg(1)->Arg(16)->Arg(64);
+
+}  // namespace android
@@ -130,6 +130,36 @@ TEST_F(ThemeTest, SingleThemeWithParent) {
   EXPECT_EQ(static_cast<uint32_t>(ResTable_typeSpec::SPEC_PUBLIC), flags);
 }
 
+TEST_F(ThemeTest, ResolvedAttributeIsPurgedWhenThemeChanges) {
+  AssetManager2 assetmanager;
+  assetmanager.SetApkAssets({style_assets_.get()});
+
+  std::unique_ptr<Theme> theme = assetmanager.NewTheme();
+  ASSERT_TRUE(theme->ApplyStyle(app::R::style::StyleTwo));
+
+  Res_value value;
+  uint32_t flags;
+
+  // attr_three points to attr_indirect, so the second lookup is served from the cache.
+  for (int i = 0; i < 2; i++) {
+    ASSERT_NE(kInvalidCookie, theme->GetAttribute(app::R::attr::attr_three, &value, &flags));
+    EXPECT_EQ(Res_value::TYPE_INT_DEC, value.dataType);
+    EXPECT_EQ(3u, value.data);
+    EXPECT_EQ(static_cast<uint32_t>(ResTable_typeSpec::SPEC_PUBLIC), flags);
+  }
+
+  theme->Clear();
+  EXPECT_EQ(kInvalidCookie, theme->GetAttribute(app::R::attr::attr_three, &value, &flags));
+
+  ASSERT_TRUE(theme->ApplyStyle(app::R::style::StyleTwo));
+  ASSERT_NE(kInvalidCookie, theme->GetAttribute(app::R::attr::attr_three, &value, &flags));
+  EXPECT_EQ(3u, value.data);
+
+  std::unique_ptr<Theme> empty_theme = assetmanager.NewTheme();
+  theme->SetTo(*empty_theme);
+  EXPECT_EQ(kInvalidCookie, theme->GetAttribute(app::R::attr::attr_three, &value, &flags));
+}
+
 TEST_F(ThemeTest, TryToUseBadResourceId) {
   AssetManager2 assetmanager;
   assetmanager.SetApkAssets({style_assets_.get()});
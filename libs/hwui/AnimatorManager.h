@@ -60,7 +60,8 @@ public:
     // the ActivityContext is being destroyed
     void endAllActiveAnimators();
 
-    bool hasAnimators() { return mAnimators.size(); }
+    bool hasAnimators() const { return mAnimators.size(); }
+    bool hasNewAnimators() const { return mNewAnimators.size(); }
 
 private:
     uint32_t animateCommon(TreeInfo& info);
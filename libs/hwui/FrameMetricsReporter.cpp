@@ -0,0 +1,55 @@
+/*
+ * Copyright (C) 2020 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "FrameMetricsReporter.h"
+
+namespace android {
+namespace uirenderer {
+
+std::mutex GlobalFrameMetricsReporter::sLock;
+std::vector<std::pair<GlobalFrameMetricsReporter::Callback, void*> >
+        GlobalFrameMetricsReporter::sCallbacks;
+std::atomic_bool GlobalFrameMetricsReporter::sHasCallbacks = false;
+
+void GlobalFrameMetricsReporter::addCallback(Callback callback, void* data) {
+    std::lock_guard<std::mutex> lock(sLock);
+    sCallbacks.emplace_back(callback, data);
+    sHasCallbacks = true;
+}
+
+bool GlobalFrameMetricsReporter::removeCallback(Callback callback, void* data) {
+    std::lock_guard<std::mutex> lock(sLock);
+    for (size_t i = 0; i < sCallbacks.size(); i++) {
+        if (sCallbacks[i].first == callback && sCallbacks[i].second == data) {
+            sCallbacks.erase(sCallbacks.begin() + i);
+            sHasCallbacks = !sCallbacks.empty();
+            return true;
+        }
+    }
+    return false;
+}
+
+void GlobalFrameMetricsReporter::reportFrameMetrics(const int64_t* stats) {
+    // Holding the lock while calling out is what lets removeCallback() promise
+    // that a removed callback is not running anymore. It is uncontended except
+    // while callbacks are being added or removed.
+    std::lock_guard<std::mutex> lock(sLock);
+    for (const auto& [callback, data] : sCallbacks) {
+        callback(stats, static_cast<size_t>(FrameInfoIndex::NumIndexes), data);
+    }
+}
+
+}  // namespace uirenderer
+}  // namespace android
@@ -23,6 +23,9 @@
 #include "FrameMetricsObserver.h"
 
 #include <string.h>
+#include <atomic>
+#include <mutex>
+#include <utility>
 #include <vector>
 
 namespace android {
@@ -56,5 +59,30 @@ private:
     std::vector<sp<FrameMetricsObserver> > mObservers;
 };
 
+/*
+ * Process-wide callbacks that receive the FrameInfo of every frame drawn by any
+ * CanvasContext. They run on the render thread straight from
+ * CanvasContext::draw, so native code can collect frame timing without the
+ * Java observer and its handler thread.
+ */
+class GlobalFrameMetricsReporter {
+public:
+    typedef void (*Callback)(const int64_t* metrics, size_t count, void* data);
+
+    static void addCallback(Callback callback, void* data);
+
+    // Once this returns the callback will not be invoked again.
+    static bool removeCallback(Callback callback, void* data);
+
+    static bool hasCallbacks() { return sHasCallbacks.load(std::memory_order_relaxed); }
+
+    static void reportFrameMetrics(const int64_t* stats);
+
+private:
+    static std::mutex sLock;
+    static std::vector<std::pair<Callback, void*> > sCallbacks;
+    static std::atomic_bool sHasCallbacks;
+};
+
 }  // namespace uirenderer
 }  // namespace android
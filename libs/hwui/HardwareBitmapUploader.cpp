@@ -19,6 +19,7 @@
 #include "hwui/Bitmap.h"
 #include "renderthread/EglManager.h"
 #include "renderthread/VulkanManager.h"
+#include "thread/CommonPool.h"
 #include "thread/ThreadBase.h"
 #include "utils/TimeUtils.h"
 
@@ -32,6 +33,7 @@
 #include <utils/GLUtils.h>
 #include <utils/Trace.h>
 #include <utils/TraceUtils.h>
+#include <deque>
 #include <thread>
 
 namespace android::uirenderer {
@@ -49,6 +51,12 @@ struct FormatInfo {
     bool valid = true;
 };
 
+struct HardwareBitmapUpload {
+    SkBitmap bitmap;
+    FormatInfo format;
+    sp<GraphicBuffer> graphicBuffer;
+};
+
 class AHBUploader : public RefBase {
 public:
     virtual ~AHBUploader() {}
@@ -79,6 +87,19 @@ public:
         return result;
     }
 
+    // Sets results[i] to whether uploads[i] succeeded.
+    void uploadHardwareBitmaps(const std::vector<HardwareBitmapUpload>& uploads,
+                               std::vector<bool>* results) {
+        ATRACE_FORMAT("uploadHardwareBitmaps (%zu)", uploads.size());
+        results->assign(uploads.size(), false);
+        if (uploads.empty()) {
+            return;
+        }
+        beginUpload();
+        onUploadHardwareBitmaps(uploads, results);
+        endUpload();
+    }
+
     void postIdleTimeoutCheck() {
         mUploadThread->queue().postDelayed(5000_ms, [this](){ this->idleTimeoutCheck(); });
     }
@@ -94,6 +115,13 @@ private:
 
     virtual bool onUploadHardwareBitmap(const SkBitmap& bitmap, const FormatInfo& format,
                                         sp<GraphicBuffer> graphicBuffer) = 0;
+    virtual void onUploadHardwareBitmaps(const std::vector<HardwareBitmapUpload>& uploads,
+                                         std::vector<bool>* results) {
+        for (size_t i = 0; i < uploads.size(); i++) {
+            (*results)[i] = onUploadHardwareBitmap(uploads[i].bitmap, uploads[i].format,
+                                                   uploads[i].graphicBuffer);
+        }
+    }
     virtual void onBeginUpload() = 0;
 
     bool shouldTimeOutLocked() {
@@ -223,6 +251,75 @@ private:
         return true;
     }
 
+    void onUploadHardwareBitmaps(const std::vector<HardwareBitmapUpload>& uploads,
+                                 std::vector<bool>* results) override {
+        ATRACE_CALL();
+
+        EGLDisplay display = getUploadEglDisplay();
+
+        LOG_ALWAYS_FATAL_IF(display == EGL_NO_DISPLAY, "Failed to get EGL_DEFAULT_DISPLAY! err=%s",
+                            uirenderer::renderthread::EglManager::eglErrorString());
+        std::vector<std::unique_ptr<AutoEglImage>> images(uploads.size());
+        for (size_t i = 0; i < uploads.size(); i++) {
+            EGLClientBuffer clientBuffer =
+                    (EGLClientBuffer)uploads[i].graphicBuffer->getNativeBuffer();
+            images[i] = std::make_unique<AutoEglImage>(display, clientBuffer);
+            if (images[i]->image == EGL_NO_IMAGE_KHR) {
+                ALOGW("Could not create EGL image, err =%s",
+                      uirenderer::renderthread::EglManager::eglErrorString());
+                images[i].reset();
+            }
+        }
+
+        // Unlike onUploadHardwareBitmap, all of the transfers are issued in a single trip to the
+        // upload thread and share one fence.
+        ATRACE_FORMAT("CPU -> gralloc transfer (%zu bitmaps)", uploads.size());
+        EGLSyncKHR fence = mUploadThread->queue().runSync([&]() -> EGLSyncKHR {
+            bool anyUploaded = false;
+            for (size_t i = 0; i < uploads.size(); i++) {
+                if (!images[i]) {
+                    continue;
+                }
+                const SkBitmap& bitmap = uploads[i].bitmap;
+                const FormatInfo& format = uploads[i].format;
+                AutoSkiaGlTexture glTexture;
+                glEGLImageTargetTexture2DOES(GL_TEXTURE_2D, images[i]->image);
+                if (GLUtils::dumpGLErrors()) {
+                    continue;
+                }
+                glTexSubImage2D(GL_TEXTURE_2D, 0, 0, 0, bitmap.width(), bitmap.height(),
+                                format.format, format.type, bitmap.getPixels());
+                if (GLUtils::dumpGLErrors()) {
+                    continue;
+                }
+                (*results)[i] = true;
+                anyUploaded = true;
+            }
+            if (!anyUploaded) {
+                return EGL_NO_SYNC_KHR;
+            }
+
+            EGLSyncKHR uploadFence =
+                    eglCreateSyncKHR(eglGetCurrentDisplay(), EGL_SYNC_FENCE_KHR, NULL);
+            if (uploadFence == EGL_NO_SYNC_KHR) {
+                ALOGW("Could not create sync fence %#x", eglGetError());
+            }
+            glFlush();
+            GLUtils::dumpGLErrors();
+            return uploadFence;
+        });
+
+        if (fence == EGL_NO_SYNC_KHR) {
+            results->assign(uploads.size(), false);
+            return;
+        }
+        EGLint waitStatus = eglClientWaitSyncKHR(display, fence, 0, FENCE_TIMEOUT);
+        ALOGE_IF(waitStatus != EGL_CONDITION_SATISFIED_KHR,
+                "Failed to wait for the fence %#x", eglGetError());
+
+        eglDestroySyncKHR(display, fence);
+    }
+
     renderthread::EglManager mEglManager;
 };
 
@@ -382,15 +479,11 @@ static void createUploader(bool usingGL) {
     }
 }
 
-sk_sp<Bitmap> HardwareBitmapUploader::allocateHardwareBitmap(const SkBitmap& sourceBitmap) {
-    ATRACE_CALL();
-
-    bool usingGL = uirenderer::Properties::getRenderPipelineType() ==
-            uirenderer::RenderPipelineType::SkiaGL;
-
+static bool prepareUpload(const SkBitmap& sourceBitmap, bool usingGL,
+                          HardwareBitmapUpload* upload) {
     FormatInfo format = determineFormat(sourceBitmap, usingGL);
     if (!format.valid) {
-        return nullptr;
+        return false;
     }
 
     SkBitmap bitmap = makeHwCompatible(format, sourceBitmap);
@@ -405,17 +498,123 @@ sk_sp<Bitmap> HardwareBitmapUploader::allocateHardwareBitmap(const SkBitmap& sou
     status_t error = buffer->initCheck();
     if (error < 0) {
         ALOGW("createGraphicBuffer() failed in GraphicBuffer.create()");
+        return false;
+    }
+
+    upload->bitmap = std::move(bitmap);
+    upload->format = format;
+    upload->graphicBuffer = std::move(buffer);
+    return true;
+}
+
+static sk_sp<Bitmap> createFromUpload(const HardwareBitmapUpload& upload) {
+    const SkBitmap& bitmap = upload.bitmap;
+    return Bitmap::createFrom(upload.graphicBuffer->toAHardwareBuffer(), bitmap.colorType(),
+                              bitmap.refColorSpace(), bitmap.alphaType(),
+                              Bitmap::computePalette(bitmap));
+}
+
+sk_sp<Bitmap> HardwareBitmapUploader::allocateHardwareBitmap(const SkBitmap& sourceBitmap) {
+    ATRACE_CALL();
+
+    bool usingGL = uirenderer::Properties::getRenderPipelineType() ==
+            uirenderer::RenderPipelineType::SkiaGL;
+
+    HardwareBitmapUpload upload;
+    if (!prepareUpload(sourceBitmap, usingGL, &upload)) {
         return nullptr;
     }
 
     createUploader(usingGL);
 
-    if (!sUploader->uploadHardwareBitmap(bitmap, format, buffer)) {
+    if (!sUploader->uploadHardwareBitmap(upload.bitmap, upload.format, upload.graphicBuffer)) {
         return nullptr;
     }
-    return Bitmap::createFrom(buffer->toAHardwareBuffer(), bitmap.colorType(),
-                              bitmap.refColorSpace(), bitmap.alphaType(),
-			      Bitmap::computePalette(bitmap));
+    return createFromUpload(upload);
+}
+
+std::vector<sk_sp<Bitmap>> HardwareBitmapUploader::allocateHardwareBitmaps(
+        const std::vector<SkBitmap>& sourceBitmaps) {
+    ATRACE_CALL();
+
+    bool usingGL = uirenderer::Properties::getRenderPipelineType() ==
+            uirenderer::RenderPipelineType::SkiaGL;
+
+    std::vector<HardwareBitmapUpload> uploads;
+    std::vector<size_t> indices;
+    uploads.reserve(sourceBitmaps.size());
+    indices.reserve(sourceBitmaps.size());
+    for (size_t i = 0; i < sourceBitmaps.size(); i++) {
+        HardwareBitmapUpload upload;
+        if (prepareUpload(sourceBitmaps[i], usingGL, &upload)) {
+            uploads.push_back(std::move(upload));
+            indices.push_back(i);
+        }
+    }
+
+    std::vector<sk_sp<Bitmap>> bitmaps(sourceBitmaps.size());
+    if (uploads.empty()) {
+        return bitmaps;
+    }
+
+    createUploader(usingGL);
+
+    std::vector<bool> results;
+    sUploader->uploadHardwareBitmaps(uploads, &results);
+    for (size_t i = 0; i < uploads.size(); i++) {
+        if (results[i]) {
+            bitmaps[indices[i]] = createFromUpload(uploads[i]);
+        }
+    }
+    return bitmaps;
+}
+
+struct AsyncUpload {
+    SkBitmap bitmap;
+    std::promise<sk_sp<Bitmap>> result;
+};
+
+static std::mutex sAsyncUploadLock;
+static std::deque<AsyncUpload> sAsyncUploads;
+static bool sAsyncUploadPosted = false;
+
+// Uploads the queued bitmaps in batches until the queue is empty.
+static void uploadQueuedBitmaps() {
+    while (true) {
+        std::deque<AsyncUpload> batch;
+        {
+            std::lock_guard _lock{sAsyncUploadLock};
+            if (sAsyncUploads.empty()) {
+                sAsyncUploadPosted = false;
+                return;
+            }
+            batch.swap(sAsyncUploads);
+        }
+
+        std::vector<SkBitmap> sourceBitmaps;
+        sourceBitmaps.reserve(batch.size());
+        for (const AsyncUpload& upload : batch) {
+            sourceBitmaps.push_back(upload.bitmap);
+        }
+        std::vector<sk_sp<Bitmap>> bitmaps =
+                HardwareBitmapUploader::allocateHardwareBitmaps(sourceBitmaps);
+        for (size_t i = 0; i < batch.size(); i++) {
+            batch[i].result.set_value(std::move(bitmaps[i]));
+        }
+    }
+}
+
+std::future<sk_sp<Bitmap>> HardwareBitmapUploader::allocateHardwareBitmapAsync(
+        const SkBitmap& sourceBitmap) {
+    std::lock_guard _lock{sAsyncUploadLock};
+    sAsyncUploads.push_back(AsyncUpload{sourceBitmap, {}});
+    std::future<sk_sp<Bitmap>> result = sAsyncUploads.back().result.get_future();
+    if (!sAsyncUploadPosted) {
+        sAsyncUploadPosted = true;
+        // Uploads wait on the GPU, so keep them behind any frame work queued on the pool.
+        CommonPool::post(uploadQueuedBitmaps, CommonPool::Priority::Low);
+    }
+    return result;
 }
 
 void HardwareBitmapUploader::initialize() {
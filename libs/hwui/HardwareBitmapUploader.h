@@ -18,6 +18,9 @@
 
 #include <hwui/Bitmap.h>
 
+#include <future>
+#include <vector>
+
 namespace android::uirenderer {
 
 class ANDROID_API HardwareBitmapUploader {
@@ -27,6 +30,16 @@ public:
 
     static sk_sp<Bitmap> allocateHardwareBitmap(const SkBitmap& sourceBitmap);
 
+    // Uploads all of the bitmaps in one pass over the upload thread, waiting on a single fence
+    // for the whole batch. The result at each index is null if that bitmap could not be uploaded.
+    static std::vector<sk_sp<Bitmap>> allocateHardwareBitmaps(
+            const std::vector<SkBitmap>& sourceBitmaps);
+
+    // Queues the bitmap for upload and returns without waiting for it, so that the caller can
+    // decode the next bitmap in the meantime. Bitmaps queued while an upload is in progress are
+    // uploaded together as the next batch. The pixels must not change until the future is ready.
+    static std::future<sk_sp<Bitmap>> allocateHardwareBitmapAsync(const SkBitmap& sourceBitmap);
+
 #ifdef __ANDROID__
     static bool hasFP16Support();
 #else
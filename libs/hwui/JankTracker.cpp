@@ -23,6 +23,8 @@
 #include <statslog.h>
 #include <sys/mman.h>
 
+#include <android/util/ProtoOutputStream.h>
+
 #include <algorithm>
 #include <cmath>
 #include <cstdio>
@@ -79,6 +81,16 @@ static const int64_t EXEMPT_FRAMES_FLAGS = FrameInfoFlags::SurfaceCanvas;
 // and filter it out of the frame profile data
 static FrameInfoIndex sFrameStart = FrameInfoIndex::IntendedVsync;
 
+static const char* FRAME_STAGE_NAMES[] = {"Sync", "Issue draw", "Swap", "GPU", "Functor GPU"};
+// Counter track names, so that the stages of each frame can be seen in a trace
+static const char* FRAME_STAGE_COUNTER_NAMES[] = {"hwui sync us", "hwui issue draw us",
+                                                  "hwui swap us", "hwui gpu us",
+                                                  "hwui functor gpu us"};
+
+// The number of frames recorded in the stage histograms between reports to statsd, about a
+// minute of continuous rendering at 60Hz.
+static const uint32_t kFramesPerStageReport = 3600;
+
 JankTracker::JankTracker(ProfileDataContainer* globalData) {
     mGlobalData = globalData;
     nsecs_t frameIntervalNanos = DeviceInfo::getVsyncPeriod();
@@ -96,6 +108,19 @@ JankTracker::JankTracker(ProfileDataContainer* globalData) {
         mDequeueTimeForgiveness = offsetDelta + 4_ms;
     }
     setFrameInterval(frameIntervalNanos);
+    for (auto& histogram : mStageHistograms) {
+        histogram = std::make_unique<StageHistogram>(Properties::stageHistogramPrecision);
+    }
+}
+
+void JankTracker::recordStage(FrameStage stage, nsecs_t duration) {
+    if (duration < 0 || duration >= IGNORE_EXCEEDING) {
+        return;
+    }
+    mStageHistograms[static_cast<size_t>(stage)]->record(duration);
+    if (CC_UNLIKELY(ATRACE_ENABLED())) {
+        ATRACE_INT64(FRAME_STAGE_COUNTER_NAMES[static_cast<size_t>(stage)], ns2us(duration));
+    }
 }
 
 void JankTracker::setFrameInterval(nsecs_t frameInterval) {
@@ -134,6 +159,17 @@ void JankTracker::finishFrame(const FrameInfo& frame) {
         return;
     }
 
+    recordStage(FrameStage::Sync,
+                frame.duration(FrameInfoIndex::SyncStart, FrameInfoIndex::IssueDrawCommandsStart));
+    recordStage(FrameStage::IssueDraw,
+                frame.duration(FrameInfoIndex::IssueDrawCommandsStart, FrameInfoIndex::SwapBuffers));
+    recordStage(FrameStage::Swap,
+                frame.duration(FrameInfoIndex::SwapBuffers, FrameInfoIndex::FrameCompleted));
+    if (mStageHistograms[static_cast<size_t>(FrameStage::Sync)]->count() >=
+        kFramesPerStageReport) {
+        reportStageHistograms();
+    }
+
     if (totalDuration > mFrameInterval) {
         mData->reportJank();
         (*mGlobalData)->reportJank();
@@ -158,6 +194,7 @@ void JankTracker::finishFrame(const FrameInfo& frame) {
 
     mData->reportJankType(JankType::kMissedDeadline);
     (*mGlobalData)->reportJankType(JankType::kMissedDeadline);
+    mJankyFrames.next() = frame;
 
     // Janked, reset the swap deadline
     nsecs_t jitterNanos = frame[FrameInfoIndex::FrameCompleted] - frame[FrameInfoIndex::Vsync];
@@ -208,6 +245,83 @@ void JankTracker::dumpData(int fd, const ProfileDataDescription* description,
     dprintf(fd, "\n");
 }
 
+void JankTracker::dumpStageHistograms(int fd) {
+    dprintf(fd, "\nStage percentiles (us, %d precision bits):",
+            mStageHistograms[0]->precisionBits());
+    for (size_t i = 0; i < kFrameStageCount; i++) {
+        const StageHistogram& histogram = *mStageHistograms[i];
+        dprintf(fd, "\n%s: frames=%u 50th=%" PRId64 " 90th=%" PRId64 " 95th=%" PRId64
+                " 99th=%" PRId64, FRAME_STAGE_NAMES[i], histogram.count(),
+                histogram.findPercentile(50), histogram.findPercentile(90),
+                histogram.findPercentile(95), histogram.findPercentile(99));
+    }
+    dprintf(fd, "\n");
+}
+
+// Field ids taken from FrameStageHistogram message in atoms.proto
+#define BUCKET_MICROS_FIELD_NUMBER 1
+#define FRAME_COUNTS_FIELD_NUMBER 2
+
+static std::vector<uint8_t> serializeStageHistogram(const StageHistogram& histogram) {
+    android::util::ProtoOutputStream proto;
+    histogram.forEachBucket([&proto](int64_t lowerBoundMicros, uint32_t) {
+        proto.write(android::util::FIELD_TYPE_INT64 | android::util::FIELD_COUNT_REPEATED |
+                            BUCKET_MICROS_FIELD_NUMBER /* field id */,
+                    (long long)lowerBoundMicros);
+    });
+    histogram.forEachBucket([&proto](int64_t, uint32_t count) {
+        proto.write(android::util::FIELD_TYPE_INT64 | android::util::FIELD_COUNT_REPEATED |
+                            FRAME_COUNTS_FIELD_NUMBER /* field id */,
+                    (long long)count);
+    });
+    std::vector<uint8_t> outVector;
+    proto.serializeToVector(&outVector);
+    return outVector;
+}
+
+void JankTracker::reportStageHistograms() {
+    ATRACE_CALL();
+    std::array<std::vector<uint8_t>, kFrameStageCount> histograms;
+    for (size_t i = 0; i < kFrameStageCount; i++) {
+        histograms[i] = serializeStageHistogram(*mStageHistograms[i]);
+    }
+    auto bytes = [&histograms](FrameStage stage) {
+        const std::vector<uint8_t>& histogram = histograms[static_cast<size_t>(stage)];
+        return android::util::BytesField(reinterpret_cast<const char*>(histogram.data()),
+                                histogram.size());
+    };
+    // The atom has no field for the functor stage yet; it is only dumped.
+    android::util::stats_write(android::util::FRAME_STAGE_TIMINGS_REPORTED, getuid(),
+                      mStageHistograms[static_cast<size_t>(FrameStage::Sync)]->count(),
+                      mStageHistograms[0]->precisionBits(), bytes(FrameStage::Sync),
+                      bytes(FrameStage::IssueDraw), bytes(FrameStage::Swap),
+                      bytes(FrameStage::Gpu));
+    for (auto& histogram : mStageHistograms) {
+        histogram->reset();
+    }
+}
+
+void JankTracker::dumpJankyFrames(int fd) {
+    if (mJankyFrames.size() == 0) {
+        return;
+    }
+    dprintf(fd, "\nRecent janky frames (ns):");
+    for (size_t i = 0; i < mJankyFrames.size(); i++) {
+        const FrameInfo& frame = mJankyFrames[i];
+        dprintf(fd, "\nvsync=%" PRId64 " total=%" PRId64 " sync=%" PRId64 " draw=%" PRId64
+                " dequeue=%" PRId64 " queue=%" PRId64 " swap=%" PRId64 " gpu=%" PRId64,
+                frame[FrameInfoIndex::IntendedVsync],
+                frame.duration(sFrameStart, FrameInfoIndex::FrameCompleted),
+                frame.duration(FrameInfoIndex::SyncStart, FrameInfoIndex::IssueDrawCommandsStart),
+                frame.duration(FrameInfoIndex::IssueDrawCommandsStart, FrameInfoIndex::SwapBuffers),
+                frame[FrameInfoIndex::DequeueBufferDuration],
+                frame[FrameInfoIndex::QueueBufferDuration],
+                frame.duration(FrameInfoIndex::SwapBuffers, FrameInfoIndex::FrameCompleted),
+                frame.gpuDrawTime());
+    }
+    dprintf(fd, "\n");
+}
+
 void JankTracker::dumpFrames(int fd) {
     dprintf(fd, "\n\n---PROFILEDATA---\n");
     for (size_t i = 0; i < static_cast<size_t>(FrameInfoIndex::NumIndexes); i++) {
@@ -229,6 +343,10 @@ void JankTracker::dumpFrames(int fd) {
 
 void JankTracker::reset() {
     mFrames.clear();
+    mJankyFrames.clear();
+    for (auto& histogram : mStageHistograms) {
+        histogram->reset();
+    }
     mData->reset();
     (*mGlobalData)->reset();
     sFrameStart = Properties::filterOutTestOverhead ? FrameInfoIndex::HandleInputStart
@@ -238,6 +356,16 @@ void JankTracker::reset() {
 void JankTracker::finishGpuDraw(const FrameInfo& frame) {
     int64_t totalGPUDrawTime = frame.gpuDrawTime();
     if (totalGPUDrawTime >= 0) {
+        recordStage(FrameStage::Gpu, totalGPUDrawTime);
+        // The GPU finishes a few frames after finishFrame() saw the frame, so fill in the copy
+        // if this one janked.
+        for (size_t i = mJankyFrames.size(); i > 0; i--) {
+            FrameInfo& janky = mJankyFrames[i - 1];
+            if (janky[FrameInfoIndex::SyncStart] == frame[FrameInfoIndex::SyncStart]) {
+                janky.set(FrameInfoIndex::GpuCompleted) = frame[FrameInfoIndex::GpuCompleted];
+                break;
+            }
+        }
         mData->reportGPUFrame(totalGPUDrawTime);
         (*mGlobalData)->reportGPUFrame(totalGPUDrawTime);
     }
@@ -19,6 +19,7 @@
 #include "FrameInfo.h"
 #include "ProfileData.h"
 #include "ProfileDataContainer.h"
+#include "StageHistogram.h"
 #include "renderthread/TimeLord.h"
 #include "utils/RingBuffer.h"
 
@@ -39,6 +40,24 @@ enum class JankTrackerType {
     Window,
 };
 
+// The stages of a frame that get their own duration histogram
+enum class FrameStage {
+    // SyncStart to IssueDrawCommandsStart
+    Sync = 0,
+    // IssueDrawCommandsStart to SwapBuffers
+    IssueDraw,
+    // SwapBuffers to FrameCompleted
+    Swap,
+    // SwapBuffers to the GPU completing the frame
+    Gpu,
+    // GPU time that WebView functors reported for their draws
+    Functor,
+};
+static constexpr size_t kFrameStageCount = 5;
+
+// The number of janky frames whose full timings are kept for dumpsys
+static constexpr size_t kJankyFrameHistorySize = 16;
+
 // Metadata about the ProfileData being collected
 struct ProfileDataDescription {
     JankTrackerType type;
@@ -58,21 +77,42 @@ public:
     FrameInfo* startFrame() { return &mFrames.next(); }
     void finishFrame(const FrameInfo& frame);
     void finishGpuDraw(const FrameInfo& frame);
+    void recordFunctorGpuTime(nsecs_t duration) { recordStage(FrameStage::Functor, duration); }
 
-    void dumpStats(int fd) { dumpData(fd, &mDescription, mData.get()); }
+    void dumpStats(int fd) {
+        dumpData(fd, &mDescription, mData.get());
+        dumpStageHistograms(fd);
+        dumpJankyFrames(fd);
+    }
     void dumpFrames(int fd);
     void reset();
 
+    // Returns the given percentile of a stage's duration in microseconds, over the frames since
+    // the last reset or report to statsd
+    int64_t stagePercentile(FrameStage stage, int percentile) const {
+        return mStageHistograms[static_cast<size_t>(stage)]->findPercentile(percentile);
+    }
+
     // Exposed for FrameInfoVisualizer
     // TODO: Figure out a better way to handle this
     RingBuffer<FrameInfo, 120>& frames() { return mFrames; }
 
+    // The most recent frames that missed their deadline, oldest first
+    const RingBuffer<FrameInfo, kJankyFrameHistorySize>& jankyFrames() const {
+        return mJankyFrames;
+    }
+
 private:
     void setFrameInterval(nsecs_t frameIntervalNanos);
 
     static void dumpData(int fd, const ProfileDataDescription* description,
                          const ProfileData* data);
 
+    void recordStage(FrameStage stage, nsecs_t duration);
+    void dumpStageHistograms(int fd);
+    void dumpJankyFrames(int fd);
+    void reportStageHistograms();
+
     std::array<int64_t, NUM_BUCKETS> mThresholds;
     int64_t mFrameInterval;
     nsecs_t mSwapDeadline = -1;
@@ -90,6 +130,14 @@ private:
 
     // Ring buffer large enough for 2 seconds worth of frames
     RingBuffer<FrameInfo, 120> mFrames;
+
+    // Copies of the frames that missed their deadline. mFrames only covers the last 2 seconds,
+    // these are kept until the tracker is reset so that the timings of every phase of a janky
+    // frame are still around when a bug report is taken.
+    RingBuffer<FrameInfo, kJankyFrameHistorySize> mJankyFrames;
+
+    // Duration histograms of each stage of the frames since the last report to statsd
+    std::array<std::unique_ptr<StageHistogram>, kFrameStageCount> mStageHistograms;
 };
 
 } /* namespace uirenderer */
@@ -21,8 +21,11 @@
 #include <errno.h>
 #include <stdlib.h>
 #include <utils/Log.h>
+#include <list>
+#include <mutex>
 #include <sstream>
 #include <string>
+#include <unordered_map>
 #include <vector>
 
 namespace android {
@@ -99,8 +102,100 @@ static void extract(int* outEndPosition, bool* outEndWithNegOrDot, const char* s
     *outEndPosition = currentIndex;
 }
 
-static float parseFloat(PathParser::ParseResult* result, const char* startPtr,
+// Every integer up to 2^24 and every power of ten up to 10^10 is exactly representable as a float.
+static constexpr uint32_t kMaxExactMantissa = 1 << 24;
+static constexpr float kExactPowersOfTen[] = {1e0f, 1e1f, 1e2f, 1e3f, 1e4f, 1e5f,
+                                              1e6f, 1e7f, 1e8f, 1e9f, 1e10f};
+static constexpr int kMaxExactExponent = 10;
+
+/**
+ * Parses a plain decimal number that spans all of [start, end) without going through strtof.
+ * This only succeeds when both the digits and the power of ten are exact floats, as the single
+ * rounding of the final multiply or divide then gives the same result as strtof. Returns false
+ * for anything else, which is left to strtof.
+ */
+static bool parseExactFloat(const char* start, const char* end, float* outValue) {
+    const char* p = start;
+    bool negative = false;
+    if (p < end && (*p == '-' || *p == '+')) {
+        negative = *p == '-';
+        p++;
+    }
+
+    uint64_t mantissa = 0;
+    int exponent = 0;
+    int digits = 0;
+    for (; p < end && *p >= '0' && *p <= '9'; p++, digits++) {
+        mantissa = mantissa * 10 + (*p - '0');
+        if (mantissa > kMaxExactMantissa) {
+            return false;
+        }
+    }
+    if (p < end && *p == '.') {
+        // Trailing zeros of the fraction don't change the value, so they are only applied once
+        // a non-zero digit follows them.
+        int pendingZeros = 0;
+        for (p++; p < end && *p >= '0' && *p <= '9'; p++, digits++) {
+            if (*p == '0') {
+                pendingZeros++;
+                continue;
+            }
+            for (; pendingZeros >= 0; pendingZeros--) {
+                mantissa *= 10;
+                exponent--;
+                if (mantissa > kMaxExactMantissa) {
+                    return false;
+                }
+            }
+            mantissa += *p - '0';
+            pendingZeros = 0;
+        }
+    }
+    if (digits == 0) {
+        return false;
+    }
+
+    if (p < end && (*p == 'e' || *p == 'E')) {
+        p++;
+        bool negativeExponent = false;
+        if (p < end && (*p == '-' || *p == '+')) {
+            negativeExponent = *p == '-';
+            p++;
+        }
+        int value = 0;
+        int exponentDigits = 0;
+        for (; p < end && *p >= '0' && *p <= '9'; p++, exponentDigits++) {
+            value = value * 10 + (*p - '0');
+            if (value > kMaxExactExponent * 2) {
+                return false;
+            }
+        }
+        if (exponentDigits == 0) {
+            return false;
+        }
+        exponent += negativeExponent ? -value : value;
+    }
+    if (p != end || exponent < -kMaxExactExponent || exponent > kMaxExactExponent) {
+        return false;
+    }
+
+    float value = static_cast<float>(mantissa);
+    if (exponent < 0) {
+        value /= kExactPowersOfTen[-exponent];
+    } else {
+        value *= kExactPowersOfTen[exponent];
+    }
+    *outValue = negative ? -value : value;
+    return true;
+}
+
+static float parseFloat(PathParser::ParseResult* result, const char* startPtr, size_t tokenLength,
                         size_t expectedLength) {
+    float exactValue;
+    if (parseExactFloat(startPtr, startPtr + tokenLength, &exactValue)) {
+        return exactValue;
+    }
+
     char* endPtr = NULL;
     float currentValue = strtof(startPtr, &endPtr);
     if ((currentValue == HUGE_VALF || currentValue == -HUGE_VALF) && errno == ERANGE) {
@@ -139,7 +234,8 @@ static void getFloats(std::vector<float>* outPoints, PathParser::ParseResult* re
         extract(&endPosition, &endWithNegOrDot, pathStr, startPosition, end);
 
         if (startPosition < endPosition) {
-            float currentValue = parseFloat(result, &pathStr[startPosition], end - startPosition);
+            float currentValue = parseFloat(result, &pathStr[startPosition],
+                                            endPosition - startPosition, end - startPosition);
             if (result->failureOccurred) {
                 return;
             }
@@ -214,14 +310,79 @@ void PathParser::validateVerbAndPoints(char verb, size_t points, PathParser::Par
                               std::to_string(points) + " float(s) are found. ";
 }
 
-void PathParser::getPathDataFromAsciiString(PathData* data, ParseResult* result,
-                                            const char* pathStr, size_t strLen) {
-    if (pathStr == NULL) {
-        result->failureOccurred = true;
-        result->failureMessage = "Path string cannot be NULL.";
-        return;
+/**
+ * Keeps the data of recently parsed path strings, so that the same string inflated for many
+ * drawables, or parsed again for every run of a path morphing animation, is only parsed once.
+ * Only successful parses are kept.
+ */
+class PathDataCache {
+public:
+    bool get(const std::string& pathString, PathData* outData) {
+        std::lock_guard<std::mutex> lock(mMutex);
+        auto found = mIndex.find(pathString);
+        if (found == mIndex.end()) {
+            return false;
+        }
+        mEntries.splice(mEntries.begin(), mEntries, found->second);
+        const PathData& data = found->second->data;
+        outData->verbs.insert(outData->verbs.end(), data.verbs.begin(), data.verbs.end());
+        outData->verbSizes.insert(outData->verbSizes.end(), data.verbSizes.begin(),
+                                  data.verbSizes.end());
+        outData->points.insert(outData->points.end(), data.points.begin(), data.points.end());
+        return true;
+    }
+
+    void put(const std::string& pathString, const PathData& data) {
+        size_t bytes = pathString.size() + data.verbs.size() * sizeof(char) +
+                       data.verbSizes.size() * sizeof(size_t) + data.points.size() * sizeof(float);
+        if (bytes > kMaxBytes) {
+            return;
+        }
+        std::lock_guard<std::mutex> lock(mMutex);
+        if (mIndex.count(pathString)) {
+            return;
+        }
+        mEntries.push_front({pathString, data, bytes});
+        mIndex.emplace(pathString, mEntries.begin());
+        mBytes += bytes;
+        while (mBytes > kMaxBytes) {
+            Entry& oldest = mEntries.back();
+            mBytes -= oldest.bytes;
+            mIndex.erase(oldest.pathString);
+            mEntries.pop_back();
+        }
+    }
+
+    void clear() {
+        std::lock_guard<std::mutex> lock(mMutex);
+        mIndex.clear();
+        mEntries.clear();
+        mBytes = 0;
     }
 
+private:
+    static constexpr size_t kMaxBytes = 256 * 1024;
+
+    struct Entry {
+        std::string pathString;
+        PathData data;
+        size_t bytes;
+    };
+
+    std::mutex mMutex;
+    size_t mBytes = 0;
+    // Ordered from the most to the least recently used
+    std::list<Entry> mEntries;
+    std::unordered_map<std::string, std::list<Entry>::iterator> mIndex;
+};
+
+static PathDataCache& pathDataCache() {
+    static PathDataCache* sCache = new PathDataCache();
+    return *sCache;
+}
+
+static void parsePathData(PathData* data, PathParser::ParseResult* result, const char* pathStr,
+                          size_t strLen) {
     size_t start = 0;
     // Skip leading spaces.
     while (isspace(pathStr[start]) && start < strLen) {
@@ -265,6 +426,33 @@ void PathParser::getPathDataFromAsciiString(PathData* data, ParseResult* result,
     }
 }
 
+void PathParser::getPathDataFromAsciiString(PathData* data, ParseResult* result,
+                                            const char* pathStr, size_t strLen) {
+    if (pathStr == NULL) {
+        result->failureOccurred = true;
+        result->failureMessage = "Path string cannot be NULL.";
+        return;
+    }
+
+    std::string pathString(pathStr, strLen);
+    if (pathDataCache().get(pathString, data)) {
+        return;
+    }
+    PathData parsedData;
+    parsePathData(&parsedData, result, pathStr, strLen);
+    if (!result->failureOccurred) {
+        pathDataCache().put(pathString, parsedData);
+    }
+    data->verbs.insert(data->verbs.end(), parsedData.verbs.begin(), parsedData.verbs.end());
+    data->verbSizes.insert(data->verbSizes.end(), parsedData.verbSizes.begin(),
+                           parsedData.verbSizes.end());
+    data->points.insert(data->points.end(), parsedData.points.begin(), parsedData.points.end());
+}
+
+void PathParser::clearPathDataCache() {
+    pathDataCache().clear();
+}
+
 void PathParser::dump(const PathData& data) {
     // Print out the path data.
     size_t start = 0;
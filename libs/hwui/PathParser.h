@@ -40,8 +40,16 @@ public:
      */
     ANDROID_API static void parseAsciiStringForSkPath(SkPath* outPath, ParseResult* result,
                                                       const char* pathStr, size_t strLength);
+    /**
+     * Parse the string literal and append its verbs and points to outData. The data of recently
+     * parsed strings is cached, so parsing the same string again is cheap.
+     */
     ANDROID_API static void getPathDataFromAsciiString(PathData* outData, ParseResult* result,
                                                        const char* pathStr, size_t strLength);
+    /**
+     * Drop the data cached by getPathDataFromAsciiString.
+     */
+    ANDROID_API static void clearPathDataCache();
     static void dump(const PathData& data);
     static void validateVerbAndPoints(char verb, size_t points, ParseResult* result);
 };
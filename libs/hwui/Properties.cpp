@@ -48,6 +48,7 @@ bool Properties::showDirtyRegions = false;
 bool Properties::skipEmptyFrames = true;
 bool Properties::useBufferAge = true;
 bool Properties::enablePartialUpdates = true;
+int Properties::partialUpdateMaxAreaPercent = 75;
 
 DebugLevel Properties::debugLevel = kDebugDisabled;
 OverdrawColorSet Properties::overdrawColorSet = OverdrawColorSet::Default;
@@ -71,6 +72,15 @@ bool Properties::filterOutTestOverhead = false;
 bool Properties::disableVsync = false;
 bool Properties::skpCaptureEnabled = false;
 bool Properties::enableRTAnimations = true;
+bool Properties::parallelPrepareTree = false;
+bool Properties::elideDisplayListNoOps = false;
+bool Properties::precompileShaders = false;
+bool Properties::drawLate = false;
+int Properties::stageHistogramPrecision = 3;
+bool Properties::shareVectorDrawableRasters = false;
+int Properties::animatedImageDecodeAhead = 1;
+int Properties::cacheMaxRamPercent = 0;
+bool Properties::poolLayerSurfaces = false;
 
 bool Properties::runningInEmulator = false;
 bool Properties::debuggingEnabled = false;
@@ -116,6 +126,8 @@ bool Properties::load() {
     skipEmptyFrames = base::GetBoolProperty(PROPERTY_SKIP_EMPTY_DAMAGE, true);
     useBufferAge = base::GetBoolProperty(PROPERTY_USE_BUFFER_AGE, true);
     enablePartialUpdates = base::GetBoolProperty(PROPERTY_ENABLE_PARTIAL_UPDATES, true);
+    partialUpdateMaxAreaPercent = std::max(
+            0, std::min(100, base::GetIntProperty(PROPERTY_PARTIAL_UPDATE_MAX_AREA, 75)));
 
     filterOutTestOverhead = base::GetBoolProperty(PROPERTY_FILTER_TEST_OVERHEAD, false);
 
@@ -126,6 +138,19 @@ bool Properties::load() {
 
     runningInEmulator = base::GetBoolProperty(PROPERTY_QEMU_KERNEL, false);
 
+    parallelPrepareTree = base::GetBoolProperty(PROPERTY_PARALLEL_PREPARE_TREE, false);
+    elideDisplayListNoOps = base::GetBoolProperty(PROPERTY_ELIDE_DISPLAY_LIST_NO_OPS, false);
+    precompileShaders = base::GetBoolProperty(PROPERTY_PRECOMPILE_SHADERS, false);
+    drawLate = base::GetBoolProperty(PROPERTY_DRAW_LATE, false);
+    stageHistogramPrecision = base::GetIntProperty(PROPERTY_STAGE_HISTOGRAM_PRECISION, 3);
+    shareVectorDrawableRasters =
+            base::GetBoolProperty(PROPERTY_SHARE_VECTOR_DRAWABLE_RASTERS, false);
+    animatedImageDecodeAhead = std::max(
+            1, std::min(8, base::GetIntProperty(PROPERTY_ANIMATED_IMAGE_DECODE_AHEAD, 1)));
+    cacheMaxRamPercent = std::max(
+            0, std::min(100, base::GetIntProperty(PROPERTY_CACHE_MAX_RAM_PERCENT, 0)));
+    poolLayerSurfaces = base::GetBoolProperty(PROPERTY_POOL_LAYER_SURFACES, false);
+
     defaultRenderAhead = std::max(-1, std::min(2, base::GetIntProperty(PROPERTY_RENDERAHEAD,
             render_ahead().value_or(0))));
 
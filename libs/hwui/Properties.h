@@ -123,6 +123,13 @@ enum DebugLevel {
  */
 #define PROPERTY_ENABLE_PARTIAL_UPDATES "debug.hwui.use_partial_updates"
 
+/**
+ * Largest area, as a percentage of the surface, that a partial update may repaint. Frames whose
+ * damage, once unioned with the history needed for the buffer's age, covers more than this are
+ * redrawn in full instead. Accepted values are 0 to 100. Default is 75.
+ */
+#define PROPERTY_PARTIAL_UPDATE_MAX_AREA "debug.hwui.partial_update_max_area"
+
 #define PROPERTY_FILTER_TEST_OVERHEAD "debug.hwui.filter_test_overhead"
 
 /**
@@ -164,6 +171,73 @@ enum DebugLevel {
 
 #define PROPERTY_RENDERAHEAD "debug.hwui.render_ahead"
 
+/**
+ * Allows independent RenderNode subtrees to be synced on CommonPool workers during prepareTree.
+ * Accepted values are "true" and "false". Default is false.
+ */
+#define PROPERTY_PARALLEL_PREPARE_TREE "debug.hwui.parallel_prepare_tree"
+
+/**
+ * Allows ops that cannot affect the output to be skipped when a display list is synced.
+ * Accepted values are "true" and "false". Default is false.
+ */
+#define PROPERTY_ELIDE_DISPLAY_LIST_NO_OPS "debug.hwui.elide_no_ops"
+
+/**
+ * Compiles the shaders used most often in previous runs as soon as the GPU context is created,
+ * instead of when a frame first needs them.
+ * Accepted values are "true" and "false". Default is false.
+ */
+#define PROPERTY_PRECOMPILE_SHADERS "debug.hwui.precompile_shaders"
+
+/**
+ * Defers drawing a synced frame to the latest point that still meets the vsync deadline, so
+ * that a sync arriving in the meantime replaces it. Lowers latency for apps that sync more
+ * than once per vsync.
+ * Accepted values are "true" and "false". Default is false.
+ */
+#define PROPERTY_DRAW_LATE "debug.hwui.draw_late"
+
+/**
+ * Number of bits of resolution of the per-stage frame time histograms: every power of two of
+ * durations is split into 2^n buckets. Accepted values are 1 to 7. Default is 3.
+ */
+#define PROPERTY_STAGE_HISTOGRAM_PRECISION "debug.hwui.stage_histogram_precision"
+
+/**
+ * Lets vector drawables with identical contents, drawn at the same size, share one raster
+ * instead of each rasterizing their own.
+ * Accepted values are "true" and "false". Default is false.
+ */
+#define PROPERTY_SHARE_VECTOR_DRAWABLE_RASTERS "debug.hwui.share_vector_drawable_rasters"
+
+/**
+ * Number of frames of an animated image that are decoded ahead of the one on screen. Frames past
+ * the first are copied into their own bitmap. Accepted values are 1 to 8. Default is 1.
+ */
+#define PROPERTY_ANIMATED_IMAGE_DECODE_AHEAD "debug.hwui.animated_image_decode_ahead"
+
+/**
+ * Upper bound on the GPU resource cache, as a percentage of the device's physical memory. The
+ * cache is sized from the screen resolution, which on low memory devices with large screens can
+ * hold on to more memory than the device can spare. Accepted values are 0 to 100, where 0 leaves
+ * the cache sized from the screen alone. Default is 0.
+ */
+#define PROPERTY_CACHE_MAX_RAM_PERCENT "debug.hwui.cache_max_ram_percent"
+
+/**
+ * Whether the surfaces of destroyed or resized hardware layers are kept for reuse by the next
+ * layer of the same size. Accepted values are "true" and "false". Default is false.
+ */
+#define PROPERTY_POOL_LAYER_SURFACES "debug.hwui.pool_layer_surfaces"
+
+/**
+ * Size, in kilobytes, of the per-process pool of freed heap bitmap pixel buffers that new heap
+ * bitmaps (from BitmapFactory, ImageDecoder and friends) are allocated from. Only large buffers
+ * are pooled. Default is 0, which disables the pool.
+ */
+#define PROPERTY_BITMAP_POOL_SIZE_KB "debug.hwui.bitmap_pool_size_kb"
+
 ///////////////////////////////////////////////////////////////////////////////
 // Misc
 ///////////////////////////////////////////////////////////////////////////////
@@ -195,6 +269,7 @@ public:
     static bool skipEmptyFrames;
     static bool useBufferAge;
     static bool enablePartialUpdates;
+    static int partialUpdateMaxAreaPercent;
 
     // TODO: Move somewhere else?
     static constexpr float textGamma = 1.45f;
@@ -237,6 +312,16 @@ public:
     // For experimentation b/68769804
     ANDROID_API static bool enableRTAnimations;
 
+    static bool parallelPrepareTree;
+    static bool elideDisplayListNoOps;
+    static bool precompileShaders;
+    static bool drawLate;
+    static int stageHistogramPrecision;
+    static bool shareVectorDrawableRasters;
+    static int animatedImageDecodeAhead;
+    static int cacheMaxRamPercent;
+    static bool poolLayerSurfaces;
+
     // Used for testing only to change the render pipeline.
     static void overrideRenderPipelineType(RenderPipelineType);
 
@@ -16,6 +16,7 @@
 
 #include "Readback.h"
 
+#include <SkSurface.h>
 #include <sync/sync.h>
 #include <system/window.h>
 #include <ui/GraphicBuffer.h>
@@ -35,16 +36,15 @@ using namespace android::uirenderer::renderthread;
 namespace android {
 namespace uirenderer {
 
-CopyResult Readback::copySurfaceInto(ANativeWindow* window, const Rect& srcRect, SkBitmap* bitmap) {
-    ATRACE_CALL();
-    // Setup the source
+// Grabs the last buffer queued to the window, once its fence has signaled.
+static CopyResult getLastQueuedImage(ANativeWindow* window, Matrix4* texTransform,
+                                     sk_sp<SkImage>* outImage) {
     AHardwareBuffer* rawSourceBuffer;
     int rawSourceFence;
-    Matrix4 texTransform;
     status_t err = ANativeWindow_getLastQueuedBuffer(window, &rawSourceBuffer, &rawSourceFence,
-                                                     texTransform.data);
+                                                     texTransform->data);
     base::unique_fd sourceFence(rawSourceFence);
-    texTransform.invalidateType();
+    texTransform->invalidateType();
     if (err != NO_ERROR) {
         ALOGW("Failed to get last queued buffer, error = %d", err);
         return CopyResult::UnknownError;
@@ -70,11 +70,84 @@ CopyResult Readback::copySurfaceInto(ANativeWindow* window, const Rect& srcRect,
 
     sk_sp<SkColorSpace> colorSpace = DataSpaceToColorSpace(
             static_cast<android_dataspace>(ANativeWindow_getBuffersDataSpace(window)));
-    sk_sp<SkImage> image =
+    *outImage =
             SkImage::MakeFromAHardwareBuffer(sourceBuffer.get(), kPremul_SkAlphaType, colorSpace);
+    return CopyResult::Success;
+}
+
+CopyResult Readback::copySurfaceInto(ANativeWindow* window, const Rect& srcRect, SkBitmap* bitmap) {
+    ATRACE_CALL();
+    // Setup the source
+    Matrix4 texTransform;
+    sk_sp<SkImage> image;
+    CopyResult result = getLastQueuedImage(window, &texTransform, &image);
+    if (result != CopyResult::Success) {
+        return result;
+    }
     return copyImageInto(image, texTransform, srcRect, bitmap);
 }
 
+CopyResult Readback::copySurfaceIntoBuffer(ANativeWindow* window, const Rect& srcRect,
+                                           AHardwareBuffer* buffer, int* outFence) {
+    ATRACE_CALL();
+    *outFence = -1;
+    const bool isGl = Properties::getRenderPipelineType() == RenderPipelineType::SkiaGL;
+    if (isGl) {
+        mRenderThread.requireGlContext();
+    } else {
+        mRenderThread.requireVkContext();
+    }
+    GrContext* grContext = mRenderThread.getGrContext();
+    if (!grContext) {
+        return CopyResult::UnknownError;
+    }
+
+    // Unlike the bitmap copies the destination is drawn into directly, so only the requested
+    // region is ever rendered and nothing has to be read back to the CPU.
+    sk_sp<SkSurface> destSurface = SkSurface::MakeFromAHardwareBuffer(
+            grContext, buffer, kTopLeft_GrSurfaceOrigin, SkColorSpace::MakeSRGB(), nullptr);
+    if (!destSurface) {
+        ALOGW("Unable to wrap the destination buffer for rendering");
+        return CopyResult::DestinationInvalid;
+    }
+
+    Matrix4 texTransform;
+    sk_sp<SkImage> image;
+    CopyResult result = getLastQueuedImage(window, &texTransform, &image);
+    if (result != CopyResult::Success) {
+        return result;
+    }
+    if (!image.get()) {
+        return CopyResult::UnknownError;
+    }
+
+    Layer layer(mRenderThread.renderState(), nullptr, 255, SkBlendMode::kSrc);
+    SkRect skiaSrcRect;
+    if (!setupLayerForImage(&layer, image, texTransform, srcRect, &skiaSrcRect)) {
+        return CopyResult::UnknownError;
+    }
+    const SkRect skiaDestRect = SkRect::MakeIWH(destSurface->width(), destSurface->height());
+    if (!skiapipeline::LayerDrawable::DrawLayer(grContext, destSurface->getCanvas(), &layer,
+                                                &skiaSrcRect, &skiaDestRect, false)) {
+        ALOGW("Unable to draw content from GPU into the provided buffer");
+        return CopyResult::UnknownError;
+    }
+
+    status_t err;
+    if (isGl) {
+        grContext->flush();
+        EGLSyncKHR eglFence = EGL_NO_SYNC_KHR;
+        err = mRenderThread.eglManager().createReleaseFence(false, &eglFence, outFence);
+    } else {
+        err = mRenderThread.vulkanManager().createReleaseFence(outFence, grContext);
+    }
+    if (err != OK || *outFence == -1) {
+        // Without a native fence there is nothing to hand back, so finish the copy here instead.
+        grContext->flush(kSyncCpu_GrFlushFlag, 0, nullptr);
+    }
+    return CopyResult::Success;
+}
+
 CopyResult Readback::copyHWBitmapInto(Bitmap* hwBitmap, SkBitmap* bitmap) {
     LOG_ALWAYS_FATAL_IF(!hwBitmap->isHardware());
 
@@ -117,8 +190,6 @@ CopyResult Readback::copyImageInto(const sk_sp<SkImage>& image, Matrix4& texTran
     if (!image.get()) {
         return CopyResult::UnknownError;
     }
-    int imgWidth = image->width();
-    int imgHeight = image->height();
     sk_sp<GrContext> grContext = sk_ref_sp(mRenderThread.getGrContext());
 
     if (bitmap->colorType() == kRGBA_F16_SkColorType &&
@@ -129,26 +200,12 @@ CopyResult Readback::copyImageInto(const sk_sp<SkImage>& image, Matrix4& texTran
 
     CopyResult copyResult = CopyResult::UnknownError;
 
-    int displayedWidth = imgWidth, displayedHeight = imgHeight;
-    // If this is a 90 or 270 degree rotation we need to swap width/height to get the device
-    // size.
-    if (texTransform[Matrix4::kSkewX] >= 0.5f || texTransform[Matrix4::kSkewX] <= -0.5f) {
-        std::swap(displayedWidth, displayedHeight);
-    }
-    SkRect skiaDestRect = SkRect::MakeWH(bitmap->width(), bitmap->height());
-    SkRect skiaSrcRect = srcRect.toSkRect();
-    if (skiaSrcRect.isEmpty()) {
-        skiaSrcRect = SkRect::MakeIWH(displayedWidth, displayedHeight);
-    }
-    bool srcNotEmpty = skiaSrcRect.intersect(SkRect::MakeIWH(displayedWidth, displayedHeight));
-    if (!srcNotEmpty) {
+    Layer layer(mRenderThread.renderState(), nullptr, 255, SkBlendMode::kSrc);
+    SkRect skiaSrcRect;
+    if (!setupLayerForImage(&layer, image, texTransform, srcRect, &skiaSrcRect)) {
         return copyResult;
     }
-
-    Layer layer(mRenderThread.renderState(), nullptr, 255, SkBlendMode::kSrc);
-    layer.setSize(displayedWidth, displayedHeight);
-    texTransform.copyTo(layer.getTexTransform());
-    layer.setImage(image);
+    SkRect skiaDestRect = SkRect::MakeWH(bitmap->width(), bitmap->height());
     // Scaling filter is not explicitly set here, because it is done inside copyLayerInfo
     // after checking the necessity based on the src/dest rect size and the transformation.
     if (copyLayerInto(&layer, &skiaSrcRect, &skiaDestRect, bitmap)) {
@@ -158,6 +215,29 @@ CopyResult Readback::copyImageInto(const sk_sp<SkImage>& image, Matrix4& texTran
     return copyResult;
 }
 
+bool Readback::setupLayerForImage(Layer* layer, const sk_sp<SkImage>& image,
+                                  Matrix4& texTransform, const Rect& srcRect,
+                                  SkRect* outSrcRect) {
+    int displayedWidth = image->width(), displayedHeight = image->height();
+    // If this is a 90 or 270 degree rotation we need to swap width/height to get the device
+    // size.
+    if (texTransform[Matrix4::kSkewX] >= 0.5f || texTransform[Matrix4::kSkewX] <= -0.5f) {
+        std::swap(displayedWidth, displayedHeight);
+    }
+    *outSrcRect = srcRect.toSkRect();
+    if (outSrcRect->isEmpty()) {
+        *outSrcRect = SkRect::MakeIWH(displayedWidth, displayedHeight);
+    }
+    if (!outSrcRect->intersect(SkRect::MakeIWH(displayedWidth, displayedHeight))) {
+        return false;
+    }
+
+    layer->setSize(displayedWidth, displayedHeight);
+    texTransform.copyTo(layer->getTexTransform());
+    layer->setImage(image);
+    return true;
+}
+
 bool Readback::copyLayerInto(Layer* layer, const SkRect* srcRect, const SkRect* dstRect,
                              SkBitmap* bitmap) {
     /* This intermediate surface is present to work around a bug in SwiftShader that
@@ -49,11 +49,23 @@ public:
      */
     CopyResult copySurfaceInto(ANativeWindow* window, const Rect& srcRect, SkBitmap* bitmap);
 
+    /**
+     * Copies srcRect of the surface's most recently queued buffer into the provided buffer,
+     * scaling it to fill the buffer. This does not wait for the GPU to finish the copy, instead
+     * outFence is set to a fence that signals once the buffer has been written, or -1 if the copy
+     * has already completed.
+     */
+    CopyResult copySurfaceIntoBuffer(ANativeWindow* window, const Rect& srcRect,
+                                     AHardwareBuffer* buffer, int* outFence);
+
     CopyResult copyHWBitmapInto(Bitmap* hwBitmap, SkBitmap* bitmap);
 
     CopyResult copyLayerInto(DeferredLayerUpdater* layer, SkBitmap* bitmap);
 
 private:
+    bool setupLayerForImage(Layer* layer, const sk_sp<SkImage>& image, Matrix4& texTransform,
+                            const Rect& srcRect, SkRect* outSrcRect);
+
     CopyResult copyImageInto(const sk_sp<SkImage>& image, Matrix4& texTransform,
                              const Rect& srcRect, SkBitmap* bitmap);
 
@@ -35,6 +35,7 @@
 #include "SkVertices.h"
 
 #include <experimental/type_traits>
+#include <vector>
 
 namespace android {
 namespace uirenderer {
@@ -75,7 +76,8 @@ enum class Type : uint8_t {
 #undef X
 
 struct Op {
-    uint32_t type : 8;
+    uint32_t type : 7;
+    uint32_t elided : 1;
     uint32_t skip : 24;
 };
 static_assert(sizeof(Op) == 4, "");
@@ -536,7 +538,9 @@ void* DisplayListData::push(size_t pod, Args&&... args) {
     fUsed += skip;
     new (op) T{std::forward<Args>(args)...};
     op->type = (uint32_t)T::kType;
+    op->elided = 0;
     op->skip = skip;
+    mOpCount++;
     return op + 1;
 }
 
@@ -720,7 +724,9 @@ typedef void (*color_transform_fn)(const void*, ColorTransform);
 // All ops implement draw().
 #define X(T)                                                    \
     [](const void* op, SkCanvas* c, const SkMatrix& original) { \
-        ((const T*)op)->draw(c, original);                      \
+        if (!((const Op*)op)->elided) {                         \
+            ((const T*)op)->draw(c, original);                  \
+        }                                                       \
     },
 static const draw_fn draw_fns[] = {
 #include "DisplayListOps.in"
@@ -743,14 +749,191 @@ void DisplayListData::draw(SkCanvas* canvas) const {
 }
 
 DisplayListData::~DisplayListData() {
-    this->reset();
+    this->map(dtor_fns);
 }
 
 void DisplayListData::reset() {
     this->map(dtor_fns);
 
-    // Leave fBytes and fReserved alone.
+    // Keep fBytes for the next recording, unless it has grown far beyond what the last one
+    // needed.
+    if (fReserved > SKLITEDL_PAGE && fUsed < fReserved / 4) {
+        fReserved = (fUsed + SKLITEDL_PAGE) & ~(SKLITEDL_PAGE - 1);
+        fBytes.realloc(fReserved);
+    }
     fUsed = 0;
+    mOpCount = 0;
+    mElidedOpCount = 0;
+}
+
+// Whether an empty clip guarantees that the op draws nothing. Layers, drawables and functors
+// are always kept, as they may draw outside of the clip or have side effects.
+static bool isClippable(Type type) {
+    switch (type) {
+        case Type::DrawPaint:
+        case Type::DrawPath:
+        case Type::DrawRect:
+        case Type::DrawRegion:
+        case Type::DrawOval:
+        case Type::DrawArc:
+        case Type::DrawRRect:
+        case Type::DrawDRRect:
+        case Type::DrawPicture:
+        case Type::DrawImage:
+        case Type::DrawImageNine:
+        case Type::DrawImageRect:
+        case Type::DrawImageLattice:
+        case Type::DrawTextBlob:
+        case Type::DrawPatch:
+        case Type::DrawPoints:
+        case Type::DrawVertices:
+        case Type::DrawAtlas:
+        case Type::DrawShadowRec:
+            return true;
+        default:
+            return false;
+    }
+}
+
+// Returns the paint of ops whose output is fully determined by it, so that a paint that draws
+// nothing means the op draws nothing. Ops that blend their own colors are not included.
+static const SkPaint* opaquePaint(const Op* op) {
+    switch ((Type)op->type) {
+#define PAINT_OF(T)  \
+    case Type::T:    \
+        return &((const T*)op)->paint;
+        PAINT_OF(DrawPaint)
+        PAINT_OF(DrawPath)
+        PAINT_OF(DrawRect)
+        PAINT_OF(DrawRegion)
+        PAINT_OF(DrawOval)
+        PAINT_OF(DrawArc)
+        PAINT_OF(DrawRRect)
+        PAINT_OF(DrawDRRect)
+        PAINT_OF(DrawImage)
+        PAINT_OF(DrawImageNine)
+        PAINT_OF(DrawImageRect)
+        PAINT_OF(DrawImageLattice)
+        PAINT_OF(DrawTextBlob)
+        PAINT_OF(DrawPoints)
+#undef PAINT_OF
+        default:
+            return nullptr;
+    }
+}
+
+// Returns true if the clip op leaves nothing to draw into.
+static bool clipsOutEverything(const Op* op) {
+    switch ((Type)op->type) {
+        case Type::ClipRect: {
+            auto clip = (const ClipRect*)op;
+            return clip->op == SkClipOp::kIntersect && clip->rect.isEmpty();
+        }
+        case Type::ClipRRect: {
+            auto clip = (const ClipRRect*)op;
+            return clip->op == SkClipOp::kIntersect && clip->rrect.isEmpty();
+        }
+        case Type::ClipPath: {
+            auto clip = (const ClipPath*)op;
+            return clip->op == SkClipOp::kIntersect && clip->path.isEmpty() &&
+                   !clip->path.isInverseFillType();
+        }
+        case Type::ClipRegion: {
+            auto clip = (const ClipRegion*)op;
+            return clip->op == SkClipOp::kIntersect && clip->region.isEmpty();
+        }
+        default:
+            return false;
+    }
+}
+
+static SkClipOp clipOpOf(const Op* op) {
+    switch ((Type)op->type) {
+        case Type::ClipRect:
+            return ((const ClipRect*)op)->op;
+        case Type::ClipRRect:
+            return ((const ClipRRect*)op)->op;
+        case Type::ClipPath:
+            return ((const ClipPath*)op)->op;
+        default:
+            return ((const ClipRegion*)op)->op;
+    }
+}
+
+void DisplayListData::elideNoOps() {
+    struct SaveState {
+        Op* save;
+        bool isLayer;
+        bool hasDraws;
+        bool clippedOut;
+    };
+    // The bottom entry stands for the canvas state the list is drawn with.
+    std::vector<SaveState> saves{{nullptr, true, false, false}};
+
+    auto elide = [this](Op* op) {
+        if (!op->elided) {
+            op->elided = 1;
+            mElidedOpCount++;
+        }
+    };
+
+    uint8_t* end = fBytes.get() + fUsed;
+    for (uint8_t* ptr = fBytes.get(); ptr < end; ptr += ((Op*)ptr)->skip) {
+        Op* op = (Op*)ptr;
+        Type type = (Type)op->type;
+        switch (type) {
+            case Type::Save:
+            case Type::SaveLayer:
+            case Type::SaveBehind:
+                saves.push_back({op, type != Type::Save, false, saves.back().clippedOut});
+                break;
+            case Type::Restore: {
+                if (saves.size() == 1) {
+                    break;
+                }
+                SaveState state = saves.back();
+                saves.pop_back();
+                if (state.isLayer || state.hasDraws) {
+                    saves.back().hasDraws = true;
+                    break;
+                }
+                // Nothing was drawn, so the save, its state changes and the restore can go.
+                for (uint8_t* skipped = (uint8_t*)state.save; skipped <= ptr;
+                     skipped += ((Op*)skipped)->skip) {
+                    elide((Op*)skipped);
+                }
+                break;
+            }
+            case Type::ClipPath:
+            case Type::ClipRect:
+            case Type::ClipRRect:
+            case Type::ClipRegion:
+                if (clipsOutEverything(op)) {
+                    saves.back().clippedOut = true;
+                } else if (clipOpOf(op) != SkClipOp::kIntersect &&
+                           clipOpOf(op) != SkClipOp::kDifference) {
+                    // Expanding clip ops may bring back area that was clipped out.
+                    saves.back().clippedOut = false;
+                }
+                break;
+            case Type::Concat44:
+            case Type::Concat:
+            case Type::SetMatrix:
+            case Type::Scale:
+            case Type::Translate:
+                break;
+            default: {
+                const SkPaint* paint = opaquePaint(op);
+                if ((isClippable(type) && saves.back().clippedOut) ||
+                    (paint && paint->nothingToDraw())) {
+                    elide(op);
+                } else {
+                    saves.back().hasDraws = true;
+                }
+                break;
+            }
+        }
+    }
 }
 
 template <class T>
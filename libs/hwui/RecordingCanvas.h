@@ -67,9 +67,16 @@ public:
 
     void applyColorTransform(ColorTransform transform);
 
+    // Marks the ops that cannot affect what is drawn so that draw() skips them: save/restore
+    // pairs with nothing drawn in between, draws under an empty clip and draws whose paint
+    // draws nothing. The skipped ops keep their resources until reset().
+    void elideNoOps();
+
     bool hasText() const { return mHasText; }
     size_t usedSize() const { return fUsed; }
     size_t allocatedSize() const { return fReserved; }
+    int opCount() const { return mOpCount; }
+    int elidedOpCount() const { return mElidedOpCount; }
 
 private:
     friend class RecordingCanvas;
@@ -137,6 +144,8 @@ private:
     SkAutoTMalloc<uint8_t> fBytes;
     size_t fUsed = 0;
     size_t fReserved = 0;
+    int mOpCount = 0;
+    int mElidedOpCount = 0;
 
     bool mHasText : 1;
 };
@@ -186,7 +186,7 @@ void RenderNode::pushLayerUpdate(TreeInfo& info) {
         CC_UNLIKELY(properties().getWidth() == 0) || CC_UNLIKELY(properties().getHeight() == 0) ||
         CC_UNLIKELY(!properties().fitsOnLayer())) {
         if (CC_UNLIKELY(hasLayer())) {
-            this->setLayerSurface(nullptr);
+            info.canvasContext.destroyLayer(this);
         }
         return;
     }
@@ -210,6 +210,66 @@ void RenderNode::pushLayerUpdate(TreeInfo& info) {
 #endif
 }
 
+static bool hasSameChildren(const DisplayList* a, const DisplayList* b) {
+    const size_t count = a ? a->mChildNodes.size() : 0;
+    if (count != (b ? b->mChildNodes.size() : 0)) {
+        return false;
+    }
+    for (size_t i = 0; i < count; i++) {
+        const RenderNode* child = a->mChildNodes[i].getRenderNode();
+        if (child == b->mChildNodes[i].getRenderNode()) {
+            continue;
+        }
+        if (std::none_of(b->mChildNodes.begin(), b->mChildNodes.end(),
+                         [child](const auto& other) { return other.getRenderNode() == child; })) {
+            return false;
+        }
+    }
+    return true;
+}
+
+int RenderNode::parallelPrepareSubtreeSize() const {
+    // A node with several parents may be reached from more than one subtree.
+    if (mParentCount != 1) {
+        return -1;
+    }
+
+    // Layers, position listeners and animators all call into the CanvasContext or back to the
+    // UI thread, and backward projection damages a receiver outside of the subtree.
+    const RenderProperties& props = mDirtyPropertyFields ? mStagingProperties : mProperties;
+    if (hasLayer() || props.effectiveLayerType() == LayerType::RenderLayer ||
+        props.getProjectBackwards() || mPositionListener.get() || mPositionListenerDirty ||
+        mAnimatorManager.hasAnimators() || mAnimatorManager.hasNewAnimators()) {
+        return -1;
+    }
+
+    if (mNeedsDisplayListSync) {
+        // Adding or removing children changes the parent count of nodes that may be in another
+        // subtree, and may destroy them.
+        if (!hasSameChildren(mStagingDisplayList, mDisplayList) ||
+            (mDisplayList && mDisplayList->hasRenderThreadContent())) {
+            return -1;
+        }
+    }
+
+    const DisplayList* displayList = mNeedsDisplayListSync ? mStagingDisplayList : mDisplayList;
+    if (!displayList) {
+        return 1;
+    }
+    if (displayList->hasRenderThreadContent()) {
+        return -1;
+    }
+    int size = 1;
+    for (const auto& child : displayList->mChildNodes) {
+        int childSize = child.getRenderNode()->parallelPrepareSubtreeSize();
+        if (childSize < 0) {
+            return -1;
+        }
+        size += childSize;
+    }
+    return size;
+}
+
 /**
  * Traverse down the the draw tree to prepare for a frame.
  *
@@ -323,7 +383,7 @@ void RenderNode::syncDisplayList(TreeObserver& observer, TreeInfo* info) {
         WebViewSyncData syncData {
             .applyForceDark = info && !info->disableForceDark
         };
-        mDisplayList->syncContents(syncData);
+        mDisplayList->syncContents(syncData, info ? info->pendingFunctorSyncs : nullptr);
         handleForceDark(info);
     }
 }
@@ -380,7 +440,9 @@ void RenderNode::deleteDisplayList(TreeObserver& observer, TreeInfo* info) {
     if (mDisplayList) {
         mDisplayList->updateChildren(
                 [&observer, info](RenderNode* child) { child->decParentRefCount(observer, info); });
-        if (!mDisplayList->reuseDisplayList(this, info ? &info->canvasContext : nullptr)) {
+        if (info && info->retiredDisplayLists) {
+            info->retiredDisplayLists->emplace_back(this, mDisplayList);
+        } else if (!mDisplayList->reuseDisplayList(this, info ? &info->canvasContext : nullptr)) {
             delete mDisplayList;
         }
     }
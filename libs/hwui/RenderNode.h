@@ -199,6 +199,11 @@ public:
     // on the UI thread.
     ANDROID_API bool hasParents() { return mParentCount; }
 
+    // Returns the number of nodes in this subtree if a MODE_FULL prepareTree of it touches
+    // nothing outside of the subtree, so that it can run on a worker thread. Returns -1 if
+    // anything in it needs the RenderThread or may be shared with another subtree.
+    int parallelPrepareSubtreeSize() const;
+
     void onRemovedFromTree(TreeInfo* info);
 
     // Called by CanvasContext to promote a RenderNode to be a root node
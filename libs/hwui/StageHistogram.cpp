@@ -0,0 +1,85 @@
+/*
+ * Copyright (C) 2020 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "StageHistogram.h"
+
+#include <algorithm>
+
+namespace android {
+namespace uirenderer {
+
+StageHistogram::StageHistogram(int precisionBits)
+        : mPrecisionBits(std::clamp(precisionBits, kMinPrecisionBits, kMaxPrecisionBits)) {
+    mBuckets.resize(bucketIndexForMicros(kMaxMicros) + 1);
+}
+
+// This will be called for every stage of every frame, keep it cheap
+size_t StageHistogram::bucketIndexForMicros(int64_t micros) const {
+    const uint64_t value = static_cast<uint64_t>(std::clamp<int64_t>(micros, 0, kMaxMicros));
+    const uint64_t subBuckets = 1u << mPrecisionBits;
+    if (value < subBuckets) {
+        return value;
+    }
+    // The leading bit selects the power of two, the next mPrecisionBits bits the bucket in it.
+    const int shift = (63 - __builtin_clzll(value)) - mPrecisionBits;
+    return (shift + 1) * subBuckets + ((value >> shift) - subBuckets);
+}
+
+int64_t StageHistogram::lowerBoundMicrosForBucketIndex(size_t index) const {
+    const size_t subBuckets = 1u << mPrecisionBits;
+    if (index < subBuckets) {
+        return index;
+    }
+    const int shift = index / subBuckets - 1;
+    return static_cast<int64_t>(subBuckets + index % subBuckets) << shift;
+}
+
+void StageHistogram::record(nsecs_t duration) {
+    mBuckets[bucketIndexForMicros(ns2us(duration))]++;
+    mCount++;
+}
+
+void StageHistogram::reset() {
+    std::fill(mBuckets.begin(), mBuckets.end(), 0);
+    mCount = 0;
+}
+
+int64_t StageHistogram::findPercentile(int percentile) const {
+    if (mCount == 0) {
+        return 0;
+    }
+    uint32_t pos = static_cast<uint64_t>(percentile) * mCount / 100;
+    uint32_t seen = 0;
+    for (size_t i = 0; i < mBuckets.size(); i++) {
+        seen += mBuckets[i];
+        if (seen > pos) {
+            return lowerBoundMicrosForBucketIndex(i);
+        }
+    }
+    return lowerBoundMicrosForBucketIndex(mBuckets.size() - 1);
+}
+
+void StageHistogram::forEachBucket(
+        const std::function<void(int64_t lowerBoundMicros, uint32_t count)>& callback) const {
+    for (size_t i = 0; i < mBuckets.size(); i++) {
+        if (mBuckets[i]) {
+            callback(lowerBoundMicrosForBucketIndex(i), mBuckets[i]);
+        }
+    }
+}
+
+} /* namespace uirenderer */
+} /* namespace android */
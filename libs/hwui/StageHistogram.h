@@ -0,0 +1,72 @@
+/*
+ * Copyright (C) 2020 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include "utils/Macros.h"
+
+#include <utils/Timers.h>
+
+#include <cstdint>
+#include <functional>
+#include <vector>
+
+namespace android {
+namespace uirenderer {
+
+// Histogram of durations in microseconds with a bounded relative error, in the style of
+// HdrHistogram: every power of two is split into 2^precisionBits linear buckets, so a duration
+// is counted in a bucket whose lower bound is within 1 / 2^precisionBits of it. Durations below
+// 2^precisionBits us are exact, and durations above kMaxMicros are counted in the last bucket.
+class StageHistogram {
+    PREVENT_COPY_AND_ASSIGN(StageHistogram);
+
+public:
+    static constexpr int kMinPrecisionBits = 1;
+    static constexpr int kMaxPrecisionBits = 7;
+    // About 16.8 seconds
+    static constexpr int64_t kMaxMicros = (1 << 24) - 1;
+
+    // precisionBits is clamped to [kMinPrecisionBits, kMaxPrecisionBits].
+    explicit StageHistogram(int precisionBits);
+
+    void record(nsecs_t duration);
+    void reset();
+
+    uint32_t count() const { return mCount; }
+    int precisionBits() const { return mPrecisionBits; }
+
+    // Returns the lower bound in microseconds of the bucket holding the given percentile, or 0
+    // if nothing was recorded.
+    int64_t findPercentile(int percentile) const;
+
+    // Calls the callback with the lower bound in microseconds and the count of every non-empty
+    // bucket, in increasing order.
+    void forEachBucket(const std::function<void(int64_t lowerBoundMicros, uint32_t count)>&
+                               callback) const;
+
+    // Visible for testing
+    size_t bucketIndexForMicros(int64_t micros) const;
+    int64_t lowerBoundMicrosForBucketIndex(size_t index) const;
+
+private:
+    int mPrecisionBits;
+    std::vector<uint32_t> mBuckets;
+    uint32_t mCount = 0;
+};
+
+} /* namespace uirenderer */
+} /* namespace android */
@@ -25,6 +25,7 @@ TreeInfo::TreeInfo(TraversalMode mode, renderthread::CanvasContext& canvasContex
         , prepareTextures(mode == MODE_FULL)
         , canvasContext(canvasContext)
         , disableForceDark(canvasContext.useForceDark() ? 0 : 1)
-        , screenSize(canvasContext.getNextFrameSize()) {}
+        , screenSize(canvasContext.getNextFrameSize())
+        , allowParallelPrepare(mode == MODE_FULL && Properties::parallelPrepareTree) {}
 
 }  // namespace android::uirenderer
@@ -22,7 +22,10 @@
 #include <utils/Timers.h>
 #include "SkSize.h"
 
+#include <future>
 #include <string>
+#include <utility>
+#include <vector>
 
 namespace android {
 namespace uirenderer {
@@ -31,6 +34,10 @@ namespace renderthread {
 class CanvasContext;
 }
 
+namespace skiapipeline {
+class SkiaDisplayList;
+}
+
 class DamageAccumulator;
 class LayerUpdateQueue;
 class RenderNode;
@@ -98,6 +105,21 @@ public:
 
     const SkISize screenSize;
 
+    // Whether independent subtrees may be prepared on CommonPool workers. Only honored in
+    // MODE_FULL, and never set on the TreeInfo used by a worker.
+    bool allowParallelPrepare;
+
+    // Only set on the TreeInfo used by a parallel prepareTree worker. Display lists replaced
+    // on the worker are collected here and released on the RenderThread after the join, as
+    // releasing their contents may free GPU resources.
+    std::vector<std::pair<RenderNode*, skiapipeline::SkiaDisplayList*>>* retiredDisplayLists =
+            nullptr;
+
+    // Syncs of functors that opted in to WebViewFunctor_setConcurrentSync are started here
+    // instead of being run inline. Set by CanvasContext, which waits for them before the
+    // UI thread is unblocked. Never set on the TreeInfo used by a worker.
+    std::vector<std::future<void>>* pendingFunctorSyncs = nullptr;
+
     struct Out {
         bool hasFunctors = false;
         // This is only updated if evaluateAnimations is true
@@ -21,12 +21,14 @@
 #include <utils/Log.h>
 
 #include "PathParser.h"
+#include "Properties.h"
 #include "SkColorFilter.h"
 #include "SkImageInfo.h"
 #include "SkShader.h"
 #include "hwui/Paint.h"
 
 #ifdef __ANDROID__
+#include "pipeline/skia/VectorDrawableCache.h"
 #include "renderthread/RenderThread.h"
 #endif
 
@@ -39,6 +41,19 @@ namespace uirenderer {
 namespace VectorDrawable {
 
 const int Tree::MAX_CACHED_BITMAP_SIZE = 2048;
+const int Tree::MAX_SHARED_RASTER_COUNT = 2;
+
+template <typename T>
+static void appendToKey(std::string* key, const T& value) {
+    static_assert(std::is_trivially_copyable<T>::value, "Key values are copied as raw bytes");
+    key->append(reinterpret_cast<const char*>(&value), sizeof(T));
+}
+
+template <typename T>
+static void appendToKey(std::string* key, const std::vector<T>& values) {
+    appendToKey(key, values.size());
+    key->append(reinterpret_cast<const char*>(values.data()), values.size() * sizeof(T));
+}
 
 void Path::dump() {
     ALOGD("Path: %s has %zu points", mName.c_str(), mProperties.getData().points.size());
@@ -71,6 +86,14 @@ const SkPath& Path::getUpdatedPath(bool useStagingData, SkPath* tempStagingPath)
     }
 }
 
+bool Path::appendContentKey(std::string* outKey) const {
+    const Data& data = mProperties.getData();
+    appendToKey(outKey, data.verbs);
+    appendToKey(outKey, data.verbSizes);
+    appendToKey(outKey, data.points);
+    return true;
+}
+
 void Path::syncProperties() {
     if (mStagingPropertiesDirty) {
         mProperties.syncProperties(mStagingProperties);
@@ -196,6 +219,19 @@ void FullPath::draw(SkCanvas* outCanvas, bool useStagingData) {
     }
 }
 
+bool FullPath::appendContentKey(std::string* outKey) const {
+    // Gradients can only be told apart by identity, which does not survive across trees.
+    if (mProperties.getFillGradient() || mProperties.getStrokeGradient()) {
+        return false;
+    }
+    FullPathProperties::PrimitiveFields fields;
+    mProperties.copyProperties(reinterpret_cast<int8_t*>(&fields), sizeof(fields));
+    appendToKey(outKey, 'F');
+    appendToKey(outKey, fields);
+    appendToKey(outKey, mAntiAlias);
+    return Path::appendContentKey(outKey);
+}
+
 void FullPath::syncProperties() {
     Path::syncProperties();
 
@@ -272,6 +308,11 @@ void ClipPath::draw(SkCanvas* outCanvas, bool useStagingData) {
     outCanvas->clipPath(getUpdatedPath(useStagingData, &tempStagingPath));
 }
 
+bool ClipPath::appendContentKey(std::string* outKey) const {
+    appendToKey(outKey, 'C');
+    return Path::appendContentKey(outKey);
+}
+
 Group::Group(const Group& group) : Node(group) {
     mStagingProperties.syncProperties(group.mStagingProperties);
 }
@@ -291,6 +332,18 @@ void Group::draw(SkCanvas* outCanvas, bool useStagingData) {
     // Restore the previous clip and matrix information.
 }
 
+bool Group::appendContentKey(std::string* outKey) const {
+    appendToKey(outKey, 'G');
+    appendToKey(outKey, mProperties.mPrimitiveFields);
+    appendToKey(outKey, mChildren.size());
+    for (auto& child : mChildren) {
+        if (!child->appendContentKey(outKey)) {
+            return false;
+        }
+    }
+    return true;
+}
+
 void Group::dump() {
     ALOGD("Group %s has %zu children: ", mName.c_str(), mChildren.size());
     ALOGD("Group translateX, Y : %f, %f, scaleX, Y: %f, %f", mProperties.getTranslateX(),
@@ -485,16 +538,62 @@ void Tree::getPaintFor(SkPaint* outPaint, const TreeProperties& prop) const {
     outPaint->setAlpha(prop.getRootAlpha() * 255);
 }
 
+static skiapipeline::VectorDrawableCache* sharedRasterCache() {
+#ifdef __ANDROID__
+    if (Properties::shareVectorDrawableRasters && renderthread::RenderThread::isCurrent()) {
+        return &renderthread::RenderThread::getInstance().cacheManager().vectorDrawableCache();
+    }
+#endif
+    return nullptr;
+}
+
 Bitmap& Tree::getBitmapUpdateIfDirty() {
-    bool redrawNeeded = allocateBitmapIfNeeded(mCache, mProperties.getScaledWidth(),
-                                               mProperties.getScaledHeight());
-    if (redrawNeeded || mCache.dirty) {
-        updateBitmapCache(*mCache.bitmap, false);
-        mCache.dirty = false;
+    int width = mProperties.getScaledWidth();
+    int height = mProperties.getScaledHeight();
+    if (!mCache.dirty && canReuseBitmap(mCache.bitmap.get(), width, height)) {
+        return *mCache.bitmap;
+    }
+
+    skiapipeline::VectorDrawableCache* sharedCache =
+            mRasterCount < MAX_SHARED_RASTER_COUNT ? sharedRasterCache() : nullptr;
+    std::string key;
+    if (sharedCache && !buildCacheKey(width, height, &key)) {
+        sharedCache = nullptr;
+    }
+    if (sharedCache) {
+        if (sk_sp<Bitmap> bitmap = sharedCache->get(key)) {
+            mCache.bitmap = std::move(bitmap);
+            mCache.shared = true;
+            mCache.dirty = false;
+            return *mCache.bitmap;
+        }
+    }
+
+    // Other trees may be drawing the shared bitmap, so it gets replaced instead of redrawn.
+    if (mCache.shared) {
+        mCache.bitmap.reset();
+        mCache.shared = false;
+    }
+    allocateBitmapIfNeeded(mCache, width, height);
+    updateBitmapCache(*mCache.bitmap, false);
+    mCache.dirty = false;
+    mRasterCount++;
+
+    if (sharedCache && mCache.bitmap->width() == width && mCache.bitmap->height() == height) {
+        sharedCache->put(key, mCache.bitmap);
+        mCache.shared = true;
     }
     return *mCache.bitmap;
 }
 
+bool Tree::buildCacheKey(int width, int height, std::string* outKey) const {
+    appendToKey(outKey, width);
+    appendToKey(outKey, height);
+    appendToKey(outKey, mProperties.getViewportWidth());
+    appendToKey(outKey, mProperties.getViewportHeight());
+    return mRootNode->appendContentKey(outKey);
+}
+
 void Tree::draw(SkCanvas* canvas, const SkRect& bounds, const SkPaint& inPaint) {
     if (canvas->quickReject(bounds)) {
         // The RenderNode is on screen, but the AVD is not.
@@ -122,6 +122,11 @@ public:
 
     virtual void forEachFillColor(const std::function<void(SkColor)>& func) const { }
 
+    // Appends everything that affects how this node draws on the render thread to outKey, so
+    // that trees with equal keys rasterize identically. Returns false if the node cannot be
+    // described this way. Render thread only.
+    virtual bool appendContentKey(std::string* outKey) const { return false; }
+
 protected:
     std::string mName;
     PropertyChangedListener* mPropertyChangedListener = nullptr;
@@ -187,6 +192,8 @@ public:
     // This should only be called from animations on RT
     PathProperties* mutateProperties() { return &mProperties; }
 
+    bool appendContentKey(std::string* outKey) const override;
+
 protected:
     virtual const SkPath& getUpdatedPath(bool useStagingData, SkPath* tempStagingPath);
 
@@ -354,6 +361,7 @@ public:
     void forEachFillColor(const std::function<void(SkColor)>& func) const override {
         func(mStagingProperties.getFillColor());
     }
+    bool appendContentKey(std::string* outKey) const override;
 
 protected:
     const SkPath& getUpdatedPath(bool useStagingData, SkPath* tempStagingPath) override;
@@ -376,6 +384,7 @@ public:
     ClipPath() : Path() {}
     void draw(SkCanvas* outCanvas, bool useStagingData) override;
     virtual void setAntiAlias(bool aa) {}
+    bool appendContentKey(std::string* outKey) const override;
 };
 
 class ANDROID_API Group : public Node {
@@ -491,6 +500,8 @@ public:
         }
     }
 
+    bool appendContentKey(std::string* outKey) const override;
+
 private:
     GroupProperties mProperties = GroupProperties(this);
     GroupProperties mStagingProperties = GroupProperties(this);
@@ -658,9 +669,12 @@ private:
     public:
         sk_sp<Bitmap> bitmap;  // used by HWUI pipeline and software
         bool dirty = true;
+        // Set when bitmap is held by the shared VectorDrawableCache, and so must not be redrawn
+        bool shared = false;
     };
 
     bool allocateBitmapIfNeeded(Cache& cache, int width, int height);
+    bool buildCacheKey(int width, int height, std::string* outKey) const;
     bool canReuseBitmap(Bitmap*, int width, int height);
     void updateBitmapCache(Bitmap& outCache, bool useStagingData);
 
@@ -669,6 +683,10 @@ private:
     // The drawable will look blurry above this size.
     const static int MAX_CACHED_BITMAP_SIZE;
 
+    // Trees that had to be rasterized this many times on the render thread are most likely
+    // animating, and stop looking for a shared raster.
+    const static int MAX_SHARED_RASTER_COUNT;
+
     bool mAllowCaching = true;
     std::unique_ptr<Group> mRootNode;
 
@@ -681,6 +699,8 @@ private:
     PropertyChangedListener mPropertyChangedListener =
             PropertyChangedListener(&mCache.dirty, &mStagingCache.dirty);
 
+    int mRasterCount = 0;
+
     mutable bool mWillBeConsumed = false;
 };
 
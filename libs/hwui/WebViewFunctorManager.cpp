@@ -56,6 +56,14 @@ void WebViewFunctor_release(int functor) {
     WebViewFunctorManager::instance().releaseFunctor(functor);
 }
 
+void WebViewFunctor_setConcurrentSync(int functor, bool concurrent) {
+    WebViewFunctorManager::instance().setConcurrentSync(functor, concurrent);
+}
+
+void WebViewFunctor_reportGpuTime(int functor, int64_t gpuTimeNanos) {
+    WebViewFunctorManager::instance().reportGpuTime(functor, gpuTimeNanos);
+}
+
 static std::atomic_int sNextId{1};
 
 WebViewFunctor::WebViewFunctor(void* data, const WebViewFunctorCallbacks& callbacks,
@@ -182,6 +190,24 @@ void WebViewFunctorManager::destroyFunctor(int functor) {
     }
 }
 
+void WebViewFunctorManager::setConcurrentSync(int functor, bool concurrent) {
+    std::lock_guard _lock{mLock};
+    for (auto& iter : mFunctors) {
+        if (iter->id() == functor) {
+            iter->setConcurrentSync(concurrent);
+            return;
+        }
+    }
+}
+
+void WebViewFunctorManager::reportGpuTime(int /* functor */, int64_t gpuTimeNanos) {
+    // All functors draw on the RenderThread, so their time is attributed to whichever
+    // context draws next rather than tracked per functor.
+    if (gpuTimeNanos > 0) {
+        mReportedGpuTime += gpuTimeNanos;
+    }
+}
+
 sp<WebViewFunctor::Handle> WebViewFunctorManager::handleFor(int functor) {
     std::lock_guard _lock{mLock};
     for (auto& iter : mActiveFunctors) {
@@ -24,6 +24,7 @@
 #endif
 
 #include <utils/LightRefBase.h>
+#include <atomic>
 #include <mutex>
 #include <vector>
 
@@ -48,6 +49,8 @@ public:
 
         void sync(const WebViewSyncData& syncData) const { mReference.sync(syncData); }
 
+        bool concurrentSync() const { return mReference.concurrentSync(); }
+
         void drawGl(const DrawGlInfo& drawInfo) const { mReference.drawGl(drawInfo); }
 
         void initVk(const VkFunctorInitParams& params) { mReference.initVk(params); }
@@ -72,6 +75,9 @@ public:
     void postDrawVk();
     void destroyContext();
 
+    bool concurrentSync() const { return mConcurrentSync.load(std::memory_order_relaxed); }
+    void setConcurrentSync(bool concurrent) { mConcurrentSync = concurrent; }
+
     sp<Handle> createHandle() {
         LOG_ALWAYS_FATAL_IF(mCreatedHandle);
         mCreatedHandle = true;
@@ -85,6 +91,7 @@ private:
     RenderMode mMode;
     bool mHasContext = false;
     bool mCreatedHandle = false;
+    std::atomic_bool mConcurrentSync = false;
 };
 
 class WebViewFunctorManager {
@@ -98,6 +105,12 @@ public:
 
     sp<WebViewFunctor::Handle> handleFor(int functor);
 
+    void setConcurrentSync(int functor, bool concurrent);
+
+    // GPU time reported by functors is accumulated until the next frame takes it.
+    void reportGpuTime(int functor, int64_t gpuTimeNanos);
+    int64_t takeReportedGpuTime() { return mReportedGpuTime.exchange(0); }
+
 private:
     WebViewFunctorManager() = default;
     ~WebViewFunctorManager() = default;
@@ -105,6 +118,7 @@ private:
     std::mutex mLock;
     std::vector<std::unique_ptr<WebViewFunctor>> mFunctors;
     std::vector<sp<WebViewFunctor::Handle>> mActiveFunctors;
+    std::atomic<int64_t> mReportedGpuTime = 0;
 };
 
 }  // namespace android::uirenderer
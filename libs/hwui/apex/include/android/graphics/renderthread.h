@@ -17,6 +17,9 @@
 #define ANDROID_GRAPHICS_RENDERTHREAD_H
 
 #include <cutils/compiler.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
 #include <sys/cdefs.h>
 
 __BEGIN_DECLS
@@ -29,6 +32,29 @@ __BEGIN_DECLS
  */
 ANDROID_API void ARenderThread_dumpGraphicsMemory(int fd);
 
+/**
+ * Receives the frame metrics of one frame: count values of the renderer's FrameInfo, indexed
+ * by FrameInfoIndex. The array is only valid for the duration of the call.
+ */
+typedef void (*ARenderThread_frameMetricsCallback)(const int64_t* metrics, size_t count,
+                                                   void* data);
+
+/**
+ * Registers a callback that is invoked on the render thread after every frame drawn by any
+ * renderer in this process. The callback must return quickly, and must not add or remove
+ * frame metrics callbacks.
+ */
+ANDROID_API void ARenderThread_addFrameMetricsCallback(ARenderThread_frameMetricsCallback callback,
+                                                       void* data);
+
+/**
+ * Unregisters a callback registered with the same callback and data. Once this returns the
+ * callback will not be invoked again.
+ * @return true if the callback was registered.
+ */
+ANDROID_API bool ARenderThread_removeFrameMetricsCallback(
+        ARenderThread_frameMetricsCallback callback, void* data);
+
 __END_DECLS
 
 #endif // ANDROID_GRAPHICS_RENDERTHREAD_H
@@ -16,6 +16,7 @@
 
 #include "android/graphics/renderthread.h"
 
+#include <FrameMetricsReporter.h>
 #include <renderthread/RenderProxy.h>
 
 using namespace android;
@@ -23,3 +24,13 @@ using namespace android;
 void ARenderThread_dumpGraphicsMemory(int fd) {
     uirenderer::renderthread::RenderProxy::dumpGraphicsMemory(fd);
 }
+
+void ARenderThread_addFrameMetricsCallback(ARenderThread_frameMetricsCallback callback,
+                                           void* data) {
+    uirenderer::GlobalFrameMetricsReporter::addCallback(callback, data);
+}
+
+bool ARenderThread_removeFrameMetricsCallback(ARenderThread_frameMetricsCallback callback,
+                                              void* data) {
+    return uirenderer::GlobalFrameMetricsReporter::removeCallback(callback, data);
+}
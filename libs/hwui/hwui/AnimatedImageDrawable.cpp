@@ -19,17 +19,23 @@
 #include "AnimatedImageThread.h"
 #endif
 
+#include "Properties.h"
 #include "utils/TraceUtils.h"
 
 #include <SkPicture.h>
+#include <SkPictureRecorder.h>
 #include <SkRefCnt.h>
+#include <SkSurface.h>
 
+#include <algorithm>
 #include <optional>
 
 namespace android {
 
 AnimatedImageDrawable::AnimatedImageDrawable(sk_sp<SkAnimatedImage> animatedImage, size_t bytesUsed)
-        : mSkAnimatedImage(std::move(animatedImage)), mBytesUsed(bytesUsed) {
+        : mSkAnimatedImage(std::move(animatedImage))
+        , mBytesUsed(bytesUsed)
+        , mDecodeAhead(std::max(1, uirenderer::Properties::animatedImageDecodeAhead)) {
     mTimeToShowNextSnapshot = ms2ns(mSkAnimatedImage->currentFrameDuration());
 }
 
@@ -59,8 +65,8 @@ bool AnimatedImageDrawable::isRunning() {
 }
 
 bool AnimatedImageDrawable::nextSnapshotReady() const {
-    return mNextSnapshot.valid() &&
-           mNextSnapshot.wait_for(std::chrono::seconds(0)) == std::future_status::ready;
+    return !mNextSnapshots.empty() &&
+           mNextSnapshots.front().wait_for(std::chrono::seconds(0)) == std::future_status::ready;
 }
 
 // Only called on the RenderThread while UI thread is locked.
@@ -77,7 +83,7 @@ bool AnimatedImageDrawable::isDirty(nsecs_t* outDelay) {
     std::unique_lock lock{mSwapLock};
     mCurrentTime += currentTime - lastWallTime;
 
-    if (!mNextSnapshot.valid()) {
+    if (mNextSnapshots.empty()) {
         // Need to trigger onDraw in order to start decoding the next frame.
         *outDelay = mTimeToShowNextSnapshot - mCurrentTime;
         return true;
@@ -108,7 +114,7 @@ AnimatedImageDrawable::Snapshot AnimatedImageDrawable::decodeNextFrame() {
     {
         std::unique_lock lock{mImageLock};
         snap.mDurationMS = mSkAnimatedImage->decodeNextFrame();
-        snap.mPic.reset(mSkAnimatedImage->newPictureSnapshot());
+        snap.mPic = newPictureSnapshot();
     }
 
     return snap;
@@ -120,13 +126,37 @@ AnimatedImageDrawable::Snapshot AnimatedImageDrawable::reset() {
     {
         std::unique_lock lock{mImageLock};
         mSkAnimatedImage->reset();
-        snap.mPic.reset(mSkAnimatedImage->newPictureSnapshot());
+        snap.mPic = newPictureSnapshot();
         snap.mDurationMS = mSkAnimatedImage->currentFrameDuration();
     }
 
     return snap;
 }
 
+sk_sp<SkPicture> AnimatedImageDrawable::newPictureSnapshot() {
+    if (mDecodeAhead <= 1) {
+        return sk_sp<SkPicture>(mSkAnimatedImage->newPictureSnapshot());
+    }
+
+    // SkAnimatedImage's snapshots share pixels with the frames it decodes into, and it only keeps
+    // two of those. Frames decoded further ahead need pixels of their own.
+    const SkRect bounds = mSkAnimatedImage->getBounds();
+    sk_sp<SkSurface> surface = SkSurface::MakeRasterN32Premul(SkScalarCeilToInt(bounds.width()),
+                                                              SkScalarCeilToInt(bounds.height()));
+    if (!surface) {
+        return sk_sp<SkPicture>(mSkAnimatedImage->newPictureSnapshot());
+    }
+    SkCanvas* surfaceCanvas = surface->getCanvas();
+    surfaceCanvas->clear(SK_ColorTRANSPARENT);
+    surfaceCanvas->translate(-bounds.fLeft, -bounds.fTop);
+    mSkAnimatedImage->draw(surfaceCanvas);
+
+    SkPictureRecorder recorder;
+    recorder.beginRecording(bounds)->drawImage(surface->makeImageSnapshot(), bounds.fLeft,
+                                               bounds.fTop);
+    return recorder.finishRecordingAsPicture();
+}
+
 // Only called on the RenderThread.
 void AnimatedImageDrawable::onDraw(SkCanvas* canvas) {
     std::optional<SkPaint> lazyPaint;
@@ -164,7 +194,8 @@ void AnimatedImageDrawable::onDraw(SkCanvas* canvas) {
         // frame, but keep showing the current frame until the first is ready.
 #ifdef __ANDROID__ // Layoutlib does not support AnimatedImageThread
         auto& thread = uirenderer::AnimatedImageThread::getInstance();
-        mNextSnapshot = thread.reset(sk_ref_sp(this));
+        mNextSnapshots.clear();
+        mNextSnapshots.push_back(thread.reset(sk_ref_sp(this)));
 #endif
     }
 
@@ -172,11 +203,14 @@ void AnimatedImageDrawable::onDraw(SkCanvas* canvas) {
     if (mRunning && nextSnapshotReady()) {
         std::unique_lock lock{mSwapLock};
         if (mCurrentTime >= mTimeToShowNextSnapshot) {
-            mSnapshot = mNextSnapshot.get();
+            mSnapshot = mNextSnapshots.front().get();
+            mNextSnapshots.pop_front();
             const nsecs_t timeToShowCurrentSnap = mTimeToShowNextSnapshot;
             if (mSnapshot.mDurationMS == SkAnimatedImage::kFinished) {
                 finalFrame = true;
                 mRunning = false;
+                // Anything decoded past the end is stale by the time the animation restarts.
+                mNextSnapshots.clear();
             } else {
                 mTimeToShowNextSnapshot += ms2ns(mSnapshot.mDurationMS);
                 if (mCurrentTime >= mTimeToShowNextSnapshot) {
@@ -190,10 +224,12 @@ void AnimatedImageDrawable::onDraw(SkCanvas* canvas) {
         }
     }
 
-    if (mRunning && !mNextSnapshot.valid()) {
+    if (mRunning && mNextSnapshots.size() < mDecodeAhead) {
 #ifdef __ANDROID__ // Layoutlib does not support AnimatedImageThread
         auto& thread = uirenderer::AnimatedImageThread::getInstance();
-        mNextSnapshot = thread.decodeNextFrame(sk_ref_sp(this));
+        while (mNextSnapshots.size() < mDecodeAhead) {
+            mNextSnapshots.push_back(thread.decodeNextFrame(sk_ref_sp(this)));
+        }
 #endif
     }
 
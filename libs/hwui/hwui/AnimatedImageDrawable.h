@@ -27,11 +27,16 @@
 #include <SkDrawable.h>
 #include <SkPicture.h>
 
+#include <deque>
 #include <future>
 #include <mutex>
 
 namespace android {
 
+namespace uirenderer {
+class AnimatedImageThread;
+}
+
 class OnAnimationEndListener {
 public:
     virtual ~OnAnimationEndListener() {}
@@ -112,20 +117,31 @@ protected:
     virtual void onDraw(SkCanvas* canvas) override;
 
 private:
+    friend class uirenderer::AnimatedImageThread;
+
     sk_sp<SkAnimatedImage> mSkAnimatedImage;
     const size_t mBytesUsed;
 
+    // How many frames are decoded ahead of the one being shown.
+    const size_t mDecodeAhead;
+
+    // The AnimatedImageThread thread this drawable decodes on, or -1 before its first decode.
+    int mDecodeThread = -1;
+
     bool mRunning = false;
     bool mStarting = false;
 
     // A snapshot of the current frame to draw.
     Snapshot mSnapshot;
 
-    std::future<Snapshot> mNextSnapshot;
+    // The frames following mSnapshot, in the order they will be shown.
+    std::deque<std::future<Snapshot>> mNextSnapshots;
 
     bool nextSnapshotReady() const;
+    // Only called on the AnimatedImageThread, with mImageLock held.
+    sk_sp<SkPicture> newPictureSnapshot();
 
-    // When to switch from mSnapshot to mNextSnapshot.
+    // When to switch from mSnapshot to the first of mNextSnapshots.
     nsecs_t mTimeToShowNextSnapshot = 0;
 
     // The current time for the drawable itself.
@@ -18,27 +18,50 @@
 
 #include <sys/resource.h>
 
+#include <algorithm>
+#include <thread>
+
 namespace android {
 namespace uirenderer {
 
+// Enough to keep a few animations on screen from waiting on each other, without competing with
+// the UI and render threads for cores.
+static constexpr unsigned int kMaxThreadCount = 2;
+
 AnimatedImageThread& AnimatedImageThread::getInstance() {
     static AnimatedImageThread* sInstance = new AnimatedImageThread();
     return *sInstance;
 }
 
 AnimatedImageThread::AnimatedImageThread() {
-    setpriority(PRIO_PROCESS, 0, PRIORITY_NORMAL + PRIORITY_MORE_FAVORABLE);
-    start("AnimatedImageThread");
+    const unsigned int threadCount =
+            std::max(1u, std::min(kMaxThreadCount, std::thread::hardware_concurrency()));
+    for (unsigned int i = 0; i < threadCount; i++) {
+        sp<ThreadBase> thread = new ThreadBase();
+        thread->start("AnimatedImageThread");
+        thread->queue().post(
+                []() { setpriority(PRIO_PROCESS, 0, PRIORITY_NORMAL + PRIORITY_MORE_FAVORABLE); });
+        mThreads.push_back(std::move(thread));
+    }
+}
+
+// Only called on the RenderThread.
+WorkQueue& AnimatedImageThread::queueFor(AnimatedImageDrawable* drawable) {
+    if (drawable->mDecodeThread < 0) {
+        drawable->mDecodeThread = mNextThread;
+        mNextThread = (mNextThread + 1) % mThreads.size();
+    }
+    return mThreads[drawable->mDecodeThread]->queue();
 }
 
 std::future<AnimatedImageDrawable::Snapshot> AnimatedImageThread::decodeNextFrame(
         const sk_sp<AnimatedImageDrawable>& drawable) {
-    return queue().async([drawable]() { return drawable->decodeNextFrame(); });
+    return queueFor(drawable.get()).async([drawable]() { return drawable->decodeNextFrame(); });
 }
 
 std::future<AnimatedImageDrawable::Snapshot> AnimatedImageThread::reset(
         const sk_sp<AnimatedImageDrawable>& drawable) {
-    return queue().async([drawable]() { return drawable->reset(); });
+    return queueFor(drawable.get()).async([drawable]() { return drawable->reset(); });
 }
 
 }  // namespace uirenderer
@@ -22,11 +22,18 @@
 
 #include <SkRefCnt.h>
 
+#include <vector>
+
 namespace android {
 
 namespace uirenderer {
 
-class AnimatedImageThread : private ThreadBase {
+/**
+ * A small pool of threads decoding the frames of every AnimatedImageDrawable in the process. Each
+ * drawable is assigned to one of the threads when it first decodes, so that its decodes run in
+ * the order they were requested, while other drawables decode in parallel.
+ */
+class AnimatedImageThread {
     PREVENT_COPY_AND_ASSIGN(AnimatedImageThread);
 
 public:
@@ -38,6 +45,11 @@ public:
 
 private:
     AnimatedImageThread();
+
+    WorkQueue& queueFor(AnimatedImageDrawable*);
+
+    std::vector<sp<ThreadBase>> mThreads;
+    size_t mNextThread = 0;
 };
 
 }  // namespace uirenderer
@@ -26,6 +26,7 @@
 #ifndef _WIN32
 #include <sys/mman.h>
 #endif
+#include <string.h>
 
 #include <cutils/ashmem.h>
 #include <log/log.h>
@@ -39,10 +40,87 @@
 #include <SkImagePriv.h>
 #include <SkWebpEncoder.h>
 #include <SkHighContrastFilter.h>
+#include <android-base/properties.h>
+#include <algorithm>
 #include <limits>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
 
 namespace android {
 
+namespace {
+
+/**
+ * Keeps freed heap pixel buffers for reuse by later heap bitmaps, sparing image heavy apps the
+ * page faults and GC pressure of repeatedly allocating and freeing multi-megabyte buffers.
+ * Buffers are bucketed by size class; sizes are rounded up to a quarter of their power of two
+ * so differently sized images can share buffers.
+ */
+class HeapPixelPool {
+public:
+    // Smaller buffers come from malloc's own caches quickly enough.
+    static constexpr size_t kMinPooledBytes = 64 * 1024;
+
+    static HeapPixelPool& get() {
+        static HeapPixelPool* pool = new HeapPixelPool();
+        return *pool;
+    }
+
+    bool enabled() const { return mMaxBytes > 0; }
+
+    static size_t sizeClass(size_t size) {
+        const int shift = 63 - __builtin_clzll(static_cast<unsigned long long>(size));
+        const size_t step = size_t(1) << (shift - 2);
+        return (size + step - 1) & ~(step - 1);
+    }
+
+    // Returns a zeroed buffer of exactly |classSize| bytes.
+    void* obtain(size_t classSize) {
+        void* addr = nullptr;
+        {
+            std::lock_guard<std::mutex> lock(mLock);
+            auto it = mBuffers.find(classSize);
+            if (it != mBuffers.end() && !it->second.empty()) {
+                addr = it->second.back();
+                it->second.pop_back();
+                mPooledBytes -= classSize;
+            }
+        }
+        if (addr == nullptr) {
+            return calloc(classSize, 1);
+        }
+        memset(addr, 0, classSize);
+        return addr;
+    }
+
+    // Takes ownership of |addr| if it is a pooled size and there is room for it.
+    bool release(void* addr, size_t size) {
+        if (!enabled() || size < kMinPooledBytes || sizeClass(size) != size) {
+            return false;
+        }
+        std::lock_guard<std::mutex> lock(mLock);
+        if (mPooledBytes + size > mMaxBytes) {
+            return false;
+        }
+        mBuffers[size].push_back(addr);
+        mPooledBytes += size;
+        return true;
+    }
+
+private:
+    HeapPixelPool()
+            : mMaxBytes(KB(static_cast<size_t>(
+                      std::max(0, base::GetIntProperty(PROPERTY_BITMAP_POOL_SIZE_KB, 0))))) {}
+
+    const size_t mMaxBytes;
+    std::mutex mLock;
+    std::unordered_map<size_t, std::vector<void*>> mBuffers;
+    size_t mPooledBytes = 0;
+};
+
+}  // namespace
+
 bool Bitmap::computeAllocationSize(size_t rowBytes, int height, size_t* size) {
     return 0 <= height && height <= std::numeric_limits<size_t>::max() &&
            !__builtin_mul_overflow(rowBytes, (size_t)height, size) &&
@@ -125,6 +203,16 @@ sk_sp<Bitmap> Bitmap::allocateHeapBitmap(const SkImageInfo& info) {
 }
 
 sk_sp<Bitmap> Bitmap::allocateHeapBitmap(size_t size, const SkImageInfo& info, size_t rowBytes) {
+    HeapPixelPool& pool = HeapPixelPool::get();
+    if (pool.enabled() && size >= HeapPixelPool::kMinPooledBytes) {
+        const size_t classSize = HeapPixelPool::sizeClass(size);
+        void* addr = pool.obtain(classSize);
+        if (!addr) {
+            return nullptr;
+        }
+        return sk_sp<Bitmap>(new Bitmap(addr, classSize, info, rowBytes));
+    }
+
     void* addr = calloc(size, 1);
     if (!addr) {
         return nullptr;
@@ -280,6 +368,10 @@ Bitmap::~Bitmap() {
             close(mPixelStorage.ashmem.fd);
             break;
         case PixelStorageType::Heap:
+            if (HeapPixelPool::get().release(mPixelStorage.heap.address,
+                                             mPixelStorage.heap.size)) {
+                break;
+            }
             free(mPixelStorage.heap.address);
 #ifdef __ANDROID__
             mallopt(M_PURGE, 0);
@@ -82,6 +82,21 @@ float MinikinUtils::measureText(const Paint* paint, minikin::Bidi bidiFlags,
                                         endHyphen, advances);
 }
 
+void MinikinUtils::measureTextRuns(const Paint* paint, minikin::Bidi bidiFlags,
+                                   const Typeface* typeface, const uint16_t* buf, size_t bufSize,
+                                   const minikin::Range* runs, size_t runCount,
+                                   float* outAdvances) {
+    minikin::MinikinPaint minikinPaint = prepareMinikinPaint(paint, typeface);
+    const minikin::U16StringPiece textBuf(buf, bufSize);
+    const minikin::StartHyphenEdit startHyphen = paint->getStartHyphenEdit();
+    const minikin::EndHyphenEdit endHyphen = paint->getEndHyphenEdit();
+
+    for (size_t i = 0; i < runCount; i++) {
+        outAdvances[i] = minikin::Layout::measureText(textBuf, runs[i], bidiFlags, minikinPaint,
+                                                      startHyphen, endHyphen, nullptr);
+    }
+}
+
 bool MinikinUtils::hasVariationSelector(const Typeface* typeface, uint32_t codepoint, uint32_t vs) {
     const Typeface* resolvedFace = Typeface::resolveDefault(typeface);
     return resolvedFace->fFontCollection->hasVariationSelector(codepoint, vs);
@@ -53,6 +53,14 @@ public:
                                          size_t start, size_t count, size_t bufSize,
                                          float* advances);
 
+    // Measures several runs of the same buffer with one paint, writing the advance of each run to
+    // outAdvances. The typeface is resolved and the minikin paint built once for the whole batch
+    // instead of once per run, which matters when the runs are short.
+    ANDROID_API static void measureTextRuns(const Paint* paint, minikin::Bidi bidiFlags,
+                                            const Typeface* typeface, const uint16_t* buf,
+                                            size_t bufSize, const minikin::Range* runs,
+                                            size_t runCount, float* outAdvances);
+
     ANDROID_API static bool hasVariationSelector(const Typeface* typeface, uint32_t codepoint,
                                                  uint32_t vs);
 
@@ -32,14 +32,214 @@
 #include <androidfw/Asset.h>
 #include <sys/stat.h>
 
+#include <algorithm>
+#include <atomic>
+#include <list>
 #include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
 
 using namespace android;
 
+static jclass gBitmap_class;
+
+namespace android {
+
+/*
+ * Owns the SkBitmapRegionDecoder behind a Java BitmapRegionDecoder, plus a
+ * small LRU cache of recently decoded regions and a pool of extra decoders
+ * used to decode several regions in parallel.
+ */
+class BitmapRegionDecoderWrapper {
+public:
+    // Upper bound on the pixel memory held by one decoder's region cache.
+    static constexpr size_t kCacheBytes = 8 * 1024 * 1024;
+    // Maximum number of threads used by decodeRegions().
+    static constexpr size_t kMaxDecodeThreads = 4;
+
+    static std::unique_ptr<BitmapRegionDecoderWrapper> Make(
+            std::unique_ptr<SkStreamRewindable> stream) {
+        // Keep a duplicate of the stream so that worker decoders can be made
+        // later; for memory streams this shares the underlying data.
+        std::unique_ptr<SkStreamRewindable> source = stream->duplicate();
+        std::unique_ptr<SkBitmapRegionDecoder> decoder(SkBitmapRegionDecoder::Create(
+                stream.release(), SkBitmapRegionDecoder::kAndroidCodec_Strategy));
+        if (!decoder) {
+            return nullptr;
+        }
+        return std::unique_ptr<BitmapRegionDecoderWrapper>(
+                new BitmapRegionDecoderWrapper(std::move(decoder), std::move(source)));
+    }
+
+    SkBitmapRegionDecoder* decoder() const { return mDecoder.get(); }
+
+    /*
+     * Same contract as SkBitmapRegionDecoder::decodeRegion(), served from the
+     * region cache when the exact same region was decoded recently. Callers
+     * serialize calls, as the Java class does.
+     */
+    bool decodeRegion(SkBitmap* bitmap, SkBRDAllocator* allocator, const SkIRect& subset,
+                      int sampleSize, SkColorType colorType, bool requireUnpremul,
+                      sk_sp<SkColorSpace> colorSpace) {
+        const CacheKey key{subset, sampleSize, colorType, requireUnpremul, colorSpace};
+        if (copyFromCache(key, bitmap, allocator)) {
+            return true;
+        }
+        if (!mDecoder->decodeRegion(bitmap, allocator, subset, sampleSize, colorType,
+                                    requireUnpremul, colorSpace)) {
+            return false;
+        }
+        addToCache(key, *bitmap);
+        return true;
+    }
+
+    /*
+     * Decodes each of |subsets| into a heap bitmap, in parallel on up to
+     * kMaxDecodeThreads extra decoders. Entries that fail to decode are left
+     * null.
+     */
+    std::vector<sk_sp<Bitmap>> decodeRegions(const std::vector<SkIRect>& subsets, int sampleSize,
+                                             SkColorType colorType, bool requireUnpremul,
+                                             sk_sp<SkColorSpace> colorSpace) {
+        std::vector<sk_sp<Bitmap>> results(subsets.size());
+        std::atomic<size_t> next(0);
+        auto worker = [&]() {
+            std::unique_ptr<SkBitmapRegionDecoder> decoder;
+            for (size_t i = next++; i < subsets.size(); i = next++) {
+                const CacheKey key{subsets[i], sampleSize, colorType, requireUnpremul,
+                                   colorSpace};
+                HeapAllocator heapAlloc;
+                SkBitmap bitmap;
+                if (copyFromCache(key, &bitmap, &heapAlloc)) {
+                    results[i] = sk_sp<Bitmap>(heapAlloc.getStorageObjAndReset());
+                    continue;
+                }
+                if (!decoder && !(decoder = obtainWorkerDecoder())) {
+                    continue;
+                }
+                if (decoder->decodeRegion(&bitmap, &heapAlloc, subsets[i], sampleSize, colorType,
+                                          requireUnpremul, colorSpace)) {
+                    addToCache(key, bitmap);
+                    results[i] = sk_sp<Bitmap>(heapAlloc.getStorageObjAndReset());
+                }
+            }
+            if (decoder) {
+                recycleWorkerDecoder(std::move(decoder));
+            }
+        };
+
+        // The calling thread decodes its share of the regions too.
+        const size_t threadCount = std::min(subsets.size(), kMaxDecodeThreads);
+        std::vector<std::thread> threads;
+        for (size_t i = 1; i < threadCount; i++) {
+            threads.emplace_back(worker);
+        }
+        worker();
+        for (auto& thread : threads) {
+            thread.join();
+        }
+        return results;
+    }
+
+private:
+    struct CacheKey {
+        SkIRect subset;
+        int sampleSize;
+        SkColorType colorType;
+        bool requireUnpremul;
+        sk_sp<SkColorSpace> colorSpace;
+
+        bool operator==(const CacheKey& other) const {
+            return subset == other.subset && sampleSize == other.sampleSize &&
+                    colorType == other.colorType && requireUnpremul == other.requireUnpremul &&
+                    SkColorSpace::Equals(colorSpace.get(), other.colorSpace.get());
+        }
+    };
+
+    struct CacheEntry {
+        CacheKey key;
+        SkBitmap pixels;
+    };
+
+    BitmapRegionDecoderWrapper(std::unique_ptr<SkBitmapRegionDecoder> decoder,
+                               std::unique_ptr<SkStreamRewindable> source)
+            : mDecoder(std::move(decoder)), mSource(std::move(source)) {}
+
+    bool copyFromCache(const CacheKey& key, SkBitmap* bitmap, SkBRDAllocator* allocator) {
+        std::lock_guard<std::mutex> lock(mCacheLock);
+        for (auto it = mCache.begin(); it != mCache.end(); ++it) {
+            if (!(it->key == key)) {
+                continue;
+            }
+            bitmap->setInfo(it->pixels.info());
+            if (!allocator->allocPixelRef(bitmap) ||
+                    !bitmap->writePixels(it->pixels.pixmap(), 0, 0)) {
+                return false;
+            }
+            // Move to the front; the back of the list is evicted first.
+            mCache.splice(mCache.begin(), mCache, it);
+            return true;
+        }
+        return false;
+    }
+
+    void addToCache(const CacheKey& key, const SkBitmap& bitmap) {
+        const size_t bytes = bitmap.computeByteSize();
+        if (bytes == 0 || bytes > kCacheBytes / 4) {
+            return;
+        }
+        CacheEntry entry{key, SkBitmap()};
+        if (!entry.pixels.tryAllocPixels(bitmap.info()) ||
+                !entry.pixels.writePixels(bitmap.pixmap(), 0, 0)) {
+            return;
+        }
+
+        std::lock_guard<std::mutex> lock(mCacheLock);
+        mCache.push_front(std::move(entry));
+        mCacheSize += bytes;
+        while (mCacheSize > kCacheBytes) {
+            mCacheSize -= mCache.back().pixels.computeByteSize();
+            mCache.pop_back();
+        }
+    }
+
+    std::unique_ptr<SkBitmapRegionDecoder> obtainWorkerDecoder() {
+        std::lock_guard<std::mutex> lock(mWorkerLock);
+        if (!mWorkerDecoders.empty()) {
+            std::unique_ptr<SkBitmapRegionDecoder> decoder = std::move(mWorkerDecoders.back());
+            mWorkerDecoders.pop_back();
+            return decoder;
+        }
+        std::unique_ptr<SkStreamRewindable> stream = mSource ? mSource->duplicate() : nullptr;
+        if (!stream) {
+            return nullptr;
+        }
+        return std::unique_ptr<SkBitmapRegionDecoder>(SkBitmapRegionDecoder::Create(
+                stream.release(), SkBitmapRegionDecoder::kAndroidCodec_Strategy));
+    }
+
+    void recycleWorkerDecoder(std::unique_ptr<SkBitmapRegionDecoder> decoder) {
+        std::lock_guard<std::mutex> lock(mWorkerLock);
+        mWorkerDecoders.push_back(std::move(decoder));
+    }
+
+    const std::unique_ptr<SkBitmapRegionDecoder> mDecoder;
+    const std::unique_ptr<SkStreamRewindable> mSource;
+
+    std::mutex mCacheLock;
+    std::list<CacheEntry> mCache;
+    size_t mCacheSize = 0;
+
+    std::mutex mWorkerLock;
+    std::vector<std::unique_ptr<SkBitmapRegionDecoder>> mWorkerDecoders;
+};
+
+} // namespace android
+
 static jobject createBitmapRegionDecoder(JNIEnv* env, std::unique_ptr<SkStreamRewindable> stream) {
-  std::unique_ptr<SkBitmapRegionDecoder> brd(
-            SkBitmapRegionDecoder::Create(stream.release(),
-                                          SkBitmapRegionDecoder::kAndroidCodec_Strategy));
+    std::unique_ptr<BitmapRegionDecoderWrapper> brd =
+            BitmapRegionDecoderWrapper::Make(std::move(stream));
     if (!brd) {
         doThrowIOE(env, "Image format not supported");
         return nullObjectReturn("CreateBitmapRegionDecoder returned null");
@@ -158,7 +358,9 @@ static jobject nativeDecodeRegion(JNIEnv* env, jobject, jlong brdHandle, jint in
         recycledBytes = recycledBitmap->getAllocationByteCount();
     }
 
-    SkBitmapRegionDecoder* brd = reinterpret_cast<SkBitmapRegionDecoder*>(brdHandle);
+    BitmapRegionDecoderWrapper* wrapper =
+            reinterpret_cast<BitmapRegionDecoderWrapper*>(brdHandle);
+    SkBitmapRegionDecoder* brd = wrapper->decoder();
     SkColorType decodeColorType = brd->computeOutputColorType(colorType);
     if (decodeColorType == kRGBA_F16_SkColorType && isHardware &&
             !uirenderer::HardwareBitmapUploader::hasFP16Support()) {
@@ -183,7 +385,7 @@ static jobject nativeDecodeRegion(JNIEnv* env, jobject, jlong brdHandle, jint in
     // Decode the region.
     SkIRect subset = SkIRect::MakeXYWH(inputX, inputY, inputWidth, inputHeight);
     SkBitmap bitmap;
-    if (!brd->decodeRegion(&bitmap, allocator, subset, sampleSize,
+    if (!wrapper->decodeRegion(&bitmap, allocator, subset, sampleSize,
             decodeColorType, requireUnpremul, decodeColorSpace)) {
         return nullObjectReturn("Failed to decode region.");
     }
@@ -229,21 +431,65 @@ static jobject nativeDecodeRegion(JNIEnv* env, jobject, jlong brdHandle, jint in
     return android::bitmap::createBitmap(env, heapAlloc.getStorageObjAndReset(), bitmapCreateFlags);
 }
 
+/*
+ * Decodes several regions, given as consecutive (x, y, width, height)
+ * quadruples in |rects|, into new heap bitmaps of the native 32-bit config.
+ * Regions are decoded in parallel; failed regions are returned as null.
+ */
+static jobjectArray nativeDecodeRegions(JNIEnv* env, jobject, jlong brdHandle, jintArray rects,
+        jint sampleSize, jlong colorSpaceHandle) {
+    BitmapRegionDecoderWrapper* wrapper =
+            reinterpret_cast<BitmapRegionDecoderWrapper*>(brdHandle);
+    SkBitmapRegionDecoder* brd = wrapper->decoder();
+
+    NPE_CHECK_RETURN_ZERO(env, rects);
+    const jsize count = env->GetArrayLength(rects) / 4;
+    std::vector<jint> coords(count * 4);
+    env->GetIntArrayRegion(rects, 0, count * 4, coords.data());
+    std::vector<SkIRect> subsets;
+    subsets.reserve(count);
+    for (jsize i = 0; i < count; i++) {
+        subsets.push_back(SkIRect::MakeXYWH(coords[i * 4], coords[i * 4 + 1],
+                                            coords[i * 4 + 2], coords[i * 4 + 3]));
+    }
+
+    const SkColorType decodeColorType = brd->computeOutputColorType(kN32_SkColorType);
+    sk_sp<SkColorSpace> decodeColorSpace = brd->computeOutputColorSpace(
+            decodeColorType, GraphicsJNI::getNativeColorSpace(colorSpaceHandle));
+    std::vector<sk_sp<Bitmap>> bitmaps = wrapper->decodeRegions(
+            subsets, sampleSize, decodeColorType, false /* requireUnpremul */, decodeColorSpace);
+
+    jobjectArray result = env->NewObjectArray(count, gBitmap_class, nullptr);
+    if (result == nullptr) {
+        return nullptr;
+    }
+    for (jsize i = 0; i < count; i++) {
+        if (bitmaps[i] == nullptr) {
+            continue;
+        }
+        jobject bitmap = bitmap::createBitmap(env, bitmaps[i].release(),
+                android::bitmap::kBitmapCreateFlag_Premultiplied);
+        env->SetObjectArrayElement(result, i, bitmap);
+        env->DeleteLocalRef(bitmap);
+    }
+    return result;
+}
+
 static jint nativeGetHeight(JNIEnv* env, jobject, jlong brdHandle) {
-    SkBitmapRegionDecoder* brd =
-            reinterpret_cast<SkBitmapRegionDecoder*>(brdHandle);
-    return static_cast<jint>(brd->height());
+    BitmapRegionDecoderWrapper* brd =
+            reinterpret_cast<BitmapRegionDecoderWrapper*>(brdHandle);
+    return static_cast<jint>(brd->decoder()->height());
 }
 
 static jint nativeGetWidth(JNIEnv* env, jobject, jlong brdHandle) {
-    SkBitmapRegionDecoder* brd =
-            reinterpret_cast<SkBitmapRegionDecoder*>(brdHandle);
-    return static_cast<jint>(brd->width());
+    BitmapRegionDecoderWrapper* brd =
+            reinterpret_cast<BitmapRegionDecoderWrapper*>(brdHandle);
+    return static_cast<jint>(brd->decoder()->width());
 }
 
 static void nativeClean(JNIEnv* env, jobject, jlong brdHandle) {
-    SkBitmapRegionDecoder* brd =
-            reinterpret_cast<SkBitmapRegionDecoder*>(brdHandle);
+    BitmapRegionDecoderWrapper* brd =
+            reinterpret_cast<BitmapRegionDecoderWrapper*>(brdHandle);
     delete brd;
 }
 
@@ -254,6 +500,9 @@ static const JNINativeMethod gBitmapRegionDecoderMethods[] = {
         "(JIIIILandroid/graphics/BitmapFactory$Options;JJ)Landroid/graphics/Bitmap;",
         (void*)nativeDecodeRegion},
 
+    {   "nativeDecodeRegions", "(J[IIJ)[Landroid/graphics/Bitmap;",
+        (void*)nativeDecodeRegions},
+
     {   "nativeGetHeight", "(J)I", (void*)nativeGetHeight},
 
     {   "nativeGetWidth", "(J)I", (void*)nativeGetWidth},
@@ -283,6 +532,7 @@ static const JNINativeMethod gBitmapRegionDecoderMethods[] = {
 
 int register_android_graphics_BitmapRegionDecoder(JNIEnv* env)
 {
+    gBitmap_class = MakeGlobalRefOrDie(env, FindClassOrDie(env, "android/graphics/Bitmap"));
     return android::RegisterMethodsOrDie(env, "android/graphics/BitmapRegionDecoder",
             gBitmapRegionDecoderMethods, NELEM(gBitmapRegionDecoderMethods));
 }
@@ -17,10 +17,10 @@
 
 #include "graphics_jni_helpers.h"
 
-class SkBitmapRegionDecoder;
 class SkCanvas;
 
 namespace android {
+class BitmapRegionDecoderWrapper;
 class Paint;
 struct Typeface;
 }
@@ -103,7 +103,8 @@ public:
 
     static jobject createRegion(JNIEnv* env, SkRegion* region);
 
-    static jobject createBitmapRegionDecoder(JNIEnv* env, SkBitmapRegionDecoder* bitmap);
+    static jobject createBitmapRegionDecoder(JNIEnv* env,
+                                             android::BitmapRegionDecoderWrapper* decoder);
 
     /**
      * Given a bitmap we natively allocate a memory block to store the contents
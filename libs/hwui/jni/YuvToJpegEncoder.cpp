@@ -6,6 +6,49 @@
 
 #include "graphics_jni_helpers.h"
 
+#if defined(__ARM_NEON__) || defined(__ARM_NEON)
+#include <arm_neon.h>
+#define YUV_USE_NEON 1
+#endif
+
+// Splits |count| interleaved V/U pairs into separate U and V rows.
+static void splitVuRow(const uint8_t* vu, uint8_t* u, uint8_t* v, int count) {
+    int i = 0;
+#ifdef YUV_USE_NEON
+    for (; i + 16 <= count; i += 16) {
+        uint8x16x2_t pairs = vld2q_u8(vu + 2 * i);
+        vst1q_u8(u + i, pairs.val[1]);
+        vst1q_u8(v + i, pairs.val[0]);
+    }
+#endif
+    for (; i < count; ++i) {
+        u[i] = vu[2 * i + 1];
+        v[i] = vu[2 * i];
+    }
+}
+
+// Splits |count| Y0/U/Y1/V quadruples into a Y row and separate U and V rows.
+static void splitYuyvRow(const uint8_t* yuyv, uint8_t* y, uint8_t* u, uint8_t* v, int count) {
+    int i = 0;
+#ifdef YUV_USE_NEON
+    for (; i + 16 <= count; i += 16) {
+        uint8x16x4_t quads = vld4q_u8(yuyv + 4 * i);
+        uint8x16x2_t luma;
+        luma.val[0] = quads.val[0];
+        luma.val[1] = quads.val[2];
+        vst2q_u8(y + 2 * i, luma);
+        vst1q_u8(u + i, quads.val[1]);
+        vst1q_u8(v + i, quads.val[3]);
+    }
+#endif
+    for (; i < count; ++i) {
+        y[2 * i] = yuyv[4 * i];
+        y[2 * i + 1] = yuyv[4 * i + 2];
+        u[i] = yuyv[4 * i + 1];
+        v[i] = yuyv[4 * i + 3];
+    }
+}
+
 YuvToJpegEncoder* YuvToJpegEncoder::create(int format, int* strides) {
     // Only ImageFormat.NV21 and ImageFormat.YUY2 are supported
     // for now.
@@ -133,13 +176,8 @@ void Yuv420SpToJpegEncoder::deinterleave(uint8_t* vuPlanar, uint8_t* uRows,
     if (numRows > 8) numRows = 8;
     for (int row = 0; row < numRows; ++row) {
         int offset = ((rowIndex >> 1) + row) * fStrides[1];
-        uint8_t* vu = vuPlanar + offset;
-        for (int i = 0; i < (width >> 1); ++i) {
-            int index = row * (width >> 1) + i;
-            uRows[index] = vu[1];
-            vRows[index] = vu[0];
-            vu += 2;
-        }
+        int index = row * (width >> 1);
+        splitVuRow(vuPlanar + offset, uRows + index, vRows + index, width >> 1);
     }
 }
 
@@ -208,15 +246,8 @@ void Yuv422IToJpegEncoder::deinterleave(uint8_t* yuv, uint8_t* yRows, uint8_t* u
     if (numRows > 16) numRows = 16;
     for (int row = 0; row < numRows; ++row) {
         uint8_t* yuvSeg = yuv + (rowIndex + row) * fStrides[0];
-        for (int i = 0; i < (width >> 1); ++i) {
-            int indexY = row * width + (i << 1);
-            int indexU = row * (width >> 1) + i;
-            yRows[indexY] = yuvSeg[0];
-            yRows[indexY + 1] = yuvSeg[2];
-            uRows[indexU] = yuvSeg[1];
-            vRows[indexU] = yuvSeg[3];
-            yuvSeg += 4;
-        }
+        int indexU = row * (width >> 1);
+        splitYuyvRow(yuvSeg, yRows + row * width, uRows + indexU, vRows + indexU, width >> 1);
     }
 }
 
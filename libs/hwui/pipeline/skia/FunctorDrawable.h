@@ -54,6 +54,15 @@ public:
         }
     }
 
+    // Returns the handle of a functor that may be synced off the RenderThread, or nullptr if
+    // syncFunctor() must be called instead.
+    virtual sp<WebViewFunctor::Handle> concurrentSyncHandle() const {
+        if (mAnyFunctor.index() == 0 && std::get<0>(mAnyFunctor).handle->concurrentSync()) {
+            return std::get<0>(mAnyFunctor).handle;
+        }
+        return nullptr;
+    }
+
 protected:
     virtual SkRect onGetBounds() override { return mBounds; }
 
@@ -0,0 +1,64 @@
+/*
+ * Copyright (C) 2020 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "LayerSurfacePool.h"
+
+namespace android {
+namespace uirenderer {
+namespace skiapipeline {
+
+static size_t surfaceBytes(const SkSurface& surface) {
+    return surface.imageInfo().computeMinByteSize();
+}
+
+static bool matches(const SkImageInfo& a, const SkImageInfo& b) {
+    return a.width() == b.width() && a.height() == b.height() &&
+           a.colorType() == b.colorType() && a.alphaType() == b.alphaType() &&
+           SkColorSpace::Equals(a.colorSpace(), b.colorSpace());
+}
+
+sk_sp<SkSurface> LayerSurfacePool::get(const SkImageInfo& info) {
+    for (auto it = mSurfaces.begin(); it != mSurfaces.end(); it++) {
+        if (matches((*it)->imageInfo(), info)) {
+            sk_sp<SkSurface> surface = std::move(*it);
+            mSurfaces.erase(it);
+            mBytes -= surfaceBytes(*surface);
+            return surface;
+        }
+    }
+    return nullptr;
+}
+
+void LayerSurfacePool::put(sk_sp<SkSurface> surface) {
+    size_t bytes = surfaceBytes(*surface);
+    if (bytes > mMaxBytes) {
+        return;
+    }
+    mSurfaces.push_front(std::move(surface));
+    mBytes += bytes;
+    trim(mMaxBytes);
+}
+
+void LayerSurfacePool::trim(size_t maxBytes) {
+    while (mBytes > maxBytes && !mSurfaces.empty()) {
+        mBytes -= surfaceBytes(*mSurfaces.back());
+        mSurfaces.pop_back();
+    }
+}
+
+} /* namespace skiapipeline */
+} /* namespace uirenderer */
+} /* namespace android */
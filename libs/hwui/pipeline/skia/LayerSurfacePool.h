@@ -0,0 +1,74 @@
+/*
+ * Copyright (C) 2020 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <SkColorSpace.h>
+#include <SkSurface.h>
+
+#include <list>
+
+namespace android {
+namespace uirenderer {
+namespace skiapipeline {
+
+/**
+ * Keeps the surfaces of hardware layers that were recently destroyed or resized, so that a view
+ * that only becomes a layer for the length of an animation can reuse the surface of the previous
+ * one instead of allocating new GPU memory. Layer surfaces are sized on LAYER_SIZE boundaries,
+ * which makes exact size matches common. The least recently released surfaces are dropped once
+ * the pool holds more than its byte budget.
+ *
+ * All the surfaces must belong to the same GrContext, so the pool has to be cleared when that
+ * context is destroyed. This should only be used from the RenderThread.
+ */
+class LayerSurfacePool {
+public:
+    explicit LayerSurfacePool(size_t maxBytes) : mMaxBytes(maxBytes) {}
+
+    /**
+     * Removes and returns a surface matching the given info, or nullptr. The contents of the
+     * returned surface are undefined.
+     */
+    sk_sp<SkSurface> get(const SkImageInfo& info);
+
+    /**
+     * Returns a surface to the pool. The caller must not draw into it afterwards.
+     */
+    void put(sk_sp<SkSurface> surface);
+
+    /**
+     * Drops least recently released surfaces until the pool holds no more than maxBytes.
+     */
+    void trim(size_t maxBytes);
+
+    void clear() { trim(0); }
+
+    size_t getCacheSize() const { return mMaxBytes; }
+    size_t size() const { return mBytes; }
+    size_t count() const { return mSurfaces.size(); }
+
+private:
+    const size_t mMaxBytes;
+    size_t mBytes = 0;
+
+    // Ordered from the most to the least recently released
+    std::list<sk_sp<SkSurface>> mSurfaces;
+};
+
+} /* namespace skiapipeline */
+} /* namespace uirenderer */
+} /* namespace android */
@@ -20,6 +20,7 @@
 #include <openssl/sha.h>
 #include <algorithm>
 #include <array>
+#include <cstring>
 #include <thread>
 #include "FileBlobCache.h"
 #include "Properties.h"
@@ -34,6 +35,9 @@ static const size_t maxKeySize = 1024;
 static const size_t maxValueSize = 512 * 1024;
 static const size_t maxTotalSize = 1024 * 1024;
 
+// The number of shaders whose use counts are saved to disk, and that can be precompiled.
+static const size_t maxRecordedShaders = 64;
+
 ShaderCache::ShaderCache() {
     // There is an "incomplete FileBlobCache type" compilation error, if ctor is moved to header.
 }
@@ -77,7 +81,9 @@ bool ShaderCache::validateCache(const void* identity, ssize_t size) {
 
 void ShaderCache::initShaderDiskCache(const void* identity, ssize_t size) {
     ATRACE_NAME("initShaderDiskCache");
-    std::lock_guard<std::mutex> lock(mMutex);
+    std::unique_lock<std::mutex> lock(mMutex);
+    // The cache that is being written to disk must not go away under the writer.
+    mSaveFinished.wait(lock, [this]() { return !mSaveInProgress; });
 
     // Emulators can switch between different renders either as part of config
     // or snapshot migration. Also, program binaries may not work well on some
@@ -85,10 +91,76 @@ void ShaderCache::initShaderDiskCache(const void* identity, ssize_t size) {
     if (!Properties::runningInEmulator && mFilename.length() > 0) {
         mBlobCache.reset(new FileBlobCache(maxKeySize, maxValueSize, maxTotalSize, mFilename));
         validateCache(identity, size);
+        loadUsageLocked();
         mInitialized = true;
     }
 }
 
+void ShaderCache::loadUsageLocked() {
+    mUsageCounts.clear();
+    mPrecompileKeys.clear();
+    mNextPrecompileKey = 0;
+
+    auto key = sUsageKey;
+    size_t size = mBlobCache->get(&key, sizeof(key), nullptr, 0);
+    if (size == 0) {
+        return;
+    }
+    std::vector<uint8_t> usage(size);
+    if (mBlobCache->get(&key, sizeof(key), usage.data(), size) != size) {
+        return;
+    }
+
+    // Each entry is a use count and a key size followed by the key.
+    const uint8_t* data = usage.data();
+    const uint8_t* end = data + size;
+    while (size_t(end - data) >= 2 * sizeof(uint32_t)) {
+        uint32_t count, keySize;
+        memcpy(&count, data, sizeof(count));
+        memcpy(&keySize, data + sizeof(count), sizeof(keySize));
+        data += 2 * sizeof(uint32_t);
+        if (keySize == 0 || keySize > maxKeySize || keySize > size_t(end - data)) {
+            ALOGW("ShaderCache::loadUsageLocked corrupt shader use counts");
+            break;
+        }
+        std::string shaderKey(reinterpret_cast<const char*>(data), keySize);
+        data += keySize;
+        // Counts from previous runs are halved, so that shaders that are no longer used
+        // eventually make room for the ones that are.
+        mUsageCounts[shaderKey] = std::max(count / 2, 1u);
+        mPrecompileKeys.push_back(std::move(shaderKey));
+    }
+}
+
+void ShaderCache::saveUsageLocked() {
+    std::vector<std::pair<const std::string*, uint32_t>> entries;
+    entries.reserve(mUsageCounts.size());
+    for (const auto& [key, count] : mUsageCounts) {
+        entries.emplace_back(&key, count);
+    }
+    size_t count = std::min(entries.size(), maxRecordedShaders);
+    std::partial_sort(entries.begin(), entries.begin() + count, entries.end(),
+                      [](const auto& a, const auto& b) { return a.second > b.second; });
+
+    std::vector<uint8_t> usage;
+    for (size_t i = 0; i < count; i++) {
+        uint32_t useCount = entries[i].second;
+        uint32_t keySize = entries[i].first->size();
+        if (usage.size() + 2 * sizeof(uint32_t) + keySize >= maxValueSize) {
+            break;
+        }
+        size_t offset = usage.size();
+        usage.resize(offset + 2 * sizeof(uint32_t) + keySize);
+        memcpy(usage.data() + offset, &useCount, sizeof(useCount));
+        memcpy(usage.data() + offset + sizeof(useCount), &keySize, sizeof(keySize));
+        memcpy(usage.data() + offset + 2 * sizeof(uint32_t), entries[i].first->data(), keySize);
+    }
+    if (!usage.empty()) {
+        auto key = sUsageKey;
+        mBlobCache->set(&key, sizeof(key), usage.data(), usage.size());
+    }
+}
+
 void ShaderCache::setFilename(const char* filename) {
     std::lock_guard<std::mutex> lock(mMutex);
     mFilename = filename;
@@ -101,12 +173,26 @@ BlobCache* ShaderCache::getBlobCacheLocked() {
 
 sk_sp<SkData> ShaderCache::load(const SkData& key) {
     ATRACE_NAME("ShaderCache::load");
-    size_t keySize = key.size();
     std::lock_guard<std::mutex> lock(mMutex);
     if (!mInitialized) {
         return nullptr;
     }
 
+    sk_sp<SkData> value = loadLocked(key.data(), key.size());
+    if (value) {
+        mUsageCounts[std::string(static_cast<const char*>(key.data()), key.size())]++;
+    }
+    return value;
+}
+
+sk_sp<SkData> ShaderCache::loadLocked(const void* key, size_t keySize) {
+    // Entries stored while the cache is written to disk are not in mBlobCache yet.
+    for (auto it = mStoresDuringSave.rbegin(); it != mStoresDuringSave.rend(); ++it) {
+        if (it->first->size() == keySize && !memcmp(it->first->data(), key, keySize)) {
+            return it->second;
+        }
+    }
+
     // mObservedBlobValueSize is reasonably big to avoid memory reallocation
     // Allocate a buffer with malloc. SkData takes ownership of that allocation and will call free.
     void* valueBuffer = malloc(mObservedBlobValueSize);
@@ -114,7 +200,7 @@ sk_sp<SkData> ShaderCache::load(const SkData& key) {
         return nullptr;
     }
     BlobCache* bc = getBlobCacheLocked();
-    size_t valueSize = bc->get(key.data(), keySize, valueBuffer, mObservedBlobValueSize);
+    size_t valueSize = bc->get(key, keySize, valueBuffer, mObservedBlobValueSize);
     int maxTries = 3;
     while (valueSize > mObservedBlobValueSize && maxTries > 0) {
         mObservedBlobValueSize = std::min(valueSize, maxValueSize);
@@ -124,7 +210,7 @@ sk_sp<SkData> ShaderCache::load(const SkData& key) {
             return nullptr;
         }
         valueBuffer = newValueBuffer;
-        valueSize = bc->get(key.data(), keySize, valueBuffer, mObservedBlobValueSize);
+        valueSize = bc->get(key, keySize, valueBuffer, mObservedBlobValueSize);
         maxTries--;
     }
     if (!valueSize) {
@@ -139,16 +225,59 @@ sk_sp<SkData> ShaderCache::load(const SkData& key) {
     return SkData::MakeFromMalloc(valueBuffer, valueSize);
 }
 
-void ShaderCache::saveToDiskLocked() {
+void ShaderCache::saveToDiskLocked(std::unique_lock<std::mutex>& lock) {
     ATRACE_NAME("ShaderCache::saveToDiskLocked");
-    if (mInitialized && mBlobCache && mSavePending) {
-        if (mIDHash.size()) {
-            auto key = sIDKey;
-            mBlobCache->set(&key, sizeof(key), mIDHash.data(), mIDHash.size());
-        }
-        mBlobCache->writeToFile();
+    mSaveFinished.wait(lock, [this]() { return !mSaveInProgress; });
+    if (!mInitialized || !mBlobCache || !mSavePending) {
+        mSavePending = false;
+        return;
     }
+
+    if (mIDHash.size()) {
+        auto key = sIDKey;
+        mBlobCache->set(&key, sizeof(key), mIDHash.data(), mIDHash.size());
+    }
+    saveUsageLocked();
+
+    // Serializing and writing a large cache takes long enough to hitch a frame that is waiting
+    // for load or store, so the lock is dropped. mBlobCache is not modified until the write is
+    // done, which makes it a consistent snapshot for the writer.
+    mSaveInProgress = true;
+    lock.unlock();
+    mBlobCache->writeToFile();
+    lock.lock();
+    mSaveInProgress = false;
+    mSaveFinished.notify_all();
+
+    bool storedDuringSave = !mStoresDuringSave.empty();
+    for (const auto& [key, value] : mStoresDuringSave) {
+        mBlobCache->set(key->data(), key->size(), value->data(), value->size());
+    }
+    mStoresDuringSave.clear();
     mSavePending = false;
+    if (storedDuringSave) {
+        scheduleDeferredSaveLocked();
+    }
+}
+
+void ShaderCache::scheduleDeferredSaveLocked() {
+    if (mSavePending || mDeferredSaveDelay == 0) {
+        return;
+    }
+    mSavePending = true;
+    std::thread deferredSaveThread([this]() {
+        sleep(mDeferredSaveDelay);
+        std::unique_lock<std::mutex> lock(mMutex);
+        // Store file on disk if there a new shader or Vulkan pipeline cache size changed.
+        if (mCacheDirty || mNewPipelineCacheSize != mOldPipelineCacheSize) {
+            // Reset before the write, so that stores made while it runs are not forgotten.
+            mOldPipelineCacheSize = mNewPipelineCacheSize;
+            mTryToStorePipelineCache = false;
+            mCacheDirty = false;
+            saveToDiskLocked(lock);
+        }
+    });
+    deferredSaveThread.detach();
 }
 
 void ShaderCache::store(const SkData& key, const SkData& data) {
@@ -181,29 +310,49 @@ void ShaderCache::store(const SkData& key, const SkData& data) {
         }
         mNewPipelineCacheSize = valueSize;
     } else {
+        mUsageCounts[std::string(static_cast<const char*>(key.data()), keySize)]++;
         mCacheDirty = true;
         // If there are new shaders compiled, we probably have new pipeline state too.
         // Store pipeline cache on the next flush.
         mNewPipelineCacheSize = -1;
         mTryToStorePipelineCache = true;
     }
+    if (mSaveInProgress) {
+        mStoresDuringSave.emplace_back(SkData::MakeWithCopy(key.data(), keySize),
+                                       SkData::MakeWithCopy(value, valueSize));
+        return;
+    }
     bc->set(key.data(), keySize, value, valueSize);
 
-    if (!mSavePending && mDeferredSaveDelay > 0) {
-        mSavePending = true;
-        std::thread deferredSaveThread([this]() {
-            sleep(mDeferredSaveDelay);
-            std::lock_guard<std::mutex> lock(mMutex);
-            // Store file on disk if there a new shader or Vulkan pipeline cache size changed.
-            if (mCacheDirty || mNewPipelineCacheSize != mOldPipelineCacheSize) {
-                saveToDiskLocked();
-                mOldPipelineCacheSize = mNewPipelineCacheSize;
-                mTryToStorePipelineCache = false;
-                mCacheDirty = false;
+    scheduleDeferredSaveLocked();
+}
+
+bool ShaderCache::precompileShaders(GrContext* context, size_t maxCount) {
+    ATRACE_NAME("ShaderCache::precompileShaders");
+    std::vector<std::pair<sk_sp<SkData>, sk_sp<SkData>>> shaders;
+    bool morePending;
+    {
+        std::lock_guard<std::mutex> lock(mMutex);
+        if (!mInitialized) {
+            return false;
+        }
+        while (shaders.size() < maxCount && mNextPrecompileKey < mPrecompileKeys.size()) {
+            const std::string& key = mPrecompileKeys[mNextPrecompileKey++];
+            // The shader may have been evicted from the cache since its use was recorded.
+            sk_sp<SkData> value = loadLocked(key.data(), key.size());
+            if (value) {
+                shaders.emplace_back(SkData::MakeWithCopy(key.data(), key.size()),
+                                     std::move(value));
             }
-        });
-        deferredSaveThread.detach();
+        }
+        morePending = mNextPrecompileKey < mPrecompileKeys.size();
+    }
+
+    // Compile without holding the lock, so that other threads can use the cache meanwhile.
+    for (const auto& [key, value] : shaders) {
+        context->precompileShader(*key, *value);
     }
+    return morePending;
 }
 
 void ShaderCache::onVkFrameFlushed(GrContext* context) {
@@ -18,9 +18,11 @@
 
 #include <GrContextOptions.h>
 #include <cutils/compiler.h>
+#include <condition_variable>
 #include <memory>
 #include <mutex>
 #include <string>
+#include <unordered_map>
 #include <vector>
 
 namespace android {
@@ -82,6 +84,14 @@ public:
      */
     void onVkFrameFlushed(GrContext* context);
 
+    /**
+     * "precompileShaders" compiles up to maxCount of the shaders that were used most often in
+     * previous program invocations, most used first, so that they are ready before a frame
+     * needs them. It returns true if there are shaders left to compile. When the cache is
+     * (re)initialized it starts again from the most used shader.
+     */
+    bool precompileShaders(GrContext* context, size_t maxCount);
+
 private:
     // Creation and (the lack of) destruction is handled internally.
     ShaderCache();
@@ -98,6 +108,24 @@ private:
      */
     BlobCache* getBlobCacheLocked();
 
+    /**
+     * "loadLocked" returns the value blob associated with the given key, or nullptr if there is
+     * none. Unlike "load" it does not count the lookup as a use of the shader.
+     */
+    sk_sp<SkData> loadLocked(const void* key, size_t keySize);
+
+    /**
+     * "loadUsageLocked" reads the shader use counts saved by "saveUsageLocked" and queues the
+     * recorded shaders for "precompileShaders".
+     */
+    void loadUsageLocked();
+
+    /**
+     * "saveUsageLocked" inserts the keys and use counts of the most used shaders into the cache,
+     * so that they are written to disk along with the shaders.
+     */
+    void saveUsageLocked();
+
     /**
      * "validateCache" updates the cache to match the given identity.  If the
      * cache currently has the wrong identity, all entries in the cache are cleared.
@@ -107,9 +135,16 @@ private:
     /**
      * "saveToDiskLocked" attemps to save the current contents of the cache to
      * disk. If the identity hash exists, we will insert the identity hash into
-     * the cache for next validation.
+     * the cache for next validation. The lock is released while the file is
+     * written; entries stored in the meantime are inserted once it is done.
      */
-    void saveToDiskLocked();
+    void saveToDiskLocked(std::unique_lock<std::mutex>& lock);
+
+    /**
+     * "scheduleDeferredSaveLocked" starts a thread that saves the cache to disk
+     * after mDeferredSaveDelay, unless a save is already pending.
+     */
+    void scheduleDeferredSaveLocked();
 
     /**
      * "mInitialized" indicates whether the ShaderCache is in the initialized
@@ -157,6 +192,16 @@ private:
      */
     bool mSavePending = false;
 
+    /**
+     * "mSaveInProgress" is true while the cache is being written to disk without
+     * holding mMutex. mBlobCache is only read until then, and the entries stored
+     * meanwhile are kept in "mStoresDuringSave". "mSaveFinished" is notified when
+     * the write is done.
+     */
+    bool mSaveInProgress = false;
+    std::vector<std::pair<sk_sp<SkData>, sk_sp<SkData>>> mStoresDuringSave;
+    std::condition_variable mSaveFinished;
+
     /**
      *  "mObservedBlobValueSize" is the maximum value size observed by the cache reading function.
      */
@@ -200,6 +245,19 @@ private:
      */
     bool mCacheDirty = false;
 
+    /**
+     * "mUsageCounts" maps the key of each shader to the number of times it was loaded or stored,
+     * including the counts carried over from previous program invocations.
+     */
+    std::unordered_map<std::string, uint32_t> mUsageCounts;
+
+    /**
+     * "mPrecompileKeys" holds the keys of the shaders "precompileShaders" compiles, most used
+     * first, and "mNextPrecompileKey" the index of the next one to compile.
+     */
+    std::vector<std::string> mPrecompileKeys;
+    size_t mNextPrecompileKey = 0;
+
     /**
      * "sCache" is the singleton ShaderCache object.
      */
@@ -210,6 +268,11 @@ private:
      */
     static constexpr uint8_t sIDKey = 0;
 
+    /**
+     * "sUsageKey" is the cache key of the shader use counts
+     */
+    static constexpr uint8_t sUsageKey = 1;
+
     friend class ShaderCacheTestUtils;  // used for unit testing
 };
 
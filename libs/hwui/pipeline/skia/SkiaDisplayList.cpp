@@ -26,17 +26,84 @@
 #include "VectorDrawable.h"
 #ifdef __ANDROID__
 #include "renderthread/CanvasContext.h"
+#include "thread/CommonPool.h"
+#include "utils/TraceUtils.h"
 #endif
 
 #include <SkImagePriv.h>
 #include <SkPathOps.h>
 
+#include <algorithm>
+#include <array>
+#include <future>
+#include <vector>
+
 namespace android {
 namespace uirenderer {
 namespace skiapipeline {
 
-void SkiaDisplayList::syncContents(const WebViewSyncData& data) {
+#ifdef __ANDROID__ // Layoutlib does not support CommonPool
+namespace {
+
+// Below this many nodes in the subtrees that can be handed off, the cost of waking up the
+// workers outweighs the cost of preparing the subtrees on the RenderThread.
+constexpr int kMinParallelPrepareNodes = 64;
+
+class CollectingTreeObserver : public TreeObserver {
+public:
+    explicit CollectingTreeObserver(std::vector<sp<RenderNode>>* nodes) : mNodes(nodes) {}
+
+    void onMaybeRemovedFromTree(RenderNode* node) override { mNodes->emplace_back(node); }
+
+private:
+    std::vector<sp<RenderNode>>* mNodes;
+};
+
+// The children of a display list prepared by one CommonPool worker. The worker has its own
+// TreeInfo and DamageAccumulator, and everything it would have handed to the RenderThread's
+// state is collected here and applied once the worker has been joined.
+struct PrepareBatch {
+    std::vector<RenderNodeDrawable*> children;
+    int nodeCount = 0;
+    std::unique_ptr<TreeInfo> info;
+    DamageAccumulator damageAccumulator;
+    std::vector<sp<RenderNode>> maybeRemoved;
+    std::vector<std::pair<RenderNode*, SkiaDisplayList*>> retiredDisplayLists;
+};
+
+void prepareBatch(PrepareBatch& batch, bool functorsNeedLayer,
+                  const std::function<void(RenderNode*, TreeObserver&, TreeInfo&, bool)>& childFn) {
+    ATRACE_NAME("prepareTree worker");
+    CollectingTreeObserver observer(&batch.maybeRemoved);
+    for (RenderNodeDrawable* child : batch.children) {
+        Matrix4 mat4(child->getRecordedMatrix());
+        batch.damageAccumulator.pushTransform(&mat4);
+        batch.info->hasBackwardProjectedNodes = false;
+        childFn(child->getRenderNode(), observer, *batch.info, functorsNeedLayer);
+        batch.damageAccumulator.popTransform();
+    }
+}
+
+}  // namespace
+#endif
+
+void SkiaDisplayList::syncContents(const WebViewSyncData& data,
+                                   std::vector<std::future<void>>* pendingSyncs) {
+    if (Properties::elideDisplayListNoOps) {
+        mDisplayList.elideNoOps();
+    }
     for (auto& functor : mChildFunctors) {
+#ifdef __ANDROID__ // Layoutlib does not support CommonPool
+        if (pendingSyncs) {
+            // The handle keeps the functor alive even if this display list goes away before
+            // the sync has run.
+            if (sp<WebViewFunctor::Handle> handle = functor->concurrentSyncHandle()) {
+                pendingSyncs->push_back(CommonPool::async(
+                        [handle, data]() { handle->sync(data); }, CommonPool::Priority::High));
+                continue;
+            }
+        }
+#endif
         functor->syncFunctor(data);
     }
     for (auto& animatedImage : mAnimatedImages) {
@@ -101,8 +168,7 @@ bool SkiaDisplayList::prepareListAndChildren(
     bool hasBackwardProjectedNodesHere = false;
     bool hasBackwardProjectedNodesSubtree = false;
 
-    for (auto& child : mChildNodes) {
-        hasBackwardProjectedNodesHere |= child.getNodeProperties().getProjectBackwards();
+    auto prepareChild = [&](RenderNodeDrawable& child) {
         RenderNode* childNode = child.getRenderNode();
         Matrix4 mat4(child.getRecordedMatrix());
         info.damageAccumulator->pushTransform(&mat4);
@@ -110,6 +176,114 @@ bool SkiaDisplayList::prepareListAndChildren(
         childFn(childNode, observer, info, functorsNeedLayer);
         hasBackwardProjectedNodesSubtree |= info.hasBackwardProjectedNodes;
         info.damageAccumulator->popTransform();
+    };
+
+#ifdef __ANDROID__ // Layoutlib does not support CommonPool
+    // Child subtrees that are independent of each other and of the RenderThread are split
+    // between CommonPool workers and this thread. The other children may reach nodes in those
+    // subtrees, e.g. through a newly recorded drawRenderNode, so they are only prepared once
+    // the workers are done.
+    std::unique_ptr<std::array<PrepareBatch, CommonPool::THREAD_COUNT>> batches;
+    std::vector<bool> isIndependent;
+    if (info.allowParallelPrepare && info.mode == TreeInfo::MODE_FULL && mChildNodes.size() > 1) {
+        std::vector<std::pair<int, size_t>> candidates;
+        int candidateNodes = 0;
+        for (size_t i = 0; i < mChildNodes.size(); i++) {
+            int size = mChildNodes[i].getRenderNode()->parallelPrepareSubtreeSize();
+            if (size > 0) {
+                candidates.emplace_back(size, i);
+                candidateNodes += size;
+            }
+        }
+
+        if (candidateNodes >= kMinParallelPrepareNodes) {
+            batches = std::make_unique<std::array<PrepareBatch, CommonPool::THREAD_COUNT>>();
+            isIndependent.resize(mChildNodes.size(), false);
+            std::vector<bool> preparedByWorker(mChildNodes.size(), false);
+
+            // Largest subtrees first, each to whichever of the workers or this thread has the
+            // least work so far.
+            std::sort(candidates.begin(), candidates.end(), std::greater<>());
+            int renderThreadNodes = 0;
+            for (auto& [size, index] : candidates) {
+                isIndependent[index] = true;
+                auto lightest = std::min_element(batches->begin(), batches->end(),
+                                                 [](const PrepareBatch& a, const PrepareBatch& b) {
+                                                     return a.nodeCount < b.nodeCount;
+                                                 });
+                if (renderThreadNodes <= lightest->nodeCount) {
+                    renderThreadNodes += size;
+                    continue;
+                }
+                lightest->children.push_back(&mChildNodes[index]);
+                lightest->nodeCount += size;
+                preparedByWorker[index] = true;
+            }
+
+            std::vector<std::future<void>> pending;
+            for (auto& batch : *batches) {
+                if (batch.children.empty()) {
+                    continue;
+                }
+                batch.info = std::make_unique<TreeInfo>(info.mode, info.canvasContext);
+                TreeInfo& batchInfo = *batch.info;
+                batchInfo.prepareTextures = info.prepareTextures;
+                batchInfo.runAnimations = info.runAnimations;
+                batchInfo.damageAccumulator = &batch.damageAccumulator;
+                batchInfo.damageGenerationId = info.damageGenerationId;
+                batchInfo.layerUpdateQueue = info.layerUpdateQueue;
+                batchInfo.errorHandler = info.errorHandler;
+                batchInfo.updateWindowPositions = info.updateWindowPositions;
+                batchInfo.disableForceDark = info.disableForceDark;
+                batchInfo.allowParallelPrepare = false;
+                batchInfo.retiredDisplayLists = &batch.retiredDisplayLists;
+                pending.push_back(CommonPool::async(
+                        [&batch, functorsNeedLayer, &childFn]() {
+                            prepareBatch(batch, functorsNeedLayer, childFn);
+                        },
+                        CommonPool::Priority::High));
+            }
+
+            for (size_t i = 0; i < mChildNodes.size(); i++) {
+                if (isIndependent[i] && !preparedByWorker[i]) {
+                    prepareChild(mChildNodes[i]);
+                }
+            }
+
+            for (auto& future : pending) {
+                future.get();
+            }
+            for (auto& batch : *batches) {
+                // The worker's root frame stands in for this list's frame, so its damage
+                // applies here unchanged. Independent subtrees have no backward projected
+                // nodes.
+                SkRect dirty;
+                batch.damageAccumulator.peekAtDirty(&dirty);
+                if (!dirty.isEmpty()) {
+                    info.damageAccumulator->dirty(dirty.fLeft, dirty.fTop, dirty.fRight,
+                                                  dirty.fBottom);
+                }
+                for (auto& node : batch.maybeRemoved) {
+                    observer.onMaybeRemovedFromTree(node.get());
+                }
+                for (auto& [node, displayList] : batch.retiredDisplayLists) {
+                    if (!displayList->reuseDisplayList(node, &info.canvasContext)) {
+                        delete displayList;
+                    }
+                }
+            }
+        }
+    }
+#endif
+
+    for (size_t i = 0; i < mChildNodes.size(); i++) {
+        hasBackwardProjectedNodesHere |= mChildNodes[i].getNodeProperties().getProjectBackwards();
+#ifdef __ANDROID__ // Layoutlib does not support CommonPool
+        if (!isIndependent.empty() && isIndependent[i]) {
+            continue;
+        }
+#endif
+        prepareChild(mChildNodes[i]);
     }
 
     // The purpose of next block of code is to reset projected display list if there are no
@@ -168,11 +342,16 @@ void SkiaDisplayList::reset() {
     mChildFunctors.clear();
     mChildNodes.clear();
 
-    allocator.~LinearAllocator();
-    new (&allocator) LinearAllocator();
+    // Keep the allocator's pages for the next recording of this node, which is usually of a
+    // similar size.
+    allocator.reset();
 }
 
 void SkiaDisplayList::output(std::ostream& output, uint32_t level) {
+    if (mDisplayList.elidedOpCount()) {
+        output << std::string((level + 1) * 2, ' ') << "(" << mDisplayList.elidedOpCount()
+               << " of " << mDisplayList.opCount() << " ops elided)" << std::endl;
+    }
     DumpOpsCanvas canvas(output, level, *this);
     mDisplayList.draw(&canvas);
 }
@@ -93,6 +93,15 @@ public:
 
     bool hasText() const { return mDisplayList.hasText(); }
 
+    /**
+     * Returns true if syncing or preparing this list needs the RenderThread, either because it
+     * talks to the CanvasContext or because its drawables may be shared with other lists.
+     */
+    bool hasRenderThreadContent() const {
+        return hasFunctor() || !mMutableImages.empty() || !mVectorDrawables.empty() ||
+               !mAnimatedImages.empty();
+    }
+
     /**
      * Attempts to reset and reuse this DisplayList.
      *
@@ -104,10 +113,14 @@ public:
      * ONLY to be called by RenderNode::syncDisplayList so that we can notify any
      * contained VectorDrawables or GLFunctors to sync their state.
      *
+     * Functors that sync concurrently are started on CommonPool and added to pendingSyncs
+     * if it is given, otherwise they are synced inline like the others.
+     *
      * NOTE: This function can be folded into RenderNode when we no longer need
      *       to subclass from DisplayList
      */
-    void syncContents(const WebViewSyncData& data);
+    void syncContents(const WebViewSyncData& data,
+                      std::vector<std::future<void>>* pendingSyncs = nullptr);
 
     /**
      * ONLY to be called by RenderNode::prepareTree in order to prepare this
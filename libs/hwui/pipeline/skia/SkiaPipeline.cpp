@@ -31,6 +31,7 @@
 
 #include <sstream>
 
+#include "LayerSurfacePool.h"
 #include "LightingInfo.h"
 #include "VectorDrawable.h"
 #include "thread/CommonPool.h"
@@ -168,11 +169,20 @@ bool SkiaPipeline::createOrUpdateLayer(RenderNode* node, const DamageAccumulator
         SkImageInfo info;
         info = SkImageInfo::Make(surfaceWidth, surfaceHeight, getSurfaceColorType(),
                                  kPremul_SkAlphaType, getSurfaceColorSpace());
-        SkSurfaceProps props(0, kUnknown_SkPixelGeometry);
-        SkASSERT(mRenderThread.getGrContext() != nullptr);
-        node->setLayerSurface(SkSurface::MakeRenderTarget(mRenderThread.getGrContext(),
-                                                          SkBudgeted::kYes, info, 0,
-                                                          this->getSurfaceOrigin(), &props));
+        sk_sp<SkSurface> surface;
+        if (Properties::poolLayerSurfaces) {
+            if (layer) {
+                destroyLayer(node);
+            }
+            surface = mRenderThread.cacheManager().layerSurfacePool().get(info);
+        }
+        if (!surface) {
+            SkSurfaceProps props(0, kUnknown_SkPixelGeometry);
+            SkASSERT(mRenderThread.getGrContext() != nullptr);
+            surface = SkSurface::MakeRenderTarget(mRenderThread.getGrContext(), SkBudgeted::kYes,
+                                                  info, 0, this->getSurfaceOrigin(), &props);
+        }
+        node->setLayerSurface(std::move(surface));
         if (node->getLayerSurface()) {
             // update the transform in window of the layer to reset its origin wrt light source
             // position
@@ -199,6 +209,13 @@ bool SkiaPipeline::createOrUpdateLayer(RenderNode* node, const DamageAccumulator
     return false;
 }
 
+void SkiaPipeline::destroyLayer(RenderNode* node) {
+    if (Properties::poolLayerSurfaces && node->getLayerSurface()) {
+        mRenderThread.cacheManager().layerSurfacePool().put(sk_ref_sp(node->getLayerSurface()));
+    }
+    node->setLayerSurface(nullptr);
+}
+
 void SkiaPipeline::prepareToDraw(const RenderThread& thread, Bitmap* bitmap) {
     GrContext* context = thread.getGrContext();
     if (context) {
@@ -224,7 +241,7 @@ static void savePictureAsync(const sk_sp<SkData>& data, const std::string& filen
             ALOGD("SKP Captured Drawing Output (%zu bytes) for frame. %s", stream.bytesWritten(),
                      filename.c_str());
         }
-    });
+    }, CommonPool::Priority::Low);
 }
 
 // Note multiple SkiaPipeline instances may be loaded if more than one app is visible.
@@ -402,7 +419,7 @@ void SkiaPipeline::endCapture(SkSurface* surface) {
                 doc->close();
                 delete stream;
                 ALOGD("Multi frame SKP complete.");
-            });
+            }, CommonPool::Priority::Low);
         }
     } else {
         sk_sp<SkPicture> picture = mRecorder->finishRecordingAsPicture();
@@ -0,0 +1,71 @@
+/*
+ * Copyright (C) 2020 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "VectorDrawableCache.h"
+
+namespace android {
+namespace uirenderer {
+namespace skiapipeline {
+
+sk_sp<Bitmap> VectorDrawableCache::get(const std::string& key) {
+    auto found = mIndex.find(key);
+    if (found == mIndex.end()) {
+        return nullptr;
+    }
+    mEntries.splice(mEntries.begin(), mEntries, found->second);
+    return found->second->bitmap;
+}
+
+void VectorDrawableCache::put(const std::string& key, sk_sp<Bitmap> bitmap) {
+    auto found = mIndex.find(key);
+    if (found != mIndex.end()) {
+        removeEntry(found->second);
+    }
+    size_t bytes = bitmap->getAllocationByteCount();
+    if (bytes > mMaxBytes) {
+        return;
+    }
+    mEntries.push_front({key, std::move(bitmap), bytes});
+    mIndex.emplace(key, mEntries.begin());
+    mBytes += bytes;
+    trim(mMaxBytes);
+}
+
+void VectorDrawableCache::trim(size_t maxBytes) {
+    while (mBytes > maxBytes && !mEntries.empty()) {
+        removeEntry(std::prev(mEntries.end()));
+    }
+}
+
+void VectorDrawableCache::trimUnused() {
+    for (auto entry = mEntries.begin(); entry != mEntries.end();) {
+        auto next = std::next(entry);
+        if (entry->bitmap->unique()) {
+            removeEntry(entry);
+        }
+        entry = next;
+    }
+}
+
+void VectorDrawableCache::removeEntry(std::list<Entry>::iterator entry) {
+    mBytes -= entry->bytes;
+    mIndex.erase(entry->key);
+    mEntries.erase(entry);
+}
+
+} /* namespace skiapipeline */
+} /* namespace uirenderer */
+} /* namespace android */
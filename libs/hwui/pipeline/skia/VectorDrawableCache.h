@@ -0,0 +1,89 @@
+/*
+ * Copyright (C) 2020 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include "hwui/Bitmap.h"
+
+#include <list>
+#include <string>
+#include <unordered_map>
+
+namespace android {
+namespace uirenderer {
+namespace skiapipeline {
+
+/**
+ * Holds the rasterized contents of vector drawable trees so that identical trees drawn at the
+ * same size share a single bitmap, and therefore a single texture on the GPU. Entries are keyed by
+ * the full description of a tree's contents as built by VectorDrawable::Tree, so two trees only
+ * ever share a bitmap when they would rasterize to the same pixels. The least recently used
+ * entries are evicted once the cache holds more than its byte budget.
+ *
+ * This should only be used from the RenderThread.
+ */
+class VectorDrawableCache {
+public:
+    explicit VectorDrawableCache(size_t maxBytes) : mMaxBytes(maxBytes) {}
+
+    /**
+     * Returns the bitmap stored for the given key, or nullptr. A returned bitmap must not be
+     * drawn into, as other trees may be using it.
+     */
+    sk_sp<Bitmap> get(const std::string& key);
+
+    /**
+     * Stores a bitmap for the given key, replacing any existing entry. The caller must not draw
+     * into the bitmap afterwards.
+     */
+    void put(const std::string& key, sk_sp<Bitmap> bitmap);
+
+    /**
+     * Evicts least recently used entries until the cache holds no more than maxBytes.
+     */
+    void trim(size_t maxBytes);
+
+    /**
+     * Evicts the entries whose bitmap is no longer used by any tree.
+     */
+    void trimUnused();
+
+    void clear() { trim(0); }
+
+    size_t getCacheSize() const { return mMaxBytes; }
+    size_t size() const { return mBytes; }
+    size_t count() const { return mEntries.size(); }
+
+private:
+    struct Entry {
+        std::string key;
+        sk_sp<Bitmap> bitmap;
+        size_t bytes;
+    };
+
+    void removeEntry(std::list<Entry>::iterator entry);
+
+    const size_t mMaxBytes;
+    size_t mBytes = 0;
+
+    // Ordered from the most to the least recently used
+    std::list<Entry> mEntries;
+    std::unordered_map<std::string, std::list<Entry>::iterator> mIndex;
+};
+
+} /* namespace skiapipeline */
+} /* namespace uirenderer */
+} /* namespace android */
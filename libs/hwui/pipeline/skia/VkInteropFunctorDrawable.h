@@ -40,6 +40,9 @@ public:
 
     void syncFunctor(const WebViewSyncData& data) const override;
 
+    // Syncs need a draw request held on the RenderThread, so they are never concurrent.
+    sp<WebViewFunctor::Handle> concurrentSyncHandle() const override { return nullptr; }
+
 protected:
     virtual void onDraw(SkCanvas* canvas) override;
 
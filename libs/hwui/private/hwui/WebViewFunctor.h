@@ -73,6 +73,16 @@ ANDROID_API int WebViewFunctor_create(void* data, const WebViewFunctorCallbacks&
 // and it should be considered alive & active until that point.
 ANDROID_API void WebViewFunctor_release(int functor);
 
+// Opts the functor in to having onSync called on a worker thread, concurrently with the
+// rest of the RenderThread's sync. The RenderThread still waits for onSync to return before
+// the UI thread is unblocked. May be called on any thread.
+ANDROID_API void WebViewFunctor_setConcurrentSync(int functor, bool concurrent);
+
+// Reports how long the GPU spent on the functor's latest draw, so that it shows up in the
+// renderer's frame stage timings. May be called on any thread, including once the GPU
+// work has completed.
+ANDROID_API void WebViewFunctor_reportGpuTime(int functor, int64_t gpuTimeNanos);
+
 }  // namespace android::uirenderer
 
 #endif  // FRAMEWORKS_BASE_WEBVIEWFUNCTOR_H
@@ -21,8 +21,10 @@
 #include "Properties.h"
 #include "RenderThread.h"
 #include "pipeline/skia/ATraceMemoryDump.h"
+#include "pipeline/skia/LayerSurfacePool.h"
 #include "pipeline/skia/ShaderCache.h"
 #include "pipeline/skia/SkiaMemoryTracer.h"
+#include "pipeline/skia/VectorDrawableCache.h"
 #include "renderstate/RenderState.h"
 #include "thread/CommonPool.h"
 #include <utils/Trace.h>
@@ -32,6 +34,7 @@
 #include <SkGraphics.h>
 #include <SkMathPriv.h>
 #include <math.h>
+#include <sys/sysinfo.h>
 #include <set>
 
 namespace android {
@@ -44,10 +47,29 @@ namespace renderthread {
 // be ARGB_8888.
 #define SURFACE_SIZE_MULTIPLIER (12.0f * 4.0f)
 #define BACKGROUND_RETENTION_PERCENTAGE (0.5f)
+// Enough shared vector drawable rasters to cover the screen once.
+#define VECTOR_DRAWABLE_CACHE_SIZE_MULTIPLIER (1.0f * 4.0f)
+// Enough released layer surfaces for a transition between two full screen layers.
+#define LAYER_SURFACE_POOL_SIZE_MULTIPLIER (2.0f * 4.0f)
+// The resource cache is never capped below a couple of full screen ARGB_8888 buffers, or every
+// frame that uses an offscreen layer would have to allocate it again.
+#define MIN_SURFACE_SIZE_MULTIPLIER (2.0f * 4.0f)
+
+static size_t computeMaxResourceBytes(size_t maxSurfaceArea) {
+    size_t maxBytes = maxSurfaceArea * SURFACE_SIZE_MULTIPLIER;
+    struct sysinfo info;
+    if (Properties::cacheMaxRamPercent > 0 && sysinfo(&info) == 0) {
+        uint64_t totalRam = static_cast<uint64_t>(info.totalram) * info.mem_unit;
+        size_t ramBytes = totalRam * Properties::cacheMaxRamPercent / 100;
+        size_t minBytes = maxSurfaceArea * MIN_SURFACE_SIZE_MULTIPLIER;
+        maxBytes = std::max(minBytes, std::min(maxBytes, ramBytes));
+    }
+    return maxBytes;
+}
 
 CacheManager::CacheManager()
         : mMaxSurfaceArea(DeviceInfo::getWidth() * DeviceInfo::getHeight())
-        , mMaxResourceBytes(mMaxSurfaceArea * SURFACE_SIZE_MULTIPLIER)
+        , mMaxResourceBytes(computeMaxResourceBytes(mMaxSurfaceArea))
         , mBackgroundResourceBytes(mMaxResourceBytes * BACKGROUND_RETENTION_PERCENTAGE)
         // This sets the maximum size for a single texture atlas in the GPU font cache. If
         // necessary, the cache can allocate additional textures that are counted against the
@@ -57,10 +79,16 @@ CacheManager::CacheManager()
         // total number of GPU font caches (i.e. 4 separate GPU atlases).
         , mMaxCpuFontCacheBytes(
                   std::max(mMaxGpuFontAtlasBytes * 4, SkGraphics::GetFontCacheLimit()))
-        , mBackgroundCpuFontCacheBytes(mMaxCpuFontCacheBytes * BACKGROUND_RETENTION_PERCENTAGE) {
+        , mBackgroundCpuFontCacheBytes(mMaxCpuFontCacheBytes * BACKGROUND_RETENTION_PERCENTAGE)
+        , mVectorDrawableCache(new skiapipeline::VectorDrawableCache(
+                  mMaxSurfaceArea * VECTOR_DRAWABLE_CACHE_SIZE_MULTIPLIER))
+        , mLayerSurfacePool(new skiapipeline::LayerSurfacePool(
+                  mMaxSurfaceArea * LAYER_SURFACE_POOL_SIZE_MULTIPLIER)) {
     SkGraphics::SetFontCacheLimit(mMaxCpuFontCacheBytes);
 }
 
+CacheManager::~CacheManager() {}
+
 void CacheManager::reset(sk_sp<GrContext> context) {
     if (context != mGrContext) {
         destroy();
@@ -74,6 +102,7 @@ void CacheManager::reset(sk_sp<GrContext> context) {
 
 void CacheManager::destroy() {
     // cleanup any caches here as the GrContext is about to go away...
+    mLayerSurfacePool->clear();
     mGrContext.reset(nullptr);
 }
 
@@ -97,13 +126,35 @@ void CacheManager::configureContext(GrContextOptions* contextOptions, const void
 }
 
 void CacheManager::trimMemory(TrimMemoryMode mode) {
+    // The shared vector drawable rasters live in CPU memory, and are uploaded like any other
+    // bitmap, so they are trimmed even without a GrContext.
+    if (mode == TrimMemoryMode::Complete) {
+        mVectorDrawableCache->clear();
+    } else if (mode != TrimMemoryMode::RunningLow) {
+        mVectorDrawableCache->trimUnused();
+    }
+
     if (!mGrContext) {
         return;
     }
 
+    // Pooled layer surfaces are only waiting to be reused, like Skia's scratch resources, so
+    // every level releases them.
+    mLayerSurfacePool->clear();
     mGrContext->flush();
 
     switch (mode) {
+        case TrimMemoryMode::RunningLow:
+            // The app is still visible, so keep everything that is expensive to recreate and only
+            // drop the scratch textures and render targets that are waiting to be reused.
+            mGrContext->purgeUnlockedResources(true);
+            break;
+        case TrimMemoryMode::RunningCritical:
+            // Glyphs are cheap to rasterize again compared to the bitmaps an app would have to
+            // upload, so they go next.
+            mGrContext->purgeUnlockedResources(true);
+            SkGraphics::PurgeFontCache();
+            break;
         case TrimMemoryMode::Complete:
             mGrContext->freeGpuResources();
             SkGraphics::PurgeAllCaches();
@@ -126,9 +177,11 @@ void CacheManager::trimMemory(TrimMemoryMode mode) {
 }
 
 void CacheManager::trimStaleResources() {
+    mVectorDrawableCache->trimUnused();
     if (!mGrContext) {
         return;
     }
+    mLayerSurfacePool->clear();
     mGrContext->flush();
     mGrContext->purgeResourcesNotUsedInMs(std::chrono::seconds(30));
 }
@@ -161,6 +214,13 @@ void CacheManager::dumpMemoryUsage(String8& log, const RenderState* renderState)
 
     log.appendFormat("Other Caches:\n");
     log.appendFormat("                         Current / Maximum\n");
+    log.appendFormat("  VectorDrawableCache  %6.2f KB / %6.2f KB (entries = %zu)\n",
+                     mVectorDrawableCache->size() / 1024.0f,
+                     mVectorDrawableCache->getCacheSize() / 1024.0f,
+                     mVectorDrawableCache->count());
+    log.appendFormat("  LayerSurfacePool     %6.2f KB / %6.2f KB (entries = %zu)\n",
+                     mLayerSurfacePool->size() / 1024.0f,
+                     mLayerSurfacePool->getCacheSize() / 1024.0f, mLayerSurfacePool->count());
 
     if (renderState) {
         if (renderState->mActiveLayers.size() > 0) {
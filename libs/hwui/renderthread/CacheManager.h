@@ -22,6 +22,7 @@
 #endif
 #include <SkSurface.h>
 #include <utils/String8.h>
+#include <memory>
 #include <vector>
 
 namespace android {
@@ -32,6 +33,11 @@ namespace uirenderer {
 
 class RenderState;
 
+namespace skiapipeline {
+class LayerSurfacePool;
+class VectorDrawableCache;
+}
+
 namespace renderthread {
 
 class IRenderPipeline;
@@ -39,11 +45,14 @@ class RenderThread;
 
 class CacheManager {
 public:
-    enum class TrimMemoryMode { Complete, UiHidden };
+    // Ordered from the least to the most memory released
+    enum class TrimMemoryMode { RunningLow, RunningCritical, UiHidden, Complete };
 
 #ifdef __ANDROID__ // Layoutlib does not support hardware acceleration
     void configureContext(GrContextOptions* context, const void* identity, ssize_t size);
 #endif
+    ~CacheManager();
+
     void trimMemory(TrimMemoryMode mode);
     void trimStaleResources();
     void dumpMemoryUsage(String8& log, const RenderState* renderState = nullptr);
@@ -52,6 +61,9 @@ public:
     size_t getBackgroundCacheSize() const { return mBackgroundResourceBytes; }
     void onFrameCompleted();
 
+    skiapipeline::VectorDrawableCache& vectorDrawableCache() { return *mVectorDrawableCache; }
+    skiapipeline::LayerSurfacePool& layerSurfacePool() { return *mLayerSurfacePool; }
+
 private:
     friend class RenderThread;
 
@@ -73,6 +85,9 @@ private:
     const size_t mMaxGpuFontAtlasBytes;
     const size_t mMaxCpuFontCacheBytes;
     const size_t mBackgroundCpuFontCacheBytes;
+
+    std::unique_ptr<skiapipeline::VectorDrawableCache> mVectorDrawableCache;
+    std::unique_ptr<skiapipeline::LayerSurfacePool> mLayerSurfacePool;
 };
 
 } /* namespace renderthread */
@@ -32,6 +32,7 @@
 #include "LayerUpdateQueue.h"
 #include "Properties.h"
 #include "RenderThread.h"
+#include "WebViewFunctorManager.h"
 #include "hwui/Canvas.h"
 #include "pipeline/skia/SkiaOpenGLPipeline.h"
 #include "pipeline/skia/SkiaPipeline.h"
@@ -43,6 +44,8 @@
 
 #define TRIM_MEMORY_COMPLETE 80
 #define TRIM_MEMORY_UI_HIDDEN 20
+#define TRIM_MEMORY_RUNNING_CRITICAL 15
+#define TRIM_MEMORY_RUNNING_LOW 10
 
 #define LOG_FRAMETIME_MMA 0
 
@@ -132,6 +135,7 @@ void CanvasContext::removeRenderNode(RenderNode* node) {
 }
 
 void CanvasContext::destroy() {
+    cancelLateDraw();
     stopDrawing();
     setSurface(nullptr);
     freePrefetchedLayers();
@@ -156,6 +160,7 @@ static void setBufferCount(ANativeWindow* window) {
 
 void CanvasContext::setSurface(ANativeWindow* window, bool enableTimeout) {
     ATRACE_CALL();
+    flushLateDraw();
 
     if (mRenderAheadDepth == 0 && DeviceInfo::get()->getMaxRefreshRate() > 66.6f) {
         mFixedRenderAhead = false;
@@ -205,11 +210,13 @@ void CanvasContext::setSwapBehavior(SwapBehavior swapBehavior) {
 }
 
 bool CanvasContext::pauseSurface() {
+    flushLateDraw();
     mGenerationID++;
     return mRenderThread.removeFrameCallback(this);
 }
 
 void CanvasContext::setStopped(bool stopped) {
+    flushLateDraw();
     if (mStopped != stopped) {
         mStopped = stopped;
         if (mStopped) {
@@ -316,6 +323,8 @@ bool CanvasContext::isSwapChainStuffed() {
 void CanvasContext::prepareTree(TreeInfo& info, int64_t* uiFrameInfo, int64_t syncQueued,
                                 RenderNode* target) {
     mRenderThread.removeFrameCallback(this);
+    // A frame still waiting in drawLate is superseded; its damage is drawn with this one.
+    cancelLateDraw();
 
     // If the previous frame was dropped we don't need to hold onto it, so
     // just keep using the previous frame's structure instead
@@ -332,6 +341,9 @@ void CanvasContext::prepareTree(TreeInfo& info, int64_t* uiFrameInfo, int64_t sy
     info.damageGenerationId = mDamageId++;
     info.out.canDrawThisFrame = true;
 
+    std::vector<std::future<void>> functorSyncs;
+    info.pendingFunctorSyncs = &functorSyncs;
+
     mAnimationContext->startFrame(info.mode);
     for (const sp<RenderNode>& node : mRenderNodes) {
         // Only the primary target node will be drawn full - all other nodes would get drawn in
@@ -344,6 +356,16 @@ void CanvasContext::prepareTree(TreeInfo& info, int64_t* uiFrameInfo, int64_t sy
     mAnimationContext->runRemainingAnimations(info);
     GL_CHECKPOINT(MODERATE);
 
+    // Concurrent functor syncs may read UI thread state, so they have to be done before the
+    // UI thread is unblocked.
+    if (!functorSyncs.empty()) {
+        ATRACE_NAME("wait for functor syncs");
+        for (auto& sync : functorSyncs) {
+            sync.get();
+        }
+    }
+    info.pendingFunctorSyncs = nullptr;
+
     freePrefetchedLayers();
     GL_CHECKPOINT(MODERATE);
 
@@ -426,6 +448,7 @@ void CanvasContext::prepareTree(TreeInfo& info, int64_t* uiFrameInfo, int64_t sy
 }
 
 void CanvasContext::stopDrawing() {
+    flushLateDraw();
     mRenderThread.removeFrameCallback(this);
     mAnimationContext->pauseAnimators();
     mGenerationID++;
@@ -586,9 +609,16 @@ void CanvasContext::draw() {
     }
 
     mJankTracker.finishFrame(*mCurrentFrameInfo);
+    nsecs_t functorGpuTime = WebViewFunctorManager::instance().takeReportedGpuTime();
+    if (functorGpuTime > 0) {
+        mJankTracker.recordFunctorGpuTime(functorGpuTime);
+    }
     if (CC_UNLIKELY(mFrameMetricsReporter.get() != nullptr)) {
         mFrameMetricsReporter->reportFrameMetrics(mCurrentFrameInfo->data());
     }
+    if (CC_UNLIKELY(GlobalFrameMetricsReporter::hasCallbacks())) {
+        GlobalFrameMetricsReporter::reportFrameMetrics(mCurrentFrameInfo->data());
+    }
 
     if (mLast4FrameInfos.size() == mLast4FrameInfos.capacity()) {
         // By looking 4 frames back, we guarantee all SF stats are available. There are at
@@ -609,6 +639,60 @@ void CanvasContext::draw() {
     mRenderThread.cacheManager().onFrameCompleted();
 }
 
+void CanvasContext::drawLate() {
+    // Slack left between the end of the estimated draw and the deadline.
+    static constexpr nsecs_t kLateDrawMargin = 1_ms;
+
+    const nsecs_t frameInterval = mRenderThread.timeLord().frameIntervalNanos();
+    const nsecs_t deadline = mCurrentFrameInfo->get(FrameInfoIndex::Vsync) + frameInterval;
+    // Until a deferred draw has been measured, assume it takes half a frame.
+    const nsecs_t estimate = mLateDrawDuration ? mLateDrawDuration : frameInterval / 2;
+    const nsecs_t drawAt = deadline - estimate - kLateDrawMargin;
+    if (drawAt - systemTime(SYSTEM_TIME_MONOTONIC) < kLateDrawMargin) {
+        drawAndMeasure();
+        return;
+    }
+
+    ATRACE_FORMAT("drawLate in %dus",
+                  static_cast<int>((drawAt - systemTime(SYSTEM_TIME_MONOTONIC)) / 1000));
+    mLateDrawPending = true;
+    int token = ++*mLateDrawToken;
+    mRenderThread.queue().postAt(
+            drawAt, [this, weakToken = std::weak_ptr<int>(mLateDrawToken), token]() {
+                std::shared_ptr<int> currentToken = weakToken.lock();
+                if (currentToken && *currentToken == token) {
+                    flushLateDraw();
+                }
+            });
+}
+
+void CanvasContext::drawAndMeasure() {
+    nsecs_t start = systemTime(SYSTEM_TIME_MONOTONIC);
+    draw();
+    nsecs_t duration = systemTime(SYSTEM_TIME_MONOTONIC) - start;
+    // Follow slower draws immediately and faster ones slowly, so that a single quick frame
+    // doesn't make the next one miss its deadline.
+    mLateDrawDuration = duration > mLateDrawDuration ? duration
+                                                     : (7 * mLateDrawDuration + duration) / 8;
+}
+
+void CanvasContext::flushLateDraw() {
+    if (mLateDrawPending) {
+        mLateDrawPending = false;
+        ++*mLateDrawToken;
+        drawAndMeasure();
+    }
+}
+
+void CanvasContext::cancelLateDraw() {
+    if (mLateDrawPending) {
+        mLateDrawPending = false;
+        ++*mLateDrawToken;
+        // Lets the next prepareTree reuse the frame info, as for any other dropped frame.
+        mCurrentFrameInfo->addFlag(FrameInfoFlags::SkippedFrame);
+    }
+}
+
 // Called by choreographer to do an RT-driven animation
 void CanvasContext::doFrame() {
     if (!mRenderPipeline->isSurfaceReady()) return;
@@ -707,6 +791,10 @@ void CanvasContext::trimMemory(RenderThread& thread, int level) {
         thread.destroyRenderingContext();
     } else if (level >= TRIM_MEMORY_UI_HIDDEN) {
         thread.cacheManager().trimMemory(CacheManager::TrimMemoryMode::UiHidden);
+    } else if (level >= TRIM_MEMORY_RUNNING_CRITICAL) {
+        thread.cacheManager().trimMemory(CacheManager::TrimMemoryMode::RunningCritical);
+    } else if (level >= TRIM_MEMORY_RUNNING_LOW) {
+        thread.cacheManager().trimMemory(CacheManager::TrimMemoryMode::RunningLow);
     }
 }
 
@@ -738,7 +826,7 @@ void CanvasContext::waitOnFences() {
 }
 
 void CanvasContext::enqueueFrameWork(std::function<void()>&& func) {
-    mFrameFences.push_back(CommonPool::async(std::move(func)));
+    mFrameFences.push_back(CommonPool::async(std::move(func), CommonPool::Priority::High));
 }
 
 int64_t CanvasContext::getFrameNumber() {
@@ -815,6 +903,14 @@ SkRect CanvasContext::computeDirtyRect(const Frame& frame, SkRect* dirty) {
         }
     }
 
+    // Once the repaint covers most of the surface, clipping to it saves little GPU work and
+    // still forces the driver to preserve the rest of the buffer, so just draw everything.
+    const float frameArea = static_cast<float>(frame.width()) * frame.height();
+    if (dirty->width() * dirty->height() >
+        frameArea * Properties::partialUpdateMaxAreaPercent / 100.0f) {
+        dirty->setIWH(frame.width(), frame.height());
+    }
+
     return windowDirty;
 }
 
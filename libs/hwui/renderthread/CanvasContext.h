@@ -39,6 +39,7 @@
 
 #include <functional>
 #include <future>
+#include <memory>
 #include <set>
 #include <string>
 #include <utility>
@@ -85,6 +86,12 @@ public:
         return mRenderPipeline->createOrUpdateLayer(node, dmgAccumulator, errorHandler);
     }
 
+    /**
+     * Removes the layer of the provided RenderNode, which the RenderPipeline may keep around to
+     * back a later layer.
+     */
+    void destroyLayer(RenderNode* node) { mRenderPipeline->destroyLayer(node); }
+
     /**
      * Pin any mutable images to the GPU cache. A pinned images is guaranteed to
      * remain in the cache until it has been unpinned. We leverage this feature
@@ -129,6 +136,11 @@ public:
     bool makeCurrent();
     void prepareTree(TreeInfo& info, int64_t* uiFrameInfo, int64_t syncQueued, RenderNode* target);
     void draw();
+    // Draws the frame prepared by the last prepareTree at the latest point that still leaves
+    // time to finish before the next vsync, or right away if that point has already passed.
+    // A prepareTree in the meantime supersedes the deferred draw, so the newer content is
+    // what gets drawn.
+    void drawLate();
     void destroy();
 
     // IFrameCallback, Choreographer-driven frame callback entry point
@@ -150,6 +162,9 @@ public:
 
     void dumpFrames(int fd);
     void resetFrameStats();
+    int64_t frameStagePercentile(FrameStage stage, int percentile) const {
+        return mJankTracker.stagePercentile(stage, percentile);
+    }
 
     void setName(const std::string&& name);
 
@@ -220,6 +235,13 @@ private:
 
     SkRect computeDirtyRect(const Frame& frame, SkRect* dirty);
 
+    // Draws and updates the estimate of how long a deferred draw takes.
+    void drawAndMeasure();
+    // Draws the frame deferred by drawLate now, if there is one.
+    void flushLateDraw();
+    // Forgets the frame deferred by drawLate, if there is one.
+    void cancelLateDraw();
+
     // The same type as Frame.mWidth and Frame.mHeight
     int32_t mLastFrameWidth = 0;
     int32_t mLastFrameHeight = 0;
@@ -255,6 +277,14 @@ private:
     // last vsync for a dropped frame due to stuffed queue
     nsecs_t mLastDropVsync = 0;
 
+    // Whether a frame deferred by drawLate has yet to be drawn. The posted draw only runs if
+    // mLateDrawToken still holds the value it was posted with; holding the token weakly keeps
+    // it from touching a destroyed context.
+    bool mLateDrawPending = false;
+    std::shared_ptr<int> mLateDrawToken = std::make_shared<int>(0);
+    // Conservative estimate of how long a deferred draw takes, 0 until one has been measured.
+    nsecs_t mLateDrawDuration = 0;
+
     bool mOpaque;
     bool mUseForceDark = false;
     LightInfo mLightInfo;
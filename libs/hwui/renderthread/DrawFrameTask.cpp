@@ -21,6 +21,7 @@
 
 #include "../DeferredLayerUpdater.h"
 #include "../DisplayList.h"
+#include "../Properties.h"
 #include "../RenderNode.h"
 #include "CanvasContext.h"
 #include "RenderThread.h"
@@ -114,7 +115,12 @@ void DrawFrameTask::run() {
     }
 
     if (CC_LIKELY(canDrawThisFrame)) {
-        context->draw();
+        if (Properties::drawLate && canUnblockUiThread) {
+            // The UI thread is no longer waiting, so the draw can wait for the deadline.
+            context->drawLate();
+        } else {
+            context->draw();
+        }
     } else {
         // wait on fences so tasks don't overlap next frame
         context->waitOnFences();
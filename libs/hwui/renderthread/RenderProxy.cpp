@@ -239,6 +239,11 @@ uint32_t RenderProxy::frameTimePercentile(int percentile) {
     });
 }
 
+int64_t RenderProxy::frameStagePercentile(FrameStage stage, int percentile) {
+    return mRenderThread.queue().runSync(
+            [&]() -> auto { return mContext->frameStagePercentile(stage, percentile); });
+}
+
 void RenderProxy::dumpGraphicsMemory(int fd) {
     if (RenderThread::hasInstance()) {
         auto& thread = RenderThread::getInstance();
@@ -322,6 +327,15 @@ int RenderProxy::copySurfaceInto(ANativeWindow* window, int left, int top, int r
     }));
 }
 
+int RenderProxy::copySurfaceIntoBuffer(ANativeWindow* window, int left, int top, int right,
+                                       int bottom, AHardwareBuffer* buffer, int* outFence) {
+    auto& thread = RenderThread::getInstance();
+    return static_cast<int>(thread.queue().runSync([&]() -> auto {
+        return thread.readback().copySurfaceIntoBuffer(window, Rect(left, top, right, bottom),
+                                                       buffer, outFence);
+    }));
+}
+
 void RenderProxy::prepareToDraw(Bitmap& bitmap) {
     // If we haven't spun up a hardware accelerated window yet, there's no
     // point in precaching these bitmaps as it can't impact jank.
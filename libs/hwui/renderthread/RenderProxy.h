@@ -37,6 +37,7 @@ namespace uirenderer {
 class DeferredLayerUpdater;
 class RenderNode;
 class Rect;
+enum class FrameStage;
 
 namespace renderthread {
 
@@ -105,6 +106,7 @@ public:
     // Not exported, only used for testing
     void resetProfileInfo();
     uint32_t frameTimePercentile(int p);
+    int64_t frameStagePercentile(FrameStage stage, int p);
     ANDROID_API static void dumpGraphicsMemory(int fd);
 
     ANDROID_API static void rotateProcessStatsBuffer();
@@ -143,6 +145,10 @@ public:
 
     ANDROID_API static int copySurfaceInto(ANativeWindow* window, int left, int top, int right,
                                            int bottom, SkBitmap* bitmap);
+    // Returns once the copy has been submitted, outFence signals when it has completed
+    ANDROID_API static int copySurfaceIntoBuffer(ANativeWindow* window, int left, int top,
+                                                 int right, int bottom, AHardwareBuffer* buffer,
+                                                 int* outFence);
     ANDROID_API static void prepareToDraw(Bitmap& bitmap);
 
     static int copyHWBitmapInto(Bitmap* hwBitmap, SkBitmap* bitmap);
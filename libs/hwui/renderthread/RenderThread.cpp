@@ -24,6 +24,7 @@
 #include "RenderProxy.h"
 #include "VulkanManager.h"
 #include "hwui/Bitmap.h"
+#include "pipeline/skia/ShaderCache.h"
 #include "pipeline/skia/SkiaOpenGLPipeline.h"
 #include "pipeline/skia/SkiaVulkanPipeline.h"
 #include "renderstate/RenderState.h"
@@ -272,6 +273,22 @@ void RenderThread::setGrContext(sk_sp<GrContext> context) {
     mGrContext = std::move(context);
     if (mGrContext) {
         DeviceInfo::setMaxTextureSize(mGrContext->maxRenderTargetSize());
+        if (Properties::precompileShaders) {
+            queue().post([this, context = mGrContext.get()]() { precompileShaders(context); });
+        }
+    }
+}
+
+void RenderThread::precompileShaders(GrContext* context) {
+    // Number of shaders compiled before yielding to the other work in the queue.
+    static constexpr size_t kShadersPerStep = 4;
+
+    // Stop if the context was destroyed or replaced since this was posted.
+    if (mGrContext.get() != context) {
+        return;
+    }
+    if (skiapipeline::ShaderCache::get().precompileShaders(context, kShadersPerStep)) {
+        queue().post([this, context]() { precompileShaders(context); });
     }
 }
 
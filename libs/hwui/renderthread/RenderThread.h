@@ -154,6 +154,9 @@ private:
     void initThreadLocals();
     void initializeChoreographer();
     void setupFrameInterval();
+    // Compiles a few of the most used shaders recorded by the ShaderCache, and reposts itself
+    // until all of them are compiled, so that frames queued meanwhile are not held up.
+    void precompileShaders(GrContext* context);
     // Callbacks for choreographer events:
     // choreographerCallback will call AChoreograper_handleEvent to call the
     // corresponding callbacks for each display event type
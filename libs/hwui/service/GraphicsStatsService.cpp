@@ -21,6 +21,7 @@
 #include <google/protobuf/io/zero_copy_stream_impl_lite.h>
 #include <inttypes.h>
 #include <log/log.h>
+#include <stddef.h>
 #include <sys/mman.h>
 #include <sys/stat.h>
 #include <sys/types.h>
@@ -39,17 +40,83 @@ namespace uirenderer {
 using namespace google::protobuf;
 using namespace uirenderer::protos;
 
-constexpr int32_t sCurrentFileVersion = 1;
+// Version 1 files hold a serialized GraphicsStatsProto after the version
+// header. saveBuffer() now writes version 2 files, which have the fixed layout
+// below so that they can be memory-mapped and updated in place. The proto is
+// only built when the stats are dumped.
+constexpr int32_t sProtoFileVersion = 1;
+constexpr int32_t sFixedFileVersion = 2;
 constexpr int32_t sHeaderSize = 4;
-static_assert(sizeof(sCurrentFileVersion) == sHeaderSize, "Header size is wrong");
+static_assert(sizeof(sProtoFileVersion) == sHeaderSize, "Header size is wrong");
 
 constexpr int sHistogramSize = ProfileData::HistogramSize();
 constexpr int sGPUHistogramSize = ProfileData::GPUHistogramSize();
 
+enum StatsFileSummary {
+    kTotalFrames = 0,
+    kJankyFrames,
+    kMissedVsyncCount,
+    kHighInputLatencyCount,
+    kSlowUiThreadCount,
+    kSlowBitmapUploadCount,
+    kSlowDrawCount,
+    kMissedDeadlineCount,
+
+    // must be last
+    kStatsFileSummarySize,
+};
+
+// A version 2 file is this header, followed by histogramSize and then
+// gpuHistogramSize StatsFileBuckets, followed by the package name (not
+// terminated).
+struct StatsFileHeader {
+    uint32_t fileVersion;
+    uint32_t histogramSize;
+    uint32_t gpuHistogramSize;
+    uint32_t packageNameSize;
+    int64_t versionCode;
+    int64_t statsStart;
+    int64_t statsEnd;
+    int32_t pipeline;
+    uint32_t summary[kStatsFileSummarySize];
+    uint32_t reserved;
+};
+static_assert(sizeof(StatsFileHeader) == 80, "StatsFileHeader layout changed");
+static_assert(offsetof(StatsFileHeader, fileVersion) == 0, "Version must lead the file");
+
+struct StatsFileBucket {
+    uint32_t renderMillis;
+    uint32_t frameCount;
+};
+
+struct StatsFile {
+    StatsFileHeader* header;
+    StatsFileBucket* histogram;
+    StatsFileBucket* gpuHistogram;
+    char* packageName;
+};
+
+static uint64_t statsFileSize(uint64_t histogramSize, uint64_t gpuHistogramSize,
+                              uint64_t packageNameSize) {
+    return sizeof(StatsFileHeader) + (histogramSize + gpuHistogramSize) * sizeof(StatsFileBucket) +
+           packageNameSize;
+}
+
+static StatsFile mapStatsFile(void* addr) {
+    StatsFile file;
+    file.header = reinterpret_cast<StatsFileHeader*>(addr);
+    file.histogram = reinterpret_cast<StatsFileBucket*>(file.header + 1);
+    file.gpuHistogram = file.histogram + file.header->histogramSize;
+    file.packageName = reinterpret_cast<char*>(file.gpuHistogram + file.header->gpuHistogramSize);
+    return file;
+}
+
 static bool mergeProfileDataIntoProto(protos::GraphicsStatsProto* proto, const std::string& package,
                                       int64_t versionCode, int64_t startTime, int64_t endTime,
                                       const ProfileData* data);
 static void dumpAsTextToFd(protos::GraphicsStatsProto* proto, int outFd);
+static bool parseFixedStats(const std::string& path, const void* addr, size_t size,
+                            protos::GraphicsStatsProto* output);
 
 class FileDescriptor {
 public:
@@ -142,8 +209,13 @@ bool GraphicsStatsService::parseFromFile(const std::string& path,
         return false;
     }
     uint32_t file_version = *reinterpret_cast<uint32_t*>(addr);
-    if (file_version != sCurrentFileVersion) {
-        ALOGW("file_version mismatch! expected %d got %d", sCurrentFileVersion, file_version);
+    if (file_version == sFixedFileVersion) {
+        bool success = parseFixedStats(path, addr, sb.st_size, output);
+        munmap(addr, sb.st_size);
+        return success;
+    }
+    if (file_version != sProtoFileVersion) {
+        ALOGW("file_version mismatch! expected %d got %d", sFixedFileVersion, file_version);
         munmap(addr, sb.st_size);
         return false;
     }
@@ -160,6 +232,158 @@ bool GraphicsStatsService::parseFromFile(const std::string& path,
     return success;
 }
 
+bool parseFixedStats(const std::string& path, const void* addr, size_t size,
+                     protos::GraphicsStatsProto* output) {
+    if (size < sizeof(StatsFileHeader)) {
+        ALOGW("Truncated stats file '%s' (%zu bytes)", path.c_str(), size);
+        return false;
+    }
+    const StatsFileHeader* header = reinterpret_cast<const StatsFileHeader*>(addr);
+    if (statsFileSize(header->histogramSize, header->gpuHistogramSize,
+                      header->packageNameSize) != size) {
+        ALOGW("Stats file '%s' size %zu does not match its header", path.c_str(), size);
+        return false;
+    }
+    StatsFile file = mapStatsFile(const_cast<void*>(addr));
+
+    output->set_package_name(std::string(file.packageName, header->packageNameSize));
+    output->set_version_code(header->versionCode);
+    output->set_stats_start(header->statsStart);
+    output->set_stats_end(header->statsEnd);
+    output->set_pipeline(static_cast<GraphicsStatsProto_PipelineType>(header->pipeline));
+    auto summary = output->mutable_summary();
+    summary->set_total_frames(header->summary[kTotalFrames]);
+    summary->set_janky_frames(header->summary[kJankyFrames]);
+    summary->set_missed_vsync_count(header->summary[kMissedVsyncCount]);
+    summary->set_high_input_latency_count(header->summary[kHighInputLatencyCount]);
+    summary->set_slow_ui_thread_count(header->summary[kSlowUiThreadCount]);
+    summary->set_slow_bitmap_upload_count(header->summary[kSlowBitmapUploadCount]);
+    summary->set_slow_draw_count(header->summary[kSlowDrawCount]);
+    summary->set_missed_deadline_count(header->summary[kMissedDeadlineCount]);
+    output->mutable_histogram()->Reserve(header->histogramSize);
+    for (uint32_t i = 0; i < header->histogramSize; i++) {
+        auto bucket = output->add_histogram();
+        bucket->set_render_millis(file.histogram[i].renderMillis);
+        bucket->set_frame_count(file.histogram[i].frameCount);
+    }
+    output->mutable_gpu_histogram()->Reserve(header->gpuHistogramSize);
+    for (uint32_t i = 0; i < header->gpuHistogramSize; i++) {
+        auto bucket = output->add_gpu_histogram();
+        bucket->set_render_millis(file.gpuHistogram[i].renderMillis);
+        bucket->set_frame_count(file.gpuHistogram[i].frameCount);
+    }
+    return true;
+}
+
+// Returns true if the mapped file has the layout saveBuffer() would create for
+// this package and data, so that it can be updated in place.
+static bool isCurrentStatsLayout(const StatsFile& file, const std::string& package,
+                                 const ProfileData* data) {
+    const StatsFileHeader* header = file.header;
+    if (header->fileVersion != static_cast<uint32_t>(sFixedFileVersion) ||
+        header->histogramSize != static_cast<uint32_t>(sHistogramSize) ||
+        header->gpuHistogramSize != static_cast<uint32_t>(sGPUHistogramSize) ||
+        header->packageNameSize != package.size() ||
+        memcmp(file.packageName, package.data(), package.size()) != 0) {
+        return false;
+    }
+    bool matches = true;
+    int index = 0;
+    data->histogramForEach([&](ProfileData::HistogramEntry entry) {
+        matches = matches && file.histogram[index++].renderMillis == entry.renderTimeMs;
+    });
+    index = 0;
+    data->histogramGPUForEach([&](ProfileData::HistogramEntry entry) {
+        matches = matches && file.gpuHistogram[index++].renderMillis == entry.renderTimeMs;
+    });
+    return matches;
+}
+
+// Lays out a new stats file for the package, carrying over previously saved
+// stats if their histogram buckets still line up with the data's.
+static void initStatsFile(const StatsFile& file, const std::string& package,
+                          const ProfileData* data, const protos::GraphicsStatsProto* previous) {
+    StatsFileHeader* header = file.header;
+    int index = 0;
+    data->histogramForEach([&](ProfileData::HistogramEntry entry) {
+        file.histogram[index++] = StatsFileBucket{entry.renderTimeMs, 0};
+    });
+    index = 0;
+    data->histogramGPUForEach([&](ProfileData::HistogramEntry entry) {
+        file.gpuHistogram[index++] = StatsFileBucket{entry.renderTimeMs, 0};
+    });
+    memcpy(file.packageName, package.data(), package.size());
+
+    if (previous == nullptr || !previous->has_summary()) {
+        return;
+    }
+    bool compatible = previous->histogram_size() == sHistogramSize &&
+                      (previous->gpu_histogram_size() == 0 ||
+                       previous->gpu_histogram_size() == sGPUHistogramSize);
+    for (int i = 0; compatible && i < previous->histogram_size(); i++) {
+        compatible = previous->histogram(i).render_millis() ==
+                     static_cast<int32_t>(file.histogram[i].renderMillis);
+    }
+    for (int i = 0; compatible && i < previous->gpu_histogram_size(); i++) {
+        compatible = previous->gpu_histogram(i).render_millis() ==
+                     static_cast<int32_t>(file.gpuHistogram[i].renderMillis);
+    }
+    if (!compatible) {
+        ALOGW("Dropping saved stats for %s, histogram layout changed", package.c_str());
+        return;
+    }
+    for (int i = 0; i < previous->histogram_size(); i++) {
+        file.histogram[i].frameCount = previous->histogram(i).frame_count();
+    }
+    for (int i = 0; i < previous->gpu_histogram_size(); i++) {
+        file.gpuHistogram[i].frameCount = previous->gpu_histogram(i).frame_count();
+    }
+    header->versionCode = previous->version_code();
+    header->statsStart = previous->stats_start();
+    header->statsEnd = previous->stats_end();
+    const auto& summary = previous->summary();
+    header->summary[kTotalFrames] = summary.total_frames();
+    header->summary[kJankyFrames] = summary.janky_frames();
+    header->summary[kMissedVsyncCount] = summary.missed_vsync_count();
+    header->summary[kHighInputLatencyCount] = summary.high_input_latency_count();
+    header->summary[kSlowUiThreadCount] = summary.slow_ui_thread_count();
+    header->summary[kSlowBitmapUploadCount] = summary.slow_bitmap_upload_count();
+    header->summary[kSlowDrawCount] = summary.slow_draw_count();
+    header->summary[kMissedDeadlineCount] = summary.missed_deadline_count();
+}
+
+static void mergeProfileDataIntoStatsFile(const StatsFile& file, int64_t versionCode,
+                                          int64_t startTime, int64_t endTime,
+                                          const ProfileData* data) {
+    StatsFileHeader* header = file.header;
+    if (header->statsStart == 0 || header->statsStart > startTime) {
+        header->statsStart = startTime;
+    }
+    if (header->statsEnd == 0 || header->statsEnd < endTime) {
+        header->statsEnd = endTime;
+    }
+    header->versionCode = versionCode;
+    header->pipeline = data->pipelineType() == RenderPipelineType::SkiaGL
+                               ? GraphicsStatsProto_PipelineType_GL
+                               : GraphicsStatsProto_PipelineType_VULKAN;
+    header->summary[kTotalFrames] += data->totalFrameCount();
+    header->summary[kJankyFrames] += data->jankFrameCount();
+    header->summary[kMissedVsyncCount] += data->jankTypeCount(kMissedVsync);
+    header->summary[kHighInputLatencyCount] += data->jankTypeCount(kHighInputLatency);
+    header->summary[kSlowUiThreadCount] += data->jankTypeCount(kSlowUI);
+    header->summary[kSlowBitmapUploadCount] += data->jankTypeCount(kSlowSync);
+    header->summary[kSlowDrawCount] += data->jankTypeCount(kSlowRT);
+    header->summary[kMissedDeadlineCount] += data->jankTypeCount(kMissedDeadline);
+    int index = 0;
+    data->histogramForEach([&](ProfileData::HistogramEntry entry) {
+        file.histogram[index++].frameCount += entry.frameCount;
+    });
+    index = 0;
+    data->histogramGPUForEach([&](ProfileData::HistogramEntry entry) {
+        file.gpuHistogram[index++].frameCount += entry.frameCount;
+    });
+}
+
 bool mergeProfileDataIntoProto(protos::GraphicsStatsProto* proto, const std::string& package,
                                int64_t versionCode, int64_t startTime, int64_t endTime,
                                const ProfileData* data) {
@@ -323,50 +547,58 @@ void dumpAsTextToFd(protos::GraphicsStatsProto* proto, int fd) {
 void GraphicsStatsService::saveBuffer(const std::string& path, const std::string& package,
                                       int64_t versionCode, int64_t startTime, int64_t endTime,
                                       const ProfileData* data) {
-    protos::GraphicsStatsProto statsProto;
-    if (!parseFromFile(path, &statsProto)) {
-        statsProto.Clear();
-    }
-    if (!mergeProfileDataIntoProto(&statsProto, package, versionCode, startTime, endTime, data)) {
-        return;
-    }
-    // Although we might not have read any data from the file, merging the existing data
-    // should always fully-initialize the proto
-    if (!statsProto.IsInitialized()) {
-        ALOGE("proto initialization error %s", statsProto.InitializationErrorString().c_str());
+    if (package.empty()) {
+        ALOGE("missing package_name() for '%s'", path.c_str());
         return;
     }
-    if (statsProto.package_name().empty() || !statsProto.has_summary()) {
-        ALOGE("missing package_name() '%s' summary %d", statsProto.package_name().c_str(),
-              statsProto.has_summary());
-        return;
-    }
-    int outFd = open(path.c_str(), O_CREAT | O_RDWR | O_TRUNC, 0660);
-    if (outFd <= 0) {
+    const size_t fileSize = statsFileSize(sHistogramSize, sGPUHistogramSize, package.size());
+    FileDescriptor fd{open(path.c_str(), O_CREAT | O_RDWR | O_CLOEXEC, 0660)};
+    if (!fd.valid()) {
         int err = errno;
         ALOGW("Failed to open '%s', error=%d (%s)", path.c_str(), err, strerror(err));
         return;
     }
-    int wrote = write(outFd, &sCurrentFileVersion, sHeaderSize);
-    if (wrote != sHeaderSize) {
+    struct stat sb;
+    if (fstat(fd, &sb)) {
         int err = errno;
-        ALOGW("Failed to write header to '%s', returned=%d errno=%d (%s)", path.c_str(), wrote, err,
-              strerror(err));
-        close(outFd);
+        ALOGW("Failed to fstat '%s', error=%d (%s)", path.c_str(), err, strerror(err));
         return;
     }
-    {
-        FileOutputStreamLite output(outFd);
-        bool success = statsProto.SerializeToZeroCopyStream(&output) && output.Flush();
-        if (output.GetErrno() != 0) {
-            ALOGW("Error writing to fd=%d, path='%s' err=%d (%s)", outFd, path.c_str(),
-                  output.GetErrno(), strerror(output.GetErrno()));
-            success = false;
-        } else if (!success) {
-            ALOGW("Serialize failed on '%s' unknown error", path.c_str());
+
+    // Stats saved earlier in the current layout are updated in place, which
+    // only dirties the pages holding the counters. Anything else (no stats
+    // yet, a version 1 proto file, or a histogram layout change) is rebuilt.
+    void* addr = MAP_FAILED;
+    if (static_cast<size_t>(sb.st_size) == fileSize) {
+        addr = mmap(nullptr, fileSize, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+        if (addr != MAP_FAILED && !isCurrentStatsLayout(mapStatsFile(addr), package, data)) {
+            munmap(addr, fileSize);
+            addr = MAP_FAILED;
         }
     }
-    close(outFd);
+    if (addr == MAP_FAILED) {
+        protos::GraphicsStatsProto previous;
+        bool hasPrevious = sb.st_size > 0 && parseFromFile(path, &previous);
+        if (ftruncate(fd, 0) || ftruncate(fd, fileSize)) {
+            int err = errno;
+            ALOGW("Failed to resize '%s', error=%d (%s)", path.c_str(), err, strerror(err));
+            return;
+        }
+        addr = mmap(nullptr, fileSize, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+        if (addr == MAP_FAILED) {
+            int err = errno;
+            ALOGW("Failed to mmap '%s', error=%d (%s)", path.c_str(), err, strerror(err));
+            return;
+        }
+        StatsFileHeader* header = reinterpret_cast<StatsFileHeader*>(addr);
+        header->fileVersion = sFixedFileVersion;
+        header->histogramSize = sHistogramSize;
+        header->gpuHistogramSize = sGPUHistogramSize;
+        header->packageNameSize = package.size();
+        initStatsFile(mapStatsFile(addr), package, data, hasPrevious ? &previous : nullptr);
+    }
+    mergeProfileDataIntoStatsFile(mapStatsFile(addr), versionCode, startTime, endTime, data);
+    munmap(addr, fileSize);
 }
 
 class GraphicsStatsService::Dump {
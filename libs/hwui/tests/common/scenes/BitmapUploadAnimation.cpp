@@ -0,0 +1,64 @@
+/*
+ * Copyright (C) 2020 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "TestSceneBase.h"
+#include "utils/Color.h"
+
+#include <SkBitmap.h>
+
+class BitmapUploadAnimation;
+
+static TestScene::Registrar _BitmapUpload(TestScene::Info{
+        "bitmapupload",
+        "Draws a grid of bitmaps that are all newly allocated every frame, like images "
+        "arriving while a list of thumbnails is flung. Tests uploading bitmaps to the GPU.",
+        TestScene::simpleCreateScene<BitmapUploadAnimation>});
+
+class BitmapUploadAnimation : public TestScene {
+public:
+    static constexpr int kColumns = 4;
+    static constexpr int kRows = 4;
+
+    sp<RenderNode> container;
+    void createContent(int width, int height, Canvas& canvas) override {
+        container = TestUtils::createNode(0, 0, width, height, nullptr);
+        doFrame(0);  // update container
+
+        canvas.drawColor(Color::White, SkBlendMode::kSrcOver);
+        canvas.drawRenderNode(container.get());
+    }
+
+    void doFrame(int frameNr) override {
+        const int width = container->stagingProperties().getWidth();
+        const int height = container->stagingProperties().getHeight();
+        const int bitmapWidth = width / kColumns;
+        const int bitmapHeight = height / kRows;
+        std::unique_ptr<Canvas> canvas(
+                Canvas::create_recording_canvas(width, height, container.get()));
+
+        for (int y = 0; y < kRows; y++) {
+            for (int x = 0; x < kColumns; x++) {
+                SkBitmap skBitmap;
+                sk_sp<Bitmap> bitmap =
+                        TestUtils::createBitmap(bitmapWidth, bitmapHeight, &skBitmap);
+                skBitmap.eraseColor(BrightColors[(frameNr + x + y * kColumns) % BrightColorsCount]);
+                canvas->drawBitmap(*bitmap, x * bitmapWidth, y * bitmapHeight, nullptr);
+            }
+        }
+
+        container->setStagingDisplayList(canvas->finishRecording());
+    }
+};
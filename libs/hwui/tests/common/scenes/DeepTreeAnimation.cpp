@@ -0,0 +1,70 @@
+/*
+ * Copyright (C) 2020 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "TestSceneBase.h"
+#include "utils/Color.h"
+
+class DeepTreeAnimation;
+
+static TestScene::Registrar _DeepTree(TestScene::Info{
+        "deeptree",
+        "A chain of 100 nested RenderNodes, each drawing a small rect. The innermost node is "
+        "animated, which stresses the cost of syncing and drawing deep view hierarchies.",
+        TestScene::simpleCreateScene<DeepTreeAnimation>});
+
+class DeepTreeAnimation : public TestScene {
+public:
+    static constexpr int kDepth = 100;
+
+    sp<RenderNode> leaf;
+    void createContent(int width, int height, Canvas& canvas) override {
+        canvas.drawColor(Color::White, SkBlendMode::kSrcOver);
+        sp<RenderNode> root = createLevel(0, width, height);
+        canvas.drawRenderNode(root.get());
+    }
+
+    void doFrame(int frameNr) override {
+        int curFrame = frameNr % 150;
+        leaf->mutateStagingProperties().setTranslationX(curFrame);
+        leaf->mutateStagingProperties().setTranslationY(curFrame);
+        leaf->setPropertyFieldsDirty(RenderNode::X | RenderNode::Y);
+    }
+
+private:
+    sp<RenderNode> createLevel(int level, int width, int height) {
+        sp<RenderNode> child;
+        if (level + 1 < kDepth) {
+            child = createLevel(level + 1, width - 2, height - 2);
+        }
+        sp<RenderNode> node = TestUtils::createNode(
+                1, 1, width, height, [level, child](RenderProperties& props, Canvas& canvas) {
+                    // Every tenth level is translucent, as views with alpha commonly are
+                    if (level % 10 == 5) {
+                        props.setAlpha(0.9f);
+                    }
+                    Paint paint;
+                    paint.setColor(BrightColors[level % BrightColorsCount]);
+                    canvas.drawRect(0, 0, 20, 20, paint);
+                    if (child) {
+                        canvas.drawRenderNode(child.get());
+                    }
+                });
+        if (!child) {
+            leaf = node;
+        }
+        return node;
+    }
+};
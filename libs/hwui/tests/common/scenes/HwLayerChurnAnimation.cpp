@@ -0,0 +1,73 @@
+/*
+ * Copyright (C) 2020 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "TestSceneBase.h"
+#include "utils/Color.h"
+
+class HwLayerChurnAnimation;
+
+static TestScene::Registrar _HwLayerChurn(TestScene::Info{
+        "hwlayerchurn",
+        "A grid of cards that take turns becoming LAYER_TYPE_HARDWARE for a few frames while "
+        "they fade, like views animated by a fragment transition. Tests creating and destroying "
+        "hardware layers.",
+        TestScene::simpleCreateScene<HwLayerChurnAnimation>});
+
+class HwLayerChurnAnimation : public TestScene {
+public:
+    static constexpr int kColumns = 4;
+    static constexpr int kRows = 6;
+    // How many frames each card stays a layer for
+    static constexpr int kLayerFrames = 10;
+
+    std::vector<sp<RenderNode>> cards;
+    void createContent(int width, int height, Canvas& canvas) override {
+        canvas.drawColor(Color::White, SkBlendMode::kSrcOver);
+        const int cardWidth = width / kColumns;
+        const int cardHeight = height / kRows;
+        for (int y = 0; y < kRows; y++) {
+            for (int x = 0; x < kColumns; x++) {
+                const SkColor color = (x + y) % 2 ? Color::Blue_500 : Color::Amber_500;
+                sp<RenderNode> card = TestUtils::createNode(
+                        x * cardWidth, y * cardHeight, (x + 1) * cardWidth - dp(4),
+                        (y + 1) * cardHeight - dp(4),
+                        [color](RenderProperties& props, Canvas& canvas) {
+                            canvas.drawColor(color, SkBlendMode::kSrcOver);
+                            Paint paint;
+                            paint.setAntiAlias(true);
+                            paint.setColor(Color::White);
+                            canvas.drawCircle(dp(24), dp(24), dp(16), paint);
+                        });
+                canvas.drawRenderNode(card.get());
+                cards.push_back(card);
+            }
+        }
+    }
+
+    void doFrame(int frameNr) override {
+        // A third of the cards are layers at any time, and a new set starts every kLayerFrames
+        const int phase = (frameNr / kLayerFrames) % 3;
+        const float progress = (frameNr % kLayerFrames) / float(kLayerFrames);
+        for (size_t i = 0; i < cards.size(); i++) {
+            RenderProperties& props = cards[i]->mutateStagingProperties();
+            const bool isLayer = static_cast<int>(i % 3) == phase;
+            props.mutateLayerProperties().setType(isLayer ? LayerType::RenderLayer
+                                                          : LayerType::None);
+            props.setAlpha(isLayer ? 1.0f - 0.5f * progress : 1.0f);
+            cards[i]->setPropertyFieldsDirty(RenderNode::GENERIC | RenderNode::ALPHA);
+        }
+    }
+};
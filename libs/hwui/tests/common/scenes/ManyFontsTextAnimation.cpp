@@ -0,0 +1,72 @@
+/*
+ * Copyright (C) 2020 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "TestSceneBase.h"
+#include "hwui/Paint.h"
+#include "hwui/Typeface.h"
+#include "utils/Color.h"
+
+#include <cstdio>
+
+class ManyFontsTextAnimation;
+
+static TestScene::Registrar _ManyFontsText(TestScene::Info{
+        "manyfontstext",
+        "A full screen block of text in several weights, styles and sizes that scrolls by a "
+        "line every frame. Tests laying out and drawing large amounts of text.",
+        TestScene::simpleCreateScene<ManyFontsTextAnimation>});
+
+class ManyFontsTextAnimation : public TestScene {
+public:
+    sp<RenderNode> container;
+    std::vector<std::unique_ptr<Typeface>> typefaces;
+
+    void createContent(int width, int height, Canvas& canvas) override {
+        for (int weight = 100; weight <= 900; weight += 200) {
+            typefaces.emplace_back(Typeface::createAbsolute(nullptr, weight, false));
+            typefaces.emplace_back(Typeface::createAbsolute(nullptr, weight, true));
+        }
+        container = TestUtils::createNode(0, 0, width, height, nullptr);
+        doFrame(0);  // update container
+
+        canvas.drawColor(Color::White, SkBlendMode::kSrcOver);
+        canvas.drawRenderNode(container.get());
+    }
+
+    void doFrame(int frameNr) override {
+        const int width = container->stagingProperties().getWidth();
+        const int height = container->stagingProperties().getHeight();
+        std::unique_ptr<Canvas> canvas(
+                Canvas::create_recording_canvas(width, height, container.get()));
+
+        Paint paint;
+        paint.setAntiAlias(true);
+        paint.setColor(Color::Black);
+        char text[64];
+        float y = 0;
+        // Each frame starts one line further down the text, so every line changes style
+        for (int line = frameNr % 50; y < height; line++) {
+            paint.setAndroidTypeface(typefaces[line % typefaces.size()].get());
+            paint.getSkFont().setSize(dp(12 + (line % 5) * 4));
+            snprintf(text, sizeof(text), "Line %d: the quick brown fox jumps over the lazy dog",
+                     line);
+            y += paint.getSkFont().getSize() * 1.2f;
+            TestUtils::drawUtf8ToCanvas(canvas.get(), text, paint, dp(8), y);
+        }
+
+        container->setStagingDisplayList(canvas->finishRecording());
+    }
+};
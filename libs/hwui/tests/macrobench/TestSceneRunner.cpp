@@ -15,6 +15,7 @@
  */
 
 #include "AnimationContext.h"
+#include "JankTracker.h"
 #include "RenderNode.h"
 #include "renderthread/RenderProxy.h"
 #include "renderthread/RenderTask.h"
@@ -77,6 +78,21 @@ void outputBenchmarkReport(const TestScene::Info& info, const TestScene::Options
             ReportInfo{99, "_99th"},
     };
 
+    struct StageInfo {
+        FrameStage stage;
+        const char* counter;
+    };
+
+    // The percentiles of each stage are reported as counters of the main run, also when rendering
+    // offscreen, so that --benchmark_format=json gives a per-stage breakdown that CI can track
+    static std::array<StageInfo, kFrameStageCount> STAGES = {
+            StageInfo{FrameStage::Sync, "sync_us"},
+            StageInfo{FrameStage::IssueDraw, "issue_draw_us"},
+            StageInfo{FrameStage::Swap, "swap_us"},
+            StageInfo{FrameStage::Gpu, "gpu_us"},
+            StageInfo{FrameStage::Functor, "functor_gpu_us"},
+    };
+
     // Although a vector is used, it must stay with only a single element
     // otherwise the BenchmarkReporter will automatically compute
     // mean and stddev which doesn't make sense for our usage
@@ -87,6 +103,12 @@ void outputBenchmarkReport(const TestScene::Info& info, const TestScene::Options
     report.real_accumulated_time = durationInS;
     report.cpu_accumulated_time = durationInS;
     report.counters["items_per_second"] = opts.count / durationInS;
+    for (auto& si : STAGES) {
+        for (auto& ri : REPORTS) {
+            report.counters[std::string(si.counter) + ri.suffix] =
+                    proxy->frameStagePercentile(si.stage, ri.percentile);
+        }
+    }
     reports.push_back(report);
     reporter->ReportRuns(reports);
 
@@ -101,6 +123,7 @@ void outputBenchmarkReport(const TestScene::Info& info, const TestScene::Options
             reports[0].real_accumulated_time = durationInS;
             reports[0].cpu_accumulated_time = durationInS;
             reports[0].iterations = 1;
+            reports[0].counters.clear();
             reports[0].counters["items_per_second"] = 0;
             reporter->ReportRuns(reports);
         }
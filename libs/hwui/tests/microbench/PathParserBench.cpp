@@ -28,6 +28,20 @@ static const char* sPathString =
         "M 1 1 m 2 2, l 3 3 L 3 3 H 4 h4 V5 v5, Q6 6 6 6 q 6 6 6 6t 7 7 T 7 7 C 8 8 8 8 8 8 c 8 8 "
         "8 8 8 8 S 9 9 9 9 s 9 9 9 9 A 10 10 0 1 1 10 10 a 10 10 0 1 1 10 10";
 
+// A typical Material icon, with the long runs of relative curves real-world icons are made of.
+static const char* sIconPathString =
+        "M19.14,12.94c0.04,-0.3 0.06,-0.61 0.06,-0.94c0,-0.32 -0.02,-0.64 -0.07,-0.94l2.03,-1.58"
+        "c0.18,-0.14 0.23,-0.41 0.12,-0.61l-1.92,-3.32c-0.12,-0.22 -0.37,-0.29 -0.59,-0.22l-2.39,"
+        "0.96c-0.5,-0.38 -1.03,-0.7 -1.62,-0.94L14.4,2.81c-0.04,-0.24 -0.24,-0.41 -0.48,-0.41h-3.84"
+        "c-0.24,0 -0.43,0.17 -0.47,0.41L9.25,5.35C8.66,5.59 8.12,5.92 7.63,6.29L5.24,5.33c-0.22,"
+        "-0.08 -0.47,0 -0.59,0.22L2.74,8.87C2.62,9.08 2.66,9.34 2.86,9.48l2.03,1.58C4.84,11.36 4.8,"
+        "11.69 4.8,12s0.02,0.64 0.07,0.94l-2.03,1.58c-0.18,0.14 -0.23,0.41 -0.12,0.61l1.92,3.32c0.12,"
+        "0.22 0.37,0.29 0.59,0.22l2.39,-0.96c0.5,0.38 1.03,0.7 1.62,0.94l0.36,2.54c0.05,0.24 0.24,"
+        "0.41 0.48,0.41h3.84c0.24,0 0.44,-0.17 0.47,-0.41l0.36,-2.54c0.59,-0.24 1.13,-0.56 1.62,"
+        "-0.94l2.39,0.96c0.22,0.08 0.47,0 0.59,-0.22l1.92,-3.32c0.12,-0.22 0.07,-0.47 -0.12,-0.61"
+        "L19.14,12.94zM12,15.6c-1.98,0 -3.6,-1.62 -3.6,-3.6s1.62,-3.6 3.6,-3.6s3.6,1.62 3.6,3.6"
+        "S13.98,15.6 12,15.6z";
+
 void BM_PathParser_parseStringPathForSkPath(benchmark::State& state) {
     SkPath skPath;
     size_t length = strlen(sPathString);
@@ -51,3 +65,40 @@ void BM_PathParser_parseStringPathForPathData(benchmark::State& state) {
     }
 }
 BENCHMARK(BM_PathParser_parseStringPathForPathData);
+
+// Parses the icon from scratch every iteration, as happens the first time it is inflated.
+void BM_PathParser_parseIconPathForPathData(benchmark::State& state) {
+    size_t length = strlen(sIconPathString);
+    PathParser::ParseResult result;
+    while (state.KeepRunning()) {
+        PathParser::clearPathDataCache();
+        PathData outData;
+        PathParser::getPathDataFromAsciiString(&outData, &result, sIconPathString, length);
+        benchmark::DoNotOptimize(&outData);
+    }
+}
+BENCHMARK(BM_PathParser_parseIconPathForPathData);
+
+// Parses the same icon repeatedly, as when it is inflated for every row of a list or morphed by
+// an animation.
+void BM_PathParser_parseCachedIconPathForPathData(benchmark::State& state) {
+    size_t length = strlen(sIconPathString);
+    PathParser::ParseResult result;
+    while (state.KeepRunning()) {
+        PathData outData;
+        PathParser::getPathDataFromAsciiString(&outData, &result, sIconPathString, length);
+        benchmark::DoNotOptimize(&outData);
+    }
+}
+BENCHMARK(BM_PathParser_parseCachedIconPathForPathData);
+
+void BM_PathParser_parseIconPathForSkPath(benchmark::State& state) {
+    size_t length = strlen(sIconPathString);
+    PathParser::ParseResult result;
+    while (state.KeepRunning()) {
+        SkPath skPath;
+        PathParser::parseAsciiStringForSkPath(&skPath, &result, sIconPathString, length);
+        benchmark::DoNotOptimize(&skPath);
+    }
+}
+BENCHMARK(BM_PathParser_parseIconPathForSkPath);
@@ -0,0 +1,81 @@
+/*
+ * Copyright (C) 2020 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <gtest/gtest.h>
+
+#include <vector>
+
+#include "utils/Blur.h"
+
+using namespace android::uirenderer;
+
+// Straightforward per-pixel blur with clamped edges, used as the reference for the row passes.
+static uint8_t referenceBlur(const std::vector<float>& weights, int32_t radius,
+                             const uint8_t* source, int32_t x, int32_t y, int32_t width,
+                             int32_t height, bool horizontal) {
+    float sum = 0.0f;
+    for (int32_t r = -radius; r <= radius; r++) {
+        int32_t sx = horizontal ? std::min(std::max(x + r, 0), width - 1) : x;
+        int32_t sy = horizontal ? y : std::min(std::max(y + r, 0), height - 1);
+        sum += (float)source[sy * width + sx] * weights[r + radius];
+    }
+    return (uint8_t)sum;
+}
+
+TEST(Blur, passesMatchReference) {
+    const int32_t width = 37;
+    const int32_t height = 23;
+    std::vector<uint8_t> source(width * height);
+    for (size_t i = 0; i < source.size(); i++) {
+        source[i] = (i * 97 + (i / width) * 31) & 0xFF;
+    }
+
+    for (int32_t radius : {1, 4, 12, 25}) {
+        std::vector<float> weights(2 * radius + 1);
+        Blur::generateGaussianWeights(weights.data(), radius);
+
+        std::vector<uint8_t> horizontal(source.size());
+        std::vector<uint8_t> vertical(source.size());
+        Blur::horizontal(weights.data(), radius, source.data(), horizontal.data(), width, height);
+        Blur::vertical(weights.data(), radius, source.data(), vertical.data(), width, height);
+
+        for (int32_t y = 0; y < height; y++) {
+            for (int32_t x = 0; x < width; x++) {
+                uint8_t expectedH =
+                        referenceBlur(weights, radius, source.data(), x, y, width, height, true);
+                uint8_t expectedV =
+                        referenceBlur(weights, radius, source.data(), x, y, width, height, false);
+                ASSERT_NEAR(expectedH, horizontal[y * width + x], 1)
+                        << "radius " << radius << " at " << x << "," << y;
+                ASSERT_NEAR(expectedV, vertical[y * width + x], 1)
+                        << "radius " << radius << " at " << x << "," << y;
+            }
+        }
+    }
+}
+
+TEST(Blur, weightsAreNormalized) {
+    for (float radius : {1.0f, 3.5f, 10.0f}) {
+        const int32_t intRadius = Blur::convertRadiusToInt(radius);
+        std::vector<float> weights(2 * intRadius + 1);
+        Blur::generateGaussianWeights(weights.data(), radius);
+        float total = 0.0f;
+        for (float weight : weights) {
+            total += weight;
+        }
+        EXPECT_NEAR(1.0f, total, 0.0001f);
+    }
+}
@@ -83,3 +83,35 @@ RENDERTHREAD_SKIA_PIPELINE_TEST(CacheManager, trimMemory) {
     renderThread.cacheManager().trimMemory(CacheManager::TrimMemoryMode::Complete);
     ASSERT_TRUE(0 == grContext->getResourceCachePurgeableBytes());
 }
+
+RENDERTHREAD_SKIA_PIPELINE_TEST(CacheManager, trimMemoryRunningLow) {
+    int32_t width = DeviceInfo::get()->getWidth();
+    int32_t height = DeviceInfo::get()->getHeight();
+    GrContext* grContext = renderThread.getGrContext();
+    ASSERT_TRUE(grContext != nullptr);
+    renderThread.cacheManager().trimMemory(CacheManager::TrimMemoryMode::Complete);
+
+    // an offscreen render target that becomes a scratch resource once it is freed
+    SkImageInfo info = SkImageInfo::MakeA8(width, height);
+    sk_sp<SkSurface> surface = SkSurface::MakeRenderTarget(grContext, SkBudgeted::kYes, info);
+    surface->getCanvas()->drawColor(SK_AlphaTRANSPARENT);
+    grContext->flush();
+    surface.reset();
+
+    // and an image texture with a unique key
+    sk_sp<Bitmap> bitmap = Bitmap::allocateHeapBitmap(info);
+    sk_sp<SkImage> image = bitmap->makeImage();
+    ASSERT_TRUE(SkImage_pinAsTexture(image.get(), grContext));
+    SkImage_unpinAsTexture(image.get(), grContext);
+
+    const size_t purgeableBytes = grContext->getResourceCachePurgeableBytes();
+    ASSERT_TRUE(0 < purgeableBytes);
+
+    // running low only drops the scratch resources, the image texture stays cached
+    renderThread.cacheManager().trimMemory(CacheManager::TrimMemoryMode::RunningLow);
+    ASSERT_TRUE(0 < grContext->getResourceCachePurgeableBytes());
+    ASSERT_TRUE(purgeableBytes > grContext->getResourceCachePurgeableBytes());
+
+    renderThread.cacheManager().trimMemory(CacheManager::TrimMemoryMode::Complete);
+    ASSERT_TRUE(0 == grContext->getResourceCachePurgeableBytes());
+}
@@ -22,6 +22,7 @@
 #include <condition_variable>
 #include <set>
 #include <thread>
+#include <vector>
 #include "unistd.h"
 
 using namespace android;
@@ -95,6 +96,54 @@ TEST(CommonPool, singleThread) {
     EXPECT_NE(gettid(), tid1);
 }
 
+TEST(CommonPool, higherPriorityRunsFirst) {
+    std::mutex mutex;
+    std::condition_variable fence;
+    bool isBlocking = false;
+    bool released = false;
+    std::vector<CommonPool::Priority> order;
+
+    // Keep one worker busy. A single queued task does not wake up the other worker, so both
+    // tasks below are queued by the time it picks one.
+    CommonPool::waitForIdle();
+    auto blocker = CommonPool::async([&] {
+        std::unique_lock lock{mutex};
+        isBlocking = true;
+        fence.notify_all();
+        while (!released) {
+            fence.wait(lock);
+        }
+    });
+    {
+        std::unique_lock lock{mutex};
+        while (!isBlocking) {
+            fence.wait(lock);
+        }
+    }
+
+    auto record = [&](CommonPool::Priority priority) {
+        return [&, priority] {
+            std::unique_lock lock{mutex};
+            order.push_back(priority);
+        };
+    };
+    auto low = CommonPool::async(record(CommonPool::Priority::Low), CommonPool::Priority::Low);
+    auto high = CommonPool::async(record(CommonPool::Priority::High), CommonPool::Priority::High);
+    low.get();
+    high.get();
+
+    {
+        std::unique_lock lock{mutex};
+        released = true;
+        fence.notify_all();
+    }
+    blocker.get();
+
+    ASSERT_EQ(2, order.size());
+    EXPECT_EQ(CommonPool::Priority::High, order[0]);
+    EXPECT_EQ(CommonPool::Priority::Low, order[1]);
+}
+
 // Test currently relies on timings
 // which makes it flaky, disable for now
 TEST(DISABLED_CommonPool, fullQueue) {
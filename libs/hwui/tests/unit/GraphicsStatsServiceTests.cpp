@@ -160,3 +160,59 @@ TEST(GraphicsStats, merge) {
         EXPECT_EQ(expectedBucket, loadedProto.histogram().Get(i).render_millis());
     }
 }
+
+TEST(GraphicsStats, mergeIntoProtoFile) {
+    std::string path = findRootPath() + "/test_mergeIntoProtoFile";
+    std::string packageName = "com.test.mergeIntoProtoFile";
+    MockProfileData mockData;
+    mockData.editJankFrameCount() = 20;
+    mockData.editTotalFrameCount() = 100;
+    for (size_t i = 0; i < mockData.editFrameCounts().size(); i++) {
+        mockData.editFrameCounts()[i] = (i % 5) + 1;
+    }
+
+    // Write stats the way older releases did: a version header followed by
+    // the serialized proto.
+    protos::GraphicsStatsProto oldProto;
+    oldProto.set_package_name(packageName);
+    oldProto.set_version_code(5);
+    oldProto.set_stats_start(3000);
+    oldProto.set_stats_end(7000);
+    oldProto.mutable_summary()->set_total_frames(10);
+    oldProto.mutable_summary()->set_janky_frames(2);
+    mockData.histogramForEach([&](ProfileData::HistogramEntry entry) {
+        auto bucket = oldProto.add_histogram();
+        bucket->set_render_millis(entry.renderTimeMs);
+        bucket->set_frame_count(1);
+    });
+    std::string serialized;
+    ASSERT_TRUE(oldProto.SerializeToString(&serialized));
+    int32_t version = 1;
+    FILE* file = fopen(path.c_str(), "w");
+    ASSERT_NE(nullptr, file);
+    fwrite(&version, sizeof(version), 1, file);
+    fwrite(serialized.data(), 1, serialized.size(), file);
+    fclose(file);
+
+    GraphicsStatsService::saveBuffer(path, packageName, 6, 7050, 10000, &mockData);
+    GraphicsStatsService::saveBuffer(path, packageName, 6, 10050, 12000, &mockData);
+
+    protos::GraphicsStatsProto loadedProto;
+    EXPECT_TRUE(GraphicsStatsService::parseFromFile(path, &loadedProto));
+    // Clean up the file
+    unlink(path.c_str());
+
+    EXPECT_EQ(packageName, loadedProto.package_name());
+    EXPECT_EQ(6, loadedProto.version_code());
+    EXPECT_EQ(3000, loadedProto.stats_start());
+    EXPECT_EQ(12000, loadedProto.stats_end());
+    ASSERT_TRUE(loadedProto.has_summary());
+    EXPECT_EQ(2 + 20 * 2, loadedProto.summary().janky_frames());
+    EXPECT_EQ(10 + 100 * 2, loadedProto.summary().total_frames());
+    ASSERT_EQ(mockData.editFrameCounts().size() + mockData.editSlowFrameCounts().size(),
+              (size_t)loadedProto.histogram_size());
+    for (size_t i = 0; i < mockData.editFrameCounts().size(); i++) {
+        int expectedCount = 1 + ((i % 5) + 1) * 2;
+        EXPECT_EQ(expectedCount, loadedProto.histogram().Get(i).frame_count());
+    }
+}
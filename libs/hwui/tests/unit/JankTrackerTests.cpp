@@ -0,0 +1,66 @@
+/*
+ * Copyright (C) 2020 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <gtest/gtest.h>
+
+#include "DeviceInfo.h"
+#include "JankTracker.h"
+
+using namespace android;
+using namespace android::uirenderer;
+
+static FrameInfo* addFrame(JankTracker& tracker, nsecs_t vsync, nsecs_t duration) {
+    FrameInfo* frame = tracker.startFrame();
+    memset(frame, 0, sizeof(FrameInfo));
+    frame->set(FrameInfoIndex::IntendedVsync) = vsync;
+    frame->set(FrameInfoIndex::Vsync) = vsync;
+    frame->set(FrameInfoIndex::HandleInputStart) = vsync;
+    frame->set(FrameInfoIndex::AnimationStart) = vsync;
+    frame->set(FrameInfoIndex::PerformTraversalsStart) = vsync;
+    frame->set(FrameInfoIndex::DrawStart) = vsync;
+    frame->set(FrameInfoIndex::SyncQueued) = vsync + duration / 4;
+    frame->set(FrameInfoIndex::SyncStart) = vsync + duration / 4;
+    frame->set(FrameInfoIndex::IssueDrawCommandsStart) = vsync + duration / 2;
+    frame->set(FrameInfoIndex::SwapBuffers) = vsync + duration * 3 / 4;
+    frame->set(FrameInfoIndex::FrameCompleted) = vsync + duration;
+    tracker.finishFrame(*frame);
+    return frame;
+}
+
+TEST(JankTracker, keepsJankyFrames) {
+    ProfileDataContainer globalData;
+    JankTracker tracker(&globalData);
+    const nsecs_t interval = DeviceInfo::getVsyncPeriod();
+
+    nsecs_t vsync = interval;
+    addFrame(tracker, vsync, interval / 4);
+    vsync += interval;
+    FrameInfo* janky = addFrame(tracker, vsync, interval * 3);
+    vsync += interval * 3;
+    addFrame(tracker, vsync, interval / 4);
+
+    ASSERT_EQ(1u, tracker.jankyFrames().size());
+    EXPECT_EQ(interval * 3, tracker.jankyFrames()[0].totalDuration());
+    EXPECT_EQ(-1, tracker.jankyFrames()[0].gpuDrawTime());
+
+    // The GPU time arrives later and is filled in on the kept copy.
+    janky->set(FrameInfoIndex::GpuCompleted) = (*janky)[FrameInfoIndex::SwapBuffers] + 1000;
+    tracker.finishGpuDraw(*janky);
+    EXPECT_EQ(1000, tracker.jankyFrames()[0].gpuDrawTime());
+
+    tracker.reset();
+    EXPECT_EQ(0u, tracker.jankyFrames().size());
+}
@@ -0,0 +1,76 @@
+/*
+ * Copyright (C) 2020 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <gtest/gtest.h>
+
+#include "pipeline/skia/LayerSurfacePool.h"
+#include "tests/common/TestUtils.h"
+
+using namespace android;
+using namespace android::uirenderer;
+using namespace android::uirenderer::skiapipeline;
+
+static sk_sp<SkSurface> makeSurface(GrContext* context, const SkImageInfo& info) {
+    return SkSurface::MakeRenderTarget(context, SkBudgeted::kYes, info);
+}
+
+RENDERTHREAD_SKIA_PIPELINE_TEST(LayerSurfacePool, reuseMatchingSurface) {
+    GrContext* context = renderThread.getGrContext();
+    const SkImageInfo small = SkImageInfo::MakeN32Premul(64, 64);
+    const SkImageInfo large = SkImageInfo::MakeN32Premul(128, 64);
+    LayerSurfacePool pool(small.computeMinByteSize() + large.computeMinByteSize());
+
+    sk_sp<SkSurface> surface = makeSurface(context, small);
+    SkSurface* raw = surface.get();
+    pool.put(std::move(surface));
+    EXPECT_EQ(1u, pool.count());
+    EXPECT_EQ(small.computeMinByteSize(), pool.size());
+
+    // different size or color type never matches
+    EXPECT_EQ(nullptr, pool.get(large));
+    EXPECT_EQ(nullptr, pool.get(small.makeColorType(kRGBA_F16_SkColorType)));
+
+    sk_sp<SkSurface> reused = pool.get(small);
+    EXPECT_EQ(raw, reused.get());
+    EXPECT_EQ(0u, pool.count());
+    EXPECT_EQ(0u, pool.size());
+    EXPECT_EQ(nullptr, pool.get(small));
+}
+
+RENDERTHREAD_SKIA_PIPELINE_TEST(LayerSurfacePool, evictOldestOverBudget) {
+    GrContext* context = renderThread.getGrContext();
+    const SkImageInfo info = SkImageInfo::MakeN32Premul(64, 64);
+    LayerSurfacePool pool(info.computeMinByteSize() * 2);
+
+    sk_sp<SkSurface> first = makeSurface(context, info);
+    SkSurface* firstRaw = first.get();
+    pool.put(std::move(first));
+    pool.put(makeSurface(context, info));
+    pool.put(makeSurface(context, info));
+    EXPECT_EQ(2u, pool.count());
+
+    // the first released surface was the one dropped
+    EXPECT_NE(firstRaw, pool.get(info).get());
+    EXPECT_NE(firstRaw, pool.get(info).get());
+
+    pool.put(makeSurface(context, SkImageInfo::MakeN32Premul(256, 256)));
+    EXPECT_EQ(0u, pool.count());
+
+    pool.put(makeSurface(context, info));
+    pool.clear();
+    EXPECT_EQ(0u, pool.count());
+    EXPECT_EQ(0u, pool.size());
+}
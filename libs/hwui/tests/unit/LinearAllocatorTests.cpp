@@ -86,6 +86,41 @@ TEST(LinearAllocator, rewind) {
     EXPECT_EQ(1, destroyed);
 }
 
+TEST(LinearAllocator, reset) {
+    int destroyed = 0;
+    LinearAllocator la;
+    la.create<TestUtils::SignalingDtor>()->setSignal(&destroyed);
+    for (int i = 0; i < 100; i++) {
+        la.alloc<char>(64);
+    }
+    la.alloc<char>(4096);  // dedicated page
+    EXPECT_EQ(0u, la.recycledSize());
+
+    la.reset();
+    EXPECT_EQ(1, destroyed);
+    EXPECT_EQ(0u, la.usedSize());
+    EXPECT_EQ(0u, la.allocatedSize());
+
+    // The same sequence of allocations is served entirely from recycled pages
+    for (int i = 0; i < 100; i++) {
+        la.alloc<char>(64);
+    }
+    EXPECT_LT(0u, la.recycledSize());
+    EXPECT_EQ(la.allocatedSize(), la.recycledSize());
+    EXPECT_EQ(la.allocatedSize() - la.usedSize(), la.wastedSize());
+    size_t recycled = la.recycledSize();
+
+    // A smaller use afterwards drops the pages it did not reach
+    la.reset();
+    la.alloc<char>(64);
+    EXPECT_GT(recycled, la.recycledSize());
+    la.reset();
+    la.alloc<char>(64);
+    la.alloc<char>(4096);
+    la.alloc<char>(64);
+    EXPECT_GT(la.allocatedSize(), la.recycledSize());
+}
+
 TEST(LinearStdAllocator, simpleAllocate) {
     LinearAllocator la;
     LinearStdAllocator<void*> stdAllocator(la);
@@ -0,0 +1,48 @@
+/*
+ * Copyright (C) 2020 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <gtest/gtest.h>
+
+#include "hwui/MinikinUtils.h"
+#include "hwui/Paint.h"
+
+#include <utils/String16.h>
+
+using namespace android;
+
+TEST(MinikinUtils, measureTextRunsMatchesMeasureText) {
+    Paint paint;
+    paint.getSkFont().setSize(20);
+    const String16 text(u"Hello world, one item per row");
+    const uint16_t* buf = reinterpret_cast<const uint16_t*>(text.string());
+    const size_t bufSize = text.size();
+
+    const std::vector<minikin::Range> runs = {
+            minikin::Range(0, 5), minikin::Range(6, 11), minikin::Range(13, 29),
+            minikin::Range(0, 29), minikin::Range(3, 3)};
+    std::vector<float> advances(runs.size());
+    MinikinUtils::measureTextRuns(&paint, minikin::Bidi::LTR, nullptr, buf, bufSize, runs.data(),
+                                  runs.size(), advances.data());
+
+    for (size_t i = 0; i < runs.size(); i++) {
+        float expected = MinikinUtils::measureText(&paint, minikin::Bidi::LTR, nullptr, buf,
+                                                   runs[i].getStart(), runs[i].getLength(),
+                                                   bufSize, nullptr);
+        EXPECT_EQ(expected, advances[i]) << "run " << i;
+    }
+    EXPECT_EQ(0.0f, advances[4]);
+    EXPECT_LT(0.0f, advances[0]);
+}
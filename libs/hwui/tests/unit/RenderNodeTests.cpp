@@ -328,3 +328,73 @@ RENDERTHREAD_TEST(DISABLED_RenderNode, prepareTree_HwLayer_AVD_enqueueDamage) {
     EXPECT_EQ(uirenderer::Rect(0, 0, 200, 400), info.layerUpdateQueue->entries().at(0).damage);
     canvasContext->destroy();
 }
+
+RENDERTHREAD_TEST(RenderNode, prepareTree_parallelSubtreesMatchSerialDamage) {
+    struct Tree {
+        sp<RenderNode> root;
+        std::vector<sp<RenderNode>> children;
+        std::vector<sp<RenderNode>> grandchildren;
+    };
+    auto createTree = []() {
+        Tree tree;
+        for (int i = 0; i < 16; i++) {
+            std::vector<sp<RenderNode>> leaves;
+            for (int j = 0; j < 8; j++) {
+                leaves.push_back(TestUtils::createNode(j * 10, 0, j * 10 + 10, 10,
+                                                       [](RenderProperties& props, Canvas& canvas) {
+                                                           canvas.drawColor(Color::Red_500,
+                                                                            SkBlendMode::kSrcOver);
+                                                       }));
+            }
+            tree.children.push_back(TestUtils::createNode(
+                    0, i * 10, 100, i * 10 + 10, [&leaves](RenderProperties& props, Canvas& canvas) {
+                        for (auto& leaf : leaves) {
+                            canvas.drawRenderNode(leaf.get());
+                        }
+                    }));
+            tree.grandchildren.insert(tree.grandchildren.end(), leaves.begin(), leaves.end());
+        }
+        tree.root = TestUtils::createNode(0, 0, 200, 400, [&tree](RenderProperties& props,
+                                                                 Canvas& canvas) {
+            for (auto& child : tree.children) {
+                canvas.drawRenderNode(child.get());
+            }
+        });
+        return tree;
+    };
+
+    Tree serialTree = createTree();
+    Tree parallelTree = createTree();
+    ContextFactory contextFactory;
+    std::unique_ptr<CanvasContext> canvasContext(
+            CanvasContext::create(renderThread, false, serialTree.root.get(), &contextFactory));
+
+    auto prepare = [&](Tree& tree, bool allowParallelPrepare) {
+        TreeInfo info(TreeInfo::MODE_FULL, *canvasContext.get());
+        DamageAccumulator damageAccumulator;
+        info.damageAccumulator = &damageAccumulator;
+        info.allowParallelPrepare = allowParallelPrepare;
+        tree.root->prepareTree(info);
+        SkRect dirty;
+        damageAccumulator.finish(&dirty);
+        return dirty;
+    };
+
+    // The first frame adds every node to the tree, so nothing can be prepared in parallel yet.
+    EXPECT_EQ(prepare(serialTree, false), prepare(parallelTree, true));
+    for (auto& child : parallelTree.children) {
+        EXPECT_EQ(9, child->parallelPrepareSubtreeSize());
+    }
+
+    for (Tree* tree : {&serialTree, &parallelTree}) {
+        tree->grandchildren[3]->mutateStagingProperties().setTranslationX(5);
+        tree->grandchildren[3]->setPropertyFieldsDirty(RenderNode::TRANSLATION_X);
+        TestUtils::recordNode(*tree->grandchildren[77], [](Canvas& canvas) {
+            canvas.drawColor(Color::Blue_500, SkBlendMode::kSrcOver);
+        });
+    }
+    EXPECT_EQ(prepare(serialTree, false), prepare(parallelTree, true));
+    EXPECT_TRUE(parallelTree.grandchildren[77]->getDisplayList());
+
+    canvasContext->destroy();
+}
@@ -47,15 +47,23 @@ public:
      * Next call to "initShaderDiskCache" will load again the in-memory cache from disk.
      */
     static void terminate(ShaderCache& cache, bool saveContent) {
-        std::lock_guard<std::mutex> lock(cache.mMutex);
+        std::unique_lock<std::mutex> lock(cache.mMutex);
         cache.mSavePending = saveContent;
-        cache.saveToDiskLocked();
+        cache.saveToDiskLocked(lock);
         cache.mBlobCache = NULL;
     }
 
     /**
      *
      */
+    /**
+     * "precompileKeys" returns the keys of the shaders queued for precompilation, most used first.
+     */
+    static std::vector<std::string> precompileKeys(ShaderCache& cache) {
+        std::lock_guard<std::mutex> lock(cache.mMutex);
+        return cache.mPrecompileKeys;
+    }
+
     template <typename T>
     static bool validateCache(ShaderCache& cache, std::vector<T> hash) {
         return cache.validateCache(hash.data(), hash.size() * sizeof(T));
@@ -279,4 +287,41 @@ TEST(ShaderCacheTest, testCacheValidation) {
     remove(cacheFile1.c_str());
 }
 
+TEST(ShaderCacheTest, testUsageOrder) {
+    if (!folderExist(getExternalStorageFolder())) {
+        // don't run the test if external storage folder is not available
+        return;
+    }
+    std::string cacheFile1 = getExternalStorageFolder() + "/shaderCacheTest1";
+
+    // remove any test files from previous test run
+    int deleteFile = remove(cacheFile1.c_str());
+    ASSERT_TRUE(0 == deleteFile || ENOENT == errno);
+
+    ShaderCache::get().setFilename(cacheFile1.c_str());
+    ShaderCacheTestUtils::setSaveDelay(ShaderCache::get(), 0);  // disable deferred save
+    ShaderCache::get().initShaderDiskCache();
+    ASSERT_TRUE(ShaderCacheTestUtils::precompileKeys(ShaderCache::get()).empty());
+
+    sk_sp<SkData> inVS;
+    setShader(inVS, "sassas");
+    ShaderCache::get().store(GrProgramDescTest(100), *inVS.get());
+    ShaderCache::get().store(GrProgramDescTest(200), *inVS.get());
+    ShaderCache::get().store(GrProgramDescTest(300), *inVS.get());
+    for (int i = 0; i < 3; i++) {
+        ASSERT_NE(ShaderCache::get().load(GrProgramDescTest(300)), sk_sp<SkData>());
+    }
+    ASSERT_NE(ShaderCache::get().load(GrProgramDescTest(200)), sk_sp<SkData>());
+
+    // the use counts are stored on disk with the shaders and ranked when the cache is loaded
+    ShaderCacheTestUtils::terminate(ShaderCache::get(), true);
+    ShaderCache::get().initShaderDiskCache();
+    std::vector<std::string> keys = ShaderCacheTestUtils::precompileKeys(ShaderCache::get());
+    ASSERT_EQ(3u, keys.size());
+    ASSERT_EQ(std::string("300", sizeof("300")), keys[0]);
+
+    ShaderCacheTestUtils::terminate(ShaderCache::get(), false);
+    remove(cacheFile1.c_str());
+}
+
 }  // namespace
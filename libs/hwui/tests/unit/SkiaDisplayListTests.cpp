@@ -360,6 +360,37 @@ RENDERTHREAD_SKIA_PIPELINE_TEST(SkiaDisplayList, prepareListAndChildren_vdOffscr
     }
 }
 
+TEST(SkiaDisplayList, elideNoOps) {
+    std::unique_ptr<SkiaDisplayList> skiaDL;
+    {
+        SkiaRecordingCanvas canvas{nullptr, 100, 100};
+        SkCanvas* skCanvas = canvas.asSkCanvas();
+        SkPaint paint;
+
+        // An empty save/restore pair.
+        skCanvas->save();
+        skCanvas->translate(10, 10);
+        skCanvas->restore();
+
+        // A draw under an empty clip.
+        skCanvas->save();
+        skCanvas->clipRect(SkRect::MakeEmpty());
+        skCanvas->drawRect(SkRect::MakeWH(50, 50), paint);
+        skCanvas->restore();
+
+        skCanvas->drawRect(SkRect::MakeWH(50, 50), paint);
+        skiaDL.reset(canvas.finishRecording());
+    }
+
+    skiaDL->mDisplayList.elideNoOps();
+    EXPECT_EQ(8, skiaDL->mDisplayList.opCount());
+    EXPECT_EQ(7, skiaDL->mDisplayList.elidedOpCount());
+
+    // Eliding again must not count the same ops twice.
+    skiaDL->mDisplayList.elideNoOps();
+    EXPECT_EQ(7, skiaDL->mDisplayList.elidedOpCount());
+}
+
 TEST(SkiaDisplayList, updateChildren) {
     SkiaDisplayList skiaDL;
 
@@ -0,0 +1,84 @@
+/*
+ * Copyright (C) 2020 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <gtest/gtest.h>
+
+#include "StageHistogram.h"
+
+using namespace android;
+using namespace android::uirenderer;
+
+TEST(StageHistogram, bucketBoundsWithinPrecision) {
+    for (int precisionBits = StageHistogram::kMinPrecisionBits;
+         precisionBits <= StageHistogram::kMaxPrecisionBits; precisionBits++) {
+        StageHistogram histogram(precisionBits);
+        size_t lastIndex = 0;
+        for (int64_t micros = 0; micros <= StageHistogram::kMaxMicros; micros += 1 + micros / 64) {
+            size_t index = histogram.bucketIndexForMicros(micros);
+            int64_t lowerBound = histogram.lowerBoundMicrosForBucketIndex(index);
+            ASSERT_GE(index, lastIndex);
+            ASSERT_LE(lowerBound, micros);
+            // The bucket covers less than 1 / 2^precisionBits of its lower bound.
+            ASSERT_LT((micros - lowerBound) << precisionBits, std::max<int64_t>(lowerBound, 1))
+                    << "precision " << precisionBits << " micros " << micros;
+            lastIndex = index;
+        }
+    }
+}
+
+TEST(StageHistogram, smallDurationsAreExact) {
+    StageHistogram histogram(3);
+    for (int64_t micros = 0; micros < 8; micros++) {
+        EXPECT_EQ(micros, histogram.lowerBoundMicrosForBucketIndex(
+                                  histogram.bucketIndexForMicros(micros)));
+    }
+}
+
+TEST(StageHistogram, percentiles) {
+    StageHistogram histogram(3);
+    EXPECT_EQ(0, histogram.findPercentile(50));
+
+    for (int i = 0; i < 90; i++) {
+        histogram.record(us2ns(4));
+    }
+    for (int i = 0; i < 10; i++) {
+        histogram.record(ms2ns(20));
+    }
+    EXPECT_EQ(100u, histogram.count());
+    EXPECT_EQ(4, histogram.findPercentile(50));
+    EXPECT_LE(histogram.findPercentile(95), 20000);
+    EXPECT_GT(histogram.findPercentile(95), 20000 - 20000 / 8);
+
+    int buckets = 0;
+    histogram.forEachBucket([&buckets](int64_t, uint32_t count) {
+        buckets++;
+        EXPECT_TRUE(count == 90 || count == 10);
+    });
+    EXPECT_EQ(2, buckets);
+
+    histogram.reset();
+    EXPECT_EQ(0u, histogram.count());
+    EXPECT_EQ(0, histogram.findPercentile(99));
+}
+
+TEST(StageHistogram, clampsOutOfRange) {
+    StageHistogram histogram(3);
+    histogram.record(-1);
+    histogram.record(seconds_to_nanoseconds(100));
+    EXPECT_EQ(2u, histogram.count());
+    EXPECT_EQ(0, histogram.findPercentile(0));
+    EXPECT_LE(histogram.findPercentile(99), StageHistogram::kMaxMicros);
+}
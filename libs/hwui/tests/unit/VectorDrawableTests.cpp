@@ -18,10 +18,13 @@
 
 #include "PathParser.h"
 #include "VectorDrawable.h"
+#include "pipeline/skia/VectorDrawableCache.h"
+#include "tests/common/TestUtils.h"
 #include "utils/MathUtils.h"
 #include "utils/VectorDrawableUtils.h"
 
 #include <functional>
+#include <string>
 
 namespace android {
 namespace uirenderer {
@@ -273,6 +276,50 @@ TEST(PathParser, parseStringForData) {
     }
 }
 
+TEST(PathParser, parseStringForDataCached) {
+    PathParser::clearPathDataCache();
+    for (const TestData& testData : sTestDataSet) {
+        size_t length = strlen(testData.pathString);
+        for (int i = 0; i < 2; i++) {
+            PathParser::ParseResult result;
+            PathData pathData;
+            PathParser::getPathDataFromAsciiString(&pathData, &result, testData.pathString,
+                                                   length);
+            EXPECT_EQ(testData.pathData, pathData);
+        }
+
+        // Cached data is appended to the output, like freshly parsed data.
+        PathParser::ParseResult result;
+        PathData pathData = testData.pathData;
+        PathParser::getPathDataFromAsciiString(&pathData, &result, testData.pathString, length);
+        EXPECT_EQ(2 * testData.pathData.verbs.size(), pathData.verbs.size());
+        EXPECT_EQ(2 * testData.pathData.points.size(), pathData.points.size());
+    }
+    PathParser::clearPathDataCache();
+}
+
+TEST(PathParser, parseFloats) {
+    // Mixes numbers that are parsed exactly without strtof with ones that are not.
+    const char* numbers[] = {"0.1",  "-2.5e1",   "1.000000", "22.000000", "-0",     ".5",
+                             "1e10", "16777217", "1e-12",    "3.4e38",    "-7.125", "0.0000001"};
+    std::string pathString = "M";
+    for (const char* number : numbers) {
+        pathString += " ";
+        pathString += number;
+    }
+
+    PathParser::ParseResult result;
+    PathData pathData;
+    PathParser::getPathDataFromAsciiString(&pathData, &result, pathString.c_str(),
+                                           pathString.size());
+    ASSERT_FALSE(result.failureOccurred);
+    ASSERT_EQ(sizeof(numbers) / sizeof(numbers[0]), pathData.points.size());
+    for (size_t i = 0; i < pathData.points.size(); i++) {
+        float expected = strtof(numbers[i], nullptr);
+        EXPECT_EQ(0, memcmp(&expected, &pathData.points[i], sizeof(float))) << numbers[i];
+    }
+}
+
 TEST(VectorDrawableUtils, createSkPathFromPathData) {
     for (const TestData& testData : sTestDataSet) {
         SkPath expectedPath;
@@ -409,5 +456,57 @@ TEST(VectorDrawable, drawPathWithoutIncrementingShaderRefCount) {
     EXPECT_TRUE(shader->unique());
 }
 
+static SkColor getRasterColor(Bitmap& bitmap, int x, int y) {
+    SkBitmap skBitmap;
+    bitmap.getSkBitmap(&skBitmap);
+    return skBitmap.getColor(x, y);
+}
+
+RENDERTHREAD_TEST(VectorDrawable, shareRasterBetweenIdenticalTrees) {
+    ScopedProperty<bool> prop(Properties::shareVectorDrawableRasters, true);
+    auto& cache = renderThread.cacheManager().vectorDrawableCache();
+    cache.clear();
+
+    const char* pathString = "M0 0 L10 10 L0 10 Z";
+    auto createTree = [&](SkColor fillColor, VectorDrawable::FullPath** outPath) {
+        VectorDrawable::FullPath* path =
+                new VectorDrawable::FullPath(pathString, strlen(pathString));
+        path->mutateStagingProperties()->setFillColor(fillColor);
+        VectorDrawable::Group* group = new VectorDrawable::Group();
+        group->addChild(path);
+        sp<VectorDrawableRoot> tree(new VectorDrawableRoot(group));
+        tree->mutateStagingProperties()->setViewportSize(10, 10);
+        tree->mutateStagingProperties()->setScaledSize(20, 20);
+        tree->syncProperties();
+        if (outPath) {
+            *outPath = path;
+        }
+        return tree;
+    };
+
+    VectorDrawable::FullPath* secondPath;
+    sp<VectorDrawableRoot> first = createTree(SK_ColorRED, nullptr);
+    sp<VectorDrawableRoot> second = createTree(SK_ColorRED, &secondPath);
+    sp<VectorDrawableRoot> third = createTree(SK_ColorBLUE, nullptr);
+
+    EXPECT_EQ(&first->getBitmapUpdateIfDirty(), &second->getBitmapUpdateIfDirty());
+    EXPECT_NE(&first->getBitmapUpdateIfDirty(), &third->getBitmapUpdateIfDirty());
+    EXPECT_EQ(2u, cache.count());
+
+    // Changing one of the sharing trees gives it a raster of its own, and leaves the shared one
+    // untouched.
+    secondPath->mutateStagingProperties()->setFillColor(SK_ColorGREEN);
+    second->syncProperties();
+    EXPECT_TRUE(second->isDirty());
+    Bitmap& secondBitmap = second->getBitmapUpdateIfDirty();
+    EXPECT_NE(&first->getBitmapUpdateIfDirty(), &secondBitmap);
+    EXPECT_EQ(SK_ColorRED, getRasterColor(first->getBitmapUpdateIfDirty(), 2, 15));
+    EXPECT_EQ(SK_ColorGREEN, getRasterColor(secondBitmap, 2, 15));
+    EXPECT_EQ(3u, cache.count());
+
+    cache.clear();
+    EXPECT_EQ(0u, cache.size());
+}
+
 }  // namespace uirenderer
 }  // namespace android
@@ -108,6 +108,32 @@ TEST(WebViewFunctor, createSyncDrawGLES) {
     EXPECT_EQ(1, counts.destroyed);
 }
 
+TEST(WebViewFunctor, concurrentSyncAndGpuTime) {
+    int functor = WebViewFunctor_create(
+            nullptr, TestUtils::createMockFunctor(RenderMode::OpenGL_ES), RenderMode::OpenGL_ES);
+    ASSERT_NE(-1, functor);
+    auto handle = WebViewFunctorManager::instance().handleFor(functor);
+    ASSERT_TRUE(handle);
+    EXPECT_FALSE(handle->concurrentSync());
+    WebViewFunctor_setConcurrentSync(functor, true);
+    EXPECT_TRUE(handle->concurrentSync());
+    WebViewFunctor_setConcurrentSync(functor, false);
+    EXPECT_FALSE(handle->concurrentSync());
+
+    WebViewFunctorManager::instance().takeReportedGpuTime();
+    WebViewFunctor_reportGpuTime(functor, 2000);
+    WebViewFunctor_reportGpuTime(functor, -1);
+    WebViewFunctor_reportGpuTime(functor, 3000);
+    EXPECT_EQ(5000, WebViewFunctorManager::instance().takeReportedGpuTime());
+    EXPECT_EQ(0, WebViewFunctorManager::instance().takeReportedGpuTime());
+
+    WebViewFunctor_release(functor);
+    handle.clear();
+    TestUtils::runOnRenderThreadUnmanaged([](renderthread::RenderThread&) {
+        // fence
+    });
+}
+
 TEST(WebViewFunctor, contextDestroyed) {
     int functor = WebViewFunctor_create(
             nullptr, TestUtils::createMockFunctor(RenderMode::OpenGL_ES), RenderMode::OpenGL_ES);
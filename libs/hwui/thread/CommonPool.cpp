@@ -25,6 +25,9 @@
 namespace android {
 namespace uirenderer {
 
+// The index of the CommonPool worker running on this thread, or -1 on any other thread.
+static thread_local int sWorkerIndex = -1;
+
 CommonPool::CommonPool() {
     ATRACE_CALL();
 
@@ -43,7 +46,7 @@ CommonPool::CommonPool() {
                     startHook(name.data());
                 }
             }
-            pool->workerLoop();
+            pool->workerLoop(i);
         });
         worker.detach();
     }
@@ -54,39 +57,93 @@ CommonPool& CommonPool::instance() {
     return pool;
 }
 
-void CommonPool::post(Task&& task) {
-    instance().enqueue(std::move(task));
+void CommonPool::post(Task&& task, Priority priority) {
+    instance().enqueue(std::move(task), priority);
 }
 
-void CommonPool::enqueue(Task&& task) {
+void CommonPool::enqueue(Task&& task, Priority priority) {
+    const int firstWorker =
+            sWorkerIndex >= 0 ? sWorkerIndex : static_cast<int>(mNextWorker++ % THREAD_COUNT);
+    if (tryEnqueue(firstWorker, priority, task)) {
+        std::unique_lock lock(mLock);
+        notifyWorkerLocked();
+        return;
+    }
+
+    if (sWorkerIndex >= 0) {
+        // Every queue is full. Waiting for space on a worker could leave all workers waiting
+        // on each other, so run the task right here instead.
+        task();
+        return;
+    }
+
     std::unique_lock lock(mLock);
-    while (!mWorkQueue.hasSpace()) {
-        lock.unlock();
-        usleep(100);
-        lock.lock();
+    mBlockedPosters++;
+    while (!tryEnqueue(firstWorker, priority, task)) {
+        mSpaceAvailable.wait(lock);
+    }
+    mBlockedPosters--;
+    notifyWorkerLocked();
+}
+
+bool CommonPool::tryEnqueue(int firstWorker, Priority priority, Task& task) {
+    for (int i = 0; i < THREAD_COUNT; i++) {
+        Worker& worker = mWorkers[(firstWorker + i) % THREAD_COUNT];
+        std::lock_guard lock(worker.lock);
+        auto& queue = worker.queues[static_cast<int>(priority)];
+        if (queue.hasSpace()) {
+            queue.push(std::move(task));
+            mQueuedTasks++;
+            return true;
+        }
     }
-    mWorkQueue.push(std::move(task));
-    if (mWaitingThreads == THREAD_COUNT || (mWaitingThreads > 0 && mWorkQueue.size() > 1)) {
+    return false;
+}
+
+void CommonPool::notifyWorkerLocked() {
+    if (mWaitingThreads == THREAD_COUNT || (mWaitingThreads > 0 && mQueuedTasks > 1)) {
         mCondition.notify_one();
     }
 }
 
-void CommonPool::workerLoop() {
-    std::unique_lock lock(mLock);
+bool CommonPool::tryTakeTask(int self, Task* outTask) {
+    bool found = false;
+    for (int priority = 0; priority < PRIORITY_COUNT && !found; priority++) {
+        for (int i = 0; i < THREAD_COUNT && !found; i++) {
+            Worker& worker = mWorkers[(self + i) % THREAD_COUNT];
+            std::lock_guard lock(worker.lock);
+            auto& queue = worker.queues[priority];
+            if (queue.hasWork()) {
+                *outTask = queue.pop();
+                mQueuedTasks--;
+                found = true;
+            }
+        }
+    }
+    if (found && mBlockedPosters > 0) {
+        std::unique_lock lock(mLock);
+        mSpaceAvailable.notify_all();
+    }
+    return found;
+}
+
+void CommonPool::workerLoop(int index) {
+    sWorkerIndex = index;
+    Task work;
     while (true) {
-        if (!mWorkQueue.hasWork()) {
+        if (tryTakeTask(index, &work)) {
+            work();
+            work = nullptr;
+            continue;
+        }
+        std::unique_lock lock(mLock);
+        // Tasks are counted before the poster takes mLock to wake anyone up, so checking the
+        // count here cannot miss a wakeup.
+        if (mQueuedTasks == 0) {
             mWaitingThreads++;
             mCondition.wait(lock);
             mWaitingThreads--;
         }
-        // Need to double-check that work is still available now that we have the lock
-        // It may have already been grabbed by a different thread
-        while (mWorkQueue.hasWork()) {
-            auto work = mWorkQueue.pop();
-            lock.unlock();
-            work();
-            lock.lock();
-        }
     }
 }
 
@@ -104,4 +161,4 @@ void CommonPool::doWaitForIdle() {
 }
 
 }  // namespace uirenderer
-}  // namespace android
\ No newline at end of file
+}  // namespace android
@@ -21,6 +21,8 @@
 
 #include <log/log.h>
 
+#include <array>
+#include <atomic>
 #include <condition_variable>
 #include <functional>
 #include <future>
@@ -80,20 +82,27 @@ public:
     static constexpr auto THREAD_COUNT = 2;
     static constexpr auto QUEUE_SIZE = 128;
 
-    static void post(Task&& func);
+    // A worker always starts the most urgent task queued on any worker. Frame-critical work
+    // such as uploads the next frame waits on should be High, background work that nothing
+    // waits on (e.g. saving captures) should be Low.
+    enum class Priority { High, Normal, Low };
+    static constexpr auto PRIORITY_COUNT = 3;
+
+    static void post(Task&& func, Priority priority = Priority::Normal);
 
     template <class F>
-    static auto async(F&& func) -> std::future<decltype(func())> {
+    static auto async(F&& func, Priority priority = Priority::Normal)
+            -> std::future<decltype(func())> {
         typedef std::packaged_task<decltype(func())()> task_t;
         auto task = std::make_shared<task_t>(std::forward<F>(func));
-        post([task]() { std::invoke(*task); });
+        post([task]() { std::invoke(*task); }, priority);
         return task->get_future();
     }
 
     template <class F>
-    static auto runSync(F&& func) -> decltype(func()) {
+    static auto runSync(F&& func, Priority priority = Priority::Normal) -> decltype(func()) {
         std::packaged_task<decltype(func())()> task{std::forward<F>(func)};
-        post([&task]() { std::invoke(task); });
+        post([&task]() { std::invoke(task); }, priority);
         return task.get_future().get();
     };
 
@@ -106,15 +115,33 @@ private:
     CommonPool();
     ~CommonPool() {}
 
-    void enqueue(Task&&);
+    // Each worker owns a queue per priority. Tasks posted by a worker go to its own queues,
+    // other threads spread their tasks over the workers, and idle workers steal from the
+    // others.
+    struct Worker {
+        std::mutex lock;
+        std::array<ArrayQueue<Task, QUEUE_SIZE>, PRIORITY_COUNT> queues;
+    };
+
+    void enqueue(Task&&, Priority);
+    bool tryEnqueue(int firstWorker, Priority, Task&);
+    bool tryTakeTask(int self, Task* outTask);
+    void notifyWorkerLocked();
     void doWaitForIdle();
 
-    void workerLoop();
+    void workerLoop(int index);
+
+    std::array<Worker, THREAD_COUNT> mWorkers;
+    std::atomic_uint mNextWorker{0};
+    std::atomic_int mQueuedTasks{0};
+    std::atomic_int mBlockedPosters{0};
 
+    // Guards sleeping and waking up, both of workers waiting for work and of threads waiting
+    // for queue space. Never acquired while holding a Worker::lock.
     std::mutex mLock;
     std::condition_variable mCondition;
+    std::condition_variable mSpaceAvailable;
     int mWaitingThreads = 0;
-    ArrayQueue<Task, QUEUE_SIZE> mWorkQueue;
 };
 
 }  // namespace uirenderer
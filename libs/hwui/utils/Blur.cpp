@@ -16,6 +16,9 @@
 
 #include <math.h>
 
+#include <algorithm>
+#include <vector>
+
 #include "Blur.h"
 #include "MathUtils.h"
 
@@ -91,90 +94,59 @@ void Blur::generateGaussianWeights(float* weights, float radius) {
     }
 }
 
+// Both passes accumulate one tap at a time over a whole row instead of one pixel at a time over
+// all taps. The inner loops are then straight multiply-adds over contiguous floats, which the
+// compiler turns into NEON/SSE code, and the taps are still summed in the same order as before so
+// the output does not change.
+static void accumulateRow(float weight, const uint8_t* __restrict input, float* __restrict sums,
+                          int32_t width) {
+    for (int32_t x = 0; x < width; x++) {
+        sums[x] += (float)input[x] * weight;
+    }
+}
+
+static void storeRow(const float* sums, uint8_t* output, int32_t width) {
+    for (int32_t x = 0; x < width; x++) {
+        output[x] = (uint8_t)sums[x];
+    }
+}
+
 void Blur::horizontal(float* weights, int32_t radius, const uint8_t* source, uint8_t* dest,
                       int32_t width, int32_t height) {
-    float blurredPixel = 0.0f;
-    float currentPixel = 0.0f;
+    if (width <= 0) {
+        return;
+    }
+    // Each row is copied with its edge pixels repeated radius times on both sides, which removes
+    // the clamping from the inner loop.
+    std::vector<uint8_t> padded(width + 2 * radius);
+    std::vector<float> sums(width);
 
     for (int32_t y = 0; y < height; y++) {
         const uint8_t* input = source + y * width;
-        uint8_t* output = dest + y * width;
-
-        for (int32_t x = 0; x < width; x++) {
-            blurredPixel = 0.0f;
-            const float* gPtr = weights;
-            // Optimization for non-border pixels
-            if (x > radius && x < (width - radius)) {
-                const uint8_t* i = input + (x - radius);
-                for (int r = -radius; r <= radius; r++) {
-                    currentPixel = (float)(*i);
-                    blurredPixel += currentPixel * gPtr[0];
-                    gPtr++;
-                    i++;
-                }
-            } else {
-                for (int32_t r = -radius; r <= radius; r++) {
-                    // Stepping left and right away from the pixel
-                    int validW = x + r;
-                    if (validW < 0) {
-                        validW = 0;
-                    }
-                    if (validW > width - 1) {
-                        validW = width - 1;
-                    }
-
-                    currentPixel = (float)input[validW];
-                    blurredPixel += currentPixel * gPtr[0];
-                    gPtr++;
-                }
-            }
-            *output = (uint8_t)blurredPixel;
-            output++;
+        std::fill(padded.begin(), padded.begin() + radius, input[0]);
+        std::copy(input, input + width, padded.begin() + radius);
+        std::fill(padded.end() - radius, padded.end(), input[width - 1]);
+
+        std::fill(sums.begin(), sums.end(), 0.0f);
+        for (int32_t r = 0; r <= 2 * radius; r++) {
+            accumulateRow(weights[r], padded.data() + r, sums.data(), width);
         }
+        storeRow(sums.data(), dest + y * width, width);
     }
 }
 
 void Blur::vertical(float* weights, int32_t radius, const uint8_t* source, uint8_t* dest,
                     int32_t width, int32_t height) {
-    float blurredPixel = 0.0f;
-    float currentPixel = 0.0f;
+    std::vector<float> sums(width);
 
     for (int32_t y = 0; y < height; y++) {
-        uint8_t* output = dest + y * width;
-
-        for (int32_t x = 0; x < width; x++) {
-            blurredPixel = 0.0f;
-            const float* gPtr = weights;
-            const uint8_t* input = source + x;
-            // Optimization for non-border pixels
-            if (y > radius && y < (height - radius)) {
-                const uint8_t* i = input + ((y - radius) * width);
-                for (int32_t r = -radius; r <= radius; r++) {
-                    currentPixel = (float)(*i);
-                    blurredPixel += currentPixel * gPtr[0];
-                    gPtr++;
-                    i += width;
-                }
-            } else {
-                for (int32_t r = -radius; r <= radius; r++) {
-                    int validH = y + r;
-                    // Clamp to zero and width
-                    if (validH < 0) {
-                        validH = 0;
-                    }
-                    if (validH > height - 1) {
-                        validH = height - 1;
-                    }
-
-                    const uint8_t* i = input + validH * width;
-                    currentPixel = (float)(*i);
-                    blurredPixel += currentPixel * gPtr[0];
-                    gPtr++;
-                }
-            }
-            *output = (uint8_t)blurredPixel;
-            output++;
+        std::fill(sums.begin(), sums.end(), 0.0f);
+        for (int32_t r = -radius; r <= radius; r++) {
+            // Clamp to the first and last rows
+            int32_t validH = std::min(std::max(y + r, 0), height - 1);
+            accumulateRow(weights[r + radius], source + validH * width, sums.data(), width);
         }
+        storeRow(sums.data(), dest + y * width, width);
     }
 }
 
@@ -105,12 +105,21 @@ LinearAllocator::LinearAllocator()
         , mDedicatedPageCount(0) {}
 
 LinearAllocator::~LinearAllocator(void) {
+    runDestructors();
+    freePages(mPages);
+    freePages(mDedicatedPages);
+    freePages(mRecycledPages);
+}
+
+void LinearAllocator::runDestructors() {
     while (mDtorList) {
         auto node = mDtorList;
         mDtorList = node->next;
         node->dtor(node->addr);
     }
-    Page* p = mPages;
+}
+
+void LinearAllocator::freePages(Page* p) {
     while (p) {
         Page* next = p->next();
         p->~Page();
@@ -120,6 +129,28 @@ LinearAllocator::~LinearAllocator(void) {
     }
 }
 
+void LinearAllocator::reset() {
+    runDestructors();
+
+    // Whatever the last use did not reach is not worth keeping around for the next one.
+    freePages(mRecycledPages);
+    freePages(mDedicatedPages);
+    mRecycledPages = mPages;
+    mDedicatedPages = nullptr;
+
+    mPageSize = INITIAL_PAGE_SIZE;
+    mMaxAllocSize = INITIAL_PAGE_SIZE * MAX_WASTE_RATIO;
+    mNext = 0;
+    mCurrentPage = 0;
+    mPages = 0;
+    mTotalAllocated = 0;
+    mWastedSpace = 0;
+    mPageCount = 0;
+    mDedicatedPageCount = 0;
+    mRecycledSize = 0;
+    mRecycledPageCount = 0;
+}
+
 void* LinearAllocator::start(Page* p) {
     return ALIGN_PTR((size_t)p + sizeof(Page));
 }
@@ -141,7 +172,21 @@ void LinearAllocator::ensureNext(size_t size) {
         mPageSize = ALIGN(mPageSize);
     }
     mWastedSpace += mPageSize;
-    Page* p = newPage(mPageSize);
+    Page* p;
+    if (mRecycledPages) {
+        // Pages are recycled in the order they were allocated, and page sizes only depend on
+        // that order, so the next recycled page is exactly mPageSize large.
+        p = mRecycledPages;
+        mRecycledPages = p->next();
+        p->setNext(nullptr);
+        size_t allocationSize = ALIGN(mPageSize + sizeof(LinearAllocator::Page));
+        mTotalAllocated += allocationSize;
+        mRecycledSize += allocationSize;
+        mPageCount++;
+        mRecycledPageCount++;
+    } else {
+        p = newPage(mPageSize);
+    }
     if (mCurrentPage) {
         mCurrentPage->setNext(p);
     }
@@ -157,11 +202,11 @@ void* LinearAllocator::allocImpl(size_t size) {
     if (size > mMaxAllocSize && !fitsInCurrentPage(size)) {
         ALOGV("Exceeded max size %zu > %zu", size, mMaxAllocSize);
         // Allocation is too large, create a dedicated page for the allocation
+        // Dedicated pages are kept apart from mPages so that only the regular ones get recycled
         Page* page = newPage(size);
         mDedicatedPageCount++;
-        page->setNext(mPages);
-        mPages = page;
-        if (!mCurrentPage) mCurrentPage = mPages;
+        page->setNext(mDedicatedPages);
+        mDedicatedPages = page;
         return start(page);
     }
     ensureNext(size);
@@ -209,7 +254,7 @@ void LinearAllocator::rewindIfLastAlloc(void* ptr, size_t allocSize) {
     runDestructorFor(ptr);
     // Don't bother rewinding across pages
     allocSize = ALIGN(allocSize);
-    if (ptr >= start(mCurrentPage) && ptr < end(mCurrentPage) &&
+    if (mCurrentPage && ptr >= start(mCurrentPage) && ptr < end(mCurrentPage) &&
         ptr == ((char*)mNext - allocSize)) {
         mWastedSpace += allocSize;
         mNext = ptr;
@@ -246,7 +291,10 @@ void LinearAllocator::dumpMemoryStats(const char* prefix) {
     prettySuffix = toSize(mWastedSpace, prettySize);
     ALOGD("%sWasted space: %.2f%s (%.1f%%)", prefix, prettySize, prettySuffix,
           (float)mWastedSpace / (float)mTotalAllocated * 100.0f);
-    ALOGD("%sPages %zu (dedicated %zu)", prefix, mPageCount, mDedicatedPageCount);
+    ALOGD("%sPages %zu (dedicated %zu, recycled %zu)", prefix, mPageCount, mDedicatedPageCount,
+          mRecycledPageCount);
+    prettySuffix = toSize(mRecycledSize, prettySize);
+    ALOGD("%sRecycled space: %.2f%s", prefix, prettySize, prettySuffix);
 }
 
 }  // namespace uirenderer
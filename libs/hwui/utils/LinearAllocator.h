@@ -105,6 +105,15 @@ public:
         rewindIfLastAlloc((void*)ptr, sizeof(T));
     }
 
+    /**
+     * Runs all pending destructors and rewinds the allocator so that it behaves as if it were
+     * newly created. The regular pages used so far are kept and handed out again, in the order
+     * they were first allocated, before any new page is malloc'd. Pages that the next recording
+     * does not reach are freed by the following reset(), so the retained memory tracks the size
+     * of the most recent use. Dedicated pages are always freed.
+     */
+    void reset();
+
     /**
      * Dump memory usage statistics to the log (allocated and wasted space)
      */
@@ -116,6 +125,14 @@ public:
      */
     size_t usedSize() const { return mTotalAllocated - mWastedSpace; }
     size_t allocatedSize() const { return mTotalAllocated; }
+    /**
+     * The number of bytes in allocated pages that are not used by any buffer
+     */
+    size_t wastedSize() const { return mWastedSpace; }
+    /**
+     * The number of bytes of allocatedSize() that came from pages recycled by reset()
+     */
+    size_t recycledSize() const { return mRecycledSize; }
 
 private:
     LinearAllocator(const LinearAllocator& other);
@@ -132,7 +149,9 @@ private:
 
     void addToDestructionList(Destructor, void* addr);
     void runDestructorFor(void* addr);
+    void runDestructors();
     Page* newPage(size_t pageSize);
+    void freePages(Page* page);
     bool fitsInCurrentPage(size_t size);
     void ensureNext(size_t size);
     void* start(Page* p);
@@ -143,6 +162,8 @@ private:
     void* mNext;
     Page* mCurrentPage;
     Page* mPages;
+    Page* mDedicatedPages = nullptr;
+    Page* mRecycledPages = nullptr;
     DestructorNode* mDtorList = nullptr;
 
     // Memory usage tracking
@@ -150,6 +171,8 @@ private:
     size_t mWastedSpace;
     size_t mPageCount;
     size_t mDedicatedPageCount;
+    size_t mRecycledSize = 0;
+    size_t mRecycledPageCount = 0;
 };
 
 template <class T>
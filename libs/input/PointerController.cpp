@@ -82,6 +82,7 @@ PointerController::PointerController(const sp<PointerControllerPolicyInterface>&
     AutoMutex _l(mLock);
 
     mLocked.animationPending = false;
+    mLocked.positionUpdatePending = false;
 
     mLocked.presentation = PRESENTATION_POINTER;
     mLocked.presentationChanged = false;
@@ -197,7 +198,14 @@ void PointerController::setPositionLocked(float x, float y) {
         } else {
             mLocked.pointerY = y;
         }
-        updatePointerLocked();
+        if (mDisplayEventReceiver.initCheck() == NO_ERROR) {
+            // Latch the new position on the next vsync. High-rate mice report several
+            // samples per frame and only the last one needs to reach the sprite.
+            mLocked.positionUpdatePending = true;
+            startAnimationLocked();
+        } else {
+            updatePointerLocked();
+        }
     }
 }
 
@@ -524,6 +532,10 @@ void PointerController::doAnimate(nsecs_t timestamp) {
 
     mLocked.animationPending = false;
 
+    if (mLocked.positionUpdatePending) {
+        updatePointerLocked();
+    }
+
     bool keepFading = doFadingAnimationLocked(timestamp);
     bool keepBitmapFlipping = doBitmapAnimationLocked(timestamp);
     if (keepFading || keepBitmapFlipping) {
@@ -637,6 +649,8 @@ void PointerController::removeInactivityTimeoutLocked() {
 }
 
 void PointerController::updatePointerLocked() REQUIRES(mLock) {
+    mLocked.positionUpdatePending = false;
+
     if (!mLocked.viewport.isValid()) {
         return;
     }
@@ -155,6 +155,9 @@ private:
         bool animationPending;
         nsecs_t animationTime;
 
+        // The pointer moved since the sprite was last updated.
+        bool positionUpdatePending;
+
         size_t animationFrameIndex;
         nsecs_t lastFrameUpdatedTime;
 
@@ -30,6 +30,14 @@
 
 namespace android {
 
+// Pointer movements only ever change sprite positions. Those updates are
+// coalesced so that at most one transaction is sent per interval, which is
+// about a frame at 120Hz.
+static const nsecs_t MIN_POSITION_UPDATE_INTERVAL = ms2ns(8);
+
+// Number of hidden sprite surfaces kept for reuse instead of being destroyed.
+static const size_t MAX_POOLED_SURFACES = 4;
+
 // --- SpriteController ---
 
 SpriteController::SpriteController(const sp<Looper>& looper, int32_t overlayLayer) :
@@ -38,6 +46,8 @@ SpriteController::SpriteController(const sp<Looper>& looper, int32_t overlayLaye
 
     mLocked.transactionNestingCount = 0;
     mLocked.deferredSpriteUpdate = false;
+    mLocked.deferredPositionOnly = true;
+    mLocked.lastUpdateTime = 0;
 }
 
 SpriteController::~SpriteController() {
@@ -68,25 +78,43 @@ void SpriteController::closeTransaction() {
     mLocked.transactionNestingCount -= 1;
     if (mLocked.transactionNestingCount == 0 && mLocked.deferredSpriteUpdate) {
         mLocked.deferredSpriteUpdate = false;
-        mLooper->sendMessage(mHandler, Message(MSG_UPDATE_SPRITES));
+        scheduleUpdateLocked(mLocked.deferredPositionOnly);
+        mLocked.deferredPositionOnly = true;
     }
 }
 
-void SpriteController::invalidateSpriteLocked(const sp<SpriteImpl>& sprite) {
+void SpriteController::invalidateSpriteLocked(const sp<SpriteImpl>& sprite, uint32_t dirty) {
     bool wasEmpty = mLocked.invalidatedSprites.isEmpty();
     mLocked.invalidatedSprites.push(sprite);
     if (wasEmpty) {
         if (mLocked.transactionNestingCount != 0) {
             mLocked.deferredSpriteUpdate = true;
+            mLocked.deferredPositionOnly = dirty == DIRTY_POSITION;
         } else {
-            mLooper->sendMessage(mHandler, Message(MSG_UPDATE_SPRITES));
+            scheduleUpdateLocked(dirty == DIRTY_POSITION);
         }
+    } else if (mLocked.deferredSpriteUpdate && dirty != DIRTY_POSITION) {
+        mLocked.deferredPositionOnly = false;
     }
 }
 
-void SpriteController::disposeSurfaceLocked(const sp<SurfaceControl>& surfaceControl) {
+void SpriteController::scheduleUpdateLocked(bool positionOnly) {
+    nsecs_t delay = 0;
+    if (positionOnly) {
+        delay = mLocked.lastUpdateTime + MIN_POSITION_UPDATE_INTERVAL
+                - systemTime(SYSTEM_TIME_MONOTONIC);
+    }
+    if (delay > 0) {
+        mLooper->sendMessageDelayed(delay, mHandler, Message(MSG_UPDATE_SPRITES));
+    } else {
+        mLooper->sendMessage(mHandler, Message(MSG_UPDATE_SPRITES));
+    }
+}
+
+void SpriteController::disposeSurfaceLocked(const sp<SurfaceControl>& surfaceControl,
+        int32_t width, int32_t height) {
     bool wasEmpty = mLocked.disposedSurfaces.isEmpty();
-    mLocked.disposedSurfaces.push(surfaceControl);
+    mLocked.disposedSurfaces.push(PooledSurface{surfaceControl, width, height});
     if (wasEmpty) {
         mLooper->sendMessage(mHandler, Message(MSG_DISPOSE_SURFACES));
     }
@@ -114,6 +142,7 @@ void SpriteController::doUpdateSprites() {
     { // acquire lock
         AutoMutex _l(mLock);
 
+        mLocked.lastUpdateTime = systemTime(SYSTEM_TIME_MONOTONIC);
         numSprites = mLocked.invalidatedSprites.size();
         for (size_t i = 0; i < numSprites; i++) {
             const sp<SpriteImpl>& sprite = mLocked.invalidatedSprites.itemAt(i);
@@ -135,7 +164,7 @@ void SpriteController::doUpdateSprites() {
             update.state.surfaceDrawn = false;
             update.state.surfaceVisible = false;
             update.state.surfaceControl = obtainSurface(
-                    update.state.surfaceWidth, update.state.surfaceHeight);
+                    &update.state.surfaceWidth, &update.state.surfaceHeight);
             if (update.state.surfaceControl != NULL) {
                 update.surfaceChanged = surfaceChanged = true;
             }
@@ -336,7 +365,7 @@ void SpriteController::doUpdateSprites() {
 
 void SpriteController::doDisposeSurfaces() {
     // Collect disposed surfaces.
-    Vector<sp<SurfaceControl> > disposedSurfaces;
+    Vector<PooledSurface> disposedSurfaces;
     { // acquire lock
         AutoMutex _l(mLock);
 
@@ -344,6 +373,21 @@ void SpriteController::doDisposeSurfaces() {
         mLocked.disposedSurfaces.clear();
     } // release lock
 
+    // Hide and keep a few of the surfaces for the next sprites instead of
+    // destroying and recreating them.
+    SurfaceComposerClient::Transaction t;
+    bool needApplyTransaction = false;
+    while (!disposedSurfaces.isEmpty() && mSurfacePool.size() < MAX_POOLED_SURFACES) {
+        const PooledSurface& surface = disposedSurfaces.top();
+        t.hide(surface.surfaceControl);
+        needApplyTransaction = true;
+        mSurfacePool.push(surface);
+        disposedSurfaces.pop();
+    }
+    if (needApplyTransaction) {
+        t.apply();
+    }
+
     // Release the last reference to each surface outside of the lock.
     // We don't want the surfaces to be deleted while we are holding our lock.
     disposedSurfaces.clear();
@@ -355,11 +399,31 @@ void SpriteController::ensureSurfaceComposerClient() {
     }
 }
 
-sp<SurfaceControl> SpriteController::obtainSurface(int32_t width, int32_t height) {
+sp<SurfaceControl> SpriteController::obtainSurface(int32_t* width, int32_t* height) {
+    // Reuse the smallest pooled surface that fits.
+    ssize_t bestIndex = -1;
+    for (size_t i = 0; i < mSurfacePool.size(); i++) {
+        const PooledSurface& surface = mSurfacePool.itemAt(i);
+        if (surface.width >= *width && surface.height >= *height
+                && (bestIndex < 0 || surface.width * surface.height
+                        < mSurfacePool.itemAt(bestIndex).width
+                                * mSurfacePool.itemAt(bestIndex).height)) {
+            bestIndex = i;
+        }
+    }
+    if (bestIndex >= 0) {
+        const PooledSurface& surface = mSurfacePool.itemAt(bestIndex);
+        sp<SurfaceControl> surfaceControl = surface.surfaceControl;
+        *width = surface.width;
+        *height = surface.height;
+        mSurfacePool.removeAt(bestIndex);
+        return surfaceControl;
+    }
+
     ensureSurfaceComposerClient();
 
     sp<SurfaceControl> surfaceControl = mSurfaceComposerClient->createSurface(
-            String8("Sprite"), width, height, PIXEL_FORMAT_RGBA_8888,
+            String8("Sprite"), *width, *height, PIXEL_FORMAT_RGBA_8888,
             ISurfaceComposerClient::eHidden |
             ISurfaceComposerClient::eCursorWindow);
     if (surfaceControl == NULL || !surfaceControl->isValid()) {
@@ -382,7 +446,8 @@ SpriteController::SpriteImpl::~SpriteImpl() {
     // Let the controller take care of deleting the last reference to sprite
     // surfaces so that we do not block the caller on an IPC here.
     if (mLocked.state.surfaceControl != NULL) {
-        mController->disposeSurfaceLocked(mLocked.state.surfaceControl);
+        mController->disposeSurfaceLocked(mLocked.state.surfaceControl,
+                mLocked.state.surfaceWidth, mLocked.state.surfaceHeight);
         mLocked.state.surfaceControl.clear();
     }
 }
@@ -392,6 +457,13 @@ void SpriteController::SpriteImpl::setIcon(const SpriteIcon& icon) {
 
     uint32_t dirty;
     if (icon.isValid()) {
+        if (mLocked.state.icon.isValid() && icon.bitmap.get() == mLocked.iconSource.get()
+                && mLocked.state.icon.hotSpotX == icon.hotSpotX
+                && mLocked.state.icon.hotSpotY == icon.hotSpotY
+                && mLocked.state.icon.style == icon.style) {
+            return; // same icon as before, the surface already shows it
+        }
+        mLocked.iconSource = icon.bitmap;
         mLocked.state.icon.bitmap = icon.bitmap.copy(ANDROID_BITMAP_FORMAT_RGBA_8888);
         if (!mLocked.state.icon.isValid()
                 || mLocked.state.icon.hotSpotX != icon.hotSpotX
@@ -408,6 +480,7 @@ void SpriteController::SpriteImpl::setIcon(const SpriteIcon& icon) {
             dirty |= DIRTY_ICON_STYLE;
         }
     } else if (mLocked.state.icon.isValid()) {
+        mLocked.iconSource.reset();
         mLocked.state.icon.bitmap.reset();
         dirty = DIRTY_BITMAP | DIRTY_HOTSPOT | DIRTY_ICON_STYLE;
     } else {
@@ -478,7 +551,7 @@ void SpriteController::SpriteImpl::invalidateLocked(uint32_t dirty) {
     mLocked.state.dirty |= dirty;
 
     if (!wasDirty) {
-        mController->invalidateSpriteLocked(this);
+        mController->invalidateSpriteLocked(this, dirty);
     }
 }
 
@@ -251,6 +251,9 @@ private:
 
         struct Locked {
             SpriteState state;
+            // The bitmap last passed to setIcon(), before it was copied. Setting the
+            // same (immutable) bitmap again doesn't need a copy or a redraw.
+            graphics::Bitmap iconSource;
         } mLocked; // guarded by mController->mLock
 
         void invalidateLocked(uint32_t dirty);
@@ -276,22 +279,36 @@ private:
 
     sp<SurfaceComposerClient> mSurfaceComposerClient;
 
+    /* A hidden surface kept around for reuse by the next sprite that needs one. */
+    struct PooledSurface {
+        sp<SurfaceControl> surfaceControl;
+        int32_t width;
+        int32_t height;
+    };
+
     struct Locked {
         Vector<sp<SpriteImpl> > invalidatedSprites;
-        Vector<sp<SurfaceControl> > disposedSurfaces;
+        Vector<PooledSurface> disposedSurfaces;
         uint32_t transactionNestingCount;
         bool deferredSpriteUpdate;
+        bool deferredPositionOnly;
+        nsecs_t lastUpdateTime;
     } mLocked; // guarded by mLock
 
-    void invalidateSpriteLocked(const sp<SpriteImpl>& sprite);
-    void disposeSurfaceLocked(const sp<SurfaceControl>& surfaceControl);
+    // Only accessed on the looper thread.
+    Vector<PooledSurface> mSurfacePool;
+
+    void invalidateSpriteLocked(const sp<SpriteImpl>& sprite, uint32_t dirty);
+    void scheduleUpdateLocked(bool positionOnly);
+    void disposeSurfaceLocked(const sp<SurfaceControl>& surfaceControl,
+            int32_t width, int32_t height);
 
     void handleMessage(const Message& message);
     void doUpdateSprites();
     void doDisposeSurfaces();
 
     void ensureSurfaceComposerClient();
-    sp<SurfaceControl> obtainSurface(int32_t width, int32_t height);
+    sp<SurfaceControl> obtainSurface(int32_t* width, int32_t* height);
 };
 
 } // namespace android
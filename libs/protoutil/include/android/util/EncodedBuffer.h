@@ -72,6 +72,24 @@ public:
      */
     void clear();
 
+    /**
+     * Counters of the process-wide pool the chunks of all EncodedBuffers are taken from.
+     * Chunks of freed buffers are kept in the pool, by chunk size, up to a memory limit.
+     */
+    struct ChunkPoolStats {
+        size_t hits = 0;          // chunks taken from the pool
+        size_t misses = 0;        // chunks that had to be mapped
+        size_t cachedChunks = 0;  // chunks currently held by the pool
+        size_t cachedBytes = 0;
+    };
+
+    static ChunkPoolStats getChunkPoolStats();
+
+    /**
+     * Unmaps all the chunks held by the pool, e.g. once a large report is done.
+     */
+    static void trimChunkPool();
+
     /******************************** Write APIs ************************************************/
 
     /**
@@ -184,6 +202,13 @@ public:
      */
     sp<ProtoReader> read();
 
+    /**
+     * Returns the address of the byte at pos and sets size to the number of bytes that are
+     * contiguous from there, i.e. up to the end of its chunk or of the written data. Returns
+     * NULL if pos is not before the write pointer.
+     */
+    uint8_t const* readBufferAt(size_t pos, size_t* size) const;
+
 private:
     class Reader;
     friend class Reader;
@@ -0,0 +1,101 @@
+/*
+ * Copyright (C) 2020 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+#include <utils/Errors.h>
+
+namespace android {
+namespace util {
+
+/**
+ * A field of a serialized protobuf message. The pointers point into the serialized data,
+ * which must outlive the field.
+ */
+struct ProtoField {
+    uint32_t id;
+    uint8_t wireType;
+
+    /**
+     * The value of WIRE_TYPE_VARINT, WIRE_TYPE_FIXED64 and WIRE_TYPE_FIXED32 fields,
+     * or the length of WIRE_TYPE_LENGTH_DELIMITED fields.
+     */
+    uint64_t value;
+
+    /**
+     * The whole field including its tag, e.g. to copy it to another message as is.
+     */
+    uint8_t const* begin;
+    size_t size;
+
+    /**
+     * The encoded value, without the tag. For WIRE_TYPE_LENGTH_DELIMITED fields this is
+     * the payload without its length, i.e. the serialized nested message of message fields.
+     */
+    uint8_t const* data;
+    size_t dataSize;
+};
+
+/**
+ * Iterates over the fields of a serialized protobuf message held in contiguous memory,
+ * e.g. a mmapped file, without copying or decoding the field payloads. Length delimited
+ * fields, nested messages included, are skipped in O(1) using their length prefix; use
+ * ProtoFieldIterator(field) to walk into one.
+ */
+class ProtoFieldIterator
+{
+public:
+    ProtoFieldIterator(uint8_t const* data, size_t size);
+
+    /**
+     * Iterates over the fields of a nested message.
+     */
+    explicit ProtoFieldIterator(const ProtoField& message);
+
+    /**
+     * Reads the next field. Returns false at the end of the data or if the data is
+     * malformed, which getError() tells apart.
+     */
+    bool next(ProtoField* field);
+
+    /**
+     * Reads up to the next field with the id of fieldId, which may be a field constant of
+     * the generated headers, i.e. with the field type and count bits set. Returns false
+     * if there is none.
+     */
+    bool find(uint64_t fieldId, ProtoField* field);
+
+    /**
+     * NO_ERROR, or BAD_VALUE if a field was truncated or had an unknown wire type.
+     */
+    status_t getError() const;
+
+    size_t bytesRead() const;
+
+private:
+    uint8_t const* mBegin;
+    uint8_t const* mPos;
+    uint8_t const* mEnd;
+    status_t mError;
+
+    bool readVarint(uint64_t* val);
+};
+
+} // util
+} // android
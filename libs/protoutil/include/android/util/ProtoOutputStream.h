@@ -77,6 +77,8 @@ const uint64_t FIELD_COUNT_SINGLE = 1ULL << FIELD_COUNT_SHIFT;
 const uint64_t FIELD_COUNT_REPEATED = 2ULL << FIELD_COUNT_SHIFT;
 const uint64_t FIELD_COUNT_PACKED = 5ULL << FIELD_COUNT_SHIFT;
 
+class ScatterWriter;
+
 /**
  * Class to write to a protobuf stream.
  *
@@ -121,7 +123,9 @@ public:
 
     /**
      * Flushes the protobuf data out to given fd. When the following functions are called,
-     * it is not able to write to ProtoOutputStream any more since the data is compact.
+     * it is not able to write to ProtoOutputStream any more since the nested message sizes
+     * are final. Only data() compacts the buffer, size(), flush() and serializeTo*() compute
+     * the sizes in a first pass and then write the chunks out without moving the data.
      */
     size_t size(); // Get the size of the serialized protobuf.
     sp<ProtoReader> data(); // Get the reader apis of the data.
@@ -138,11 +142,14 @@ public:
     void writeRawVarint(uint64_t varint);
     void writeLengthDelimitedHeader(uint32_t id, size_t size);
     void writeRawByte(uint8_t byte);
+    void writeRaw(const uint8_t* buf, size_t size);
 
 private:
     sp<EncodedBuffer> mBuffer;
     size_t mCopyBegin;
     bool mCompact;
+    bool mSizesComputed;
+    size_t mEncodedSize;
     uint32_t mDepth;
     uint32_t mObjectId;
     uint64_t mExpectedObjectToken;
@@ -164,9 +171,11 @@ private:
     inline void writeUtf8StringImpl(uint32_t id, const char* val, size_t size);
     inline void writeMessageBytesImpl(uint32_t id, const char* val, size_t size);
 
+    bool computeSizes();
     bool compact();
     size_t editEncodedSize(size_t rawSize);
     bool compactSize(size_t rawSize);
+    bool writeEncoded(ScatterWriter* writer);
 
     template<typename T>
     bool internalWrite(uint64_t fieldId, T val, const char* typeName);
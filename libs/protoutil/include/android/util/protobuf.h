@@ -17,6 +17,7 @@
 #ifndef ANDROID_UTIL_PROTOBUF_H
 #define ANDROID_UTIL_PROTOBUF_H
 
+#include <stddef.h>
 #include <stdint.h>
 
 namespace android {
@@ -51,6 +52,18 @@ size_t get_varint_size(uint64_t varint);
  */
 uint8_t* write_raw_varint(uint8_t* buf, uint64_t val);
 
+/**
+ * The longest encoding of a varint, i.e. of a 64 bit value.
+ */
+const size_t MAX_VARINT_SIZE = 10;
+
+/**
+ * Read a varint from the buffer into val. Return the position after it.
+ * There must be MAX_VARINT_SIZE bytes in the buffer, or the varint must end before the
+ * buffer does; malformed varints stop after MAX_VARINT_SIZE bytes.
+ */
+uint8_t const* read_raw_varint(uint8_t const* buf, uint64_t* val);
+
 /**
  * Write a protobuf WIRE_TYPE_LENGTH_DELIMITED header. Return the next position
  * to write at. There must be 20 bytes in the buffer.
@@ -15,9 +15,14 @@
  */
 #define LOG_TAG "libprotoutil"
 
+#include <pthread.h>
 #include <stdlib.h>
 #include <sys/mman.h>
 
+#include <algorithm>
+#include <map>
+#include <mutex>
+
 #include <android/util/EncodedBuffer.h>
 #include <android/util/protobuf.h>
 #include <cutils/log.h>
@@ -26,6 +31,89 @@ namespace android {
 namespace util {
 
 const size_t BUFFER_SIZE = 8 * 1024; // 8 KB
+// Upper bound of the memory the chunk pool holds on to.
+const size_t MAX_POOLED_BYTES = 8 * 1024 * 1024; // 8 MB
+
+namespace {
+
+// Process-wide free lists of chunks, one per chunk size. Chunk sizes are page aligned, so
+// there are only a few of them in practice.
+class ChunkPool {
+public:
+    ChunkPool() {
+        // Chunks may be allocated in a child forked while another thread holds the lock.
+        pthread_atfork([]() { get().mLock.lock(); },
+                       []() { get().mLock.unlock(); },
+                       []() { get().mLock.unlock(); });
+    }
+
+    static ChunkPool& get() {
+        // Never destroyed, buffers may be freed at exit.
+        static ChunkPool* pool = new ChunkPool();
+        return *pool;
+    }
+
+    uint8_t* obtain(size_t chunkSize) {
+        {
+            std::lock_guard<std::mutex> lock(mLock);
+            auto it = mFreeChunks.find(chunkSize);
+            if (it != mFreeChunks.end() && !it->second.empty()) {
+                uint8_t* buf = it->second.back();
+                it->second.pop_back();
+                mStats.hits++;
+                mStats.cachedChunks--;
+                mStats.cachedBytes -= chunkSize;
+                return buf;
+            }
+            mStats.misses++;
+        }
+        // Use mmap instead of malloc to ensure memory alignment i.e. no fragmentation so that
+        // the mem region can be immediately reused by the allocator after calling munmap()
+        void* buf = mmap(NULL, chunkSize, PROT_READ | PROT_WRITE, MAP_ANONYMOUS|MAP_PRIVATE,
+                -1, 0);
+        return buf == MAP_FAILED ? NULL : (uint8_t*)buf;
+    }
+
+    void recycle(uint8_t* buf, size_t chunkSize) {
+        {
+            std::lock_guard<std::mutex> lock(mLock);
+            if (mStats.cachedBytes + chunkSize <= MAX_POOLED_BYTES) {
+                mFreeChunks[chunkSize].push_back(buf);
+                mStats.cachedChunks++;
+                mStats.cachedBytes += chunkSize;
+                return;
+            }
+        }
+        munmap(buf, chunkSize);
+    }
+
+    void trim() {
+        std::map<size_t, std::vector<uint8_t*>> freeChunks;
+        {
+            std::lock_guard<std::mutex> lock(mLock);
+            freeChunks.swap(mFreeChunks);
+            mStats.cachedChunks = 0;
+            mStats.cachedBytes = 0;
+        }
+        for (const auto& sizeClass : freeChunks) {
+            for (uint8_t* buf : sizeClass.second) {
+                munmap(buf, sizeClass.first);
+            }
+        }
+    }
+
+    EncodedBuffer::ChunkPoolStats stats() {
+        std::lock_guard<std::mutex> lock(mLock);
+        return mStats;
+    }
+
+private:
+    std::mutex mLock;
+    std::map<size_t, std::vector<uint8_t*>> mFreeChunks;
+    EncodedBuffer::ChunkPoolStats mStats;
+};
+
+}  // namespace
 
 EncodedBuffer::Pointer::Pointer() : Pointer(BUFFER_SIZE)
 {
@@ -99,12 +187,24 @@ EncodedBuffer::EncodedBuffer(size_t chunkSize)
 
 EncodedBuffer::~EncodedBuffer()
 {
+    ChunkPool& pool = ChunkPool::get();
     for (size_t i=0; i<mBuffers.size(); i++) {
-        uint8_t* buf = mBuffers[i];
-        munmap(buf, mChunkSize);
+        pool.recycle(mBuffers[i], mChunkSize);
     }
 }
 
+EncodedBuffer::ChunkPoolStats
+EncodedBuffer::getChunkPoolStats()
+{
+    return ChunkPool::get().stats();
+}
+
+void
+EncodedBuffer::trimChunkPool()
+{
+    ChunkPool::get().trim();
+}
+
 inline uint8_t*
 EncodedBuffer::at(const Pointer& p) const
 {
@@ -138,10 +238,7 @@ EncodedBuffer::writeBuffer()
     if (mWp.index() > mBuffers.size()) return NULL;
     uint8_t* buf = NULL;
     if (mWp.index() == mBuffers.size()) {
-        // Use mmap instead of malloc to ensure memory alignment i.e. no fragmentation so that
-        // the mem region can be immediately reused by the allocator after calling munmap()
-        buf = (uint8_t*)mmap(NULL, mChunkSize, PROT_READ | PROT_WRITE,
-                MAP_ANONYMOUS|MAP_PRIVATE, -1, 0);
+        buf = ChunkPool::get().obtain(mChunkSize);
 
         if (buf == NULL) return NULL; // This indicates NO_MEMORY
 
@@ -166,6 +263,18 @@ EncodedBuffer::writeRawByte(uint8_t val)
 size_t
 EncodedBuffer::writeRawVarint64(uint64_t val)
 {
+    if (val < 0x80) {
+        writeRawByte((uint8_t)val);
+        return 1;
+    }
+    // Encode in place when the varint can't cross the end of the chunk.
+    uint8_t* buf = writeBuffer();
+    if (buf != NULL && currentToWrite() >= MAX_VARINT_SIZE) {
+        size_t size = write_raw_varint(buf, val) - buf;
+        mWp.move(size);
+        return size;
+    }
+
     size_t size = 0;
     while (true) {
         size++;
@@ -290,7 +399,15 @@ uint64_t
 EncodedBuffer::readRawVarint()
 {
     uint64_t val = 0, shift = 0;
-    size_t start = mEp.pos();
+    uint8_t const* buf = at(mEp);
+    if (*buf < 0x80) {
+        mEp.move();
+        return *buf;
+    }
+    if (mChunkSize - mEp.offset() >= MAX_VARINT_SIZE) {
+        mEp.move(read_raw_varint(buf, &val) - buf);
+        return val;
+    }
     while (true) {
         uint8_t byte = readRawByte();
         val |= (UINT64_C(0x7F) & byte) << shift;
@@ -352,6 +469,19 @@ EncodedBuffer::read()
     return new EncodedBuffer::Reader(this);
 }
 
+uint8_t const*
+EncodedBuffer::readBufferAt(size_t pos, size_t* size) const
+{
+    if (pos >= mWp.pos()) {
+        *size = 0;
+        return NULL;
+    }
+    const size_t index = pos / mChunkSize;
+    const size_t offset = pos % mChunkSize;
+    *size = std::min(mChunkSize - offset, mWp.pos() - pos);
+    return mBuffers[index] + offset;
+}
+
 EncodedBuffer::Reader::Reader(const sp<EncodedBuffer>& buffer)
         :mData(buffer),
          mRp(buffer->mChunkSize)
@@ -405,6 +535,15 @@ uint64_t
 EncodedBuffer::Reader::readRawVarint()
 {
     uint64_t val = 0, shift = 0;
+    uint8_t const* buf = mData->at(mRp);
+    if (*buf < 0x80) {
+        mRp.move();
+        return *buf;
+    }
+    if (currentToRead() >= MAX_VARINT_SIZE) {
+        mRp.move(read_raw_varint(buf, &val) - buf);
+        return val;
+    }
     while (true) {
         uint8_t byte = next();
         val |= (INT64_C(0x7F) & byte) << shift;
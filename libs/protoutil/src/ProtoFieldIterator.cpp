@@ -0,0 +1,156 @@
+/*
+ * Copyright (C) 2020 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#define LOG_TAG "libprotoutil"
+
+#include <cinttypes>
+
+#include <android/util/ProtoFieldIterator.h>
+#include <android/util/protobuf.h>
+#include <cutils/log.h>
+
+namespace android {
+namespace util {
+
+ProtoFieldIterator::ProtoFieldIterator(uint8_t const* data, size_t size)
+        :mBegin(data),
+         mPos(data),
+         mEnd(data + size),
+         mError(NO_ERROR)
+{
+}
+
+ProtoFieldIterator::ProtoFieldIterator(const ProtoField& message)
+        :ProtoFieldIterator(message.data, message.dataSize)
+{
+}
+
+bool
+ProtoFieldIterator::readVarint(uint64_t* val)
+{
+    if ((size_t)(mEnd - mPos) >= MAX_VARINT_SIZE) {
+        mPos = read_raw_varint(mPos, val);
+        return true;
+    }
+    // Near the end, don't let a truncated varint read past the data.
+    uint64_t result = 0;
+    for (size_t shift = 0; mPos < mEnd && shift < 64; shift += 7) {
+        uint8_t byte = *mPos++;
+        result |= (UINT64_C(0x7F) & byte) << shift;
+        if ((byte & 0x80) == 0) {
+            *val = result;
+            return true;
+        }
+    }
+    return false;
+}
+
+bool
+ProtoFieldIterator::next(ProtoField* field)
+{
+    if (mError != NO_ERROR || mPos >= mEnd) {
+        return false;
+    }
+
+    uint8_t const* begin = mPos;
+    uint64_t tag;
+    if (!readVarint(&tag)) {
+        ALOGW("ProtoFieldIterator: truncated tag at %zu", (size_t)(begin - mBegin));
+        mError = BAD_VALUE;
+        return false;
+    }
+    field->id = read_field_id((uint32_t)tag);
+    field->wireType = read_wire_type((uint32_t)tag);
+    field->begin = begin;
+    field->data = NULL;
+    field->dataSize = 0;
+
+    size_t fixedSize = 0;
+    switch (field->wireType) {
+        case WIRE_TYPE_VARINT:
+            field->data = mPos;
+            if (!readVarint(&field->value)) {
+                mError = BAD_VALUE;
+                break;
+            }
+            field->dataSize = mPos - field->data;
+            break;
+        case WIRE_TYPE_FIXED64:
+            fixedSize = 8;
+            break;
+        case WIRE_TYPE_FIXED32:
+            fixedSize = 4;
+            break;
+        case WIRE_TYPE_LENGTH_DELIMITED:
+            if (!readVarint(&field->value) || field->value > (uint64_t)(mEnd - mPos)) {
+                mError = BAD_VALUE;
+                break;
+            }
+            field->data = mPos;
+            field->dataSize = field->value;
+            mPos += field->value;
+            break;
+        default:
+            mError = BAD_VALUE;
+            break;
+    }
+    if (fixedSize > 0) {
+        if ((size_t)(mEnd - mPos) < fixedSize) {
+            mError = BAD_VALUE;
+        } else {
+            field->value = 0;
+            for (size_t i = 0; i < fixedSize; i++) {
+                field->value |= (uint64_t)mPos[i] << (8 * i);
+            }
+            field->data = mPos;
+            field->dataSize = fixedSize;
+            mPos += fixedSize;
+        }
+    }
+    if (mError != NO_ERROR) {
+        ALOGW("ProtoFieldIterator: bad field %" PRIu32 " with wire type %d at %zu", field->id,
+                field->wireType, (size_t)(begin - mBegin));
+        return false;
+    }
+    field->size = mPos - begin;
+    return true;
+}
+
+bool
+ProtoFieldIterator::find(uint64_t fieldId, ProtoField* field)
+{
+    const uint32_t id = (uint32_t)fieldId;
+    while (next(field)) {
+        if (field->id == id) {
+            return true;
+        }
+    }
+    return false;
+}
+
+status_t
+ProtoFieldIterator::getError() const
+{
+    return mError;
+}
+
+size_t
+ProtoFieldIterator::bytesRead() const
+{
+    return mPos - mBegin;
+}
+
+} // util
+} // android
@@ -16,6 +16,7 @@
 #define LOG_TAG "libprotoutil"
 
 #include <android/util/ProtoFileReader.h>
+#include <android/util/protobuf.h>
 #include <cutils/log.h>
 
 #include <cinttypes>
@@ -106,6 +107,11 @@ uint64_t
 ProtoFileReader::readRawVarint()
 {
     uint64_t val = 0, shift = 0;
+    if (ensure_data() && mMaxOffset - mOffset >= MAX_VARINT_SIZE) {
+        uint8_t const* buf = mBuffer + mOffset;
+        mOffset += read_raw_varint(buf, &val) - buf;
+        return val;
+    }
     while (true) {
         if (!hasNext()) {
             ALOGW("readRawVarint() called without hasNext() called first.");
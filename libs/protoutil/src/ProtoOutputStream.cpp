@@ -15,7 +15,12 @@
  */
 #define LOG_TAG "libprotoutil"
 
+#include <limits.h>
+#include <sys/uio.h>
+#include <unistd.h>
+
 #include <cinttypes>
+#include <functional>
 #include <type_traits>
 
 #include <android-base/file.h>
@@ -34,6 +39,8 @@ ProtoOutputStream::ProtoOutputStream(sp<EncodedBuffer> buffer)
         :mBuffer(buffer),
          mCopyBegin(0),
          mCompact(false),
+         mSizesComputed(false),
+         mEncodedSize(0),
          mDepth(0),
          mObjectId(0),
          mExpectedObjectToken(UINT64_C(-1))
@@ -51,6 +58,8 @@ ProtoOutputStream::clear()
     mBuffer->clear();
     mCopyBegin = 0;
     mCompact = false;
+    mSizesComputed = false;
+    mEncodedSize = 0;
     mDepth = 0;
     mObjectId = 0;
     mExpectedObjectToken = UINT64_C(-1);
@@ -60,7 +69,7 @@ template<typename T>
 bool
 ProtoOutputStream::internalWrite(uint64_t fieldId, T val, const char* typeName)
 {
-    if (mCompact) return false;
+    if (mSizesComputed) return false;
     const uint32_t id = (uint32_t)fieldId;
     switch (fieldId & FIELD_TYPE_MASK) {
         case FIELD_TYPE_DOUBLE:   writeDoubleImpl(id, (double)val);           break;
@@ -122,7 +131,7 @@ ProtoOutputStream::write(uint64_t fieldId, int val)
 bool
 ProtoOutputStream::write(uint64_t fieldId, long val)
 {
-    if (mCompact) return false;
+    if (mSizesComputed) return false;
     const uint32_t id = (uint32_t)fieldId;
     switch (fieldId & FIELD_TYPE_MASK) {
         case FIELD_TYPE_DOUBLE:   writeDoubleImpl(id, (double)val);           break;
@@ -156,7 +165,7 @@ ProtoOutputStream::write(uint64_t fieldId, long long val)
 bool
 ProtoOutputStream::write(uint64_t fieldId, bool val)
 {
-    if (mCompact) return false;
+    if (mSizesComputed) return false;
     const uint32_t id = (uint32_t)fieldId;
     switch (fieldId & FIELD_TYPE_MASK) {
         case FIELD_TYPE_BOOL:
@@ -172,7 +181,7 @@ ProtoOutputStream::write(uint64_t fieldId, bool val)
 bool
 ProtoOutputStream::write(uint64_t fieldId, std::string val)
 {
-    if (mCompact) return false;
+    if (mSizesComputed) return false;
     const uint32_t id = (uint32_t)fieldId;
     switch (fieldId & FIELD_TYPE_MASK) {
         case FIELD_TYPE_STRING:
@@ -188,7 +197,7 @@ ProtoOutputStream::write(uint64_t fieldId, std::string val)
 bool
 ProtoOutputStream::write(uint64_t fieldId, const char* val, size_t size)
 {
-    if (mCompact) return false;
+    if (mSizesComputed) return false;
     const uint32_t id = (uint32_t)fieldId;
     switch (fieldId & FIELD_TYPE_MASK) {
         case FIELD_TYPE_STRING:
@@ -313,23 +322,37 @@ ProtoOutputStream::bytesWritten()
 }
 
 bool
-ProtoOutputStream::compact() {
-    if (mCompact) return true;
+ProtoOutputStream::computeSizes()
+{
+    if (mSizesComputed) return true;
     if (mDepth != 0) {
         ALOGE("Can't compact when depth(%" PRIu32 ") is not zero. Missing or extra calls to end.", mDepth);
         return false;
     }
-    // record the size of the original buffer.
     size_t rawBufferSize = mBuffer->size();
     if (rawBufferSize == 0) return true; // nothing to do if the buffer is empty;
 
     // reset edit pointer and recursively compute encoded size of messages.
     mBuffer->ep()->rewind();
-    if (editEncodedSize(rawBufferSize) == 0) {
+    mEncodedSize = editEncodedSize(rawBufferSize);
+    if (mEncodedSize == 0) {
         ALOGE("Failed to editEncodedSize.");
         return false;
     }
 
+    // mark true means it is not legal to write to this ProtoOutputStream anymore
+    mSizesComputed = true;
+    return true;
+}
+
+bool
+ProtoOutputStream::compact() {
+    if (mCompact) return true;
+    if (!computeSizes()) return false;
+    // record the size of the original buffer.
+    size_t rawBufferSize = mBuffer->size();
+    if (rawBufferSize == 0) return true; // nothing to do if the buffer is empty;
+
     // reset both edit pointer and write pointer, and compact recursively.
     mBuffer->ep()->rewind();
     mBuffer->wp()->rewind();
@@ -342,7 +365,6 @@ ProtoOutputStream::compact() {
         mBuffer->copy(mCopyBegin, rawBufferSize - mCopyBegin);
     }
 
-    // mark true means it is not legal to write to this ProtoOutputStream anymore
     mCompact = true;
     return true;
 }
@@ -454,63 +476,241 @@ ProtoOutputStream::compactSize(size_t rawSize)
     return true;
 }
 
+/**
+ * Hands the serialized proto to a sink as iovecs, in batches of at most IOV_MAX. Large
+ * spans point straight into the chunks of the EncodedBuffer. Small ones, like the varint
+ * sizes of nested messages and the few bytes between them, are copied together into a
+ * scratch buffer, so a proto made of many tiny messages doesn't cost an iovec per byte run.
+ */
+class ScatterWriter
+{
+public:
+    typedef std::function<bool(struct iovec* iov, int count)> Sink;
+
+    explicit ScatterWriter(const Sink& sink)
+            :mSink(sink),
+             mScratchOpen(false)
+    {
+        mIov.reserve(IOV_MAX);
+        mScratch.reserve(SCRATCH_SIZE);
+    }
+
+    bool append(const uint8_t* data, size_t size)
+    {
+        if (size == 0) return true;
+        if (size >= MIN_IOVEC_SIZE) {
+            if (mIov.size() == IOV_MAX && !flush()) return false;
+            mIov.push_back({const_cast<uint8_t*>(data), size});
+            mScratchOpen = false;
+            return true;
+        }
+        if (mScratch.size() + size > SCRATCH_SIZE || (!mScratchOpen && mIov.size() == IOV_MAX)) {
+            if (!flush()) return false;
+        }
+        // The scratch never grows past its reserved capacity, so the iovecs stay valid.
+        uint8_t* dst = mScratch.data() + mScratch.size();
+        mScratch.insert(mScratch.end(), data, data + size);
+        if (mScratchOpen) {
+            mIov.back().iov_len += size;
+        } else {
+            mIov.push_back({dst, size});
+            mScratchOpen = true;
+        }
+        return true;
+    }
+
+    /**
+     * Appends the bytes [pos, pos + size) of the buffer, one span per chunk they cover.
+     */
+    bool append(const sp<EncodedBuffer>& buffer, size_t pos, size_t size)
+    {
+        while (size > 0) {
+            size_t available;
+            const uint8_t* data = buffer->readBufferAt(pos, &available);
+            if (data == NULL) return false;
+            available = std::min(available, size);
+            if (!append(data, available)) return false;
+            pos += available;
+            size -= available;
+        }
+        return true;
+    }
+
+    bool appendVarint32(uint32_t val)
+    {
+        uint8_t buf[5];
+        size_t size = 0;
+        while ((val & ~0x7F) != 0) {
+            buf[size++] = (uint8_t)((val & 0x7F) | 0x80);
+            val >>= 7;
+        }
+        buf[size++] = (uint8_t)val;
+        return append(buf, size);
+    }
+
+    bool flush()
+    {
+        bool ok = mIov.empty() || mSink(mIov.data(), (int)mIov.size());
+        mIov.clear();
+        mScratch.clear();
+        mScratchOpen = false;
+        return ok;
+    }
+
+private:
+    static const size_t MIN_IOVEC_SIZE = 64;
+    static const size_t SCRATCH_SIZE = 16 * 1024;
+
+    Sink mSink;
+    std::vector<struct iovec> mIov;
+    std::vector<uint8_t> mScratch;
+    bool mScratchOpen; // whether the last iovec is the tail of the scratch
+};
+
+/**
+ * Walks the raw buffer like compactSize, but instead of moving the data forward it hands
+ * the spans between the size placeholders and the encoded sizes to the writer.
+ */
+static bool
+scatterSize(const sp<EncodedBuffer>& buffer, size_t rawSize, size_t* copyBegin,
+        ScatterWriter* writer)
+{
+    size_t objectStart = buffer->ep()->pos();
+    size_t objectEnd = objectStart + rawSize;
+    int childRawSize, childEncodedSize;
+
+    while (buffer->ep()->pos() < objectEnd) {
+        uint32_t tag = (uint32_t)buffer->readRawVarint();
+        switch (read_wire_type(tag)) {
+            case WIRE_TYPE_VARINT:
+                while ((buffer->readRawByte() & 0x80) != 0) {}
+                break;
+            case WIRE_TYPE_FIXED64:
+                buffer->ep()->move(8);
+                break;
+            case WIRE_TYPE_LENGTH_DELIMITED:
+                if (!writer->append(buffer, *copyBegin, buffer->ep()->pos() - *copyBegin)) {
+                    return false;
+                }
+
+                childRawSize = (int)buffer->readRawFixed32();
+                childEncodedSize = (int)buffer->readRawFixed32();
+                *copyBegin = buffer->ep()->pos();
+
+                if (!writer->appendVarint32(childEncodedSize)) return false;
+                if (childRawSize >= 0 && childRawSize == childEncodedSize) {
+                    buffer->ep()->move(childEncodedSize);
+                } else if (childRawSize < 0) {
+                    if (!scatterSize(buffer, -childRawSize, copyBegin, writer)) return false;
+                } else {
+                    ALOGE("Bad raw or encoded values: raw=%d, encoded=%d",
+                            childRawSize, childEncodedSize);
+                    return false;
+                }
+                break;
+            case WIRE_TYPE_FIXED32:
+                buffer->ep()->move(4);
+                break;
+            default:
+                ALOGE("Unexpected wire type %d in scatterSize at [%zu, %zu]",
+                        read_wire_type(tag), objectStart, objectEnd);
+                return false;
+        }
+    }
+    return true;
+}
+
+bool
+ProtoOutputStream::writeEncoded(ScatterWriter* writer)
+{
+    if (!computeSizes()) return false;
+
+    size_t rawBufferSize = mBuffer->size();
+    if (mCompact || rawBufferSize == 0) {
+        return writer->append(mBuffer, 0, rawBufferSize) && writer->flush();
+    }
+
+    size_t copyBegin = 0;
+    mBuffer->ep()->rewind();
+    if (!scatterSize(mBuffer, rawBufferSize, &copyBegin, writer)) {
+        ALOGE("Failed to scatterSize.");
+        return false;
+    }
+    return writer->append(mBuffer, copyBegin, rawBufferSize - copyBegin) && writer->flush();
+}
+
 size_t
 ProtoOutputStream::size()
 {
-    if (!compact()) {
+    if (!computeSizes()) {
         ALOGE("compact failed, the ProtoOutputStream data is corrupted!");
         return 0;
     }
-    return mBuffer->size();
+    return mEncodedSize;
+}
+
+static bool
+writevFully(int fd, struct iovec* iov, int count)
+{
+    while (count > 0) {
+        ssize_t n = TEMP_FAILURE_RETRY(writev(fd, iov, count));
+        if (n < 0) return false;
+        // Skip what was written, the last iovec may be written partially.
+        while (count > 0 && (size_t)n >= iov->iov_len) {
+            n -= iov->iov_len;
+            iov++;
+            count--;
+        }
+        if (count > 0) {
+            iov->iov_base = (uint8_t*)iov->iov_base + n;
+            iov->iov_len -= n;
+        }
+    }
+    return true;
 }
 
 bool
 ProtoOutputStream::flush(int fd)
 {
     if (fd < 0) return false;
-    if (!compact()) return false;
 
-    sp<ProtoReader> reader = mBuffer->read();
-    while (reader->readBuffer() != NULL) {
-        if (!android::base::WriteFully(fd, reader->readBuffer(), reader->currentToRead())) {
-            return false;
-        }
-        reader->move(reader->currentToRead());
-    }
-    return true;
+    ScatterWriter writer([fd](struct iovec* iov, int count) {
+        return writevFully(fd, iov, count);
+    });
+    return writeEncoded(&writer);
 }
 
 bool
 ProtoOutputStream::serializeToString(std::string* out)
 {
     if (out == nullptr) return false;
-    if (!compact()) return false;
-
-    sp<ProtoReader> reader = mBuffer->read();
-    out->reserve(reader->size());
-    while (reader->hasNext()) {
-        out->append(static_cast<const char*>(static_cast<const void*>(reader->readBuffer())),
-                    reader->currentToRead());
-        reader->move(reader->currentToRead());
-    }
-    return true;
+    if (!computeSizes()) return false;
+
+    out->reserve(out->size() + mEncodedSize);
+    ScatterWriter writer([out](struct iovec* iov, int count) {
+        for (int i = 0; i < count; i++) {
+            out->append(static_cast<const char*>(iov[i].iov_base), iov[i].iov_len);
+        }
+        return true;
+    });
+    return writeEncoded(&writer);
 }
 
 bool
 ProtoOutputStream::serializeToVector(std::vector<uint8_t>* out)
 {
     if (out == nullptr) return false;
-    if (!compact()) return false;
-
-    sp<ProtoReader> reader = mBuffer->read();
-    out->reserve(reader->size());
-    while (reader->hasNext()) {
-        const uint8_t* buf = reader->readBuffer();
-        size_t size = reader->currentToRead();
-        out->insert(out->end(), buf, buf + size);
-        reader->move(size);
-    }
-    return true;
+    if (!computeSizes()) return false;
+
+    out->reserve(out->size() + mEncodedSize);
+    ScatterWriter writer([out](struct iovec* iov, int count) {
+        for (int i = 0; i < count; i++) {
+            const uint8_t* buf = static_cast<const uint8_t*>(iov[i].iov_base);
+            out->insert(out->end(), buf, buf + iov[i].iov_len);
+        }
+        return true;
+    });
+    return writeEncoded(&writer);
 }
 
 sp<ProtoReader>
@@ -544,6 +744,12 @@ ProtoOutputStream::writeRawByte(uint8_t byte)
     mBuffer->writeRawByte(byte);
 }
 
+void
+ProtoOutputStream::writeRaw(const uint8_t* buf, size_t size)
+{
+    mBuffer->writeRaw(buf, size);
+}
+
 
 // =========================================================================
 // Private functions
@@ -34,27 +34,42 @@ read_field_id(uint32_t varint)
 size_t
 get_varint_size(uint64_t varint)
 {
-    size_t size = 1;
-    while ((varint & ~0x7F)) {
-        size++;
-        varint >>= 7;
-    }
-    return size;
+    // One byte per started group of 7 significant bits, zero still takes a byte.
+    return (64 - __builtin_clzll(varint | 1) + 6) / 7;
 }
 
 uint8_t*
 write_raw_varint(uint8_t* buf, uint64_t val)
 {
     uint8_t* p = buf;
-    while (true) {
-        if ((val & ~0x7F) == 0) {
-            *p++ = (uint8_t)val;
-            return p;
-        } else {
-            *p++ = (uint8_t)((val & 0x7F) | 0x80);
-            val >>= 7;
+    while (val >= 0x80) {
+        *p++ = (uint8_t)(val | 0x80);
+        val >>= 7;
+    }
+    *p++ = (uint8_t)val;
+    return p;
+}
+
+uint8_t const*
+read_raw_varint(uint8_t const* buf, uint64_t* val)
+{
+    // Most varints are tags and small values, take the single byte case first.
+    uint64_t byte = buf[0];
+    if (byte < 0x80) {
+        *val = byte;
+        return buf + 1;
+    }
+    uint64_t result = byte & 0x7F;
+    for (size_t i = 1; i < MAX_VARINT_SIZE; i++) {
+        byte = buf[i];
+        result |= (byte & 0x7F) << (7 * i);
+        if (byte < 0x80) {
+            *val = result;
+            return buf + i + 1;
         }
     }
+    *val = result;
+    return buf + MAX_VARINT_SIZE;
 }
 
 uint8_t*
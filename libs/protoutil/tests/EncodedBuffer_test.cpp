@@ -150,3 +150,63 @@ TEST(EncodedBufferTest, ReadVarint) {
     EXPECT_EQ(reader->size(), len);
     EXPECT_EQ(reader->readRawVarint(), val);
 }
+
+TEST(EncodedBufferTest, ChunksAreReusedFromPool) {
+    EncodedBuffer::trimChunkPool();
+    const size_t chunkSize = 64 * 1024;  // Page aligned.
+    {
+        sp<EncodedBuffer> buffer = new EncodedBuffer(chunkSize);
+        for (size_t i = 0; i < 2 * chunkSize; i++) {
+            buffer->writeRawByte(i);
+        }
+    }
+    EncodedBuffer::ChunkPoolStats before = EncodedBuffer::getChunkPoolStats();
+    EXPECT_EQ(before.cachedBytes, 2 * chunkSize);
+
+    sp<EncodedBuffer> buffer = new EncodedBuffer(chunkSize);
+    for (size_t i = 0; i < 2 * chunkSize; i++) {
+        buffer->writeRawByte(i + 1);
+    }
+    EncodedBuffer::ChunkPoolStats after = EncodedBuffer::getChunkPoolStats();
+    EXPECT_EQ(after.hits, before.hits + 2);
+    EXPECT_EQ(after.misses, before.misses);
+    EXPECT_EQ(after.cachedBytes, 0UL);
+
+    // Reused chunks hold the new data.
+    for (size_t i = 0; i < 2 * chunkSize; i++) {
+        EXPECT_EQ(buffer->readRawByte(), (uint8_t)(i + 1));
+    }
+
+    buffer = nullptr;
+    EncodedBuffer::trimChunkPool();
+    EXPECT_EQ(EncodedBuffer::getChunkPoolStats().cachedChunks, 0UL);
+}
+
+TEST(EncodedBufferTest, VarintsAcrossChunks) {
+    const size_t chunkSize = 4096;  // Page aligned.
+    sp<EncodedBuffer> buffer = new EncodedBuffer(chunkSize);
+    // Varints of every length, so that some of them cross the chunk boundaries and take
+    // the byte by byte paths.
+    std::vector<uint64_t> values;
+    for (size_t i = 0; values.size() < 3 * chunkSize / 5; i++) {
+        values.push_back((UINT64_C(1) << (7 * (i % 10))) + i);
+    }
+    values.push_back(UINT64_C(-1));
+
+    size_t size = 0;
+    for (uint64_t value : values) {
+        size += buffer->writeRawVarint64(value);
+    }
+    EXPECT_EQ(buffer->size(), size);
+
+    for (uint64_t value : values) {
+        EXPECT_EQ(buffer->readRawVarint(), value);
+    }
+    EXPECT_EQ(buffer->ep()->pos(), size);
+
+    sp<ProtoReader> reader = buffer->read();
+    for (uint64_t value : values) {
+        EXPECT_EQ(reader->readRawVarint(), value);
+    }
+    EXPECT_FALSE(reader->hasNext());
+}
@@ -0,0 +1,114 @@
+// Copyright (C) 2020 The Android Open Source Project
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <android/util/protobuf.h>
+#include <android/util/ProtoFieldIterator.h>
+#include <android/util/ProtoOutputStream.h>
+#include <gtest/gtest.h>
+
+#include "frameworks/base/libs/protoutil/tests/test.pb.h"
+
+using namespace android::util;
+
+static std::string serializeComplex() {
+    ComplexProto complex;
+    complex.add_ints(23);
+    complex.add_ints(-72);
+    ComplexProto::Log* log = complex.add_logs();
+    log->set_id(12);
+    log->set_name("cat");
+    log = complex.add_logs();
+    log->set_id(98);
+    log->set_data("food");
+    std::string data;
+    complex.SerializeToString(&data);
+    return data;
+}
+
+TEST(ProtoFieldIteratorTest, Fields) {
+    const std::string data = serializeComplex();
+    const uint8_t* buf = reinterpret_cast<const uint8_t*>(data.data());
+    ProtoFieldIterator it(buf, data.size());
+    ProtoField field;
+
+    ASSERT_TRUE(it.next(&field));
+    EXPECT_EQ(field.id, (uint32_t)ComplexProto::kIntsFieldNumber);
+    EXPECT_EQ(field.wireType, WIRE_TYPE_VARINT);
+    EXPECT_EQ(field.value, 23UL);
+    EXPECT_EQ(field.begin, buf);
+    EXPECT_EQ(field.size, 2UL);
+
+    ASSERT_TRUE(it.next(&field));
+    EXPECT_EQ((int32_t)field.value, -72);
+    EXPECT_EQ(field.size, 11UL);  // negative int32s take 10 bytes
+
+    ASSERT_TRUE(it.next(&field));
+    EXPECT_EQ(field.id, (uint32_t)ComplexProto::kLogsFieldNumber);
+    EXPECT_EQ(field.wireType, WIRE_TYPE_LENGTH_DELIMITED);
+    EXPECT_EQ(field.dataSize, field.value);
+    EXPECT_EQ(field.data + field.dataSize, field.begin + field.size);
+    ComplexProto::Log log;
+    ASSERT_TRUE(log.ParseFromArray(field.data, field.dataSize));
+    EXPECT_EQ(log.id(), 12);
+
+    // Walk into the message.
+    ProtoFieldIterator logIt(field);
+    ASSERT_TRUE(logIt.find(FIELD_TYPE_STRING | ComplexProto::Log::kNameFieldNumber, &field));
+    EXPECT_EQ(std::string(reinterpret_cast<const char*>(field.data), field.dataSize), "cat");
+    EXPECT_FALSE(logIt.next(&field));
+    EXPECT_EQ(logIt.getError(), android::NO_ERROR);
+
+    ASSERT_TRUE(it.next(&field));
+    EXPECT_EQ(field.id, (uint32_t)ComplexProto::kLogsFieldNumber);
+    EXPECT_FALSE(it.next(&field));
+    EXPECT_EQ(it.getError(), android::NO_ERROR);
+    EXPECT_EQ(it.bytesRead(), data.size());
+}
+
+TEST(ProtoFieldIteratorTest, FixedFields) {
+    PrimitiveProto primitives;
+    primitives.set_val_fixed32(0x12345678);
+    primitives.set_val_sfixed64(-2);
+    primitives.set_val_double(3.5);
+    std::string data;
+    primitives.SerializeToString(&data);
+
+    ProtoFieldIterator it(reinterpret_cast<const uint8_t*>(data.data()), data.size());
+    ProtoField field;
+    ASSERT_TRUE(it.find(FIELD_TYPE_DOUBLE | PrimitiveProto::kValDoubleFieldNumber, &field));
+    EXPECT_EQ(field.wireType, WIRE_TYPE_FIXED64);
+    double d;
+    memcpy(&d, &field.value, sizeof(d));
+    EXPECT_EQ(d, 3.5);
+    ASSERT_TRUE(it.find(FIELD_TYPE_FIXED32 | PrimitiveProto::kValFixed32FieldNumber, &field));
+    EXPECT_EQ(field.wireType, WIRE_TYPE_FIXED32);
+    EXPECT_EQ(field.value, 0x12345678UL);
+    ASSERT_TRUE(it.find(FIELD_TYPE_SFIXED64 | PrimitiveProto::kValSfixed64FieldNumber, &field));
+    EXPECT_EQ((int64_t)field.value, -2);
+    EXPECT_FALSE(it.find(FIELD_TYPE_INT32 | PrimitiveProto::kValInt32FieldNumber, &field));
+    EXPECT_EQ(it.getError(), android::NO_ERROR);
+}
+
+TEST(ProtoFieldIteratorTest, Truncated) {
+    const std::string data = serializeComplex();
+    ProtoFieldIterator it(reinterpret_cast<const uint8_t*>(data.data()), data.size() - 1);
+    ProtoField field;
+    int count = 0;
+    while (it.next(&field)) {
+        count++;
+    }
+    // The last log is cut, it must not be returned.
+    EXPECT_EQ(count, 3);
+    EXPECT_EQ(it.getError(), android::BAD_VALUE);
+}
@@ -356,3 +356,40 @@ TEST(ProtoOutputStreamTest, NoStartCalled) {
     EXPECT_EQ(proto.size(), 0);
     EXPECT_FALSE(proto.flush(STDOUT_FILENO));
 }
+
+TEST(ProtoOutputStreamTest, FlushWithoutCompaction) {
+    // Enough messages for several writev batches, with data spanning the buffer chunks.
+    const int logCount = 3000;
+    const std::string bigData(20 * 1024, 'x');
+
+    ProtoOutputStream proto;
+    for (int i = 0; i < logCount; i++) {
+        uint64_t token = proto.start(FIELD_TYPE_MESSAGE | ComplexProto::kLogsFieldNumber);
+        EXPECT_TRUE(proto.write(FIELD_TYPE_INT32 | ComplexProto::Log::kIdFieldNumber, i));
+        if (i % 500 == 0) {
+            EXPECT_TRUE(proto.write(FIELD_TYPE_BYTES | ComplexProto::Log::kDataFieldNumber,
+                                    bigData.c_str(), bigData.size()));
+        }
+        proto.end(token);
+    }
+
+    std::string flushed = flushToString(&proto);
+    EXPECT_EQ(flushed.size(), proto.size());
+    // Writing is not allowed once the sizes are final.
+    EXPECT_FALSE(proto.write(FIELD_TYPE_INT32 | ComplexProto::kIntsFieldNumber, 1));
+
+    std::string serialized;
+    ASSERT_TRUE(proto.serializeToString(&serialized));
+    EXPECT_EQ(serialized, flushed);
+    // data() compacts the buffer, which must give the same bytes.
+    EXPECT_EQ(iterateToString(&proto), flushed);
+    EXPECT_EQ(flushToString(&proto), flushed);
+
+    ComplexProto complex;
+    ASSERT_TRUE(complex.ParseFromString(flushed));
+    ASSERT_EQ(complex.logs_size(), logCount);
+    for (int i = 0; i < logCount; i++) {
+        EXPECT_EQ(complex.logs(i).id(), i);
+        EXPECT_EQ(complex.logs(i).data().size(), i % 500 == 0 ? bigData.size() : 0UL);
+    }
+}
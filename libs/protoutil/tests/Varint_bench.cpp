@@ -0,0 +1,89 @@
+// Copyright (C) 2020 The Android Open Source Project
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+#include <android/util/EncodedBuffer.h>
+#include <android/util/protobuf.h>
+#include <benchmark/benchmark.h>
+
+#include <vector>
+
+using namespace android::util;
+using android::sp;
+
+// Number of varints written or read per iteration.
+constexpr size_t VARINT_COUNT = 4096;
+
+// Varints of state.range(0) bytes, e.g. 1 for tags and 10 for negative int64s.
+static std::vector<uint64_t> makeValues(size_t varintSize) {
+    const uint64_t value = varintSize >= MAX_VARINT_SIZE
+            ? UINT64_C(-1) : (UINT64_C(1) << (7 * varintSize)) - 1;
+    return std::vector<uint64_t>(VARINT_COUNT, value);
+}
+
+static void BM_WriteRawVarint(benchmark::State& state) {
+    const std::vector<uint64_t> values = makeValues(state.range(0));
+    sp<EncodedBuffer> buffer = new EncodedBuffer();
+    while (state.KeepRunning()) {
+        buffer->clear();
+        for (uint64_t value : values) {
+            buffer->writeRawVarint64(value);
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * VARINT_COUNT);
+}
+BENCHMARK(BM_WriteRawVarint)->Arg(1)->Arg(2)->Arg(5)->Arg(10);
+
+static void BM_EncodedBufferReadRawVarint(benchmark::State& state) {
+    const std::vector<uint64_t> values = makeValues(state.range(0));
+    sp<EncodedBuffer> buffer = new EncodedBuffer();
+    for (uint64_t value : values) {
+        buffer->writeRawVarint64(value);
+    }
+    while (state.KeepRunning()) {
+        buffer->ep()->rewind();
+        for (size_t i = 0; i < VARINT_COUNT; i++) {
+            benchmark::DoNotOptimize(buffer->readRawVarint());
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * VARINT_COUNT);
+}
+BENCHMARK(BM_EncodedBufferReadRawVarint)->Arg(1)->Arg(2)->Arg(5)->Arg(10);
+
+static void BM_ProtoReaderReadRawVarint(benchmark::State& state) {
+    const std::vector<uint64_t> values = makeValues(state.range(0));
+    sp<EncodedBuffer> buffer = new EncodedBuffer();
+    for (uint64_t value : values) {
+        buffer->writeRawVarint64(value);
+    }
+    while (state.KeepRunning()) {
+        sp<ProtoReader> reader = buffer->read();
+        while (reader->hasNext()) {
+            benchmark::DoNotOptimize(reader->readRawVarint());
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * VARINT_COUNT);
+}
+BENCHMARK(BM_ProtoReaderReadRawVarint)->Arg(1)->Arg(2)->Arg(5)->Arg(10);
+
+static void BM_GetVarintSize(benchmark::State& state) {
+    const std::vector<uint64_t> values = makeValues(state.range(0));
+    while (state.KeepRunning()) {
+        for (uint64_t value : values) {
+            benchmark::DoNotOptimize(get_varint_size(value));
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * VARINT_COUNT);
+}
+BENCHMARK(BM_GetVarintSize)->Arg(1)->Arg(10);
+
+BENCHMARK_MAIN();
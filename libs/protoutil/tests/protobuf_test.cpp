@@ -48,4 +48,18 @@ TEST(ProtobufTest, All) {
     EXPECT_EQ(header[1], 0x96);
     EXPECT_EQ(header[2], 0x01);
     EXPECT_EQ(header[3], UNSET_BYTE);
-}
\ No newline at end of file
+}
+
+TEST(ProtobufTest, ReadRawVarint) {
+    const uint64_t values[] = { 0, 1, 127, 128, 150, 16383, 16384, UINT64_C(0xFFFFFFFF),
+                                UINT64_C(1) << 62, UINT64_C(-2), UINT64_C(-1) };
+    for (uint64_t value : values) {
+        uint8_t buf[MAX_VARINT_SIZE];
+        uint8_t* end = write_raw_varint(buf, value);
+        EXPECT_EQ((size_t)(end - buf), get_varint_size(value));
+
+        uint64_t read = 0;
+        EXPECT_EQ(read_raw_varint(buf, &read), end);
+        EXPECT_EQ(read, value);
+    }
+}
@@ -37,6 +37,7 @@
 
 #include <jni.h>
 #include <nativehelper/JNIHelp.h>
+#include <nativehelper/ScopedLocalRef.h>
 
 #include <stdint.h>
 #include <inttypes.h>
@@ -728,7 +729,6 @@ static jobjectArray Image_createSurfacePlanes(JNIEnv* env, jobject thiz,
     int pixelStride = 0;
     uint8_t *pData = NULL;
     uint32_t dataSize = 0;
-    jobject byteBuffer = NULL;
 
     PublicFormat publicReaderFormat = static_cast<PublicFormat>(readerFormat);
     int halReaderFormat = mapPublicFormatToHalFormat(publicReaderFormat);
@@ -764,17 +764,24 @@ static jobjectArray Image_createSurfacePlanes(JNIEnv* env, jobject thiz,
                 &pData, &dataSize, &pixelStride, &rowStride)) {
             return NULL;
         }
-        byteBuffer = env->NewDirectByteBuffer(pData, dataSize);
-        if ((byteBuffer == NULL) && (env->ExceptionCheck() == false)) {
-            jniThrowException(env, "java/lang/IllegalStateException",
-                    "Failed to allocate ByteBuffer");
+        // The planes wrap the locked buffer directly; no pixel data is copied.
+        ScopedLocalRef<jobject> byteBuffer(env, env->NewDirectByteBuffer(pData, dataSize));
+        if (byteBuffer.get() == NULL) {
+            if (env->ExceptionCheck() == false) {
+                jniThrowException(env, "java/lang/IllegalStateException",
+                        "Failed to allocate ByteBuffer");
+            }
             return NULL;
         }
 
         // Finally, create this SurfacePlane.
-        jobject surfacePlane = env->NewObject(gSurfacePlaneClassInfo.clazz,
-                    gSurfacePlaneClassInfo.ctor, thiz, rowStride, pixelStride, byteBuffer);
-        env->SetObjectArrayElement(surfacePlanes, i, surfacePlane);
+        ScopedLocalRef<jobject> surfacePlane(env, env->NewObject(gSurfacePlaneClassInfo.clazz,
+                    gSurfacePlaneClassInfo.ctor, thiz, rowStride, pixelStride,
+                    byteBuffer.get()));
+        if (surfacePlane.get() == NULL) {
+            return NULL;
+        }
+        env->SetObjectArrayElement(surfacePlanes, i, surfacePlane.get());
     }
 
     return surfacePlanes;
@@ -19,6 +19,7 @@
 #include <utils/Log.h>
 
 #include <type_traits>
+#include <vector>
 
 #include "android_media_MediaCodec.h"
 
@@ -143,6 +144,12 @@ static struct {
     jmethodID addId;
 } gArrayListInfo;
 
+static struct {
+    jclass clazz;
+    jmethodID ctorId;
+    jmethodID setId;
+} gBufferInfo;
+
 static struct {
     jclass clazz;
     jmethodID ctorId;
@@ -418,22 +425,23 @@ status_t JMediaCodec::dequeueOutputBuffer(
     size_t size, offset;
     int64_t timeUs;
     uint32_t flags;
-    status_t err = mCodec->dequeueOutputBuffer(
-            index, &offset, &size, &timeUs, &flags, timeoutUs);
+    status_t err = dequeueOutputBuffer(index, &offset, &size, &timeUs, &flags, timeoutUs);
 
     if (err != OK) {
         return err;
     }
 
-    ScopedLocalRef<jclass> clazz(
-            env, env->FindClass("android/media/MediaCodec$BufferInfo"));
-
-    jmethodID method = env->GetMethodID(clazz.get(), "set", "(IIJI)V");
-    env->CallVoidMethod(bufferInfo, method, (jint)offset, (jint)size, timeUs, flags);
+    env->CallVoidMethod(bufferInfo, gBufferInfo.setId, (jint)offset, (jint)size, timeUs, flags);
 
     return OK;
 }
 
+status_t JMediaCodec::dequeueOutputBuffer(
+        size_t *index, size_t *offset, size_t *size, int64_t *timeUs, uint32_t *flags,
+        int64_t timeoutUs) {
+    return mCodec->dequeueOutputBuffer(index, offset, size, timeUs, flags, timeoutUs);
+}
+
 status_t JMediaCodec::releaseOutputBuffer(
         size_t index, bool render, bool updatePTS, int64_t timestampNs) {
     if (updatePTS) {
@@ -987,12 +995,7 @@ void JMediaCodec::handleCallback(const sp<AMessage> &msg) {
             CHECK(msg->findInt64("timeUs", &timeUs));
             CHECK(msg->findInt32("flags", (int32_t *)&flags));
 
-            ScopedLocalRef<jclass> clazz(
-                    env, env->FindClass("android/media/MediaCodec$BufferInfo"));
-            jmethodID ctor = env->GetMethodID(clazz.get(), "<init>", "()V");
-            jmethodID method = env->GetMethodID(clazz.get(), "set", "(IIJI)V");
-
-            obj = env->NewObject(clazz.get(), ctor);
+            obj = env->NewObject(gBufferInfo.clazz, gBufferInfo.ctorId);
 
             if (obj == NULL) {
                 if (env->ExceptionCheck()) {
@@ -1003,7 +1006,8 @@ void JMediaCodec::handleCallback(const sp<AMessage> &msg) {
                 return;
             }
 
-            env->CallVoidMethod(obj, method, (jint)offset, (jint)size, timeUs, flags);
+            env->CallVoidMethod(
+                    obj, gBufferInfo.setId, (jint)offset, (jint)size, timeUs, flags);
             break;
         }
 
@@ -1593,6 +1597,61 @@ static void android_media_MediaCodec_queueInputBuffer(
             env, err, ACTION_CODE_FATAL, errorDetailMsg.empty() ? NULL : errorDetailMsg.c_str());
 }
 
+// Queues several input buffers, e.g. audio access units, in one JNI call.
+// All arrays must have the same length. Queueing stops at the first error.
+static void android_media_MediaCodec_native_queueInputBuffers(
+        JNIEnv *env,
+        jobject thiz,
+        jintArray indices,
+        jintArray offsets,
+        jintArray sizes,
+        jlongArray timestampsUs,
+        jintArray flags) {
+    ALOGV("android_media_MediaCodec_native_queueInputBuffers");
+
+    sp<JMediaCodec> codec = getMediaCodec(env, thiz);
+
+    if (codec == NULL || codec->initCheck() != OK) {
+        throwExceptionAsNecessary(env, INVALID_OPERATION);
+        return;
+    }
+
+    if (indices == NULL || offsets == NULL || sizes == NULL
+            || timestampsUs == NULL || flags == NULL) {
+        throwExceptionAsNecessary(env, BAD_VALUE);
+        return;
+    }
+    const jsize count = env->GetArrayLength(indices);
+    if (env->GetArrayLength(offsets) != count || env->GetArrayLength(sizes) != count
+            || env->GetArrayLength(timestampsUs) != count
+            || env->GetArrayLength(flags) != count) {
+        throwExceptionAsNecessary(env, BAD_VALUE);
+        return;
+    }
+
+    std::vector<jint> indexValues(count), offsetValues(count), sizeValues(count);
+    std::vector<jlong> timestampValues(count);
+    std::vector<jint> flagValues(count);
+    env->GetIntArrayRegion(indices, 0, count, indexValues.data());
+    env->GetIntArrayRegion(offsets, 0, count, offsetValues.data());
+    env->GetIntArrayRegion(sizes, 0, count, sizeValues.data());
+    env->GetLongArrayRegion(timestampsUs, 0, count, timestampValues.data());
+    env->GetIntArrayRegion(flags, 0, count, flagValues.data());
+
+    for (jsize i = 0; i < count; ++i) {
+        AString errorDetailMsg;
+        status_t err = codec->queueInputBuffer(
+                indexValues[i], offsetValues[i], sizeValues[i], timestampValues[i],
+                flagValues[i], &errorDetailMsg);
+        if (err != OK) {
+            throwExceptionAsNecessary(
+                    env, err, ACTION_CODE_FATAL,
+                    errorDetailMsg.empty() ? NULL : errorDetailMsg.c_str());
+            return;
+        }
+    }
+}
+
 struct NativeCryptoInfo {
     NativeCryptoInfo(JNIEnv *env, jobject cryptoInfoObj)
         : mEnv{env},
@@ -2320,6 +2379,83 @@ static jint android_media_MediaCodec_dequeueOutputBuffer(
     return throwExceptionAsNecessary(env, err);
 }
 
+// Drains up to indices.length output buffers in one JNI call. Only the first
+// dequeue waits for timeoutUs. Returns the number of entries filled in, or,
+// if there are none, the same negative INFO code as dequeueOutputBuffer().
+// A format or buffers change after some buffers is reported as a last entry
+// whose index is the negative INFO code, since the codec reports it only once.
+static jint android_media_MediaCodec_native_dequeueOutputBuffers(
+        JNIEnv *env, jobject thiz, jintArray indices, jintArray offsets, jintArray sizes,
+        jlongArray timestampsUs, jintArray flags, jlong timeoutUs) {
+    ALOGV("android_media_MediaCodec_native_dequeueOutputBuffers");
+
+    sp<JMediaCodec> codec = getMediaCodec(env, thiz);
+
+    if (codec == NULL || codec->initCheck() != OK) {
+        throwExceptionAsNecessary(env, INVALID_OPERATION);
+        return 0;
+    }
+
+    if (indices == NULL || offsets == NULL || sizes == NULL
+            || timestampsUs == NULL || flags == NULL) {
+        throwExceptionAsNecessary(env, BAD_VALUE);
+        return 0;
+    }
+    const jsize capacity = env->GetArrayLength(indices);
+    if (capacity == 0 || env->GetArrayLength(offsets) < capacity
+            || env->GetArrayLength(sizes) < capacity
+            || env->GetArrayLength(timestampsUs) < capacity
+            || env->GetArrayLength(flags) < capacity) {
+        throwExceptionAsNecessary(env, BAD_VALUE);
+        return 0;
+    }
+
+    std::vector<jint> indexValues(capacity), offsetValues(capacity), sizeValues(capacity);
+    std::vector<jlong> timestampValues(capacity);
+    std::vector<jint> flagValues(capacity);
+    jsize count = 0;
+    status_t err = OK;
+    for (; count < capacity; ++count) {
+        size_t index, offset, size;
+        int64_t timeUs;
+        uint32_t bufferFlags;
+        err = codec->dequeueOutputBuffer(
+                &index, &offset, &size, &timeUs, &bufferFlags, count == 0 ? timeoutUs : 0);
+        if (err != OK) {
+            if (count > 0 && (err == INFO_FORMAT_CHANGED || err == INFO_OUTPUT_BUFFERS_CHANGED)) {
+                indexValues[count] = throwExceptionAsNecessary(env, err);
+                offsetValues[count] = 0;
+                sizeValues[count] = 0;
+                timestampValues[count] = 0;
+                flagValues[count] = 0;
+                ++count;
+            }
+            break;
+        }
+        indexValues[count] = (jint)index;
+        offsetValues[count] = (jint)offset;
+        sizeValues[count] = (jint)size;
+        timestampValues[count] = timeUs;
+        flagValues[count] = (jint)bufferFlags;
+        if (bufferFlags & MediaCodec::BUFFER_FLAG_EOS) {
+            ++count;
+            break;
+        }
+    }
+
+    if (count > 0) {
+        // Errors are sticky in MediaCodec and are reported by the next call.
+        env->SetIntArrayRegion(indices, 0, count, indexValues.data());
+        env->SetIntArrayRegion(offsets, 0, count, offsetValues.data());
+        env->SetIntArrayRegion(sizes, 0, count, sizeValues.data());
+        env->SetLongArrayRegion(timestampsUs, 0, count, timestampValues.data());
+        env->SetIntArrayRegion(flags, 0, count, flagValues.data());
+        return count;
+    }
+
+    return throwExceptionAsNecessary(env, err);
+}
+
 static void android_media_MediaCodec_releaseOutputBuffer(
         JNIEnv *env, jobject thiz,
         jint index, jboolean render, jboolean updatePTS, jlong timestampNs) {
@@ -2871,6 +3007,17 @@ static void android_media_MediaCodec_native_init(JNIEnv *env, jclass) {
     gArrayListInfo.addId = env->GetMethodID(clazz.get(), "add", "(Ljava/lang/Object;)Z");
     CHECK(gArrayListInfo.addId != NULL);
 
+    clazz.reset(env->FindClass("android/media/MediaCodec$BufferInfo"));
+    CHECK(clazz.get() != NULL);
+
+    gBufferInfo.clazz = (jclass)env->NewGlobalRef(clazz.get());
+
+    gBufferInfo.ctorId = env->GetMethodID(clazz.get(), "<init>", "()V");
+    CHECK(gBufferInfo.ctorId != NULL);
+
+    gBufferInfo.setId = env->GetMethodID(clazz.get(), "set", "(IIJI)V");
+    CHECK(gBufferInfo.setId != NULL);
+
     clazz.reset(env->FindClass("android/media/MediaCodec$LinearBlock"));
     CHECK(clazz.get() != NULL);
 
@@ -3150,6 +3297,9 @@ static const JNINativeMethod gMethods[] = {
     { "native_queueInputBuffer", "(IIIJI)V",
       (void *)android_media_MediaCodec_queueInputBuffer },
 
+    { "native_queueInputBuffers", "([I[I[I[J[I)V",
+      (void *)android_media_MediaCodec_native_queueInputBuffers },
+
     { "native_queueSecureInputBuffer", "(IILandroid/media/MediaCodec$CryptoInfo;JI)V",
       (void *)android_media_MediaCodec_queueSecureInputBuffer },
 
@@ -3178,6 +3328,9 @@ static const JNINativeMethod gMethods[] = {
     { "native_dequeueOutputBuffer", "(Landroid/media/MediaCodec$BufferInfo;J)I",
       (void *)android_media_MediaCodec_dequeueOutputBuffer },
 
+    { "native_dequeueOutputBuffers", "([I[I[I[J[IJ)I",
+      (void *)android_media_MediaCodec_native_dequeueOutputBuffers },
+
     { "releaseOutputBuffer", "(IZZJ)V",
       (void *)android_media_MediaCodec_releaseOutputBuffer },
 
@@ -72,6 +72,11 @@ JMediaExtractor::JMediaExtractor(JNIEnv *env, jobject thiz)
 }
 
 JMediaExtractor::~JMediaExtractor() {
+    {
+        Mutex::Autolock autoLock(mReadAheadLock);
+        stopReadAhead_l();
+    }
+
     JNIEnv *env = AndroidRuntime::getJNIEnv();
 
     env->DeleteWeakGlobalRef(mObject);
@@ -148,69 +153,244 @@ status_t JMediaExtractor::getFileFormat(jobject *format) const {
 }
 
 status_t JMediaExtractor::selectTrack(size_t index) {
-    return mImpl->selectTrack(index);
+    Mutex::Autolock autoLock(mReadAheadLock);
+    stopReadAhead_l();
+    mSamples.clear();
+    status_t err = mImpl->selectTrack(index);
+    startReadAhead_l();
+    return err;
 }
 
 status_t JMediaExtractor::unselectTrack(size_t index) {
-    return mImpl->unselectTrack(index);
+    Mutex::Autolock autoLock(mReadAheadLock);
+    stopReadAhead_l();
+    mSamples.clear();
+    status_t err = mImpl->unselectTrack(index);
+    startReadAhead_l();
+    return err;
 }
 
 status_t JMediaExtractor::seekTo(
         int64_t timeUs, MediaSource::ReadOptions::SeekMode mode) {
-    return mImpl->seekTo(timeUs, mode);
+    Mutex::Autolock autoLock(mReadAheadLock);
+    stopReadAhead_l();
+    mSamples.clear();
+    status_t err = mImpl->seekTo(timeUs, mode);
+    startReadAhead_l();
+    return err;
 }
 
 status_t JMediaExtractor::advance() {
-    return mImpl->advance();
+    Mutex::Autolock autoLock(mReadAheadLock);
+    if (!readingAhead_l()) {
+        return mImpl->advance();
+    }
+    status_t err = waitForSample_l();
+    if (err != OK) {
+        return err;
+    }
+    if (mFreeBuffers.size() < mReadAheadSamples) {
+        mFreeBuffers.push_back(mSamples.front().data);
+    }
+    mSamples.pop_front();
+    mReadAheadCondition.broadcast();
+    return OK;
 }
 
-status_t JMediaExtractor::readSampleData(
-        jobject byteBuf, size_t offset, size_t *sampleSize) {
-    JNIEnv *env = AndroidRuntime::getJNIEnv();
+status_t JMediaExtractor::setReadAhead(size_t maxSamples) {
+    Mutex::Autolock autoLock(mReadAheadLock);
+    stopReadAhead_l();
+    // Samples already prefetched stay queued; mImpl has moved past them.
+    mReadAheadSamples = maxSamples;
+    if (mFreeBuffers.size() > maxSamples) {
+        mFreeBuffers.resize(maxSamples);
+    }
+    startReadAhead_l();
+    return OK;
+}
 
-    void *dst = env->GetDirectBufferAddress(byteBuf);
+bool JMediaExtractor::readingAhead_l() const {
+    return mReadAheadThread.joinable() || !mSamples.empty();
+}
 
-    size_t dstSize;
-    jbyteArray byteArray = NULL;
+void JMediaExtractor::startReadAhead_l() {
+    if (mReadAheadSamples > 0 && !mReadAheadThread.joinable()) {
+        mReadAheadStatus = OK;
+        mReadAheadThread = std::thread([this] { readAheadLoop(); });
+    }
+}
 
-    ScopedLocalRef<jclass> byteBufClass(env, env->FindClass("java/nio/ByteBuffer"));
-    CHECK(byteBufClass.get() != NULL);
+void JMediaExtractor::stopReadAhead_l() {
+    if (!mReadAheadThread.joinable()) {
+        return;
+    }
+    mReadAheadStop = true;
+    mReadAheadCondition.broadcast();
+    mReadAheadLock.unlock();
+    mReadAheadThread.join();
+    mReadAheadLock.lock();
+    mReadAheadStop = false;
+    mReadAheadStatus = OK;
+}
+
+status_t JMediaExtractor::waitForSample_l() {
+    while (mSamples.empty() && mReadAheadStatus == OK) {
+        mReadAheadCondition.wait(mReadAheadLock);
+    }
+    return mSamples.empty() ? mReadAheadStatus : OK;
+}
 
-    if (dst == NULL) {
-        jmethodID arrayID =
-            env->GetMethodID(byteBufClass.get(), "array", "()[B");
-        CHECK(arrayID != NULL);
+void JMediaExtractor::readAheadLoop() {
+    Mutex::Autolock autoLock(mReadAheadLock);
+    while (!mReadAheadStop) {
+        if (mSamples.size() >= mReadAheadSamples) {
+            mReadAheadCondition.wait(mReadAheadLock);
+            continue;
+        }
+        sp<ABuffer> buffer;
+        if (!mFreeBuffers.empty()) {
+            buffer = mFreeBuffers.back();
+            mFreeBuffers.pop_back();
+        }
+
+        // Only this thread moves mImpl while reading ahead, so read without the lock.
+        mReadAheadLock.unlock();
+        Sample sample;
+        size_t sampleSize;
+        status_t err = mImpl->getSampleTrackIndex(&sample.trackIndex);
+        if (err == OK) {
+            err = mImpl->getSampleTime(&sample.timeUs);
+        }
+        if (err == OK) {
+            err = mImpl->getSampleMeta(&sample.meta);
+        }
+        if (err == OK) {
+            err = mImpl->getSampleSize(&sampleSize);
+        }
+        if (err == OK) {
+            if (buffer == NULL || buffer->capacity() < sampleSize) {
+                buffer = new ABuffer(sampleSize);
+            }
+            buffer->setRange(0, buffer->capacity());
+            err = mImpl->readSampleData(buffer);
+        }
+        if (err == OK) {
+            sample.data = buffer;
+            err = mImpl->advance();
+        }
+        mReadAheadLock.lock();
 
-        byteArray =
-            (jbyteArray)env->CallObjectMethod(byteBuf, arrayID);
+        if (sample.data != NULL) {
+            mSamples.push_back(std::move(sample));
+        }
+        if (err != OK) {
+            mReadAheadStatus = err;
+        }
+        mReadAheadCondition.broadcast();
+        if (err != OK) {
+            break;
+        }
+    }
+}
 
-        if (byteArray == NULL) {
+status_t JMediaExtractor::readSample(const sp<ABuffer> &buffer) {
+    Mutex::Autolock autoLock(mReadAheadLock);
+    if (!readingAhead_l()) {
+        return mImpl->readSampleData(buffer);
+    }
+    status_t err = waitForSample_l();
+    if (err != OK) {
+        return err;
+    }
+    const sp<ABuffer> &data = mSamples.front().data;
+    if (buffer->capacity() < data->size()) {
+        return -ENOMEM;
+    }
+    memcpy(buffer->base(), data->data(), data->size());
+    buffer->setRange(0, data->size());
+    return OK;
+}
+
+// Resolves the storage behind a direct or array-backed ByteBuffer.
+// Must be paired with releaseByteBufferStorage().
+static status_t getByteBufferStorage(
+        JNIEnv *env, jobject byteBuf, void **dst, size_t *dstSize, jbyteArray *byteArray) {
+    static jmethodID arrayID = [env] {
+        ScopedLocalRef<jclass> byteBufClass(env, env->FindClass("java/nio/ByteBuffer"));
+        CHECK(byteBufClass.get() != NULL);
+        jmethodID id = env->GetMethodID(byteBufClass.get(), "array", "()[B");
+        CHECK(id != NULL);
+        return id;
+    }();
+
+    *byteArray = NULL;
+    *dst = env->GetDirectBufferAddress(byteBuf);
+
+    if (*dst == NULL) {
+        *byteArray = (jbyteArray)env->CallObjectMethod(byteBuf, arrayID);
+
+        if (*byteArray == NULL) {
             return INVALID_OPERATION;
         }
 
         jboolean isCopy;
-        dst = env->GetByteArrayElements(byteArray, &isCopy);
+        *dst = env->GetByteArrayElements(*byteArray, &isCopy);
 
-        dstSize = (size_t) env->GetArrayLength(byteArray);
+        *dstSize = (size_t) env->GetArrayLength(*byteArray);
     } else {
-        dstSize = (size_t) env->GetDirectBufferCapacity(byteBuf);
+        *dstSize = (size_t) env->GetDirectBufferCapacity(byteBuf);
+    }
+    return OK;
+}
+
+static void releaseByteBufferStorage(JNIEnv *env, jbyteArray byteArray, void *dst) {
+    if (byteArray != NULL) {
+        env->ReleaseByteArrayElements(byteArray, (jbyte *)dst, 0);
+        env->DeleteLocalRef(byteArray);
     }
+}
 
-    if (dstSize < offset) {
-        if (byteArray != NULL) {
-            env->ReleaseByteArrayElements(byteArray, (jbyte *)dst, 0);
-        }
+static void setByteBufferRange(JNIEnv *env, jobject byteBuf, size_t offset, size_t size) {
+    static const std::pair<jmethodID, jmethodID> ids = [env] {
+        ScopedLocalRef<jclass> byteBufClass(env, env->FindClass("java/nio/ByteBuffer"));
+        CHECK(byteBufClass.get() != NULL);
+        jmethodID positionID = env->GetMethodID(
+                byteBufClass.get(), "position", "(I)Ljava/nio/Buffer;");
+        CHECK(positionID != NULL);
+        jmethodID limitID = env->GetMethodID(
+                byteBufClass.get(), "limit", "(I)Ljava/nio/Buffer;");
+        CHECK(limitID != NULL);
+        return std::make_pair(positionID, limitID);
+    }();
+
+    jobject me = env->CallObjectMethod(byteBuf, ids.second, offset + size);
+    env->DeleteLocalRef(me);
+    me = env->CallObjectMethod(byteBuf, ids.first, offset);
+    env->DeleteLocalRef(me);
+}
+
+status_t JMediaExtractor::readSampleData(
+        jobject byteBuf, size_t offset, size_t *sampleSize) {
+    JNIEnv *env = AndroidRuntime::getJNIEnv();
+
+    void *dst;
+    size_t dstSize;
+    jbyteArray byteArray;
+    status_t err = getByteBufferStorage(env, byteBuf, &dst, &dstSize, &byteArray);
+    if (err != OK) {
+        return err;
+    }
 
+    if (dstSize < offset) {
+        releaseByteBufferStorage(env, byteArray, dst);
         return -ERANGE;
     }
 
     sp<ABuffer> buffer = new ABuffer((char *)dst + offset, dstSize - offset);
 
-    status_t err = mImpl->readSampleData(buffer);
+    err = readSample(buffer);
 
-    if (byteArray != NULL) {
-        env->ReleaseByteArrayElements(byteArray, (jbyte *)dst, 0);
-    }
+    releaseByteBufferStorage(env, byteArray, dst);
 
     if (err != OK) {
         return err;
@@ -218,44 +398,112 @@ status_t JMediaExtractor::readSampleData(
 
     *sampleSize = buffer->size();
 
-    jmethodID positionID = env->GetMethodID(
-            byteBufClass.get(), "position", "(I)Ljava/nio/Buffer;");
+    setByteBufferRange(env, byteBuf, offset, *sampleSize);
 
-    CHECK(positionID != NULL);
+    return OK;
+}
 
-    jmethodID limitID = env->GetMethodID(
-            byteBufClass.get(), "limit", "(I)Ljava/nio/Buffer;");
+status_t JMediaExtractor::readSampleDataBatch(
+        jobject byteBuf, size_t offset, size_t maxSamples, std::vector<SampleInfo> *samples) {
+    JNIEnv *env = AndroidRuntime::getJNIEnv();
+    samples->clear();
 
-    CHECK(limitID != NULL);
+    void *dst;
+    size_t dstSize;
+    jbyteArray byteArray;
+    status_t err = getByteBufferStorage(env, byteBuf, &dst, &dstSize, &byteArray);
+    if (err != OK) {
+        return err;
+    }
 
-    jobject me = env->CallObjectMethod(
-            byteBuf, limitID, offset + *sampleSize);
-    env->DeleteLocalRef(me);
-    me = env->CallObjectMethod(
-            byteBuf, positionID, offset);
-    env->DeleteLocalRef(me);
-    me = NULL;
+    if (dstSize < offset) {
+        releaseByteBufferStorage(env, byteArray, dst);
+        return -ERANGE;
+    }
+
+    size_t used = 0;
+    while (samples->size() < maxSamples) {
+        SampleInfo info;
+        err = getSampleTrackIndex(&info.trackIndex);
+        if (err == OK) {
+            err = getSampleTime(&info.timeUs);
+        }
+        if (err == OK) {
+            err = getSampleFlags(&info.flags);
+        }
+        if (err == OK) {
+            err = getSampleSize(&info.size);
+        }
+        if (err == OK && !samples->empty() && info.size > dstSize - offset - used) {
+            break;  // the next sample is left for the next call.
+        }
+        if (err == OK) {
+            sp<ABuffer> buffer =
+                new ABuffer((char *)dst + offset + used, dstSize - offset - used);
+            err = readSample(buffer);
+        }
+        if (err != OK) {
+            break;
+        }
+        used += info.size;
+        samples->push_back(info);
+        if ((err = advance()) != OK) {
+            break;
+        }
+    }
+
+    releaseByteBufferStorage(env, byteArray, dst);
+
+    if (samples->empty()) {
+        return err;
+    }
+
+    setByteBufferRange(env, byteBuf, offset, used);
 
     return OK;
 }
 
 status_t JMediaExtractor::getSampleTrackIndex(size_t *trackIndex) {
-    return mImpl->getSampleTrackIndex(trackIndex);
+    Mutex::Autolock autoLock(mReadAheadLock);
+    if (!readingAhead_l()) {
+        return mImpl->getSampleTrackIndex(trackIndex);
+    }
+    status_t err = waitForSample_l();
+    if (err == OK) {
+        *trackIndex = mSamples.front().trackIndex;
+    }
+    return err;
 }
 
 status_t JMediaExtractor::getSampleTime(int64_t *sampleTimeUs) {
-    return mImpl->getSampleTime(sampleTimeUs);
+    Mutex::Autolock autoLock(mReadAheadLock);
+    if (!readingAhead_l()) {
+        return mImpl->getSampleTime(sampleTimeUs);
+    }
+    status_t err = waitForSample_l();
+    if (err == OK) {
+        *sampleTimeUs = mSamples.front().timeUs;
+    }
+    return err;
 }
 
 status_t JMediaExtractor::getSampleSize(size_t *sampleSize) {
-    return mImpl->getSampleSize(sampleSize);
+    Mutex::Autolock autoLock(mReadAheadLock);
+    if (!readingAhead_l()) {
+        return mImpl->getSampleSize(sampleSize);
+    }
+    status_t err = waitForSample_l();
+    if (err == OK) {
+        *sampleSize = mSamples.front().data->size();
+    }
+    return err;
 }
 
 status_t JMediaExtractor::getSampleFlags(uint32_t *sampleFlags) {
     *sampleFlags = 0;
 
     sp<MetaData> meta;
-    status_t err = mImpl->getSampleMeta(&meta);
+    status_t err = getSampleMeta(&meta);
 
     if (err != OK) {
         return err;
@@ -284,7 +532,15 @@ status_t JMediaExtractor::getMetrics(Parcel *reply) const {
 
 
 status_t JMediaExtractor::getSampleMeta(sp<MetaData> *sampleMeta) {
-    return mImpl->getSampleMeta(sampleMeta);
+    Mutex::Autolock autoLock(mReadAheadLock);
+    if (!readingAhead_l()) {
+        return mImpl->getSampleMeta(sampleMeta);
+    }
+    status_t err = waitForSample_l();
+    if (err == OK) {
+        *sampleMeta = mSamples.front().meta;
+    }
+    return err;
 }
 
 bool JMediaExtractor::getCachedDuration(int64_t *durationUs, bool *eos) const {
@@ -472,6 +728,71 @@ static jint android_media_MediaExtractor_readSampleData(
     return (jint) sampleSize;
 }
 
+// Reads up to sizes.length consecutive samples back to back into byteBuf.
+// Returns the number of samples read, or -1 at the end of stream.
+static jint android_media_MediaExtractor_native_readSampleDataBatch(
+        JNIEnv *env, jobject thiz, jobject byteBuf, jint offset, jintArray sizes,
+        jlongArray timesUs, jintArray flags, jintArray trackIndices) {
+    sp<JMediaExtractor> extractor = getMediaExtractor(env, thiz);
+
+    if (extractor == NULL) {
+        jniThrowException(env, "java/lang/IllegalStateException", NULL);
+        return -1;
+    }
+
+    if (sizes == NULL || timesUs == NULL || flags == NULL || trackIndices == NULL) {
+        jniThrowException(env, "java/lang/IllegalArgumentException", NULL);
+        return -1;
+    }
+    const jsize maxSamples = env->GetArrayLength(sizes);
+    if (env->GetArrayLength(timesUs) < maxSamples
+            || env->GetArrayLength(flags) < maxSamples
+            || env->GetArrayLength(trackIndices) < maxSamples) {
+        jniThrowException(env, "java/lang/IllegalArgumentException", NULL);
+        return -1;
+    }
+
+    std::vector<JMediaExtractor::SampleInfo> samples;
+    status_t err = extractor->readSampleDataBatch(byteBuf, offset, maxSamples, &samples);
+
+    if (err == ERROR_END_OF_STREAM) {
+        return -1;
+    } else if (err != OK) {
+        jniThrowException(env, "java/lang/IllegalArgumentException", NULL);
+        return -1;
+    }
+
+    for (size_t i = 0; i < samples.size(); ++i) {
+        const jint size = (jint) samples[i].size;
+        const jlong timeUs = samples[i].timeUs;
+        const jint sampleFlags = (jint) samples[i].flags;
+        const jint trackIndex = (jint) samples[i].trackIndex;
+        env->SetIntArrayRegion(sizes, i, 1, &size);
+        env->SetLongArrayRegion(timesUs, i, 1, &timeUs);
+        env->SetIntArrayRegion(flags, i, 1, &sampleFlags);
+        env->SetIntArrayRegion(trackIndices, i, 1, &trackIndex);
+    }
+
+    return (jint) samples.size();
+}
+
+static void android_media_MediaExtractor_native_setReadAhead(
+        JNIEnv *env, jobject thiz, jint maxSamples) {
+    sp<JMediaExtractor> extractor = getMediaExtractor(env, thiz);
+
+    if (extractor == NULL) {
+        jniThrowException(env, "java/lang/IllegalStateException", NULL);
+        return;
+    }
+
+    if (maxSamples < 0) {
+        jniThrowException(env, "java/lang/IllegalArgumentException", NULL);
+        return;
+    }
+
+    extractor->setReadAhead(maxSamples);
+}
+
 static jint android_media_MediaExtractor_getSampleTrackIndex(
         JNIEnv *env, jobject thiz) {
     sp<JMediaExtractor> extractor = getMediaExtractor(env, thiz);
@@ -944,6 +1265,12 @@ static const JNINativeMethod gMethods[] = {
     { "readSampleData", "(Ljava/nio/ByteBuffer;I)I",
         (void *)android_media_MediaExtractor_readSampleData },
 
+    { "native_readSampleDataBatch", "(Ljava/nio/ByteBuffer;I[I[J[I[I)I",
+        (void *)android_media_MediaExtractor_native_readSampleDataBatch },
+
+    { "native_setReadAhead", "(I)V",
+        (void *)android_media_MediaExtractor_native_setReadAhead },
+
     { "getSampleTrackIndex", "()I",
         (void *)android_media_MediaExtractor_getSampleTrackIndex },
 
@@ -21,15 +21,22 @@
 #include <media/stagefright/foundation/AudioPresentationInfo.h>
 #include <media/stagefright/MediaSource.h>
 #include <media/DataSource.h>
+#include <utils/Condition.h>
 #include <utils/Errors.h>
 #include <utils/KeyedVector.h>
+#include <utils/Mutex.h>
 #include <utils/RefBase.h>
 #include <utils/String8.h>
 
+#include <deque>
+#include <thread>
+#include <vector>
+
 #include "jni.h"
 
 namespace android {
 
+struct ABuffer;
 struct IMediaHTTPService;
 class MetaData;
 struct NuMediaExtractor;
@@ -59,6 +66,22 @@ struct JMediaExtractor : public RefBase {
 
     status_t advance();
     status_t readSampleData(jobject byteBuf, size_t offset, size_t *sampleSize);
+
+    struct SampleInfo {
+        size_t trackIndex;
+        int64_t timeUs;
+        uint32_t flags;
+        size_t size;
+    };
+    // Reads consecutive samples back to back into byteBuf from offset, advancing
+    // past each one, until maxSamples are read, the next sample does not fit, or
+    // the end of stream is reached.
+    status_t readSampleDataBatch(
+            jobject byteBuf, size_t offset, size_t maxSamples, std::vector<SampleInfo> *samples);
+
+    // Prefetches up to maxSamples samples of the selected tracks on a background
+    // thread. 0 disables read-ahead and reads on the calling thread.
+    status_t setReadAhead(size_t maxSamples);
     status_t getSampleTrackIndex(size_t *trackIndex);
     status_t getSampleTime(int64_t *sampleTimeUs);
     status_t getSampleSize(size_t *sampleSize);
@@ -74,10 +97,36 @@ protected:
     virtual ~JMediaExtractor();
 
 private:
+    struct Sample {
+        size_t trackIndex;
+        int64_t timeUs;
+        sp<MetaData> meta;
+        sp<ABuffer> data;
+    };
+
+    status_t readSample(const sp<ABuffer> &buffer);
+    bool readingAhead_l() const;
+    void startReadAhead_l();
+    void stopReadAhead_l();
+    void readAheadLoop();
+    // Waits for the next prefetched sample; returns its status if there is none.
+    status_t waitForSample_l();
+
     jclass mClass;
     jweak mObject;
     sp<NuMediaExtractor> mImpl;
 
+    // Read-ahead state. While the read-ahead thread runs it alone advances mImpl,
+    // and the sample accessors are served from mSamples.
+    Mutex mReadAheadLock;
+    Condition mReadAheadCondition;
+    size_t mReadAheadSamples = 0;
+    bool mReadAheadStop = false;
+    std::thread mReadAheadThread;
+    std::deque<Sample> mSamples;               // prefetched, in extraction order
+    status_t mReadAheadStatus = OK;            // status after the last prefetched sample
+    std::vector<sp<ABuffer>> mFreeBuffers;     // recycled sample buffers
+
     DISALLOW_EVIL_CONSTRUCTORS(JMediaExtractor);
 };
 
@@ -374,13 +374,13 @@ uint64_t MediaEvent::getAudioHandle() {
 /////////////// FilterCallback ///////////////////////
 
 jobjectArray FilterCallback::getSectionEvent(
-        jobjectArray& arr, const std::vector<DemuxFilterEvent::Event>& events) {
+        jobjectArray& arr, const hidl_vec<DemuxFilterEvent::Event>& events) {
     JNIEnv *env = AndroidRuntime::getJNIEnv();
     jclass eventClazz = env->FindClass("android/media/tv/tuner/filter/SectionEvent");
     jmethodID eventInit = env->GetMethodID(eventClazz, "<init>", "(IIII)V");
 
     for (int i = 0; i < events.size(); i++) {
-        auto event = events[i];
+        const auto& event = events[i];
         DemuxFilterSectionEvent sectionEvent = event.section();
 
         jint tableId = static_cast<jint>(sectionEvent.tableId);
@@ -391,12 +391,13 @@ jobjectArray FilterCallback::getSectionEvent(
         jobject obj =
                 env->NewObject(eventClazz, eventInit, tableId, version, sectionNum, dataLength);
         env->SetObjectArrayElement(arr, i, obj);
+        env->DeleteLocalRef(obj);
     }
     return arr;
 }
 
 jobjectArray FilterCallback::getMediaEvent(
-        jobjectArray& arr, const std::vector<DemuxFilterEvent::Event>& events) {
+        jobjectArray& arr, const hidl_vec<DemuxFilterEvent::Event>& events) {
     JNIEnv *env = AndroidRuntime::getJNIEnv();
     jclass eventClazz = env->FindClass("android/media/tv/tuner/filter/MediaEvent");
     jmethodID eventInit = env->GetMethodID(eventClazz,
@@ -406,8 +407,8 @@ jobjectArray FilterCallback::getMediaEvent(
     jfieldID eventContext = env->GetFieldID(eventClazz, "mNativeContext", "J");
 
     for (int i = 0; i < events.size(); i++) {
-        auto event = events[i];
-        DemuxFilterMediaEvent mediaEvent = event.media();
+        const auto& event = events[i];
+        const DemuxFilterMediaEvent& mediaEvent = event.media();
 
         jobject audioDescriptor = NULL;
         if (mediaEvent.extraMetaData.getDiscriminator()
@@ -426,6 +427,7 @@ jobjectArray FilterCallback::getMediaEvent(
             audioDescriptor =
                     env->NewObject(adClazz, adInit, adFade, adPan, versionTextTag, adGainCenter,
                             adGainFront, adGainSurround);
+            env->DeleteLocalRef(adClazz);
         }
 
         jlong dataLength = static_cast<jlong>(mediaEvent.dataLength);
@@ -454,18 +456,22 @@ jobjectArray FilterCallback::getMediaEvent(
         }
 
         env->SetObjectArrayElement(arr, i, obj);
+        env->DeleteLocalRef(obj);
+        if (audioDescriptor != NULL) {
+            env->DeleteLocalRef(audioDescriptor);
+        }
     }
     return arr;
 }
 
 jobjectArray FilterCallback::getPesEvent(
-        jobjectArray& arr, const std::vector<DemuxFilterEvent::Event>& events) {
+        jobjectArray& arr, const hidl_vec<DemuxFilterEvent::Event>& events) {
     JNIEnv *env = AndroidRuntime::getJNIEnv();
     jclass eventClazz = env->FindClass("android/media/tv/tuner/filter/PesEvent");
     jmethodID eventInit = env->GetMethodID(eventClazz, "<init>", "(III)V");
 
     for (int i = 0; i < events.size(); i++) {
-        auto event = events[i];
+        const auto& event = events[i];
         DemuxFilterPesEvent pesEvent = event.pes();
 
         jint streamId = static_cast<jint>(pesEvent.streamId);
@@ -475,18 +481,19 @@ jobjectArray FilterCallback::getPesEvent(
         jobject obj =
                 env->NewObject(eventClazz, eventInit, streamId, dataLength, mpuSequenceNumber);
         env->SetObjectArrayElement(arr, i, obj);
+        env->DeleteLocalRef(obj);
     }
     return arr;
 }
 
 jobjectArray FilterCallback::getTsRecordEvent(
-        jobjectArray& arr, const std::vector<DemuxFilterEvent::Event>& events) {
+        jobjectArray& arr, const hidl_vec<DemuxFilterEvent::Event>& events) {
     JNIEnv *env = AndroidRuntime::getJNIEnv();
     jclass eventClazz = env->FindClass("android/media/tv/tuner/filter/TsRecordEvent");
     jmethodID eventInit = env->GetMethodID(eventClazz, "<init>", "(IIIJ)V");
 
     for (int i = 0; i < events.size(); i++) {
-        auto event = events[i];
+        const auto& event = events[i];
         DemuxFilterTsRecordEvent tsRecordEvent = event.tsRecord();
         DemuxPid pid = tsRecordEvent.pid;
 
@@ -515,18 +522,19 @@ jobjectArray FilterCallback::getTsRecordEvent(
         jobject obj =
                 env->NewObject(eventClazz, eventInit, jpid, ts, sc, byteNumber);
         env->SetObjectArrayElement(arr, i, obj);
+        env->DeleteLocalRef(obj);
     }
     return arr;
 }
 
 jobjectArray FilterCallback::getMmtpRecordEvent(
-        jobjectArray& arr, const std::vector<DemuxFilterEvent::Event>& events) {
+        jobjectArray& arr, const hidl_vec<DemuxFilterEvent::Event>& events) {
     JNIEnv *env = AndroidRuntime::getJNIEnv();
     jclass eventClazz = env->FindClass("android/media/tv/tuner/filter/MmtpRecordEvent");
     jmethodID eventInit = env->GetMethodID(eventClazz, "<init>", "(IJ)V");
 
     for (int i = 0; i < events.size(); i++) {
-        auto event = events[i];
+        const auto& event = events[i];
         DemuxFilterMmtpRecordEvent mmtpRecordEvent = event.mmtpRecord();
 
         jint scHevcIndexMask = static_cast<jint>(mmtpRecordEvent.scHevcIndexMask);
@@ -535,18 +543,19 @@ jobjectArray FilterCallback::getMmtpRecordEvent(
         jobject obj =
                 env->NewObject(eventClazz, eventInit, scHevcIndexMask, byteNumber);
         env->SetObjectArrayElement(arr, i, obj);
+        env->DeleteLocalRef(obj);
     }
     return arr;
 }
 
 jobjectArray FilterCallback::getDownloadEvent(
-        jobjectArray& arr, const std::vector<DemuxFilterEvent::Event>& events) {
+        jobjectArray& arr, const hidl_vec<DemuxFilterEvent::Event>& events) {
     JNIEnv *env = AndroidRuntime::getJNIEnv();
     jclass eventClazz = env->FindClass("android/media/tv/tuner/filter/DownloadEvent");
     jmethodID eventInit = env->GetMethodID(eventClazz, "<init>", "(IIIII)V");
 
     for (int i = 0; i < events.size(); i++) {
-        auto event = events[i];
+        const auto& event = events[i];
         DemuxFilterDownloadEvent downloadEvent = event.download();
 
         jint itemId = static_cast<jint>(downloadEvent.itemId);
@@ -559,45 +568,49 @@ jobjectArray FilterCallback::getDownloadEvent(
                 env->NewObject(eventClazz, eventInit, itemId, mpuSequenceNumber, itemFragmentIndex,
                         lastItemFragmentIndex, dataLength);
         env->SetObjectArrayElement(arr, i, obj);
+        env->DeleteLocalRef(obj);
     }
     return arr;
 }
 
 jobjectArray FilterCallback::getIpPayloadEvent(
-        jobjectArray& arr, const std::vector<DemuxFilterEvent::Event>& events) {
+        jobjectArray& arr, const hidl_vec<DemuxFilterEvent::Event>& events) {
     JNIEnv *env = AndroidRuntime::getJNIEnv();
     jclass eventClazz = env->FindClass("android/media/tv/tuner/filter/IpPayloadEvent");
     jmethodID eventInit = env->GetMethodID(eventClazz, "<init>", "(I)V");
 
     for (int i = 0; i < events.size(); i++) {
-        auto event = events[i];
+        const auto& event = events[i];
         DemuxFilterIpPayloadEvent ipPayloadEvent = event.ipPayload();
         jint dataLength = static_cast<jint>(ipPayloadEvent.dataLength);
         jobject obj = env->NewObject(eventClazz, eventInit, dataLength);
         env->SetObjectArrayElement(arr, i, obj);
+        env->DeleteLocalRef(obj);
     }
     return arr;
 }
 
 jobjectArray FilterCallback::getTemiEvent(
-        jobjectArray& arr, const std::vector<DemuxFilterEvent::Event>& events) {
+        jobjectArray& arr, const hidl_vec<DemuxFilterEvent::Event>& events) {
     JNIEnv *env = AndroidRuntime::getJNIEnv();
     jclass eventClazz = env->FindClass("android/media/tv/tuner/filter/TemiEvent");
     jmethodID eventInit = env->GetMethodID(eventClazz, "<init>", "(JB[B)V");
 
     for (int i = 0; i < events.size(); i++) {
-        auto event = events[i];
-        DemuxFilterTemiEvent temiEvent = event.temi();
+        const auto& event = events[i];
+        const DemuxFilterTemiEvent& temiEvent = event.temi();
         jlong pts = static_cast<jlong>(temiEvent.pts);
         jbyte descrTag = static_cast<jbyte>(temiEvent.descrTag);
-        std::vector<uint8_t> descrData = temiEvent.descrData;
+        const hidl_vec<uint8_t>& descrData = temiEvent.descrData;
 
         jbyteArray array = env->NewByteArray(descrData.size());
         env->SetByteArrayRegion(
-                array, 0, descrData.size(), reinterpret_cast<jbyte*>(&descrData[0]));
+                array, 0, descrData.size(), reinterpret_cast<const jbyte*>(descrData.data()));
 
         jobject obj = env->NewObject(eventClazz, eventInit, pts, descrTag, array);
         env->SetObjectArrayElement(arr, i, obj);
+        env->DeleteLocalRef(obj);
+        env->DeleteLocalRef(array);
     }
     return arr;
 }
@@ -607,12 +620,14 @@ Return<void> FilterCallback::onFilterEvent(const DemuxFilterEvent& filterEvent)
 
     JNIEnv *env = AndroidRuntime::getJNIEnv();
 
-    std::vector<DemuxFilterEvent::Event> events = filterEvent.events;
+    // All events of a callback are delivered to Java as one array.
+    const hidl_vec<DemuxFilterEvent::Event>& events = filterEvent.events;
     jclass eventClazz = env->FindClass("android/media/tv/tuner/filter/FilterEvent");
     jobjectArray array = env->NewObjectArray(events.size(), eventClazz, NULL);
+    env->DeleteLocalRef(eventClazz);
 
-    if (!events.empty()) {
-        auto event = events[0];
+    if (events.size() > 0) {
+        const auto& event = events[0];
         switch (event.getDiscriminator()) {
             case DemuxFilterEvent::Event::hidl_discriminator::media: {
                 array = getMediaEvent(array, events);
@@ -655,6 +670,7 @@ Return<void> FilterCallback::onFilterEvent(const DemuxFilterEvent& filterEvent)
             mFilter,
             gFields.onFilterEventID,
             array);
+    env->DeleteLocalRef(array);
     return Void();
 }
 
@@ -2968,28 +2984,40 @@ static DemuxFilterSettings getFilterConfiguration(
 
 static jint copyData(JNIEnv *env, std::unique_ptr<MQ>& mq, EventFlag* flag, jbyteArray buffer,
         jlong offset, jlong size) {
-    ALOGD("copyData, size=%ld, offset=%ld", (long) size, (long) offset);
+    ALOGV("copyData, size=%ld, offset=%ld", (long) size, (long) offset);
 
     jlong available = mq->availableToRead();
-    ALOGD("copyData, available=%ld", (long) available);
+    ALOGV("copyData, available=%ld", (long) available);
     size = std::min(size, available);
-
-    jboolean isCopy;
-    jbyte *dst = env->GetByteArrayElements(buffer, &isCopy);
-    ALOGD("copyData, isCopy=%d", isCopy);
-    if (dst == nullptr) {
-        jniThrowRuntimeException(env, "Failed to GetByteArrayElements");
+    if (size <= 0) {
         return 0;
     }
 
-    if (mq->read(reinterpret_cast<unsigned char*>(dst) + offset, size)) {
-        env->ReleaseByteArrayElements(buffer, dst, 0);
-        flag->wake(static_cast<uint32_t>(DemuxQueueNotifyBits::DATA_CONSUMED));
-    } else {
+    // Copy straight out of the FMQ's (possibly wrapped) regions into the requested part of
+    // the Java array, instead of pinning or copying the whole array.
+    MQ::MemTransaction tx;
+    if (!mq->beginRead(size, &tx)) {
+        jniThrowRuntimeException(env, "Failed to read FMQ");
+        return 0;
+    }
+    const MQ::MemRegion& first = tx.getFirstRegion();
+    const MQ::MemRegion& second = tx.getSecondRegion();
+    const size_t firstLength = std::min((size_t) size, first.getLength());
+    env->SetByteArrayRegion(buffer, offset, firstLength,
+            reinterpret_cast<const jbyte*>(first.getAddress()));
+    if (firstLength < (size_t) size) {
+        env->SetByteArrayRegion(buffer, offset + firstLength, size - firstLength,
+                reinterpret_cast<const jbyte*>(second.getAddress()));
+    }
+    if (env->ExceptionCheck()) {
+        // ArrayIndexOutOfBoundsException is pending; leave the data in the queue.
+        return 0;
+    }
+    if (!mq->commitRead(size)) {
         jniThrowRuntimeException(env, "Failed to read FMQ");
-        env->ReleaseByteArrayElements(buffer, dst, 0);
         return 0;
     }
+    flag->wake(static_cast<uint32_t>(DemuxQueueNotifyBits::DATA_CONSUMED));
     return size;
 }
 
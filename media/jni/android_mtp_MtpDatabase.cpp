@@ -44,6 +44,9 @@
 #include <stdio.h>
 #include <unistd.h>
 
+#include <string>
+#include <unordered_map>
+
 using namespace android;
 
 // ----------------------------------------------------------------------------
@@ -99,6 +102,27 @@ private:
     jlongArray      mLongBuffer;
     jcharArray      mStringBuffer;
 
+    // Thumbnail details reported in ObjectInfo. Reading them means parsing
+    // the image file (EXIF or RAW preview), which dominates GetObjectInfo when
+    // a host lists a large photo folder, so they are cached per object for the
+    // session. An entry is only used while the object's path, size and
+    // modification date are unchanged.
+    struct ThumbnailInfo {
+        std::string     path;
+        int64_t         length;
+        time_t          dateModified;
+        uint32_t        thumbCompressedSize;
+        MtpObjectFormat thumbFormat;
+        uint32_t        imagePixWidth;
+        uint32_t        imagePixHeight;
+    };
+    // Bounds the cache; it is simply cleared when full.
+    static constexpr size_t kMaxThumbnailInfoCacheSize = 16384;
+    std::unordered_map<MtpObjectHandle, ThumbnailInfo> mThumbnailInfoCache;
+
+    void            readThumbnailInfo(MtpObjectHandle handle, const MtpStringBuffer& path,
+                                            MtpObjectFormat format, ThumbnailInfo& thumbInfo);
+
 public:
                                     MtpDatabase(JNIEnv *env, jobject client);
     virtual                         ~MtpDatabase();
@@ -228,6 +252,7 @@ MtpDatabase::MtpDatabase(JNIEnv *env, jobject client)
 }
 
 void MtpDatabase::cleanup(JNIEnv *env) {
+    mThumbnailInfoCache.clear();
     env->DeleteGlobalRef(mDatabase);
     env->DeleteGlobalRef(mIntBuffer);
     env->DeleteGlobalRef(mLongBuffer);
@@ -253,6 +278,7 @@ MtpObjectHandle MtpDatabase::beginSendObject(const char* path,
 }
 
 void MtpDatabase::endSendObject(MtpObjectHandle handle, bool succeeded) {
+    mThumbnailInfoCache.erase(handle);
     JNIEnv* env = AndroidRuntime::getJNIEnv();
     env->CallVoidMethod(mDatabase, method_endSendObject, (jint)handle, (jboolean)succeeded);
 
@@ -261,6 +287,7 @@ void MtpDatabase::endSendObject(MtpObjectHandle handle, bool succeeded) {
 
 void MtpDatabase::rescanFile(const char* path, MtpObjectHandle handle,
                                   MtpObjectFormat format) {
+    mThumbnailInfoCache.erase(handle);
     JNIEnv* env = AndroidRuntime::getJNIEnv();
     jstring pathStr = env->NewStringUTF(path);
     env->CallVoidMethod(mDatabase, method_rescanFile, pathStr,
@@ -816,15 +843,46 @@ MtpResponseCode MtpDatabase::getObjectInfo(MtpObjectHandle handle,
     info.mName = strdup(temp);
     env->ReleaseCharArrayElements(mStringBuffer, str, 0);
 
+    checkAndClearExceptionFromCallback(env, __FUNCTION__);
+
+    auto cached = mThumbnailInfoCache.find(handle);
+    if (cached == mThumbnailInfoCache.end()
+            || cached->second.path != (const char*)path
+            || cached->second.length != length
+            || cached->second.dateModified != info.mDateModified) {
+        ThumbnailInfo thumbInfo = {};
+        thumbInfo.path = (const char*)path;
+        thumbInfo.length = length;
+        thumbInfo.dateModified = info.mDateModified;
+        readThumbnailInfo(handle, path, info.mFormat, thumbInfo);
+        if (mThumbnailInfoCache.size() >= kMaxThumbnailInfoCacheSize) {
+            mThumbnailInfoCache.clear();
+        }
+        cached = mThumbnailInfoCache.insert_or_assign(handle, std::move(thumbInfo)).first;
+    }
+    const ThumbnailInfo& thumbInfo = cached->second;
+    if (thumbInfo.thumbFormat != 0) {
+        info.mThumbCompressedSize = thumbInfo.thumbCompressedSize;
+        info.mThumbFormat = thumbInfo.thumbFormat;
+        info.mImagePixWidth = thumbInfo.imagePixWidth;
+        info.mImagePixHeight = thumbInfo.imagePixHeight;
+    }
+
+    return MTP_RESPONSE_OK;
+}
+
+void MtpDatabase::readThumbnailInfo(MtpObjectHandle handle, const MtpStringBuffer& path,
+                                    MtpObjectFormat format, ThumbnailInfo& thumbInfo) {
+    JNIEnv* env = AndroidRuntime::getJNIEnv();
+
     // read EXIF data for thumbnail information
-    switch (info.mFormat) {
+    switch (format) {
         case MTP_FORMAT_EXIF_JPEG:
         case MTP_FORMAT_HEIF:
         case MTP_FORMAT_JFIF:
         case MTP_FORMAT_PNG:
         case MTP_FORMAT_BMP:
         case MTP_FORMAT_GIF: {
-            env = AndroidRuntime::getJNIEnv();
             if (env->CallBooleanMethod(
                     mDatabase, method_getThumbnailInfo, (jint)handle, mLongBuffer)) {
 
@@ -835,10 +893,10 @@ MtpResponseCode MtpDatabase::getObjectInfo(MtpObjectHandle handle,
                 if (size > 0 && size <= UINT32_MAX &&
                         w > 0 && w <= UINT32_MAX &&
                         h > 0 && h <= UINT32_MAX) {
-                    info.mThumbCompressedSize = size;
-                    info.mThumbFormat = MTP_FORMAT_EXIF_JPEG;
-                    info.mImagePixWidth = w;
-                    info.mImagePixHeight = h;
+                    thumbInfo.thumbCompressedSize = size;
+                    thumbInfo.thumbFormat = MTP_FORMAT_EXIF_JPEG;
+                    thumbInfo.imagePixWidth = w;
+                    thumbInfo.imagePixHeight = h;
                 }
                 env->ReleaseLongArrayElements(mLongBuffer, longValues, 0);
             }
@@ -860,17 +918,16 @@ MtpResponseCode MtpDatabase::getObjectInfo(MtpObjectHandle handle,
                 break;
             }
 
-            info.mThumbCompressedSize = image_data.thumbnail.length;
-            info.mThumbFormat = MTP_FORMAT_EXIF_JPEG;
-            info.mImagePixWidth = image_data.full_width;
-            info.mImagePixHeight = image_data.full_height;
+            thumbInfo.thumbCompressedSize = image_data.thumbnail.length;
+            thumbInfo.thumbFormat = MTP_FORMAT_EXIF_JPEG;
+            thumbInfo.imagePixWidth = image_data.full_width;
+            thumbInfo.imagePixHeight = image_data.full_height;
 
             break;
         }
     }
 
     checkAndClearExceptionFromCallback(env, __FUNCTION__);
-    return MTP_RESPONSE_OK;
 }
 
 void* MtpDatabase::getThumbnail(MtpObjectHandle handle, size_t& outThumbSize) {
@@ -978,6 +1035,9 @@ MtpResponseCode MtpDatabase::beginDeleteObject(MtpObjectHandle handle) {
 }
 
 void MtpDatabase::endDeleteObject(MtpObjectHandle handle, bool succeeded) {
+    if (succeeded) {
+        mThumbnailInfoCache.erase(handle);
+    }
     JNIEnv* env = AndroidRuntime::getJNIEnv();
     env->CallVoidMethod(mDatabase, method_endDeleteObject, (jint)handle, (jboolean) succeeded);
 
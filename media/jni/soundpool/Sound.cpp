@@ -20,6 +20,12 @@
 
 #include "Sound.h"
 
+#include <map>
+#include <mutex>
+#include <sys/stat.h>
+#include <tuple>
+
+#include <android-base/thread_annotations.h>
 #include <media/NdkMediaCodec.h>
 #include <media/NdkMediaExtractor.h>
 #include <media/NdkMediaFormat.h>
@@ -29,6 +35,90 @@ namespace android::soundpool {
 constexpr uint32_t kMaxSampleRate = 192000;
 constexpr size_t   kDefaultHeapSize = 1024 * 1024; // 1MB (compatible with low mem devices)
 
+/**
+ * DecodedSoundCache lets all SoundPools of a process share the decoded PCM of a sound
+ * loaded from the same bytes of the same file, such as the system UI and keyboard click
+ * sounds, instead of each decoding it into its own heap.
+ *
+ * Entries are keyed by the identity of the file (device, inode, size, modification time)
+ * plus the offset and length of the sound within it, and only hold weak references, so
+ * the decoded data is freed as soon as the last Sound using it is released.
+ */
+class DecodedSoundCache {
+public:
+    struct Key {
+        dev_t   dev;
+        ino_t   ino;
+        off64_t size;
+        int64_t mtimeNs;
+        int64_t offset;
+        int64_t length;
+
+        bool operator<(const Key& other) const {
+            return std::tie(dev, ino, size, mtimeNs, offset, length)
+                    < std::tie(other.dev, other.ino, other.size, other.mtimeNs,
+                               other.offset, other.length);
+        }
+    };
+
+    struct Entry {
+        wp<MemoryHeapBase>   heap;
+        size_t               sizeInBytes = 0;
+        uint32_t             sampleRate = 0;
+        int32_t              channelCount = 0;
+        audio_format_t       format = AUDIO_FORMAT_INVALID;
+        audio_channel_mask_t channelMask = AUDIO_CHANNEL_NONE;
+    };
+
+    static DecodedSoundCache& getInstance() {
+        static DecodedSoundCache* cache = new DecodedSoundCache();  // never deleted
+        return *cache;
+    }
+
+    static bool getKey(int fd, int64_t offset, int64_t length, Key* key) {
+        struct stat st;
+        if (fstat(fd, &st) != 0 || !S_ISREG(st.st_mode)) {
+            return false;  // only regular files have a stable identity.
+        }
+        *key = Key{st.st_dev, st.st_ino, st.st_size,
+                   (int64_t)st.st_mtim.tv_sec * 1000000000LL + st.st_mtim.tv_nsec,
+                   offset, length};
+        return true;
+    }
+
+    // Returns the cached entry for key with a strong reference to its heap in *heap,
+    // or false if the sound is not cached or its heap has been released.
+    bool find(const Key& key, Entry* entry, sp<MemoryHeapBase>* heap) {
+        std::lock_guard lock(mLock);
+        auto it = mEntries.find(key);
+        if (it == mEntries.end()) return false;
+        *heap = it->second.heap.promote();
+        if (*heap == nullptr) {
+            mEntries.erase(it);
+            return false;
+        }
+        *entry = it->second;
+        return true;
+    }
+
+    void insert(const Key& key, const Entry& entry) {
+        std::lock_guard lock(mLock);
+        // Drop the entries whose sounds have all been released.
+        for (auto it = mEntries.begin(); it != mEntries.end(); ) {
+            if (it->second.heap.promote() == nullptr) {
+                it = mEntries.erase(it);
+            } else {
+                ++it;
+            }
+        }
+        mEntries[key] = entry;
+    }
+
+private:
+    std::mutex mLock;
+    std::map<Key, Entry> mEntries GUARDED_BY(mLock);
+};
+
 Sound::Sound(int32_t soundID, int fd, int64_t offset, int64_t length)
     : mSoundID(soundID)
     , mFd(fcntl(fd, F_DUPFD_CLOEXEC, (int)0 /* arg */)) // dup(fd) + close on exec to prevent leaks.
@@ -197,6 +287,22 @@ status_t Sound::doLoad()
     ALOGV("%s()", __func__);
     status_t status = NO_INIT;
     if (mFd.get() != -1) {
+        DecodedSoundCache::Key key;
+        const bool cacheable = DecodedSoundCache::getKey(mFd.get(), mOffset, mLength, &key);
+        DecodedSoundCache::Entry entry;
+        if (cacheable && DecodedSoundCache::getInstance().find(key, &entry, &mHeap)) {
+            ALOGV("%s: reusing decoded sound, sizeInBytes = %zu", __func__, entry.sizeInBytes);
+            mFd.reset();  // close
+            mSizeInBytes = entry.sizeInBytes;
+            mData = new MemoryBase(mHeap, 0, mSizeInBytes);
+            mSampleRate = entry.sampleRate;
+            mChannelCount = entry.channelCount;
+            mFormat = entry.format;
+            mChannelMask = entry.channelMask;
+            mState = READY;  // this should be last, as it is an atomic sync point
+            return NO_ERROR;
+        }
+
         mHeap = new MemoryHeapBase(kDefaultHeapSize);
 
         ALOGV("%s: start decode", __func__);
@@ -226,6 +332,10 @@ status_t Sound::doLoad()
             mChannelCount = channelCount;
             mFormat = format;
             mChannelMask = channelMask;
+            if (cacheable) {
+                DecodedSoundCache::getInstance().insert(key, DecodedSoundCache::Entry{
+                        mHeap, mSizeInBytes, sampleRate, channelCount, format, channelMask});
+            }
             mState = READY;  // this should be last, as it is an atomic sync point
             return NO_ERROR;
         }
@@ -71,8 +71,8 @@ void SoundDecoder::run(int32_t id)
             }
             continue;
         }
-        const int32_t soundID = mSoundIDs.front();
-        mSoundIDs.pop_front();
+        const int32_t soundID = mSoundIDs.begin()->second;
+        mSoundIDs.erase(mSoundIDs.begin());
         mQueueSpaceAvailable.notify_one();
         ALOGV("%s(%d): processing soundID: %d  size: %zu", __func__, id, soundID, mSoundIDs.size());
         lock.unlock();
@@ -88,9 +88,9 @@ void SoundDecoder::run(int32_t id)
     ALOGV("%s(%d): exiting", __func__, id);
 }
 
-void SoundDecoder::loadSound(int32_t soundID)
+void SoundDecoder::loadSound(int32_t soundID, int32_t priority)
 {
-    ALOGV("%s(%d)", __func__, soundID);
+    ALOGV("%s(%d, %d)", __func__, soundID, priority);
     size_t pendingSounds;
     {
         std::unique_lock lock(mLock);
@@ -100,7 +100,7 @@ void SoundDecoder::loadSound(int32_t soundID)
             mQueueSpaceAvailable.wait(lock);
         }
         if (mQuit) return;
-        mSoundIDs.push_back(soundID);
+        mSoundIDs.emplace(priority, soundID);
         mQueueDataAvailable.notify_one();
         ALOGV("%s: adding soundID: %d  size: %zu", __func__, soundID, mSoundIDs.size());
         pendingSounds = mSoundIDs.size();
@@ -113,4 +113,18 @@ void SoundDecoder::loadSound(int32_t soundID)
     }
 }
 
+bool SoundDecoder::cancelSound(int32_t soundID)
+{
+    ALOGV("%s(%d)", __func__, soundID);
+    std::lock_guard lock(mLock);
+    for (auto it = mSoundIDs.begin(); it != mSoundIDs.end(); ++it) {
+        if (it->second == soundID) {
+            mSoundIDs.erase(it);
+            mQueueSpaceAvailable.notify_one();
+            return true;
+        }
+    }
+    return false;
+}
+
 } // end namespace android::soundpool
@@ -18,19 +18,27 @@
 
 #include "SoundPool.h"
 
-#include <deque>
+#include <functional>
+#include <map>
 #include <mutex>
 
 namespace android::soundpool {
 
 /**
  * SoundDecoder handles background decoding tasks.
+ *
+ * Pending decodes are served in order of decreasing load priority,
+ * and in FIFO order for equal priority.
  */
 class SoundDecoder {
 public:
     SoundDecoder(SoundManager* soundManager, size_t threads);
     ~SoundDecoder();
-    void loadSound(int32_t soundID) NO_THREAD_SAFETY_ANALYSIS; // uses unique_lock
+    void loadSound(int32_t soundID, int32_t priority = 0)
+            NO_THREAD_SAFETY_ANALYSIS; // uses unique_lock
+    // Removes a pending decode; returns false if the sound is not queued
+    // (it may already be decoding or decoded).
+    bool cancelSound(int32_t soundID);
     void quit();
 
 private:
@@ -44,7 +52,9 @@ private:
     std::condition_variable mQueueSpaceAvailable GUARDED_BY(mLock);
     std::condition_variable mQueueDataAvailable GUARDED_BY(mLock);
 
-    std::deque<int32_t>     mSoundIDs GUARDED_BY(mLock);
+    // std::multimap preserves insertion order of equal keys.
+    std::multimap<int32_t /* priority */, int32_t /* soundID */, std::greater<int32_t>>
+                            mSoundIDs GUARDED_BY(mLock);
     bool                    mQuit GUARDED_BY(mLock) = false;
 };
 
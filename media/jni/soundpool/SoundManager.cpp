@@ -20,13 +20,15 @@
 
 #include "SoundManager.h"
 
+#include <algorithm>
 #include <thread>
 
 #include "SoundDecoder.h"
 
 namespace android::soundpool {
 
-static const size_t kDecoderThreads = std::thread::hardware_concurrency() >= 4 ? 2 : 1;
+// Decoder threads are launched on demand as loads queue up, up to half the CPUs.
+static const size_t kDecoderThreads = std::max(std::thread::hardware_concurrency() / 2, 1U);
 
 SoundManager::SoundManager()
     : mDecoder{std::make_unique<SoundDecoder>(this, kDecoderThreads)}
@@ -62,14 +64,16 @@ int32_t SoundManager::load(int fd, int64_t offset, int64_t length, int32_t prior
     // mDecoder->loadSound() may block on mDecoder message queue space;
     // the message queue emptying may block on SoundManager::findSound().
     //
-    // It is theoretically possible that sound loads might decode out-of-order.
-    mDecoder->loadSound(soundID);
+    // Sound loads decode in priority order, so they may complete out-of-order.
+    mDecoder->loadSound(soundID, priority);
     return soundID;
 }
 
 bool SoundManager::unload(int32_t soundID)
 {
     ALOGV("%s(soundID=%d)", __func__, soundID);
+    // Drop a pending decode, called outside of mSoundManagerLock as with loadSound().
+    mDecoder->cancelSound(soundID);
     std::lock_guard lock(mSoundManagerLock);
     return mSounds.erase(soundID) > 0; // erase() returns number of sounds removed.
 }
@@ -166,6 +166,7 @@ void Stream::setPlay(
     mRate = rate;
     mState = PLAYING;
     mAutoPaused = false;   // New for R (consistent with Java API spec).
+    mPlayRequestTimeNs = systemTime();
     mStreamID = streamID;  // prefer this to be the last, as it is an atomic sync point
 }
 
@@ -280,6 +281,7 @@ void Stream::play_l(const std::shared_ptr<Sound>& sound, int32_t nextStreamID,
     sp<AudioTrack> &oldTrack = releaseTracks[0];
     sp<AudioTrack> &newTrack = releaseTracks[1];
     status_t status = NO_ERROR;
+    bool reusedTrack = false;
 
     {
         ALOGV("%s(%p)(soundID=%d, streamID=%d, leftVolume=%f, rightVolume=%f,"
@@ -306,6 +308,7 @@ void Stream::play_l(const std::shared_ptr<Sound>& sound, int32_t nextStreamID,
             // the sample rate may fail to change if the audio track is a fast track.
             if (mAudioTrack->setSampleRate(sampleRate) == NO_ERROR) {
                 newTrack = mAudioTrack;
+                reusedTrack = true;
                 ALOGV("%s: reusing track %p for sound %d",
                         __func__, mAudioTrack.get(), sound->getSoundID());
             }
@@ -358,6 +361,11 @@ void Stream::play_l(const std::shared_ptr<Sound>& sound, int32_t nextStreamID,
         }
         newTrack->setLoop(0, frameCount, loop);
         mAudioTrack->start();
+        if (mPlayRequestTimeNs != 0) {
+            // Trigger-to-start latency; includes any AudioTrack creation above.
+            mStreamManager->recordPlayLatency(systemTime() - mPlayRequestTimeNs, reusedTrack);
+            mPlayRequestTimeNs = 0;
+        }
         mSound = sound;
         mSoundID = sound->getSoundID();
         mPriority = priority;
@@ -154,6 +154,7 @@ private:
     sp<AudioTrack>      mAudioTrack GUARDED_BY(mLock);
     int                 mToggle GUARDED_BY(mLock) = 0;
     int64_t             mStopTimeNs GUARDED_BY(mLock) = 0;  // if nonzero, time to wait for stop.
+    int64_t             mPlayRequestTimeNs GUARDED_BY(mLock) = 0; // systemTime() of setPlay().
 };
 
 } // namespace android::soundpool
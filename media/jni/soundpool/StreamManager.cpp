@@ -38,7 +38,10 @@ static constexpr bool kStealActiveStream_OldestFirst = true;
 // kPlayOnCallingThread = true prior to R.
 // Changing to false means calls to play() are almost instantaneous instead of taking around
 // ~10ms to launch the AudioTrack. It is perhaps 100x faster.
-static constexpr bool kPlayOnCallingThread = true;
+// When false, play() still runs on the calling thread if the stream's AudioTrack can be
+// reused (same soundID), as that only requires AudioTrack::start(); otherwise the
+// AudioTrack is created by a StreamManager thread through the restart queue.
+static constexpr bool kPlayOnCallingThread = false;
 
 // Amount of time for a StreamManager thread to wait before closing.
 static constexpr int64_t kWaitTimeBeforeCloseNs = 9 * NANOS_PER_SECOND;
@@ -229,7 +232,8 @@ int32_t StreamManager::queueForPlay(const std::shared_ptr<Sound> &sound,
                 __func__, newStream, pairStream, streamID);
         pairStream->setPlay(
                 streamID, sound, soundID, leftVolume, rightVolume, priority, loop, rate);
-        if (fromAvailableQueue && kPlayOnCallingThread) {
+        if (fromAvailableQueue
+                && (kPlayOnCallingThread || newStream->getSoundID() == soundID)) {
             removeFromQueues_l(newStream);
             mProcessingStreams.emplace(newStream);
             lock.unlock();
@@ -259,6 +263,16 @@ int32_t StreamManager::queueForPlay(const std::shared_ptr<Sound> &sound,
     return streamID;
 }
 
+void StreamManager::recordPlayLatency(int64_t latencyNs, bool reusedTrack)
+{
+    ALOGV("%s(latencyNs=%lld, reusedTrack=%d)", __func__, (long long)latencyNs, reusedTrack);
+    ++mPlayCount;
+    if (reusedTrack) ++mReusedTrackCount;
+    mPlayLatencyTotalNs += latencyNs;
+    int64_t maxNs = mPlayLatencyMaxNs.load();
+    while (latencyNs > maxNs && !mPlayLatencyMaxNs.compare_exchange_weak(maxNs, latencyNs)) {}
+}
+
 void StreamManager::moveToRestartQueue(
         Stream* stream, int32_t activeStreamIDToMatch)
 {
@@ -403,6 +417,11 @@ void StreamManager::run(int32_t id)
 void StreamManager::dump() const
 {
     forEach([](const Stream *stream) { stream->dump(); });
+    const int64_t plays = mPlayCount.load();
+    ALOGV("plays=%lld, reusedTracks=%lld, avgLatencyNs=%lld, maxLatencyNs=%lld",
+            (long long)plays, (long long)mReusedTrackCount.load(),
+            (long long)(plays > 0 ? mPlayLatencyTotalNs.load() / plays : 0),
+            (long long)mPlayLatencyMaxNs.load());
 }
 
 void StreamManager::sanityCheckQueue_l() const
@@ -18,6 +18,7 @@
 
 #include "Stream.h"
 
+#include <atomic>
 #include <condition_variable>
 #include <future>
 #include <list>
@@ -410,6 +411,11 @@ public:
     // if the streamIDToMatch is found on the active queue.
     void moveToRestartQueue(Stream* stream, int32_t activeStreamIDToMatch = 0);
 
+    // Records the trigger-to-start latency of a play (from the app play() request
+    // to AudioTrack::start()), and whether an existing AudioTrack was reused.
+    // This is lock-free, so it may be called by a Stream holding its own lock.
+    void recordPlayLatency(int64_t latencyNs, bool reusedTrack);
+
 private:
 
     void run(int32_t id) NO_THREAD_SAFETY_ANALYSIS; // worker thread, takes unique_lock.
@@ -479,6 +485,12 @@ private:
     std::unordered_set<Stream*> mProcessingStreams GUARDED_BY(mStreamManagerLock);
 
     const std::string           mOpPackageName;
+
+    // Play latency statistics, see recordPlayLatency().  No lock needed.
+    std::atomic<int64_t>        mPlayCount = 0;
+    std::atomic<int64_t>        mReusedTrackCount = 0;
+    std::atomic<int64_t>        mPlayLatencyTotalNs = 0;
+    std::atomic<int64_t>        mPlayLatencyMaxNs = 0;
 };
 
 } // namespace android::soundpool
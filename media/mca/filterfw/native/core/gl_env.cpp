@@ -34,6 +34,10 @@
 namespace android {
 namespace filterfw {
 
+// Textures kept around for reuse per environment. Effect graphs usually cycle
+// through a handful of frame sizes, so a small pool covers them.
+static const size_t kMaxPooledTextures = 16;
+
 GLEnv::GLEnv()
   : display_(EGL_NO_DISPLAY),
     context_id_(0),
@@ -45,6 +49,16 @@ GLEnv::GLEnv()
 }
 
 GLEnv::~GLEnv() {
+  // Delete pooled textures while we can still reach the context
+  if (IsActive()) {
+    for (std::multimap<std::pair<int, int>, GLuint>::iterator it = pooled_textures_.begin();
+         it != pooled_textures_.end();
+         ++it) {
+      glDeleteTextures(1, &it->second);
+    }
+  }
+  pooled_textures_.clear();
+
   // Destroy surfaces
   for (std::map<int, SurfaceWindowPair>::iterator it = surfaces_.begin();
        it != surfaces_.end();
@@ -412,5 +426,23 @@ VertexFrame* GLEnv::VertexFrameWithKey(int key) {
   return FindPtrOrNull(attached_vframes_, key);
 }
 
+GLuint GLEnv::ObtainPooledTexture(int width, int height) {
+  std::multimap<std::pair<int, int>, GLuint>::iterator it =
+      pooled_textures_.find(std::make_pair(width, height));
+  if (it == pooled_textures_.end())
+    return 0;
+  const GLuint texture_id = it->second;
+  pooled_textures_.erase(it);
+  return texture_id;
+}
+
+void GLEnv::RecycleTexture(GLuint texture_id, int width, int height) {
+  if (pooled_textures_.size() < kMaxPooledTextures) {
+    pooled_textures_.insert(std::make_pair(std::make_pair(width, height), texture_id));
+  } else {
+    glDeleteTextures(1, &texture_id);
+  }
+}
+
 } // namespace filterfw
 } // namespace android
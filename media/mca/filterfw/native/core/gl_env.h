@@ -191,6 +191,18 @@ class GLEnv {
     // such frame attached to this environment.
     VertexFrame* VertexFrameWithKey(int key);
 
+    // Texture pooling /////////////////////////////////////////////////////////
+
+    // Returns an allocated RGBA texture of the given size that a previous
+    // frame has handed back, or 0 if there is none. The caller takes
+    // ownership of the texture.
+    GLuint ObtainPooledTexture(int width, int height);
+
+    // Hands an allocated RGBA texture of the given size back to the
+    // environment for reuse. If the pool is full the texture is deleted.
+    // This environment must be active.
+    void RecycleTexture(GLuint texture_id, int width, int height);
+
     // Static methods //////////////////////////////////////////////////////////
     // These operate on the currently active environment!
 
@@ -256,6 +268,9 @@ class GLEnv {
     std::map<int, ShaderProgram*> attached_shaders_;
     std::map<int, VertexFrame*> attached_vframes_;
 
+    // Allocated textures available for reuse, keyed by (width, height).
+    std::multimap<std::pair<int, int>, GLuint> pooled_textures_;
+
     GLEnv(const GLEnv&) = delete;
     GLEnv& operator=(const GLEnv&) = delete;
 };
@@ -92,8 +92,11 @@ void GLFrame::InitDimensions(int width, int height) {
 }
 
 GLFrame::~GLFrame() {
-  // Delete texture
-  if (owns_texture_) {
+  // Hand our texture back to the environment, or delete it. Deleting the FBO
+  // below detaches a recycled texture from it.
+  if (IsPoolableTexture() && !TextureWasDeleted()) {
+    gl_env_->RecycleTexture(texture_id_, width_, height_);
+  } else if (owns_texture_) {
     // Bind FBO so that texture is unbound from it during deletion
     if (fbo_state_ == kStateComplete) {
       glBindFramebuffer(GL_FRAMEBUFFER, fbo_id_);
@@ -288,6 +291,20 @@ bool GLFrame::GenerateTextureName() {
       return false;
     }
 
+    // Reuse an allocated texture of our size if the environment has one
+    if (texture_target_ == GL_TEXTURE_2D && width_ > 0 && height_ > 0) {
+      texture_id_ = gl_env_->ObtainPooledTexture(width_, height_);
+      if (texture_id_ != 0) {
+        LOG_FRAME("GLFrame: Reusing pooled texture: %d", texture_id_);
+        owns_texture_ = true;
+        glBindTexture(GL_TEXTURE_2D, texture_id_);
+        if (!UpdateTexParameters())
+          return false;
+        texture_state_ = kStateComplete;
+        return true;
+      }
+    }
+
     // Generate the texture
     glGenTextures (1, &texture_id_);
     if (GLEnv::CheckGLError("Texture Generation"))
@@ -325,6 +342,14 @@ bool GLFrame::TextureWasDeleted() const {
   return texture_state_ == kStateComplete && !glIsTexture(texture_id_);
 }
 
+bool GLFrame::IsPoolableTexture() const {
+  return owns_texture_
+      && texture_target_ == GL_TEXTURE_2D
+      && texture_state_ == kStateComplete
+      && width_ > 0
+      && height_ > 0;
+}
+
 bool GLFrame::GenerateFboName() {
   if (fbo_state_ == kStateUninitialized) {
     // Make sure FBO not in use already
@@ -449,9 +474,15 @@ bool GLFrame::UploadTexturePixels(const uint8_t* pixels) {
   // Bind the texture object
   FocusTexture();
 
-  // Load mipmap level 0
-  glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA, width_, height_,
-               0, GL_RGBA, GL_UNSIGNED_BYTE, pixels);
+  // Load mipmap level 0. Textures we allocated already have our size, so
+  // update them in place instead of re-specifying the storage.
+  if (IsPoolableTexture() && !TextureWasDeleted()) {
+    glTexSubImage2D(GL_TEXTURE_2D, 0, 0, 0, width_, height_,
+                    GL_RGBA, GL_UNSIGNED_BYTE, pixels);
+  } else {
+    glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA, width_, height_,
+                 0, GL_RGBA, GL_UNSIGNED_BYTE, pixels);
+  }
 
   // Set the user specified texture parameters
   UpdateTexParameters();
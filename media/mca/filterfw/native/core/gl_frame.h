@@ -138,6 +138,10 @@ class GLFrame : public GLBufferHandle {
     // Creates the internal FBO.
     bool GenerateFboName();
 
+    // Returns true if we own an allocated 2D texture of our size, which can be
+    // handed back to the environment's texture pool.
+    bool IsPoolableTexture() const;
+
     // Copies pixels from texture or FBO to the specified buffer.
     bool CopyPixelsTo(uint8_t* buffer);
 
@@ -16,15 +16,60 @@
 
 #include "core/native_frame.h"
 
+#include <map>
+#include <mutex>
+
 namespace android {
 namespace filterfw {
 
+namespace {
+
+// Frame buffers are recycled by size across all native frames, since effect
+// graphs allocate a fresh frame per filter for every video frame. Small
+// buffers are cheap to allocate and are not pooled.
+const int kMinPooledBytes = 4096;
+const int kMaxPooledBytes = 32 * 1024 * 1024;
+
+std::mutex sPoolLock;
+std::multimap<int, uint8_t*> sPooledBuffers;
+int sPooledBytes = 0;
+
+uint8_t* ObtainBuffer(int size) {
+  if (size == 0)
+    return NULL;
+  if (size >= kMinPooledBytes) {
+    std::lock_guard<std::mutex> lock(sPoolLock);
+    std::multimap<int, uint8_t*>::iterator it = sPooledBuffers.find(size);
+    if (it != sPooledBuffers.end()) {
+      uint8_t* buffer = it->second;
+      sPooledBuffers.erase(it);
+      sPooledBytes -= size;
+      return buffer;
+    }
+  }
+  return new uint8_t[size];
+}
+
+void RecycleBuffer(uint8_t* buffer, int size) {
+  if (buffer && size >= kMinPooledBytes) {
+    std::lock_guard<std::mutex> lock(sPoolLock);
+    if (sPooledBytes + size <= kMaxPooledBytes) {
+      sPooledBuffers.insert(std::make_pair(size, buffer));
+      sPooledBytes += size;
+      return;
+    }
+  }
+  delete[] buffer;
+}
+
+} // namespace
+
 NativeFrame::NativeFrame(int size) : data_(NULL), size_(size), capacity_(size) {
-  data_ = capacity_ == 0 ? NULL : new uint8_t[capacity_];
+  data_ = ObtainBuffer(capacity_);
 }
 
 NativeFrame::~NativeFrame() {
-  delete[] data_;
+  RecycleBuffer(data_, capacity_);
 }
 
 bool NativeFrame::WriteData(const uint8_t* data, int offset, int size) {
@@ -36,7 +81,7 @@ bool NativeFrame::WriteData(const uint8_t* data, int offset, int size) {
 }
 
 bool NativeFrame::SetData(uint8_t* data, int size) {
-  delete[] data_;
+  RecycleBuffer(data_, capacity_);
   size_ = capacity_ = size;
   data_ = data;
   return true;
@@ -23,11 +23,22 @@
 #include <androidfw/AssetDir.h>
 #include <androidfw/AssetManager.h>
 #include <androidfw/AssetManager2.h>
+#include <android-base/unique_fd.h>
 #include <utils/threads.h>
 
 #include "jni.h"
 #include <nativehelper/JNIHelp.h>
 
+#include <algorithm>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+
+#include <errno.h>
+#include <unistd.h>
+
 using namespace android;
 
 // -------------------- Backing implementation of the public API --------------------
@@ -50,9 +61,138 @@ struct AAssetDir {
 struct AAsset {
     std::unique_ptr<Asset> mAsset;
 
+    // Serializes ranged reads that have to go through mAsset's cursor.
+    std::mutex mRangeLock;
+    // For assets stored uncompressed, a descriptor for the containing file
+    // so ranged reads can pread() without touching the cursor.
+    bool mRangeFdChecked = false;
+    base::unique_fd mRangeFd;
+    off64_t mRangeFdStart = 0;
+    off64_t mRangeFdLength = 0;
+
     explicit AAsset(std::unique_ptr<Asset> asset) : mAsset(std::move(asset)) { }
 };
 
+// One region of an asset for AAsset_readRanges(). |result| receives the number
+// of bytes read into |buffer|, or -1 with errno-style failure.
+struct AAssetRange {
+    off64_t offset;
+    void* buffer;
+    size_t size;
+    ssize_t result;
+};
+
+typedef void (*AAsset_readRangesCallback)(AAsset* asset, AAssetRange* ranges, size_t count,
+                                          int status, void* data);
+
+namespace {
+
+ssize_t readRange(AAsset* asset, AAssetRange* range)
+{
+    std::unique_lock<std::mutex> lock(asset->mRangeLock);
+    if (!asset->mRangeFdChecked) {
+        asset->mRangeFdChecked = true;
+        asset->mRangeFd.reset(asset->mAsset->openFileDescriptor(&asset->mRangeFdStart,
+                                                                &asset->mRangeFdLength));
+    }
+
+    if (range->offset < 0) {
+        return -1;
+    }
+
+    if (asset->mRangeFd.ok()) {
+        const int fd = asset->mRangeFd.get();
+        const off64_t start = asset->mRangeFdStart;
+        const off64_t length = asset->mRangeFdLength;
+        lock.unlock();
+
+        if (range->offset >= length) {
+            return 0;
+        }
+        size_t remaining = std::min<off64_t>(range->size, length - range->offset);
+        uint8_t* out = static_cast<uint8_t*>(range->buffer);
+        off64_t pos = start + range->offset;
+        size_t total = 0;
+        while (remaining > 0) {
+            const ssize_t n = TEMP_FAILURE_RETRY(pread64(fd, out + total, remaining, pos));
+            if (n < 0) {
+                return -1;
+            }
+            if (n == 0) {
+                break;
+            }
+            total += n;
+            pos += n;
+            remaining -= n;
+        }
+        return total;
+    }
+
+    // Compressed asset: reuse its inflater, restoring the cursor afterwards so
+    // interleaved AAsset_read() calls are unaffected.
+    Asset* a = asset->mAsset.get();
+    const off64_t saved = a->seek(0, SEEK_CUR);
+    if (saved < 0 || a->seek(range->offset, SEEK_SET) < 0) {
+        return -1;
+    }
+    const ssize_t n = a->read(range->buffer, range->size);
+    a->seek(saved, SEEK_SET);
+    return n;
+}
+
+int readRanges(AAsset* asset, AAssetRange* ranges, size_t count)
+{
+    int status = 0;
+    for (size_t i = 0; i < count; i++) {
+        ranges[i].result = readRange(asset, &ranges[i]);
+        if (ranges[i].result < 0) {
+            status = -1;
+        }
+    }
+    return status;
+}
+
+// Serves AAsset_readRangesAsync() requests on a single background thread, so
+// inflating compressed assets never runs on the caller's thread.
+class RangeReader {
+public:
+    static RangeReader& get() {
+        static RangeReader* reader = new RangeReader();
+        return *reader;
+    }
+
+    void enqueue(std::function<void()> job) {
+        std::lock_guard<std::mutex> lock(mLock);
+        mJobs.push_back(std::move(job));
+        if (!mStarted) {
+            mStarted = true;
+            std::thread(&RangeReader::run, this).detach();
+        }
+        mCondition.notify_one();
+    }
+
+private:
+    void run() {
+        for (;;) {
+            std::function<void()> job;
+            {
+                std::unique_lock<std::mutex> lock(mLock);
+                mCondition.wait(lock, [this] { return !mJobs.empty(); });
+                job = std::move(mJobs.front());
+                mJobs.pop_front();
+            }
+            job();
+        }
+    }
+
+    std::mutex mLock;
+    std::condition_variable mCondition;
+    std::deque<std::function<void()>> mJobs;
+    bool mStarted = false;
+};
+
+} // namespace
+
 // -------------------- Public native C API --------------------
 
 /**
@@ -212,3 +352,22 @@ int AAsset_isAllocated(AAsset* asset)
 {
     return asset->mAsset->isAllocated() ? 1 : 0;
 }
+
+int AAsset_readRanges(AAsset* asset, AAssetRange* ranges, size_t count)
+{
+    return readRanges(asset, ranges, count);
+}
+
+int AAsset_readRangesAsync(AAsset* asset, AAssetRange* ranges, size_t count,
+                           AAsset_readRangesCallback callback, void* data)
+{
+    if (callback == nullptr) {
+        return -EINVAL;
+    }
+    // The asset and ranges must stay valid until the callback runs.
+    RangeReader::get().enqueue([=]() {
+        const int status = readRanges(asset, ranges, count);
+        callback(asset, ranges, count, status, data);
+    });
+    return 0;
+}
@@ -14,10 +14,102 @@
  * limitations under the License.
  */
 
+#include <apex/display.h>
 #include <private/android/choreographer.h>
 
+#include <log/log.h>
+
+#include <cstddef>
+
 using namespace android;
 
+// Number of frame timelines reported to extended frame callbacks. Timeline i
+// targets presenting i frames later than the earliest possible one.
+static constexpr size_t kFrameTimelinesLength = 3;
+
+struct AChoreographerFrameTimeline {
+    int64_t vsyncId;
+    int64_t expectedPresentTimeNanos;
+    int64_t deadlineNanos;
+};
+
+struct AChoreographerFrameCallbackData {
+    int64_t frameTimeNanos;
+    size_t preferredFrameTimelineIndex;
+    AChoreographerFrameTimeline frameTimelines[kFrameTimelinesLength];
+};
+
+typedef void (*AChoreographer_extendedFrameCallback)(const AChoreographerFrameCallbackData* data,
+                                                     void* callbackData);
+
+namespace {
+
+// Display timing used to predict the frame timelines. Choreographers are
+// per-thread, and so is this.
+struct FrameTimingState {
+    bool initialized = false;
+    int64_t vsyncPeriodNanos = 0;
+    int64_t appOffsetNanos = 0;
+    int64_t compositorOffsetNanos = 0;
+};
+
+thread_local FrameTimingState gFrameTiming;
+
+void updateFrameTiming(FrameTimingState* state) {
+    ADisplay** displays = nullptr;
+    const int count = ADisplay_acquirePhysicalDisplays(&displays);
+    for (int i = 0; i < count; i++) {
+        if (ADisplay_getDisplayType(displays[i]) != ADisplayType::DISPLAY_TYPE_INTERNAL) {
+            continue;
+        }
+        ADisplayConfig* config = nullptr;
+        if (ADisplay_getCurrentConfig(displays[i], &config) == 0 && config != nullptr) {
+            state->vsyncPeriodNanos =
+                    static_cast<int64_t>(1000000000 / ADisplayConfig_getFps(config));
+            state->appOffsetNanos = ADisplayConfig_getAppVsyncOffsetNanos(config);
+            state->compositorOffsetNanos = ADisplayConfig_getCompositorOffsetNanos(config);
+        }
+        break;
+    }
+    if (count > 0) {
+        ADisplay_release(displays);
+    }
+}
+
+void onRefreshRateChanged(int64_t /* vsyncPeriodNanos */, void* data) {
+    updateFrameTiming(static_cast<FrameTimingState*>(data));
+}
+
+struct ExtendedFrameCallback {
+    AChoreographer_extendedFrameCallback callback;
+    void* data;
+};
+
+void dispatchExtendedFrameCallback(int64_t frameTimeNanos, void* data) {
+    ExtendedFrameCallback* extended = static_cast<ExtendedFrameCallback*>(data);
+
+    AChoreographerFrameCallbackData callbackData;
+    callbackData.frameTimeNanos = frameTimeNanos;
+    callbackData.preferredFrameTimelineIndex = 0;
+
+    // A buffer drawn for the vsync at frameTimeNanos is latched by the
+    // compositor on the following vsync and shown on the one after that.
+    const int64_t period = gFrameTiming.vsyncPeriodNanos;
+    const int64_t vsyncNanos = frameTimeNanos - gFrameTiming.appOffsetNanos;
+    for (size_t i = 0; i < kFrameTimelinesLength; i++) {
+        AChoreographerFrameTimeline& timeline = callbackData.frameTimelines[i];
+        const int64_t targetVsyncNanos = vsyncNanos + static_cast<int64_t>(i + 1) * period;
+        timeline.vsyncId = period > 0 ? targetVsyncNanos / period : 0;
+        timeline.deadlineNanos = targetVsyncNanos + gFrameTiming.compositorOffsetNanos;
+        timeline.expectedPresentTimeNanos = targetVsyncNanos + period;
+    }
+
+    extended->callback(&callbackData, extended->data);
+    delete extended;
+}
+
+} // namespace
+
 AChoreographer* AChoreographer_getInstance() {
     return AChoreographer_routeGetInstance();
 }
@@ -50,3 +142,43 @@ void AChoreographer_unregisterRefreshRateCallback(AChoreographer* choreographer,
                                                   void* data) {
     return AChoreographer_routeUnregisterRefreshRateCallback(choreographer, callback, data);
 }
+
+void AChoreographer_postExtendedFrameCallback(AChoreographer* choreographer,
+                                              AChoreographer_extendedFrameCallback callback,
+                                              void* data) {
+    if (!gFrameTiming.initialized) {
+        gFrameTiming.initialized = true;
+        updateFrameTiming(&gFrameTiming);
+        AChoreographer_routeRegisterRefreshRateCallback(choreographer, onRefreshRateChanged,
+                                                        &gFrameTiming);
+    }
+    return AChoreographer_routePostFrameCallback64(choreographer, dispatchExtendedFrameCallback,
+                                                   new ExtendedFrameCallback{callback, data});
+}
+int64_t AChoreographerFrameCallbackData_getFrameTimeNanos(
+        const AChoreographerFrameCallbackData* data) {
+    return data->frameTimeNanos;
+}
+size_t AChoreographerFrameCallbackData_getFrameTimelinesLength(
+        const AChoreographerFrameCallbackData* /* data */) {
+    return kFrameTimelinesLength;
+}
+size_t AChoreographerFrameCallbackData_getPreferredFrameTimelineIndex(
+        const AChoreographerFrameCallbackData* data) {
+    return data->preferredFrameTimelineIndex;
+}
+int64_t AChoreographerFrameCallbackData_getFrameTimelineVsyncId(
+        const AChoreographerFrameCallbackData* data, size_t index) {
+    LOG_ALWAYS_FATAL_IF(index >= kFrameTimelinesLength, "Invalid frame timeline index %zu", index);
+    return data->frameTimelines[index].vsyncId;
+}
+int64_t AChoreographerFrameCallbackData_getFrameTimelineExpectedPresentTimeNanos(
+        const AChoreographerFrameCallbackData* data, size_t index) {
+    LOG_ALWAYS_FATAL_IF(index >= kFrameTimelinesLength, "Invalid frame timeline index %zu", index);
+    return data->frameTimelines[index].expectedPresentTimeNanos;
+}
+int64_t AChoreographerFrameCallbackData_getFrameTimelineDeadlineNanos(
+        const AChoreographerFrameCallbackData* data, size_t index) {
+    LOG_ALWAYS_FATAL_IF(index >= kFrameTimelinesLength, "Invalid frame timeline index %zu", index);
+    return data->frameTimelines[index].deadlineNanos;
+}
@@ -19,12 +19,120 @@
 
 #include <android/looper.h>
 #include <utils/Looper.h>
+#include <utils/Timers.h>
 #include <binder/IPCThreadState.h>
+#include <cutils/trace.h>
+
+#include <errno.h>
+#include <stdio.h>
+
+#include <algorithm>
+#include <atomic>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <vector>
 
 using android::Looper;
+using android::LooperCallback;
 using android::sp;
+using android::wp;
 using android::IPCThreadState;
 
+namespace {
+
+struct FdStats {
+    int64_t callbacks = 0;
+    nsecs_t totalNanos = 0;
+    nsecs_t maxNanos = 0;
+};
+
+// Statistics for one looper, shared with the callbacks that feed them so a
+// callback outliving ALooper_setStatsEnabled(false) still has somewhere to write.
+struct LooperStats {
+    std::mutex lock;
+    int64_t polls = 0;
+    int64_t callbacks = 0;
+    nsecs_t totalCallbackNanos = 0;
+    nsecs_t maxCallbackNanos = 0;
+    std::map<int, FdStats> fds;
+};
+
+struct LooperStatsEntry {
+    wp<Looper> looper;
+    std::shared_ptr<LooperStats> stats;
+};
+
+// Keeps the poll path free of locking while no looper collects statistics.
+std::atomic<int> gStatsLooperCount(0);
+std::mutex gStatsLock;
+std::map<Looper*, LooperStatsEntry> gStats;
+
+// Returns the statistics of |looper|, or null if they aren't being collected.
+std::shared_ptr<LooperStats> statsForLooper(Looper* looper) {
+    if (gStatsLooperCount.load(std::memory_order_relaxed) == 0) {
+        return nullptr;
+    }
+    std::lock_guard<std::mutex> lock(gStatsLock);
+    auto it = gStats.find(looper);
+    if (it == gStats.end()) {
+        return nullptr;
+    }
+    // The address may belong to a new looper if the old one went away.
+    if (it->second.looper.promote() == nullptr) {
+        gStats.erase(it);
+        gStatsLooperCount--;
+        return nullptr;
+    }
+    return it->second.stats;
+}
+
+// Times an ALooper_callbackFunc on behalf of a looper collecting statistics.
+class TimedLooperCallback : public LooperCallback {
+public:
+    TimedLooperCallback(ALooper_callbackFunc callback, std::shared_ptr<LooperStats> stats)
+            : mCallback(callback), mStats(std::move(stats)) {}
+
+    int handleEvent(int fd, int events, void* data) override {
+        const bool tracing = atrace_is_tag_enabled(ATRACE_TAG_APP);
+        if (tracing) {
+            char name[32];
+            snprintf(name, sizeof(name), "ALooper callback fd=%d", fd);
+            atrace_begin(ATRACE_TAG_APP, name);
+        }
+        const nsecs_t start = systemTime(SYSTEM_TIME_MONOTONIC);
+        int result = mCallback(fd, events, data);
+        const nsecs_t duration = systemTime(SYSTEM_TIME_MONOTONIC) - start;
+        if (tracing) {
+            atrace_end(ATRACE_TAG_APP);
+        }
+
+        std::lock_guard<std::mutex> lock(mStats->lock);
+        mStats->callbacks++;
+        mStats->totalCallbackNanos += duration;
+        mStats->maxCallbackNanos = std::max(mStats->maxCallbackNanos, duration);
+        FdStats& fdStats = mStats->fds[fd];
+        fdStats.callbacks++;
+        fdStats.totalNanos += duration;
+        fdStats.maxNanos = std::max(fdStats.maxNanos, duration);
+        return result;
+    }
+
+private:
+    ALooper_callbackFunc mCallback;
+    std::shared_ptr<LooperStats> mStats;
+};
+
+void countPoll(Looper* looper) {
+    std::shared_ptr<LooperStats> stats = statsForLooper(looper);
+    if (stats != nullptr) {
+        std::lock_guard<std::mutex> lock(stats->lock);
+        stats->polls++;
+    }
+}
+
+} // namespace
+
 static inline Looper* ALooper_to_Looper(ALooper* alooper) {
     return reinterpret_cast<Looper*>(alooper);
 }
@@ -57,7 +165,9 @@ int ALooper_pollOnce(int timeoutMillis, int* outFd, int* outEvents, void** outDa
     }
 
     IPCThreadState::self()->flushCommands();
-    return looper->pollOnce(timeoutMillis, outFd, outEvents, outData);
+    int result = looper->pollOnce(timeoutMillis, outFd, outEvents, outData);
+    countPoll(looper.get());
+    return result;
 }
 
 int ALooper_pollAll(int timeoutMillis, int* outFd, int* outEvents, void** outData) {
@@ -68,7 +178,9 @@ int ALooper_pollAll(int timeoutMillis, int* outFd, int* outEvents, void** outDat
     }
 
     IPCThreadState::self()->flushCommands();
-    return looper->pollAll(timeoutMillis, outFd, outEvents, outData);
+    int result = looper->pollAll(timeoutMillis, outFd, outEvents, outData);
+    countPoll(looper.get());
+    return result;
 }
 
 void ALooper_wake(ALooper* looper) {
@@ -77,9 +189,100 @@ void ALooper_wake(ALooper* looper) {
 
 int ALooper_addFd(ALooper* looper, int fd, int ident, int events,
         ALooper_callbackFunc callback, void* data) {
+    if (callback != nullptr) {
+        std::shared_ptr<LooperStats> stats = statsForLooper(ALooper_to_Looper(looper));
+        if (stats != nullptr) {
+            return ALooper_to_Looper(looper)->addFd(fd, ident, events,
+                    new TimedLooperCallback(callback, std::move(stats)), data);
+        }
+    }
     return ALooper_to_Looper(looper)->addFd(fd, ident, events, callback, data);
 }
 
 int ALooper_removeFd(ALooper* looper, int fd) {
     return ALooper_to_Looper(looper)->removeFd(fd);
 }
+
+/**
+ * Starts or stops collecting statistics for the looper. Only callbacks added
+ * with ALooper_addFd() while collection is enabled are timed, and polls are
+ * counted only when made through ALooper_pollOnce() or ALooper_pollAll().
+ * Disabling collection discards the statistics gathered so far.
+ *
+ * While enabled, each timed callback is also shown as a trace section in app
+ * traces.
+ *
+ * Returns 0 on success.
+ */
+int ALooper_setStatsEnabled(ALooper* looper, bool enabled) {
+    Looper* l = ALooper_to_Looper(looper);
+    std::lock_guard<std::mutex> lock(gStatsLock);
+    auto it = gStats.find(l);
+    if (it != gStats.end() && it->second.looper.promote() == nullptr) {
+        gStats.erase(it);
+        gStatsLooperCount--;
+        it = gStats.end();
+    }
+    if (enabled && it == gStats.end()) {
+        gStats[l] = LooperStatsEntry{l, std::make_shared<LooperStats>()};
+        gStatsLooperCount++;
+    } else if (!enabled && it != gStats.end()) {
+        gStats.erase(it);
+        gStatsLooperCount--;
+    }
+    return 0;
+}
+
+/**
+ * Reads the statistics collected for the looper: the number of polls, the
+ * number of timed callbacks, their total run time and the run time of the
+ * slowest one, in nanoseconds. Any of the out parameters may be null.
+ *
+ * Returns 0 on success or -EINVAL if statistics are not enabled.
+ */
+int ALooper_getStats(ALooper* looper, int64_t* outPolls, int64_t* outCallbacks,
+        int64_t* outCallbackNanos, int64_t* outMaxCallbackNanos) {
+    std::shared_ptr<LooperStats> stats = statsForLooper(ALooper_to_Looper(looper));
+    if (stats == nullptr) {
+        return -EINVAL;
+    }
+    std::lock_guard<std::mutex> lock(stats->lock);
+    if (outPolls != nullptr) *outPolls = stats->polls;
+    if (outCallbacks != nullptr) *outCallbacks = stats->callbacks;
+    if (outCallbackNanos != nullptr) *outCallbackNanos = stats->totalCallbackNanos;
+    if (outMaxCallbackNanos != nullptr) *outMaxCallbackNanos = stats->maxCallbackNanos;
+    return 0;
+}
+
+/**
+ * Fills outFds with up to maxCount of the looper's fds whose callbacks ran
+ * the longest, slowest first. outMaxCallbackNanos and outCallbacks, if not
+ * null, receive each fd's slowest callback run time and callback count.
+ *
+ * Returns the number of fds written or -EINVAL if statistics are not enabled.
+ */
+int ALooper_getSlowestFds(ALooper* looper, int* outFds, int64_t* outMaxCallbackNanos,
+        int64_t* outCallbacks, int maxCount) {
+    if (outFds == nullptr || maxCount < 0) {
+        return -EINVAL;
+    }
+    std::shared_ptr<LooperStats> stats = statsForLooper(ALooper_to_Looper(looper));
+    if (stats == nullptr) {
+        return -EINVAL;
+    }
+
+    std::vector<std::pair<int, FdStats>> fds;
+    {
+        std::lock_guard<std::mutex> lock(stats->lock);
+        fds.assign(stats->fds.begin(), stats->fds.end());
+    }
+    const size_t count = std::min(fds.size(), static_cast<size_t>(maxCount));
+    std::partial_sort(fds.begin(), fds.begin() + count, fds.end(),
+            [](const auto& a, const auto& b) { return a.second.maxNanos > b.second.maxNanos; });
+    for (size_t i = 0; i < count; i++) {
+        outFds[i] = fds[i].first;
+        if (outMaxCallbackNanos != nullptr) outMaxCallbackNanos[i] = fds[i].second.maxNanos;
+        if (outCallbacks != nullptr) outCallbacks[i] = fds[i].second.callbacks;
+    }
+    return count;
+}
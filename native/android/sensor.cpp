@@ -29,7 +29,14 @@
 #include <utils/Timers.h>
 #include <vndk/hardware_buffer.h>
 
+#include <errno.h>
 #include <poll.h>
+#include <string.h>
+#include <sys/timerfd.h>
+#include <unistd.h>
+
+#include <map>
+#include <mutex>
 
 using android::sp;
 using android::Sensor;
@@ -61,6 +68,56 @@ using android::String16;
         } \
     } while (false)
 
+/*****************************************************************************/
+
+namespace {
+
+// How an event queue's looper callback is delivered. By default the sensor fd
+// itself is on the looper and every batch sensorservice writes wakes it up.
+// With a delivery interval set, a timerfd takes its place and pending events
+// are handed to the callback at most once per interval.
+struct QueueDelivery {
+    ALooper* looper;
+    int ident;
+    ALooper_callbackFunc callback;
+    void* data;
+    int timerFd = -1;
+};
+
+std::mutex gDeliveryLock;
+std::map<ASensorEventQueue*, QueueDelivery> gDeliveries;
+
+int deliverPendingEvents(int fd, int /* events */, void* data) {
+    ASensorEventQueue* queue = static_cast<ASensorEventQueue*>(data);
+    uint64_t expirations;
+    if (read(fd, &expirations, sizeof(expirations)) < 0 && errno != EAGAIN) {
+        ALOGE("Failed to read delivery timer: %s", strerror(errno));
+    }
+
+    ALooper_callbackFunc callback;
+    void* callbackData;
+    {
+        std::lock_guard<std::mutex> lock(gDeliveryLock);
+        auto it = gDeliveries.find(queue);
+        if (it == gDeliveries.end() || it->second.timerFd != fd) {
+            return 0;
+        }
+        callback = it->second.callback;
+        callbackData = it->second.data;
+    }
+
+    if (ASensorEventQueue_hasEvents(queue) <= 0) {
+        return 1;
+    }
+    // Hand the callback the sensor fd, as it would get without an interval.
+    // If it returns 0 the looper drops the timer; the fd itself is closed
+    // when the queue is destroyed.
+    const int sensorFd = static_cast<SensorEventQueue*>(queue)->getFd();
+    return callback(sensorFd, ALOOPER_EVENT_INPUT, callbackData);
+}
+
+} // namespace
+
 ASensorManager* ASensorManager_getInstance() {
     return ASensorManager_getInstanceForPackage(nullptr);
 }
@@ -114,6 +171,10 @@ ASensorEventQueue* ASensorManager_createEventQueue(ASensorManager* manager,
             static_cast<SensorManager*>(manager)->createEventQueue();
     if (queue != 0) {
         ALooper_addFd(looper, queue->getFd(), ident, ALOOPER_EVENT_INPUT, callback, data);
+        {
+            std::lock_guard<std::mutex> lock(gDeliveryLock);
+            gDeliveries[queue.get()] = QueueDelivery{looper, ident, callback, data};
+        }
         queue->looper = looper;
         queue->requestAdditionalInfo = false;
         queue->incStrong(manager);
@@ -127,6 +188,17 @@ int ASensorManager_destroyEventQueue(ASensorManager* manager, ASensorEventQueue*
 
     sp<SensorEventQueue> q = static_cast<SensorEventQueue*>(queue);
     ALooper_removeFd(q->looper, q->getFd());
+    {
+        std::lock_guard<std::mutex> lock(gDeliveryLock);
+        auto it = gDeliveries.find(queue);
+        if (it != gDeliveries.end()) {
+            if (it->second.timerFd >= 0) {
+                ALooper_removeFd(q->looper, it->second.timerFd);
+                close(it->second.timerFd);
+            }
+            gDeliveries.erase(it);
+        }
+    }
     q->decStrong(manager);
     return 0;
 }
@@ -290,6 +362,63 @@ int ASensorEventQueue_requestAdditionalInfoEvents(ASensorEventQueue* queue, bool
     return android::OK;
 }
 
+int ASensorEventQueue_setDeliveryInterval(ASensorEventQueue* queue, int64_t intervalUs) {
+    RETURN_IF_QUEUE_IS_NULL(android::BAD_VALUE);
+    if (intervalUs < 0) {
+        ERROR_INVALID_PARAMETER("intervalUs cannot be negative");
+        return android::BAD_VALUE;
+    }
+
+    std::lock_guard<std::mutex> lock(gDeliveryLock);
+    auto it = gDeliveries.find(queue);
+    if (it == gDeliveries.end()) {
+        ERROR_INVALID_PARAMETER("queue was not created by ASensorManager_createEventQueue");
+        return android::BAD_VALUE;
+    }
+    QueueDelivery& delivery = it->second;
+    if (delivery.callback == nullptr) {
+        // Without a callback the looper hands our timer's ident to the app,
+        // which has no way to drain the timer.
+        ERROR_INVALID_PARAMETER("delivery intervals require a looper callback");
+        return android::INVALID_OPERATION;
+    }
+    const int sensorFd = static_cast<SensorEventQueue*>(queue)->getFd();
+
+    if (intervalUs == 0) {
+        if (delivery.timerFd >= 0) {
+            ALooper_removeFd(delivery.looper, delivery.timerFd);
+            close(delivery.timerFd);
+            delivery.timerFd = -1;
+            ALooper_addFd(delivery.looper, sensorFd, delivery.ident, ALOOPER_EVENT_INPUT,
+                          delivery.callback, delivery.data);
+        }
+        return android::OK;
+    }
+
+    if (delivery.timerFd < 0) {
+        delivery.timerFd = timerfd_create(CLOCK_MONOTONIC, TFD_NONBLOCK | TFD_CLOEXEC);
+        if (delivery.timerFd < 0) {
+            const int err = errno;
+            ALOGE("Failed to create delivery timer: %s", strerror(err));
+            return -err;
+        }
+        ALooper_removeFd(delivery.looper, sensorFd);
+        ALooper_addFd(delivery.looper, delivery.timerFd, delivery.ident, ALOOPER_EVENT_INPUT,
+                      deliverPendingEvents, queue);
+    }
+
+    struct itimerspec spec = {};
+    spec.it_interval.tv_sec = intervalUs / 1000000;
+    spec.it_interval.tv_nsec = (intervalUs % 1000000) * 1000;
+    spec.it_value = spec.it_interval;
+    if (timerfd_settime(delivery.timerFd, 0, &spec, nullptr) != 0) {
+        const int err = errno;
+        ALOGE("Failed to arm delivery timer: %s", strerror(err));
+        return -err;
+    }
+    return android::OK;
+}
+
 /*****************************************************************************/
 
 const char* ASensor_getName(ASensor const* sensor) {
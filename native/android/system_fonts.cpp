@@ -23,6 +23,7 @@
 #include <android/system_fonts.h>
 
 #include <memory>
+#include <mutex>
 #include <string>
 #include <vector>
 
@@ -54,7 +55,7 @@ struct ParserState {
     XmlCharUniquePtr mLocale;
 };
 
-struct ASystemFontIterator {
+struct FontXmlParser {
     XmlDocUniquePtr mXmlDoc;
     ParserState state;
 
@@ -71,6 +72,27 @@ struct AFont {
     std::vector<std::pair<uint32_t, float>> mAxes;
 };
 
+// The parsed system font list, shared by all iterators until the font
+// configuration files change.
+struct SystemFontList {
+    struct FileStamp {
+        bool exists = false;
+        dev_t dev = 0;
+        ino_t ino = 0;
+        off_t size = 0;
+        struct timespec mtime = {};
+    };
+
+    FileStamp mConfigStamp;
+    FileStamp mCustomizationStamp;
+    std::vector<std::unique_ptr<AFont>> mFonts;
+};
+
+struct ASystemFontIterator {
+    std::shared_ptr<const SystemFontList> mFontList;
+    size_t mNextIndex = 0;
+};
+
 struct AFontMatcher {
     minikin::FontStyle mFontStyle;
     uint32_t mLocaleListId = 0;  // 0 is reserved for empty locale ID.
@@ -210,12 +232,64 @@ bool findFirstFontNode(const XmlDocUniquePtr& doc, ParserState* state) {
     return font != nullptr;
 }
 
+const char* const FONT_CONFIG_PATH = "/system/etc/fonts.xml";
+const char* const FONT_CUSTOMIZATION_PATH = "/product/etc/fonts_customization.xml";
+
+SystemFontList::FileStamp stampFile(const char* path) {
+    SystemFontList::FileStamp stamp;
+    struct stat st = {};
+    if (stat(path, &st) == 0) {
+        stamp.exists = true;
+        stamp.dev = st.st_dev;
+        stamp.ino = st.st_ino;
+        stamp.size = st.st_size;
+        stamp.mtime = st.st_mtim;
+    }
+    return stamp;
+}
+
+bool sameStamp(const SystemFontList::FileStamp& a, const SystemFontList::FileStamp& b) {
+    return a.exists == b.exists && a.dev == b.dev && a.ino == b.ino && a.size == b.size &&
+            a.mtime.tv_sec == b.mtime.tv_sec && a.mtime.tv_nsec == b.mtime.tv_nsec;
+}
+
+AFont* nextFontFromXml(FontXmlParser* ite);
+
+// Returns the cached font list, re-parsing the XML only when either config
+// file was replaced or modified since the last parse.
+std::shared_ptr<const SystemFontList> getSystemFontList() {
+    static std::mutex sLock;
+    static std::shared_ptr<const SystemFontList> sFontList;
+
+    SystemFontList::FileStamp configStamp = stampFile(FONT_CONFIG_PATH);
+    SystemFontList::FileStamp customizationStamp = stampFile(FONT_CUSTOMIZATION_PATH);
+
+    std::lock_guard<std::mutex> lock(sLock);
+    if (sFontList && sameStamp(sFontList->mConfigStamp, configStamp) &&
+            sameStamp(sFontList->mCustomizationStamp, customizationStamp)) {
+        return sFontList;
+    }
+
+    auto list = std::make_shared<SystemFontList>();
+    list->mConfigStamp = configStamp;
+    list->mCustomizationStamp = customizationStamp;
+
+    FontXmlParser parser;
+    parser.mXmlDoc.reset(xmlReadFile(FONT_CONFIG_PATH, nullptr, 0));
+    parser.mCustomizationXmlDoc.reset(xmlReadFile(FONT_CUSTOMIZATION_PATH, nullptr, 0));
+    while (AFont* font = nextFontFromXml(&parser)) {
+        list->mFonts.emplace_back(font);
+    }
+
+    sFontList = std::move(list);
+    return sFontList;
+}
+
 }  // namespace
 
 ASystemFontIterator* ASystemFontIterator_open() {
     std::unique_ptr<ASystemFontIterator> ite(new ASystemFontIterator());
-    ite->mXmlDoc.reset(xmlReadFile("/system/etc/fonts.xml", nullptr, 0));
-    ite->mCustomizationXmlDoc.reset(xmlReadFile("/product/etc/fonts_customization.xml", nullptr, 0));
+    ite->mFontList = getSystemFontList();
     return ite.release();
 }
 
@@ -306,8 +380,9 @@ bool findNextFontNode(const XmlDocUniquePtr& xmlDoc, ParserState* state) {
     }
 }
 
-AFont* ASystemFontIterator_next(ASystemFontIterator* ite) {
-    LOG_ALWAYS_FATAL_IF(ite == nullptr, "nullptr has passed as iterator argument");
+namespace {
+
+AFont* nextFontFromXml(FontXmlParser* ite) {
     if (ite->mXmlDoc) {
         if (!findNextFontNode(ite->mXmlDoc, &ite->state)) {
             // Reached end of the XML file. Continue OEM customization.
@@ -316,7 +391,7 @@ AFont* ASystemFontIterator_next(ASystemFontIterator* ite) {
             std::unique_ptr<AFont> font = std::make_unique<AFont>();
             copyFont(ite->mXmlDoc, ite->state, font.get(), "/system/fonts/");
             if (!isFontFileAvailable(font->mFilePath)) {
-                return ASystemFontIterator_next(ite);
+                return nextFontFromXml(ite);
             }
             return font.release();
         }
@@ -331,7 +406,7 @@ AFont* ASystemFontIterator_next(ASystemFontIterator* ite) {
             std::unique_ptr<AFont> font = std::make_unique<AFont>();
             copyFont(ite->mCustomizationXmlDoc, ite->state, font.get(), "/product/fonts/");
             if (!isFontFileAvailable(font->mFilePath)) {
-                return ASystemFontIterator_next(ite);
+                return nextFontFromXml(ite);
             }
             return font.release();
         }
@@ -339,6 +414,24 @@ AFont* ASystemFontIterator_next(ASystemFontIterator* ite) {
     return nullptr;
 }
 
+}  // namespace
+
+AFont* ASystemFontIterator_next(ASystemFontIterator* ite) {
+    LOG_ALWAYS_FATAL_IF(ite == nullptr, "nullptr has passed as iterator argument");
+    if (ite->mNextIndex >= ite->mFontList->mFonts.size()) {
+        return nullptr;
+    }
+    const AFont& cached = *ite->mFontList->mFonts[ite->mNextIndex++];
+    std::unique_ptr<AFont> font = std::make_unique<AFont>();
+    font->mFilePath = cached.mFilePath;
+    font->mLocale.reset(cached.mLocale ? new std::string(*cached.mLocale) : nullptr);
+    font->mWeight = cached.mWeight;
+    font->mItalic = cached.mItalic;
+    font->mCollectionIndex = cached.mCollectionIndex;
+    font->mAxes = cached.mAxes;
+    return font.release();
+}
+
 void AFont_close(AFont* font) {
     delete font;
 }
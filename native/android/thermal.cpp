@@ -17,6 +17,8 @@
 #define LOG_TAG "thermal"
 
 #include <cerrno>
+#include <chrono>
+#include <cmath>
 #include <thread>
 
 #include <android/thermal.h>
@@ -30,6 +32,13 @@ using android::sp;
 using namespace android;
 using namespace android::os;
 
+// The thermal service refuses headroom requests that come in more often than
+// this, so answers are reused for repeated queries within the window.
+static constexpr std::chrono::seconds kHeadroomMinInterval(1);
+
+// Longest forecast horizon the thermal service supports.
+static constexpr int kMaxHeadroomForecastSeconds = 60;
+
 struct ThermalServiceListener : public BnThermalStatusListener {
     public:
         virtual binder::Status onStatusChange(int32_t status) override;
@@ -52,12 +61,17 @@ struct AThermalManager {
         status_t getCurrentThermalStatus(int32_t *status);
         status_t addListener(AThermal_StatusCallback, void *data);
         status_t removeListener(AThermal_StatusCallback, void *data);
+        status_t getThermalHeadroom(int32_t forecastSeconds, float *result);
    private:
        AThermalManager(sp<IThermalService> service);
        sp<IThermalService> mThermalSvc;
        sp<ThermalServiceListener> mServiceListener;
        std::vector<ListenerCallback> mListeners;
        std::mutex mMutex;
+       std::mutex mHeadroomMutex;
+       std::chrono::steady_clock::time_point mLastHeadroomTime;
+       int32_t mLastHeadroomForecast = -1;
+       float mLastHeadroom = NAN;
 };
 
 binder::Status ThermalServiceListener::onStatusChange(int32_t status) {
@@ -184,6 +198,34 @@ status_t AThermalManager::getCurrentThermalStatus(int32_t *status) {
     return OK;
 }
 
+status_t AThermalManager::getThermalHeadroom(int32_t forecastSeconds, float *result) {
+    std::unique_lock<std::mutex> lock(mHeadroomMutex);
+
+    const auto now = std::chrono::steady_clock::now();
+    if (forecastSeconds == mLastHeadroomForecast &&
+            now - mLastHeadroomTime < kHeadroomMinInterval) {
+        *result = mLastHeadroom;
+        return OK;
+    }
+
+    // The service forecasts from its recent skin temperature history.
+    binder::Status ret = mThermalSvc->getThermalHeadroom(forecastSeconds, result);
+    if (!ret.isOk()) {
+        if (ret.exceptionCode() == binder::Status::EX_SECURITY) {
+            return EPERM;
+        }
+        return EPIPE;
+    }
+    // Rate-limited or unsupported requests come back as NaN; don't let them
+    // replace a good cached value.
+    if (!std::isnan(*result)) {
+        mLastHeadroomTime = now;
+        mLastHeadroomForecast = forecastSeconds;
+        mLastHeadroom = *result;
+    }
+    return OK;
+}
+
 /**
   * Acquire an instance of the thermal manager. This must be freed using
   * {@link AThermal_releaseManager}.
@@ -259,3 +301,34 @@ int AThermal_unregisterThermalStatusListener(AThermalManager *manager,
         AThermal_StatusCallback callback, void *data) {
     return manager->removeListener(callback, data);
 }
+
+/**
+ * Provides an estimate of how much thermal headroom the device will have
+ * forecastSeconds from now, before hitting severe throttling. The value is
+ * normalized so that 1.0 corresponds to ATHERMAL_STATUS_SEVERE and 0.0 to no
+ * thermal load; it is forecast from the device's recent temperature history,
+ * so callers can scale down their workload before throttling starts.
+ *
+ * Repeated calls with the same forecastSeconds within a second return the
+ * previous estimate instead of querying the thermal service again.
+ *
+ * @param manager The manager instance to use to query the headroom,
+ * acquired by {@link AThermal_acquireManager}.
+ * @param forecastSeconds How many seconds into the future to forecast, 0 for
+ * the current headroom. At most 60.
+ *
+ * @return the predicted headroom, or NaN if forecastSeconds is out of range,
+ *         the device doesn't support headroom forecasts, or the thermal
+ *         service could not be reached.
+ */
+float AThermal_getThermalHeadroom(AThermalManager *manager, int forecastSeconds) {
+    if (forecastSeconds < 0 || forecastSeconds > kMaxHeadroomForecastSeconds) {
+        return NAN;
+    }
+    float result = NAN;
+    status_t ret = manager->getThermalHeadroom(forecastSeconds, &result);
+    if (ret != OK) {
+        return NAN;
+    }
+    return result;
+}
@@ -17,10 +17,15 @@
 #define LOG_TAG "PacProcessor"
 
 #include <stdlib.h>
+#include <memory>
+#include <mutex>
 #include <string>
+#include <unordered_map>
+#include <vector>
 
 #include <utils/Log.h>
 #include <utils/Mutex.h>
+#include <utils/Timers.h>
 #include "android_runtime/AndroidRuntime.h"
 
 #include "jni.h"
@@ -30,8 +35,44 @@
 
 namespace android {
 
-ProxyResolverV8Handle* proxyResolver = NULL;
-bool pacSet = false;
+// Up to this many isolated resolver contexts are kept warm so that lookups
+// from different connections don't queue behind each other.
+static constexpr size_t kMaxResolvers = 4;
+
+// FindProxyForURL may consult the clock, DNS and the local address, so results
+// are only reused for a short while.
+static constexpr nsecs_t kResultCacheTtl = s2ns(10);
+static constexpr size_t kMaxCachedResults = 256;
+
+struct Resolver {
+    Resolver() : handle(ProxyResolverV8Handle_new()) {}
+    ~Resolver() { ProxyResolverV8Handle_delete(handle); }
+
+    std::mutex lock;
+    ProxyResolverV8Handle* handle;
+    // Generation of the script loaded into this context, 0 if none.
+    uint32_t scriptGeneration = 0;
+};
+
+struct CachedResult {
+    std::u16string proxies;
+    nsecs_t expiry;
+};
+
+// Guards the resolver pool and the current script. Resolvers are shared so a
+// lookup in flight keeps its context alive across destroyV8ParserNativeLocked.
+static std::mutex gResolverLock;
+static std::vector<std::shared_ptr<Resolver>> gResolvers;
+static size_t gNextResolver = 0;
+static std::u16string gScript;
+static bool gScriptSet = false;
+// Bumped whenever the script changes or the parser is torn down, so stale
+// contexts reload the script and stale lookups aren't cached.
+static uint32_t gScriptGeneration = 0;
+
+static std::mutex gCacheLock;
+static std::unordered_map<std::u16string, CachedResult> gResultCache;
+static uint32_t gCacheGeneration = 0;
 
 std::u16string jstringToString16(JNIEnv* env, jstring jstr) {
     const jchar* str = env->GetStringCritical(jstr, 0);
@@ -48,11 +89,121 @@ jstring string16ToJstring(JNIEnv* env, std::u16string string) {
     return env->NewString(reinterpret_cast<const jchar*>(str), len);
 }
 
+static std::u16string resultCacheKey(const std::u16string& url, const std::u16string& host) {
+    std::u16string key(url);
+    key.push_back(u'\0');
+    key.append(host);
+    return key;
+}
+
+static bool lookupCachedResult(const std::u16string& key, std::u16string* outProxies) {
+    std::lock_guard<std::mutex> lock(gCacheLock);
+    auto it = gResultCache.find(key);
+    if (it == gResultCache.end()) {
+        return false;
+    }
+    if (it->second.expiry <= systemTime(SYSTEM_TIME_MONOTONIC)) {
+        gResultCache.erase(it);
+        return false;
+    }
+    *outProxies = it->second.proxies;
+    return true;
+}
+
+static void storeCachedResult(uint32_t generation, std::u16string key, std::u16string proxies) {
+    std::lock_guard<std::mutex> lock(gCacheLock);
+    // The script changed while this lookup was running.
+    if (generation != gCacheGeneration) {
+        return;
+    }
+    const nsecs_t now = systemTime(SYSTEM_TIME_MONOTONIC);
+    if (gResultCache.size() >= kMaxCachedResults) {
+        for (auto it = gResultCache.begin(); it != gResultCache.end();) {
+            it = it->second.expiry <= now ? gResultCache.erase(it) : std::next(it);
+        }
+        if (gResultCache.size() >= kMaxCachedResults) {
+            gResultCache.clear();
+        }
+    }
+    gResultCache[std::move(key)] = {std::move(proxies), now + kResultCacheTtl};
+}
+
+static void clearResultCache(uint32_t generation) {
+    std::lock_guard<std::mutex> lock(gCacheLock);
+    gResultCache.clear();
+    gCacheGeneration = generation;
+}
+
+// Must be called with gResolverLock held.
+static uint32_t nextScriptGenerationLocked() {
+    // Resolvers use generation 0 for "no script loaded".
+    if (++gScriptGeneration == 0) {
+        gScriptGeneration = 1;
+    }
+    return gScriptGeneration;
+}
+
+// Returns a resolver locked by |outLock| with the current script loaded, or
+// null if the parser isn't running or no script has been set.
+static std::shared_ptr<Resolver> acquireResolver(std::unique_lock<std::mutex>* outLock) {
+    std::shared_ptr<Resolver> resolver;
+    std::u16string script;
+    uint32_t generation;
+    {
+        std::lock_guard<std::mutex> lock(gResolverLock);
+        if (gResolvers.empty() || !gScriptSet) {
+            return nullptr;
+        }
+        for (const auto& candidate : gResolvers) {
+            std::unique_lock<std::mutex> candidateLock(candidate->lock, std::try_to_lock);
+            if (candidateLock.owns_lock()) {
+                resolver = candidate;
+                *outLock = std::move(candidateLock);
+                break;
+            }
+        }
+        if (resolver == nullptr && gResolvers.size() < kMaxResolvers) {
+            resolver = std::make_shared<Resolver>();
+            *outLock = std::unique_lock<std::mutex>(resolver->lock);
+            gResolvers.push_back(resolver);
+        }
+        if (resolver == nullptr) {
+            resolver = gResolvers[gNextResolver++ % gResolvers.size()];
+        }
+        generation = gScriptGeneration;
+        if (outLock->owns_lock() && resolver->scriptGeneration != generation) {
+            script = gScript;
+        }
+    }
+
+    // Every context is busy; wait for one outside the pool lock.
+    if (!outLock->owns_lock()) {
+        *outLock = std::unique_lock<std::mutex>(resolver->lock);
+        std::lock_guard<std::mutex> lock(gResolverLock);
+        generation = gScriptGeneration;
+        if (resolver->scriptGeneration != generation) {
+            script = gScript;
+        }
+    }
+
+    if (resolver->scriptGeneration != generation) {
+        if (ProxyResolverV8Handle_SetPacScript(resolver->handle, script.data()) != OK) {
+            ALOGE("Unable to set PAC script");
+            outLock->unlock();
+            return nullptr;
+        }
+        resolver->scriptGeneration = generation;
+    }
+    return resolver;
+}
+
 static jboolean com_android_pacprocessor_PacNative_createV8ParserNativeLocked(JNIEnv* /* env */,
         jobject) {
-    if (proxyResolver == NULL) {
-        proxyResolver = ProxyResolverV8Handle_new();
-        pacSet = false;
+    std::lock_guard<std::mutex> lock(gResolverLock);
+    if (gResolvers.empty()) {
+        gResolvers.push_back(std::make_shared<Resolver>());
+        gScript.clear();
+        gScriptSet = false;
         return JNI_FALSE;
     }
     return JNI_TRUE;
@@ -60,58 +211,94 @@ static jboolean com_android_pacprocessor_PacNative_createV8ParserNativeLocked(JN
 
 static jboolean com_android_pacprocessor_PacNative_destroyV8ParserNativeLocked(JNIEnv* /* env */,
         jobject) {
-    if (proxyResolver != NULL) {
-        ProxyResolverV8Handle_delete(proxyResolver);
-        proxyResolver = NULL;
-        return JNI_FALSE;
+    std::vector<std::shared_ptr<Resolver>> resolvers;
+    uint32_t generation;
+    {
+        std::lock_guard<std::mutex> lock(gResolverLock);
+        if (gResolvers.empty()) {
+            return JNI_TRUE;
+        }
+        resolvers.swap(gResolvers);
+        gScript.clear();
+        gScriptSet = false;
+        generation = nextScriptGenerationLocked();
     }
-    return JNI_TRUE;
+    clearResultCache(generation);
+    return JNI_FALSE;
 }
 
 static jboolean com_android_pacprocessor_PacNative_setProxyScriptNativeLocked(JNIEnv* env, jobject,
         jstring script) {
     std::u16string script16 = jstringToString16(env, script);
 
-    if (proxyResolver == NULL) {
-        ALOGE("V8 Parser not started when setting PAC script");
-        return JNI_TRUE;
+    std::shared_ptr<Resolver> resolver;
+    std::unique_lock<std::mutex> resolverLock;
+    {
+        std::lock_guard<std::mutex> lock(gResolverLock);
+        if (gResolvers.empty()) {
+            ALOGE("V8 Parser not started when setting PAC script");
+            return JNI_TRUE;
+        }
+        resolver = gResolvers[0];
     }
 
-    if (ProxyResolverV8Handle_SetPacScript(proxyResolver, script16.data()) != OK) {
+    // Load the script into one context up front so a broken script is
+    // reported here; the other contexts pick it up on their next lookup.
+    resolverLock = std::unique_lock<std::mutex>(resolver->lock);
+    if (ProxyResolverV8Handle_SetPacScript(resolver->handle, script16.data()) != OK) {
         ALOGE("Unable to set PAC script");
         return JNI_TRUE;
     }
-    pacSet = true;
+
+    uint32_t generation;
+    {
+        std::lock_guard<std::mutex> lock(gResolverLock);
+        gScript = std::move(script16);
+        gScriptSet = true;
+        generation = nextScriptGenerationLocked();
+        resolver->scriptGeneration = generation;
+    }
+    clearResultCache(generation);
 
     return JNI_FALSE;
 }
 
-static jstring com_android_pacprocessor_PacNative_makeProxyRequestNativeLocked(JNIEnv* env, jobject,
+static jstring com_android_pacprocessor_PacNative_makeProxyRequestNative(JNIEnv* env, jobject,
         jstring url, jstring host) {
     std::u16string url16 = jstringToString16(env, url);
     std::u16string host16 = jstringToString16(env, host);
+    std::u16string key = resultCacheKey(url16, host16);
 
-    if (proxyResolver == NULL) {
-        ALOGE("V8 Parser not initialized when running PAC script");
-        return NULL;
+    std::u16string proxies;
+    if (lookupCachedResult(key, &proxies)) {
+        return string16ToJstring(env, proxies);
     }
 
-    if (!pacSet) {
-        ALOGW("Attempting to run PAC with no script set");
+    std::unique_lock<std::mutex> resolverLock;
+    std::shared_ptr<Resolver> resolver = acquireResolver(&resolverLock);
+    if (resolver == nullptr) {
+        ALOGW("Attempting to run PAC with no parser or script set");
         return NULL;
     }
+    const uint32_t generation = resolver->scriptGeneration;
 
     std::unique_ptr<char16_t, decltype(&free)> result = std::unique_ptr<char16_t, decltype(&free)>(
-        ProxyResolverV8Handle_GetProxyForURL(proxyResolver, url16.data(), host16.data()), &free);
+        ProxyResolverV8Handle_GetProxyForURL(resolver->handle, url16.data(), host16.data()),
+        &free);
+    resolverLock.unlock();
     if (result.get() == NULL) {
         ALOGE("Error Running PAC");
         return NULL;
     }
 
-    std::u16string ret(result.get());
-    jstring jret = string16ToJstring(env, ret);
+    proxies = result.get();
+    storeCachedResult(generation, std::move(key), proxies);
+    return string16ToJstring(env, proxies);
+}
 
-    return jret;
+static jstring com_android_pacprocessor_PacNative_makeProxyRequestNativeLocked(JNIEnv* env,
+        jobject obj, jstring url, jstring host) {
+    return com_android_pacprocessor_PacNative_makeProxyRequestNative(env, obj, url, host);
 }
 
 static const JNINativeMethod gMethods[] = {
@@ -123,6 +310,8 @@ static const JNINativeMethod gMethods[] = {
         (void*)com_android_pacprocessor_PacNative_setProxyScriptNativeLocked},
     { "makeProxyRequestNativeLocked", "(Ljava/lang/String;Ljava/lang/String;)Ljava/lang/String;",
         (void*)com_android_pacprocessor_PacNative_makeProxyRequestNativeLocked},
+    { "makeProxyRequestNative", "(Ljava/lang/String;Ljava/lang/String;)Ljava/lang/String;",
+        (void*)com_android_pacprocessor_PacNative_makeProxyRequestNative},
 };
 
 int register_com_android_pacprocessor_PacNative(JNIEnv* env) {
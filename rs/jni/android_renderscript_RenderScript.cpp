@@ -1596,6 +1596,159 @@ nAllocationRead3D(JNIEnv *_env, jobject _this, jlong con, jlong _alloc, jint xof
                    (RsContext)con, alloc, xoff, yoff, zoff, lod, w, h, d, ptr, sizeBytes, 0);
 }
 
+// Returns the address of bytes [offset, offset + sizeBytes) of the direct
+// ByteBuffer data, or nullptr if data is not a direct buffer or is too small.
+static void*
+getDirectBufferRange(JNIEnv *_env, jobject data, jint offset, jint sizeBytes)
+{
+    if (data == nullptr || offset < 0 || sizeBytes < 0) {
+        ALOGE("Invalid direct buffer range.");
+        return nullptr;
+    }
+    uint8_t *base = (uint8_t *)_env->GetDirectBufferAddress(data);
+    jlong capacity = _env->GetDirectBufferCapacity(data);
+    if (base == nullptr || capacity < (jlong)offset + sizeBytes) {
+        ALOGE("Data must be a direct ByteBuffer holding %i bytes at offset %i.", sizeBytes, offset);
+        return nullptr;
+    }
+    return base + offset;
+}
+
+// The *Direct variants below copy straight between an Allocation and a direct
+// ByteBuffer, without pinning or copying a Java array first.
+
+static void
+nAllocationData1DDirect(JNIEnv *_env, jobject _this, jlong con, jlong _alloc, jint offset,
+                        jint lod, jint count, jobject data, jint dataOffset, jint sizeBytes)
+{
+    if (kLogApi) {
+        ALOGD("nAllocation1DDataDirect, con(%p), alloc(%p), offset(%i), count(%i), sizeBytes(%i)",
+              (RsContext)con, (RsAllocation)_alloc, offset, count, sizeBytes);
+    }
+    void *ptr = getDirectBufferRange(_env, data, dataOffset, sizeBytes);
+    if (ptr == nullptr) {
+        return;
+    }
+    rsAllocation1DData((RsContext)con, (RsAllocation)_alloc, offset, lod, count, ptr, sizeBytes);
+}
+
+static void
+nAllocationData2DDirect(JNIEnv *_env, jobject _this, jlong con, jlong _alloc, jint xoff,
+                        jint yoff, jint lod, jint _face, jint w, jint h, jobject data,
+                        jint dataOffset, jint sizeBytes, jint stride)
+{
+    if (kLogApi) {
+        ALOGD("nAllocation2DDataDirect, con(%p), alloc(%p), xoff(%i), yoff(%i), w(%i), h(%i), "
+              "sizeBytes(%i), stride(%i)", (RsContext)con, (RsAllocation)_alloc, xoff, yoff, w, h,
+              sizeBytes, stride);
+    }
+    void *ptr = getDirectBufferRange(_env, data, dataOffset, sizeBytes);
+    if (ptr == nullptr) {
+        return;
+    }
+    rsAllocation2DData((RsContext)con, (RsAllocation)_alloc, xoff, yoff, lod,
+                       (RsAllocationCubemapFace)_face, w, h, ptr, sizeBytes, stride);
+}
+
+static void
+nAllocationData3DDirect(JNIEnv *_env, jobject _this, jlong con, jlong _alloc, jint xoff,
+                        jint yoff, jint zoff, jint lod, jint w, jint h, jint d, jobject data,
+                        jint dataOffset, jint sizeBytes)
+{
+    if (kLogApi) {
+        ALOGD("nAllocation3DDataDirect, con(%p), alloc(%p), xoff(%i), yoff(%i), zoff(%i), w(%i), "
+              "h(%i), d(%i), sizeBytes(%i)", (RsContext)con, (RsAllocation)_alloc, xoff, yoff,
+              zoff, w, h, d, sizeBytes);
+    }
+    void *ptr = getDirectBufferRange(_env, data, dataOffset, sizeBytes);
+    if (ptr == nullptr) {
+        return;
+    }
+    rsAllocation3DData((RsContext)con, (RsAllocation)_alloc, xoff, yoff, zoff, lod, w, h, d,
+                       ptr, sizeBytes, 0);
+}
+
+static void
+nAllocationReadDirect(JNIEnv *_env, jobject _this, jlong con, jlong _alloc, jobject data,
+                      jint dataOffset, jint sizeBytes)
+{
+    if (kLogApi) {
+        ALOGD("nAllocationReadDirect, con(%p), alloc(%p), sizeBytes(%i)", (RsContext)con,
+              (RsAllocation)_alloc, sizeBytes);
+    }
+    void *ptr = getDirectBufferRange(_env, data, dataOffset, sizeBytes);
+    if (ptr == nullptr) {
+        return;
+    }
+    rsAllocationRead((RsContext)con, (RsAllocation)_alloc, ptr, sizeBytes);
+}
+
+static void
+nAllocationRead2DDirect(JNIEnv *_env, jobject _this, jlong con, jlong _alloc, jint xoff,
+                        jint yoff, jint lod, jint _face, jint w, jint h, jobject data,
+                        jint dataOffset, jint sizeBytes, jint stride)
+{
+    if (kLogApi) {
+        ALOGD("nAllocation2DReadDirect, con(%p), alloc(%p), xoff(%i), yoff(%i), w(%i), h(%i), "
+              "sizeBytes(%i), stride(%i)", (RsContext)con, (RsAllocation)_alloc, xoff, yoff, w, h,
+              sizeBytes, stride);
+    }
+    void *ptr = getDirectBufferRange(_env, data, dataOffset, sizeBytes);
+    if (ptr == nullptr) {
+        return;
+    }
+    rsAllocation2DRead((RsContext)con, (RsAllocation)_alloc, xoff, yoff, lod,
+                       (RsAllocationCubemapFace)_face, w, h, ptr, sizeBytes, stride);
+}
+
+// Updates several Allocations from one direct ByteBuffer in a single call.
+// ranges holds four ints per Allocation: the element offset, the element
+// count, and the byte offset and byte size of its data in the buffer.
+static void
+nAllocationData1DBatch(JNIEnv *_env, jobject _this, jlong con, jlongArray allocs,
+                       jintArray ranges, jobject data)
+{
+    jint count = _env->GetArrayLength(allocs);
+    if (_env->GetArrayLength(ranges) < count * 4) {
+        ALOGE("Batch ranges must hold four values per Allocation.");
+        return;
+    }
+    if (kLogApi) {
+        ALOGD("nAllocationData1DBatch, con(%p), count(%i)", (RsContext)con, count);
+    }
+    uint8_t *base = (uint8_t *)_env->GetDirectBufferAddress(data);
+    jlong capacity = _env->GetDirectBufferCapacity(data);
+    if (base == nullptr) {
+        ALOGE("Batch data must be a direct ByteBuffer.");
+        return;
+    }
+
+    jlong *allocPtr = _env->GetLongArrayElements(allocs, nullptr);
+    if (allocPtr == nullptr) {
+        ALOGE("Failed to get Java array elements: allocs");
+        return;
+    }
+    jint *rangePtr = _env->GetIntArrayElements(ranges, nullptr);
+    if (rangePtr == nullptr) {
+        ALOGE("Failed to get Java array elements: ranges");
+        _env->ReleaseLongArrayElements(allocs, allocPtr, JNI_ABORT);
+        return;
+    }
+
+    for (jint i = 0; i < count; i++) {
+        const jint *range = rangePtr + i * 4;
+        if (range[2] < 0 || range[3] < 0 || capacity < (jlong)range[2] + range[3]) {
+            ALOGE("Batch entry %i is outside the data buffer.", i);
+            break;
+        }
+        rsAllocation1DData((RsContext)con, (RsAllocation)allocPtr[i], range[0], 0, range[1],
+                           base + range[2], range[3]);
+    }
+
+    _env->ReleaseIntArrayElements(ranges, rangePtr, JNI_ABORT);
+    _env->ReleaseLongArrayElements(allocs, allocPtr, JNI_ABORT);
+}
+
 static jlong
 nAllocationGetType(JNIEnv *_env, jobject _this, jlong con, jlong a)
 {
@@ -2888,6 +3041,12 @@ static const JNINativeMethod methods[] = {
 {"rsnAllocationElementRead",         "(JJIIIII[BI)V",                         (void*)nAllocationElementRead },
 {"rsnAllocationRead2D",              "(JJIIIIIILjava/lang/Object;IIIZ)V",     (void*)nAllocationRead2D },
 {"rsnAllocationRead3D",              "(JJIIIIIIILjava/lang/Object;IIIZ)V",    (void*)nAllocationRead3D },
+{"rsnAllocationData1DDirect",        "(JJIIILjava/nio/ByteBuffer;II)V",       (void*)nAllocationData1DDirect },
+{"rsnAllocationData2DDirect",        "(JJIIIIIILjava/nio/ByteBuffer;III)V",   (void*)nAllocationData2DDirect },
+{"rsnAllocationData3DDirect",        "(JJIIIIIIILjava/nio/ByteBuffer;II)V",   (void*)nAllocationData3DDirect },
+{"rsnAllocationData1DBatch",         "(J[J[ILjava/nio/ByteBuffer;)V",         (void*)nAllocationData1DBatch },
+{"rsnAllocationReadDirect",          "(JJLjava/nio/ByteBuffer;II)V",          (void*)nAllocationReadDirect },
+{"rsnAllocationRead2DDirect",        "(JJIIIIIILjava/nio/ByteBuffer;III)V",   (void*)nAllocationRead2DDirect },
 {"rsnAllocationGetType",             "(JJ)J",                                 (void*)nAllocationGetType},
 {"rsnAllocationResize1D",            "(JJI)V",                                (void*)nAllocationResize1D },
 {"rsnAllocationGenerateMipmaps",     "(JJ)V",                                 (void*)nAllocationGenerateMipmaps },
@@ -18,29 +18,177 @@
 //#define LOG_NDEBUG 0
 
 #include <dirent.h>
+#include <errno.h>
+#include <inttypes.h>
+#include <limits.h>
 #include <stddef.h>
 #include <stdio.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/resource.h>
 #include <sys/stat.h>
+#include <sys/syscall.h>
 #include <sys/types.h>
+#include <sys/uio.h>
 #include <unistd.h>
 
+#include <algorithm>
+#include <atomic>
+#include <thread>
+#include <vector>
+
 #include <android-base/stringprintf.h>
 #include <android-base/file.h>
+#include <android-base/unique_fd.h>
 
 #include <nativehelper/JNIHelp.h>
 #include <android_runtime/AndroidRuntime.h>
 #include <binder/IPCThreadState.h>
 #include <jni.h>
 #include <processgroup/processgroup.h>
+#include <system/thread_defs.h>
+#include <utils/Timers.h>
 
+using android::base::ReadFileToString;
 using android::base::StringPrintf;
+using android::base::unique_fd;
 using android::base::WriteStringToFile;
 
 #define SYNC_RECEIVED_WHILE_FROZEN (1)
 #define ASYNC_RECEIVED_WHILE_FROZEN (2)
 
+#ifndef MADV_PAGEOUT
+#define MADV_PAGEOUT 21
+#endif
+
 namespace android {
 
+// Must match with the COMPACT_MODE_* constants in CachedAppOptimizer.java.
+enum CompactMode {
+    COMPACT_MODE_FILE = 1,
+    COMPACT_MODE_ANON = 2,
+    COMPACT_MODE_ALL = COMPACT_MODE_FILE | COMPACT_MODE_ANON,
+};
+
+// Compaction holds the target's mmap_sem, so keep the number of processes
+// being reclaimed at once small.
+static const size_t MAX_COMPACTION_THREADS = 4;
+
+static long getResidentBytes(pid_t pid) {
+    std::string statm;
+    if (!ReadFileToString(StringPrintf("/proc/%d/statm", pid), &statm)) {
+        return -1;
+    }
+    long size, resident;
+    if (sscanf(statm.c_str(), "%ld %ld", &size, &resident) != 2) {
+        return -1;
+    }
+    return resident * getpagesize();
+}
+
+#if defined(__NR_process_madvise) && defined(__NR_pidfd_open)
+// Pages out every VMA of |pid| matching |mode| with process_madvise(). Returns
+// false if the kernel does not support it, in which case the caller falls back
+// to /proc/<pid>/reclaim.
+static bool compactWithProcessMadvise(pid_t pid, int mode) {
+    unique_fd pidfd(syscall(__NR_pidfd_open, pid, 0));
+    if (pidfd < 0) {
+        return errno != ENOSYS;
+    }
+
+    std::string maps;
+    if (!ReadFileToString(StringPrintf("/proc/%d/maps", pid), &maps)) {
+        return true;
+    }
+
+    std::vector<struct iovec> vmas;
+    size_t pos = 0;
+    while (pos < maps.size()) {
+        size_t end = maps.find('\n', pos);
+        if (end == std::string::npos) {
+            end = maps.size();
+        }
+        const char* line = maps.c_str() + pos;
+        uintptr_t start, limit;
+        unsigned long inode;
+        int pathOffset = 0;
+        if (sscanf(line, "%" SCNxPTR "-%" SCNxPTR " %*s %*s %*s %lu %n",
+                   &start, &limit, &inode, &pathOffset) >= 3) {
+            const char* path = line + pathOffset;
+            const bool fileBacked = inode != 0;
+            // Leave special mappings such as [stack] and [vdso] alone.
+            const bool special = !fileBacked && *path == '[' && strncmp(path, "[anon:", 6) != 0
+                    && strncmp(path, "[heap]", 6) != 0;
+            if (!special && ((fileBacked && (mode & COMPACT_MODE_FILE)) ||
+                             (!fileBacked && (mode & COMPACT_MODE_ANON)))) {
+                vmas.push_back({reinterpret_cast<void*>(start), limit - start});
+            }
+        }
+        pos = end + 1;
+    }
+
+    for (size_t i = 0; i < vmas.size(); i += IOV_MAX) {
+        const size_t count = std::min<size_t>(IOV_MAX, vmas.size() - i);
+        if (syscall(__NR_process_madvise, pidfd.get(), &vmas[i], count, MADV_PAGEOUT, 0) < 0) {
+            if (errno == ENOSYS || errno == EINVAL) {
+                return i != 0;
+            }
+            if (errno == ESRCH) {
+                break;
+            }
+        }
+    }
+    return true;
+}
+#else
+static bool compactWithProcessMadvise(pid_t, int) {
+    return false;
+}
+#endif
+
+static void compactProcess(pid_t pid, int mode) {
+    if (compactWithProcessMadvise(pid, mode)) {
+        return;
+    }
+    const char* type = mode == COMPACT_MODE_FILE ? "file"
+            : mode == COMPACT_MODE_ANON ? "anon" : "all";
+    WriteStringToFile(std::string(type), StringPrintf("/proc/%d/reclaim", pid));
+}
+
+// Compacts each of |pids| with the matching entry of |modes| on a small pool of
+// background priority threads. If non-null, |outReclaimed| receives the drop in
+// resident bytes for each pid (or -1 if the process went away) and
+// |outDurations| the time spent on it in nanoseconds.
+static void compactProcesses(const std::vector<pid_t>& pids, const std::vector<int>& modes,
+                             jlong* outReclaimed, jlong* outDurations) {
+    std::atomic<size_t> next(0);
+    auto worker = [&]() {
+        setpriority(PRIO_PROCESS, 0, ANDROID_PRIORITY_BACKGROUND);
+        for (size_t i = next++; i < pids.size(); i = next++) {
+            const nsecs_t start = systemTime(SYSTEM_TIME_MONOTONIC);
+            const long before = getResidentBytes(pids[i]);
+            compactProcess(pids[i], modes[i]);
+            const long after = getResidentBytes(pids[i]);
+            if (outReclaimed != nullptr) {
+                outReclaimed[i] = (before < 0 || after < 0) ? -1 : std::max(0L, before - after);
+            }
+            if (outDurations != nullptr) {
+                outDurations[i] = systemTime(SYSTEM_TIME_MONOTONIC) - start;
+            }
+        }
+    };
+
+    const size_t threadCount = std::min(pids.size(), MAX_COMPACTION_THREADS);
+    std::vector<std::thread> threads;
+    threads.reserve(threadCount);
+    for (size_t i = 0; i < threadCount; i++) {
+        threads.emplace_back(worker);
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+}
+
 // This performs per-process reclaim on all processes belonging to non-app UIDs.
 // For the most part, these are non-zygote processes like Treble HALs, but it
 // also includes zygote-derived processes that run in system UIDs, like bluetooth
@@ -48,6 +196,7 @@ namespace android {
 // not be compacted is system_server, since compacting system_server around the
 // time of BOOT_COMPLETE could result in perceptible issues.
 static void com_android_server_am_CachedAppOptimizer_compactSystem(JNIEnv *, jobject) {
+    std::vector<pid_t> pids;
     std::unique_ptr<DIR, decltype(&closedir)> proc(opendir("/proc"), closedir);
     struct dirent* current;
     while ((current = readdir(proc.get()))) {
@@ -74,8 +223,49 @@ static void com_android_server_am_CachedAppOptimizer_compactSystem(JNIEnv *, job
             continue;
         }
 
-        std::string reclaim_path = StringPrintf("/proc/%s/reclaim", current->d_name);
-        WriteStringToFile(std::string("all"), reclaim_path);
+        pids.push_back(atoi(current->d_name));
+    }
+
+    std::vector<int> modes(pids.size(), COMPACT_MODE_ALL);
+    compactProcesses(pids, modes, nullptr, nullptr);
+}
+
+static void com_android_server_am_CachedAppOptimizer_compactProcesses(JNIEnv* env, jobject,
+        jintArray pidArray, jintArray modeArray, jlongArray reclaimedArray,
+        jlongArray durationArray) {
+    if (pidArray == NULL || modeArray == NULL) {
+        jniThrowNullPointerException(env, NULL);
+        return;
+    }
+    const jsize count = env->GetArrayLength(pidArray);
+    if (env->GetArrayLength(modeArray) != count
+            || (reclaimedArray != NULL && env->GetArrayLength(reclaimedArray) < count)
+            || (durationArray != NULL && env->GetArrayLength(durationArray) < count)) {
+        jniThrowException(env, "java/lang/IllegalArgumentException", "array length mismatch");
+        return;
+    }
+
+    std::vector<pid_t> pids(count);
+    std::vector<int> modes(count);
+    env->GetIntArrayRegion(pidArray, 0, count, pids.data());
+    env->GetIntArrayRegion(modeArray, 0, count, modes.data());
+    for (jsize i = 0; i < count; i++) {
+        if (modes[i] < COMPACT_MODE_FILE || modes[i] > COMPACT_MODE_ALL) {
+            jniThrowExceptionFmt(env, "java/lang/IllegalArgumentException",
+                                 "invalid compaction mode %d", modes[i]);
+            return;
+        }
+    }
+
+    std::vector<jlong> reclaimed(count);
+    std::vector<jlong> durations(count);
+    compactProcesses(pids, modes, reclaimed.data(), durations.data());
+
+    if (reclaimedArray != NULL) {
+        env->SetLongArrayRegion(reclaimedArray, 0, count, reclaimed.data());
+    }
+    if (durationArray != NULL) {
+        env->SetLongArrayRegion(durationArray, 0, count, durations.data());
     }
 }
 
@@ -128,6 +318,8 @@ static jint com_android_server_am_CachedAppOptimizer_getBinderFreezeInfo(JNIEnv
 static const JNINativeMethod sMethods[] = {
     /* name, signature, funcPtr */
     {"compactSystem", "()V", (void*)com_android_server_am_CachedAppOptimizer_compactSystem},
+    {"compactProcesses", "([I[I[J[J)V",
+        (void*)com_android_server_am_CachedAppOptimizer_compactProcesses},
     {"enableFreezerInternal", "(Z)V",
         (void*)com_android_server_am_CachedAppOptimizer_enableFreezerInternal},
     {"freezeBinder", "(IZ)V", (void*)com_android_server_am_CachedAppOptimizer_freezeBinder},
@@ -18,12 +18,16 @@
 
 #include <errno.h>
 #include <psi/psi.h>
+#include <stdio.h>
+#include <stdlib.h>
 #include <string.h>
 #include <sys/epoll.h>
+#include <unistd.h>
 
 #include <jni.h>
 #include <nativehelper/JNIHelp.h>
 #include <utils/Log.h>
+#include <utils/Timers.h>
 
 namespace android {
 
@@ -35,6 +39,9 @@ enum pressure_levels {
     PRESSURE_LEVEL_COUNT = PRESSURE_HIGH
 };
 
+// upper bound on the number of triggers initWithTriggers() accepts
+static constexpr int MAX_PRESSURE_LEVELS = 8;
+
 // amount of stall in us for each level
 static constexpr int PSI_LOW_STALL_US = 15000;
 static constexpr int PSI_MEDIUM_STALL_US = 30000;
@@ -43,56 +50,126 @@ static constexpr int PSI_HIGH_STALL_US = 50000;
 // stall tracking window size in us
 static constexpr int PSI_WINDOW_SIZE_US = 1000000;
 
-static int psi_epollfd = -1;
+// Layout of the long array filled by waitForPressureWithStats(). Deltas are
+// relative to the previous call; must match with the constants from
+// LowMemDetector.java.
+enum pressure_stats {
+    STATS_ELAPSED_NS,
+    STATS_SOME_STALL_DELTA_US,
+    STATS_FULL_STALL_DELTA_US,
+    STATS_SOME_AVG10_CENTI,   // avg10 * 100
+    STATS_FULL_AVG10_CENTI,
+    STATS_MEM_FREE_KB,
+    STATS_MEM_AVAILABLE_KB,
+    STATS_CACHED_KB,
+    STATS_SWAP_FREE_KB,
+    STATS_PGSCAN_KSWAPD_DELTA,
+    STATS_PGSCAN_DIRECT_DELTA,
+    STATS_PGSTEAL_DELTA,
+    STATS_WORKINGSET_REFAULT_DELTA,
+    STATS_COUNT
+};
 
-static jint android_server_am_LowMemDetector_init(JNIEnv*, jobject) {
-    int epollfd;
-    int low_psi_fd;
-    int medium_psi_fd;
-    int high_psi_fd;
+struct pressure_snapshot {
+    nsecs_t time;
+    int64_t some_total;
+    int64_t full_total;
+    int64_t pgscan_kswapd;
+    int64_t pgscan_direct;
+    int64_t pgsteal;
+    int64_t workingset_refault;
+};
+
+static int psi_epollfd = -1;
+static int psi_fds[MAX_PRESSURE_LEVELS];
+static int psi_level_count = 0;
+static pressure_snapshot last_snapshot;
+static bool last_snapshot_valid = false;
 
-    epollfd = epoll_create(PRESSURE_LEVEL_COUNT);
+static int register_psi_triggers(const jint* types, const jint* stalls_us,
+                                 const jint* windows_us, int count) {
+    int fds[MAX_PRESSURE_LEVELS];
+    int epollfd = epoll_create(count);
     if (epollfd == -1) {
         ALOGE("epoll_create failed: %s", strerror(errno));
         return -1;
     }
 
-    low_psi_fd = init_psi_monitor(PSI_SOME, PSI_LOW_STALL_US, PSI_WINDOW_SIZE_US);
-    if (low_psi_fd < 0 ||
-        register_psi_monitor(epollfd, low_psi_fd, (void*)PRESSURE_LOW) != 0) {
-        goto low_fail;
-    }
-
-    medium_psi_fd =
-        init_psi_monitor(PSI_FULL, PSI_MEDIUM_STALL_US, PSI_WINDOW_SIZE_US);
-    if (medium_psi_fd < 0 || register_psi_monitor(epollfd, medium_psi_fd,
-                                                  (void*)PRESSURE_MEDIUM) != 0) {
-        goto medium_fail;
+    for (int i = 0; i < count; i++) {
+        fds[i] = init_psi_monitor(static_cast<enum psi_stall_type>(types[i]), stalls_us[i],
+                                  windows_us[i]);
+        // levels are reported 1-based; PRESSURE_NONE is 0
+        if (fds[i] < 0 ||
+            register_psi_monitor(epollfd, fds[i], (void*)(uintptr_t)(i + 1)) != 0) {
+            if (fds[i] >= 0) {
+                destroy_psi_monitor(fds[i]);
+            }
+            while (--i >= 0) {
+                unregister_psi_monitor(epollfd, fds[i]);
+                destroy_psi_monitor(fds[i]);
+            }
+            ALOGE("Failed to register psi trigger");
+            close(epollfd);
+            return -1;
+        }
     }
 
-    high_psi_fd =
-        init_psi_monitor(PSI_FULL, PSI_HIGH_STALL_US, PSI_WINDOW_SIZE_US);
-    if (high_psi_fd < 0 ||
-        register_psi_monitor(epollfd, high_psi_fd, (void*)PRESSURE_HIGH) != 0) {
-        goto high_fail;
+    // drop the triggers from a previous init
+    if (psi_epollfd >= 0) {
+        for (int i = 0; i < psi_level_count; i++) {
+            unregister_psi_monitor(psi_epollfd, psi_fds[i]);
+            destroy_psi_monitor(psi_fds[i]);
+        }
+        close(psi_epollfd);
     }
-
+    memcpy(psi_fds, fds, count * sizeof(int));
     psi_epollfd = epollfd;
+    psi_level_count = count;
     return 0;
+}
 
-high_fail:
-    unregister_psi_monitor(epollfd, medium_psi_fd);
-medium_fail:
-    unregister_psi_monitor(epollfd, low_psi_fd);
-low_fail:
-    ALOGE("Failed to register psi trigger");
-    close(epollfd);
-    return -1;
+static jint android_server_am_LowMemDetector_init(JNIEnv*, jobject) {
+    static const jint types[] = {PSI_SOME, PSI_FULL, PSI_FULL};
+    static const jint stalls[] = {PSI_LOW_STALL_US, PSI_MEDIUM_STALL_US, PSI_HIGH_STALL_US};
+    static const jint windows[] = {PSI_WINDOW_SIZE_US, PSI_WINDOW_SIZE_US, PSI_WINDOW_SIZE_US};
+    return register_psi_triggers(types, stalls, windows, PRESSURE_LEVEL_COUNT);
 }
 
-static jint android_server_am_LowMemDetector_waitForPressure(JNIEnv*, jobject) {
+// Replaces the default three levels with one level per trigger. Level N (1-based)
+// corresponds to the Nth trigger, so triggers should be ordered by severity.
+static jint android_server_am_LowMemDetector_initWithTriggers(JNIEnv* env, jobject,
+        jintArray typeArray, jintArray stallArray, jintArray windowArray) {
+    if (typeArray == NULL || stallArray == NULL || windowArray == NULL) {
+        jniThrowNullPointerException(env, NULL);
+        return -1;
+    }
+    const jsize count = env->GetArrayLength(typeArray);
+    if (count <= 0 || count > MAX_PRESSURE_LEVELS ||
+        env->GetArrayLength(stallArray) != count || env->GetArrayLength(windowArray) != count) {
+        jniThrowException(env, "java/lang/IllegalArgumentException", "invalid trigger count");
+        return -1;
+    }
+
+    jint types[MAX_PRESSURE_LEVELS];
+    jint stalls[MAX_PRESSURE_LEVELS];
+    jint windows[MAX_PRESSURE_LEVELS];
+    env->GetIntArrayRegion(typeArray, 0, count, types);
+    env->GetIntArrayRegion(stallArray, 0, count, stalls);
+    env->GetIntArrayRegion(windowArray, 0, count, windows);
+    for (int i = 0; i < count; i++) {
+        if (types[i] < 0 || types[i] >= PSI_TYPE_COUNT || stalls[i] <= 0 ||
+            windows[i] < stalls[i]) {
+            jniThrowExceptionFmt(env, "java/lang/IllegalArgumentException",
+                                 "invalid psi trigger %d", i);
+            return -1;
+        }
+    }
+    return register_psi_triggers(types, stalls, windows, count);
+}
+
+static int wait_for_pressure() {
     static uint32_t pressure_level = PRESSURE_NONE;
-    struct epoll_event events[PRESSURE_LEVEL_COUNT];
+    struct epoll_event events[MAX_PRESSURE_LEVELS];
     int nevents = 0;
 
     if (psi_epollfd < 0) {
@@ -103,14 +180,14 @@ static jint android_server_am_LowMemDetector_waitForPressure(JNIEnv*, jobject) {
     do {
         if (pressure_level == PRESSURE_NONE) {
             /* Wait for events with no timeout */
-            nevents = epoll_wait(psi_epollfd, events, PRESSURE_LEVEL_COUNT, -1);
+            nevents = epoll_wait(psi_epollfd, events, psi_level_count, -1);
         } else {
             // This is simpler than lmkd. Assume that the memory pressure
             // state will stay high for at least 1s. Within that 1s window,
             // the memory pressure state can go up due to a different FD
             // becoming available or it can go down when that window expires.
             // Accordingly, there's no polling: just epoll_wait with a 1s timeout.
-            nevents = epoll_wait(psi_epollfd, events, PRESSURE_LEVEL_COUNT, 1000);
+            nevents = epoll_wait(psi_epollfd, events, psi_level_count, 1000);
             if (nevents == 0) {
                 pressure_level = PRESSURE_NONE;
                 return pressure_level;
@@ -141,11 +218,132 @@ static jint android_server_am_LowMemDetector_waitForPressure(JNIEnv*, jobject) {
     return pressure_level;
 }
 
+static jint android_server_am_LowMemDetector_waitForPressure(JNIEnv*, jobject) {
+    return wait_for_pressure();
+}
+
+static void read_psi_totals(pressure_snapshot* snapshot, jlong* stats) {
+    FILE* fp = fopen("/proc/pressure/memory", "re");
+    if (fp == NULL) {
+        return;
+    }
+    char line[256];
+    while (fgets(line, sizeof(line), fp) != NULL) {
+        float avg10;
+        long long total;
+        if (sscanf(line, "some avg10=%f %*s %*s total=%lld", &avg10, &total) == 2) {
+            snapshot->some_total = total;
+            stats[STATS_SOME_AVG10_CENTI] = static_cast<jlong>(avg10 * 100);
+        } else if (sscanf(line, "full avg10=%f %*s %*s total=%lld", &avg10, &total) == 2) {
+            snapshot->full_total = total;
+            stats[STATS_FULL_AVG10_CENTI] = static_cast<jlong>(avg10 * 100);
+        }
+    }
+    fclose(fp);
+}
+
+static void read_meminfo(jlong* stats) {
+    static const struct {
+        const char* name;
+        int index;
+    } fields[] = {
+        {"MemFree:", STATS_MEM_FREE_KB},
+        {"MemAvailable:", STATS_MEM_AVAILABLE_KB},
+        {"Cached:", STATS_CACHED_KB},
+        {"SwapFree:", STATS_SWAP_FREE_KB},
+    };
+    FILE* fp = fopen("/proc/meminfo", "re");
+    if (fp == NULL) {
+        return;
+    }
+    char line[128];
+    size_t found = 0;
+    while (found < NELEM(fields) && fgets(line, sizeof(line), fp) != NULL) {
+        for (const auto& field : fields) {
+            size_t len = strlen(field.name);
+            if (strncmp(line, field.name, len) == 0) {
+                stats[field.index] = strtoll(line + len, NULL, 10);
+                found++;
+                break;
+            }
+        }
+    }
+    fclose(fp);
+}
+
+static void read_vmstat(pressure_snapshot* snapshot) {
+    FILE* fp = fopen("/proc/vmstat", "re");
+    if (fp == NULL) {
+        return;
+    }
+    char name[64];
+    long long value;
+    while (fscanf(fp, "%63s %lld", name, &value) == 2) {
+        // pgscan/pgsteal are split per reclaimer (and per file/anon on newer
+        // kernels); fold them together
+        if (strncmp(name, "pgscan_kswapd", 13) == 0) {
+            snapshot->pgscan_kswapd += value;
+        } else if (strncmp(name, "pgscan_direct", 13) == 0) {
+            snapshot->pgscan_direct += value;
+        } else if (strncmp(name, "pgsteal_", 8) == 0) {
+            snapshot->pgsteal += value;
+        } else if (strcmp(name, "workingset_refault") == 0 ||
+                   strcmp(name, "workingset_refault_anon") == 0 ||
+                   strcmp(name, "workingset_refault_file") == 0) {
+            snapshot->workingset_refault += value;
+        }
+    }
+    fclose(fp);
+}
+
+// Same as waitForPressure(), but on every wakeup also samples PSI stall totals,
+// /proc/meminfo and /proc/vmstat so the caller gets the pressure trend and
+// reclaim activity without reading those files itself. Returns the level.
+static jint android_server_am_LowMemDetector_waitForPressureWithStats(JNIEnv* env, jobject,
+        jlongArray statsArray) {
+    if (statsArray == NULL || env->GetArrayLength(statsArray) < STATS_COUNT) {
+        jniThrowException(env, "java/lang/IllegalArgumentException", "stats array too small");
+        return -1;
+    }
+
+    int level = wait_for_pressure();
+    if (level < 0) {
+        return level;
+    }
+
+    jlong stats[STATS_COUNT] = {};
+    pressure_snapshot snapshot = {};
+    snapshot.time = systemTime(SYSTEM_TIME_MONOTONIC);
+    read_psi_totals(&snapshot, stats);
+    read_meminfo(stats);
+    read_vmstat(&snapshot);
+
+    if (last_snapshot_valid) {
+        stats[STATS_ELAPSED_NS] = snapshot.time - last_snapshot.time;
+        stats[STATS_SOME_STALL_DELTA_US] = snapshot.some_total - last_snapshot.some_total;
+        stats[STATS_FULL_STALL_DELTA_US] = snapshot.full_total - last_snapshot.full_total;
+        stats[STATS_PGSCAN_KSWAPD_DELTA] = snapshot.pgscan_kswapd - last_snapshot.pgscan_kswapd;
+        stats[STATS_PGSCAN_DIRECT_DELTA] = snapshot.pgscan_direct - last_snapshot.pgscan_direct;
+        stats[STATS_PGSTEAL_DELTA] = snapshot.pgsteal - last_snapshot.pgsteal;
+        stats[STATS_WORKINGSET_REFAULT_DELTA] =
+                snapshot.workingset_refault - last_snapshot.workingset_refault;
+    }
+    last_snapshot = snapshot;
+    last_snapshot_valid = true;
+
+    env->SetLongArrayRegion(statsArray, 0, STATS_COUNT, stats);
+    return level;
+}
+
 static const JNINativeMethod sMethods[] = {
     /* name, signature, funcPtr */
     {"init", "()I", (void*)android_server_am_LowMemDetector_init},
+    {"initWithTriggers", "([I[I[I)I",
+     (void*)android_server_am_LowMemDetector_initWithTriggers},
     {"waitForPressure", "()I",
      (void*)android_server_am_LowMemDetector_waitForPressure},
+    {"waitForPressureWithStats", "([J)I",
+     (void*)android_server_am_LowMemDetector_waitForPressureWithStats},
 };
 
 int register_android_server_am_LowMemDetector(JNIEnv* env) {
@@ -30,6 +30,9 @@
 #include <atomic>
 #include <cinttypes>
 #include <limits.h>
+#include <map>
+#include <mutex>
+#include <optional>
 #include <android-base/parseint.h>
 #include <android-base/stringprintf.h>
 #include <android_runtime/AndroidRuntime.h>
@@ -182,6 +185,81 @@ static std::string getStringElementFromJavaArray(JNIEnv* env, jobjectArray array
     return result;
 }
 
+// --- PolicyUpcallStats ---
+
+// Latency of the policy upcalls made from the reader and dispatcher threads,
+// reported in dump(). Updated lock-free since it sits on the input path.
+class PolicyUpcallStats {
+public:
+    enum Callback {
+        FILTER_INPUT_EVENT,
+        INTERCEPT_KEY_BEFORE_QUEUEING,
+        INTERCEPT_MOTION_BEFORE_QUEUEING,
+        INTERCEPT_KEY_BEFORE_DISPATCHING,
+        DISPATCH_UNHANDLED_KEY,
+        CALLBACK_COUNT
+    };
+
+    void record(Callback callback, nsecs_t duration) {
+        Entry& entry = mEntries[callback];
+        entry.count.fetch_add(1, std::memory_order_relaxed);
+        entry.totalNs.fetch_add(duration, std::memory_order_relaxed);
+        nsecs_t max = entry.maxNs.load(std::memory_order_relaxed);
+        while (duration > max &&
+               !entry.maxNs.compare_exchange_weak(max, duration, std::memory_order_relaxed)) {
+        }
+    }
+
+    void recordCacheHit(Callback callback) {
+        mEntries[callback].cacheHits.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    void dump(std::string& dump) const {
+        static const char* const kNames[CALLBACK_COUNT] = {
+            "filterInputEvent",
+            "interceptKeyBeforeQueueing",
+            "interceptMotionBeforeQueueing",
+            "interceptKeyBeforeDispatching",
+            "dispatchUnhandledKey",
+        };
+        dump += INDENT "Policy Upcalls:\n";
+        for (int i = 0; i < CALLBACK_COUNT; i++) {
+            const Entry& entry = mEntries[i];
+            const uint64_t count = entry.count.load(std::memory_order_relaxed);
+            const nsecs_t total = entry.totalNs.load(std::memory_order_relaxed);
+            dump += StringPrintf(INDENT INDENT "%s: count=%" PRIu64 ", avg=%.3fms, "
+                                 "max=%.3fms, cacheHits=%" PRIu64 "\n",
+                                 kNames[i], count,
+                                 count != 0 ? total / 1000000.0 / count : 0.0,
+                                 entry.maxNs.load(std::memory_order_relaxed) / 1000000.0,
+                                 entry.cacheHits.load(std::memory_order_relaxed));
+        }
+    }
+
+private:
+    struct Entry {
+        std::atomic<uint64_t> count{0};
+        std::atomic<uint64_t> cacheHits{0};
+        std::atomic<nsecs_t> totalNs{0};
+        std::atomic<nsecs_t> maxNs{0};
+    };
+    Entry mEntries[CALLBACK_COUNT];
+};
+
+class ScopedUpcallTimer {
+public:
+    ScopedUpcallTimer(PolicyUpcallStats& stats, PolicyUpcallStats::Callback callback) :
+            mStats(stats), mCallback(callback), mStart(systemTime(SYSTEM_TIME_MONOTONIC)) {}
+    ~ScopedUpcallTimer() {
+        mStats.record(mCallback, systemTime(SYSTEM_TIME_MONOTONIC) - mStart);
+    }
+
+private:
+    PolicyUpcallStats& mStats;
+    const PolicyUpcallStats::Callback mCallback;
+    const nsecs_t mStart;
+};
+
 // --- NativeInputManager ---
 
 class NativeInputManager : public virtual RefBase,
@@ -215,6 +293,7 @@ public:
     void setInputDeviceEnabled(uint32_t deviceId, bool enabled);
     void setShowTouches(bool enabled);
     void setInteractive(bool interactive);
+    void setNonInteractiveMotionPolicy(int32_t displayId, int32_t wmActions);
     void reloadCalibration();
     void setPointerIconType(int32_t iconId);
     void reloadPointerIcons();
@@ -310,6 +389,15 @@ private:
 
     std::atomic<bool> mInteractive;
 
+    // Result of interceptMotionBeforeQueueingNonInteractive per display, as
+    // pushed by the window manager when its answer doesn't depend on the event
+    // (e.g. wake-on-motion disabled). Displays missing here still upcall.
+    // Cleared whenever the interactive state changes.
+    std::mutex mMotionPolicyLock;
+    std::map<int32_t, int32_t> mNonInteractiveMotionActions GUARDED_BY(mMotionPolicyLock);
+
+    PolicyUpcallStats mUpcallStats;
+
     void updateInactivityTimeoutLocked();
     void handleInterceptActions(jint wmActions, nsecs_t when, uint32_t& policyFlags);
     void ensureSpriteControllerLocked();
@@ -368,6 +456,12 @@ void NativeInputManager::dump(std::string& dump) {
         dump += StringPrintf(INDENT "Show Touches: %s\n", toString(mLocked.showTouches));
         dump += StringPrintf(INDENT "Pointer Capture Enabled: %s\n", toString(mLocked.pointerCapture));
     }
+    {
+        std::scoped_lock _l(mMotionPolicyLock);
+        dump += StringPrintf(INDENT "Cached Non-Interactive Motion Policies: %zu\n",
+                mNonInteractiveMotionActions.size());
+    }
+    mUpcallStats.dump(dump);
     dump += "\n";
 
     mInputManager->getReader()->dump(dump);
@@ -881,7 +975,19 @@ void NativeInputManager::setPointerCapture(bool enabled) {
 }
 
 void NativeInputManager::setInteractive(bool interactive) {
-    mInteractive = interactive;
+    if (mInteractive.exchange(interactive) != interactive) {
+        std::scoped_lock _l(mMotionPolicyLock);
+        mNonInteractiveMotionActions.clear();
+    }
+}
+
+void NativeInputManager::setNonInteractiveMotionPolicy(int32_t displayId, int32_t wmActions) {
+    std::scoped_lock _l(mMotionPolicyLock);
+    if (wmActions < 0) {
+        mNonInteractiveMotionActions.erase(displayId);
+    } else {
+        mNonInteractiveMotionActions[displayId] = wmActions;
+    }
 }
 
 void NativeInputManager::reloadCalibration() {
@@ -975,8 +1081,12 @@ bool NativeInputManager::filterInputEvent(const InputEvent* inputEvent, uint32_t
     }
 
     // The callee is responsible for recycling the event.
-    jboolean pass = env->CallBooleanMethod(mServiceObj, gServiceClassInfo.filterInputEvent,
-            inputEventObj, policyFlags);
+    jboolean pass;
+    {
+        ScopedUpcallTimer timer(mUpcallStats, PolicyUpcallStats::FILTER_INPUT_EVENT);
+        pass = env->CallBooleanMethod(mServiceObj, gServiceClassInfo.filterInputEvent,
+                inputEventObj, policyFlags);
+    }
     if (checkAndClearExceptionFromCallback(env, "filterInputEvent")) {
         pass = true;
     }
@@ -1001,9 +1111,13 @@ void NativeInputManager::interceptKeyBeforeQueueing(const KeyEvent* keyEvent,
         jobject keyEventObj = android_view_KeyEvent_fromNative(env, keyEvent);
         jint wmActions;
         if (keyEventObj) {
-            wmActions = env->CallIntMethod(mServiceObj,
-                    gServiceClassInfo.interceptKeyBeforeQueueing,
-                    keyEventObj, policyFlags);
+            {
+                ScopedUpcallTimer timer(mUpcallStats,
+                        PolicyUpcallStats::INTERCEPT_KEY_BEFORE_QUEUEING);
+                wmActions = env->CallIntMethod(mServiceObj,
+                        gServiceClassInfo.interceptKeyBeforeQueueing,
+                        keyEventObj, policyFlags);
+            }
             if (checkAndClearExceptionFromCallback(env, "interceptKeyBeforeQueueing")) {
                 wmActions = 0;
             }
@@ -1038,10 +1152,29 @@ void NativeInputManager::interceptMotionBeforeQueueing(const int32_t displayId,
         if (policyFlags & POLICY_FLAG_INTERACTIVE) {
             policyFlags |= POLICY_FLAG_PASS_TO_USER;
         } else {
+            std::optional<int32_t> cachedActions;
+            {
+                std::scoped_lock _l(mMotionPolicyLock);
+                auto it = mNonInteractiveMotionActions.find(displayId);
+                if (it != mNonInteractiveMotionActions.end()) {
+                    cachedActions = it->second;
+                }
+            }
+            if (cachedActions) {
+                mUpcallStats.recordCacheHit(
+                        PolicyUpcallStats::INTERCEPT_MOTION_BEFORE_QUEUEING);
+                handleInterceptActions(*cachedActions, when, /*byref*/ policyFlags);
+                return;
+            }
             JNIEnv* env = jniEnv();
-            jint wmActions = env->CallIntMethod(mServiceObj,
+            jint wmActions;
+            {
+                ScopedUpcallTimer timer(mUpcallStats,
+                        PolicyUpcallStats::INTERCEPT_MOTION_BEFORE_QUEUEING);
+                wmActions = env->CallIntMethod(mServiceObj,
                         gServiceClassInfo.interceptMotionBeforeQueueingNonInteractive,
                         displayId, when, policyFlags);
+            }
             if (checkAndClearExceptionFromCallback(env,
                     "interceptMotionBeforeQueueingNonInteractive")) {
                 wmActions = 0;
@@ -1085,9 +1218,14 @@ nsecs_t NativeInputManager::interceptKeyBeforeDispatching(
 
         jobject keyEventObj = android_view_KeyEvent_fromNative(env, keyEvent);
         if (keyEventObj) {
-            jlong delayMillis = env->CallLongMethod(mServiceObj,
-                    gServiceClassInfo.interceptKeyBeforeDispatching,
-                    tokenObj, keyEventObj, policyFlags);
+            jlong delayMillis;
+            {
+                ScopedUpcallTimer timer(mUpcallStats,
+                        PolicyUpcallStats::INTERCEPT_KEY_BEFORE_DISPATCHING);
+                delayMillis = env->CallLongMethod(mServiceObj,
+                        gServiceClassInfo.interceptKeyBeforeDispatching,
+                        tokenObj, keyEventObj, policyFlags);
+            }
             bool error = checkAndClearExceptionFromCallback(env, "interceptKeyBeforeDispatching");
             android_view_KeyEvent_recycle(env, keyEventObj);
             env->DeleteLocalRef(keyEventObj);
@@ -1119,9 +1257,13 @@ bool NativeInputManager::dispatchUnhandledKey(const sp<IBinder>& token,
         jobject tokenObj = javaObjectForIBinder(env, token);
         jobject keyEventObj = android_view_KeyEvent_fromNative(env, keyEvent);
         if (keyEventObj) {
-            jobject fallbackKeyEventObj = env->CallObjectMethod(mServiceObj,
-                    gServiceClassInfo.dispatchUnhandledKey,
-                    tokenObj, keyEventObj, policyFlags);
+            jobject fallbackKeyEventObj;
+            {
+                ScopedUpcallTimer timer(mUpcallStats, PolicyUpcallStats::DISPATCH_UNHANDLED_KEY);
+                fallbackKeyEventObj = env->CallObjectMethod(mServiceObj,
+                        gServiceClassInfo.dispatchUnhandledKey,
+                        tokenObj, keyEventObj, policyFlags);
+            }
             if (checkAndClearExceptionFromCallback(env, "dispatchUnhandledKey")) {
                 fallbackKeyEventObj = nullptr;
             }
@@ -1611,6 +1753,13 @@ static void nativeSetInteractive(JNIEnv* env,
     im->setInteractive(interactive);
 }
 
+static void nativeSetNonInteractiveMotionPolicy(JNIEnv* /* env */,
+        jclass /* clazz */, jlong ptr, jint displayId, jint wmActions) {
+    NativeInputManager* im = reinterpret_cast<NativeInputManager*>(ptr);
+
+    im->setNonInteractiveMotionPolicy(displayId, wmActions);
+}
+
 static void nativeReloadCalibration(JNIEnv* env, jclass clazz, jlong ptr) {
     NativeInputManager* im = reinterpret_cast<NativeInputManager*>(ptr);
 
@@ -1790,6 +1939,8 @@ static const JNINativeMethod gInputManagerMethods[] = {
         {"nativeSetPointerSpeed", "(JI)V", (void*)nativeSetPointerSpeed},
         {"nativeSetShowTouches", "(JZ)V", (void*)nativeSetShowTouches},
         {"nativeSetInteractive", "(JZ)V", (void*)nativeSetInteractive},
+        {"nativeSetNonInteractiveMotionPolicy", "(JII)V",
+         (void*)nativeSetNonInteractiveMotionPolicy},
         {"nativeReloadCalibration", "(J)V", (void*)nativeReloadCalibration},
         {"nativeVibrate", "(JI[JII)V", (void*)nativeVibrate},
         {"nativeCancelVibrate", "(JII)V", (void*)nativeCancelVibrate},
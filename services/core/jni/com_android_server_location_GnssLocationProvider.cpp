@@ -43,6 +43,11 @@
 #include <cinttypes>
 #include <iomanip>
 #include <limits>
+#include <map>
+#include <mutex>
+#include <string>
+#include <tuple>
+#include <vector>
 #include <linux/in.h>
 #include <linux/in6.h>
 #include <pthread.h>
@@ -283,6 +288,29 @@ bool hasLatLong(const GnssLocation_V2_0& location) {
 }
 
 }  // namespace
+
+// Setters are looked up by name for every field of every measurement, which at
+// 1-10 Hz with dozens of satellites makes GetMethodID the dominant JNI cost of
+// the callbacks. Method IDs stay valid for as long as the class is loaded, and
+// all classes used with JavaObject are held as global references, so cache them.
+static jmethodID getCachedMethodID(JNIEnv* env, jclass clazz, const char* method_name,
+                                   const char* signature) {
+    static std::mutex sLock;
+    static std::map<std::tuple<jclass, std::string, std::string>, jmethodID> sMethodIds;
+
+    auto key = std::make_tuple(clazz, std::string(method_name), std::string(signature));
+    std::lock_guard<std::mutex> lock(sLock);
+    auto it = sMethodIds.find(key);
+    if (it != sMethodIds.end()) {
+        return it->second;
+    }
+    jmethodID method = env->GetMethodID(clazz, method_name, signature);
+    if (method != nullptr) {
+        sMethodIds.emplace(std::move(key), method);
+    }
+    return method;
+}
+
 template<class T>
 class JavaMethodHelper {
  public:
@@ -305,7 +333,7 @@ void JavaMethodHelper<T>::callJavaMethod(
         jobject object,
         const char* method_name,
         T value) {
-    jmethodID method = env->GetMethodID(clazz, method_name, signature_);
+    jmethodID method = getCachedMethodID(env, clazz, method_name, signature_);
     env->CallVoidMethod(object, method, value);
 }
 
@@ -360,10 +388,7 @@ void JavaObject::callSetter(
         const char* method_name, uint8_t* value, size_t size) {
     jbyteArray array = env_->NewByteArray(size);
     env_->SetByteArrayRegion(array, 0, size, reinterpret_cast<jbyte*>(value));
-    jmethodID method = env_->GetMethodID(
-            clazz_,
-            method_name,
-            "([B)V");
+    jmethodID method = getCachedMethodID(env_, clazz_, method_name, "([B)V");
     env_->CallVoidMethod(object_, method, array);
     env_->DeleteLocalRef(array);
 }
@@ -795,12 +820,19 @@ Return<void> GnssCallback::gnssSvStatusCbImpl(const T& svStatus) {
     jfloatArray carrierFreqArray = env->NewFloatArray(listSize);
     jfloatArray basebandCn0Array = env->NewFloatArray(listSize);
 
-    jint* svidWithFlags = env->GetIntArrayElements(svidWithFlagArray, 0);
-    jfloat* cn0s = env->GetFloatArrayElements(cn0Array, 0);
-    jfloat* elev = env->GetFloatArrayElements(elevArray, 0);
-    jfloat* azim = env->GetFloatArrayElements(azimArray, 0);
-    jfloat* carrierFreq = env->GetFloatArrayElements(carrierFreqArray, 0);
-    jfloat* basebandCn0s = env->GetFloatArrayElements(basebandCn0Array, 0);
+    // The Java arrays are handed off to GnssStatus, so they can't be reused;
+    // fill them from scratch buffers that keep their capacity across callbacks
+    // rather than pinning or copying each array with Get/Release*ArrayElements.
+    static thread_local std::vector<jint> svidWithFlagsBuffer;
+    static thread_local std::vector<jfloat> floatBuffer;
+    svidWithFlagsBuffer.resize(listSize);
+    floatBuffer.resize(5 * listSize);
+    jint* svidWithFlags = svidWithFlagsBuffer.data();
+    jfloat* cn0s = floatBuffer.data();
+    jfloat* elev = cn0s + listSize;
+    jfloat* azim = elev + listSize;
+    jfloat* carrierFreq = azim + listSize;
+    jfloat* basebandCn0s = carrierFreq + listSize;
 
     /*
      * Read GNSS SV info.
@@ -823,12 +855,12 @@ Return<void> GnssCallback::gnssSvStatusCbImpl(const T& svStatus) {
         basebandCn0s[i] = getBasebandCn0DbHz(svStatus, i);
     }
 
-    env->ReleaseIntArrayElements(svidWithFlagArray, svidWithFlags, 0);
-    env->ReleaseFloatArrayElements(cn0Array, cn0s, 0);
-    env->ReleaseFloatArrayElements(elevArray, elev, 0);
-    env->ReleaseFloatArrayElements(azimArray, azim, 0);
-    env->ReleaseFloatArrayElements(carrierFreqArray, carrierFreq, 0);
-    env->ReleaseFloatArrayElements(basebandCn0Array, basebandCn0s, 0);
+    env->SetIntArrayRegion(svidWithFlagArray, 0, listSize, svidWithFlags);
+    env->SetFloatArrayRegion(cn0Array, 0, listSize, cn0s);
+    env->SetFloatArrayRegion(elevArray, 0, listSize, elev);
+    env->SetFloatArrayRegion(azimArray, 0, listSize, azim);
+    env->SetFloatArrayRegion(carrierFreqArray, 0, listSize, carrierFreq);
+    env->SetFloatArrayRegion(basebandCn0Array, 0, listSize, basebandCn0s);
 
     env->CallVoidMethod(mCallbacksObj, method_reportSvStatus,
             static_cast<jint>(listSize), svidWithFlagArray, cn0Array, elevArray, azimArray,
@@ -18,8 +18,12 @@
 
 #include <errno.h>
 #include <inttypes.h>
+#include <string.h>
 #include <sys/stat.h>
 #include <sys/types.h>
+#include <mutex>
+#include <string>
+#include <unordered_map>
 #include <vector>
 
 #include <jni.h>
@@ -43,6 +47,70 @@ namespace android {
 
 static jclass gStringClass;
 
+// Interface names repeat on every row and every poll; keep one global String per
+// name instead of creating a new one per row. Interfaces come and go rarely, so
+// the table is simply reset if it ever grows past the cap.
+static const size_t MAX_INTERNED_IFACES = 256;
+static std::mutex gIfaceLock;
+static std::unordered_map<std::string, jstring> gIfaceStrings;
+
+static jstring get_iface_string(JNIEnv* env, const char* iface)
+{
+    std::lock_guard<std::mutex> lock(gIfaceLock);
+    auto it = gIfaceStrings.find(iface);
+    if (it != gIfaceStrings.end()) {
+        return it->second;
+    }
+    if (gIfaceStrings.size() >= MAX_INTERNED_IFACES) {
+        for (auto& entry : gIfaceStrings) {
+            env->DeleteGlobalRef(entry.second);
+        }
+        gIfaceStrings.clear();
+    }
+    ScopedLocalRef<jstring> local(env, env->NewStringUTF(iface));
+    if (local.get() == NULL) {
+        return NULL;
+    }
+    jstring global = static_cast<jstring>(env->NewGlobalRef(local.get()));
+    gIfaceStrings.emplace(iface, global);
+    return global;
+}
+
+// Previous counters per (iface, uid, set, tag), used by the incremental read to
+// only report rows that changed since the last call with the same snapshot.
+struct StatsKey {
+    std::string iface;
+    uint32_t uid;
+    uint32_t set;
+    uint32_t tag;
+
+    bool operator==(const StatsKey& other) const {
+        return uid == other.uid && set == other.set && tag == other.tag && iface == other.iface;
+    }
+};
+
+struct StatsKeyHash {
+    size_t operator()(const StatsKey& key) const {
+        size_t hash = std::hash<std::string>()(key.iface);
+        hash = hash * 31 + key.uid;
+        hash = hash * 31 + key.set;
+        hash = hash * 31 + key.tag;
+        return hash;
+    }
+};
+
+struct StatsCounters {
+    uint64_t rxBytes;
+    uint64_t rxPackets;
+    uint64_t txBytes;
+    uint64_t txPackets;
+};
+
+struct StatsSnapshot {
+    std::mutex lock;
+    std::unordered_map<StatsKey, StatsCounters, StatsKeyHash> counters;
+};
+
 static struct {
     jfieldID size;
     jfieldID capacity;
@@ -60,6 +128,13 @@ static struct {
     jfieldID operations;
 } gNetworkStatsClassInfo;
 
+// Arrays are over-allocated when they have to grow so that a slowly growing
+// number of rows doesn't reallocate every array on every poll.
+static int grow_capacity(int size)
+{
+    return size + size / 2;
+}
+
 static jobjectArray get_string_array(JNIEnv* env, jobject obj, jfieldID field, int size, bool grow)
 {
     if (!grow) {
@@ -210,47 +285,47 @@ static int statsLinesToNetworkStats(JNIEnv* env, jclass clazz, jobject stats,
     int size = lines.size();
 
     bool grow = size > env->GetIntField(stats, gNetworkStatsClassInfo.capacity);
+    int capacity = grow ? grow_capacity(size) : size;
 
     ScopedLocalRef<jobjectArray> iface(env, get_string_array(env, stats,
-            gNetworkStatsClassInfo.iface, size, grow));
+            gNetworkStatsClassInfo.iface, capacity, grow));
     if (iface.get() == NULL) return -1;
     ScopedIntArrayRW uid(env, get_int_array(env, stats,
-            gNetworkStatsClassInfo.uid, size, grow));
+            gNetworkStatsClassInfo.uid, capacity, grow));
     if (uid.get() == NULL) return -1;
     ScopedIntArrayRW set(env, get_int_array(env, stats,
-            gNetworkStatsClassInfo.set, size, grow));
+            gNetworkStatsClassInfo.set, capacity, grow));
     if (set.get() == NULL) return -1;
     ScopedIntArrayRW tag(env, get_int_array(env, stats,
-            gNetworkStatsClassInfo.tag, size, grow));
+            gNetworkStatsClassInfo.tag, capacity, grow));
     if (tag.get() == NULL) return -1;
     ScopedIntArrayRW metered(env, get_int_array(env, stats,
-            gNetworkStatsClassInfo.metered, size, grow));
+            gNetworkStatsClassInfo.metered, capacity, grow));
     if (metered.get() == NULL) return -1;
     ScopedIntArrayRW roaming(env, get_int_array(env, stats,
-            gNetworkStatsClassInfo.roaming, size, grow));
+            gNetworkStatsClassInfo.roaming, capacity, grow));
     if (roaming.get() == NULL) return -1;
     ScopedIntArrayRW defaultNetwork(env, get_int_array(env, stats,
-            gNetworkStatsClassInfo.defaultNetwork, size, grow));
+            gNetworkStatsClassInfo.defaultNetwork, capacity, grow));
     if (defaultNetwork.get() == NULL) return -1;
     ScopedLongArrayRW rxBytes(env, get_long_array(env, stats,
-            gNetworkStatsClassInfo.rxBytes, size, grow));
+            gNetworkStatsClassInfo.rxBytes, capacity, grow));
     if (rxBytes.get() == NULL) return -1;
     ScopedLongArrayRW rxPackets(env, get_long_array(env, stats,
-            gNetworkStatsClassInfo.rxPackets, size, grow));
+            gNetworkStatsClassInfo.rxPackets, capacity, grow));
     if (rxPackets.get() == NULL) return -1;
     ScopedLongArrayRW txBytes(env, get_long_array(env, stats,
-            gNetworkStatsClassInfo.txBytes, size, grow));
+            gNetworkStatsClassInfo.txBytes, capacity, grow));
     if (txBytes.get() == NULL) return -1;
     ScopedLongArrayRW txPackets(env, get_long_array(env, stats,
-            gNetworkStatsClassInfo.txPackets, size, grow));
+            gNetworkStatsClassInfo.txPackets, capacity, grow));
     if (txPackets.get() == NULL) return -1;
     ScopedLongArrayRW operations(env, get_long_array(env, stats,
-            gNetworkStatsClassInfo.operations, size, grow));
+            gNetworkStatsClassInfo.operations, capacity, grow));
     if (operations.get() == NULL) return -1;
 
     for (int i = 0; i < size; i++) {
-        ScopedLocalRef<jstring> ifaceString(env, env->NewStringUTF(lines[i].iface));
-        env->SetObjectArrayElement(iface.get(), i, ifaceString.get());
+        env->SetObjectArrayElement(iface.get(), i, get_iface_string(env, lines[i].iface));
 
         uid[i] = lines[i].uid;
         set[i] = lines[i].set;
@@ -264,7 +339,7 @@ static int statsLinesToNetworkStats(JNIEnv* env, jclass clazz, jobject stats,
 
     env->SetIntField(stats, gNetworkStatsClassInfo.size, size);
     if (grow) {
-        env->SetIntField(stats, gNetworkStatsClassInfo.capacity, size);
+        env->SetIntField(stats, gNetworkStatsClassInfo.capacity, capacity);
         env->SetObjectField(stats, gNetworkStatsClassInfo.iface, iface.get());
         env->SetObjectField(stats, gNetworkStatsClassInfo.uid, uid.getJavaArray());
         env->SetObjectField(stats, gNetworkStatsClassInfo.set, set.getJavaArray());
@@ -282,9 +357,9 @@ static int statsLinesToNetworkStats(JNIEnv* env, jclass clazz, jobject stats,
     return 0;
 }
 
-static int readNetworkStatsDetail(JNIEnv* env, jclass clazz, jobject stats, jstring path,
-                                  jint limitUid, jobjectArray limitIfacesObj, jint limitTag,
-                                  jboolean useBpfStats) {
+static int readStatsLines(JNIEnv* env, std::vector<stats_line>* lines, jstring path,
+                          jint limitUid, jobjectArray limitIfacesObj, jint limitTag,
+                          jboolean useBpfStats) {
 
     std::vector<std::string> limitIfaces;
     if (limitIfacesObj != NULL && env->GetArrayLength(limitIfacesObj) > 0) {
@@ -297,11 +372,8 @@ static int readNetworkStatsDetail(JNIEnv* env, jclass clazz, jobject stats, jstr
             }
         }
     }
-    std::vector<stats_line> lines;
-
-
     if (useBpfStats) {
-        if (parseBpfNetworkStatsDetail(&lines, limitIfaces, limitTag, limitUid) < 0)
+        if (parseBpfNetworkStatsDetail(lines, limitIfaces, limitTag, limitUid) < 0)
             return -1;
     } else {
         ScopedUtfChars path8(env, path);
@@ -309,16 +381,72 @@ static int readNetworkStatsDetail(JNIEnv* env, jclass clazz, jobject stats, jstr
             ALOGE("the qtaguid legacy path is invalid: %s", path8.c_str());
             return -1;
         }
-        if (legacyReadNetworkStatsDetail(&lines, limitIfaces, limitTag,
+        if (legacyReadNetworkStatsDetail(lines, limitIfaces, limitTag,
                                          limitUid, path8.c_str()) < 0)
             return -1;
     }
+    return 0;
+}
+
+static int readNetworkStatsDetail(JNIEnv* env, jclass clazz, jobject stats, jstring path,
+                                  jint limitUid, jobjectArray limitIfacesObj, jint limitTag,
+                                  jboolean useBpfStats) {
+    // Reused across polls so the row buffer keeps its capacity.
+    thread_local std::vector<stats_line> lines;
+    lines.clear();
+
+    if (readStatsLines(env, &lines, path, limitUid, limitIfacesObj, limitTag, useBpfStats) < 0)
+        return -1;
+
+    return statsLinesToNetworkStats(env, clazz, stats, lines);
+}
+
+static jlong createStatsSnapshot(JNIEnv*, jclass) {
+    return reinterpret_cast<jlong>(new StatsSnapshot());
+}
+
+static void destroyStatsSnapshot(JNIEnv*, jclass, jlong snapshotPtr) {
+    delete reinterpret_cast<StatsSnapshot*>(snapshotPtr);
+}
+
+// Like readNetworkStatsDetail(), but only fills |stats| with the rows whose
+// counters differ from the previous read through |snapshotPtr|. Counters are
+// still absolute; rows that disappeared are not reported.
+static int readNetworkStatsDetailChanged(JNIEnv* env, jclass clazz, jlong snapshotPtr,
+                                         jobject stats, jstring path, jint limitUid,
+                                         jobjectArray limitIfacesObj, jint limitTag,
+                                         jboolean useBpfStats) {
+    StatsSnapshot* snapshot = reinterpret_cast<StatsSnapshot*>(snapshotPtr);
+    if (snapshot == NULL) {
+        jniThrowNullPointerException(env, "snapshot");
+        return -1;
+    }
+
+    thread_local std::vector<stats_line> lines;
+    lines.clear();
+    if (readStatsLines(env, &lines, path, limitUid, limitIfacesObj, limitTag, useBpfStats) < 0)
+        return -1;
+
+    std::lock_guard<std::mutex> lock(snapshot->lock);
+    size_t changed = 0;
+    for (const stats_line& line : lines) {
+        StatsCounters current = {line.rxBytes, line.rxPackets, line.txBytes, line.txPackets};
+        StatsCounters& previous =
+                snapshot->counters[StatsKey{line.iface, line.uid, line.set, line.tag}];
+        if (memcmp(&previous, &current, sizeof(current)) == 0) {
+            continue;
+        }
+        previous = current;
+        lines[changed++] = line;
+    }
+    lines.resize(changed);
 
     return statsLinesToNetworkStats(env, clazz, stats, lines);
 }
 
 static int readNetworkStatsDev(JNIEnv* env, jclass clazz, jobject stats) {
-    std::vector<stats_line> lines;
+    thread_local std::vector<stats_line> lines;
+    lines.clear();
 
     if (parseBpfNetworkStatsDev(&lines) < 0)
             return -1;
@@ -332,6 +460,11 @@ static const JNINativeMethod gMethods[] = {
                 (void*) readNetworkStatsDetail },
         { "nativeReadNetworkStatsDev", "(Landroid/net/NetworkStats;)I",
                 (void*) readNetworkStatsDev },
+        { "nativeCreateStatsSnapshot", "()J", (void*) createStatsSnapshot },
+        { "nativeDestroyStatsSnapshot", "(J)V", (void*) destroyStatsSnapshot },
+        { "nativeReadNetworkStatsDetailChanged",
+                "(JLandroid/net/NetworkStats;Ljava/lang/String;I[Ljava/lang/String;IZ)I",
+                (void*) readNetworkStatsDetailChanged },
 };
 
 int register_android_server_net_NetworkStatsFactory(JNIEnv* env) {
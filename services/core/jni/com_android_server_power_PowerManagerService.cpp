@@ -30,6 +30,13 @@
 #include <nativehelper/ScopedUtfChars.h>
 
 #include <limits.h>
+#include <pthread.h>
+
+#include <algorithm>
+#include <condition_variable>
+#include <map>
+#include <mutex>
+#include <thread>
 
 #include <android-base/chrono_utils.h>
 #include <android_runtime/AndroidRuntime.h>
@@ -324,6 +331,68 @@ static void sendPowerHint(PowerHint hintId, uint32_t data) {
     SurfaceComposerClient::notifyPowerHint(static_cast<int32_t>(hintId));
 }
 
+// Sends boosts and legacy hints to the power HAL from a dedicated thread so that
+// input and binder threads never block on a slow HAL. Requests that pile up
+// while a HAL call is in flight are coalesced: a boost keeps its longest
+// duration, a hint its latest data.
+class PowerHintDispatcher {
+public:
+    static PowerHintDispatcher& getInstance() {
+        static PowerHintDispatcher* sInstance = new PowerHintDispatcher();
+        return *sInstance;
+    }
+
+    void enqueueBoost(Boost boost, int32_t durationMs) {
+        std::lock_guard<std::mutex> lock(mLock);
+        auto [it, inserted] = mPendingBoosts.emplace(boost, durationMs);
+        if (!inserted) {
+            it->second = std::max(it->second, durationMs);
+        }
+        mCondition.notify_one();
+    }
+
+    void enqueueHint(PowerHint hintId, uint32_t data) {
+        std::lock_guard<std::mutex> lock(mLock);
+        mPendingHints[hintId] = data;
+        mCondition.notify_one();
+    }
+
+private:
+    PowerHintDispatcher() : mThread(&PowerHintDispatcher::threadLoop, this) {
+        mThread.detach();
+    }
+
+    void threadLoop() {
+        pthread_setname_np(pthread_self(), "PowerHintDisp");
+        std::unique_lock<std::mutex> lock(mLock);
+        while (true) {
+            mCondition.wait(lock, [this] {
+                return !mPendingBoosts.empty() || !mPendingHints.empty();
+            });
+            std::map<Boost, int32_t> boosts;
+            std::map<PowerHint, uint32_t> hints;
+            boosts.swap(mPendingBoosts);
+            hints.swap(mPendingHints);
+            lock.unlock();
+
+            for (const auto& [boost, durationMs] : boosts) {
+                setPowerBoost(boost, durationMs);
+            }
+            for (const auto& [hintId, data] : hints) {
+                sendPowerHint(hintId, data);
+            }
+
+            lock.lock();
+        }
+    }
+
+    std::mutex mLock;
+    std::condition_variable mCondition;
+    std::map<Boost, int32_t> mPendingBoosts;
+    std::map<PowerHint, uint32_t> mPendingHints;
+    std::thread mThread;
+};
+
 void android_server_PowerManagerService_userActivity(nsecs_t eventTime, int32_t eventType) {
     if (gPowerManagerServiceObj) {
         // Throttle calls into user activity by event type.
@@ -341,7 +410,7 @@ void android_server_PowerManagerService_userActivity(nsecs_t eventTime, int32_t
             gLastEventTime[eventType] = eventTime;
 
             // Tell the power HAL when user activity occurs.
-            sendPowerHint(PowerHint::INTERACTION, 0);
+            PowerHintDispatcher::getInstance().enqueueHint(PowerHint::INTERACTION, 0);
         }
 
         JNIEnv* env = AndroidRuntime::getJNIEnv();
@@ -473,12 +542,12 @@ static void nativeSetAutoSuspend(JNIEnv* /* env */, jclass /* clazz */, jboolean
 }
 
 static void nativeSendPowerHint(JNIEnv* /* env */, jclass /* clazz */, jint hintId, jint data) {
-    sendPowerHint(static_cast<PowerHint>(hintId), data);
+    PowerHintDispatcher::getInstance().enqueueHint(static_cast<PowerHint>(hintId), data);
 }
 
 static void nativeSetPowerBoost(JNIEnv* /* env */, jclass /* clazz */, jint boost,
                                 jint durationMs) {
-    setPowerBoost(static_cast<Boost>(boost), durationMs);
+    PowerHintDispatcher::getInstance().enqueueBoost(static_cast<Boost>(boost), durationMs);
 }
 
 static jboolean nativeSetPowerMode(JNIEnv* /* env */, jclass /* clazz */, jint mode,
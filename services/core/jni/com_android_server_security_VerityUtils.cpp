@@ -31,25 +31,28 @@
 #include <sys/stat.h>
 #include <sys/types.h>
 
+#include <algorithm>
+#include <atomic>
+#include <string>
+#include <thread>
+#include <vector>
+
 #include <android-base/unique_fd.h>
+#include <utils/Timers.h>
 
 namespace android {
 
 namespace {
 
-int enableFsverity(JNIEnv* env, jobject /* clazz */, jstring filePath, jbyteArray signature) {
-    ScopedUtfChars path(env, filePath);
-    if (path.c_str() == nullptr) {
-        return EINVAL;
-    }
-    ::android::base::unique_fd rfd(open(path.c_str(), O_RDONLY | O_CLOEXEC));
+// Enabling verity reads and hashes the whole file, so files of a multi-split
+// install are enabled concurrently on up to this many threads.
+constexpr size_t kMaxEnableThreads = 4;
+
+int enableFsverityForPath(const char* path, const jbyte* signature, size_t signatureSize) {
+    ::android::base::unique_fd rfd(open(path, O_RDONLY | O_CLOEXEC));
     if (rfd.get() < 0) {
         return errno;
     }
-    ScopedByteArrayRO signature_bytes(env, signature);
-    if (signature_bytes.get() == nullptr) {
-        return EINVAL;
-    }
 
     fsverity_enable_arg arg = {};
     arg.version = 1;
@@ -57,8 +60,8 @@ int enableFsverity(JNIEnv* env, jobject /* clazz */, jstring filePath, jbyteArra
     arg.block_size = 4096;
     arg.salt_size = 0;
     arg.salt_ptr = reinterpret_cast<uintptr_t>(nullptr);
-    arg.sig_size = signature_bytes.size();
-    arg.sig_ptr = reinterpret_cast<uintptr_t>(signature_bytes.get());
+    arg.sig_size = signatureSize;
+    arg.sig_ptr = reinterpret_cast<uintptr_t>(signature);
 
     if (ioctl(rfd.get(), FS_IOC_ENABLE_VERITY, &arg) < 0) {
         return errno;
@@ -66,6 +69,86 @@ int enableFsverity(JNIEnv* env, jobject /* clazz */, jstring filePath, jbyteArra
     return 0;
 }
 
+int enableFsverity(JNIEnv* env, jobject /* clazz */, jstring filePath, jbyteArray signature) {
+    ScopedUtfChars path(env, filePath);
+    if (path.c_str() == nullptr) {
+        return EINVAL;
+    }
+    ScopedByteArrayRO signature_bytes(env, signature);
+    if (signature_bytes.get() == nullptr) {
+        return EINVAL;
+    }
+    return enableFsverityForPath(path.c_str(), signature_bytes.get(), signature_bytes.size());
+}
+
+// Enables fs-verity on each of |filePaths| with the matching signature.
+// |outErrors| receives 0 or the errno for each file and, if non-null,
+// |outDurations| the time spent on it in nanoseconds.
+void enableFsverityBatch(JNIEnv* env, jobject /* clazz */, jobjectArray filePaths,
+                         jobjectArray signatures, jintArray outErrors, jlongArray outDurations) {
+    if (filePaths == nullptr || signatures == nullptr || outErrors == nullptr) {
+        jniThrowNullPointerException(env, nullptr);
+        return;
+    }
+    const jsize count = env->GetArrayLength(filePaths);
+    if (env->GetArrayLength(signatures) != count || env->GetArrayLength(outErrors) < count ||
+        (outDurations != nullptr && env->GetArrayLength(outDurations) < count)) {
+        jniThrowException(env, "java/lang/IllegalArgumentException", "array length mismatch");
+        return;
+    }
+
+    // Copy everything out of the Java arrays up front; the workers can't use JNI.
+    std::vector<std::string> paths(count);
+    std::vector<std::vector<jbyte>> sigs(count);
+    std::vector<jint> errors(count, 0);
+    std::vector<jlong> durations(count, 0);
+    for (jsize i = 0; i < count; i++) {
+        jstring pathString = static_cast<jstring>(env->GetObjectArrayElement(filePaths, i));
+        jbyteArray signature = static_cast<jbyteArray>(env->GetObjectArrayElement(signatures, i));
+        if (pathString == nullptr || signature == nullptr) {
+            errors[i] = EINVAL;
+        } else {
+            ScopedUtfChars path(env, pathString);
+            ScopedByteArrayRO signature_bytes(env, signature);
+            if (path.c_str() == nullptr || signature_bytes.get() == nullptr) {
+                return;
+            }
+            paths[i] = path.c_str();
+            sigs[i].assign(signature_bytes.get(), signature_bytes.get() + signature_bytes.size());
+        }
+        env->DeleteLocalRef(pathString);
+        env->DeleteLocalRef(signature);
+    }
+
+    std::atomic<jsize> next(0);
+    auto worker = [&]() {
+        for (jsize i = next++; i < count; i = next++) {
+            if (errors[i] != 0) {
+                continue;
+            }
+            const nsecs_t start = systemTime(SYSTEM_TIME_MONOTONIC);
+            errors[i] = enableFsverityForPath(paths[i].c_str(), sigs[i].data(), sigs[i].size());
+            durations[i] = systemTime(SYSTEM_TIME_MONOTONIC) - start;
+        }
+    };
+
+    // The calling thread takes a share of the files as well.
+    const size_t threadCount = std::min(static_cast<size_t>(count), kMaxEnableThreads);
+    std::vector<std::thread> threads;
+    for (size_t i = 1; i < threadCount; i++) {
+        threads.emplace_back(worker);
+    }
+    worker();
+    for (auto& thread : threads) {
+        thread.join();
+    }
+
+    env->SetIntArrayRegion(outErrors, 0, count, errors.data());
+    if (outDurations != nullptr) {
+        env->SetLongArrayRegion(outDurations, 0, count, durations.data());
+    }
+}
+
 // Returns whether the file has fs-verity enabled.
 // 0 if it is not present, 1 if is present, and -errno if there was an error.
 int statxForFsverity(JNIEnv *env, jobject /* clazz */, jstring filePath) {
@@ -87,6 +170,8 @@ int statxForFsverity(JNIEnv *env, jobject /* clazz */, jstring filePath) {
 
 const JNINativeMethod sMethods[] = {
         {"enableFsverityNative", "(Ljava/lang/String;[B)I", (void *)enableFsverity},
+        {"enableFsverityBatchNative", "([Ljava/lang/String;[[B[I[J)V",
+         (void *)enableFsverityBatch},
         {"statxForFsverityNative", "(Ljava/lang/String;)I", (void *)statxForFsverity},
 };
 
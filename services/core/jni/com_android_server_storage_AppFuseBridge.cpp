@@ -17,6 +17,8 @@
 // Need to use LOGE_EX.
 #define LOG_TAG "AppFuseBridge"
 
+#include <sys/socket.h>
+
 #include <android_runtime/Log.h>
 #include <android-base/logging.h>
 #include <android-base/unique_fd.h>
@@ -33,6 +35,20 @@ static jclass gAppFuseClass;
 static jmethodID gAppFuseOnMount;
 static jmethodID gAppFuseOnClosed;
 
+// SetupMessageSockets() sizes the socket buffers for a single message, so a
+// client can only have one read or write in flight before the next blocks on
+// the socket. Leave room for several so the app side can pipeline requests and
+// the bridge loop always has the next one queued.
+constexpr int kMaxPendingMessages = 8;
+
+void EnlargeMessageSocketBuffers(int fd) {
+    const int size = fuse::kFuseMaxMessageSize * kMaxPendingMessages;
+    if (setsockopt(fd, SOL_SOCKET, SO_SNDBUF, &size, sizeof(size)) != 0 ||
+        setsockopt(fd, SOL_SOCKET, SO_RCVBUF, &size, sizeof(size)) != 0) {
+        PLOG(WARNING) << "Failed to enlarge AppFuse socket buffers";
+    }
+}
+
 class Callback : public fuse::FuseBridgeLoopCallback {
     JNIEnv* mEnv;
     jobject mSelf;
@@ -115,6 +131,8 @@ jint com_android_server_storage_AppFuseBridge_add_bridge(
     if (!fuse::SetupMessageSockets(&proxyFd)) {
         return -1;
     }
+    EnlargeMessageSocketBuffers(proxyFd[0].get());
+    EnlargeMessageSocketBuffers(proxyFd[1].get());
 
     if (!loop->AddBridge(mountId, std::move(devFd), std::move(proxyFd[0]))) {
         return -1;
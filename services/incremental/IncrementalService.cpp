@@ -18,6 +18,7 @@
 
 #include "IncrementalService.h"
 
+#include <android-base/file.h>
 #include <android-base/logging.h>
 #include <android-base/no_destructor.h>
 #include <android-base/properties.h>
@@ -28,8 +29,12 @@
 #include <sys/stat.h>
 #include <uuid/uuid.h>
 
+#include <algorithm>
 #include <charconv>
+#include <cstdio>
+#include <cstring>
 #include <ctime>
+#include <filesystem>
 #include <iterator>
 #include <span>
 #include <type_traits>
@@ -53,6 +58,23 @@ namespace {
 
 using IncrementalFileSystemControlParcel = os::incremental::IncrementalFileSystemControlParcel;
 
+// Upper bound on the number of threads extracting native libraries.
+constexpr unsigned kMaxJobProcessors = 4;
+
+// Upper bound on the number of threads restoring existing images at boot.
+constexpr size_t kMaxMountThreads = 4;
+
+// Prefetch profiles are recorded by polling the read log at this interval and
+// hold at most this many blocks (~100MB of data at 4K per block).
+constexpr auto kPrefetchPollInterval = 100ms;
+constexpr size_t kMaxPrefetchBlocks = 25600;
+
+// On-disk prefetch profile: magic, block count, then (16-byte file id, block
+// index) records in access order.
+constexpr uint32_t kPrefetchProfileMagic = 0x50464e49; // "INFP"
+constexpr size_t kPrefetchHeaderSize = 2 * sizeof(uint32_t);
+constexpr size_t kPrefetchRecordSize = sizeof(FileId) + sizeof(BlockIndex);
+
 struct Constants {
     static constexpr auto backing = "backing_store"sv;
     static constexpr auto mount = "mount"sv;
@@ -61,6 +83,7 @@ struct Constants {
     static constexpr auto mountpointMdPrefix = ".mountpoint."sv;
     static constexpr auto infoMdName = ".info"sv;
     static constexpr auto readLogsDisabledMarkerName = ".readlogs_disabled"sv;
+    static constexpr auto prefetchDir = "prefetch"sv;
     static constexpr auto libDir = "lib"sv;
     static constexpr auto libSuffix = ".so"sv;
     static constexpr auto blockSize = 4096;
@@ -285,11 +308,14 @@ IncrementalService::IncrementalService(ServiceManagerWrapper&& sm, std::string_v
     CHECK(mLooper) << "Looper is unavailable";
     CHECK(mTimedQueue) << "TimedQueue is unavailable";
 
-    mJobQueue.reserve(16);
-    mJobProcessor = std::thread([this]() {
-        mJni->initializeForCurrentThread();
-        runJobProcessing();
-    });
+    const auto jobProcessorCount =
+            std::clamp<unsigned>(std::thread::hardware_concurrency() / 2, 1, kMaxJobProcessors);
+    for (unsigned i = 0; i < jobProcessorCount; ++i) {
+        mJobProcessors.emplace_back([this]() {
+            mJni->initializeForCurrentThread();
+            runJobProcessing();
+        });
+    }
     mCmdLooperThread = std::thread([this]() {
         mJni->initializeForCurrentThread();
         runCmdLooper();
@@ -305,7 +331,9 @@ IncrementalService::~IncrementalService() {
         mRunning = false;
     }
     mJobCondition.notify_all();
-    mJobProcessor.join();
+    for (auto& processor : mJobProcessors) {
+        processor.join();
+    }
     mLooper->wake();
     mCmdLooperThread.join();
     mTimedQueue->stop();
@@ -730,6 +758,11 @@ void IncrementalService::deleteStorageLocked(IncrementalService::IncFsMount& ifs
         mBindsByPath.erase(path);
     }
     mMounts.erase(ifs.mountId);
+
+    std::lock_guard metricsLock(mMetricsLock);
+    for (auto&& [id, _] : storages) {
+        mMetricsCache.erase(id);
+    }
 }
 
 StorageId IncrementalService::openStorage(std::string_view pathInMount) {
@@ -874,6 +907,66 @@ int IncrementalService::makeFile(StorageId storage, std::string_view path, int m
     return -EINVAL;
 }
 
+int IncrementalService::makeFiles(StorageId storage, std::span<const NewFile> files,
+                                  std::vector<int>* results) {
+    if (results) {
+        results->assign(files.size(), -EINVAL);
+    }
+    const auto ifs = getIfs(storage);
+    if (!ifs) {
+        return -EINVAL;
+    }
+
+    std::vector<std::string> normPaths;
+    normPaths.reserve(files.size());
+    {
+        std::unique_lock l(ifs->lock);
+        const auto storageInfo = ifs->storages.find(storage);
+        if (storageInfo == ifs->storages.end()) {
+            return -EINVAL;
+        }
+        for (auto&& file : files) {
+            normPaths.push_back(normalizePathToStorageLocked(*ifs, storageInfo, file.path));
+        }
+    }
+
+    int firstError = 0;
+    std::unordered_set<std::string_view> createdDirs;
+    for (size_t i = 0; i < files.size(); ++i) {
+        const auto& file = files[i];
+        const auto& normPath = normPaths[i];
+        const auto err = [&]() -> int {
+            if (normPath.empty()) {
+                LOG(ERROR) << "Internal error: storageId " << storage
+                           << " failed to normalize: " << file.path;
+                return -EINVAL;
+            }
+            if (const auto dir = path::dirname(normPath); !createdDirs.contains(dir)) {
+                if (auto err = mIncFs->makeDirs(ifs->control, dir, 0755); err < 0) {
+                    LOG(ERROR) << "Internal error: storageId " << storage
+                               << " failed to makeDirs for " << normPath << ": " << err;
+                    return err;
+                }
+                createdDirs.insert(dir);
+            }
+            if (auto err = mIncFs->makeFile(ifs->control, normPath, file.mode, file.id,
+                                            file.params)) {
+                LOG(ERROR) << "Internal error: storageId " << storage
+                           << " failed to makeFile: " << err;
+                return err;
+            }
+            return 0;
+        }();
+        if (results) {
+            (*results)[i] = err;
+        }
+        if (err && !firstError) {
+            firstError = err;
+        }
+    }
+    return firstError;
+}
+
 int IncrementalService::makeDir(StorageId storageId, std::string_view path, int mode) {
     if (auto ifs = getIfs(storageId)) {
         std::string normPath = normalizePathToStorage(*ifs, storageId, path);
@@ -1242,6 +1335,7 @@ void IncrementalService::mountExistingImages(
         PLOG(WARNING) << "Couldn't open the root incremental dir " << mIncrementalDir;
         return;
     }
+    std::vector<std::string> roots;
     while (auto entry = ::readdir(dir.get())) {
         if (entry->d_type != DT_DIR) {
             continue;
@@ -1253,10 +1347,30 @@ void IncrementalService::mountExistingImages(
         if (mountedRootNames.find(name) != mountedRootNames.end()) {
             continue;
         }
-        const auto root = path::join(mIncrementalDir, name);
-        if (!mountExistingImage(root)) {
-            IncFsMount::cleanupFilesystem(root);
+        roots.push_back(path::join(mIncrementalDir, name));
+    }
+
+    // Each image costs a vold round trip, metadata reads and bind mounts, so
+    // restore them concurrently to keep boot time flat with many installs.
+    std::atomic<size_t> next = 0;
+    auto worker = [&]() {
+        for (size_t i = next++; i < roots.size(); i = next++) {
+            if (!mountExistingImage(roots[i])) {
+                IncFsMount::cleanupFilesystem(roots[i]);
+            }
         }
+    };
+    const auto threadCount = std::min<size_t>(roots.size(), kMaxMountThreads);
+    std::vector<std::thread> threads;
+    for (size_t i = 1; i < threadCount; ++i) {
+        threads.emplace_back([this, &worker]() {
+            mJni->initializeForCurrentThread();
+            worker();
+        });
+    }
+    worker();
+    for (auto&& thread : threads) {
+        thread.join();
     }
 }
 
@@ -1286,7 +1400,10 @@ bool IncrementalService::mountExistingImage(std::string_view root) {
     }
 
     ifs->mountId = mount.storage().id();
-    mNextId = std::max(mNextId, ifs->mountId + 1);
+    {
+        std::lock_guard l(mLock);
+        mNextId = std::max(mNextId, ifs->mountId + 1);
+    }
 
     // Check if marker file present.
     if (checkReadLogsDisabledMarker(mountTarget)) {
@@ -1337,16 +1454,19 @@ bool IncrementalService::mountExistingImage(std::string_view root) {
                                  << root;
                     continue;
                 }
-                auto [_, inserted] = mMounts.try_emplace(storageId, ifs);
-                if (!inserted) {
-                    LOG(WARNING) << "Ignoring storage with duplicate id " << storageId
-                                 << " for mount " << root;
-                    continue;
+                {
+                    std::lock_guard l(mLock);
+                    auto [_, inserted] = mMounts.try_emplace(storageId, ifs);
+                    if (!inserted) {
+                        LOG(WARNING) << "Ignoring storage with duplicate id " << storageId
+                                     << " for mount " << root;
+                        continue;
+                    }
+                    mNextId = std::max(mNextId, storageId + 1);
                 }
                 ifs->storages.insert_or_assign(storageId,
                                                IncFsMount::Storage{
                                                        path::join(root, constants().mount, name)});
-                mNextId = std::max(mNextId, storageId + 1);
             }
         }
     }
@@ -1373,7 +1493,9 @@ bool IncrementalService::mountExistingImage(std::string_view root) {
         return false;
     }
 
-    // not locking here at all: we're still in the constructor, no other calls can happen
+    // Other images are being restored concurrently, so this needs the lock even
+    // though we're still in the constructor.
+    std::lock_guard l(mLock);
     mMounts[ifs->mountId] = std::move(ifs);
     return true;
 }
@@ -1556,12 +1678,8 @@ bool IncrementalService::configureNativeBinaries(StorageId storage, std::string_
             std::lock_guard lock(mJobMutex);
             if (mRunning) {
                 auto& existingJobs = mJobQueue[ifs->mountId];
-                if (existingJobs.empty()) {
-                    existingJobs = std::move(jobQueue);
-                } else {
-                    existingJobs.insert(existingJobs.end(), std::move_iterator(jobQueue.begin()),
-                                        std::move_iterator(jobQueue.end()));
-                }
+                existingJobs.insert(existingJobs.end(), std::move_iterator(jobQueue.begin()),
+                                    std::move_iterator(jobQueue.end()));
             }
         }
         mJobCondition.notify_all();
@@ -1668,11 +1786,214 @@ bool IncrementalService::waitForNativeBinariesExtraction(StorageId storage) {
     std::unique_lock lock(mJobMutex);
     mJobCondition.wait(lock, [this, mount] {
         return !mRunning ||
-                (mPendingJobsMount != mount && mJobQueue.find(mount) == mJobQueue.end());
+                (mRunningJobs.find(mount) == mRunningJobs.end() &&
+                 mJobQueue.find(mount) == mJobQueue.end());
     });
     return mRunning;
 }
 
+std::string IncrementalService::prefetchProfilePath(std::string_view profileName) const {
+    if (profileName.empty() || profileName == "." || profileName == ".." ||
+        profileName.find('/') != std::string_view::npos) {
+        return {};
+    }
+    return path::join(mIncrementalDir, constants().prefetchDir, profileName);
+}
+
+int IncrementalService::recordPrefetchProfile(StorageId storage, std::string_view profileName,
+                                              Milliseconds duration) {
+    auto profilePath = prefetchProfilePath(profileName);
+    if (profilePath.empty()) {
+        LOG(ERROR) << "Invalid prefetch profile name: " << profileName;
+        return -EINVAL;
+    }
+    const auto ifs = getIfs(storage);
+    if (!ifs) {
+        LOG(ERROR) << "recordPrefetchProfile failed, invalid storageId: " << storage;
+        return -EINVAL;
+    }
+    {
+        std::unique_lock l(ifs->lock);
+        if (!ifs->readLogsEnabled()) {
+            LOG(ERROR) << "recordPrefetchProfile failed, read logs are disabled for " << storage;
+            return -EPERM;
+        }
+    }
+    // Use a control of our own so the data loader keeps its read log position.
+    auto control = mIncFs->openMount(path::join(ifs->root, constants().mount));
+    if (control.logs() < 0) {
+        LOG(ERROR) << "recordPrefetchProfile failed, no read log for storage " << storage;
+        return -EINVAL;
+    }
+    if (!mkdirOrLog(path::join(mIncrementalDir, constants().prefetchDir), 0700)) {
+        return -EIO;
+    }
+
+    auto recording = std::make_shared<PrefetchRecording>();
+    recording->profilePath = std::move(profilePath);
+    recording->control = std::move(control);
+    recording->deadline = Clock::now() + duration;
+    const auto mountId = ifs->mountId;
+    addTimedJob(mountId, kPrefetchPollInterval,
+                [this, mountId, recording]() { recordPrefetchStep(mountId, recording); });
+    return 0;
+}
+
+void IncrementalService::recordPrefetchStep(MountId id, const PrefetchRecordingPtr& recording) {
+    auto& blocks = recording->blocks;
+    auto& reads = recording->reads;
+    while (blocks.size() < kMaxPrefetchBlocks) {
+        reads.clear();
+        if (mIncFs->waitForPageReads(recording->control, 0ms, &reads) !=
+                    incfs::WaitResult::HaveData ||
+            reads.empty()) {
+            break;
+        }
+        for (auto&& read : reads) {
+            std::string key(read.id.data, sizeof(read.id.data));
+            key.append(reinterpret_cast<const char*>(&read.block), sizeof(read.block));
+            if (recording->seen.insert(std::move(key)).second) {
+                blocks.push_back({read.id, read.block});
+                if (blocks.size() >= kMaxPrefetchBlocks) {
+                    break;
+                }
+            }
+        }
+    }
+
+    if (blocks.size() < kMaxPrefetchBlocks && Clock::now() < recording->deadline) {
+        addTimedJob(id, kPrefetchPollInterval,
+                    [this, id, recording]() { recordPrefetchStep(id, recording); });
+        return;
+    }
+    savePrefetchProfile(*recording);
+}
+
+bool IncrementalService::savePrefetchProfile(const PrefetchRecording& recording) {
+    const uint32_t header[] = {kPrefetchProfileMagic, uint32_t(recording.blocks.size())};
+    std::string data(reinterpret_cast<const char*>(header), sizeof(header));
+    data.reserve(kPrefetchHeaderSize + recording.blocks.size() * kPrefetchRecordSize);
+    for (auto&& block : recording.blocks) {
+        data.append(block.id.data, sizeof(block.id.data));
+        data.append(reinterpret_cast<const char*>(&block.block), sizeof(block.block));
+    }
+
+    // Write to a temporary file first so a reader never sees a partial profile.
+    const auto tmpPath = recording.profilePath + ".tmp";
+    if (!base::WriteStringToFile(data, tmpPath)) {
+        PLOG(ERROR) << "Failed to write prefetch profile " << tmpPath;
+        ::unlink(tmpPath.c_str());
+        return false;
+    }
+    if (::rename(tmpPath.c_str(), recording.profilePath.c_str())) {
+        PLOG(ERROR) << "Failed to save prefetch profile " << recording.profilePath;
+        ::unlink(tmpPath.c_str());
+        return false;
+    }
+    LOG(INFO) << "Saved " << recording.blocks.size() << " blocks into prefetch profile "
+              << recording.profilePath;
+    return true;
+}
+
+std::vector<IncrementalService::PrefetchBlock> IncrementalService::loadPrefetchProfile(
+        std::string_view profileName) const {
+    const auto profilePath = prefetchProfilePath(profileName);
+    std::string data;
+    if (profilePath.empty() || !base::ReadFileToString(profilePath, &data)) {
+        return {};
+    }
+    uint32_t header[2];
+    if (data.size() < kPrefetchHeaderSize) {
+        LOG(ERROR) << "Truncated prefetch profile " << profilePath;
+        return {};
+    }
+    memcpy(header, data.data(), sizeof(header));
+    if (header[0] != kPrefetchProfileMagic ||
+        data.size() != kPrefetchHeaderSize + size_t(header[1]) * kPrefetchRecordSize) {
+        LOG(ERROR) << "Corrupted prefetch profile " << profilePath;
+        return {};
+    }
+
+    std::vector<PrefetchBlock> blocks(header[1]);
+    auto ptr = data.data() + kPrefetchHeaderSize;
+    for (auto&& block : blocks) {
+        memcpy(block.id.data, ptr, sizeof(block.id.data));
+        memcpy(&block.block, ptr + sizeof(block.id.data), sizeof(block.block));
+        ptr += kPrefetchRecordSize;
+    }
+    return blocks;
+}
+
+int IncrementalService::getStorageMetrics(StorageId storage, StorageMetrics* metrics) {
+    const auto ifs = getIfs(storage);
+    if (!ifs) {
+        return -EINVAL;
+    }
+    std::string storagePath;
+    {
+        std::unique_lock l(ifs->lock);
+        const auto storageInfo = ifs->storages.find(storage);
+        if (storageInfo == ifs->storages.end()) {
+            return -EINVAL;
+        }
+        storagePath = storageInfo->second.name;
+    }
+
+    std::lock_guard l(mMetricsLock);
+    auto& cached = mMetricsCache[storage];
+    if (cached.updatedTs == TimePoint{} || Clock::now() - cached.updatedTs >= kStorageMetricsTtl) {
+        updateStorageMetrics(*ifs, storagePath, cached);
+    }
+    *metrics = cached.metrics;
+    return 0;
+}
+
+void IncrementalService::updateStorageMetrics(const IncFsMount& ifs, std::string_view storagePath,
+                                              CachedStorageMetrics& cached) {
+    StorageMetrics metrics;
+
+    std::error_code ec;
+    for (auto it = fs::recursive_directory_iterator(storagePath, ec);
+         !ec && it != fs::recursive_directory_iterator(); it.increment(ec)) {
+        if (!it->is_regular_file(ec)) {
+            continue;
+        }
+        const auto [filled, total] = mIncFs->countFilledBlocks(ifs.control, it->path().c_str());
+        if (filled < 0 || total < 0) {
+            continue;
+        }
+        metrics.filledBlocks += filled;
+        metrics.totalBlocks += total;
+    }
+
+    if (cached.control.pendingReads() < 0) {
+        cached.control = mIncFs->openMount(path::join(ifs.root, constants().mount));
+    }
+    std::vector<incfs::ReadInfo> pendingReads;
+    if (cached.control.pendingReads() >= 0 &&
+        mIncFs->waitForPendingReads(cached.control, 0ms, &pendingReads) ==
+                incfs::WaitResult::HaveData) {
+        struct timespec now;
+        clock_gettime(CLOCK_BOOTTIME, &now);
+        const auto nowUs = BootClockTsUs(now.tv_sec) * 1000000 + now.tv_nsec / 1000;
+        static constexpr BootClockTsUs kBucketLimitsUs[] = {10000, 50000, 100000, 500000,
+                                                            1000000};
+        for (auto&& pendingRead : pendingReads) {
+            const auto ageUs = nowUs > pendingRead.bootClockTsUs
+                    ? nowUs - pendingRead.bootClockTsUs
+                    : 0;
+            const auto bucket = std::upper_bound(std::begin(kBucketLimitsUs),
+                                                 std::end(kBucketLimitsUs), ageUs) -
+                    std::begin(kBucketLimitsUs);
+            ++metrics.pendingReadAgeHistogram[bucket];
+        }
+        metrics.pendingReads = pendingReads.size();
+    }
+
+    cached.metrics = metrics;
+    cached.updatedTs = Clock::now();
+}
+
 bool IncrementalService::perfLoggingEnabled() {
     static const bool enabled = base::GetBoolProperty("incremental.perflogging", false);
     return enabled;
@@ -1686,18 +2007,28 @@ void IncrementalService::runJobProcessing() {
             return;
         }
 
-        auto it = mJobQueue.begin();
-        mPendingJobsMount = it->first;
-        auto queue = std::move(it->second);
-        mJobQueue.erase(it);
+        // Take turns between mounts so that one app with many large libraries
+        // doesn't hold up the extraction for others installing at the same time.
+        auto it = mJobQueue.upper_bound(mLastJobMount);
+        if (it == mJobQueue.end()) {
+            it = mJobQueue.begin();
+        }
+        const auto mount = it->first;
+        auto job = std::move(it->second.front());
+        it->second.pop_front();
+        if (it->second.empty()) {
+            mJobQueue.erase(it);
+        }
+        mLastJobMount = mount;
+        ++mRunningJobs[mount];
         lock.unlock();
 
-        for (auto&& job : queue) {
-            job();
-        }
+        job();
 
         lock.lock();
-        mPendingJobsMount = kInvalidStorageId;
+        if (--mRunningJobs[mount] == 0) {
+            mRunningJobs.erase(mount);
+        }
         lock.unlock();
         mJobCondition.notify_all();
     }
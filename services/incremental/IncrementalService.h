@@ -28,9 +28,11 @@
 #include <utils/StrongPointer.h>
 #include <ziparchive/zip_archive.h>
 
+#include <array>
 #include <atomic>
 #include <chrono>
 #include <condition_variable>
+#include <deque>
 #include <functional>
 #include <limits>
 #include <map>
@@ -125,6 +127,19 @@ public:
 
     int makeFile(StorageId storage, std::string_view path, int mode, FileId id,
                  incfs::NewFileParams params);
+
+    struct NewFile {
+        std::string_view path;
+        int mode;
+        FileId id;
+        incfs::NewFileParams params;
+    };
+    // Creates a whole file manifest in |storage|, including missing parent
+    // directories. Paths are resolved under a single lock acquisition and each
+    // directory is created once. |results|, if set, receives the per-file error
+    // code; the first error is returned.
+    int makeFiles(StorageId storage, std::span<const NewFile> files,
+                  std::vector<int>* results = nullptr);
     int makeDir(StorageId storage, std::string_view path, int mode = 0755);
     int makeDirs(StorageId storage, std::string_view path, int mode = 0755);
 
@@ -146,6 +161,32 @@ public:
                                  bool extractNativeLibs);
     bool waitForNativeBinariesExtraction(StorageId storage);
 
+    // A single block read recorded from the IncFS read log, in access order.
+    struct PrefetchBlock {
+        FileId id;
+        BlockIndex block;
+    };
+
+    // Records the order of page reads on |storage| for |duration| and saves it
+    // under |profileName|. Requires read logs to be enabled for the storage.
+    int recordPrefetchProfile(StorageId storage, std::string_view profileName,
+                              Milliseconds duration);
+    std::vector<PrefetchBlock> loadPrefetchProfile(std::string_view profileName) const;
+
+    // Loading progress and outstanding page reads of a storage. Pending reads
+    // are counted for the whole IncFS mount the storage lives on.
+    struct StorageMetrics {
+        int64_t filledBlocks = 0;
+        int64_t totalBlocks = 0;
+        int pendingReads = 0;
+        // Pending reads by age: <10ms, <50ms, <100ms, <500ms, <1s, >=1s.
+        std::array<int, 6> pendingReadAgeHistogram = {};
+    };
+    // Returns 0 and fills |metrics|, or a negative errno. IncFS is queried at
+    // most once per kStorageMetricsTtl for each storage.
+    static constexpr auto kStorageMetricsTtl = std::chrono::milliseconds(500);
+    int getStorageMetrics(StorageId storage, StorageMetrics* metrics);
+
     class AppOpsListener : public android::BnAppOpsCallback {
     public:
         AppOpsListener(IncrementalService& incrementalService, std::string packageName)
@@ -295,6 +336,23 @@ private:
     };
 
     using IfsMountPtr = std::shared_ptr<IncFsMount>;
+
+    struct PrefetchRecording {
+        std::string profilePath;
+        incfs::UniqueControl control;
+        TimePoint deadline;
+        std::vector<incfs::ReadInfo> reads;
+        std::vector<PrefetchBlock> blocks;
+        std::unordered_set<std::string> seen;
+    };
+    using PrefetchRecordingPtr = std::shared_ptr<PrefetchRecording>;
+
+    struct CachedStorageMetrics {
+        StorageMetrics metrics;
+        TimePoint updatedTs;
+        incfs::UniqueControl control;
+    };
+
     using MountMap = std::unordered_map<MountId, IfsMountPtr>;
     using BindPathMap = std::map<std::string, IncFsMount::BindMap::iterator, path::PathLess>;
 
@@ -352,6 +410,13 @@ private:
 
     void runCmdLooper();
 
+    std::string prefetchProfilePath(std::string_view profileName) const;
+    void recordPrefetchStep(MountId id, const PrefetchRecordingPtr& recording);
+    bool savePrefetchProfile(const PrefetchRecording& recording);
+
+    void updateStorageMetrics(const IncFsMount& ifs, std::string_view storagePath,
+                              CachedStorageMetrics& cached);
+
     void addTimedJob(MountId id, Milliseconds after, Job what);
     void removeTimedJobs(MountId id);
 
@@ -373,16 +438,23 @@ private:
     std::mutex mCallbacksLock;
     std::map<std::string, sp<AppOpsListener>> mCallbackRegistered;
 
+    // Held while refreshing, so concurrent queries share a single IncFS scan.
+    std::mutex mMetricsLock;
+    std::unordered_map<StorageId, CachedStorageMetrics> mMetricsCache;
+
     std::atomic_bool mSystemReady = false;
     StorageId mNextId = 0;
 
     std::atomic_bool mRunning{true};
 
-    std::unordered_map<MountId, std::vector<Job>> mJobQueue;
-    MountId mPendingJobsMount = kInvalidStorageId;
+    // Native library extraction jobs, queued per mount and run by a small pool
+    // of processors that take turns between mounts.
+    std::map<MountId, std::deque<Job>> mJobQueue;
+    std::unordered_map<MountId, int> mRunningJobs;
+    MountId mLastJobMount = kInvalidStorageId;
     std::condition_variable mJobCondition;
     std::mutex mJobMutex;
-    std::thread mJobProcessor;
+    std::vector<std::thread> mJobProcessors;
 
     std::thread mCmdLooperThread;
 };
@@ -23,6 +23,8 @@
 #include <android/content/pm/IDataLoaderManager.h>
 #include <android/os/IVold.h>
 #include <binder/AppOpsManager.h>
+#include <fcntl.h>
+#include <sys/stat.h>
 #include <utils/String16.h>
 
 #include <thread>
@@ -35,6 +37,7 @@ namespace android::incremental {
 
 static constexpr auto kVoldServiceName = "vold"sv;
 static constexpr auto kDataLoaderManagerName = "dataloader_manager"sv;
+static constexpr int64_t kBlockSize = 4096;
 
 class RealVoldService : public VoldServiceWrapper {
 public:
@@ -181,6 +184,30 @@ public:
                                    std::vector<incfs::ReadInfo>* pendingReadsBuffer) const final {
         return incfs::waitForPendingReads(control, timeout, pendingReadsBuffer);
     }
+    std::pair<int64_t, int64_t> countFilledBlocks(const Control& control,
+                                                  std::string_view path) const final {
+        base::unique_fd fd(::open(std::string(path).c_str(), O_RDONLY | O_CLOEXEC));
+        if (fd < 0) {
+            return {-errno, -errno};
+        }
+        struct stat st;
+        if (::fstat(fd.get(), &st)) {
+            return {-errno, -errno};
+        }
+        auto [err, ranges] = incfs::getFilledRanges(fd.get());
+        if (err) {
+            return {err, err};
+        }
+        int64_t filled = 0;
+        for (auto&& range : ranges.dataRanges()) {
+            filled += range.size();
+        }
+        return {filled, (st.st_size + kBlockSize - 1) / kBlockSize};
+    }
+    WaitResult waitForPageReads(const Control& control, std::chrono::milliseconds timeout,
+                                std::vector<incfs::ReadInfo>* pageReadsBuffer) const final {
+        return incfs::waitForPageReads(control, timeout, pageReadsBuffer);
+    }
 };
 
 static JNIEnv* getOrAttachJniEnv(JavaVM* jvm);
@@ -99,6 +99,11 @@ public:
     virtual WaitResult waitForPendingReads(
             const Control& control, std::chrono::milliseconds timeout,
             std::vector<incfs::ReadInfo>* pendingReadsBuffer) const = 0;
+    // Returns {filled, total} data blocks of the file at |path|, or a negative errno.
+    virtual std::pair<int64_t, int64_t> countFilledBlocks(const Control& control,
+                                                          std::string_view path) const = 0;
+    virtual WaitResult waitForPageReads(const Control& control, std::chrono::milliseconds timeout,
+                                        std::vector<incfs::ReadInfo>* pageReadsBuffer) const = 0;
 };
 
 class AppOpsManagerWrapper {
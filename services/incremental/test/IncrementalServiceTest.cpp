@@ -268,6 +268,8 @@ private:
 
 class MockIncFs : public IncFsWrapper {
 public:
+    using BlockCounts = std::pair<int64_t, int64_t>;
+
     MOCK_CONST_METHOD1(listExistingMounts, void(const ExistingMountCallback& cb));
     MOCK_CONST_METHOD1(openMount, Control(std::string_view path));
     MOCK_CONST_METHOD3(createControl, Control(IncFsFd cmd, IncFsFd pendingReads, IncFsFd logs));
@@ -288,6 +290,11 @@ public:
     MOCK_CONST_METHOD3(waitForPendingReads,
                        WaitResult(const Control& control, std::chrono::milliseconds timeout,
                                   std::vector<incfs::ReadInfo>* pendingReadsBuffer));
+    MOCK_CONST_METHOD2(countFilledBlocks,
+                       BlockCounts(const Control& control, std::string_view path));
+    MOCK_CONST_METHOD3(waitForPageReads,
+                       WaitResult(const Control& control, std::chrono::milliseconds timeout,
+                                  std::vector<incfs::ReadInfo>* pageReadsBuffer));
 
     MockIncFs() { ON_CALL(*this, listExistingMounts(_)).WillByDefault(Return()); }
 
@@ -318,6 +325,11 @@ public:
         return UniqueControl(IncFs_CreateControl(-1, kPendingReadsFd, -1));
     }
 
+    static constexpr auto kLogsFd = 43;
+    Control openMountForReadLogs(std::string_view) {
+        return UniqueControl(IncFs_CreateControl(-1, -1, kLogsFd));
+    }
+
     RawMetadata getMountInfoMetadata(const Control& control, std::string_view path) {
         metadata::Mount m;
         m.mutable_storage()->set_id(100);
@@ -1078,4 +1090,102 @@ TEST_F(IncrementalServiceTest, testMakeDirectories) {
     auto res = mIncrementalService->makeDirs(storageId, dir_path, 0555);
     ASSERT_EQ(res, 0);
 }
+
+TEST_F(IncrementalServiceTest, testMakeFiles) {
+    mVold->mountIncFsSuccess();
+    mIncFs->makeFileSuccess();
+    mVold->bindMountSuccess();
+    mDataLoaderManager->bindToDataLoaderSuccess();
+    mDataLoaderManager->getDataLoaderSuccess();
+    TemporaryDir tempDir;
+    int storageId = mIncrementalService->createStorage(tempDir.path, std::move(mDataLoaderParcel),
+                                                       IncrementalService::CreateOptions::CreateNew,
+                                                       {}, {}, {});
+    const IncrementalService::NewFile files[] = {
+            {.path = "base.apk", .mode = 0777, .id = FileId{{'a'}}, .params = {.size = 4096}},
+            {.path = "obb/main.obb", .mode = 0777, .id = FileId{{'b'}}, .params = {.size = 1}},
+            {.path = "obb/patch.obb", .mode = 0777, .id = FileId{{'c'}}, .params = {.size = 1}},
+    };
+
+    // Each parent directory is created once.
+    EXPECT_CALL(*mIncFs, makeDirs(_, Truly([&](std::string_view arg) {
+                                      return arg.ends_with("/mount/st_1_0");
+                                  }),
+                                  _));
+    EXPECT_CALL(*mIncFs, makeDirs(_, Truly([&](std::string_view arg) {
+                                      return arg.ends_with("/mount/st_1_0/obb");
+                                  }),
+                                  _));
+    EXPECT_CALL(*mIncFs, makeFile(_, _, _, _, _)).Times(3);
+    std::vector<int> results;
+    ASSERT_EQ(0, mIncrementalService->makeFiles(storageId, files, &results));
+    ASSERT_EQ(std::vector<int>(3, 0), results);
+}
+
+TEST_F(IncrementalServiceTest, testGetStorageMetrics) {
+    mVold->mountIncFsSuccess();
+    mIncFs->makeFileSuccess();
+    mVold->bindMountSuccess();
+    mDataLoaderManager->bindToDataLoaderSuccess();
+    mDataLoaderManager->getDataLoaderSuccess();
+    TemporaryDir tempDir;
+    int storageId = mIncrementalService->createStorage(tempDir.path, std::move(mDataLoaderParcel),
+                                                       IncrementalService::CreateOptions::CreateNew,
+                                                       {}, {}, {});
+    ASSERT_GE(storageId, 0);
+    mIncFs->openMountSuccess();
+    mIncFs->waitForPendingReadsSuccess();
+
+    // The second query within the TTL is served from the cache.
+    EXPECT_CALL(*mIncFs, waitForPendingReads(_, _, _)).Times(1);
+    IncrementalService::StorageMetrics metrics;
+    ASSERT_EQ(0, mIncrementalService->getStorageMetrics(storageId, &metrics));
+    ASSERT_EQ(1, metrics.pendingReads);
+    ASSERT_EQ(1, metrics.pendingReadAgeHistogram.back());
+    ASSERT_EQ(0, mIncrementalService->getStorageMetrics(storageId, &metrics));
+    ASSERT_EQ(1, metrics.pendingReads);
+
+    ASSERT_EQ(-EINVAL, mIncrementalService->getStorageMetrics(storageId + 1000, &metrics));
+}
+
+TEST_F(IncrementalServiceTest, testRecordPrefetchProfile) {
+    mVold->mountIncFsSuccess();
+    mIncFs->makeFileSuccess();
+    mVold->bindMountSuccess();
+    mDataLoaderManager->bindToDataLoaderSuccess();
+    mDataLoaderManager->getDataLoaderSuccess();
+    TemporaryDir tempDir;
+    int storageId = mIncrementalService->createStorage(tempDir.path, std::move(mDataLoaderParcel),
+                                                       IncrementalService::CreateOptions::CreateNew,
+                                                       {}, {}, {});
+    ASSERT_GE(storageId, 0);
+
+    const FileId first{{'a'}};
+    const FileId second{{'b'}};
+    ON_CALL(*mIncFs, openMount(_)).WillByDefault(Invoke(mIncFs, &MockIncFs::openMountForReadLogs));
+    EXPECT_CALL(*mIncFs, waitForPageReads(_, _, _))
+            .WillOnce(Invoke([&](const Control&, std::chrono::milliseconds,
+                                 std::vector<incfs::ReadInfo>* pageReadsBuffer) {
+                pageReadsBuffer->push_back({.id = second, .block = 7});
+                pageReadsBuffer->push_back({.id = first, .block = 0});
+                pageReadsBuffer->push_back({.id = second, .block = 7});
+                return android::incfs::WaitResult::HaveData;
+            }))
+            .WillOnce(Return(android::incfs::WaitResult::Timeout));
+
+    ASSERT_EQ(0, mIncrementalService->recordPrefetchProfile(storageId, "com.test", 0ms));
+    ASSERT_EQ(storageId, mTimedQueue->mId);
+    auto timedCallback = mTimedQueue->mWhat;
+    mTimedQueue->clearJob(storageId);
+    timedCallback();
+
+    const auto blocks = mIncrementalService->loadPrefetchProfile("com.test");
+    ASSERT_EQ(2u, blocks.size());
+    ASSERT_EQ(second, blocks[0].id);
+    ASSERT_EQ(7, blocks[0].block);
+    ASSERT_EQ(first, blocks[1].id);
+    ASSERT_EQ(0, blocks[1].block);
+
+    ASSERT_EQ(-EINVAL, mIncrementalService->recordPrefetchProfile(storageId, "../x", 0ms));
+}
 } // namespace android::os::incremental
@@ -24,9 +24,13 @@
 #include "androidfw/AssetManager2.h"
 #include "androidfw/ResourceTypes.h"
 
+#include <unistd.h>
+
+#include <fstream>
 #include <iostream>
 #include <locale>
 
+#include "android-base/file.h"
 #include "android-base/stringprintf.h"
 
 namespace startop {
@@ -55,7 +59,7 @@ class ResXmlVisitorAdapter {
           depth++;
           size_t name_length = 0;
           const char16_t* name = parser_->getElementName(&name_length);
-          visitor->VisitStartTag(std::u16string{name, name_length});
+          visitor->VisitStartTag(std::u16string_view{name, name_length});
           break;
         }
         case ResXMLParser::END_TAG:
@@ -80,6 +84,27 @@ bool CanCompileLayout(ResXMLParser* parser) {
 }
 
 namespace {
+// Calls `visit` with the path, contents and cookie of each layout file in `assets`.
+template <typename Visitor>
+void ForEachLayout(const std::unique_ptr<const android::ApkAssets>& assets,
+                   android::AssetManager2* resources, Visitor visit) {
+  assets->GetAssetsProvider()->ForEachFile("res/", [&](const android::StringPiece& s,
+                                                       android::FileType) {
+    if (s == "layout") {
+      auto path = StringPrintf("res/%s/", s.to_string().c_str());
+      assets->GetAssetsProvider()->ForEachFile(path, [&](const android::StringPiece& layout_file,
+                                                         android::FileType) {
+        auto layout_path = StringPrintf("%s%s", path.c_str(), layout_file.to_string().c_str());
+        android::ApkAssetsCookie cookie = android::kInvalidCookie;
+        auto asset = resources->OpenNonAsset(layout_path, android::Asset::ACCESS_RANDOM, &cookie);
+        CHECK(asset);
+        CHECK(android::kInvalidCookie != cookie);
+        visit(layout_path, asset.get(), cookie);
+      });
+    }
+  });
+}
+
 void CompileApkAssetsLayouts(const std::unique_ptr<const android::ApkAssets>& assets,
                              CompilationTarget target, std::ostream& target_out) {
   android::AssetManager2 resources;
@@ -100,55 +125,45 @@ void CompileApkAssetsLayouts(const std::unique_ptr<const android::ApkAssets>& as
       dex_file.MakeClass(StringPrintf("%s.CompiledView", package_name.c_str()))};
   std::vector<dex::MethodBuilder> methods;
 
-  assets->GetAssetsProvider()->ForEachFile("res/", [&](const android::StringPiece& s,
-                                                       android::FileType) {
-    if (s == "layout") {
-      auto path = StringPrintf("res/%s/", s.to_string().c_str());
-      assets->GetAssetsProvider()->ForEachFile(path, [&](const android::StringPiece& layout_file,
-                                                         android::FileType) {
-        auto layout_path = StringPrintf("%s%s", path.c_str(), layout_file.to_string().c_str());
-        android::ApkAssetsCookie cookie = android::kInvalidCookie;
-        auto asset = resources.OpenNonAsset(layout_path, android::Asset::ACCESS_RANDOM, &cookie);
-        CHECK(asset);
-        CHECK(android::kInvalidCookie != cookie);
-        const auto dynamic_ref_table = resources.GetDynamicRefTableForCookie(cookie);
-        CHECK(nullptr != dynamic_ref_table);
-        android::ResXMLTree xml_tree{dynamic_ref_table};
-        xml_tree.setTo(asset->getBuffer(/*wordAligned=*/true),
-                       asset->getLength(),
-                       /*copy_data=*/true);
-        android::ResXMLParser parser{xml_tree};
-        parser.restart();
-        if (CanCompileLayout(&parser)) {
-          parser.restart();
-          const std::string layout_name = startop::util::FindLayoutNameFromFilename(layout_path);
-          ResXmlVisitorAdapter adapter{&parser};
-          switch (target) {
-            case CompilationTarget::kDex: {
-              methods.push_back(compiled_view.CreateMethod(
-                  layout_name,
-                  dex::Prototype{dex::TypeDescriptor::FromClassname("android.view.View"),
-                                 dex::TypeDescriptor::FromClassname("android.content.Context"),
-                                 dex::TypeDescriptor::Int()}));
-              DexViewBuilder builder(&methods.back());
-              builder.Start();
-              LayoutCompilerVisitor visitor{&builder};
-              adapter.Accept(&visitor);
-              builder.Finish();
-              methods.back().Encode();
-              break;
-            }
-            case CompilationTarget::kJavaLanguage: {
-              JavaLangViewBuilder builder{package_name, layout_name, target_out};
-              builder.Start();
-              LayoutCompilerVisitor visitor{&builder};
-              adapter.Accept(&visitor);
-              builder.Finish();
-              break;
-            }
-          }
+  ForEachLayout(assets, &resources, [&](const std::string& layout_path, android::Asset* asset,
+                                         android::ApkAssetsCookie cookie) {
+    const auto dynamic_ref_table = resources.GetDynamicRefTableForCookie(cookie);
+    CHECK(nullptr != dynamic_ref_table);
+    android::ResXMLTree xml_tree{dynamic_ref_table};
+    // The asset outlives the tree, so the tree can parse the asset's buffer in place.
+    xml_tree.setTo(asset->getBuffer(/*wordAligned=*/true),
+                   asset->getLength(),
+                   /*copy_data=*/false);
+    android::ResXMLParser parser{xml_tree};
+    parser.restart();
+    if (CanCompileLayout(&parser)) {
+      parser.restart();
+      const std::string layout_name = startop::util::FindLayoutNameFromFilename(layout_path);
+      ResXmlVisitorAdapter adapter{&parser};
+      switch (target) {
+        case CompilationTarget::kDex: {
+          methods.push_back(compiled_view.CreateMethod(
+              layout_name,
+              dex::Prototype{dex::TypeDescriptor::FromClassname("android.view.View"),
+                             dex::TypeDescriptor::FromClassname("android.content.Context"),
+                             dex::TypeDescriptor::Int()}));
+          DexViewBuilder builder(&methods.back());
+          builder.Start();
+          LayoutCompilerVisitor visitor{&builder};
+          adapter.Accept(&visitor);
+          builder.Finish();
+          methods.back().Encode();
+          break;
         }
-      });
+        case CompilationTarget::kJavaLanguage: {
+          JavaLangViewBuilder builder{package_name, layout_name, target_out};
+          builder.Start();
+          LayoutCompilerVisitor visitor{&builder};
+          adapter.Accept(&visitor);
+          builder.Finish();
+          break;
+        }
+      }
     }
   });
 
@@ -157,6 +172,33 @@ void CompileApkAssetsLayouts(const std::unique_ptr<const android::ApkAssets>& as
     target_out.write(image.ptr<const char>(), image.size());
   }
 }
+
+// Returns a 64-bit FNV-1a hash of the compilation target and the path and contents of every
+// layout in `assets`, in the order in which they are compiled.
+std::string FingerprintApkAssetsLayouts(const std::unique_ptr<const android::ApkAssets>& assets,
+                                        CompilationTarget target) {
+  android::AssetManager2 resources;
+  resources.SetApkAssets({assets.get()});
+
+  uint64_t hash = 0xcbf29ce484222325ull;
+  auto add = [&hash](const void* data, size_t size) {
+    const uint8_t* bytes = reinterpret_cast<const uint8_t*>(data);
+    for (size_t i = 0; i < size; i++) {
+      hash = (hash ^ bytes[i]) * 0x100000001b3ull;
+    }
+  };
+
+  const uint8_t target_tag = static_cast<uint8_t>(target);
+  add(&target_tag, sizeof(target_tag));
+  ForEachLayout(assets, &resources, [&](const std::string& layout_path, android::Asset* asset,
+                                        android::ApkAssetsCookie /*cookie*/) {
+    add(layout_path.c_str(), layout_path.size() + 1);
+    const uint64_t length = asset->getLength();
+    add(&length, sizeof(length));
+    add(asset->getBuffer(/*wordAligned=*/false), asset->getLength());
+  });
+  return StringPrintf("%016llx\n", static_cast<unsigned long long>(hash));
+}
 }  // namespace
 
 void CompileApkLayouts(const std::string& filename, CompilationTarget target,
@@ -172,4 +214,50 @@ void CompileApkLayoutsFd(android::base::unique_fd fd, CompilationTarget target,
   CompileApkAssetsLayouts(assets, target, target_out);
 }
 
+bool CompileApkLayoutsIncremental(const std::vector<std::string>& filenames,
+                                  CompilationTarget target, const std::string& out_dir) {
+  const char* extension = target == CompilationTarget::kDex ? ".dex" : ".java";
+  bool success = true;
+  for (const std::string& filename : filenames) {
+    auto assets = android::ApkAssets::Load(filename);
+    if (assets == nullptr) {
+      LOG(ERROR) << "Failed to load " << filename;
+      success = false;
+      continue;
+    }
+
+    std::string out_path = out_dir + "/" + android::base::Basename(filename);
+    const size_t dot = out_path.rfind('.');
+    if (dot != std::string::npos && dot > out_dir.size()) {
+      out_path.resize(dot);
+    }
+    out_path += extension;
+    const std::string fingerprint_path = out_path + ".fingerprint";
+
+    const std::string fingerprint = FingerprintApkAssetsLayouts(assets, target);
+    std::string previous_fingerprint;
+    if (access(out_path.c_str(), F_OK) == 0 &&
+        android::base::ReadFileToString(fingerprint_path, &previous_fingerprint) &&
+        previous_fingerprint == fingerprint) {
+      continue;
+    }
+
+    // Drop the stale fingerprint first, so an interrupted build is never considered up to date.
+    unlink(fingerprint_path.c_str());
+    std::ofstream out{out_path, std::ios::binary | std::ios::trunc};
+    CompileApkAssetsLayouts(assets, target, out);
+    out.close();
+    if (!out) {
+      LOG(ERROR) << "Failed to write " << out_path;
+      success = false;
+      continue;
+    }
+    if (!android::base::WriteStringToFile(fingerprint, fingerprint_path)) {
+      LOG(ERROR) << "Failed to write " << fingerprint_path;
+      success = false;
+    }
+  }
+  return success;
+}
+
 }  // namespace startop
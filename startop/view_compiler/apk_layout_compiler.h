@@ -18,6 +18,7 @@
 #define APK_LAYOUT_COMPILER_H_
 
 #include <string>
+#include <vector>
 
 #include "android-base/unique_fd.h"
 
@@ -30,6 +31,13 @@ void CompileApkLayouts(const std::string& filename, CompilationTarget target,
 void CompileApkLayoutsFd(android::base::unique_fd fd, CompilationTarget target,
                          std::ostream& target_out);
 
+// Compiles the layouts of each APK in `filenames` into `out_dir`, as `<apk name>.dex` (or `.java`).
+// A fingerprint of the layouts is stored next to each output, and outputs whose layouts have not
+// changed since the previous run are not rebuilt. Returns false if an APK could not be loaded or an
+// output could not be written.
+bool CompileApkLayoutsIncremental(const std::vector<std::string>& filenames,
+                                  CompilationTarget target, const std::string& out_dir);
+
 }  // namespace startop
 
 #endif  // APK_LAYOUT_COMPILER_H_
\ No newline at end of file
@@ -21,12 +21,17 @@
 
 #include <codecvt>
 #include <locale>
+#include <optional>
 #include <string>
+#include <string_view>
 #include <vector>
 
 namespace startop {
 
 // This visitor does the actual view compilation, using a supplied builder.
+//
+// Views are passed to the builder as the tags stream in, without building a tree of the layout
+// first. A view is only started once the next tag shows whether it has children.
 template <typename Builder>
 class LayoutCompilerVisitor {
  public:
@@ -34,38 +39,26 @@ class LayoutCompilerVisitor {
 
   void VisitStartDocument() { builder_->Start(); }
   void VisitEndDocument() { builder_->Finish(); }
-  void VisitStartTag(const std::u16string& name) {
-    parent_stack_.push_back(ViewEntry{
-        std::wstring_convert<std::codecvt_utf8_utf16<char16_t>, char16_t>{}.to_bytes(name), {}});
-  }
-  void VisitEndTag() {
-    auto entry = parent_stack_.back();
-    parent_stack_.pop_back();
-
-    if (parent_stack_.empty()) {
-      GenerateCode(entry);
-    } else {
-      parent_stack_.back().children.push_back(entry);
+  void VisitStartTag(std::u16string_view name) {
+    if (pending_view_) {
+      builder_->StartView(*pending_view_, /*is_viewgroup=*/true);
     }
+    pending_view_ = converter_.to_bytes(name.data(), name.data() + name.size());
   }
-
- private:
-  struct ViewEntry {
-    std::string name;
-    std::vector<ViewEntry> children;
-  };
-
-  void GenerateCode(const ViewEntry& view) {
-    builder_->StartView(view.name, !view.children.empty());
-    for (const auto& child : view.children) {
-      GenerateCode(child);
+  void VisitEndTag() {
+    if (pending_view_) {
+      builder_->StartView(*pending_view_, /*is_viewgroup=*/false);
+      pending_view_.reset();
     }
     builder_->FinishView();
   }
 
+ private:
   Builder* builder_;
 
-  std::vector<ViewEntry> parent_stack_;
+  // The most recently opened view, until we know whether it has children.
+  std::optional<std::string> pending_view_;
+  std::wstring_convert<std::codecvt_utf8_utf16<char16_t>, char16_t> converter_;
 };
 
 class DexViewBuilder {
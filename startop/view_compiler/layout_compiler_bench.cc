@@ -0,0 +1,125 @@
+/*
+ * Copyright (C) 2020 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "benchmark/benchmark.h"
+
+#include "dex_builder.h"
+#include "dex_layout_compiler.h"
+#include "java_lang_builder.h"
+#include "tinyxml_layout_parser.h"
+
+#include "tinyxml2.h"
+
+#include <sstream>
+#include <string>
+
+// Benchmarks for the cost of the layout compiler, over synthetic layouts of various sizes. Each
+// benchmark takes the number of leaf views and the nesting depth of the layout as arguments.
+//
+// BM_ParseAndValidateLayout measures the XML parsing and validation that every compilation pays
+// for, BM_CompileLayoutToDex and BM_CompileLayoutToJava the code generation on top of it. The
+// counters report the size of the generated code, which is what has to be loaded at run time in
+// place of inflating the layout.
+
+namespace startop {
+namespace {
+
+using tinyxml2::XMLDocument;
+
+// Returns a layout with `views` TextViews nested inside `depth` LinearLayouts.
+std::string MakeLayout(int views, int depth) {
+  std::string layout;
+  for (int i = 0; i < depth; i++) {
+    layout += "<LinearLayout xmlns:android=\"http://schemas.android.com/apk/res/android\">\n";
+  }
+  for (int i = 0; i < views; i++) {
+    layout += "<TextView android:text=\"view\" />\n";
+  }
+  for (int i = 0; i < depth; i++) {
+    layout += "</LinearLayout>\n";
+  }
+  return layout;
+}
+
+template <typename Builder>
+void CompileLayout(XMLDocument* xml, Builder* builder) {
+  LayoutCompilerVisitor<Builder> visitor{builder};
+  TinyXmlVisitorAdapter<decltype(visitor)> adapter{&visitor};
+  xml->Accept(&adapter);
+}
+
+void LayoutArgs(benchmark::internal::Benchmark* b) {
+  b->Args({1, 1})->Args({10, 1})->Args({50, 1})->Args({10, 5})->Args({50, 10});
+}
+
+void BM_ParseAndValidateLayout(benchmark::State& state) {
+  const std::string layout = MakeLayout(state.range(0), state.range(1));
+  for (auto _ : state) {
+    XMLDocument xml;
+    xml.Parse(layout.c_str(), layout.size());
+    benchmark::DoNotOptimize(CanCompileLayout(xml));
+  }
+  state.counters["views"] = state.range(0) + state.range(1);
+}
+BENCHMARK(BM_ParseAndValidateLayout)->Apply(LayoutArgs);
+
+void BM_CompileLayoutToDex(benchmark::State& state) {
+  const std::string layout = MakeLayout(state.range(0), state.range(1));
+  size_t dex_size = 0;
+  for (auto _ : state) {
+    XMLDocument xml;
+    xml.Parse(layout.c_str(), layout.size());
+
+    dex::DexBuilder dex_file;
+    dex::ClassBuilder compiled_view{dex_file.MakeClass("android.startop.bench.CompiledView")};
+    dex::MethodBuilder method{compiled_view.CreateMethod(
+        "layout",
+        dex::Prototype{dex::TypeDescriptor::FromClassname("android.view.View"),
+                       dex::TypeDescriptor::FromClassname("android.content.Context"),
+                       dex::TypeDescriptor::Int()})};
+    DexViewBuilder builder{&method};
+    CompileLayout(&xml, &builder);
+    method.Encode();
+
+    slicer::MemView image{dex_file.CreateImage()};
+    dex_size = image.size();
+  }
+  state.counters["views"] = state.range(0) + state.range(1);
+  state.counters["dex_bytes"] = dex_size;
+}
+BENCHMARK(BM_CompileLayoutToDex)->Apply(LayoutArgs);
+
+void BM_CompileLayoutToJava(benchmark::State& state) {
+  const std::string layout = MakeLayout(state.range(0), state.range(1));
+  size_t java_size = 0;
+  for (auto _ : state) {
+    XMLDocument xml;
+    xml.Parse(layout.c_str(), layout.size());
+
+    std::ostringstream out;
+    JavaLangViewBuilder builder{"android.startop.bench", "layout", out};
+    CompileLayout(&xml, &builder);
+    java_size = out.tellp();
+  }
+  state.counters["views"] = state.range(0) + state.range(1);
+  state.counters["java_bytes"] = java_size;
+}
+BENCHMARK(BM_CompileLayoutToJava)->Apply(LayoutArgs);
+
+}  // namespace
+}  // namespace startop
+
+BENCHMARK_MAIN();
@@ -20,20 +20,20 @@
 
 namespace startop {
 
-void LayoutValidationVisitor::VisitStartTag(const std::u16string& name) {
-  if (0 == name.compare(u"merge")) {
+void LayoutValidationVisitor::VisitStartTag(std::u16string_view name) {
+  if (name == u"merge") {
     message_ = "Merge tags are not supported";
     can_compile_ = false;
   }
-  if (0 == name.compare(u"include")) {
+  if (name == u"include") {
     message_ = "Include tags are not supported";
     can_compile_ = false;
   }
-  if (0 == name.compare(u"view")) {
+  if (name == u"view") {
     message_ = "View tags are not supported";
     can_compile_ = false;
   }
-  if (0 == name.compare(u"fragment")) {
+  if (name == u"fragment") {
     message_ = "Fragment tags are not supported";
     can_compile_ = false;
   }
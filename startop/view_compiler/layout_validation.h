@@ -20,6 +20,7 @@
 #include "dex_builder.h"
 
 #include <string>
+#include <string_view>
 
 namespace startop {
 
@@ -30,7 +31,7 @@ class LayoutValidationVisitor {
  public:
   void VisitStartDocument() const {}
   void VisitEndDocument() const {}
-  void VisitStartTag(const std::u16string& name);
+  void VisitStartTag(std::u16string_view name);
   void VisitEndTag() const {}
 
   const std::string& message() const { return message_; }
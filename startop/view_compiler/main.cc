@@ -51,6 +51,9 @@ DEFINE_bool(apk, false, "Compile layouts in an APK");
 DEFINE_bool(dex, false, "Generate a DEX file instead of Java");
 DEFINE_int32(infd, -1, "Read input from the given file descriptor");
 DEFINE_string(out, kStdoutFilename, "Where to write the generated class");
+DEFINE_string(out_dir, "",
+              "With --apk, compile every APK given on the command line into this directory, "
+              "skipping the APKs whose layouts have not changed since the last run");
 DEFINE_string(package, "", "The package name for the generated class (required)");
 
 template <typename Visitor>
@@ -120,6 +123,14 @@ int main(int argc, char** argv) {
   if (FLAGS_apk) {
     const startop::CompilationTarget target =
         FLAGS_dex ? startop::CompilationTarget::kDex : startop::CompilationTarget::kJavaLanguage;
+    if (!FLAGS_out_dir.empty()) {
+      if (argc < 2) {
+        gflags::ShowUsageWithFlags(argv[kProgramName]);
+        return 1;
+      }
+      const std::vector<string> filenames{argv + kFileNameParam, argv + argc};
+      return startop::CompileApkLayoutsIncremental(filenames, target, FLAGS_out_dir) ? 0 : 1;
+    }
     if (FLAGS_infd >= 0) {
       startop::CompileApkLayoutsFd(
           android::base::unique_fd{FLAGS_infd}, target, is_stdout ? std::cout : outfile);
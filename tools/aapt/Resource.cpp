@@ -19,6 +19,8 @@
 #include "XMLNode.h"
 
 #include <algorithm>
+#include <map>
+#include <memory>
 
 // STATUST: mingw does seem to redefine UNKNOWN_ERROR from our enum value, so a cast is necessary.
 
@@ -31,7 +33,7 @@
 // Set to true for noisy debug output.
 static const bool kIsDebug = false;
 
-// Number of threads to use for preprocessing images.
+// Number of threads to use for preprocessing images and parsing XML files.
 static const size_t MAX_THREADS = 4;
 
 // ==========================================================================
@@ -389,6 +391,109 @@ static status_t preProcessImages(const Bundle* bundle, const sp<AaptAssets>& ass
     return (hasErrors || (res < NO_ERROR)) ? STATUST(UNKNOWN_ERROR) : NO_ERROR;
 }
 
+// XML files are parsed on worker threads ahead of being compiled, since parsing does not touch
+// the resource table. Compilation still happens on the main thread in the usual order, so the
+// output does not depend on how the work was scheduled.
+typedef std::map<const AaptFile*, sp<XMLNode> > ParsedXmlFiles;
+
+struct ParsedValuesFile {
+    ParsedValuesFile() : err(NO_ERROR) {
+    }
+
+    status_t err;
+    ResXMLTree block;
+};
+typedef std::map<const AaptFile*, std::unique_ptr<ParsedValuesFile> > ParsedValuesFiles;
+
+class ParseXmlFileWorkUnit : public WorkQueue::WorkUnit {
+public:
+    ParseXmlFileWorkUnit(const sp<AaptFile>& file, sp<XMLNode>* outRoot) :
+            mFile(file), mOutRoot(outRoot) {
+    }
+
+    virtual bool run() {
+        *mOutRoot = XMLNode::parse(mFile);
+        return true;
+    }
+
+private:
+    sp<AaptFile> mFile;
+    sp<XMLNode>* mOutRoot;
+};
+
+class ParseValuesFileWorkUnit : public WorkQueue::WorkUnit {
+public:
+    ParseValuesFileWorkUnit(const sp<AaptFile>& file, ParsedValuesFile* outFile) :
+            mFile(file), mOutFile(outFile) {
+    }
+
+    virtual bool run() {
+        mOutFile->err = parseXMLResource(mFile, &mOutFile->block, false, true);
+        return true;
+    }
+
+private:
+    sp<AaptFile> mFile;
+    ParsedValuesFile* mOutFile;
+};
+
+static void scheduleXmlFiles(WorkQueue* wq, const sp<ResourceTypeSet>& set, const char* type,
+                             bool xmlOnly, ParsedXmlFiles* outFiles)
+{
+    if (set == NULL) {
+        return;
+    }
+    ResourceDirIterator it(set, String8(type));
+    while (it.next() == NO_ERROR) {
+        const sp<AaptFile>& file = it.getFile();
+        if (xmlOnly && file->getPath().getPathExtension() != ".xml") {
+            continue;
+        }
+        ParseXmlFileWorkUnit* w = new ParseXmlFileWorkUnit(file, &(*outFiles)[file.get()]);
+        if (wq->schedule(w) != NO_ERROR) {
+            // The file is parsed when it is compiled instead.
+            outFiles->erase(file.get());
+            delete w;
+            return;
+        }
+    }
+}
+
+static void scheduleValuesFiles(WorkQueue* wq, const sp<ResourceTypeSet>& set,
+                                ParsedValuesFiles* outFiles)
+{
+    ResourceDirIterator it(set, String8("values"));
+    while (it.next() == NO_ERROR) {
+        const sp<AaptFile>& file = it.getFile();
+        std::unique_ptr<ParsedValuesFile>& parsed = (*outFiles)[file.get()];
+        parsed.reset(new ParsedValuesFile());
+        ParseValuesFileWorkUnit* w = new ParseValuesFileWorkUnit(file, parsed.get());
+        if (wq->schedule(w) != NO_ERROR) {
+            outFiles->erase(file.get());
+            delete w;
+            return;
+        }
+    }
+}
+
+static status_t compileParsedXmlFile(const Bundle* bundle, const sp<AaptAssets>& assets,
+                                     ParsedXmlFiles* parsedFiles, const String16& resourceName,
+                                     const sp<AaptFile>& target, ResourceTable* table, int options)
+{
+    sp<XMLNode> root;
+    ParsedXmlFiles::iterator parsed = parsedFiles->find(target.get());
+    if (parsed != parsedFiles->end()) {
+        root = parsed->second;
+        parsedFiles->erase(parsed);
+    } else {
+        root = XMLNode::parse(target);
+    }
+    if (root == NULL) {
+        return UNKNOWN_ERROR;
+    }
+    return compileXmlFile(bundle, assets, resourceName, root, target, table, options);
+}
+
 static void collect_files(const sp<AaptDir>& dir,
         KeyedVector<String8, sp<ResourceTypeSet> >* resources)
 {
@@ -1457,6 +1562,19 @@ status_t buildResources(Bundle* bundle, const sp<AaptAssets>& assets, sp<ApkBuil
     }
 
     // compile resources
+    ParsedValuesFiles parsedValues;
+    {
+        WorkQueue wq(MAX_THREADS, false);
+        for (current = assets; current.get(); current = current->getOverlay()) {
+            KeyedVector<String8, sp<ResourceTypeSet> > *resources = current->getResources();
+            ssize_t index = resources->indexOfKey(String8("values"));
+            if (index >= 0) {
+                scheduleValuesFiles(&wq, resources->valueAt(index), &parsedValues);
+            }
+        }
+        wq.finish();
+    }
+
     current = assets;
     while(current.get()) {
         KeyedVector<String8, sp<ResourceTypeSet> > *resources = 
@@ -1468,8 +1586,18 @@ status_t buildResources(Bundle* bundle, const sp<AaptAssets>& assets, sp<ApkBuil
             ssize_t res;
             while ((res=it.next()) == NO_ERROR) {
                 const sp<AaptFile>& file = it.getFile();
-                res = compileResourceFile(bundle, assets, file, it.getParams(), 
-                                          (current!=assets), &table);
+                ParsedValuesFiles::iterator parsed = parsedValues.find(file.get());
+                if (parsed != parsedValues.end()) {
+                    res = parsed->second->err;
+                    if (res == NO_ERROR) {
+                        res = compileResourceFile(bundle, assets, file, &parsed->second->block,
+                                                  it.getParams(), (current!=assets), &table);
+                    }
+                    parsedValues.erase(parsed);
+                } else {
+                    res = compileResourceFile(bundle, assets, file, it.getParams(),
+                                              (current!=assets), &table);
+                }
                 if (res != NO_ERROR) {
                     hasErrors = true;
                 }
@@ -1512,11 +1640,26 @@ status_t buildResources(Bundle* bundle, const sp<AaptAssets>& assets, sp<ApkBuil
     // resources.
     // --------------------------------------------------------------
 
+    ParsedXmlFiles parsedXml;
+    {
+        WorkQueue wq(MAX_THREADS, false);
+        scheduleXmlFiles(&wq, layouts, "layout", false, &parsedXml);
+        scheduleXmlFiles(&wq, anims, "anim", false, &parsedXml);
+        scheduleXmlFiles(&wq, animators, "animator", false, &parsedXml);
+        scheduleXmlFiles(&wq, interpolators, "interpolator", false, &parsedXml);
+        scheduleXmlFiles(&wq, transitions, "transition", false, &parsedXml);
+        scheduleXmlFiles(&wq, xmls, "xml", false, &parsedXml);
+        scheduleXmlFiles(&wq, colors, "color", false, &parsedXml);
+        scheduleXmlFiles(&wq, menus, "menu", false, &parsedXml);
+        scheduleXmlFiles(&wq, fonts, "font", true, &parsedXml);
+        wq.finish();
+    }
+
     if (layouts != NULL) {
         ResourceDirIterator it(layouts, String8("layout"));
         while ((err=it.next()) == NO_ERROR) {
             String8 src = it.getFile()->getPrintableSource();
-            err = compileXmlFile(bundle, assets, String16(it.getBaseName()),
+            err = compileParsedXmlFile(bundle, assets, &parsedXml, String16(it.getBaseName()),
                     it.getFile(), &table, xmlFlags);
             // Only verify IDs if there was no error and the file is non-empty.
             if (err == NO_ERROR && it.getFile()->hasData()) {
@@ -1537,7 +1680,7 @@ status_t buildResources(Bundle* bundle, const sp<AaptAssets>& assets, sp<ApkBuil
     if (anims != NULL) {
         ResourceDirIterator it(anims, String8("anim"));
         while ((err=it.next()) == NO_ERROR) {
-            err = compileXmlFile(bundle, assets, String16(it.getBaseName()),
+            err = compileParsedXmlFile(bundle, assets, &parsedXml, String16(it.getBaseName()),
                     it.getFile(), &table, xmlFlags);
             if (err != NO_ERROR) {
                 hasErrors = true;
@@ -1553,7 +1696,7 @@ status_t buildResources(Bundle* bundle, const sp<AaptAssets>& assets, sp<ApkBuil
     if (animators != NULL) {
         ResourceDirIterator it(animators, String8("animator"));
         while ((err=it.next()) == NO_ERROR) {
-            err = compileXmlFile(bundle, assets, String16(it.getBaseName()),
+            err = compileParsedXmlFile(bundle, assets, &parsedXml, String16(it.getBaseName()),
                     it.getFile(), &table, xmlFlags);
             if (err != NO_ERROR) {
                 hasErrors = true;
@@ -1569,7 +1712,7 @@ status_t buildResources(Bundle* bundle, const sp<AaptAssets>& assets, sp<ApkBuil
     if (interpolators != NULL) {
         ResourceDirIterator it(interpolators, String8("interpolator"));
         while ((err=it.next()) == NO_ERROR) {
-            err = compileXmlFile(bundle, assets, String16(it.getBaseName()),
+            err = compileParsedXmlFile(bundle, assets, &parsedXml, String16(it.getBaseName()),
                     it.getFile(), &table, xmlFlags);
             if (err != NO_ERROR) {
                 hasErrors = true;
@@ -1585,7 +1728,7 @@ status_t buildResources(Bundle* bundle, const sp<AaptAssets>& assets, sp<ApkBuil
     if (transitions != NULL) {
         ResourceDirIterator it(transitions, String8("transition"));
         while ((err=it.next()) == NO_ERROR) {
-            err = compileXmlFile(bundle, assets, String16(it.getBaseName()),
+            err = compileParsedXmlFile(bundle, assets, &parsedXml, String16(it.getBaseName()),
                     it.getFile(), &table, xmlFlags);
             if (err != NO_ERROR) {
                 hasErrors = true;
@@ -1601,7 +1744,7 @@ status_t buildResources(Bundle* bundle, const sp<AaptAssets>& assets, sp<ApkBuil
     if (xmls != NULL) {
         ResourceDirIterator it(xmls, String8("xml"));
         while ((err=it.next()) == NO_ERROR) {
-            err = compileXmlFile(bundle, assets, String16(it.getBaseName()),
+            err = compileParsedXmlFile(bundle, assets, &parsedXml, String16(it.getBaseName()),
                     it.getFile(), &table, xmlFlags);
             if (err != NO_ERROR) {
                 hasErrors = true;
@@ -1647,7 +1790,7 @@ status_t buildResources(Bundle* bundle, const sp<AaptAssets>& assets, sp<ApkBuil
     if (colors != NULL) {
         ResourceDirIterator it(colors, String8("color"));
         while ((err=it.next()) == NO_ERROR) {
-            err = compileXmlFile(bundle, assets, String16(it.getBaseName()),
+            err = compileParsedXmlFile(bundle, assets, &parsedXml, String16(it.getBaseName()),
                     it.getFile(), &table, xmlFlags);
             if (err != NO_ERROR) {
                 hasErrors = true;
@@ -1664,7 +1807,7 @@ status_t buildResources(Bundle* bundle, const sp<AaptAssets>& assets, sp<ApkBuil
         ResourceDirIterator it(menus, String8("menu"));
         while ((err=it.next()) == NO_ERROR) {
             String8 src = it.getFile()->getPrintableSource();
-            err = compileXmlFile(bundle, assets, String16(it.getBaseName()),
+            err = compileParsedXmlFile(bundle, assets, &parsedXml, String16(it.getBaseName()),
                     it.getFile(), &table, xmlFlags);
             if (err == NO_ERROR && it.getFile()->hasData()) {
                 ResXMLTree block;
@@ -1687,8 +1830,8 @@ status_t buildResources(Bundle* bundle, const sp<AaptAssets>& assets, sp<ApkBuil
             // fonts can be resources other than xml.
             if (it.getFile()->getPath().getPathExtension() == ".xml") {
                 String8 src = it.getFile()->getPrintableSource();
-                err = compileXmlFile(bundle, assets, String16(it.getBaseName()),
-                        it.getFile(), &table, xmlFlags);
+                err = compileParsedXmlFile(bundle, assets, &parsedXml,
+                        String16(it.getBaseName()), it.getFile(), &table, xmlFlags);
                 if (err != NO_ERROR) {
                     hasErrors = true;
                 }
@@ -787,6 +787,20 @@ status_t compileResourceFile(Bundle* bundle,
         return err;
     }
 
+    return compileResourceFile(bundle, assets, in, &block, defParams, overwrite, outTable);
+}
+
+status_t compileResourceFile(Bundle* bundle,
+                             const sp<AaptAssets>& assets,
+                             const sp<AaptFile>& in,
+                             ResXMLTree* parsedBlock,
+                             const ResTable_config& defParams,
+                             const bool overwrite,
+                             ResourceTable* outTable)
+{
+    ResXMLTree& block = *parsedBlock;
+    status_t err = NO_ERROR;
+
     // Top-level tag.
     const String16 resources16("resources");
 
@@ -64,6 +64,15 @@ status_t compileResourceFile(Bundle* bundle,
                              const bool overwrite,
                              ResourceTable* outTable);
 
+// Same as above, for a values file that has already been parsed with parseXMLResource().
+status_t compileResourceFile(Bundle* bundle,
+                             const sp<AaptAssets>& assets,
+                             const sp<AaptFile>& in,
+                             ResXMLTree* parsedBlock,
+                             const ResTable_config& defParams,
+                             const bool overwrite,
+                             ResourceTable* outTable);
+
 struct AccessorCookie
 {
     SourcePos sourcePos;
@@ -1,6 +1,7 @@
 #include "SourcePos.h"
 
 #include <stdarg.h>
+#include <utils/Mutex.h>
 #include <vector>
 
 using namespace std;
@@ -29,6 +30,8 @@ struct ErrorPos
     void print(FILE* to) const;
 };
 
+// Errors can be reported from the worker threads that parse XML files.
+static Mutex g_errorsLock;
 static vector<ErrorPos> g_errors;
 
 ErrorPos::ErrorPos()
@@ -117,6 +120,7 @@ SourcePos::error(const char* fmt, ...) const
     va_start(ap, fmt);
     String8 msg = String8::formatV(fmt, ap);
     va_end(ap);
+    AutoMutex _l(g_errorsLock);
     g_errors.push_back(ErrorPos(this->file, this->line, msg, ErrorPos::ERROR));
 }
 
@@ -149,12 +153,14 @@ SourcePos::operator<(const SourcePos& rhs) const
 bool
 SourcePos::hasErrors()
 {
+    AutoMutex _l(g_errorsLock);
     return g_errors.size() > 0;
 }
 
 void
 SourcePos::printErrors(FILE* to)
 {
+    AutoMutex _l(g_errorsLock);
     vector<ErrorPos>::const_iterator it;
     for (it=g_errors.begin(); it!=g_errors.end(); it++) {
         it->print(to);
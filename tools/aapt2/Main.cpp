@@ -37,6 +37,7 @@
 #include "cmd/Link.h"
 #include "cmd/Optimize.h"
 #include "io/FileStream.h"
+#include "io/ZipArchive.h"
 #include "trace/TraceBuffer.h"
 #include "util/Files.h"
 #include "util/Util.h"
@@ -108,6 +109,11 @@ class DaemonCommand : public Command {
   int Action(const std::vector<std::string>& arguments) override {
     TRACE_FLUSH_ARGS(trace_folder_ ? trace_folder_.value() : "", "daemon", arguments);
     text::Printer printer(out_);
+
+    // Every invocation opens the same framework and library archives, so keep them open, and keep
+    // the symbols parsed from them for the links that include them.
+    io::ZipFileCollection::SetArchiveCacheEnabled(true);
+    LinkCommand::SetIncludeCacheEnabled(true);
     std::cout << "Ready" << std::endl;
 
     while (true) {
@@ -146,11 +146,32 @@ ResourceTableType* ResourceTablePackage::FindOrCreateType(ResourceType type,
   return types.emplace(iter, std::move(new_type))->get();
 }
 
+ResourceEntry* ResourceTableType::FindFirstEntry(const StringPiece& name) {
+  if (indexed_entry_count_ != entries.size()) {
+    entry_index_.clear();
+    entry_index_.reserve(entries.size());
+    for (auto& entry : entries) {
+      // Entries are sorted by name and then ID, so the first one with a name wins.
+      entry_index_.emplace(entry->name, entry.get());
+    }
+    indexed_entry_count_ = entries.size();
+  }
+
+  auto iter = entry_index_.find(name);
+  return iter != entry_index_.end() ? iter->second : nullptr;
+}
+
 ResourceEntry* ResourceTableType::FindEntry(const StringPiece& name, const Maybe<uint16_t> id) {
+  ResourceEntry* entry = FindFirstEntry(name);
+  if (entry == nullptr || !id || id == entry->id) {
+    return entry;
+  }
+
+  // Entries that share a name are only told apart by their ID.
   const auto last = entries.end();
   auto iter = std::lower_bound(entries.begin(), last, std::make_pair(name, id),
       less_than_struct_with_name_and_id<ResourceEntry>);
-  if (iter != last && name == (*iter)->name && (!id || id == (*iter)->id)) {
+  if (iter != last && name == (*iter)->name && id == (*iter)->id) {
     return iter->get();
   }
   return nullptr;
@@ -158,16 +179,23 @@ ResourceEntry* ResourceTableType::FindEntry(const StringPiece& name, const Maybe
 
 ResourceEntry* ResourceTableType::FindOrCreateEntry(const StringPiece& name,
                                                     const Maybe<uint16_t > id) {
+  ResourceEntry* entry = FindEntry(name, id);
+  if (entry != nullptr) {
+    return entry;
+  }
+
   auto last = entries.end();
   auto iter = std::lower_bound(entries.begin(), last, std::make_pair(name, id),
                                less_than_struct_with_name_and_id<ResourceEntry>);
-  if (iter != last && name == (*iter)->name && (!id || id == (*iter)->id)) {
-    return iter->get();
-  }
-
   auto new_entry = new ResourceEntry(name);
   new_entry->id = id;
-  return entries.emplace(iter, std::move(new_entry))->get();
+  iter = entries.emplace(iter, std::move(new_entry));
+
+  if (iter == entries.begin() || (*(iter - 1))->name != name) {
+    entry_index_[(*iter)->name] = iter->get();
+  }
+  indexed_entry_count_++;
+  return iter->get();
 }
 
 ResourceConfigValue* ResourceEntry::FindValue(const ConfigDescription& config) {
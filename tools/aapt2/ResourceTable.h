@@ -173,6 +173,16 @@ class ResourceTableType {
                                    Maybe<uint16_t> id = Maybe<uint16_t>());
 
  private:
+  // Returns the first entry with the given name in `entries`, using the name index.
+  ResourceEntry* FindFirstEntry(const android::StringPiece& name);
+
+  // Maps the name of an entry to the first entry with that name in `entries`. The keys point at
+  // the names of the entries. Entries created through FindOrCreateEntry are indexed as they are
+  // added; when code removes entries from the vector directly the size no longer matches and the
+  // index is rebuilt on the next lookup.
+  std::unordered_map<android::StringPiece, ResourceEntry*> entry_index_;
+  size_t indexed_entry_count_ = 0;
+
   DISALLOW_COPY_AND_ASSIGN(ResourceTableType);
 };
 
@@ -372,4 +372,41 @@ TEST(ResourceTableTest, AllowDuplictaeResourcesNames) {
   ASSERT_THAT(entry2->visibility.level, Visibility::Level::kPrivate);
 }
 
+TEST(ResourceTableTest, FindEntriesAfterRemovingThemDirectly) {
+  ResourceTableType type(ResourceType::kString);
+  for (const char* name : {"foo", "bar", "baz"}) {
+    ASSERT_THAT(type.FindOrCreateEntry(name), NotNull());
+  }
+  ASSERT_THAT(type.FindEntry("bar"), NotNull());
+
+  auto iter = std::find_if(type.entries.begin(), type.entries.end(),
+                           [](const std::unique_ptr<ResourceEntry>& entry) -> bool {
+                             return entry->name == "bar";
+                           });
+  ASSERT_TRUE(iter != type.entries.end());
+  type.entries.erase(iter);
+
+  EXPECT_THAT(type.FindEntry("bar"), Eq(nullptr));
+  ASSERT_THAT(type.FindEntry("baz"), NotNull());
+  EXPECT_THAT(type.FindEntry("baz")->name, StrEq("baz"));
+
+  ResourceEntry* bar = type.FindOrCreateEntry("bar");
+  EXPECT_THAT(type.FindEntry("bar"), Eq(bar));
+  EXPECT_THAT(type.entries.size(), Eq(3u));
+}
+
+TEST(ResourceTableTest, FindFirstOfEntriesSharingAName) {
+  ResourceTableType type(ResourceType::kBool);
+  ResourceEntry* foo_100 = type.FindOrCreateEntry("foo", 0x0100);
+  ResourceEntry* foo_ff = type.FindOrCreateEntry("foo", 0x00ff);
+  ASSERT_THAT(foo_100, NotNull());
+  ASSERT_THAT(foo_ff, NotNull());
+
+  EXPECT_THAT(type.FindEntry("foo"), Eq(foo_ff));
+  EXPECT_THAT(type.FindEntry("foo", 0x0100), Eq(foo_100));
+  EXPECT_THAT(type.FindEntry("foo", 0x0101), Eq(nullptr));
+  EXPECT_THAT(type.FindOrCreateEntry("foo", 0x0100), Eq(foo_100));
+  EXPECT_THAT(type.entries.size(), Eq(2u));
+}
+
 }  // namespace aapt
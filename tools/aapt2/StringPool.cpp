@@ -169,28 +169,142 @@ StringPool::Ref StringPool::MakeRef(const StringPiece& str, const Context& conte
   return MakeRefImpl(str, context, true);
 }
 
+template <typename T>
+T* StringPool::EntryArena<T>::Allocate() {
+  if (free_.empty()) {
+    if (chunk_used_ == chunk_size_) {
+      // Grow geometrically, but not without bounds: the last chunk is rarely full.
+      AddChunk(std::min<size_t>(std::max<size_t>(chunk_size_ * 2, 64u), 4096u));
+    }
+    return &chunks_.back()[chunk_used_++];
+  }
+
+  T* entry = free_.back();
+  free_.pop_back();
+  return entry;
+}
+
+template <typename T>
+void StringPool::EntryArena<T>::Free(T* entry) {
+  *entry = T();
+  free_.push_back(entry);
+}
+
+template <typename T>
+void StringPool::EntryArena<T>::Reserve(size_t count) {
+  const size_t available = free_.size() + (chunk_size_ - chunk_used_);
+  if (available < count) {
+    AddChunk(count - available);
+  }
+}
+
+template <typename T>
+void StringPool::EntryArena<T>::AddChunk(size_t size) {
+  // The rest of the current chunk is used before the new one.
+  for (; chunk_used_ < chunk_size_; chunk_used_++) {
+    free_.push_back(&chunks_.back()[chunk_used_]);
+  }
+  chunks_.emplace_back(new T[size]);
+  chunk_size_ = size;
+  chunk_used_ = 0;
+}
+
+template <typename T>
+void StringPool::EntryArena<T>::Merge(EntryArena&& arena) {
+  for (; arena.chunk_used_ < arena.chunk_size_; arena.chunk_used_++) {
+    free_.push_back(&arena.chunks_.back()[arena.chunk_used_]);
+  }
+  free_.insert(free_.end(), arena.free_.begin(), arena.free_.end());
+  arena.free_.clear();
+
+  // Keep our current chunk last, since it is the one still being filled.
+  chunks_.insert(chunks_.end() - (chunks_.empty() ? 0 : 1),
+                 std::make_move_iterator(arena.chunks_.begin()),
+                 std::make_move_iterator(arena.chunks_.end()));
+  arena.chunks_.clear();
+  arena.chunk_size_ = 0;
+  arena.chunk_used_ = 0;
+}
+
+StringPool::Entry* StringPool::FindIndexed(const StringPiece& str, size_t hash,
+                                           uint32_t priority) const {
+  if (index_.empty()) {
+    return nullptr;
+  }
+
+  const size_t mask = index_.size() - 1;
+  for (size_t slot = hash & mask; index_[slot] != nullptr; slot = (slot + 1) & mask) {
+    Entry* entry = index_[slot];
+    if (entry->hash_ == hash && entry->context.priority == priority && entry->value == str) {
+      return entry;
+    }
+  }
+  return nullptr;
+}
+
+void StringPool::AddToIndex(Entry* entry) {
+  const size_t mask = index_.size() - 1;
+  size_t slot = entry->hash_ & mask;
+  while (index_[slot] != nullptr) {
+    slot = (slot + 1) & mask;
+  }
+  index_[slot] = entry;
+}
+
+void StringPool::RebuildIndex(size_t capacity) {
+  index_.assign(capacity, nullptr);
+
+  // Index in order, so that of the strings added twice by Merge, the first one is found.
+  for (Entry* entry : strings_) {
+    AddToIndex(entry);
+  }
+}
+
+void StringPool::ReserveIndex(size_t count) {
+  if (count * 2 <= index_.size()) {
+    return;
+  }
+
+  size_t capacity = std::max<size_t>(index_.size(), 64u);
+  while (count * 2 > capacity) {
+    capacity *= 2;
+  }
+  RebuildIndex(capacity);
+}
+
+void StringPool::IndexStrings(size_t first) {
+  const size_t capacity = index_.size();
+  ReserveIndex(strings_.size());
+  if (index_.size() != capacity) {
+    // The index was rebuilt, with all the strings.
+    return;
+  }
+
+  for (size_t i = first; i < strings_.size(); i++) {
+    AddToIndex(strings_[i]);
+  }
+}
+
 StringPool::Ref StringPool::MakeRefImpl(const StringPiece& str, const Context& context,
                                         bool unique) {
+  const size_t hash = std::hash<StringPiece>()(str);
   if (unique) {
-    auto range = indexed_strings_.equal_range(str);
-    for (auto iter = range.first; iter != range.second; ++iter) {
-      if (context.priority == iter->second->context.priority) {
-        return Ref(iter->second);
-      }
+    if (Entry* entry = FindIndexed(str, hash, context.priority)) {
+      return Ref(entry);
     }
   }
 
-  std::unique_ptr<Entry> entry(new Entry());
+  Entry* entry = string_arena_.Allocate();
   entry->value = str.to_string();
   entry->context = context;
   entry->index_ = strings_.size();
   entry->ref_ = 0;
   entry->pool_ = this;
+  entry->hash_ = hash;
 
-  Entry* borrow = entry.get();
-  strings_.emplace_back(std::move(entry));
-  indexed_strings_.insert(std::make_pair(StringPiece(borrow->value), borrow));
-  return Ref(borrow);
+  strings_.push_back(entry);
+  IndexStrings(strings_.size() - 1);
+  return Ref(entry);
 }
 
 StringPool::Ref StringPool::MakeRef(const Ref& ref) {
@@ -205,33 +319,33 @@ StringPool::StyleRef StringPool::MakeRef(const StyleString& str) {
 }
 
 StringPool::StyleRef StringPool::MakeRef(const StyleString& str, const Context& context) {
-  std::unique_ptr<StyleEntry> entry(new StyleEntry());
+  StyleEntry* entry = style_arena_.Allocate();
   entry->value = str.str;
   entry->context = context;
   entry->index_ = styles_.size();
   entry->ref_ = 0;
+  entry->spans.reserve(str.spans.size());
   for (const aapt::Span& span : str.spans) {
     entry->spans.emplace_back(Span{MakeRef(span.name), span.first_char, span.last_char});
   }
 
-  StyleEntry* borrow = entry.get();
-  styles_.emplace_back(std::move(entry));
-  return StyleRef(borrow);
+  styles_.push_back(entry);
+  return StyleRef(entry);
 }
 
 StringPool::StyleRef StringPool::MakeRef(const StyleRef& ref) {
-  std::unique_ptr<StyleEntry> entry(new StyleEntry());
+  StyleEntry* entry = style_arena_.Allocate();
   entry->value = ref.entry_->value;
   entry->context = ref.entry_->context;
   entry->index_ = styles_.size();
   entry->ref_ = 0;
+  entry->spans.reserve(ref.entry_->spans.size());
   for (const Span& span : ref.entry_->spans) {
     entry->spans.emplace_back(Span{MakeRef(*span.name), span.first_char, span.last_char});
   }
 
-  StyleEntry* borrow = entry.get();
-  styles_.emplace_back(std::move(entry));
-  return StyleRef(borrow);
+  styles_.push_back(entry);
+  return StyleRef(entry);
 }
 
 void StringPool::ReAssignIndices() {
@@ -250,17 +364,20 @@ void StringPool::ReAssignIndices() {
 
 void StringPool::Merge(StringPool&& pool) {
   // First, change the owning pool for the incoming strings.
-  for (std::unique_ptr<Entry>& entry : pool.strings_) {
+  for (Entry* entry : pool.strings_) {
     entry->pool_ = this;
   }
 
-  // Now move the styles, strings, and indices over.
-  std::move(pool.styles_.begin(), pool.styles_.end(), std::back_inserter(styles_));
+  // Now move the entries, styles, strings, and indices over. The entries keep their addresses.
+  string_arena_.Merge(std::move(pool.string_arena_));
+  style_arena_.Merge(std::move(pool.style_arena_));
+  styles_.insert(styles_.end(), pool.styles_.begin(), pool.styles_.end());
   pool.styles_.clear();
-  std::move(pool.strings_.begin(), pool.strings_.end(), std::back_inserter(strings_));
+  const size_t first_merged = strings_.size();
+  strings_.insert(strings_.end(), pool.strings_.begin(), pool.strings_.end());
   pool.strings_.clear();
-  indexed_strings_.insert(pool.indexed_strings_.begin(), pool.indexed_strings_.end());
-  pool.indexed_strings_.clear();
+  pool.index_.clear();
+  IndexStrings(first_merged);
 
   ReAssignIndices();
 }
@@ -268,41 +385,51 @@ void StringPool::Merge(StringPool&& pool) {
 void StringPool::HintWillAdd(size_t string_count, size_t style_count) {
   strings_.reserve(strings_.size() + string_count);
   styles_.reserve(styles_.size() + style_count);
+  string_arena_.Reserve(string_count);
+  style_arena_.Reserve(style_count);
+  ReserveIndex(strings_.size() + string_count);
 }
 
 void StringPool::Prune() {
-  const auto iter_end = indexed_strings_.end();
-  auto index_iter = indexed_strings_.begin();
-  while (index_iter != iter_end) {
-    if (index_iter->second->ref_ <= 0) {
-      index_iter = indexed_strings_.erase(index_iter);
-    } else {
-      ++index_iter;
+  std::vector<Entry*> pruned_strings;
+  auto strings_end = std::remove_if(strings_.begin(), strings_.end(), [&](Entry* entry) -> bool {
+    if (entry->ref_ <= 0) {
+      pruned_strings.push_back(entry);
+      return true;
     }
-  }
-
-  auto end_iter2 =
-      std::remove_if(strings_.begin(), strings_.end(),
-                     [](const std::unique_ptr<Entry>& entry) -> bool { return entry->ref_ <= 0; });
-  auto end_iter3 = std::remove_if(
-      styles_.begin(), styles_.end(),
-      [](const std::unique_ptr<StyleEntry>& entry) -> bool { return entry->ref_ <= 0; });
+    return false;
+  });
+  std::vector<StyleEntry*> pruned_styles;
+  auto styles_end = std::remove_if(styles_.begin(), styles_.end(), [&](StyleEntry* entry) -> bool {
+    if (entry->ref_ <= 0) {
+      pruned_styles.push_back(entry);
+      return true;
+    }
+    return false;
+  });
+  strings_.erase(strings_end, strings_.end());
+  styles_.erase(styles_end, styles_.end());
 
-  // Remove the entries at the end or else we'll be accessing a deleted string from the StyleEntry.
-  strings_.erase(end_iter2, strings_.end());
-  styles_.erase(end_iter3, styles_.end());
+  // Free the styles first or else we'll be accessing a freed string from the spans of a StyleEntry.
+  for (StyleEntry* entry : pruned_styles) {
+    style_arena_.Free(entry);
+  }
+  for (Entry* entry : pruned_strings) {
+    string_arena_.Free(entry);
+  }
 
+  if (!index_.empty()) {
+    RebuildIndex(index_.size());
+  }
   ReAssignIndices();
 }
 
 template <typename E>
 static void SortEntries(
-    std::vector<std::unique_ptr<E>>& entries,
+    std::vector<E*>& entries,
     const std::function<int(const StringPool::Context&, const StringPool::Context&)>& cmp) {
-  using UEntry = std::unique_ptr<E>;
-
   if (cmp != nullptr) {
-    std::sort(entries.begin(), entries.end(), [&cmp](const UEntry& a, const UEntry& b) -> bool {
+    std::sort(entries.begin(), entries.end(), [&cmp](const E* a, const E* b) -> bool {
       int r = cmp(a->context, b->context);
       if (r == 0) {
         r = a->value.compare(b->value);
@@ -311,7 +438,7 @@ static void SortEntries(
     });
   } else {
     std::sort(entries.begin(), entries.end(),
-              [](const UEntry& a, const UEntry& b) -> bool { return a->value < b->value; });
+              [](const E* a, const E* b) -> bool { return a->value < b->value; });
   }
 }
 
@@ -364,10 +491,25 @@ static size_t EncodedLengthUnits(size_t length) {
 
 const std::string kStringTooLarge = "STRING_TOO_LARGE";
 
+// Returns whether `str` has 4 byte codepoints, which Modified UTF-8 encodes differently.
+static bool NeedsModifiedUtf8(const std::string& str) {
+  for (char c : str) {
+    if ((static_cast<uint8_t>(c) >> 4) == 0xF) {
+      return true;
+    }
+  }
+  return false;
+}
+
 static bool EncodeString(const std::string& str, const bool utf8, BigBuffer* out,
                          IDiagnostics* diag) {
   if (utf8) {
-    const std::string& encoded = util::Utf8ToModifiedUtf8(str);
+    // Most strings are already valid Modified UTF-8, so avoid copying them.
+    std::string modified;
+    if (NeedsModifiedUtf8(str)) {
+      modified = util::Utf8ToModifiedUtf8(str);
+    }
+    const std::string& encoded = modified.empty() ? str : modified;
     const ssize_t utf16_length = utf8_to_utf16_length(
         reinterpret_cast<const uint8_t*>(encoded.data()), encoded.size());
     CHECK(utf16_length >= 0);
@@ -397,8 +539,9 @@ static bool EncodeString(const std::string& str, const bool utf8, BigBuffer* out
     strncpy(data, encoded.data(), encoded.size());
 
   } else {
-    const std::u16string encoded = util::Utf8ToUtf16(str);
-    const ssize_t utf16_length = encoded.size();
+    // Convert straight into the buffer instead of through a temporary UTF-16 string.
+    const ssize_t utf16_length = std::max<ssize_t>(
+        utf8_to_utf16_length(reinterpret_cast<const uint8_t*>(str.data()), str.size()), 0);
 
     // Make sure the length to be encoded does not exceed the maximum possible
     // length that can be encoded
@@ -412,17 +555,16 @@ static bool EncodeString(const std::string& str, const bool utf8, BigBuffer* out
 
     // Total number of 16-bit words to write.
     const size_t total_size = EncodedLengthUnits<char16_t>(utf16_length)
-        + encoded.size() + 1;
+        + utf16_length + 1;
 
     char16_t* data = out->NextBlock<char16_t>(total_size);
 
     // Encode the actual UTF16 string length.
     data = EncodeLength(data, utf16_length);
-    const size_t byte_length = encoded.size() * sizeof(char16_t);
-
-    // NOTE: For some reason, strncpy16(data, entry->value.data(),
-    // entry->value.size()) truncates the string.
-    memcpy(data, encoded.data(), byte_length);
+    if (utf16_length > 0) {
+      utf8_to_utf16(reinterpret_cast<const uint8_t*>(str.data()), str.size(), data,
+                    utf16_length + 1);
+    }
 
     // The null-terminating character is already here due to the block of data
     // being set to 0s on allocation.
@@ -452,12 +594,12 @@ bool StringPool::Flatten(BigBuffer* out, const StringPool& pool, bool utf8,
   header->stringsStart = before_strings_index - start_index;
 
   // Styles always come first.
-  for (const std::unique_ptr<StyleEntry>& entry : pool.styles_) {
+  for (const StyleEntry* entry : pool.styles_) {
     *indices++ = out->size() - before_strings_index;
     no_error = EncodeString(entry->value, utf8, out, diag) && no_error;
   }
 
-  for (const std::unique_ptr<Entry>& entry : pool.strings_) {
+  for (const Entry* entry : pool.strings_) {
     *indices++ = out->size() - before_strings_index;
     no_error = EncodeString(entry->value, utf8, out, diag) && no_error;
   }
@@ -468,7 +610,7 @@ bool StringPool::Flatten(BigBuffer* out, const StringPool& pool, bool utf8,
     const size_t before_styles_index = out->size();
     header->stylesStart = util::HostToDevice32(before_styles_index - start_index);
 
-    for (const std::unique_ptr<StyleEntry>& entry : pool.styles_) {
+    for (const StyleEntry* entry : pool.styles_) {
       *style_indices++ = out->size() - before_styles_index;
 
       if (!entry->spans.empty()) {
@@ -131,6 +131,9 @@ class StringPool {
     size_t index_;
     int ref_;
     const StringPool* pool_;
+
+    // The hash of `value`, by which the entry is indexed.
+    size_t hash_;
   };
 
   struct Span {
@@ -185,7 +188,7 @@ class StringPool {
   // empty.
   void Merge(StringPool&& pool);
 
-  inline const std::vector<std::unique_ptr<Entry>>& strings() const {
+  inline const std::vector<Entry*>& strings() const {
     return strings_;
   }
 
@@ -208,14 +211,67 @@ class StringPool {
  private:
   DISALLOW_COPY_AND_ASSIGN(StringPool);
 
+  // Allocates the entries of a pool in chunks, so that adding a string does not allocate its entry
+  // on its own. The entries never move, since Refs point at them. Freed entries are reused.
+  template <typename T>
+  class EntryArena {
+   public:
+    EntryArena() = default;
+    EntryArena(EntryArena&&) = default;
+    EntryArena& operator=(EntryArena&&) = default;
+
+    T* Allocate();
+
+    // Resets the entry, releasing what it holds, and keeps it for reuse.
+    void Free(T* entry);
+
+    // Makes room for `count` more entries.
+    void Reserve(size_t count);
+
+    // Takes over the entries of `arena`, which keep their addresses.
+    void Merge(EntryArena&& arena);
+
+   private:
+    DISALLOW_COPY_AND_ASSIGN(EntryArena);
+
+    void AddChunk(size_t size);
+
+    std::vector<std::unique_ptr<T[]>> chunks_;
+    size_t chunk_size_ = 0;
+    size_t chunk_used_ = 0;
+    std::vector<T*> free_;
+  };
+
   static bool Flatten(BigBuffer* out, const StringPool& pool, bool utf8, IDiagnostics* diag);
 
   Ref MakeRefImpl(const android::StringPiece& str, const Context& context, bool unique);
   void ReAssignIndices();
 
-  std::vector<std::unique_ptr<Entry>> strings_;
-  std::vector<std::unique_ptr<StyleEntry>> styles_;
-  std::unordered_multimap<android::StringPiece, Entry*> indexed_strings_;
+  // Returns the indexed string with the value `str`, of hash `hash`, and the given priority.
+  Entry* FindIndexed(const android::StringPiece& str, size_t hash, uint32_t priority) const;
+
+  // Adds the entry to the index, which must have a free slot.
+  void AddToIndex(Entry* entry);
+
+  // Re-indexes all the strings in an index of `capacity` slots, a power of two.
+  void RebuildIndex(size_t capacity);
+
+  // Grows the index, if needed, to hold `count` strings.
+  void ReserveIndex(size_t count);
+
+  // Indexes the strings from `first` on, growing the index if needed.
+  void IndexStrings(size_t first);
+
+  // The styles are declared last, so that they are destroyed before the strings their spans
+  // reference.
+  EntryArena<Entry> string_arena_;
+  std::vector<Entry*> strings_;
+  EntryArena<StyleEntry> style_arena_;
+  std::vector<StyleEntry*> styles_;
+
+  // An open addressed hash index of `strings_`, by value, kept at most half full. A value added with
+  // several priorities has a slot per priority.
+  std::vector<Entry*> index_;
 };
 
 }  // namespace aapt
@@ -111,6 +111,47 @@ TEST(StringPoolTest, PruneStringsWithNoReferences) {
   EXPECT_THAT(pool.size(), Eq(1u));
 }
 
+TEST(StringPoolTest, DedupeManyStringsAndReusePrunedEntries) {
+  StringPool pool;
+
+  std::vector<StringPool::Ref> refs;
+  for (size_t i = 0; i < 1000; i++) {
+    refs.push_back(pool.MakeRef("string " + std::to_string(i)));
+  }
+  ASSERT_THAT(pool.size(), Eq(1000u));
+
+  for (size_t i = 0; i < 1000; i++) {
+    StringPool::Ref ref = pool.MakeRef("string " + std::to_string(i));
+    EXPECT_THAT(ref.index(), Eq(refs[i].index()));
+  }
+  EXPECT_THAT(pool.size(), Eq(1000u));
+
+  // Drop every other string and add new ones in their place.
+  for (size_t i = 0; i < 1000; i += 2) {
+    refs[i] = StringPool::Ref();
+  }
+  pool.Prune();
+  ASSERT_THAT(pool.size(), Eq(500u));
+
+  for (size_t i = 0; i < 1000; i += 2) {
+    refs[i] = pool.MakeRef("other " + std::to_string(i));
+  }
+  EXPECT_THAT(pool.size(), Eq(1000u));
+
+  for (size_t i = 1; i < 1000; i += 2) {
+    StringPool::Ref ref = pool.MakeRef("string " + std::to_string(i));
+    EXPECT_THAT(ref.index(), Eq(refs[i].index()));
+  }
+  EXPECT_THAT(pool.MakeRef("other 10").index(), Eq(refs[10].index()));
+
+  StringPool other_pool;
+  StringPool::Ref other_ref = other_pool.MakeRef("merged");
+  pool.Merge(std::move(other_pool));
+  EXPECT_THAT(pool.size(), Eq(1001u));
+  EXPECT_THAT(*pool.MakeRef("merged"), Eq("merged"));
+  EXPECT_THAT(pool.size(), Eq(1001u));
+}
+
 TEST(StringPoolTest, SortAndMaintainIndexesInStringReferences) {
   StringPool pool;
 
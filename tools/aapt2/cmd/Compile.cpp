@@ -17,7 +17,13 @@
 #include "Compile.h"
 
 #include <dirent.h>
+
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
 #include <string>
+#include <thread>
+#include <vector>
 
 #include "android-base/errors.h"
 #include "android-base/file.h"
@@ -30,10 +36,12 @@
 #include "Diagnostics.h"
 #include "ResourceParser.h"
 #include "ResourceTable.h"
+#include "ResourceUtils.h"
 #include "cmd/Util.h"
 #include "compile/IdAssigner.h"
 #include "compile/InlineXmlFormatParser.h"
 #include "compile/Png.h"
+#include "compile/PngCache.h"
 #include "compile/PseudolocaleGenerator.h"
 #include "compile/XmlIdCollector.h"
 #include "format/Archive.h"
@@ -475,12 +483,31 @@ static bool CompilePng(IAaptContext* context, const CompileOptions& options,
       return false;
     }
 
+    const StringPiece content(reinterpret_cast<const char*>(data->data()), data->size());
+    const bool is_nine_patch = path_data.extension == "9.png";
+
+    // A PNG in the cache was already crunched by an earlier compile.
+    std::string cache_key;
+    if (options.png_cache_dir) {
+      const PngCache cache(options.png_cache_dir.value());
+      cache_key = PngCache::GetKey(content, is_nine_patch);
+      std::string cached_png;
+      if (cache.Find(cache_key, &cached_png)) {
+        if (context->IsVerbose()) {
+          context->GetDiagnostics()->Note(DiagMessage(path_data.source)
+                                          << "using crunched PNG from the PNG cache");
+        }
+        io::StringInputStream cached_png_in(cached_png);
+        return WriteHeaderAndDataToWriter(output_path, res_file, &cached_png_in, writer,
+                                          context->GetDiagnostics());
+      }
+    }
+
     BigBuffer crunched_png_buffer(4096);
     io::BigBufferOutputStream crunched_png_buffer_out(&crunched_png_buffer);
 
     // Ensure that we only keep the chunks we care about if we end up
     // using the original PNG instead of the crunched one.
-    const StringPiece content(reinterpret_cast<const char*>(data->data()), data->size());
     PngChunkFilter png_chunk_filter(content);
     std::unique_ptr<Image> image = ReadPng(context, path_data.source, &png_chunk_filter);
     if (!image) {
@@ -488,7 +515,7 @@ static bool CompilePng(IAaptContext* context, const CompileOptions& options,
     }
 
     std::unique_ptr<NinePatch> nine_patch;
-    if (path_data.extension == "9.png") {
+    if (is_nine_patch) {
       std::string err;
       nine_patch = NinePatch::Create(image->rows.get(), image->width, image->height, &err);
       if (!nine_patch) {
@@ -554,6 +581,15 @@ static bool CompilePng(IAaptContext* context, const CompileOptions& options,
                                       << "legacy=" << legacy_buffer.size()
                                       << " new=" << buffer.size());
     }
+
+    if (!cache_key.empty()) {
+      const PngCache cache(options.png_cache_dir.value());
+      std::string error;
+      if (!cache.Store(cache_key, buffer.to_string(), &error)) {
+        context->GetDiagnostics()->Warn(DiagMessage(path_data.source)
+                                        << "failed to update the PNG cache: " << error);
+      }
+    }
   }
 
   io::BigBufferInputStream buffer_in(&buffer);
@@ -643,10 +679,92 @@ class CompileContext : public IAaptContext {
   bool verbose_ = false;
 };
 
+using CompileFunc = bool (*)(IAaptContext* context, const CompileOptions& options,
+                            const ResourcePathData& path_data, io::IFile* file,
+                            IArchiveWriter* writer, const std::string& output_path);
+
+// An input file and how to compile it.
+struct CompileJob {
+  io::IFile* file;
+  ResourcePathData path_data;
+  CompileFunc compile_func;
+  std::string out_path;
+};
+
+// Compiles the jobs on `options.jobs` threads. Each job writes to its own in-memory archive; the
+// archives and the messages of the jobs are handed over to the output writer and the diagnostics
+// of `context` in the order of the jobs, so the output does not depend on the scheduling.
+static bool CompileInParallel(IAaptContext* context, const CompileOptions& options,
+                              const std::vector<CompileJob>& jobs, IArchiveWriter* output_writer) {
+  struct JobResult {
+    explicit JobResult(IAaptContext* context) : context(context) {
+    }
+
+    BufferedDiagnosticsContext context;
+    BufferedArchiveWriter writer;
+    bool success = false;
+    bool done = false;
+  };
+
+  std::vector<std::unique_ptr<JobResult>> results;
+  results.reserve(jobs.size());
+  for (size_t i = 0; i < jobs.size(); i++) {
+    results.push_back(util::make_unique<JobResult>(context));
+  }
+
+  std::mutex mutex;
+  std::condition_variable job_done;
+  std::atomic<size_t> next_job(0);
+  auto worker = [&]() {
+    for (size_t i = next_job++; i < jobs.size(); i = next_job++) {
+      const CompileJob& job = jobs[i];
+      JobResult* result = results[i].get();
+      result->success = job.compile_func(&result->context, options, job.path_data, job.file,
+                                         &result->writer, job.out_path);
+      std::lock_guard<std::mutex> lock(mutex);
+      result->done = true;
+      job_done.notify_all();
+    }
+  };
+
+  std::vector<std::thread> threads;
+  const size_t thread_count = std::min(options.jobs, jobs.size());
+  for (size_t i = 0; i < thread_count; i++) {
+    threads.emplace_back(worker);
+  }
+
+  bool error = false;
+  for (size_t i = 0; i < jobs.size(); i++) {
+    {
+      std::unique_lock<std::mutex> lock(mutex);
+      job_done.wait(lock, [&]() { return results[i]->done; });
+    }
+
+    std::unique_ptr<JobResult> result = std::move(results[i]);
+    result->context.GetBufferedDiagnostics()->Replay(context->GetDiagnostics());
+    if (!result->writer.WriteTo(output_writer)) {
+      context->GetDiagnostics()->Error(DiagMessage(jobs[i].out_path)
+                                       << "failed to write: " << output_writer->GetError());
+      result->success = false;
+    }
+    if (!result->success) {
+      context->GetDiagnostics()->Error(DiagMessage(jobs[i].file->GetSource())
+                                       << "file failed to compile");
+      error = true;
+    }
+  }
+
+  for (std::thread& thread : threads) {
+    thread.join();
+  }
+  return !error;
+}
+
 int Compile(IAaptContext* context, io::IFileCollection* inputs, IArchiveWriter* output_writer,
              CompileOptions& options) {
   TRACE_CALL();
   bool error = false;
+  std::vector<CompileJob> jobs;
 
   // Iterate over the input files in a stable, platform-independent manner
   auto file_iterator  = inputs->Iterator();
@@ -676,7 +794,7 @@ int Compile(IAaptContext* context, io::IFileCollection* inputs, IArchiveWriter*
     }
 
     // Determine how to compile the file based on its type.
-    auto compile_func = &CompileFile;
+    CompileFunc compile_func = &CompileFile;
     if (path_data.resource_dir == "values" && path_data.extension == "xml") {
       compile_func = &CompileTable;
       // We use a different extension (not necessary anymore, but avoids altering the existing
@@ -711,10 +829,24 @@ int Compile(IAaptContext* context, io::IFileCollection* inputs, IArchiveWriter*
     }
 
     const std::string out_path = BuildIntermediateContainerFilename(path_data);
-    if (!compile_func(context, options, path_data, file, output_writer, out_path)) {
-      context->GetDiagnostics()->Error(DiagMessage(file->GetSource()) << "file failed to compile");
+    jobs.push_back(CompileJob{file, std::move(path_data), compile_func, out_path});
+  }
+
+  // Every values file writes the text symbols file, so the last one has to win: keep those
+  // compilations in order.
+  if (options.jobs > 1 && jobs.size() > 1 && !options.generate_text_symbols_path) {
+    if (!CompileInParallel(context, options, jobs, output_writer)) {
       error = true;
     }
+  } else {
+    for (const CompileJob& job : jobs) {
+      if (!job.compile_func(context, options, job.path_data, job.file, output_writer,
+                            job.out_path)) {
+        context->GetDiagnostics()->Error(DiagMessage(job.file->GetSource())
+                                         << "file failed to compile");
+        error = true;
+      }
+    }
   }
 
   return error ? 1 : 0;
@@ -801,6 +933,23 @@ int CompileCommand::Action(const std::vector<std::string>& args) {
     return 1;
   }
 
+  if (jobs_) {
+    const Maybe<uint32_t> maybe_jobs = ResourceUtils::ParseInt(jobs_.value());
+    if (!maybe_jobs || maybe_jobs.value() == 0) {
+      context.GetDiagnostics()->Error(DiagMessage() << "-j '" << jobs_.value()
+                                                    << "' is not a valid number of jobs");
+      return 1;
+    }
+    options_.jobs = maybe_jobs.value();
+  }
+
+  if (options_.png_cache_dir && !file::mkdirs(options_.png_cache_dir.value())) {
+    context.GetDiagnostics()->Error(DiagMessage(options_.png_cache_dir.value())
+                                    << "failed to create the PNG cache: "
+                                    << SystemErrorCodeToString(errno));
+    return 1;
+  }
+
   return Compile(&context, file_collection.get(), archive_writer.get(), options_);
 }
 
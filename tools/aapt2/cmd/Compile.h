@@ -38,6 +38,10 @@ struct CompileOptions {
   // See comments on aapt::ResourceParserOptions.
   bool preserve_visibility_of_styleables = false;
   bool verbose = false;
+  // Number of files compiled in parallel.
+  size_t jobs = 1;
+  // Directory where crunched PNGs are cached between builds, if any.
+  Maybe<std::string> png_cache_dir;
 };
 
 /** Parses flags and compiles resources to be used in linking.  */
@@ -67,6 +71,11 @@ class CompileCommand : public Command {
         "Sets the visibility of the compiled resources to the specified\n"
             "level. Accepted levels: public, private, default", &visibility_);
     AddOptionalSwitch("-v", "Enables verbose logging", &options_.verbose);
+    AddOptionalFlag("-j", "Number of files to compile in parallel. Defaults to 1.", &jobs_);
+    AddOptionalFlag("--png-cache",
+        "Directory where crunched PNGs are cached between builds. A PNG is crunched\n"
+            "again only if its content changed.",
+        &options_.png_cache_dir, Command::kPath);
     AddOptionalFlag("--trace-folder", "Generate systrace json trace fragment to specified folder.",
                     &trace_folder_);
   }
@@ -78,6 +87,7 @@ class CompileCommand : public Command {
   CompileOptions options_;
   Maybe<std::string> visibility_;
   Maybe<std::string> trace_folder_;
+  Maybe<std::string> jobs_;
 };
 
 int Compile(IAaptContext* context, io::IFileCollection* inputs, IArchiveWriter* output_writer,
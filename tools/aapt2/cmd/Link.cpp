@@ -20,7 +20,12 @@
 #include <cinttypes>
 
 #include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
 #include <queue>
+#include <sstream>
+#include <thread>
 #include <unordered_map>
 #include <vector>
 
@@ -29,6 +34,7 @@
 #include "android-base/stringprintf.h"
 #include "androidfw/Locale.h"
 #include "androidfw/StringPiece.h"
+#include "google/protobuf/arena.h"
 
 #include "AppInfo.h"
 #include "Debug.h"
@@ -50,11 +56,13 @@
 #include "io/BigBufferStream.h"
 #include "io/FileStream.h"
 #include "io/FileSystem.h"
+#include "io/StringStream.h"
 #include "io/Util.h"
 #include "io/ZipArchive.h"
 #include "java/JavaClassGenerator.h"
 #include "java/ManifestClassGenerator.h"
 #include "java/ProguardRules.h"
+#include "link/LinkCache.h"
 #include "link/Linkers.h"
 #include "link/ManifestFixer.h"
 #include "link/NoDefaultResourceRemover.h"
@@ -75,9 +83,43 @@ using ::aapt::io::FileInputStream;
 using ::android::ConfigDescription;
 using ::android::StringPiece;
 using ::android::base::StringPrintf;
+using ::android::base::SystemErrorCodeToString;
 
 namespace aapt {
 
+namespace {
+
+struct CachedStaticLibrary {
+  file::FileStamp stamp;
+  std::shared_ptr<LoadedApk> apk;
+};
+
+// Static libraries included with -I, keyed by path and by the package name they were renamed to
+// with --no-static-lib-packages. Their tables are only read once loaded, so links can share them.
+struct StaticLibraryCache {
+  std::mutex lock;
+  bool enabled = false;
+  std::map<std::string, CachedStaticLibrary> libraries;
+};
+
+StaticLibraryCache& GetStaticLibraryCache() {
+  static StaticLibraryCache* cache = new StaticLibraryCache();
+  return *cache;
+}
+
+}  // namespace
+
+void LinkCommand::SetIncludeCacheEnabled(bool enabled) {
+  AssetManagerSymbolSource::SetApkAssetsCacheEnabled(enabled);
+
+  StaticLibraryCache& cache = GetStaticLibraryCache();
+  std::lock_guard<std::mutex> lock(cache.lock);
+  cache.enabled = enabled;
+  if (!enabled) {
+    cache.libraries.clear();
+  }
+}
+
 class LinkContext : public IAaptContext {
  public:
   explicit LinkContext(IDiagnostics* diagnostics)
@@ -259,6 +301,34 @@ static bool FlattenXml(IAaptContext* context, const xml::XmlResource& xml_res,
   return false;
 }
 
+// Flattens the XML file like FlattenXml, but to `out_data` instead of an archive.
+static bool FlattenXmlToString(IAaptContext* context, const xml::XmlResource& xml_res,
+                               bool keep_raw_values, bool utf16, OutputFormat format,
+                               std::string* out_data) {
+  TRACE_CALL();
+  switch (format) {
+    case OutputFormat::kApk: {
+      BigBuffer buffer(1024);
+      XmlFlattenerOptions options = {};
+      options.keep_raw_values = keep_raw_values;
+      options.use_utf16 = utf16;
+      XmlFlattener flattener(&buffer, options);
+      if (!flattener.Consume(context, &xml_res)) {
+        return false;
+      }
+      *out_data = buffer.to_string();
+      return true;
+    } break;
+
+    case OutputFormat::kProto: {
+      pb::XmlNode pb_node;
+      SerializeXmlResourceToPb(xml_res, &pb_node);
+      return pb_node.SerializeToString(out_data);
+    } break;
+  }
+  return false;
+}
+
 // Inflates an XML file from the source path.
 static std::unique_ptr<xml::XmlResource> LoadXml(const std::string& path, IDiagnostics* diag) {
   TRACE_CALL();
@@ -280,8 +350,14 @@ struct ResourceFileFlattenerOptions {
   bool update_proguard_spec = false;
   bool do_not_fail_on_missing_resources = false;
   OutputFormat output_format = OutputFormat::kApk;
+  size_t jobs = 1;
   std::unordered_set<std::string> extensions_to_not_compress;
   Maybe<std::regex> regex_to_not_compress;
+
+  // When set, the linked XML files are looked up in and added to this cache. `link_cache_key`
+  // holds what the XML files depend on besides the table and these options, like the includes.
+  LinkCache* link_cache = nullptr;
+  LinkCacheKey link_cache_key;
 };
 
 // A sampling of public framework resource IDs.
@@ -348,10 +424,44 @@ class ResourceFileFlattener {
 
     // The destination to write this file to.
     std::string dst_path;
+
+    // The key of the linked XML in the link cache, or empty if it is not cached.
+    std::string cache_key;
   };
 
-  std::vector<std::unique_ptr<xml::XmlResource>> LinkAndVersionXmlFile(ResourceTable* table,
-                                                                       FileOperation* file_op);
+  // A file of the table that is ready to be written to the archive. It is either a linked XML to
+  // flatten, a file to copy as-is, or an XML that was already flattened.
+  struct OutputFile {
+    std::unique_ptr<xml::XmlResource> xml_to_flatten;
+    io::IFile* file_to_copy = nullptr;
+    std::string flattened_xml;
+    std::string dst_path;
+
+    // Whether `xml_to_flatten` is kept in `flattened_xml` once flattened, to store it in the cache.
+    bool keep_flattened_xml = false;
+  };
+
+  // The link cache entry of an XML file, waiting for its documents to be flattened.
+  struct PendingCacheEntry {
+    std::string key;
+    LinkCache::Entry entry;
+
+    // The index of the output file of each file of the entry.
+    std::vector<size_t> output_files;
+  };
+
+  std::string GetLinkCacheKey(const LinkCacheKey& table_key, ResourceEntry* entry,
+                              const FileOperation& file_op, const io::IData& data);
+
+  bool AddCachedXmlFile(ResourceTable* table, const FileOperation& file_op,
+                        LinkCache::Entry* cached, std::vector<OutputFile>* output_files);
+
+  std::vector<std::unique_ptr<xml::XmlResource>> LinkAndVersionXmlFile(
+      ResourceTable* table, FileOperation* file_op, proguard::KeepSet* keep_set);
+
+  bool WriteFile(IAaptContext* context, OutputFile* file, IArchiveWriter* archive_writer);
+
+  bool WriteFiles(std::vector<OutputFile>* files, IArchiveWriter* archive_writer);
 
   ResourceFileFlattenerOptions options_;
   IAaptContext* context_;
@@ -430,7 +540,7 @@ std::vector<T> make_singleton_vec(T&& val) {
 }
 
 std::vector<std::unique_ptr<xml::XmlResource>> ResourceFileFlattener::LinkAndVersionXmlFile(
-    ResourceTable* table, FileOperation* file_op) {
+    ResourceTable* table, FileOperation* file_op, proguard::KeepSet* keep_set) {
   TRACE_CALL();
   xml::XmlResource* doc = file_op->xml_to_flatten.get();
   const Source& src = doc->file.source;
@@ -449,7 +559,7 @@ std::vector<std::unique_ptr<xml::XmlResource>> ResourceFileFlattener::LinkAndVer
     return {};
   }
 
-  if (options_.update_proguard_spec && !proguard::CollectProguardRules(context_, doc, keep_set_)) {
+  if (options_.update_proguard_spec && !proguard::CollectProguardRules(context_, doc, keep_set)) {
     return {};
   }
 
@@ -499,6 +609,99 @@ static auto kDrawableVersions = std::map<std::string, ApiVersion>{
     { "adaptive-icon" , SDK_O },
 };
 
+// Adds what linking the XML files of `table` depends on to `key`: the IDs and visibility of the
+// resources they can reference, and the definitions of the attributes they can use. The values of
+// the other resources don't matter, so changing them keeps the cached XML files valid.
+static void AddTableToLinkCacheKey(const ResourceTable& table, LinkCacheKey* key) {
+  for (const auto& package : table.packages) {
+    key->Add(package->name);
+    key->Add(package->id ? package->id.value() : 0x100u);
+    for (const auto& type : package->types) {
+      key->Add(to_string(type->type));
+      key->Add(type->id ? type->id.value() : 0x100u);
+      key->Add(static_cast<uint64_t>(type->visibility_level));
+      for (const auto& entry : type->entries) {
+        key->Add(entry->name);
+        key->Add(entry->id ? entry->id.value() : 0x10000u);
+        key->Add(static_cast<uint64_t>(entry->visibility.level));
+        if (type->type != ResourceType::kAttr && type->type != ResourceType::kAttrPrivate) {
+          continue;
+        }
+
+        for (const auto& config_value : entry->values) {
+          if (config_value->value) {
+            std::stringstream attr;
+            config_value->value->Print(&attr);
+            key->Add(config_value->config.to_string());
+            key->Add(attr.str());
+          }
+        }
+      }
+    }
+  }
+
+  for (const auto& included_package : table.included_packages_) {
+    key->Add(included_package.first);
+    key->Add(included_package.second);
+  }
+}
+
+std::string ResourceFileFlattener::GetLinkCacheKey(const LinkCacheKey& table_key,
+                                                   ResourceEntry* entry,
+                                                   const FileOperation& file_op,
+                                                   const io::IData& data) {
+  LinkCacheKey key = table_key;
+  key.Add(StringPiece(reinterpret_cast<const char*>(data.data()), data.size()));
+
+  const ResourceFile& file = file_op.xml_to_flatten->file;
+  key.Add(file.name.to_string());
+  key.Add(file.source.to_string());
+  key.Add(file.config.to_string());
+  key.Add(file_op.dst_path);
+
+  // The auto-versioned copies depend on the other configurations of the entry.
+  for (const auto& config_value : entry->values) {
+    key.Add(config_value->config.to_string());
+  }
+  return key.ToString();
+}
+
+bool ResourceFileFlattener::AddCachedXmlFile(ResourceTable* table, const FileOperation& file_op,
+                                             LinkCache::Entry* cached,
+                                             std::vector<OutputFile>* output_files) {
+  const ResourceFile& file = file_op.xml_to_flatten->file;
+  if (context_->IsVerbose()) {
+    context_->GetDiagnostics()->Note(DiagMessage() << "using linked " << file.source.path << " ("
+                                                   << file.name << ") from the link cache");
+  }
+
+  for (LinkCache::File& cached_file : cached->files) {
+    if (cached_file.config != file_op.config) {
+      if (context_->IsVerbose()) {
+        context_->GetDiagnostics()->Note(DiagMessage(file.source)
+                                         << "auto-versioning resource from config '"
+                                         << file_op.config << "' -> '" << cached_file.config
+                                         << "'");
+      }
+
+      std::unique_ptr<FileReference> file_ref =
+          util::make_unique<FileReference>(table->string_pool.MakeRef(cached_file.path));
+      file_ref->SetSource(file.source);
+      file_ref->type = XmlFileTypeForOutputFormat(options_.output_format);
+      if (!table->AddResourceMangled(file.name, cached_file.config, {}, std::move(file_ref),
+                                     context_->GetDiagnostics())) {
+        return false;
+      }
+    }
+
+    OutputFile output_file;
+    output_file.flattened_xml = std::move(cached_file.data);
+    output_file.dst_path = std::move(cached_file.path);
+    output_files->push_back(std::move(output_file));
+  }
+  return true;
+}
+
 bool ResourceFileFlattener::Flatten(ResourceTable* table, IArchiveWriter* archive_writer) {
   TRACE_CALL();
   bool error = false;
@@ -506,6 +709,23 @@ bool ResourceFileFlattener::Flatten(ResourceTable* table, IArchiveWriter* archiv
 
   proguard::CollectResourceReferences(context_, table, keep_set_);
 
+  LinkCacheKey table_key = options_.link_cache_key;
+  if (options_.link_cache) {
+    table_key.Add(options_.keep_raw_values);
+    table_key.Add(options_.no_auto_version);
+    table_key.Add(options_.no_version_vectors);
+    table_key.Add(options_.no_version_transitions);
+    table_key.Add(options_.no_xml_namespaces);
+    table_key.Add(options_.update_proguard_spec);
+    table_key.Add(options_.do_not_fail_on_missing_resources);
+    table_key.Add(static_cast<uint64_t>(options_.output_format));
+    table_key.Add(static_cast<uint64_t>(context_->GetPackageType()));
+    table_key.Add(context_->GetPackageId());
+    table_key.Add(context_->GetCompilationPackage());
+    table_key.Add(static_cast<uint64_t>(context_->GetMinSdkVersion()));
+    AddTableToLinkCacheKey(*table, &table_key);
+  }
+
   for (auto& pkg : table->packages) {
     CHECK(!pkg->name.empty()) << "Packages must have names when being linked";
 
@@ -579,6 +799,10 @@ bool ResourceFileFlattener::Flatten(ResourceTable* table, IArchiveWriter* archiv
             file_op.xml_to_flatten->file.config = config_value->config;
             file_op.xml_to_flatten->file.source = file_ref->GetSource();
             file_op.xml_to_flatten->file.name = ResourceName(pkg->name, type->type, entry->name);
+
+            if (options_.link_cache) {
+              file_op.cache_key = GetLinkCacheKey(table_key, entry.get(), file_op, *data);
+            }
           }
 
           // NOTE(adamlesinski): Explicitly construct a StringPiece here, or
@@ -591,7 +815,10 @@ bool ResourceFileFlattener::Flatten(ResourceTable* table, IArchiveWriter* archiv
         }
       }
 
-      // Now flatten the sorted values.
+      // Now link the sorted values. Adding the versioned documents to the table has to happen here,
+      // one file after the other, but flattening them does not.
+      std::vector<OutputFile> output_files;
+      std::vector<PendingCacheEntry> pending_cache_entries;
       for (auto& map_entry : config_sorted_files) {
         const ConfigDescription& config = map_entry.first.first;
         FileOperation& file_op = map_entry.second;
@@ -611,13 +838,38 @@ bool ResourceFileFlattener::Flatten(ResourceTable* table, IArchiveWriter* archiv
             }
           }
 
+          const bool cache_file = !file_op.cache_key.empty();
+          if (cache_file) {
+            LinkCache::Entry cached;
+            proguard::KeepSet cached_keep_set;
+            if (options_.link_cache->Find(file_op.cache_key, &cached) &&
+                proguard::DeserializeKeepSet(cached.keep_rules, &cached_keep_set)) {
+              keep_set_->Merge(cached_keep_set);
+              if (!AddCachedXmlFile(table, file_op, &cached, &output_files)) {
+                return false;
+              }
+              continue;
+            }
+          }
+
+          // The rules of a cached file are collected separately, so that they can be cached too.
+          proguard::KeepSet file_keep_set;
           std::vector<std::unique_ptr<xml::XmlResource>> versioned_docs =
-              LinkAndVersionXmlFile(table, &file_op);
+              LinkAndVersionXmlFile(table, &file_op, cache_file ? &file_keep_set : keep_set_);
           if (versioned_docs.empty()) {
             error = true;
             continue;
           }
 
+          PendingCacheEntry* pending_cache_entry = nullptr;
+          if (cache_file) {
+            keep_set_->Merge(file_keep_set);
+            pending_cache_entries.emplace_back();
+            pending_cache_entry = &pending_cache_entries.back();
+            pending_cache_entry->key = file_op.cache_key;
+            proguard::SerializeKeepSet(file_keep_set, &pending_cache_entry->entry.keep_rules);
+          }
+
           for (std::unique_ptr<xml::XmlResource>& doc : versioned_docs) {
             std::string dst_path = file_op.dst_path;
             if (doc->file.config != file_op.config) {
@@ -642,13 +894,44 @@ bool ResourceFileFlattener::Flatten(ResourceTable* table, IArchiveWriter* archiv
               }
             }
 
-            error |= !FlattenXml(context_, *doc, dst_path, options_.keep_raw_values,
-                                 false /*utf16*/, options_.output_format, archive_writer);
+            if (pending_cache_entry) {
+              LinkCache::File cached_file;
+              cached_file.path = dst_path;
+              cached_file.config = doc->file.config;
+              pending_cache_entry->entry.files.push_back(std::move(cached_file));
+              pending_cache_entry->output_files.push_back(output_files.size());
+            }
+
+            OutputFile output_file;
+            output_file.xml_to_flatten = std::move(doc);
+            output_file.dst_path = std::move(dst_path);
+            output_file.keep_flattened_xml = pending_cache_entry != nullptr;
+            output_files.push_back(std::move(output_file));
           }
         } else {
-          error |= !io::CopyFileToArchive(context_, file_op.file_to_copy, file_op.dst_path,
-                                          GetCompressionFlags(file_op.dst_path, options_),
-                                          archive_writer);
+          OutputFile output_file;
+          output_file.file_to_copy = file_op.file_to_copy;
+          output_file.dst_path = file_op.dst_path;
+          output_files.push_back(std::move(output_file));
+        }
+      }
+
+      error |= !WriteFiles(&output_files, archive_writer);
+
+      for (PendingCacheEntry& pending_cache_entry : pending_cache_entries) {
+        bool flattened = true;
+        for (size_t i = 0; i < pending_cache_entry.output_files.size(); i++) {
+          std::string& data = output_files[pending_cache_entry.output_files[i]].flattened_xml;
+          flattened &= !data.empty();
+          pending_cache_entry.entry.files[i].data = std::move(data);
+        }
+
+        std::string error_str;
+        if (flattened &&
+            !options_.link_cache->Store(pending_cache_entry.key, pending_cache_entry.entry,
+                                        &error_str)) {
+          context_->GetDiagnostics()->Warn(DiagMessage() << "failed to update the link cache: "
+                                                         << error_str);
         }
       }
     }
@@ -656,6 +939,121 @@ bool ResourceFileFlattener::Flatten(ResourceTable* table, IArchiveWriter* archiv
   return !error;
 }
 
+bool ResourceFileFlattener::WriteFile(IAaptContext* context, OutputFile* file,
+                                      IArchiveWriter* archive_writer) {
+  if (file->file_to_copy) {
+    return io::CopyFileToArchive(context, file->file_to_copy, file->dst_path,
+                                 GetCompressionFlags(file->dst_path, options_), archive_writer);
+  }
+
+  if (file->xml_to_flatten) {
+    if (!file->keep_flattened_xml) {
+      return FlattenXml(context, *file->xml_to_flatten, file->dst_path, options_.keep_raw_values,
+                        false /*utf16*/, options_.output_format, archive_writer);
+    }
+
+    if (!FlattenXmlToString(context, *file->xml_to_flatten, options_.keep_raw_values,
+                            false /*utf16*/, options_.output_format, &file->flattened_xml)) {
+      return false;
+    }
+  }
+
+  if (context->IsVerbose()) {
+    context->GetDiagnostics()->Note(DiagMessage(file->dst_path) << "writing to archive");
+  }
+  io::StringInputStream input_stream(file->flattened_xml);
+  return io::CopyInputStreamToArchive(context, &input_stream, file->dst_path,
+                                      ArchiveEntry::kCompress, archive_writer);
+}
+
+// Writes `files` to the archive in order. With more than one job, the XML documents are flattened
+// on worker threads into in-memory archives, which are then written out, together with the other
+// files, in the order of `files`. The files to copy are read on this thread only, as the input
+// zips can't be read concurrently.
+bool ResourceFileFlattener::WriteFiles(std::vector<OutputFile>* files,
+                                       IArchiveWriter* archive_writer) {
+  TRACE_CALL();
+  const size_t xml_count = std::count_if(files->begin(), files->end(), [](const OutputFile& file) {
+    return file.xml_to_flatten != nullptr;
+  });
+  if (options_.jobs <= 1 || xml_count <= 1) {
+    bool error = false;
+    for (OutputFile& file : *files) {
+      error |= !WriteFile(context_, &file, archive_writer);
+    }
+    return !error;
+  }
+
+  struct FlattenResult {
+    explicit FlattenResult(IAaptContext* context) : context(context) {
+    }
+
+    BufferedDiagnosticsContext context;
+    BufferedArchiveWriter writer;
+    bool success = false;
+    bool done = false;
+  };
+
+  std::vector<OutputFile*> xml_files;
+  std::vector<std::unique_ptr<FlattenResult>> results;
+  xml_files.reserve(xml_count);
+  results.reserve(xml_count);
+  for (OutputFile& file : *files) {
+    if (file.xml_to_flatten) {
+      xml_files.push_back(&file);
+      results.push_back(util::make_unique<FlattenResult>(context_));
+    }
+  }
+
+  std::mutex mutex;
+  std::condition_variable flatten_done;
+  std::atomic<size_t> next_file(0);
+  auto worker = [&]() {
+    for (size_t i = next_file++; i < xml_files.size(); i = next_file++) {
+      FlattenResult* result = results[i].get();
+      result->success = WriteFile(&result->context, xml_files[i], &result->writer);
+      std::lock_guard<std::mutex> lock(mutex);
+      result->done = true;
+      flatten_done.notify_all();
+    }
+  };
+
+  std::vector<std::thread> threads;
+  const size_t thread_count = std::min(options_.jobs, xml_files.size());
+  for (size_t i = 0; i < thread_count; i++) {
+    threads.emplace_back(worker);
+  }
+
+  bool error = false;
+  size_t next_result = 0;
+  for (OutputFile& file : *files) {
+    if (!file.xml_to_flatten) {
+      error |= !WriteFile(context_, &file, archive_writer);
+      continue;
+    }
+
+    const size_t i = next_result++;
+    {
+      std::unique_lock<std::mutex> lock(mutex);
+      flatten_done.wait(lock, [&]() { return results[i]->done; });
+    }
+
+    std::unique_ptr<FlattenResult> result = std::move(results[i]);
+    result->context.GetBufferedDiagnostics()->Replay(context_->GetDiagnostics());
+    if (!result->writer.WriteTo(archive_writer)) {
+      context_->GetDiagnostics()->Error(DiagMessage(file.dst_path) << "failed to write: "
+                                                                    << archive_writer->GetError());
+      result->success = false;
+    }
+    error |= !result->success;
+  }
+
+  for (std::thread& thread : threads) {
+    thread.join();
+  }
+  return !error;
+}
+
 static bool WriteStableIdMapToPath(IDiagnostics* diag,
                                    const std::unordered_map<ResourceName, ResourceId>& id_map,
                                    const std::string& id_map_path) {
@@ -818,6 +1216,32 @@ class Linker {
 
   // Creates a SymbolTable that loads symbols from the various APKs.
   // Pre-condition: context_->GetCompilationPackage() needs to be set.
+  // Opens the link cache. The cached files depend on the version of aapt2 and on the content of
+  // the includes, which are hashed into the key of every entry.
+  bool OpenLinkCache() {
+    TRACE_CALL();
+    const std::string& dir = options_.link_cache_dir.value();
+    if (!file::mkdirs(dir)) {
+      context_->GetDiagnostics()->Error(DiagMessage(dir) << "failed to create the link cache: "
+                                                         << SystemErrorCodeToString(errno));
+      return false;
+    }
+
+    link_cache_key_.Add(util::GetToolFingerprint());
+    for (const std::string& path : options_.include_paths) {
+      std::string error_str;
+      Maybe<android::FileMap> include = file::MmapPath(path, &error_str);
+      if (!include) {
+        context_->GetDiagnostics()->Error(DiagMessage(path) << error_str);
+        return false;
+      }
+      link_cache_key_.Add(StringPiece(static_cast<const char*>(include.value().getDataPtr()),
+                                      include.value().getDataLength()));
+    }
+    link_cache_ = util::make_unique<LinkCache>(dir);
+    return true;
+  }
+
   bool LoadSymbolsFromIncludePaths() {
     TRACE_NAME("LoadSymbolsFromIncludePaths: #" + std::to_string(options_.include_paths.size()));
     auto asset_source = util::make_unique<AssetManagerSymbolSource>();
@@ -826,30 +1250,56 @@ class Linker {
         context_->GetDiagnostics()->Note(DiagMessage() << "including " << path);
       }
 
-      std::string error;
-      auto zip_collection = io::ZipFileCollection::Create(path, &error);
-      if (zip_collection == nullptr) {
-        context_->GetDiagnostics()->Error(DiagMessage() << "failed to open APK: " << error);
-        return false;
+      // Static libraries renamed to the compilation package can only be reused by links of the
+      // same package.
+      std::string cache_key = path;
+      if (options_.no_static_lib_packages) {
+        cache_key += '\0';
+        cache_key += context_->GetCompilationPackage();
+      }
+
+      StaticLibraryCache& cache = GetStaticLibraryCache();
+      file::FileStamp stamp;
+      bool use_cache;
+      std::shared_ptr<LoadedApk> static_apk;
+      {
+        std::lock_guard<std::mutex> lock(cache.lock);
+        use_cache = cache.enabled && file::GetFileStamp(path, &stamp);
+        if (use_cache) {
+          auto iter = cache.libraries.find(cache_key);
+          if (iter != cache.libraries.end()) {
+            if (iter->second.stamp == stamp) {
+              static_apk = iter->second.apk;
+            } else {
+              cache.libraries.erase(iter);
+            }
+          }
+        }
       }
 
-      if (zip_collection->FindFile(kProtoResourceTablePath) != nullptr) {
-        // Load this as a static library include.
-        std::unique_ptr<LoadedApk> static_apk = LoadedApk::LoadProtoApkFromFileCollection(
-            Source(path), std::move(zip_collection), context_->GetDiagnostics());
-        if (static_apk == nullptr) {
+      if (static_apk == nullptr) {
+        std::string error;
+        auto zip_collection = io::ZipFileCollection::Create(path, &error);
+        if (zip_collection == nullptr) {
+          context_->GetDiagnostics()->Error(DiagMessage() << "failed to open APK: " << error);
           return false;
         }
 
-        if (context_->GetPackageType() != PackageType::kStaticLib) {
-          // Can't include static libraries when not building a static library (they have no IDs
-          // assigned).
-          context_->GetDiagnostics()->Error(
-              DiagMessage(path) << "can't include static library when not building a static lib");
-          return false;
+        if (zip_collection->FindFile(kProtoResourceTablePath) == nullptr) {
+          if (!asset_source->AddAssetPath(path)) {
+            context_->GetDiagnostics()->Error(DiagMessage()
+                                              << "failed to load include path " << path);
+            return false;
+          }
+          continue;
         }
 
-        ResourceTable* table = static_apk->GetResourceTable();
+        // Load this as a static library include.
+        static_apk = LoadedApk::LoadProtoApkFromFileCollection(
+            Source(path), std::move(zip_collection), context_->GetDiagnostics());
+        if (static_apk == nullptr) {
+          return false;
+        }
 
         // If we are using --no-static-lib-packages, we need to rename the package of this table to
         // our compilation package.
@@ -857,6 +1307,7 @@ class Linker {
           // Since package names can differ, and multiple packages can exist in a ResourceTable,
           // we place the requirement that all static libraries are built with the package
           // ID 0x7f. So if one is not found, this is an error.
+          ResourceTable* table = static_apk->GetResourceTable();
           if (ResourceTablePackage* pkg = table->FindPackageById(kAppPackageId)) {
             pkg->name = context_->GetCompilationPackage();
           } else {
@@ -866,16 +1317,23 @@ class Linker {
           }
         }
 
-        context_->GetExternalSymbols()->AppendSource(
-            util::make_unique<ResourceTableSymbolSource>(table));
-        static_library_includes_.push_back(std::move(static_apk));
-      } else {
-        if (!asset_source->AddAssetPath(path)) {
-          context_->GetDiagnostics()->Error(DiagMessage()
-                                            << "failed to load include path " << path);
-          return false;
+        if (use_cache) {
+          std::lock_guard<std::mutex> lock(cache.lock);
+          cache.libraries[cache_key] = CachedStaticLibrary{stamp, static_apk};
         }
       }
+
+      if (context_->GetPackageType() != PackageType::kStaticLib) {
+        // Can't include static libraries when not building a static library (they have no IDs
+        // assigned).
+        context_->GetDiagnostics()->Error(
+            DiagMessage(path) << "can't include static library when not building a static lib");
+        return false;
+      }
+
+      context_->GetExternalSymbols()->AppendSource(
+          util::make_unique<ResourceTableSymbolSource>(static_apk->GetResourceTable()));
+      static_library_includes_.push_back(std::move(static_apk));
     }
 
     // Capture the shared libraries so that the final resource table can be properly flattened
@@ -1496,8 +1954,10 @@ class Linker {
     while ((entry = reader.Next()) != nullptr) {
       if (entry->Type() == ContainerEntryType::kResTable) {
         TRACE_NAME(std::string("Process ResTable:") + file->GetSource().path);
-        pb::ResourceTable pb_table;
-        if (!entry->GetResTable(&pb_table)) {
+        google::protobuf::Arena arena;
+        pb::ResourceTable* pb_table =
+            google::protobuf::Arena::CreateMessage<pb::ResourceTable>(&arena);
+        if (!entry->GetResTable(pb_table)) {
           context_->GetDiagnostics()->Error(DiagMessage(src) << "failed to read resource table: "
                                                              << entry->GetError());
           return false;
@@ -1505,7 +1965,7 @@ class Linker {
 
         ResourceTable table;
         std::string error;
-        if (!DeserializeTableFromPb(pb_table, nullptr /*files*/, &table, &error)) {
+        if (!DeserializeTableFromPb(*pb_table, nullptr /*files*/, &table, &error)) {
           context_->GetDiagnostics()->Error(DiagMessage(src)
                                             << "failed to deserialize resource table: " << error);
           return false;
@@ -1698,6 +2158,9 @@ class Linker {
         static_cast<bool>(options_.generate_proguard_rules_path);
     file_flattener_options.output_format = options_.output_format;
     file_flattener_options.do_not_fail_on_missing_resources = options_.merge_only;
+    file_flattener_options.jobs = options_.jobs;
+    file_flattener_options.link_cache = link_cache_.get();
+    file_flattener_options.link_cache_key = link_cache_key_;
 
     ResourceFileFlattener file_flattener(file_flattener_options, context_, keep_set);
     if (!file_flattener.Flatten(table, writer)) {
@@ -1789,6 +2252,10 @@ class Linker {
       return 1;
     }
 
+    if (options_.link_cache_dir && !OpenLinkCache()) {
+      return 1;
+    }
+
     ManifestFixer manifest_fixer(options_.manifest_fixer_options);
     if (!manifest_fixer.Consume(context_, manifest_xml.get())) {
       return 1;
@@ -2000,7 +2467,7 @@ class Linker {
     }
 
     if (!options_.no_resource_deduping) {
-      ResourceDeduper deduper;
+      ResourceDeduper deduper(options_.jobs);
       if (!deduper.Consume(context_, &final_table_)) {
         context_->GetDiagnostics()->Error(DiagMessage() << "failed deduping resources");
         return 1;
@@ -2168,8 +2635,13 @@ class Linker {
   // The set of merged APKs. This is mainly here to retain ownership of the APKs.
   std::vector<std::unique_ptr<LoadedApk>> merged_apks_;
 
-  // The set of included APKs (not merged). This is mainly here to retain ownership of the APKs.
-  std::vector<std::unique_ptr<LoadedApk>> static_library_includes_;
+  // The cache of linked XML files, if any, and what its entries depend on besides the table.
+  std::unique_ptr<LinkCache> link_cache_;
+  LinkCacheKey link_cache_key_;
+
+  // The set of included APKs (not merged). This is mainly here to retain ownership of the APKs,
+  // which may be shared with the static library cache.
+  std::vector<std::shared_ptr<LoadedApk>> static_library_includes_;
 
   // The set of shared libraries being used, mapping their assigned package ID to package name.
   std::map<size_t, std::string> shared_libs_;
@@ -2268,6 +2740,16 @@ int LinkCommand::Action(const std::vector<std::string>& args) {
     context.SetPackageId(static_cast<uint8_t>(package_id_int));
   }
 
+  if (jobs_) {
+    const Maybe<uint32_t> maybe_jobs = ResourceUtils::ParseInt(jobs_.value());
+    if (!maybe_jobs || maybe_jobs.value() == 0) {
+      context.GetDiagnostics()->Error(DiagMessage() << "-j '" << jobs_.value()
+                                                    << "' is not a valid number of jobs");
+      return 1;
+    }
+    options_.jobs = maybe_jobs.value();
+  }
+
   // Populate the set of extra packages for which to generate R.java.
   for (std::string& extra_package : extra_java_packages_) {
     // A given package can actually be a colon separated list of packages.
@@ -76,6 +76,12 @@ struct LinkOptions {
   bool no_static_lib_packages = false;
   bool merge_only = false;
 
+  // The number of threads that flatten the XML files of the table.
+  size_t jobs = 1;
+
+  // The directory where linked XML files are cached between builds.
+  Maybe<std::string> link_cache_dir;
+
   // AndroidManifest.xml massaging options.
   ManifestFixerOptions manifest_fixer_options;
 
@@ -307,11 +313,24 @@ class LinkCommand : public Command {
         "Only merge the resources, without verifying resource references. This flag\n"
             "should only be used together with the --static-lib flag.",
         &options_.merge_only);
+    AddOptionalFlag("-j",
+        "Number of XML files to flatten in parallel. Linking stays sequential.\n"
+            "Defaults to 1.",
+        &jobs_);
+    AddOptionalFlag("--link-cache",
+        "Directory where the linked XML files are cached between builds. An XML file\n"
+            "is linked again only if it, the IDs or attributes of the resources, the\n"
+            "includes or the options changed.",
+        &options_.link_cache_dir);
     AddOptionalSwitch("-v", "Enables verbose logging.", &verbose_);
   }
 
   int Action(const std::vector<std::string>& args) override;
 
+  // When enabled, the include paths passed with -I are parsed once and kept in memory for later
+  // links, as long as they have not changed on disk. This is meant for the daemon.
+  static void SetIncludeCacheEnabled(bool enabled);
+
  private:
   IDiagnostics* diag_;
   LinkOptions options_;
@@ -319,6 +338,7 @@ class LinkCommand : public Command {
   std::vector<std::string> overlay_arg_list_;
   std::vector<std::string> extra_java_packages_;
   Maybe<std::string> package_id_;
+  Maybe<std::string> jobs_;
   std::vector<std::string> configs_;
   Maybe<std::string> preferred_density_;
   Maybe<std::string> product_list_;
@@ -254,6 +254,160 @@ TEST_F(LinkTest, OverrideStylesInsteadOfOverlaying) {
   EXPECT_EQ(actual_style->entries[0].key.id, 0x010100d4);  // android:background
 }
 
+TEST_F(LinkTest, FlattenXmlFilesInParallel) {
+  StdErrDiagnostics diag;
+  const std::string compiled_files_dir = GetTestPath("compiled");
+  const std::vector<std::string> names = {"a", "b", "c", "d", "e"};
+  for (const std::string& name : names) {
+    ASSERT_TRUE(CompileFile(GetTestPath("res/xml/" + name + ".xml"),
+                            "<Item name=\"" + name + "\"/>", compiled_files_dir, &diag));
+  }
+  ASSERT_TRUE(CompileFile(GetTestPath("res/raw/file.txt"), "raw", compiled_files_dir, &diag));
+
+  const std::string serial_apk = GetTestPath("serial.apk");
+  ASSERT_TRUE(Link({"--manifest", GetDefaultManifest(), "-o", serial_apk}, compiled_files_dir,
+                   &diag));
+  const std::string parallel_apk = GetTestPath("parallel.apk");
+  ASSERT_TRUE(Link({"--manifest", GetDefaultManifest(), "-o", parallel_apk, "-j", "4"},
+                   compiled_files_dir, &diag));
+
+  std::unique_ptr<LoadedApk> serial = LoadedApk::LoadApkFromPath(serial_apk, &diag);
+  ASSERT_THAT(serial, Ne(nullptr));
+  std::unique_ptr<LoadedApk> parallel = LoadedApk::LoadApkFromPath(parallel_apk, &diag);
+  ASSERT_THAT(parallel, Ne(nullptr));
+
+  std::vector<std::string> paths = {"res/raw/file.txt"};
+  for (const std::string& name : names) {
+    paths.push_back("res/xml/" + name + ".xml");
+  }
+  for (const std::string& path : paths) {
+    std::unique_ptr<io::IData> expected = OpenFileAsData(serial.get(), path);
+    ASSERT_THAT(expected, Ne(nullptr)) << path;
+    std::unique_ptr<io::IData> actual = OpenFileAsData(parallel.get(), path);
+    ASSERT_THAT(actual, Ne(nullptr)) << path;
+    EXPECT_THAT(std::string(reinterpret_cast<const char*>(actual->data()), actual->size()),
+                Eq(std::string(reinterpret_cast<const char*>(expected->data()),
+                               expected->size()))) << path;
+  }
+}
+
+TEST_F(LinkTest, LinkCacheReusesLinkedXmlFiles) {
+  StdErrDiagnostics diag;
+  const std::string compiled_files_dir = GetTestPath("compiled");
+  ASSERT_TRUE(CompileFile(GetTestPath("res/values/values.xml"),
+                          R"(<resources><string name="foo">foo</string></resources>)",
+                          compiled_files_dir, &diag));
+  ASSERT_TRUE(CompileFile(GetTestPath("res/xml/test.xml"), R"(<Item text="@string/foo"/>)",
+                          compiled_files_dir, &diag));
+
+  const std::string cache_dir = GetTestPath("cache");
+  const std::string cached_apk = GetTestPath("cached.apk");
+  ASSERT_TRUE(Link({"--manifest", GetDefaultManifest(), "-o", cached_apk, "--link-cache",
+                    cache_dir}, compiled_files_dir, &diag));
+  Maybe<std::vector<std::string>> cache_files = file::FindFiles(cache_dir, &diag);
+  ASSERT_TRUE(cache_files);
+  EXPECT_THAT(cache_files.value().size(), Eq(1u));
+
+  // Changing the value of a resource keeps the linked XML file valid.
+  ASSERT_TRUE(CompileFile(GetTestPath("res/values/values.xml"),
+                          R"(<resources><string name="foo">bar</string></resources>)",
+                          compiled_files_dir, &diag));
+  ASSERT_TRUE(Link({"--manifest", GetDefaultManifest(), "-o", cached_apk, "--link-cache",
+                    cache_dir}, compiled_files_dir, &diag));
+  cache_files = file::FindFiles(cache_dir, &diag);
+  ASSERT_TRUE(cache_files);
+  EXPECT_THAT(cache_files.value().size(), Eq(1u));
+
+  const std::string uncached_apk = GetTestPath("uncached.apk");
+  ASSERT_TRUE(Link({"--manifest", GetDefaultManifest(), "-o", uncached_apk}, compiled_files_dir,
+                   &diag));
+
+  std::unique_ptr<LoadedApk> cached = LoadedApk::LoadApkFromPath(cached_apk, &diag);
+  ASSERT_THAT(cached, Ne(nullptr));
+  std::unique_ptr<LoadedApk> uncached = LoadedApk::LoadApkFromPath(uncached_apk, &diag);
+  ASSERT_THAT(uncached, Ne(nullptr));
+
+  std::unique_ptr<io::IData> expected = OpenFileAsData(uncached.get(), "res/xml/test.xml");
+  ASSERT_THAT(expected, Ne(nullptr));
+  std::unique_ptr<io::IData> actual = OpenFileAsData(cached.get(), "res/xml/test.xml");
+  ASSERT_THAT(actual, Ne(nullptr));
+  EXPECT_THAT(std::string(reinterpret_cast<const char*>(actual->data()), actual->size()),
+              Eq(std::string(reinterpret_cast<const char*>(expected->data()), expected->size())));
+
+  // Adding a resource shifts the IDs, so the file is linked again.
+  ASSERT_TRUE(CompileFile(GetTestPath("res/values/values.xml"),
+                          R"(<resources>
+                               <string name="bar">bar</string>
+                               <string name="foo">bar</string>
+                             </resources>)",
+                          compiled_files_dir, &diag));
+  ASSERT_TRUE(Link({"--manifest", GetDefaultManifest(), "-o", cached_apk, "--link-cache",
+                    cache_dir}, compiled_files_dir, &diag));
+  cache_files = file::FindFiles(cache_dir, &diag);
+  ASSERT_TRUE(cache_files);
+  EXPECT_THAT(cache_files.value().size(), Eq(2u));
+}
+
+TEST_F(LinkTest, IncludeCacheReloadsChangedIncludes) {
+  LinkCommand::SetIncludeCacheEnabled(true);
+
+  StdErrDiagnostics diag;
+  const std::string base_files_dir = GetTestPath("base");
+  ASSERT_TRUE(CompileFile(GetTestPath("res/values/values.xml"),
+                          R"(<resources><string name="foo">foo</string></resources>)",
+                          base_files_dir, &diag));
+  const std::string base_apk = GetTestPath("base.apk");
+  std::vector<std::string> link_args = {
+      "--manifest", GetDefaultManifest("com.aapt2.app"),
+      "-o", base_apk,
+  };
+  ASSERT_TRUE(Link(link_args, base_files_dir, &diag));
+
+  const std::string feature_manifest = GetTestPath("feature_manifest.xml");
+  WriteFile(feature_manifest, R"(
+      <manifest xmlns:android="http://schemas.android.com/apk/res/android"
+          package="com.aapt2.app" split="feature">
+      </manifest>)");
+  const std::string feature_files_dir = GetTestPath("feature");
+  ASSERT_TRUE(CompileFile(GetTestPath("res/values/values.xml"),
+                          R"(<resources><string name="baz">@string/foo</string></resources>)",
+                          feature_files_dir, &diag));
+  const std::string feature_apk = GetTestPath("feature.apk");
+  link_args = {
+      "--manifest", feature_manifest,
+      "-I", base_apk,
+      "--package-id", "0x80",
+      "-o", feature_apk,
+  };
+  ASSERT_TRUE(Link(link_args, feature_files_dir, &diag));
+
+  // A resource added to the include must be visible to the next link.
+  ASSERT_TRUE(CompileFile(GetTestPath("res/values/values.xml"),
+                          R"(<resources>
+                               <string name="bar">bar</string>
+                               <string name="foo">foo</string>
+                             </resources>)",
+                          base_files_dir, &diag));
+  link_args = {
+      "--manifest", GetDefaultManifest("com.aapt2.app"),
+      "-o", base_apk,
+  };
+  ASSERT_TRUE(Link(link_args, base_files_dir, &diag));
+
+  ASSERT_TRUE(CompileFile(GetTestPath("res/values/values.xml"),
+                          R"(<resources><string name="baz">@string/bar</string></resources>)",
+                          feature_files_dir, &diag));
+  link_args = {
+      "--manifest", feature_manifest,
+      "-I", base_apk,
+      "--package-id", "0x80",
+      "-o", feature_apk,
+  };
+  EXPECT_TRUE(Link(link_args, feature_files_dir, &diag));
+
+  LinkCommand::SetIncludeCacheEnabled(false);
+}
+
 TEST_F(LinkTest, AppInfoWithUsesSplit) {
   StdErrDiagnostics diag;
   const std::string base_files_dir = GetTestPath("base");
@@ -61,6 +61,9 @@ struct OptimizeOptions {
 
   // Path to the output map of original resource paths to shortened paths.
   Maybe<std::string> shortened_paths_map_path;
+
+  // Number of multi-APK artifacts to generate in parallel.
+  size_t jobs = 1;
 };
 
 class OptimizeCommand : public Command {
@@ -111,6 +114,10 @@ class OptimizeCommand : public Command {
     AddOptionalFlag("--resource-path-shortening-map",
         "Path to output the map of old resource paths to shortened paths.",
         &options_.shortened_paths_map_path);
+    AddOptionalFlag("-j",
+        "Number of artifacts of the configuration file to generate in parallel.\n"
+            "Defaults to 1.",
+        &jobs_);
     AddOptionalSwitch("-v", "Enables verbose logging", &verbose_);
   }
 
@@ -125,6 +132,7 @@ class OptimizeCommand : public Command {
   Maybe<std::string> config_path_;
   Maybe<std::string> resources_config_path_;
   Maybe<std::string> target_densities_;
+  Maybe<std::string> jobs_;
   std::vector<std::string> configs_;
   std::vector<std::string> split_args_;
   std::unordered_set<std::string> kept_artifacts_;
@@ -25,12 +25,67 @@
 #include "Diagnostics.h"
 #include "SdkConstants.h"
 #include "filter/ConfigFilter.h"
+#include "process/IResourceTableConsumer.h"
 #include "split/TableSplitter.h"
 #include "util/Maybe.h"
 #include "xml/XmlDom.h"
 
 namespace aapt {
 
+// A context for work done on a worker thread. It forwards to `context` but buffers the messages,
+// so that they can be reported in a deterministic order once the work is done.
+class BufferedDiagnosticsContext : public IAaptContext {
+ public:
+  explicit BufferedDiagnosticsContext(IAaptContext* context) : context_(context) {
+  }
+
+  PackageType GetPackageType() override {
+    return context_->GetPackageType();
+  }
+
+  SymbolTable* GetExternalSymbols() override {
+    return context_->GetExternalSymbols();
+  }
+
+  IDiagnostics* GetDiagnostics() override {
+    return &diagnostics_;
+  }
+
+  const std::string& GetCompilationPackage() override {
+    return context_->GetCompilationPackage();
+  }
+
+  uint8_t GetPackageId() override {
+    return context_->GetPackageId();
+  }
+
+  NameMangler* GetNameMangler() override {
+    return context_->GetNameMangler();
+  }
+
+  bool IsVerbose() override {
+    return context_->IsVerbose();
+  }
+
+  int GetMinSdkVersion() override {
+    return context_->GetMinSdkVersion();
+  }
+
+  const std::set<std::string>& GetSplitNameDependencies() override {
+    return context_->GetSplitNameDependencies();
+  }
+
+  BufferedDiagnostics* GetBufferedDiagnostics() {
+    return &diagnostics_;
+  }
+
+ private:
+  DISALLOW_COPY_AND_ASSIGN(BufferedDiagnosticsContext);
+
+  IAaptContext* context_;
+  BufferedDiagnostics diagnostics_;
+};
+
 // Parses a configuration density (ex. hdpi, xxhdpi, 234dpi, anydpi, etc).
 // Returns Nothing and logs a human friendly error message if the string was not legal.
 Maybe<uint16_t> ParseTargetDensityParameter(const android::StringPiece& arg, IDiagnostics* diag);
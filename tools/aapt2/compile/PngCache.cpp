@@ -0,0 +1,109 @@
+/*
+ * Copyright (C) 2020 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "compile/PngCache.h"
+
+#include <unistd.h>
+
+#include <atomic>
+#include <cerrno>
+#include <cstdio>
+#include <cstring>
+
+#include "android-base/file.h"
+#include "android-base/stringprintf.h"
+
+#include "link/LinkCache.h"
+#include "util/Files.h"
+#include "util/Util.h"
+
+using ::android::StringPiece;
+using ::android::base::StringPrintf;
+
+namespace aapt {
+
+// An entry is this line, followed by the size of the PNG on a line and the PNG itself.
+constexpr static const char* kPngCacheMagic = "aapt2 png cache v1\n";
+
+PngCache::PngCache(const std::string& dir) : dir_(dir) {
+}
+
+std::string PngCache::GetKey(const StringPiece& source_png, bool nine_patch) {
+  LinkCacheKey key;
+  key.Add(kPngCacheMagic);
+  key.Add(util::GetToolFingerprint());
+  key.Add(static_cast<uint64_t>(nine_patch ? 1u : 0u));
+  key.Add(source_png);
+  return key.ToString();
+}
+
+std::string PngCache::GetEntryPath(const std::string& key) const {
+  std::string path = dir_;
+  file::AppendPath(&path, key);
+  return path;
+}
+
+bool PngCache::Find(const std::string& key, std::string* out_png) const {
+  std::string data;
+  if (!android::base::ReadFileToString(GetEntryPath(key), &data)) {
+    return false;
+  }
+
+  const size_t magic_size = strlen(kPngCacheMagic);
+  if (data.compare(0, magic_size, kPngCacheMagic) != 0) {
+    return false;
+  }
+
+  const size_t end = data.find('\n', magic_size);
+  if (end == std::string::npos || end == magic_size) {
+    return false;
+  }
+  char* size_end = nullptr;
+  errno = 0;
+  const unsigned long long size = strtoull(data.c_str() + magic_size, &size_end, 10);
+  if (errno != 0 || size_end != data.c_str() + end || size != data.size() - end - 1) {
+    return false;
+  }
+  *out_png = data.substr(end + 1);
+  return true;
+}
+
+bool PngCache::Store(const std::string& key, const StringPiece& png,
+                     std::string* out_error) const {
+  std::string data = kPngCacheMagic;
+  data += std::to_string(png.size()) + "\n";
+  data.append(png.data(), png.size());
+
+  // Files with the same content have the same key, and may be compiled at the same time.
+  static std::atomic<uint32_t> next_temp_id(0);
+  const std::string path = GetEntryPath(key);
+  const std::string temp_path =
+      StringPrintf("%s.%d.%u.tmp", path.c_str(), getpid(), next_temp_id++);
+  if (!android::base::WriteStringToFile(data, temp_path)) {
+    *out_error = StringPrintf("failed to write %s: %s", temp_path.c_str(), strerror(errno));
+    unlink(temp_path.c_str());
+    return false;
+  }
+
+  if (rename(temp_path.c_str(), path.c_str()) != 0) {
+    *out_error = StringPrintf("failed to rename %s: %s", temp_path.c_str(), strerror(errno));
+    unlink(temp_path.c_str());
+    return false;
+  }
+  return true;
+}
+
+}  // namespace aapt
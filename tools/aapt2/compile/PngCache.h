@@ -0,0 +1,56 @@
+/*
+ * Copyright (C) 2020 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef AAPT_COMPILE_PNGCACHE_H
+#define AAPT_COMPILE_PNGCACHE_H
+
+#include <string>
+
+#include "android-base/macros.h"
+#include "androidfw/StringPiece.h"
+
+namespace aapt {
+
+// An on-disk cache of the PNGs produced by compile, keyed by the content of the source PNG. A PNG
+// whose content is in the cache is not decoded or crunched again. Entries are never modified, so
+// one directory can be shared by any number of builds.
+class PngCache {
+ public:
+  explicit PngCache(const std::string& dir);
+
+  // Returns the key of the compiled PNG for `source_png`. The key also depends on whether the PNG
+  // is a 9-patch and on the version of aapt2, which may crunch differently.
+  static std::string GetKey(const android::StringPiece& source_png, bool nine_patch);
+
+  // Reads the PNG stored under `key`. Returns false if there is none, or if it can't be read.
+  bool Find(const std::string& key, std::string* out_png) const;
+
+  // Stores `png` under `key`. The entry is written to a temporary file which is then renamed, so
+  // that concurrent compiles never read a partial entry.
+  bool Store(const std::string& key, const android::StringPiece& png,
+             std::string* out_error) const;
+
+ private:
+  DISALLOW_COPY_AND_ASSIGN(PngCache);
+
+  std::string GetEntryPath(const std::string& key) const;
+
+  std::string dir_;
+};
+
+}  // namespace aapt
+
+#endif  // AAPT_COMPILE_PNGCACHE_H
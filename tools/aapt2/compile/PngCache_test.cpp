@@ -0,0 +1,63 @@
+/*
+ * Copyright (C) 2020 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "compile/PngCache.h"
+
+#include "android-base/file.h"
+
+#include "test/Test.h"
+
+using ::testing::Eq;
+using ::testing::Ne;
+
+namespace aapt {
+
+using PngCacheTest = TestDirectoryFixture;
+
+TEST(PngCacheKeyTest, KeysDependOnContentAndNinePatch) {
+  EXPECT_THAT(PngCache::GetKey("png", false), Eq(PngCache::GetKey("png", false)));
+  EXPECT_THAT(PngCache::GetKey("png", false), Ne(PngCache::GetKey("png", true)));
+  EXPECT_THAT(PngCache::GetKey("png", false), Ne(PngCache::GetKey("gif", false)));
+}
+
+TEST_F(PngCacheTest, StoreAndFindEntry) {
+  PngCache cache(GetTestDirectory().to_string());
+
+  const std::string png("\x89PNG\r\n\x1a\n\0data", 13);
+  std::string error;
+  ASSERT_TRUE(cache.Store("key", png, &error)) << error;
+
+  std::string cached;
+  EXPECT_FALSE(cache.Find("other", &cached));
+  ASSERT_TRUE(cache.Find("key", &cached));
+  EXPECT_THAT(cached, Eq(png));
+}
+
+TEST_F(PngCacheTest, IgnoreTruncatedEntry) {
+  PngCache cache(GetTestDirectory().to_string());
+
+  std::string error;
+  ASSERT_TRUE(cache.Store("key", "data", &error)) << error;
+
+  std::string data;
+  ASSERT_TRUE(android::base::ReadFileToString(GetTestPath("key"), &data));
+  WriteFile(GetTestPath("key"), data.substr(0, data.size() - 2));
+
+  std::string cached;
+  EXPECT_FALSE(cache.Find("key", &cached));
+}
+
+}  // namespace aapt
@@ -20,8 +20,8 @@
 #include <zlib.h>
 
 #include <algorithm>
-#include <unordered_map>
-#include <unordered_set>
+#include <iterator>
+#include <vector>
 
 #include "android-base/errors.h"
 #include "android-base/logging.h"
@@ -284,6 +284,175 @@ std::unique_ptr<Image> ReadPng(IAaptContext* context, const Source& source, io::
   return output_image;
 }
 
+// The distinct RGBA colors of an image, as long as they fit in a PNG palette. The colors are kept
+// in the order they are first seen, and looked up in an open-addressed table sized for the largest
+// palette, which is much cheaper to probe for every pixel than a std::unordered_map.
+class ColorPalette {
+ public:
+  static constexpr size_t kMaxColors = 256u;
+
+  ColorPalette() {
+    std::fill(std::begin(slot_indices_), std::end(slot_indices_), kEmptySlot);
+  }
+
+  // Adds the color to the palette. Returns false, and stops tracking colors, once the image has
+  // more colors than a palette can hold.
+  bool Add(uint32_t color) {
+    if (overflowed_) {
+      return false;
+    }
+
+    const size_t slot = FindSlot(color);
+    if (slot_indices_[slot] != kEmptySlot) {
+      return true;
+    }
+
+    if (colors_.size() == kMaxColors) {
+      overflowed_ = true;
+      return false;
+    }
+
+    slot_colors_[slot] = color;
+    slot_indices_[slot] = static_cast<int16_t>(colors_.size());
+    colors_.push_back(color);
+    if ((color & 0x000000ff) != 0xff) {
+      alpha_count_++;
+    }
+    return true;
+  }
+
+  // Whether the image has more colors than a palette can hold.
+  bool overflowed() const {
+    return overflowed_;
+  }
+
+  // The colors of the palette, in the order they were first added.
+  const std::vector<uint32_t>& colors() const {
+    return colors_;
+  }
+
+  // The number of colors that are not fully opaque.
+  size_t alpha_count() const {
+    return alpha_count_;
+  }
+
+  // Returns the index of a color of the palette, or -1 if the color was never added. Until
+  // SetIndex() is called, colors are indexed in the order they were added.
+  int GetIndex(uint32_t color) const {
+    return slot_indices_[FindSlot(color)];
+  }
+
+  void SetIndex(uint32_t color, int index) {
+    const size_t slot = FindSlot(color);
+    CHECK(slot_indices_[slot] != kEmptySlot);
+    slot_indices_[slot] = static_cast<int16_t>(index);
+  }
+
+ private:
+  DISALLOW_COPY_AND_ASSIGN(ColorPalette);
+
+  // Four times the largest palette, so that probe sequences stay short.
+  static constexpr size_t kSlotBits = 10u;
+  static constexpr size_t kSlotCount = 1u << kSlotBits;
+  static constexpr int16_t kEmptySlot = -1;
+
+  // Returns the slot holding `color`, or the empty slot where it would be inserted.
+  size_t FindSlot(uint32_t color) const {
+    size_t slot = (color * 0x9e3779b1u) >> (32u - kSlotBits);
+    while (slot_indices_[slot] != kEmptySlot && slot_colors_[slot] != color) {
+      slot = (slot + 1u) & (kSlotCount - 1u);
+    }
+    return slot;
+  }
+
+  std::vector<uint32_t> colors_;
+  size_t alpha_count_ = 0u;
+  bool overflowed_ = false;
+  uint32_t slot_colors_[kSlotCount];
+  int16_t slot_indices_[kSlotCount];
+};
+
+// What WritePng needs to know about the pixels of an image to pick its color type. Fully
+// transparent pixels count as transparent black.
+struct ImageAnalysis {
+  // The largest difference between two of the color channels of a pixel.
+  uint32_t max_gray_deviation = 0u;
+
+  // Whether a pixel is not fully opaque.
+  bool has_alpha = false;
+
+  // Whether a fully transparent pixel has color channels other than zero.
+  bool has_colored_transparent_pixels = false;
+};
+
+static uint32_t AbsDiff(uint32_t a, uint32_t b) {
+  return a > b ? a - b : b - a;
+}
+
+// Scans the pixels of the image. The loop has no branches on the pixel values and reduces into
+// independent accumulators, so that the compiler can vectorize it.
+static ImageAnalysis AnalyzeImage(const Image* image) {
+  uint32_t max_gray_deviation = 0u;
+  uint32_t min_alpha = 0xffu;
+  uint32_t transparent_color_bits = 0u;
+  for (int32_t y = 0; y < image->height; y++) {
+    const uint8_t* row = image->rows[y];
+    for (int32_t x = 0; x < image->width; x++) {
+      const uint32_t alpha = row[x * 4 + 3];
+      const uint32_t visible_mask = alpha != 0u ? 0xffu : 0u;
+      const uint32_t red = row[x * 4] & visible_mask;
+      const uint32_t green = row[x * 4 + 1] & visible_mask;
+      const uint32_t blue = row[x * 4 + 2] & visible_mask;
+
+      transparent_color_bits |= (row[x * 4] | row[x * 4 + 1] | row[x * 4 + 2]) & ~visible_mask;
+      min_alpha = std::min(min_alpha, alpha);
+      max_gray_deviation = std::max(max_gray_deviation, AbsDiff(red, green));
+      max_gray_deviation = std::max(max_gray_deviation, AbsDiff(green, blue));
+      max_gray_deviation = std::max(max_gray_deviation, AbsDiff(blue, red));
+    }
+  }
+
+  ImageAnalysis analysis;
+  analysis.max_gray_deviation = max_gray_deviation;
+  analysis.has_alpha = min_alpha != 0xffu;
+  analysis.has_colored_transparent_pixels = (transparent_color_bits & 0xffu) != 0u;
+  return analysis;
+}
+
+// Returns the color of a pixel as RGBA, with fully transparent pixels as transparent black.
+static uint32_t GetPaletteColor(const uint8_t* pixel) {
+  if (pixel[3] == 0) {
+    return 0u;
+  }
+  return static_cast<uint32_t>(pixel[0]) << 24 | static_cast<uint32_t>(pixel[1]) << 16 |
+         static_cast<uint32_t>(pixel[2]) << 8 | pixel[3];
+}
+
+// Adds the colors of the image to the palette, stopping as soon as there are too many.
+static void BuildPalette(const Image* image, ColorPalette* palette) {
+  if (image->width <= 0) {
+    return;
+  }
+
+  for (int32_t y = 0; y < image->height; y++) {
+    const uint8_t* row = image->rows[y];
+    // Neighboring pixels often have the same color, so skip the lookup for runs of a color.
+    uint32_t last_color = GetPaletteColor(row);
+    if (!palette->Add(last_color)) {
+      return;
+    }
+    for (int32_t x = 1; x < image->width; x++) {
+      const uint32_t color = GetPaletteColor(row + x * 4);
+      if (color != last_color) {
+        if (!palette->Add(color)) {
+          return;
+        }
+        last_color = color;
+      }
+    }
+  }
+}
+
 // Experimentally chosen constant to be added to the overhead of using color type
 // PNG_COLOR_TYPE_PALETTE to account for the uncompressability of the palette chunk.
 // Without this, many small PNGs encoded with palettes are larger after compression than
@@ -374,41 +543,37 @@ static int PickColorType(int32_t width, int32_t height, bool grayscale,
 // This must be done before writing image data.
 // Image data must be transformed to use the indices assigned within the palette.
 static void WritePalette(png_structp write_ptr, png_infop write_info_ptr,
-                         std::unordered_map<uint32_t, int>* color_palette,
-                         std::unordered_set<uint32_t>* alpha_palette) {
-  CHECK(color_palette->size() <= 256);
-  CHECK(alpha_palette->size() <= 256);
-
-  // Populate the PNG palette struct and assign indices to the color palette.
+                         ColorPalette* color_palette) {
+  CHECK(!color_palette->overflowed());
 
   // Colors in the alpha palette should have smaller indices.
   // This will ensure that we can truncate the alpha palette if it is
   // smaller than the color palette.
-  int index = 0;
-  for (uint32_t color : *alpha_palette) {
-    (*color_palette)[color] = index++;
+  std::vector<uint32_t> ordered_colors;
+  ordered_colors.reserve(color_palette->colors().size());
+  for (uint32_t color : color_palette->colors()) {
+    if ((color & 0x000000ff) != 0xff) {
+      ordered_colors.push_back(color);
+    }
   }
-
-  // Assign the rest of the entries.
-  for (auto& entry : *color_palette) {
-    if (entry.second == -1) {
-      entry.second = index++;
+  for (uint32_t color : color_palette->colors()) {
+    if ((color & 0x000000ff) == 0xff) {
+      ordered_colors.push_back(color);
     }
   }
 
   // Create the PNG color palette struct.
-  auto color_palette_bytes = std::unique_ptr<png_color[]>(new png_color[color_palette->size()]);
+  auto color_palette_bytes = std::unique_ptr<png_color[]>(new png_color[ordered_colors.size()]);
 
+  const size_t alpha_palette_size = color_palette->alpha_count();
   std::unique_ptr<png_byte[]> alpha_palette_bytes;
-  if (!alpha_palette->empty()) {
-    alpha_palette_bytes = std::unique_ptr<png_byte[]>(new png_byte[alpha_palette->size()]);
+  if (alpha_palette_size > 0) {
+    alpha_palette_bytes = std::unique_ptr<png_byte[]>(new png_byte[alpha_palette_size]);
   }
 
-  for (const auto& entry : *color_palette) {
-    const uint32_t color = entry.first;
-    const int index = entry.second;
-    CHECK(index >= 0);
-    CHECK(static_cast<size_t>(index) < color_palette->size());
+  for (size_t index = 0; index < ordered_colors.size(); index++) {
+    const uint32_t color = ordered_colors[index];
+    color_palette->SetIndex(color, static_cast<int>(index));
 
     png_colorp slot = color_palette_bytes.get() + index;
     slot->red = color >> 24;
@@ -416,8 +581,8 @@ static void WritePalette(png_structp write_ptr, png_infop write_info_ptr,
     slot->blue = color >> 8;
 
     const png_byte alpha = color & 0x000000ff;
-    if (alpha != 0xff && alpha_palette_bytes) {
-      CHECK(static_cast<size_t>(index) < alpha_palette->size());
+    if (alpha != 0xff) {
+      CHECK(index < alpha_palette_size);
       alpha_palette_bytes[index] = alpha;
     }
   }
@@ -425,10 +590,10 @@ static void WritePalette(png_structp write_ptr, png_infop write_info_ptr,
   // The bytes get copied here, so it is safe to release color_palette_bytes at
   // the end of function
   // scope.
-  png_set_PLTE(write_ptr, write_info_ptr, color_palette_bytes.get(), color_palette->size());
+  png_set_PLTE(write_ptr, write_info_ptr, color_palette_bytes.get(), ordered_colors.size());
 
   if (alpha_palette_bytes) {
-    png_set_tRNS(write_ptr, write_info_ptr, alpha_palette_bytes.get(), alpha_palette->size(),
+    png_set_tRNS(write_ptr, write_info_ptr, alpha_palette_bytes.get(), alpha_palette_size,
                  nullptr);
   }
 }
@@ -525,69 +690,42 @@ bool WritePng(IAaptContext* context, const Image* image,
   // 1. Every pixel has R == G == B (grayscale)
   // 2. Every pixel has A == 255 (opaque)
   // 3. There are no more than 256 distinct RGBA colors (palette).
-  std::unordered_map<uint32_t, int> color_palette;
-  std::unordered_set<uint32_t> alpha_palette;
-  bool needs_to_zero_rgb_channels_of_transparent_pixels = false;
-  bool grayscale = true;
-  int max_gray_deviation = 0;
-
-  for (int32_t y = 0; y < image->height; y++) {
-    const uint8_t* row = image->rows[y];
-    for (int32_t x = 0; x < image->width; x++) {
-      int red = *row++;
-      int green = *row++;
-      int blue = *row++;
-      int alpha = *row++;
-
-      if (alpha == 0) {
-        // The color is completely transparent.
-        // For purposes of palettes and grayscale optimization,
-        // treat all channels as 0x00.
-        needs_to_zero_rgb_channels_of_transparent_pixels =
-            needs_to_zero_rgb_channels_of_transparent_pixels ||
-            (red != 0 || green != 0 || blue != 0);
-        red = green = blue = 0;
-      }
-
-      // Insert the color into the color palette.
-      const uint32_t color = red << 24 | green << 16 | blue << 8 | alpha;
-      color_palette[color] = -1;
-
-      // If the pixel has non-opaque alpha, insert it into the
-      // alpha palette.
-      if (alpha != 0xff) {
-        alpha_palette.insert(color);
-      }
-
-      // Check if the image is indeed grayscale.
-      if (grayscale) {
-        if (red != green || red != blue) {
-          grayscale = false;
-        }
-      }
-
-      // Calculate the gray scale deviation so that it can be compared
-      // with the threshold.
-      max_gray_deviation = std::max(std::abs(red - green), max_gray_deviation);
-      max_gray_deviation = std::max(std::abs(green - blue), max_gray_deviation);
-      max_gray_deviation = std::max(std::abs(blue - red), max_gray_deviation);
-    }
-  }
+  const ImageAnalysis analysis = AnalyzeImage(image);
+  const bool grayscale = analysis.max_gray_deviation == 0u;
+  const bool needs_to_zero_rgb_channels_of_transparent_pixels =
+      analysis.has_colored_transparent_pixels;
+
+  // A palette can't be used for 9-patches, or for images with too many colors, in which case
+  // the colors are only collected until there are too many.
+  ColorPalette color_palette;
+  if (nine_patch == nullptr) {
+    BuildPalette(image, &color_palette);
+  }
+  const size_t color_palette_size =
+      (nine_patch != nullptr || color_palette.overflowed()) ? ColorPalette::kMaxColors + 1
+                                                           : color_palette.colors().size();
+  const size_t alpha_palette_size =
+      analysis.has_alpha ? std::max<size_t>(color_palette.alpha_count(), 1u) : 0u;
 
   if (context->IsVerbose()) {
     DiagMessage msg;
-    msg << " paletteSize=" << color_palette.size()
-        << " alphaPaletteSize=" << alpha_palette.size()
-        << " maxGrayDeviation=" << max_gray_deviation
+    if (color_palette.overflowed()) {
+      msg << " paletteSize=>" << ColorPalette::kMaxColors;
+    } else if (nine_patch == nullptr) {
+      msg << " paletteSize=" << color_palette_size
+          << " alphaPaletteSize=" << alpha_palette_size;
+    }
+    msg << " maxGrayDeviation=" << analysis.max_gray_deviation
         << " grayScale=" << (grayscale ? "true" : "false");
     context->GetDiagnostics()->Note(msg);
   }
 
-  const bool convertible_to_grayscale = max_gray_deviation <= options.grayscale_tolerance;
+  const bool convertible_to_grayscale =
+      static_cast<int>(analysis.max_gray_deviation) <= options.grayscale_tolerance;
 
   const int new_color_type = PickColorType(
       image->width, image->height, grayscale, convertible_to_grayscale,
-      nine_patch != nullptr, color_palette.size(), alpha_palette.size());
+      nine_patch != nullptr, color_palette_size, alpha_palette_size);
 
   if (context->IsVerbose()) {
     DiagMessage msg;
@@ -625,7 +763,7 @@ bool WritePng(IAaptContext* context, const Image* image,
   if (new_color_type & PNG_COLOR_MASK_PALETTE) {
     // Assigns indices to the palette, and writes the encoded palette to the
     // libpng writePtr.
-    WritePalette(write_ptr, write_info_ptr, &color_palette, &alpha_palette);
+    WritePalette(write_ptr, write_info_ptr, &color_palette);
     png_set_filter(write_ptr, 0, PNG_NO_FILTERS);
   } else {
     png_set_filter(write_ptr, 0, PNG_ALL_FILTERS);
@@ -645,20 +783,17 @@ bool WritePng(IAaptContext* context, const Image* image,
 
     for (int32_t y = 0; y < image->height; y++) {
       png_const_bytep in_row = image->rows[y];
+      uint32_t last_color = 0u;
+      int last_idx = -1;
       for (int32_t x = 0; x < image->width; x++) {
-        int rr = *in_row++;
-        int gg = *in_row++;
-        int bb = *in_row++;
-        int aa = *in_row++;
-        if (aa == 0) {
-          // Zero out color channels when transparent.
-          rr = gg = bb = 0;
+        // Transparent pixels were added to the palette with their color channels zeroed out.
+        const uint32_t color = GetPaletteColor(in_row + x * 4);
+        if (last_idx == -1 || color != last_color) {
+          last_color = color;
+          last_idx = color_palette.GetIndex(color);
+          CHECK(last_idx != -1);
         }
-
-        const uint32_t color = rr << 24 | gg << 16 | bb << 8 | aa;
-        const int idx = color_palette[color];
-        CHECK(idx != -1);
-        out_row[x] = static_cast<png_byte>(idx);
+        out_row[x] = static_cast<png_byte>(last_idx);
       }
       png_write_row(write_ptr, out_row.get());
     }
@@ -256,6 +256,68 @@ class ZipFileWriter : public IArchiveWriter {
 
 }  // namespace
 
+bool BufferedArchiveWriter::WriteFile(const StringPiece& path, uint32_t flags,
+                                      io::InputStream* in) {
+  if (!StartEntry(path, flags)) {
+    return false;
+  }
+
+  const void* data = nullptr;
+  size_t len = 0;
+  while (in->Next(&data, &len)) {
+    if (!Write(data, static_cast<int>(len))) {
+      return false;
+    }
+  }
+
+  if (in->HadError()) {
+    error_ = in->GetError();
+    current_.reset();
+    return false;
+  }
+
+  return FinishEntry();
+}
+
+bool BufferedArchiveWriter::StartEntry(const StringPiece& path, uint32_t flags) {
+  if (current_) {
+    return false;
+  }
+  current_ = util::make_unique<Entry>(Entry{path.to_string(), flags, {}});
+  return true;
+}
+
+bool BufferedArchiveWriter::Write(const void* data, int len) {
+  if (!current_) {
+    return false;
+  }
+  current_->data.append(reinterpret_cast<const char*>(data), len);
+  return true;
+}
+
+bool BufferedArchiveWriter::FinishEntry() {
+  if (!current_) {
+    return false;
+  }
+  entries_.push_back(std::move(*current_));
+  current_.reset();
+  return true;
+}
+
+bool BufferedArchiveWriter::WriteTo(IArchiveWriter* writer) {
+  std::vector<Entry> entries = std::move(entries_);
+  entries_.clear();
+  for (const Entry& entry : entries) {
+    if (!writer->StartEntry(entry.path, entry.flags) ||
+        (!entry.data.empty() &&
+         !writer->Write(entry.data.data(), static_cast<int>(entry.data.size()))) ||
+        !writer->FinishEntry()) {
+      return false;
+    }
+  }
+  return true;
+}
+
 std::unique_ptr<IArchiveWriter> CreateDirectoryArchiveWriter(IDiagnostics* diag,
                                                              const StringPiece& path) {
   std::unique_ptr<DirectoryWriter> writer = util::make_unique<DirectoryWriter>();
@@ -70,6 +70,43 @@ class IArchiveWriter : public ::google::protobuf::io::CopyingOutputStream {
   virtual std::string GetError() const = 0;
 };
 
+// An IArchiveWriter that keeps the finished entries in memory until they are written, in order, to
+// another IArchiveWriter. Lets entries be produced on several threads while the content of the
+// final archive stays deterministic.
+class BufferedArchiveWriter : public IArchiveWriter {
+ public:
+  BufferedArchiveWriter() = default;
+
+  bool WriteFile(const android::StringPiece& path, uint32_t flags, io::InputStream* in) override;
+  bool StartEntry(const android::StringPiece& path, uint32_t flags) override;
+  bool FinishEntry() override;
+  bool Write(const void* buffer, int size) override;
+
+  bool HadError() const override {
+    return !error_.empty();
+  }
+
+  std::string GetError() const override {
+    return error_;
+  }
+
+  // Writes the finished entries to `writer` and forgets them.
+  bool WriteTo(IArchiveWriter* writer);
+
+ private:
+  DISALLOW_COPY_AND_ASSIGN(BufferedArchiveWriter);
+
+  struct Entry {
+    std::string path;
+    uint32_t flags;
+    std::string data;
+  };
+
+  std::vector<Entry> entries_;
+  std::unique_ptr<Entry> current_;
+  std::string error_;
+};
+
 std::unique_ptr<IArchiveWriter> CreateDirectoryArchiveWriter(IDiagnostics* diag,
                                                              const android::StringPiece& path);
 
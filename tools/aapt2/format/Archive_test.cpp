@@ -206,4 +206,31 @@ TEST_F(ArchiveTest, ZipFileWriteFileError) {
   ASSERT_EQ("ZipFileWriteFileError", writer->GetError());
 }
 
+TEST_F(ArchiveTest, BufferedWriteEntriesInOrder) {
+  std::string output_path = GetTestPath("output.apk");
+  std::unique_ptr<IArchiveWriter> zip_writer = MakeZipFileWriter(output_path);
+  std::unique_ptr<uint8_t[]> data1 = MakeTestArray();
+  std::unique_ptr<uint8_t[]> data2 = MakeTestArray();
+
+  BufferedArchiveWriter writer;
+  ASSERT_TRUE(writer.StartEntry("test1", 0));
+  ASSERT_TRUE(writer.Write(static_cast<const void*>(data1.get()), kTestDataLength));
+  ASSERT_TRUE(writer.FinishEntry());
+  ASSERT_TRUE(writer.StartEntry("test2", ArchiveEntry::kCompress));
+  ASSERT_TRUE(writer.Write(static_cast<const void*>(data2.get()), kTestDataLength));
+  ASSERT_TRUE(writer.FinishEntry());
+  ASSERT_FALSE(writer.HadError());
+
+  // An entry that is not finished is not written.
+  ASSERT_TRUE(writer.StartEntry("test3", 0));
+
+  ASSERT_TRUE(writer.WriteTo(zip_writer.get()));
+  zip_writer.reset();
+
+  VerifyZipFile(output_path, "test1", data1.get());
+  VerifyZipFile(output_path, "test2", data2.get());
+  std::unique_ptr<io::ZipFileCollection> zip = io::ZipFileCollection::Create(output_path, nullptr);
+  ASSERT_EQ(zip->FindFile("test3"), nullptr);
+}
+
 }  // namespace aapt
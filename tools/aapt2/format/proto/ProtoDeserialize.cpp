@@ -485,7 +485,7 @@ static bool DeserializePackageFromPb(const pb::Package& pb_package, const ResStr
 
       if (pb_entry.has_overlayable_item()) {
         // Find the overlayable to which this item belongs
-        pb::OverlayableItem pb_overlayable_item = pb_entry.overlayable_item();
+        const pb::OverlayableItem& pb_overlayable_item = pb_entry.overlayable_item();
         if (pb_overlayable_item.overlayable_idx() >= overlayables.size()) {
           *out_error = android::base::StringPrintf("invalid overlayable_idx value %d",
                                                    pb_overlayable_item.overlayable_idx());
@@ -16,8 +16,12 @@
 
 #include "io/ZipArchive.h"
 
+#include <mutex>
+
+#include "android-base/logging.h"
 #include "utils/FileMap.h"
 #include "ziparchive/zip_archive.h"
+#include "zlib.h"
 
 #include "Source.h"
 #include "trace/TraceBuffer.h"
@@ -29,6 +33,158 @@ using ::android::StringPiece;
 namespace aapt {
 namespace io {
 
+namespace {
+
+// Inflates a compressed entry as it is read, from the mmapped compressed bytes of the entry.
+class InflatingInputStream : public InputStream {
+ public:
+  InflatingInputStream(android::FileMap compressed_data, size_t uncompressed_length)
+      : compressed_data_(std::move(compressed_data)), uncompressed_length_(uncompressed_length) {
+    if (inflateInit2(&stream_, -MAX_WBITS) != Z_OK) {
+      error_ = "failed to initialize zlib";
+      return;
+    }
+    initialized_ = true;
+    ResetStream();
+  }
+
+  ~InflatingInputStream() override {
+    if (initialized_) {
+      inflateEnd(&stream_);
+    }
+  }
+
+  bool Next(const void** data, size_t* size) override {
+    if (HadError()) {
+      return false;
+    }
+
+    if (buffer_offset_ == buffer_size_) {
+      if (!Inflate()) {
+        return false;
+      }
+    }
+
+    *data = buffer_.get() + buffer_offset_;
+    *size = buffer_size_ - buffer_offset_;
+    byte_count_ += *size;
+    buffer_offset_ = buffer_size_;
+    return true;
+  }
+
+  void BackUp(size_t count) override {
+    if (count > buffer_offset_) {
+      count = buffer_offset_;
+    }
+    buffer_offset_ -= count;
+    byte_count_ -= count;
+  }
+
+  bool CanRewind() const override {
+    return true;
+  }
+
+  bool Rewind() override {
+    if (HadError() || inflateReset(&stream_) != Z_OK) {
+      return false;
+    }
+    ResetStream();
+    return true;
+  }
+
+  size_t ByteCount() const override {
+    return byte_count_;
+  }
+
+  bool HadError() const override {
+    return !error_.empty();
+  }
+
+  std::string GetError() const override {
+    return error_;
+  }
+
+ private:
+  static constexpr size_t kBufferSize = 32u * 1024u;
+
+  void ResetStream() {
+    stream_.next_in =
+        static_cast<Bytef*>(const_cast<void*>(compressed_data_.getDataPtr()));
+    stream_.avail_in = static_cast<uInt>(compressed_data_.getDataLength());
+    buffer_offset_ = 0u;
+    buffer_size_ = 0u;
+    byte_count_ = 0u;
+    finished_ = false;
+  }
+
+  // Inflates the next block into the buffer. Returns false at the end of the entry or on error.
+  bool Inflate() {
+    if (finished_) {
+      return false;
+    }
+
+    if (buffer_ == nullptr) {
+      buffer_ = std::unique_ptr<uint8_t[]>(new uint8_t[kBufferSize]);
+    }
+
+    stream_.next_out = buffer_.get();
+    stream_.avail_out = static_cast<uInt>(kBufferSize);
+    while (stream_.avail_out == kBufferSize) {
+      const int result = inflate(&stream_, Z_NO_FLUSH);
+      if (result == Z_STREAM_END) {
+        finished_ = true;
+        break;
+      }
+      if (result != Z_OK) {
+        error_ = "failed to inflate entry";
+        return false;
+      }
+      if (stream_.avail_in == 0 && stream_.avail_out == kBufferSize) {
+        error_ = "truncated compressed entry";
+        return false;
+      }
+    }
+
+    buffer_offset_ = 0u;
+    buffer_size_ = kBufferSize - stream_.avail_out;
+    if (finished_ && stream_.total_out != uncompressed_length_) {
+      error_ = "inflated size does not match the entry";
+      return false;
+    }
+    return buffer_size_ > 0u;
+  }
+
+  android::FileMap compressed_data_;
+  const size_t uncompressed_length_;
+  z_stream stream_ = {};
+  bool initialized_ = false;
+  bool finished_ = false;
+  std::unique_ptr<uint8_t[]> buffer_;
+  size_t buffer_offset_ = 0u;
+  size_t buffer_size_ = 0u;
+  size_t byte_count_ = 0u;
+  std::string error_;
+};
+
+// Inflates a whole compressed entry into `out`, which must hold `uncompressed_length` bytes.
+bool InflateToMemory(const android::FileMap& compressed_data, uint8_t* out,
+                     size_t uncompressed_length) {
+  z_stream stream = {};
+  if (inflateInit2(&stream, -MAX_WBITS) != Z_OK) {
+    return false;
+  }
+  stream.next_in = static_cast<Bytef*>(const_cast<void*>(compressed_data.getDataPtr()));
+  stream.avail_in = static_cast<uInt>(compressed_data.getDataLength());
+  stream.next_out = out;
+  stream.avail_out = static_cast<uInt>(uncompressed_length);
+  const int result = inflate(&stream, Z_FINISH);
+  const bool success = result == Z_STREAM_END && stream.total_out == uncompressed_length;
+  inflateEnd(&stream);
+  return success;
+}
+
+}  // namespace
+
 ZipFile::ZipFile(ZipArchiveHandle handle, const ZipEntry& entry,
                  const Source& source)
     : zip_handle_(handle), zip_entry_(entry), source_(source) {}
@@ -50,6 +206,22 @@ std::unique_ptr<IData> ZipFile::OpenAsData() {
     }
     return util::make_unique<MmappedData>(std::move(file_map));
 
+  } else if (zip_entry_.method == kCompressDeflated) {
+    // Inflate from the mmapped compressed bytes rather than through the archive handle, so that
+    // entries of the same archive can be read from several threads.
+    android::FileMap compressed_data;
+    if (!compressed_data.create(nullptr, GetFileDescriptor(zip_handle_), zip_entry_.offset,
+                                zip_entry_.compressed_length, true)) {
+      return {};
+    }
+
+    std::unique_ptr<uint8_t[]> data =
+        std::unique_ptr<uint8_t[]>(new uint8_t[zip_entry_.uncompressed_length]);
+    if (!InflateToMemory(compressed_data, data.get(), zip_entry_.uncompressed_length)) {
+      return {};
+    }
+    return util::make_unique<MallocData>(std::move(data),
+                                         zip_entry_.uncompressed_length);
   } else {
     std::unique_ptr<uint8_t[]> data =
         std::unique_ptr<uint8_t[]>(new uint8_t[zip_entry_.uncompressed_length]);
@@ -65,7 +237,19 @@ std::unique_ptr<IData> ZipFile::OpenAsData() {
 }
 
 std::unique_ptr<io::InputStream> ZipFile::OpenInputStream() {
-  return OpenAsData();
+  if (zip_entry_.method != kCompressDeflated || zip_entry_.uncompressed_length == 0 ||
+      zip_entry_.compressed_length == 0) {
+    return OpenAsData();
+  }
+
+  // Inflate as the stream is read instead of inflating the whole entry up front.
+  android::FileMap compressed_data;
+  if (!compressed_data.create(nullptr, GetFileDescriptor(zip_handle_), zip_entry_.offset,
+                              zip_entry_.compressed_length, true)) {
+    return {};
+  }
+  return util::make_unique<InflatingInputStream>(std::move(compressed_data),
+                                                 zip_entry_.uncompressed_length);
 }
 
 const Source& ZipFile::GetSource() const {
@@ -78,19 +262,107 @@ bool ZipFile::WasCompressed() {
 
 ZipFileCollectionIterator::ZipFileCollectionIterator(
     ZipFileCollection* collection)
-    : current_(collection->files_.begin()), end_(collection->files_.end()) {}
+    : current_(collection->ordered_files_.begin()), end_(collection->ordered_files_.end()) {}
 
 bool ZipFileCollectionIterator::HasNext() {
   return current_ != end_;
 }
 
 IFile* ZipFileCollectionIterator::Next() {
-  IFile* result = current_->get();
+  IFile* result = *current_;
   ++current_;
   return result;
 }
 
-ZipFileCollection::ZipFileCollection() : handle_(nullptr) {}
+class ZipFileCollection::Archive {
+ public:
+  Archive() = default;
+
+  ~Archive() {
+    if (handle) {
+      CloseArchive(handle);
+    }
+  }
+
+  // Returns the entries of the archive in archive order, walking the central directory the first
+  // time it is called.
+  const std::vector<std::pair<std::string, ZipEntry>>& GetEntries() {
+    std::lock_guard<std::mutex> lock(entries_lock_);
+    if (iterated_ || empty) {
+      return entries_;
+    }
+    iterated_ = true;
+
+    void* cookie = nullptr;
+    if (StartIteration(handle, &cookie) != 0) {
+      return entries_;
+    }
+
+    using IterationEnder = std::unique_ptr<void, decltype(EndIteration)*>;
+    IterationEnder iteration_ender(cookie, EndIteration);
+
+    std::string zip_entry_path;
+    ZipEntry zip_data;
+    int32_t result;
+    while ((result = Next(cookie, &zip_data, &zip_entry_path)) == 0) {
+      // Do not add folders to the file collection
+      if (util::EndsWith(zip_entry_path, "/")) {
+        continue;
+      }
+      entries_.emplace_back(zip_entry_path, zip_data);
+    }
+
+    if (result != -1) {
+      // OpenArchive already validated the central directory, so this is not expected.
+      LOG(WARNING) << "failed to iterate " << path << ": " << ErrorCodeString(result);
+    }
+    return entries_;
+  }
+
+  std::string path;
+  ZipArchiveHandle handle = nullptr;
+
+  // Whether the archive has no entries, in which case `handle` is not usable.
+  bool empty = false;
+
+ private:
+  DISALLOW_COPY_AND_ASSIGN(Archive);
+
+  std::mutex entries_lock_;
+  bool iterated_ = false;
+  std::vector<std::pair<std::string, ZipEntry>> entries_;
+};
+
+namespace {
+
+struct CachedArchive {
+  file::FileStamp stamp;
+  std::shared_ptr<ZipFileCollection::Archive> archive;
+};
+
+struct ArchiveCache {
+  std::mutex lock;
+  bool enabled = false;
+  std::map<std::string, CachedArchive> archives;
+};
+
+ArchiveCache& GetArchiveCache() {
+  static ArchiveCache* cache = new ArchiveCache();
+  return *cache;
+}
+
+}  // namespace
+
+void ZipFileCollection::SetArchiveCacheEnabled(bool enabled) {
+  ArchiveCache& cache = GetArchiveCache();
+  std::lock_guard<std::mutex> lock(cache.lock);
+  cache.enabled = enabled;
+  if (!enabled) {
+    cache.archives.clear();
+  }
+}
+
+ZipFileCollection::ZipFileCollection() = default;
 
 std::unique_ptr<ZipFileCollection> ZipFileCollection::Create(
     const StringPiece& path, std::string* out_error) {
@@ -100,60 +372,87 @@ std::unique_ptr<ZipFileCollection> ZipFileCollection::Create(
   std::unique_ptr<ZipFileCollection> collection =
       std::unique_ptr<ZipFileCollection>(new ZipFileCollection());
 
-  int32_t result = OpenArchive(path.data(), &collection->handle_);
+  const std::string path_str = path.to_string();
+  ArchiveCache& cache = GetArchiveCache();
+  file::FileStamp stamp;
+  bool use_cache;
+  {
+    std::lock_guard<std::mutex> lock(cache.lock);
+    use_cache = cache.enabled && file::GetFileStamp(path_str, &stamp);
+    if (use_cache) {
+      auto iter = cache.archives.find(path_str);
+      if (iter != cache.archives.end()) {
+        if (iter->second.stamp == stamp) {
+          collection->archive_ = iter->second.archive;
+          return collection;
+        }
+        cache.archives.erase(iter);
+      }
+    }
+  }
+
+  auto archive = std::make_shared<Archive>();
+  archive->path = path_str;
+  int32_t result = OpenArchive(path.data(), &archive->handle);
   if (result != 0) {
     // If a zip is empty, result will be an error code. This is fine and we
     // should
     // return an empty ZipFileCollection.
-    if (result == kEmptyArchive) {
-      return collection;
+    if (result != kEmptyArchive) {
+      if (out_error) *out_error = ErrorCodeString(result);
+      return {};
     }
-
-    if (out_error) *out_error = ErrorCodeString(result);
-    return {};
-  }
-
-  void* cookie = nullptr;
-  result = StartIteration(collection->handle_, &cookie);
-  if (result != 0) {
-    if (out_error) *out_error = ErrorCodeString(result);
-    return {};
+    archive->empty = true;
   }
 
-  using IterationEnder = std::unique_ptr<void, decltype(EndIteration)*>;
-  IterationEnder iteration_ender(cookie, EndIteration);
-
-  std::string zip_entry_path;
-  ZipEntry zip_data;
-  while ((result = Next(cookie, &zip_data, &zip_entry_path)) == 0) {
-    // Do not add folders to the file collection
-    if (util::EndsWith(zip_entry_path, "/")) {
-      continue;
-    }
-
-    std::unique_ptr<IFile> file = util::make_unique<ZipFile>(collection->handle_, zip_data,
-        Source(zip_entry_path, path.to_string()));
-    collection->files_by_name_[zip_entry_path] = file.get();
-    collection->files_.push_back(std::move(file));
+  if (use_cache) {
+    std::lock_guard<std::mutex> lock(cache.lock);
+    cache.archives[path_str] = CachedArchive{stamp, archive};
   }
+  collection->archive_ = std::move(archive);
+  return collection;
+}
 
-  if (result != -1) {
-    if (out_error) *out_error = ErrorCodeString(result);
-    return {};
+IFile* ZipFileCollection::GetOrCreateFile(const std::string& name, const ZipEntry& entry) {
+  auto iter = files_by_name_.find(name);
+  if (iter != files_by_name_.end()) {
+    return iter->second;
   }
 
-  return collection;
+  std::unique_ptr<IFile> file = util::make_unique<ZipFile>(archive_->handle, entry,
+      Source(name, archive_->path));
+  IFile* result = file.get();
+  files_by_name_[name] = result;
+  files_.push_back(std::move(file));
+  return result;
 }
 
 IFile* ZipFileCollection::FindFile(const StringPiece& path) {
-  auto iter = files_by_name_.find(path.to_string());
+  if (archive_->empty || util::EndsWith(path, "/")) {
+    return nullptr;
+  }
+
+  std::string name = path.to_string();
+  auto iter = files_by_name_.find(name);
   if (iter != files_by_name_.end()) {
     return iter->second;
   }
-  return nullptr;
+
+  // Look the entry up in the central directory instead of walking the whole archive.
+  ZipEntry entry;
+  if (::FindEntry(archive_->handle, name, &entry) != 0) {
+    return nullptr;
+  }
+  return GetOrCreateFile(name, entry);
 }
 
 std::unique_ptr<IFileCollectionIterator> ZipFileCollection::Iterator() {
+  if (!iterated_) {
+    iterated_ = true;
+    for (const auto& entry : archive_->GetEntries()) {
+      ordered_files_.push_back(GetOrCreateFile(entry.first, entry.second));
+    }
+  }
   return util::make_unique<ZipFileCollectionIterator>(this);
 }
 
@@ -164,11 +463,7 @@ char ZipFileCollection::GetDirSeparator() {
   return '/';
 }
 
-ZipFileCollection::~ZipFileCollection() {
-  if (handle_) {
-    CloseArchive(handle_);
-  }
-}
+ZipFileCollection::~ZipFileCollection() = default;
 
 }  // namespace io
 }  // namespace aapt
@@ -20,6 +20,9 @@
 #include "ziparchive/zip_archive.h"
 
 #include <map>
+#include <memory>
+#include <string>
+#include <vector>
 
 #include "androidfw/StringPiece.h"
 
@@ -28,8 +31,9 @@
 namespace aapt {
 namespace io {
 
-// An IFile representing a file within a ZIP archive. If the file is compressed, it is uncompressed
-// and copied into memory when opened. Otherwise it is mmapped from the ZIP archive.
+// An IFile representing a file within a ZIP archive. If the file is stored, it is mmapped from the
+// ZIP archive. If the file is compressed, OpenAsData() inflates it into memory while
+// OpenInputStream() inflates it as the stream is read.
 class ZipFile : public IFile {
  public:
   ZipFile(::ZipArchiveHandle handle, const ::ZipEntry& entry, const Source& source);
@@ -55,28 +59,44 @@ class ZipFileCollectionIterator : public IFileCollectionIterator {
   io::IFile* Next() override;
 
  private:
-  std::vector<std::unique_ptr<IFile>>::const_iterator current_, end_;
+  std::vector<IFile*>::const_iterator current_, end_;
 };
 
-// An IFileCollection that represents a ZIP archive and the entries within it.
+// An IFileCollection that represents a ZIP archive and the entries within it. Files are only
+// created when they are looked up or when the collection is iterated, so opening a large archive
+// to look for a single entry does not walk its whole central directory.
 class ZipFileCollection : public IFileCollection {
  public:
   static std::unique_ptr<ZipFileCollection> Create(const android::StringPiece& path,
                                                    std::string* outError);
 
+  // When enabled, opened archives are kept open and their central directories are reused by later
+  // calls to Create() for the same path, as long as the file has not changed on disk. This is
+  // meant for the daemon, which opens the same framework and library archives for every link.
+  static void SetArchiveCacheEnabled(bool enabled);
+
   io::IFile* FindFile(const android::StringPiece& path) override;
   std::unique_ptr<IFileCollectionIterator> Iterator() override;
   char GetDirSeparator() override;
 
   ~ZipFileCollection() override;
 
+  // An opened archive, which may be shared by collections through the archive cache.
+  class Archive;
+
  private:
   friend class ZipFileCollectionIterator;
   ZipFileCollection();
 
-  ZipArchiveHandle handle_;
+  IFile* GetOrCreateFile(const std::string& name, const ::ZipEntry& entry);
+
+  std::shared_ptr<Archive> archive_;
   std::vector<std::unique_ptr<IFile>> files_;
   std::map<std::string, IFile*> files_by_name_;
+
+  // The non-folder entries of the archive in archive order, filled when first iterated.
+  std::vector<IFile*> ordered_files_;
+  bool iterated_ = false;
 };
 
 }  // namespace io
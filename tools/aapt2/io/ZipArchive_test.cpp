@@ -0,0 +1,186 @@
+/*
+ * Copyright (C) 2020 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "io/ZipArchive.h"
+
+#include <string>
+#include <thread>
+#include <tuple>
+#include <vector>
+
+#include "format/Archive.h"
+#include "io/StringStream.h"
+#include "test/Test.h"
+
+using ::testing::Eq;
+using ::testing::IsNull;
+using ::testing::NotNull;
+
+namespace aapt {
+namespace io {
+
+namespace {
+
+std::string MakeContents(const std::string& line, size_t count) {
+  std::string contents;
+  for (size_t i = 0; i < count; i++) {
+    contents += line + std::to_string(i) + "\n";
+  }
+  return contents;
+}
+
+void WriteZip(const std::string& path,
+              const std::vector<std::tuple<std::string, uint32_t, std::string>>& entries) {
+  std::remove(path.c_str());
+  StdErrDiagnostics diag;
+  std::unique_ptr<IArchiveWriter> writer = CreateZipFileArchiveWriter(&diag, path);
+  ASSERT_THAT(writer, NotNull());
+  for (const auto& entry : entries) {
+    StringInputStream in(std::get<2>(entry));
+    ASSERT_TRUE(writer->WriteFile(std::get<0>(entry), std::get<1>(entry), &in));
+  }
+}
+
+// Reads the stream in small steps, backing up part of every block.
+std::string ReadAll(InputStream* in) {
+  std::string result;
+  const void* data;
+  size_t size;
+  while (in->Next(&data, &size)) {
+    const size_t used = size > 7u ? size - 7u : size;
+    result.append(static_cast<const char*>(data), used);
+    in->BackUp(size - used);
+  }
+  return result;
+}
+
+}  // namespace
+
+using ZipArchiveTest = TestDirectoryFixture;
+
+TEST_F(ZipArchiveTest, InflateCompressedEntryWhileReading) {
+  const std::string path = GetTestPath("test.zip");
+  const std::string stored = "stored contents";
+  const std::string compressed = MakeContents("this line compresses well ", 10000);
+  WriteZip(path, {std::make_tuple("res/stored.txt", 0u, stored),
+                  std::make_tuple("res/compressed.txt", ArchiveEntry::kCompress, compressed)});
+
+  std::string error;
+  std::unique_ptr<ZipFileCollection> collection = ZipFileCollection::Create(path, &error);
+  ASSERT_THAT(collection, NotNull()) << error;
+
+  EXPECT_THAT(collection->FindFile("res/missing.txt"), IsNull());
+  EXPECT_THAT(collection->FindFile("res/"), IsNull());
+
+  IFile* stored_file = collection->FindFile("res/stored.txt");
+  ASSERT_THAT(stored_file, NotNull());
+  EXPECT_FALSE(stored_file->WasCompressed());
+  std::unique_ptr<InputStream> stored_in = stored_file->OpenInputStream();
+  ASSERT_THAT(stored_in, NotNull());
+  EXPECT_THAT(ReadAll(stored_in.get()), Eq(stored));
+
+  IFile* compressed_file = collection->FindFile("res/compressed.txt");
+  ASSERT_THAT(compressed_file, NotNull());
+  EXPECT_TRUE(compressed_file->WasCompressed());
+  EXPECT_THAT(collection->FindFile("res/compressed.txt"), Eq(compressed_file));
+
+  std::unique_ptr<InputStream> compressed_in = compressed_file->OpenInputStream();
+  ASSERT_THAT(compressed_in, NotNull());
+  EXPECT_THAT(ReadAll(compressed_in.get()), Eq(compressed));
+  EXPECT_FALSE(compressed_in->HadError()) << compressed_in->GetError();
+  EXPECT_THAT(compressed_in->ByteCount(), Eq(compressed.size()));
+
+  ASSERT_TRUE(compressed_in->CanRewind());
+  ASSERT_TRUE(compressed_in->Rewind());
+  EXPECT_THAT(ReadAll(compressed_in.get()), Eq(compressed));
+
+  std::unique_ptr<IData> compressed_data = compressed_file->OpenAsData();
+  ASSERT_THAT(compressed_data, NotNull());
+  EXPECT_THAT(std::string(static_cast<const char*>(compressed_data->data()),
+                          compressed_data->size()),
+              Eq(compressed));
+}
+
+TEST_F(ZipArchiveTest, OpenCompressedEntryFromSeveralThreads) {
+  const std::string path = GetTestPath("test.zip");
+  const std::string compressed = MakeContents("this line compresses well ", 10000);
+  WriteZip(path, {std::make_tuple("res/compressed.txt", ArchiveEntry::kCompress, compressed)});
+
+  std::unique_ptr<ZipFileCollection> collection = ZipFileCollection::Create(path, nullptr);
+  ASSERT_THAT(collection, NotNull());
+  IFile* file = collection->FindFile("res/compressed.txt");
+  ASSERT_THAT(file, NotNull());
+
+  std::vector<std::string> results(4);
+  std::vector<std::thread> threads;
+  for (std::string& result : results) {
+    threads.emplace_back([file, &result]() {
+      std::unique_ptr<IData> data = file->OpenAsData();
+      if (data != nullptr) {
+        result.assign(static_cast<const char*>(data->data()), data->size());
+      }
+    });
+  }
+  for (std::thread& thread : threads) {
+    thread.join();
+  }
+
+  for (const std::string& result : results) {
+    EXPECT_THAT(result, Eq(compressed));
+  }
+}
+
+TEST_F(ZipArchiveTest, IterateFilesInArchiveOrder) {
+  const std::string path = GetTestPath("test.zip");
+  WriteZip(path, {std::make_tuple("b.txt", 0u, "b"),
+                  std::make_tuple("a.txt", ArchiveEntry::kCompress, "a")});
+
+  std::unique_ptr<ZipFileCollection> collection = ZipFileCollection::Create(path, nullptr);
+  ASSERT_THAT(collection, NotNull());
+  IFile* a_file = collection->FindFile("a.txt");
+
+  std::vector<IFile*> files;
+  for (auto iter = collection->Iterator(); iter->HasNext();) {
+    files.push_back(iter->Next());
+  }
+  ASSERT_THAT(files.size(), Eq(2u));
+  EXPECT_THAT(files[0]->GetSource().path, Eq("b.txt"));
+  EXPECT_THAT(files[1], Eq(a_file));
+}
+
+TEST_F(ZipArchiveTest, ReuseCachedArchiveUntilItChanges) {
+  const std::string path = GetTestPath("test.zip");
+  WriteZip(path, {std::make_tuple("a.txt", 0u, "first")});
+
+  ZipFileCollection::SetArchiveCacheEnabled(true);
+  std::unique_ptr<ZipFileCollection> first = ZipFileCollection::Create(path, nullptr);
+  ASSERT_THAT(first, NotNull());
+  std::unique_ptr<ZipFileCollection> second = ZipFileCollection::Create(path, nullptr);
+  ASSERT_THAT(second, NotNull());
+  ASSERT_THAT(second->FindFile("a.txt"), NotNull());
+  first = {};
+  second = {};
+
+  WriteZip(path, {std::make_tuple("a.txt", 0u, "first"),
+                  std::make_tuple("b.txt", 0u, "second")});
+  std::unique_ptr<ZipFileCollection> third = ZipFileCollection::Create(path, nullptr);
+  ZipFileCollection::SetArchiveCacheEnabled(false);
+  ASSERT_THAT(third, NotNull());
+  EXPECT_THAT(third->FindFile("b.txt"), NotNull());
+}
+
+}  // namespace io
+}  // namespace aapt
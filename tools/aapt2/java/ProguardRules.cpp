@@ -31,6 +31,7 @@
 
 using ::aapt::io::OutputStream;
 using ::aapt::text::Printer;
+using ::android::StringPiece;
 
 namespace aapt {
 namespace proguard {
@@ -461,6 +462,103 @@ void WriteKeepSet(const KeepSet& keep_set, OutputStream* out, bool minimal_keep,
   }
 }
 
+void KeepSet::Merge(const KeepSet& other) {
+  for (const auto& entry : other.manifest_class_set_) {
+    manifest_class_set_[entry.first].insert(entry.second.begin(), entry.second.end());
+  }
+  for (const auto& entry : other.method_set_) {
+    method_set_[entry.first].insert(entry.second.begin(), entry.second.end());
+  }
+  for (const auto& entry : other.conditional_class_set_) {
+    conditional_class_set_[entry.first].insert(entry.second.begin(), entry.second.end());
+  }
+  for (const auto& entry : other.reference_set_) {
+    reference_set_[entry.first].insert(entry.second.begin(), entry.second.end());
+  }
+}
+
+// Each rule is one line of tab separated fields: the kind of rule, what is kept and where it is
+// used, as the resource name, source path and line of the usage.
+static void SerializeLocations(const std::string& kind, const std::string& kept,
+                               const std::set<UsageLocation>& locations, std::string* out) {
+  for (const UsageLocation& location : locations) {
+    *out += kind + "\t" + kept + "\t" + location.name.to_string() + "\t" +
+            location.source.path + "\t" +
+            (location.source.line ? std::to_string(location.source.line.value()) : "") + "\n";
+  }
+}
+
+void SerializeKeepSet(const KeepSet& keep_set, std::string* out) {
+  for (const auto& entry : keep_set.manifest_class_set_) {
+    SerializeLocations("manifest", entry.first, entry.second, out);
+  }
+  for (const auto& entry : keep_set.method_set_) {
+    SerializeLocations("method", entry.first.name + "\t" + entry.first.signature, entry.second,
+                       out);
+  }
+  for (const auto& entry : keep_set.conditional_class_set_) {
+    SerializeLocations("class", entry.first.name + "\t" + entry.first.signature, entry.second,
+                       out);
+  }
+  for (const auto& entry : keep_set.reference_set_) {
+    SerializeLocations("reference", entry.first.to_string(), entry.second, out);
+  }
+}
+
+static bool ParseName(const StringPiece& str, ResourceName* out_name) {
+  ResourceNameRef name_ref;
+  if (!ResourceUtils::ParseResourceName(str, &name_ref)) {
+    return false;
+  }
+  *out_name = name_ref.ToResourceName();
+  return true;
+}
+
+bool DeserializeKeepSet(const StringPiece& data, KeepSet* keep_set) {
+  for (const StringPiece& line : util::Tokenize(data, '\n')) {
+    if (line.empty()) {
+      continue;
+    }
+
+    const std::vector<std::string> fields = util::Split(line, '\t');
+    const bool has_signature = fields[0] == "method" || fields[0] == "class";
+    const size_t location_index = has_signature ? 3 : 2;
+    if (fields.size() != location_index + 3) {
+      return false;
+    }
+
+    UsageLocation location;
+    if (!ParseName(fields[location_index], &location.name)) {
+      return false;
+    }
+    location.source.path = fields[location_index + 1];
+    if (!fields[location_index + 2].empty()) {
+      Maybe<uint32_t> line_number = ResourceUtils::ParseInt(fields[location_index + 2]);
+      if (!line_number) {
+        return false;
+      }
+      location.source.line = static_cast<size_t>(line_number.value());
+    }
+
+    if (fields[0] == "manifest") {
+      keep_set->AddManifestClass(location, fields[1]);
+    } else if (fields[0] == "method") {
+      keep_set->AddMethod(location, {fields[1], fields[2]});
+    } else if (fields[0] == "class") {
+      keep_set->AddConditionalClass(location, {fields[1], fields[2]});
+    } else if (fields[0] == "reference") {
+      ResourceName name;
+      if (!ParseName(fields[1], &name)) {
+        return false;
+      }
+      keep_set->AddReference(location, name);
+    } else {
+      return false;
+    }
+  }
+  return true;
+}
+
 bool CollectLocations(const UsageLocation& location, const KeepSet& keep_set,
                       std::set<UsageLocation>* locations) {
   locations->insert(location);
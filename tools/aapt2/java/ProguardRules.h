@@ -69,7 +69,12 @@ class KeepSet {
     reference_set_[resource_name].insert(file);
   }
 
+  // Adds the rules of `other` to this set.
+  void Merge(const KeepSet& other);
+
  private:
+  friend void SerializeKeepSet(const KeepSet& keep_set, std::string* out);
+
   friend void WriteKeepSet(const KeepSet& keep_set, io::OutputStream* out, bool minimal_keep,
                            bool no_location_reference);
 
@@ -93,6 +98,13 @@ bool CollectResourceReferences(IAaptContext* context, ResourceTable* table, Keep
 void WriteKeepSet(const KeepSet& keep_set, io::OutputStream* out, bool minimal_keep,
                   bool no_location_reference);
 
+// Writes the rules of `keep_set` in a form that DeserializeKeepSet() reads back, so that the rules
+// collected from a file can be cached along with it.
+void SerializeKeepSet(const KeepSet& keep_set, std::string* out);
+
+// Adds the rules written by SerializeKeepSet() to `keep_set`. Returns false if `data` is malformed.
+bool DeserializeKeepSet(const android::StringPiece& data, KeepSet* keep_set);
+
 bool CollectLocations(const UsageLocation& location, const KeepSet& keep_set,
                       std::set<UsageLocation>* locations);
 
@@ -22,6 +22,7 @@
 
 using ::aapt::io::StringOutputStream;
 using ::android::ConfigDescription;
+using ::testing::Eq;
 using ::testing::HasSubstr;
 using ::testing::Not;
 
@@ -383,6 +384,36 @@ TEST(ProguardRulesTest, TransitionRulesAreEmitted) {
     "-keep class com.foo.Bar { <init>(android.content.Context, android.util.AttributeSet); }"));
 }
 
+TEST(ProguardRulesTest, SerializedKeepSetIsReadBack) {
+  std::unique_ptr<IAaptContext> context = test::ContextBuilder().Build();
+  std::unique_ptr<xml::XmlResource> menu = test::BuildXmlDom(R"(
+      <menu xmlns:android="http://schemas.android.com/apk/res/android">
+        <item android:onClick="on_click"
+            android:actionViewClass="com.foo.Bar"
+            android:actionProviderClass="com.foo.Baz" />
+      </menu>)");
+  menu->file.name = test::ParseNameOrDie("menu/foo");
+  menu->file.source = Source("res/menu/foo.xml");
+
+  proguard::KeepSet set;
+  ASSERT_TRUE(proguard::CollectProguardRules(context.get(), menu.get(), &set));
+
+  std::string serialized;
+  proguard::SerializeKeepSet(set, &serialized);
+
+  proguard::KeepSet read_set;
+  ASSERT_TRUE(proguard::DeserializeKeepSet(serialized, &read_set));
+  EXPECT_THAT(GetKeepSetString(read_set, /** minimal_rules */ false),
+              Eq(GetKeepSetString(set, /** minimal_rules */ false)));
+
+  proguard::KeepSet merged_set;
+  merged_set.Merge(read_set);
+  EXPECT_THAT(GetKeepSetString(merged_set, /** minimal_rules */ false),
+              Eq(GetKeepSetString(set, /** minimal_rules */ false)));
+
+  EXPECT_FALSE(proguard::DeserializeKeepSet("class\tcom.foo.Bar\n", &read_set));
+}
+
 TEST(ProguardRulesTest, UsageLocationComparator) {
   proguard::UsageLocation location1 = {{"pkg", ResourceType::kAttr, "x"}};
   proguard::UsageLocation location2 = {{"pkg", ResourceType::kAttr, "y"}};
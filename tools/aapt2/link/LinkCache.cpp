@@ -0,0 +1,173 @@
+/*
+ * Copyright (C) 2020 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "link/LinkCache.h"
+
+#include <unistd.h>
+
+#include <cerrno>
+#include <cstdio>
+#include <cstring>
+
+#include "android-base/file.h"
+#include "android-base/stringprintf.h"
+
+#include "util/Files.h"
+#include "util/Util.h"
+
+using ::android::ConfigDescription;
+using ::android::StringPiece;
+using ::android::base::StringPrintf;
+
+namespace aapt {
+
+// An entry starts with this line, followed by the number of files. Each file is its path, config
+// and size on a line each, followed by its data. The keep rules come last, as their size on a line
+// followed by the rules.
+constexpr static const char* kLinkCacheMagic = "aapt2 link cache v1\n";
+
+void LinkCacheKey::Add(const StringPiece& data) {
+  Add(static_cast<uint64_t>(data.size()));
+  Update(data.data(), data.size());
+}
+
+void LinkCacheKey::Add(uint64_t value) {
+  uint8_t bytes[sizeof(value)];
+  for (size_t i = 0; i < sizeof(value); i++) {
+    bytes[i] = static_cast<uint8_t>(value >> (i * 8));
+  }
+  Update(bytes, sizeof(bytes));
+}
+
+void LinkCacheKey::Update(const void* data, size_t size) {
+  const uint8_t* bytes = reinterpret_cast<const uint8_t*>(data);
+  for (size_t i = 0; i < size; i++) {
+    hash_ = (hash_ ^ bytes[i]) * 0x100000001b3ull;
+  }
+  size_ += size;
+}
+
+std::string LinkCacheKey::ToString() const {
+  // The number of bytes hashed makes a collision between different inputs even less likely.
+  return StringPrintf("%016llx-%llx", static_cast<unsigned long long>(hash_),
+                      static_cast<unsigned long long>(size_));
+}
+
+LinkCache::LinkCache(const std::string& dir) : dir_(dir) {
+}
+
+std::string LinkCache::GetEntryPath(const std::string& key) const {
+  std::string path = dir_;
+  file::AppendPath(&path, key);
+  return path;
+}
+
+// Reads a line from `data`, starting at `*offset`, and moves past it.
+static bool ReadLine(const std::string& data, size_t* offset, std::string* out_line) {
+  const size_t end = data.find('\n', *offset);
+  if (end == std::string::npos) {
+    return false;
+  }
+  *out_line = data.substr(*offset, end - *offset);
+  *offset = end + 1;
+  return true;
+}
+
+static bool ReadSize(const std::string& data, size_t* offset, size_t* out_size) {
+  std::string line;
+  if (!ReadLine(data, offset, &line) || line.empty()) {
+    return false;
+  }
+  char* end = nullptr;
+  errno = 0;
+  const unsigned long long value = strtoull(line.c_str(), &end, 10);
+  if (errno != 0 || *end != '\0') {
+    return false;
+  }
+  *out_size = static_cast<size_t>(value);
+  return true;
+}
+
+bool LinkCache::Find(const std::string& key, Entry* out_entry) const {
+  std::string data;
+  if (!android::base::ReadFileToString(GetEntryPath(key), &data)) {
+    return false;
+  }
+
+  const size_t magic_size = strlen(kLinkCacheMagic);
+  if (data.compare(0, magic_size, kLinkCacheMagic) != 0) {
+    return false;
+  }
+
+  size_t offset = magic_size;
+  size_t count;
+  if (!ReadSize(data, &offset, &count)) {
+    return false;
+  }
+
+  Entry entry;
+  for (size_t i = 0; i < count; i++) {
+    File file;
+    std::string config;
+    size_t size;
+    if (!ReadLine(data, &offset, &file.path) || !ReadLine(data, &offset, &config) ||
+        !ConfigDescription::Parse(config, &file.config) || !ReadSize(data, &offset, &size) ||
+        size > data.size() - offset) {
+      return false;
+    }
+    file.data = data.substr(offset, size);
+    offset += size;
+    entry.files.push_back(std::move(file));
+  }
+
+  size_t size;
+  if (!ReadSize(data, &offset, &size) || size != data.size() - offset) {
+    return false;
+  }
+  entry.keep_rules = data.substr(offset);
+  *out_entry = std::move(entry);
+  return true;
+}
+
+bool LinkCache::Store(const std::string& key, const Entry& entry, std::string* out_error) const {
+  std::string data = kLinkCacheMagic;
+  data += std::to_string(entry.files.size()) + "\n";
+  for (const File& file : entry.files) {
+    data += file.path + "\n";
+    data += file.config.to_string() + "\n";
+    data += std::to_string(file.data.size()) + "\n";
+    data += file.data;
+  }
+  data += std::to_string(entry.keep_rules.size()) + "\n";
+  data += entry.keep_rules;
+
+  const std::string path = GetEntryPath(key);
+  const std::string temp_path = StringPrintf("%s.%d.tmp", path.c_str(), getpid());
+  if (!android::base::WriteStringToFile(data, temp_path)) {
+    *out_error = StringPrintf("failed to write %s: %s", temp_path.c_str(), strerror(errno));
+    unlink(temp_path.c_str());
+    return false;
+  }
+
+  if (rename(temp_path.c_str(), path.c_str()) != 0) {
+    *out_error = StringPrintf("failed to rename %s: %s", temp_path.c_str(), strerror(errno));
+    unlink(temp_path.c_str());
+    return false;
+  }
+  return true;
+}
+
+}  // namespace aapt
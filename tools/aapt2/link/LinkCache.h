@@ -0,0 +1,87 @@
+/*
+ * Copyright (C) 2020 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef AAPT_LINK_LINKCACHE_H
+#define AAPT_LINK_LINKCACHE_H
+
+#include <string>
+#include <vector>
+
+#include "android-base/macros.h"
+#include "androidfw/ConfigDescription.h"
+#include "androidfw/StringPiece.h"
+
+namespace aapt {
+
+// Hashes everything a cached output depends on into the key of a LinkCache entry. The inputs are
+// length-prefixed, so that the same bytes split differently do not produce the same key.
+class LinkCacheKey {
+ public:
+  LinkCacheKey() = default;
+
+  void Add(const android::StringPiece& data);
+  void Add(uint64_t value);
+
+  // Returns the key as hex digits, usable as a file name.
+  std::string ToString() const;
+
+ private:
+  void Update(const void* data, size_t size);
+
+  // 64-bit FNV-1a.
+  uint64_t hash_ = 0xcbf29ce484222325ull;
+  uint64_t size_ = 0;
+};
+
+// An on-disk cache of the XML files of the table, as linked, versioned and flattened by link. An
+// entry maps the key of a compiled XML file to what linking it produced: the flattened file, its
+// auto-versioned copies and the proguard rules collected from it. Entries are never modified, so one directory can be shared by any
+// number of builds; a changed input simply produces a different key.
+class LinkCache {
+ public:
+  struct File {
+    std::string path;
+    android::ConfigDescription config;
+    std::string data;
+  };
+
+  struct Entry {
+    std::vector<File> files;
+
+    // The rules written by proguard::SerializeKeepSet().
+    std::string keep_rules;
+  };
+
+  explicit LinkCache(const std::string& dir);
+
+  // Reads the entry stored under `key`. Returns false if there is none, or if it can't be read.
+  bool Find(const std::string& key, Entry* out_entry) const;
+
+  // Stores `entry` under `key`. The entry is written to a temporary file which is then renamed,
+  // so that concurrent builds never read a partial entry.
+  bool Store(const std::string& key, const Entry& entry, std::string* out_error) const;
+
+ private:
+  DISALLOW_COPY_AND_ASSIGN(LinkCache);
+
+  std::string GetEntryPath(const std::string& key) const;
+
+  std::string dir_;
+};
+
+}  // namespace aapt
+
+#endif  // AAPT_LINK_LINKCACHE_H
@@ -0,0 +1,89 @@
+/*
+ * Copyright (C) 2020 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "link/LinkCache.h"
+
+#include "android-base/file.h"
+
+#include "test/Test.h"
+
+using ::testing::Eq;
+using ::testing::Ne;
+using ::testing::SizeIs;
+
+namespace aapt {
+
+using LinkCacheTest = TestDirectoryFixture;
+
+TEST(LinkCacheKeyTest, KeysDependOnHowInputsAreSplit) {
+  LinkCacheKey a;
+  a.Add("ab");
+  a.Add("c");
+
+  LinkCacheKey b;
+  b.Add("a");
+  b.Add("bc");
+
+  LinkCacheKey c;
+  c.Add("ab");
+  c.Add("c");
+
+  EXPECT_THAT(a.ToString(), Ne(b.ToString()));
+  EXPECT_THAT(a.ToString(), Eq(c.ToString()));
+}
+
+TEST_F(LinkCacheTest, StoreAndFindEntry) {
+  LinkCache cache(GetTestDirectory().to_string());
+
+  LinkCache::Entry entry;
+  entry.files.push_back(LinkCache::File{"res/layout/main.xml", {}, std::string("a\0\nb", 4)});
+  entry.files.push_back(
+      LinkCache::File{"res/layout-v21/main.xml", test::ParseConfigOrDie("v21"), "v21"});
+  entry.keep_rules = "rules";
+
+  std::string error;
+  ASSERT_TRUE(cache.Store("key", entry, &error)) << error;
+
+  LinkCache::Entry cached;
+  EXPECT_FALSE(cache.Find("other", &cached));
+  ASSERT_TRUE(cache.Find("key", &cached));
+  ASSERT_THAT(cached.files, SizeIs(2u));
+  EXPECT_THAT(cached.files[0].path, Eq("res/layout/main.xml"));
+  EXPECT_THAT(cached.files[0].config, Eq(android::ConfigDescription::DefaultConfig()));
+  EXPECT_THAT(cached.files[0].data, Eq(std::string("a\0\nb", 4)));
+  EXPECT_THAT(cached.files[1].path, Eq("res/layout-v21/main.xml"));
+  EXPECT_THAT(cached.files[1].config, Eq(test::ParseConfigOrDie("v21")));
+  EXPECT_THAT(cached.files[1].data, Eq("v21"));
+  EXPECT_THAT(cached.keep_rules, Eq("rules"));
+}
+
+TEST_F(LinkCacheTest, IgnoreTruncatedEntry) {
+  LinkCache cache(GetTestDirectory().to_string());
+
+  LinkCache::Entry entry;
+  entry.files.push_back(LinkCache::File{"res/xml/test.xml", {}, "data"});
+  std::string error;
+  ASSERT_TRUE(cache.Store("key", entry, &error)) << error;
+
+  std::string data;
+  ASSERT_TRUE(android::base::ReadFileToString(GetTestPath("key"), &data));
+  WriteFile(GetTestPath("key"), data.substr(0, data.size() - 2));
+
+  LinkCache::Entry cached;
+  EXPECT_FALSE(cache.Find("key", &cached));
+}
+
+}  // namespace aapt
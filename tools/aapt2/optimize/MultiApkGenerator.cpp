@@ -17,8 +17,13 @@
 #include "MultiApkGenerator.h"
 
 #include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
 #include <regex>
 #include <string>
+#include <thread>
+#include <vector>
 
 #include "androidfw/ConfigDescription.h"
 #include "androidfw/StringPiece.h"
@@ -131,13 +136,8 @@ bool MultiApkGenerator::FromBaseApk(const MultiApkGeneratorOptions& options) {
   std::unordered_set<std::string> filtered_artifacts;
   std::unordered_set<std::string> kept_artifacts;
 
-  // For now, just write out the stripped APK since ABI splitting doesn't modify anything else.
+  std::vector<const OutputArtifact*> artifacts;
   for (const OutputArtifact& artifact : options.apk_artifacts) {
-    FilterChain filters;
-
-    ContextWrapper wrapped_context{context_};
-    wrapped_context.SetSource(artifact.name);
-
     if (!options.kept_artifacts.empty()) {
       const auto& it = artifacts_to_keep.find(artifact.name);
       if (it == artifacts_to_keep.end()) {
@@ -151,42 +151,7 @@ bool MultiApkGenerator::FromBaseApk(const MultiApkGeneratorOptions& options) {
         kept_artifacts.insert(artifact.name);
       }
     }
-
-    std::unique_ptr<ResourceTable> table =
-        FilterTable(context_, artifact, *apk_->GetResourceTable(), &filters);
-    if (!table) {
-      return false;
-    }
-
-    IDiagnostics* diag = wrapped_context.GetDiagnostics();
-
-    std::unique_ptr<XmlResource> manifest;
-    if (!UpdateManifest(artifact, &manifest, diag)) {
-      diag->Error(DiagMessage() << "could not update AndroidManifest.xml for output artifact");
-      return false;
-    }
-
-    std::string out = options.out_dir;
-    if (!file::mkdirs(out)) {
-      diag->Warn(DiagMessage() << "could not create out dir: " << out);
-    }
-    file::AppendPath(&out, artifact.name);
-
-    if (context_->IsVerbose()) {
-      diag->Note(DiagMessage() << "Generating split: " << out);
-    }
-
-    std::unique_ptr<IArchiveWriter> writer = CreateZipFileArchiveWriter(diag, out);
-
-    if (context_->IsVerbose()) {
-      diag->Note(DiagMessage() << "Writing output: " << out);
-    }
-
-    filters.AddFilter(util::make_unique<SignatureFilter>());
-    if (!apk_->WriteToArchive(&wrapped_context, table.get(), options.table_flattener_options,
-                              &filters, writer.get(), manifest.get())) {
-      return false;
-    }
+    artifacts.push_back(&artifact);
   }
 
   // Make sure all of the requested artifacts were valid. If there are any kept artifacts left,
@@ -213,7 +178,114 @@ bool MultiApkGenerator::FromBaseApk(const MultiApkGeneratorOptions& options) {
     return false;
   }
 
-  return true;
+  if (!file::mkdirs(options.out_dir)) {
+    context_->GetDiagnostics()->Warn(DiagMessage() << "could not create out dir: "
+                                                   << options.out_dir);
+  }
+
+  if (options.jobs <= 1 || artifacts.size() <= 1) {
+    for (const OutputArtifact* artifact : artifacts) {
+      if (!WriteArtifact(context_, *artifact, options)) {
+        return false;
+      }
+    }
+    return true;
+  }
+
+  // Each artifact is written by a worker thread, which reports through buffered diagnostics. The
+  // messages are replayed in the order of the artifacts, so the output does not depend on the
+  // scheduling. The input archive is iterated once here, so that the workers only read it.
+  apk_->GetFileCollection()->Iterator();
+
+  struct ArtifactResult {
+    explicit ArtifactResult(IAaptContext* context) : context(context) {
+    }
+
+    BufferedDiagnosticsContext context;
+    bool success = false;
+    bool done = false;
+  };
+
+  std::vector<std::unique_ptr<ArtifactResult>> results;
+  results.reserve(artifacts.size());
+  for (size_t i = 0; i < artifacts.size(); i++) {
+    results.push_back(util::make_unique<ArtifactResult>(context_));
+  }
+
+  std::mutex mutex;
+  std::condition_variable artifact_done;
+  std::atomic<size_t> next_artifact(0);
+  auto worker = [&]() {
+    for (size_t i = next_artifact++; i < artifacts.size(); i = next_artifact++) {
+      ArtifactResult* result = results[i].get();
+      result->success = WriteArtifact(&result->context, *artifacts[i], options);
+      std::lock_guard<std::mutex> lock(mutex);
+      result->done = true;
+      artifact_done.notify_all();
+    }
+  };
+
+  std::vector<std::thread> threads;
+  const size_t thread_count = std::min(options.jobs, artifacts.size());
+  for (size_t i = 0; i < thread_count; i++) {
+    threads.emplace_back(worker);
+  }
+
+  bool error = false;
+  for (size_t i = 0; i < artifacts.size(); i++) {
+    {
+      std::unique_lock<std::mutex> lock(mutex);
+      artifact_done.wait(lock, [&]() { return results[i]->done; });
+    }
+
+    std::unique_ptr<ArtifactResult> result = std::move(results[i]);
+    result->context.GetBufferedDiagnostics()->Replay(context_->GetDiagnostics());
+    error |= !result->success;
+  }
+
+  for (std::thread& thread : threads) {
+    thread.join();
+  }
+  return !error;
+}
+
+bool MultiApkGenerator::WriteArtifact(IAaptContext* context, const OutputArtifact& artifact,
+                                      const MultiApkGeneratorOptions& options) {
+  FilterChain filters;
+
+  ContextWrapper wrapped_context{context};
+  wrapped_context.SetSource(artifact.name);
+
+  std::unique_ptr<ResourceTable> table =
+      FilterTable(context, artifact, *apk_->GetResourceTable(), &filters);
+  if (!table) {
+    return false;
+  }
+
+  IDiagnostics* diag = wrapped_context.GetDiagnostics();
+
+  std::unique_ptr<XmlResource> manifest;
+  if (!UpdateManifest(artifact, &manifest, diag)) {
+    diag->Error(DiagMessage() << "could not update AndroidManifest.xml for output artifact");
+    return false;
+  }
+
+  std::string out = options.out_dir;
+  file::AppendPath(&out, artifact.name);
+
+  if (context->IsVerbose()) {
+    diag->Note(DiagMessage() << "Generating split: " << out);
+  }
+
+  std::unique_ptr<IArchiveWriter> writer = CreateZipFileArchiveWriter(diag, out);
+
+  if (context->IsVerbose()) {
+    diag->Note(DiagMessage() << "Writing output: " << out);
+  }
+
+  filters.AddFilter(util::make_unique<SignatureFilter>());
+  return apk_->WriteToArchive(&wrapped_context, table.get(), options.table_flattener_options,
+                              &filters, writer.get(), manifest.get());
 }
 
 std::unique_ptr<ResourceTable> MultiApkGenerator::FilterTable(IAaptContext* context,
@@ -35,6 +35,9 @@ struct MultiApkGeneratorOptions {
   std::vector<configuration::OutputArtifact> apk_artifacts;
   TableFlattenerOptions table_flattener_options;
   std::unordered_set<std::string> kept_artifacts;
+
+  // Number of artifacts to generate in parallel.
+  size_t jobs = 1;
 };
 
 /**
@@ -62,6 +65,13 @@ class MultiApkGenerator {
     return context_->GetDiagnostics();
   }
 
+  /**
+   * Filters the base APK for the artifact and writes it to the output directory. The base APK is
+   * only read, so several artifacts can be written at the same time.
+   */
+  bool WriteArtifact(IAaptContext* context, const configuration::OutputArtifact& artifact,
+                     const MultiApkGeneratorOptions& options);
+
   bool UpdateManifest(const configuration::OutputArtifact& artifact,
                       std::unique_ptr<xml::XmlResource>* updated_manifest, IDiagnostics* diag);
 
@@ -17,10 +17,20 @@
 #include "optimize/ResourceDeduper.h"
 
 #include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#include <unordered_map>
 
+#include "utils/JenkinsHash.h"
+
+#include "Diagnostics.h"
 #include "DominatorTree.h"
 #include "ResourceTable.h"
+#include "ValueVisitor.h"
 #include "trace/TraceBuffer.h"
+#include "util/Util.h"
 
 using android::ConfigDescription;
 
@@ -28,6 +38,108 @@ namespace aapt {
 
 namespace {
 
+/**
+ * Computes a content fingerprint of a value. Values that are Equals() always have the same
+ * fingerprint, so two values with different fingerprints never need to be compared.
+ */
+class ValueFingerprinter : public ConstValueVisitor {
+ public:
+  using ConstValueVisitor::Visit;
+
+  static uint32_t Fingerprint(const Value* value) {
+    if (value == nullptr) {
+      return 0u;
+    }
+    ValueFingerprinter fingerprinter;
+    value->Accept(&fingerprinter);
+    return fingerprinter.hash_;
+  }
+
+  void Visit(const Reference* ref) override {
+    Mix(1u);
+    Mix(static_cast<uint32_t>(ref->reference_type));
+    Mix(ref->private_reference ? 1u : 0u);
+    Mix(ref->id ? ref->id.value().id : 0u);
+    Mix(ref->name ? static_cast<uint32_t>(std::hash<ResourceName>()(ref->name.value())) : 0u);
+  }
+
+  void Visit(const RawString* str) override {
+    Mix(2u);
+    Mix(*str->value);
+  }
+
+  void Visit(const String* str) override {
+    Mix(3u);
+    Mix(*str->value);
+  }
+
+  void Visit(const StyledString* str) override {
+    Mix(4u);
+    Mix(str->value->value);
+  }
+
+  void Visit(const FileReference* file) override {
+    Mix(5u);
+    Mix(*file->path);
+  }
+
+  void Visit(const Id* /*id*/) override {
+    Mix(6u);
+  }
+
+  void Visit(const BinaryPrimitive* prim) override {
+    Mix(7u);
+    Mix(prim->value.dataType);
+    Mix(prim->value.data);
+  }
+
+  void Visit(const Attribute* attr) override {
+    Mix(8u);
+    Mix(attr->type_mask);
+    Mix(static_cast<uint32_t>(attr->min_int));
+    Mix(static_cast<uint32_t>(attr->max_int));
+    Mix(static_cast<uint32_t>(attr->symbols.size()));
+  }
+
+  void Visit(const Style* style) override {
+    Mix(9u);
+    Mix(style->parent ? 1u : 0u);
+    Mix(static_cast<uint32_t>(style->entries.size()));
+  }
+
+  void Visit(const Array* array) override {
+    Mix(10u);
+    for (const auto& element : array->elements) {
+      Mix(Fingerprint(element.get()));
+    }
+  }
+
+  void Visit(const Plural* plural) override {
+    Mix(11u);
+    for (const auto& value : plural->values) {
+      Mix(Fingerprint(value.get()));
+    }
+  }
+
+  void Visit(const Styleable* styleable) override {
+    Mix(12u);
+    Mix(static_cast<uint32_t>(styleable->entries.size()));
+  }
+
+ private:
+  ValueFingerprinter() = default;
+
+  void Mix(uint32_t value) {
+    hash_ = android::JenkinsHashMix(hash_, value);
+  }
+
+  void Mix(const std::string& str) {
+    Mix(static_cast<uint32_t>(std::hash<std::string>()(str)));
+  }
+
+  uint32_t hash_ = 0u;
+};
+
 /**
  * Remove duplicated key-value entries from dominated resources.
  *
@@ -38,13 +150,21 @@ namespace {
  * 2. All compatible configurations for the entry (those not in conflict and
  *    unrelated by domination with the configuration for the entry's value) have
  *    an equivalent entry value.
+ *
+ * Removed values are moved into `removed` rather than destroyed, since destroying a value
+ * releases references into the table's string pool, which is not thread-safe.
  */
 class DominatedKeyValueRemover : public DominatorTree::BottomUpVisitor {
  public:
   using Node = DominatorTree::Node;
 
-  explicit DominatedKeyValueRemover(IAaptContext* context, ResourceEntry* entry)
-      : context_(context), entry_(entry) {}
+  explicit DominatedKeyValueRemover(IDiagnostics* diag, bool verbose, ResourceEntry* entry,
+                                    std::vector<std::unique_ptr<Value>>* removed)
+      : diag_(diag), verbose_(verbose), entry_(entry), removed_(removed) {
+    for (const auto& config_value : entry->values) {
+      fingerprints_[config_value.get()] = ValueFingerprinter::Fingerprint(config_value->value.get());
+    }
+  }
 
   void VisitConfig(Node* node) {
     Node* parent = node->parent();
@@ -56,7 +176,7 @@ class DominatedKeyValueRemover : public DominatorTree::BottomUpVisitor {
     if (!node_value || !parent_value) {
       return;
     }
-    if (!node_value->value->Equals(parent_value->value.get())) {
+    if (!AreEqual(node_value, parent_value)) {
       return;
     }
 
@@ -70,33 +190,49 @@ class DominatedKeyValueRemover : public DominatorTree::BottomUpVisitor {
         continue;
       }
       if (node_configuration.IsCompatibleWith(sibling_value->config) &&
-          !node_value->value->Equals(sibling_value->value.get())) {
+          !AreEqual(node_value, sibling_value)) {
         // The configurations are compatible, but the value is
         // different, so we can't remove this value.
         return;
       }
     }
-    if (context_->IsVerbose()) {
-      context_->GetDiagnostics()->Note(
+    if (verbose_) {
+      diag_->Note(
           DiagMessage(node_value->value->GetSource())
-          << "removing dominated duplicate resource with name \""
-          << entry_->name << "\"");
-      context_->GetDiagnostics()->Note(
+          << "removing dominated duplicate resource with name ""
+          << entry_->name << """);
+      diag_->Note(
           DiagMessage(parent_value->value->GetSource()) << "dominated here");
     }
-    node_value->value = {};
+    removed_->push_back(std::move(node_value->value));
   }
 
  private:
   DISALLOW_COPY_AND_ASSIGN(DominatedKeyValueRemover);
 
-  IAaptContext* context_;
+  bool AreEqual(const ResourceConfigValue* a, const ResourceConfigValue* b) {
+    if (a == b) {
+      return true;
+    }
+    return fingerprints_[a] == fingerprints_[b] && a->value->Equals(b->value.get());
+  }
+
+  IDiagnostics* diag_;
+  bool verbose_;
   ResourceEntry* entry_;
+  std::vector<std::unique_ptr<Value>>* removed_;
+  std::unordered_map<const ResourceConfigValue*, uint32_t> fingerprints_;
 };
 
-static void DedupeEntry(IAaptContext* context, ResourceEntry* entry) {
+static void DedupeEntry(IDiagnostics* diag, bool verbose, ResourceEntry* entry,
+                        std::vector<std::unique_ptr<Value>>* removed) {
+  if (entry->values.size() < 2) {
+    // Nothing can dominate a lone value.
+    return;
+  }
+
   DominatorTree tree(entry->values);
-  DominatedKeyValueRemover remover(context, entry);
+  DominatedKeyValueRemover remover(diag, verbose, entry, removed);
   tree.Accept(&remover);
 
   // Erase the values that were removed.
@@ -109,16 +245,75 @@ static void DedupeEntry(IAaptContext* context, ResourceEntry* entry) {
       entry->values.end());
 }
 
+// The outcome of deduping one type on a worker thread.
+struct TypeResult {
+  BufferedDiagnostics diag;
+  std::vector<std::unique_ptr<Value>> removed;
+  bool done = false;
+};
+
 }  // namespace
 
 bool ResourceDeduper::Consume(IAaptContext* context, ResourceTable* table) {
   TRACE_CALL();
+  const bool verbose = context->IsVerbose();
+  std::vector<ResourceTableType*> types;
   for (auto& package : table->packages) {
     for (auto& type : package->types) {
+      types.push_back(type.get());
+    }
+  }
+
+  if (jobs_ <= 1 || types.size() <= 1) {
+    std::vector<std::unique_ptr<Value>> removed;
+    for (ResourceTableType* type : types) {
       for (auto& entry : type->entries) {
-        DedupeEntry(context, entry.get());
+        DedupeEntry(context->GetDiagnostics(), verbose, entry.get(), &removed);
+      }
+    }
+    return true;
+  }
+
+  // Types are independent of each other, so dedupe them in parallel. Notes are replayed and
+  // removed values destroyed on this thread, in type order.
+  std::vector<std::unique_ptr<TypeResult>> results;
+  for (size_t i = 0; i < types.size(); i++) {
+    results.push_back(util::make_unique<TypeResult>());
+  }
+
+  std::atomic<size_t> next_type(0);
+  std::mutex mutex;
+  std::condition_variable cv;
+  auto worker = [&]() {
+    size_t i;
+    while ((i = next_type++) < types.size()) {
+      TypeResult* result = results[i].get();
+      for (auto& entry : types[i]->entries) {
+        DedupeEntry(&result->diag, verbose, entry.get(), &result->removed);
       }
+      std::lock_guard<std::mutex> guard(mutex);
+      result->done = true;
+      cv.notify_all();
+    }
+  };
+
+  std::vector<std::thread> threads;
+  const size_t thread_count = std::min(jobs_, types.size());
+  for (size_t i = 0; i < thread_count; i++) {
+    threads.emplace_back(worker);
+  }
+
+  for (auto& result : results) {
+    {
+      std::unique_lock<std::mutex> lock(mutex);
+      cv.wait(lock, [&]() { return result->done; });
     }
+    result->diag.Replay(context->GetDiagnostics());
+    result->removed.clear();
+  }
+
+  for (auto& thread : threads) {
+    thread.join();
   }
   return true;
 }
@@ -17,6 +17,8 @@
 #ifndef AAPT_OPTIMIZE_RESOURCEDEDUPER_H
 #define AAPT_OPTIMIZE_RESOURCEDEDUPER_H
 
+#include <cstddef>
+
 #include "android-base/macros.h"
 
 #include "process/IResourceTableConsumer.h"
@@ -26,14 +28,18 @@ namespace aapt {
 class ResourceTable;
 
 // Removes duplicated key-value entries from dominated resources.
+// When `jobs` is greater than 1, resource types are deduped in parallel on up to `jobs` threads.
 class ResourceDeduper : public IResourceTableConsumer {
  public:
-  ResourceDeduper() = default;
+  explicit ResourceDeduper(size_t jobs = 1) : jobs_(jobs) {
+  }
 
   bool Consume(IAaptContext* context, ResourceTable* table) override;
 
  private:
   DISALLOW_COPY_AND_ASSIGN(ResourceDeduper);
+
+  size_t jobs_;
 };
 
 } // namespace aapt
@@ -17,6 +17,7 @@
 #include "optimize/ResourceDeduper.h"
 
 #include "ResourceTable.h"
+#include "ResourceUtils.h"
 #include "test/Test.h"
 
 using ::aapt::test::HasValue;
@@ -151,4 +152,56 @@ TEST(ResourceDeduperTest, LocalesValuesAreKept) {
   EXPECT_THAT(table, HasValue("android:string/keep", fr_rCA_config));
 }
 
+TEST(ResourceDeduperTest, StylesWithSameShapeButDifferentItemsAreKept) {
+  std::unique_ptr<IAaptContext> context = test::ContextBuilder().Build();
+  const ConfigDescription default_config = {};
+  const ConfigDescription land_config = test::ParseConfigOrDie("land");
+
+  std::unique_ptr<ResourceTable> table =
+      test::ResourceTableBuilder()
+          .AddValue("android:style/keep", default_config, ResourceId{},
+                    test::StyleBuilder()
+                        .AddItem("android:attr/foo", ResourceUtils::TryParseInt("1"))
+                        .Build())
+          .AddValue("android:style/keep", land_config, ResourceId{},
+                    test::StyleBuilder()
+                        .AddItem("android:attr/foo", ResourceUtils::TryParseInt("2"))
+                        .Build())
+          .Build();
+
+  ASSERT_TRUE(ResourceDeduper().Consume(context.get(), table.get()));
+  EXPECT_THAT(table, HasValue("android:style/keep", default_config));
+  EXPECT_THAT(table, HasValue("android:style/keep", land_config));
+}
+
+TEST(ResourceDeduperTest, TypesAreDedupedInParallel) {
+  std::unique_ptr<IAaptContext> context = test::ContextBuilder().Build();
+  const ConfigDescription default_config = {};
+  const ConfigDescription land_config = test::ParseConfigOrDie("land");
+
+  std::unique_ptr<ResourceTable> table =
+      test::ResourceTableBuilder()
+          .AddString("android:string/dedupe", ResourceId{}, default_config, "dedupe")
+          .AddString("android:string/dedupe", ResourceId{}, land_config, "dedupe")
+          .AddString("android:string/keep", ResourceId{}, default_config, "keep")
+          .AddString("android:string/keep", ResourceId{}, land_config, "keep2")
+          .AddValue("android:integer/dedupe", default_config, ResourceId{},
+                    ResourceUtils::TryParseInt("1"))
+          .AddValue("android:integer/dedupe", land_config, ResourceId{},
+                    ResourceUtils::TryParseInt("1"))
+          .AddValue("android:integer/keep", default_config, ResourceId{},
+                    ResourceUtils::TryParseInt("1"))
+          .AddValue("android:integer/keep", land_config, ResourceId{},
+                    ResourceUtils::TryParseInt("2"))
+          .Build();
+
+  ASSERT_TRUE(ResourceDeduper(4).Consume(context.get(), table.get()));
+  EXPECT_THAT(table, HasValue("android:string/dedupe", default_config));
+  EXPECT_THAT(table, Not(HasValue("android:string/dedupe", land_config)));
+  EXPECT_THAT(table, HasValue("android:string/keep", land_config));
+  EXPECT_THAT(table, HasValue("android:integer/dedupe", default_config));
+  EXPECT_THAT(table, Not(HasValue("android:integer/dedupe", land_config)));
+  EXPECT_THAT(table, HasValue("android:integer/keep", land_config));
+}
+
 }  // namespace aapt
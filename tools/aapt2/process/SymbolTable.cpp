@@ -17,6 +17,8 @@
 #include "process/SymbolTable.h"
 
 #include <iostream>
+#include <map>
+#include <mutex>
 
 #include "android-base/logging.h"
 #include "android-base/stringprintf.h"
@@ -31,6 +33,7 @@
 #include "ResourceUtils.h"
 #include "ValueVisitor.h"
 #include "trace/TraceBuffer.h"
+#include "util/Files.h"
 #include "util/Util.h"
 
 using ::android::ApkAssets;
@@ -217,13 +220,68 @@ std::unique_ptr<SymbolTable::Symbol> ResourceTableSymbolSource::FindByName(
   return symbol;
 }
 
+namespace {
+
+struct CachedApkAssets {
+  file::FileStamp stamp;
+  std::shared_ptr<const ApkAssets> apk_assets;
+};
+
+struct ApkAssetsCache {
+  std::mutex lock;
+  bool enabled = false;
+  std::map<std::string, CachedApkAssets> apk_assets;
+};
+
+ApkAssetsCache& GetApkAssetsCache() {
+  static ApkAssetsCache* cache = new ApkAssetsCache();
+  return *cache;
+}
+
+std::shared_ptr<const ApkAssets> LoadApkAssets(const std::string& path) {
+  ApkAssetsCache& cache = GetApkAssetsCache();
+  file::FileStamp stamp;
+  bool use_cache;
+  {
+    std::lock_guard<std::mutex> lock(cache.lock);
+    use_cache = cache.enabled && file::GetFileStamp(path, &stamp);
+    if (use_cache) {
+      auto iter = cache.apk_assets.find(path);
+      if (iter != cache.apk_assets.end()) {
+        if (iter->second.stamp == stamp) {
+          return iter->second.apk_assets;
+        }
+        cache.apk_assets.erase(iter);
+      }
+    }
+  }
+
+  std::shared_ptr<const ApkAssets> apk_assets = ApkAssets::Load(path);
+  if (apk_assets != nullptr && use_cache) {
+    std::lock_guard<std::mutex> lock(cache.lock);
+    cache.apk_assets[path] = CachedApkAssets{stamp, apk_assets};
+  }
+  return apk_assets;
+}
+
+}  // namespace
+
+void AssetManagerSymbolSource::SetApkAssetsCacheEnabled(bool enabled) {
+  ApkAssetsCache& cache = GetApkAssetsCache();
+  std::lock_guard<std::mutex> lock(cache.lock);
+  cache.enabled = enabled;
+  if (!enabled) {
+    cache.apk_assets.clear();
+  }
+}
+
 bool AssetManagerSymbolSource::AddAssetPath(const StringPiece& path) {
   TRACE_CALL();
-  if (std::unique_ptr<const ApkAssets> apk = ApkAssets::Load(path.data())) {
+  if (std::shared_ptr<const ApkAssets> apk = LoadApkAssets(path.to_string())) {
     apk_assets_.push_back(std::move(apk));
 
     std::vector<const ApkAssets*> apk_assets;
-    for (const std::unique_ptr<const ApkAssets>& apk_asset : apk_assets_) {
+    for (const std::shared_ptr<const ApkAssets>& apk_asset : apk_assets_) {
       apk_assets.push_back(apk_asset.get());
     }
 
@@ -251,7 +309,7 @@ bool AssetManagerSymbolSource::IsPackageDynamic(uint32_t packageId,
     return true;
   }
 
-  for (const std::unique_ptr<const ApkAssets>& assets : apk_assets_) {
+  for (const std::shared_ptr<const ApkAssets>& assets : apk_assets_) {
     for (const std::unique_ptr<const android::LoadedPackage>& loaded_package
          : assets->GetLoadedArsc()->GetPackages()) {
       if (package_name == loaded_package->GetPackageName() && loaded_package->IsDynamic()) {
@@ -192,6 +192,11 @@ class AssetManagerSymbolSource : public ISymbolSource {
  public:
   AssetManagerSymbolSource() = default;
 
+  // When enabled, the ApkAssets loaded by AddAssetPath() are kept in memory and shared by later
+  // sources that add the same path, as long as the file has not changed on disk. This is meant for
+  // the daemon, which parses the same framework resources.arsc for every link.
+  static void SetApkAssetsCacheEnabled(bool enabled);
+
   bool AddAssetPath(const android::StringPiece& path);
   std::map<size_t, std::string> GetAssignedPackageIds() const;
   bool IsPackageDynamic(uint32_t packageId, const std::string& package_name) const;
@@ -208,7 +213,7 @@ class AssetManagerSymbolSource : public ISymbolSource {
 
  private:
   android::AssetManager2 asset_manager_;
-  std::vector<std::unique_ptr<const android::ApkAssets>> apk_assets_;
+  std::vector<std::shared_ptr<const android::ApkAssets>> apk_assets_;
 
   DISALLOW_COPY_AND_ASSIGN(AssetManagerSymbolSource);
 };
@@ -16,7 +16,9 @@
 
 #include "TraceBuffer.h"
 
+#include <atomic>
 #include <chrono>
+#include <mutex>
 #include <sstream>
 #include <unistd.h>
 #include <vector>
@@ -36,13 +38,22 @@ constexpr char kBegin = 'B';
 constexpr char kEnd = 'E';
 
 struct TracePoint {
-  pid_t tid;
+  pid_t pid;
+  int tid;
   int64_t time;
   std::string tag;
   char type;
 };
 
-std::vector<TracePoint> traces;
+std::mutex traces_mutex;
+std::vector<TracePoint> traces;  // GUARDED_BY(traces_mutex)
+
+// A small id per thread. The actual thread id is not available on every host platform.
+int GetThreadId() noexcept {
+  static std::atomic<int> next_thread_id(0);
+  thread_local int thread_id = next_thread_id++;
+  return thread_id;
+}
 
 int64_t GetTime() noexcept {
   auto now = std::chrono::steady_clock::now();
@@ -52,7 +63,8 @@ int64_t GetTime() noexcept {
 } // namespace anonymous
 
 void AddWithTime(const std::string& tag, char type, int64_t time) noexcept {
-  TracePoint t = {getpid(), time, tag, type};
+  TracePoint t = {getpid(), GetThreadId(), time, tag, type};
+  std::lock_guard<std::mutex> lock(traces_mutex);
   traces.emplace_back(t);
 }
 
@@ -76,9 +88,11 @@ void Flush(const std::string& basePath) {
     return;
   }
 
+  std::lock_guard<std::mutex> lock(traces_mutex);
   for(const TracePoint& trace : traces) {
     fprintf(f, "{\"ts\" : \"%" PRIu64 "\", \"ph\" : \"%c\", \"tid\" : \"%d\" , \"pid\" : \"%d\", "
-            "\"name\" : \"%s\" },\n", trace.time, trace.type, 0, trace.tid, trace.tag.c_str());
+            "\"name\" : \"%s\" },\n", trace.time, trace.type, trace.tid, trace.pid,
+            trace.tag.c_str());
   }
   fclose(f);
   traces.clear();
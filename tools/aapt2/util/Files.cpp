@@ -241,6 +241,21 @@ Maybe<FileMap> MmapPath(const std::string& path, std::string* out_error) {
   return std::move(filemap);
 }
 
+bool GetFileStamp(const std::string& path, FileStamp* out_stamp) {
+  struct stat sb;
+  if (stat(path.c_str(), &sb) != 0) {
+    return false;
+  }
+  out_stamp->size = static_cast<int64_t>(sb.st_size);
+  out_stamp->mtime_sec = static_cast<int64_t>(sb.st_mtime);
+#if defined(__APPLE__)
+  out_stamp->mtime_nsec = static_cast<int64_t>(sb.st_mtimespec.tv_nsec);
+#elif !defined(_WIN32)
+  out_stamp->mtime_nsec = static_cast<int64_t>(sb.st_mtim.tv_nsec);
+#endif
+  return true;
+}
+
 bool AppendArgsFromFile(const StringPiece& path, std::vector<std::string>* out_arglist,
                         std::string* out_error) {
   std::string contents;
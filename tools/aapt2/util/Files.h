@@ -17,6 +17,7 @@
 #ifndef AAPT_FILES_H
 #define AAPT_FILES_H
 
+#include <cstdint>
 #include <memory>
 #include <string>
 #include <unordered_set>
@@ -83,6 +84,24 @@ std::string PackageToPath(const android::StringPiece& package);
 // Creates a FileMap for the file at path.
 Maybe<android::FileMap> MmapPath(const std::string& path, std::string* out_error);
 
+// Identifies the version of a file on disk, to tell when something cached from it is stale.
+struct FileStamp {
+  int64_t size = 0;
+  int64_t mtime_sec = 0;
+  int64_t mtime_nsec = 0;
+
+  bool operator==(const FileStamp& rhs) const {
+    return size == rhs.size && mtime_sec == rhs.mtime_sec && mtime_nsec == rhs.mtime_nsec;
+  }
+
+  bool operator!=(const FileStamp& rhs) const {
+    return !(*this == rhs);
+  }
+};
+
+// Reads the size and modification time of the file at path.
+bool GetFileStamp(const std::string& path, FileStamp* out_stamp);
+
 // Reads the file at path and appends each line to the outArgList vector.
 bool AppendArgsFromFile(const android::StringPiece& path, std::vector<std::string>* out_arglist,
                         std::string* out_error);
@@ -15,7 +15,9 @@
  */
 
 #include <algorithm>
+#include <cctype>
 #include <cstdio>
+#include <cstring>
 
 #include "aapt/AaptUtil.h"
 
@@ -37,11 +39,14 @@ namespace split {
 static void usage() {
     fprintf(stderr,
             "split-select --help\n"
-            "split-select --target <config> --base <path/to/apk> [--split <path/to/apk> [...]]\n"
+            "split-select --target <config> [--target <config> [...]] --base <path/to/apk> [--split <path/to/apk> [...]]\n"
+            "split-select --target-list <path/to/file> --base <path/to/apk> [--split <path/to/apk> [...]]\n"
             "split-select --generate --base <path/to/apk> [--split <path/to/apk> [...]]\n"
             "\n"
             "  --help                   Displays more information about this program.\n"
             "  --target <config>        Performs the Split APK selection on the given configuration.\n"
+            "                           May be repeated to select for several configurations at once.\n"
+            "  --target-list <path>     Reads the configurations to select for from a file, one per line.\n"
             "  --generate               Generates the logic for selecting the Split APK, in JSON format.\n"
             "  --base <path/to/apk>     Specifies the base APK, from which all Split APKs must be based off.\n"
             "  --split <path/to/apk>    Includes a Split APK in the selection process.\n"
@@ -60,7 +65,35 @@ static void help() {
             "  Using the flag --generate will emit a JSON encoded tree of rules that must be satisfied in order\n"
             "  to install the given Split APK. Using the flag --target along with the device configuration\n"
             "  will emit the set of Split APKs to install, following the same logic that would have been emitted\n"
-            "  via JSON.\n");
+            "  via JSON.\n"
+            "\n"
+            "  When selecting for more than one target, the Split APKs of each target are listed under a\n"
+            "  '<config>:' line, indented by two spaces.\n");
+}
+
+static bool readTargetList(const String8& path, Vector<String8>* outTargets) {
+    FILE* f = fopen(path.string(), "r");
+    if (f == NULL) {
+        return false;
+    }
+
+    char line[1024];
+    while (fgets(line, sizeof(line), f) != NULL) {
+        const char* start = line;
+        while (isspace(*start)) {
+            start++;
+        }
+        size_t len = strlen(start);
+        while (len > 0 && isspace(start[len - 1])) {
+            len--;
+        }
+        if (len > 0 && start[0] != '#') {
+            outTargets->add(String8(start, len));
+        }
+    }
+    const bool success = ferror(f) == 0;
+    fclose(f);
+    return success;
 }
 
 Vector<SplitDescription> select(const SplitDescription& target, const Vector<SplitDescription>& splits) {
@@ -243,7 +276,7 @@ static int main(int argc, char** argv) {
     argv++;
 
     bool generateFlag = false;
-    String8 targetConfigStr;
+    Vector<String8> targetConfigStrs;
     Vector<String8> splitApkPaths;
     String8 baseApkPath;
     while (argc > 0) {
@@ -256,7 +289,19 @@ static int main(int argc, char** argv) {
                 usage();
                 return 1;
             }
-            targetConfigStr.setTo(*argv);
+            targetConfigStrs.add(String8(*argv));
+        } else if (arg == "--target-list") {
+            argc--;
+            argv++;
+            if (argc < 1) {
+                fprintf(stderr, "error: missing parameter for --target-list.\n");
+                usage();
+                return 1;
+            }
+            if (!readTargetList(String8(*argv), &targetConfigStrs)) {
+                fprintf(stderr, "error: unable to read --target-list '%s'.\n", *argv);
+                return 1;
+            }
         } else if (arg == "--split") {
             argc--;
             argv++;
@@ -295,7 +340,7 @@ static int main(int argc, char** argv) {
         argv++;
     }
 
-    if (!generateFlag && targetConfigStr == "") {
+    if (!generateFlag && targetConfigStrs.isEmpty()) {
         usage();
         return 1;
     }
@@ -313,18 +358,23 @@ static int main(int argc, char** argv) {
         return 1;
     }
 
-    SplitDescription targetSplit;
+    Vector<SplitDescription> targetSplits;
     if (!generateFlag) {
-        if (!SplitDescription::parse(targetConfigStr, &targetSplit)) {
-            fprintf(stderr, "error: invalid --target config: '%s'.\n",
-                    targetConfigStr.string());
-            usage();
-            return 1;
-        }
+        const size_t targetCount = targetConfigStrs.size();
+        for (size_t i = 0; i < targetCount; i++) {
+            SplitDescription targetSplit;
+            if (!SplitDescription::parse(targetConfigStrs[i], &targetSplit)) {
+                fprintf(stderr, "error: invalid --target config: '%s'.\n",
+                        targetConfigStrs[i].string());
+                usage();
+                return 1;
+            }
 
-        // We don't want to match on things that will change at run-time
-        // (orientation, w/h, etc.).
-        removeRuntimeQualifiers(&targetSplit.config);
+            // We don't want to match on things that will change at run-time
+            // (orientation, w/h, etc.).
+            removeRuntimeQualifiers(&targetSplit.config);
+            targetSplits.add(targetSplit);
+        }
     }
 
     splitApkPaths.add(baseApkPath);
@@ -350,17 +400,35 @@ static int main(int argc, char** argv) {
     }
 
     if (!generateFlag) {
-        Vector<SplitDescription> matchingConfigs = select(targetSplit, splitConfigs);
-        const size_t matchingConfigCount = matchingConfigs.size();
-        SortedVector<String8> matchingSplitPaths;
-        for (size_t i = 0; i < matchingConfigCount; i++) {
-            matchingSplitPaths.add(splitApkPathMap.valueFor(matchingConfigs[i]));
-        }
+        // The selector is built once for all targets, and targets that are identical once the
+        // run-time qualifiers are removed (common in device catalogs) are only selected once.
+        const SplitSelector selector(splitConfigs);
+        KeyedVector<SplitDescription, SortedVector<String8> > selected;
+        const bool multipleTargets = targetSplits.size() > 1;
+        const size_t targetCount = targetSplits.size();
+        for (size_t t = 0; t < targetCount; t++) {
+            ssize_t index = selected.indexOfKey(targetSplits[t]);
+            if (index < 0) {
+                Vector<SplitDescription> matchingConfigs =
+                        selector.getBestSplits(targetSplits[t]);
+                const size_t matchingConfigCount = matchingConfigs.size();
+                SortedVector<String8> matchingSplitPaths;
+                for (size_t i = 0; i < matchingConfigCount; i++) {
+                    matchingSplitPaths.add(splitApkPathMap.valueFor(matchingConfigs[i]));
+                }
+                index = selected.add(targetSplits[t], matchingSplitPaths);
+            }
 
-        const size_t matchingSplitApkPathCount = matchingSplitPaths.size();
-        for (size_t i = 0; i < matchingSplitApkPathCount; i++) {
-            if (matchingSplitPaths[i] != baseApkPath) {
-                fprintf(stdout, "%s\n", matchingSplitPaths[i].string());
+            if (multipleTargets) {
+                fprintf(stdout, "%s:\n", targetConfigStrs[t].string());
+            }
+            const SortedVector<String8>& matchingSplitPaths = selected.valueAt(index);
+            const size_t matchingSplitApkPathCount = matchingSplitPaths.size();
+            for (size_t i = 0; i < matchingSplitApkPathCount; i++) {
+                if (matchingSplitPaths[i] != baseApkPath) {
+                    fprintf(stdout, multipleTargets ? "  %s\n" : "%s\n",
+                            matchingSplitPaths[i].string());
+                }
             }
         }
     } else {